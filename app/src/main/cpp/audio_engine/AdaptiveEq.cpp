@@ -0,0 +1,305 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            ADAPTIVE EQ - STREAMING SPECTRAL BALANCE         ║
+ * ║     Background Analysis Steers the Callback's Equalizer     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "AdaptiveEq.h"
+#include "SignalAnalysis.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define LOG_TAG "FTL_AdaptiveEq"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+// Android's THREAD_PRIORITY_BACKGROUND
+constexpr int BACKGROUND_NICE = 10;
+
+// The tap holds several updates' worth, so a late worker loses nothing
+constexpr int32_t TAP_SECONDS = 1;
+
+// Reference band of the tilt (1 kHz)
+constexpr int REFERENCE_BAND = 5;
+
+// Octave bands span center / sqrt(2) .. center * sqrt(2)
+constexpr double BAND_SQRT2 = 1.4142135623730951;
+
+float clampDb(float value, float low, float high) {
+    return std::max(low, std::min(high, value));
+}
+
+} // namespace
+
+AdaptiveEq::AdaptiveEq() = default;
+
+AdaptiveEq::~AdaptiveEq() {
+    stop();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONFIGURATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void AdaptiveEq::configure(Equalizer* equalizer, int sampleRate, int channelCount, int32_t maxBurstFrames) {
+    m_equalizer = equalizer;
+    m_channelCount = std::max(1, channelCount);
+    if (m_tap.capacityFrames() == 0) {
+        m_tap.allocate(std::max(sampleRate * TAP_SECONDS, FFT_SIZE * 4), 1);
+    }
+    m_tapScratch.assign(static_cast<size_t>(std::max(maxBurstFrames, 1)), 0.0f);
+    setSampleRate(sampleRate);
+}
+
+void AdaptiveEq::setSampleRate(int sampleRate) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sampleRate = sampleRate;
+    if (!m_fft) {
+        m_fft = std::make_unique<analysis::Fft>(FFT_SIZE);
+    }
+
+    // Octave edges in bins; every band keeps at least one bin
+    const double binHz = static_cast<double>(sampleRate) / FFT_SIZE;
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        double center = Equalizer::bandFrequency(band);
+        int low = std::max(1, static_cast<int>(std::ceil(center / BAND_SQRT2 / binHz)));
+        int high = std::min(FFT_SIZE / 2, static_cast<int>(std::floor(center * BAND_SQRT2 / binHz)));
+        m_binLow[band] = std::min(low, FFT_SIZE / 2);
+        m_binHigh[band] = std::max(high, m_binLow[band]);
+    }
+
+    m_pending.clear();
+    std::fill(m_bandEnergy, m_bandEnergy + Equalizer::BANDS, 0.0);
+    m_analyzedSeconds = 0.0;
+    post();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONTROL
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void AdaptiveEq::setCurve(const float* gainsDb) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // A curve change is the user's: it lands at once, the correction stays where it was
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        float curve = clampDb(gainsDb[band], -Equalizer::MAX_GAIN_DB, Equalizer::MAX_GAIN_DB);
+        m_appliedDb[band] = clampDb(m_appliedDb[band] + curve - m_curveDb[band],
+                                    -Equalizer::MAX_GAIN_DB, Equalizer::MAX_GAIN_DB);
+        m_curveDb[band] = curve;
+    }
+    post();
+}
+
+void AdaptiveEq::setAdaptive(bool enabled, float strength) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_strength = std::max(0.0f, std::min(1.0f, strength));
+    bool wasEnabled = m_adaptive.exchange(enabled, std::memory_order_relaxed);
+    if (!enabled && wasEnabled) {
+        // Back to the plain curve
+        std::copy(m_curveDb, m_curveDb + Equalizer::BANDS, m_appliedDb);
+        post();
+    }
+    if (enabled != wasEnabled) {
+        m_resetRequested.store(true, std::memory_order_release);
+    }
+}
+
+void AdaptiveEq::appliedGains(float* gainsDb) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::copy(m_appliedDb, m_appliedDb + Equalizer::BANDS, gainsDb);
+}
+
+void AdaptiveEq::curve(float* gainsDb) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::copy(m_curveDb, m_curveDb + Equalizer::BANDS, gainsDb);
+}
+
+void AdaptiveEq::post() {
+    if (m_equalizer && m_sampleRate > 0) {
+        m_equalizer->post(Equalizer::design(m_sampleRate, m_appliedDb));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ANALYSIS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool AdaptiveEq::update() {
+    FTL_TRACE_SCOPE("adaptiveEq.update");
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_fft) {
+        return false;
+    }
+
+    if (m_resetRequested.exchange(false, std::memory_order_acquire)) {
+        m_pending.clear();
+        std::fill(m_bandEnergy, m_bandEnergy + Equalizer::BANDS, 0.0);
+        m_analyzedSeconds = 0.0;
+        int32_t stale = m_tap.availableToRead();
+        m_tap.discardUntil(m_tap.readPosition() + stale);
+    }
+
+    // Drain the tap and analyze every whole FFT frame (no overlap: the averages are seconds long)
+    int32_t available = m_tap.availableToRead();
+    if (available > 0) {
+        size_t offset = m_pending.size();
+        m_pending.resize(offset + static_cast<size_t>(available));
+        m_tap.read(m_pending.data() + offset, available);
+    }
+    size_t consumed = 0;
+    while (m_pending.size() - consumed >= static_cast<size_t>(FFT_SIZE)) {
+        analyzeFrame(m_pending.data() + consumed);
+        consumed += FFT_SIZE;
+    }
+    m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(consumed));
+
+    if (!m_adaptive.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    float target[Equalizer::BANDS];
+    computeTarget(target);
+
+    // Hysteresis: hold still until some band is clearly off
+    float largest = 0.0f;
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        largest = std::max(largest, std::fabs(target[band] - m_appliedDb[band]));
+    }
+    if (largest < HYSTERESIS_DB) {
+        return false;
+    }
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        m_appliedDb[band] += clampDb(target[band] - m_appliedDb[band], -MAX_STEP_DB, MAX_STEP_DB);
+    }
+    post();
+    return true;
+}
+
+void AdaptiveEq::analyzeFrame(const float* frame) {
+    double sumSquares = 0.0;
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        sumSquares += static_cast<double>(frame[i]) * frame[i];
+    }
+    double levelDbfs = 10.0 * std::log10(sumSquares / FFT_SIZE + 1e-30);
+    if (levelDbfs < SILENCE_DBFS) {
+        return;                                         // Gaps and fades say nothing about balance
+    }
+
+    m_fft->powerSpectrum(frame, 1, 0, m_power);
+    const double frameSeconds = static_cast<double>(FFT_SIZE) / m_sampleRate;
+    const double alpha = m_analyzedSeconds > 0.0 ? std::min(1.0, frameSeconds / TIME_CONSTANT_S) : 1.0;
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        double energy = 0.0;
+        for (int bin = m_binLow[band]; bin <= m_binHigh[band]; ++bin) {
+            energy += m_power[static_cast<size_t>(bin)];
+        }
+        m_bandEnergy[band] += alpha * (energy - m_bandEnergy[band]);
+    }
+    m_analyzedSeconds += frameSeconds;
+}
+
+void AdaptiveEq::computeTarget(float* targetDb) const {
+    float correction[Equalizer::BANDS] = {};
+    if (m_analyzedSeconds >= MIN_ANALYZED_S) {
+        // Octave balance against the reference tilt; overall level cancels out
+        double deviation[Equalizer::BANDS];
+        double mean = 0.0;
+        int counted = 0;
+        for (int band = 0; band < Equalizer::BANDS; ++band) {
+            double levelDb = 10.0 * std::log10(m_bandEnergy[band] + 1e-30);
+            deviation[band] = levelDb - REFERENCE_TILT_DB_PER_OCTAVE * (band - REFERENCE_BAND);
+            if (Equalizer::bandFrequency(band) < m_sampleRate * 0.45) {
+                mean += deviation[band];
+                ++counted;
+            }
+        }
+        mean /= std::max(counted, 1);
+        for (int band = 0; band < Equalizer::BANDS; ++band) {
+            if (Equalizer::bandFrequency(band) >= m_sampleRate * 0.45) continue;
+            correction[band] = clampDb(static_cast<float>(-m_strength * (deviation[band] - mean)),
+                                       MAX_CUT_DB, MAX_BOOST_DB);
+        }
+    }
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        targetDb[band] = clampDb(m_curveDb[band] + correction[band], -Equalizer::MAX_GAIN_DB, Equalizer::MAX_GAIN_DB);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// AUDIO TAP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void AdaptiveEq::tap(const float* frames, int32_t count) {
+    const int channels = m_channelCount;
+    const float scale = 1.0f / channels;
+    const int32_t chunkFrames = static_cast<int32_t>(m_tapScratch.size());
+    for (int32_t done = 0; done < count;) {
+        int32_t chunk = std::min(chunkFrames, count - done);
+        const float* in = frames + static_cast<size_t>(done) * channels;
+        for (int32_t i = 0; i < chunk; ++i, in += channels) {
+            float sum = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) sum += in[ch];
+            m_tapScratch[static_cast<size_t>(i)] = sum * scale;
+        }
+        if (m_tap.write(m_tapScratch.data(), chunk) < chunk) {
+            return;                                     // Worker behind: the estimate is slow anyway
+        }
+        done += chunk;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WORKER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void AdaptiveEq::start() {
+    if (m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopWorker = false;
+    }
+    m_worker = std::thread(&AdaptiveEq::workerLoop, this);
+}
+
+void AdaptiveEq::stop() {
+    if (!m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopWorker = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+void AdaptiveEq::workerLoop() {
+    FTL_TRACE_THREAD_NAME("ftl_adaptive_eq");
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), BACKGROUND_NICE) != 0) {
+        LOGE("Cannot lower adaptive EQ priority, running at normal priority");
+    }
+    LOGI("Adaptive EQ running (every %d ms)", UPDATE_INTERVAL_MS);
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (!m_wake.wait_for(lock, std::chrono::milliseconds(UPDATE_INTERVAL_MS), [this] { return m_stopWorker; })) {
+        lock.unlock();
+        update();
+        lock.lock();
+    }
+}
+
+} // namespace ftl_audio
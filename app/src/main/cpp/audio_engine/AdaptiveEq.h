@@ -0,0 +1,134 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            ADAPTIVE EQ - STREAMING SPECTRAL BALANCE         ║
+ * ║     Background Analysis Steers the Callback's Equalizer     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * The callback copies the program (mono, before the EQ so the loop never
+ * chases its own output) into a lock-free tap. Every UPDATE_INTERVAL_MS a
+ * background-priority thread drains the tap, folds FFT frames into slow
+ * per-band energy averages and compares the octave balance with a
+ * reference tilt. The correction, on top of the user / model curve:
+ *   • is smoothed (TIME_CONSTANT_S) and limited to MAX_BOOST_DB / MAX_CUT_DB
+ *   • only moves when some band is HYSTERESIS_DB off what is applied
+ *   • moves at most MAX_STEP_DB per band per update, so the coefficient
+ *     switch at a burst boundary stays inaudible
+ * New coefficients go to the Equalizer's seqlocked slot: no JVM, no
+ * lock on the audio thread, no stream restart.
+ */
+
+#ifndef FTL_ADAPTIVE_EQ_H
+#define FTL_ADAPTIVE_EQ_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BufferManager.h"
+#include "Equalizer.h"
+
+namespace ftl_audio {
+
+namespace analysis {
+class Fft;
+}
+
+class AdaptiveEq {
+public:
+    static constexpr int32_t UPDATE_INTERVAL_MS = 250;
+    static constexpr int FFT_SIZE = 4096;               // 11.7 Hz bins at 48 kHz: the 31.5 Hz band gets two
+    static constexpr float TIME_CONSTANT_S = 3.0f;
+    static constexpr float MIN_ANALYZED_S = 1.0f;       // No correction before this much program
+    static constexpr float REFERENCE_TILT_DB_PER_OCTAVE = -1.5f;
+    static constexpr float MAX_BOOST_DB = 4.0f;
+    static constexpr float MAX_CUT_DB = -6.0f;
+    static constexpr float HYSTERESIS_DB = 0.5f;
+    static constexpr float MAX_STEP_DB = 1.0f;
+    static constexpr float SILENCE_DBFS = -60.0f;       // Quieter FFT frames are not analyzed
+
+    AdaptiveEq();
+    ~AdaptiveEq();
+
+    /**
+     * Bind to the equalizer and size the tap for bursts up to `maxBurstFrames`.
+     * Call before the callback runs; the tap is allocated only once.
+     */
+    void configure(Equalizer* equalizer, int sampleRate, int channelCount, int32_t maxBurstFrames);
+
+    /** New stream rate (stream stopped): redesigns and reposts the applied gains */
+    void setSampleRate(int sampleRate);
+
+    // Control side - any thread
+    /** User / model curve in EQ bands; applied at once when not adapting */
+    void setCurve(const float* gainsDb);
+    void setAdaptive(bool enabled, float strength);
+    bool isAdaptive() const { return m_adaptive.load(std::memory_order_relaxed); }
+
+    /** New track: forget the measured balance (the applied gains glide from where they are) */
+    void resetAnalysis() { m_resetRequested.store(true, std::memory_order_release); }
+
+    /** Gains the equalizer runs with (curve + correction) */
+    void appliedGains(float* gainsDb) const;
+    void curve(float* gainsDb) const;
+
+    /**
+     * One analysis step: drain the tap, update the estimate, post new
+     * coefficients if they moved. The worker calls it every
+     * UPDATE_INTERVAL_MS; offline renders call it inline.
+     * @return True if coefficients were posted
+     */
+    bool update();
+
+    /** Background worker (nice 10) while adapting on a live stream */
+    void start();
+    void stop();
+
+    // Audio side
+    /** Mono fold of interleaved program frames into the tap; drops when the tap is full */
+    void tap(const float* frames, int32_t count);
+    bool tapEnabled() const { return m_adaptive.load(std::memory_order_relaxed); }
+
+private:
+    void analyzeFrame(const float* frame);
+    void computeTarget(float* targetDb) const;
+    void post();                                        // Under m_mutex
+    void workerLoop();
+
+    Equalizer* m_equalizer = nullptr;
+    int m_channelCount = 0;
+
+    // Audio -> worker
+    AudioRingBuffer m_tap;
+    std::vector<float> m_tapScratch;                    // Audio thread only
+
+    // Control state, under m_mutex
+    mutable std::mutex m_mutex;
+    int m_sampleRate = 0;
+    float m_curveDb[Equalizer::BANDS] = {};
+    float m_strength = 1.0f;
+    float m_appliedDb[Equalizer::BANDS] = {};
+    std::unique_ptr<analysis::Fft> m_fft;
+    std::vector<float> m_pending;                       // Tap frames not yet analyzed
+    std::vector<double> m_power;
+    int m_binLow[Equalizer::BANDS] = {};
+    int m_binHigh[Equalizer::BANDS] = {};
+    double m_bandEnergy[Equalizer::BANDS] = {};         // Smoothed, per FFT frame
+    double m_analyzedSeconds = 0.0;
+
+    std::atomic<bool> m_adaptive{false};
+    std::atomic<bool> m_resetRequested{false};
+
+    std::thread m_worker;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stopWorker = false;                          // Under m_wakeMutex
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_ADAPTIVE_EQ_H
@@ -0,0 +1,155 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            AUTOMATION SCHEDULER - SAMPLE-TIMED EVENTS       ║
+ * ║     Sleep/Workout Timers and Fades Run Inside the Callback  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "AutomationScheduler.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr int32_t NOT_DUE = INT32_MAX;
+
+int laneIndex(AutomationClock clock) {
+    return clock == AutomationClock::SOURCE ? 1 : 0;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONTROL SIDE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+uint32_t AutomationScheduler::schedule(const AutomationEvent& event) {
+    if (m_pending.fetch_add(1, std::memory_order_relaxed) >= CAPACITY) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    Command command{CommandType::ADD, event};
+    command.event.id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+    if (command.event.id == 0) {
+        command.event.id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!m_commands.push(command)) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        return 0;
+    }
+    return command.event.id;
+}
+
+bool AutomationScheduler::cancel(uint32_t eventId) {
+    Command command{CommandType::CANCEL, AutomationEvent()};
+    command.event.id = eventId;
+    return eventId != 0 && m_commands.push(command);
+}
+
+void AutomationScheduler::clear() {
+    m_commands.push(Command{CommandType::CLEAR, AutomationEvent()});
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TIMELINE (AUDIO THREAD)
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool AutomationScheduler::Lane::insert(const AutomationEvent& event) {
+    if (count == CAPACITY) {
+        return false;
+    }
+    // Latest-first; an event ties after those already scheduled for its frame
+    int position = count;
+    while (position > 0 && events[position - 1].frame <= event.frame) {
+        --position;
+    }
+    std::copy_backward(events + position, events + count, events + count + 1);
+    events[position] = event;
+    ++count;
+    return true;
+}
+
+bool AutomationScheduler::Lane::remove(uint32_t eventId) {
+    for (int i = 0; i < count; ++i) {
+        if (events[i].id == eventId) {
+            std::copy(events + i + 1, events + count, events + i);
+            --count;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AutomationScheduler::drain() {
+    Command command;
+    while (m_commands.pop(command)) {
+        switch (command.type) {
+            case CommandType::ADD:
+                if (!m_lanes[laneIndex(command.event.clock)].insert(command.event)) {
+                    m_pending.fetch_sub(1, std::memory_order_relaxed);
+                }
+                break;
+            case CommandType::CANCEL:
+                if (m_lanes[0].remove(command.event.id) || m_lanes[1].remove(command.event.id)) {
+                    m_pending.fetch_sub(1, std::memory_order_relaxed);
+                }
+                break;
+            case CommandType::CLEAR:
+                m_pending.fetch_sub(m_lanes[0].count + m_lanes[1].count, std::memory_order_relaxed);
+                m_lanes[0].count = 0;
+                m_lanes[1].count = 0;
+                break;
+        }
+    }
+}
+
+int32_t AutomationScheduler::dueOffset(const BurstClock& clock, const AutomationEvent& event, int32_t from) const {
+    int64_t offset;
+    if (event.clock == AutomationClock::OUTPUT) {
+        offset = event.frame - clock.outputFrame;
+    } else {
+        // Only frames that actually carry the source advance its clock, sourceRate frames each
+        offset = event.frame - clock.sourceFrame;
+        if (clock.sourceRate != 1.0) {
+            offset = static_cast<int64_t>(std::ceil(offset / clock.sourceRate));
+        }
+        if (offset >= clock.sourceFrames) {
+            return NOT_DUE;
+        }
+    }
+    if (offset >= NOT_DUE) {
+        return NOT_DUE;
+    }
+    // Overdue (seeked past, or posted late) fires at once
+    return std::max(static_cast<int32_t>(std::max<int64_t>(offset, 0)), from);
+}
+
+int32_t AutomationScheduler::nextEventOffset(const BurstClock& clock, int32_t from, int32_t numFrames) const {
+    int32_t next = numFrames;
+    for (const Lane& lane : m_lanes) {
+        if (const AutomationEvent* event = lane.earliest()) {
+            next = std::min(next, dueOffset(clock, *event, from));
+        }
+    }
+    return next;
+}
+
+bool AutomationScheduler::popDue(const BurstClock& clock, int32_t offset, AutomationEvent& event) {
+    for (Lane& lane : m_lanes) {
+        const AutomationEvent* earliest = lane.earliest();
+        if (earliest && dueOffset(clock, *earliest, offset) <= offset) {
+            event = *earliest;
+            --lane.count;
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,118 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            AUTOMATION SCHEDULER - SAMPLE-TIMED EVENTS       ║
+ * ║     Sleep/Workout Timers and Fades Run Inside the Callback  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A timeline of gain ramps, voice stops and pauses, each keyed to a frame
+ * on one of two clocks:
+ *   OUTPUT - frames the engine has played (keeps counting across tracks,
+ *            seeks and stream reopens; stands still while paused)
+ *   SOURCE - frame of the main source being played (track position)
+ *
+ * Control threads post events through a lock-free mailbox. The callback
+ * drains it into two sorted arrays it owns and, per burst, only compares
+ * the earliest event of each clock against the burst - a few loads when
+ * nothing is due. Events fire on the exact frame they name; a SOURCE
+ * event skipped over by a seek fires at once.
+ */
+
+#ifndef FTL_AUTOMATION_SCHEDULER_H
+#define FTL_AUTOMATION_SCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "MpscQueue.h"
+
+namespace ftl_audio {
+
+enum class AutomationClock : int32_t {
+    OUTPUT = 0,
+    SOURCE = 1
+};
+
+enum class AutomationAction : int32_t {
+    PROGRAM_GAIN = 0,   // Ramp the main program to `value` over `rampFrames`
+    VOICE_GAIN = 1,     // Ramp mixer voice `voiceId`
+    VOICE_STOP = 2,     // Fade mixer voice `voiceId` out over `rampFrames`
+    PAUSE = 3           // Silence from this frame on and stop the stream
+};
+
+struct AutomationEvent {
+    int64_t frame = 0;
+    AutomationClock clock = AutomationClock::OUTPUT;
+    AutomationAction action = AutomationAction::PROGRAM_GAIN;
+    float value = 0.0f;
+    int32_t rampFrames = 0;
+    int32_t voiceId = -1;
+    uint32_t id = 0;            // Assigned by schedule()
+};
+
+/**
+ * Where the current burst sits on both clocks
+ */
+struct BurstClock {
+    int64_t outputFrame = 0;    // Output clock at the burst's first frame
+    int64_t sourceFrame = 0;    // Source frame at the burst's first frame
+    int32_t sourceFrames = 0;   // Leading frames that carry source audio
+    double sourceRate = 1.0;    // Source frames per output frame (tempo)
+};
+
+class AutomationScheduler {
+public:
+    static constexpr int CAPACITY = 256;
+
+    // Control side - any thread
+    /** @return Event id, or 0 if the timeline is full */
+    uint32_t schedule(const AutomationEvent& event);
+    bool cancel(uint32_t eventId);
+    void clear();
+    int pendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+    // Audio side
+    /** Pull posted events and cancellations into the timeline */
+    void drain();
+
+    /**
+     * First frame in [from, numFrames) at which an event is due,
+     * or numFrames when none is
+     */
+    int32_t nextEventOffset(const BurstClock& clock, int32_t from, int32_t numFrames) const;
+
+    /** Pop one event due at or before burst offset `offset` */
+    bool popDue(const BurstClock& clock, int32_t offset, AutomationEvent& event);
+
+private:
+    enum class CommandType : int32_t { ADD, CANCEL, CLEAR };
+
+    struct Command {
+        CommandType type;
+        AutomationEvent event;
+    };
+
+    /** Events of one clock, sorted latest-first so the due one pops off the back */
+    struct Lane {
+        AutomationEvent events[CAPACITY];
+        int count = 0;
+
+        bool insert(const AutomationEvent& event);
+        bool remove(uint32_t eventId);
+        const AutomationEvent* earliest() const { return count > 0 ? &events[count - 1] : nullptr; }
+    };
+
+    MpscQueue<Command, CAPACITY> m_commands;
+    std::atomic<uint32_t> m_nextId{1};
+    std::atomic<int> m_pending{0};
+
+    // Audio thread only
+    Lane m_lanes[2];
+
+    int32_t dueOffset(const BurstClock& clock, const AutomationEvent& event, int32_t from) const;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_AUTOMATION_SCHEDULER_H
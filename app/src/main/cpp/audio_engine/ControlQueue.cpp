@@ -0,0 +1,224 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            CONTROL QUEUE - ONE THREAD RUNS THE ENGINE       ║
+ * ║      Start / Stop / Pause / Seek Posted, Run In Order       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "ControlQueue.h"
+
+#include "FTLAudioEngine.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+
+namespace ftl_audio {
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// call(): the waiting thread's result, filled in on the control thread
+struct CallWaiter {
+    EngineResult result = EngineResult::SUCCESS;
+    std::atomic<bool> done{false};
+
+    static void finish(ControlToken, ControlAction, EngineResult result, void* userData) {
+        auto* self = static_cast<CallWaiter*>(userData);
+        self->result = result;
+        self->done.store(true, std::memory_order_release);
+    }
+};
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void ControlQueue::start(Executor executor) {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_executor = std::move(executor);
+    m_running.store(true);
+    m_thread = std::thread(&ControlQueue::threadFunction, this);
+}
+
+void ControlQueue::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false);
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    m_executor = nullptr;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// POSTING SIDE - ANY THREAD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+ControlToken ControlQueue::post(ControlAction action, int64_t argument, ControlCallback callback, void* userData) {
+    // Announced before the running check: stop() cancels only once no post is half done
+    m_posting.fetch_add(1);
+    bool admitted = m_running.load();
+    if (admitted && m_queued.fetch_add(1) >= CAPACITY) {
+        m_queued.fetch_sub(1);
+        admitted = false;
+    }
+    if (!admitted) {
+        m_posting.fetch_sub(1);
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    ControlCommand command;
+    command.token = m_nextToken.fetch_add(1, std::memory_order_relaxed);
+    command.action = action;
+    command.argument = argument;
+    command.callback = callback;
+    command.userData = userData;
+    command.postedNs = steadyNowNs();
+    m_commands.push(command);                            // Room was reserved above
+    m_posting.fetch_sub(1);
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wake.notify_one();
+    return command.token;
+}
+
+bool ControlQueue::awaitResult(ControlToken token, std::chrono::milliseconds timeout, EngineResult* result) {
+    if (token == 0) {
+        return false;
+    }
+
+    // Slots are rewritten RESULT_SLOTS commands later: a token read on both sides of the result
+    ResultSlot& slot = m_results[token % RESULT_SLOTS];
+    bool found = false;
+    bool gone = false;
+    auto check = [&] {
+        ControlToken before = slot.token.load(std::memory_order_acquire);
+        int32_t value = slot.result.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        ControlToken after = slot.token.load(std::memory_order_relaxed);
+        if (before == token && after == token) {
+            found = true;
+            if (result) {
+                *result = static_cast<EngineResult>(value);
+            }
+        }
+        gone = !found && after > token;
+        return found || gone;
+    };
+
+    std::unique_lock<std::mutex> lock(m_doneMutex);
+    m_done.wait_for(lock, timeout, check);
+    return found;
+}
+
+EngineResult ControlQueue::call(ControlAction action, int64_t argument) {
+    // A callback calling back in would wait on itself
+    if (onControlThread()) {
+        ControlCommand command;
+        command.action = action;
+        command.argument = argument;
+        return m_executor(command);
+    }
+
+    CallWaiter waiter;
+    while (post(action, argument, &CallWaiter::finish, &waiter) == 0) {
+        if (!isRunning()) {
+            return EngineResult::ERROR_NOT_INITIALIZED;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));   // Mailbox full
+    }
+    std::unique_lock<std::mutex> lock(m_doneMutex);
+    m_done.wait(lock, [&] { return waiter.done.load(std::memory_order_acquire); });
+    return waiter.result;
+}
+
+ControlStats ControlQueue::stats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    ControlStats stats = m_stats;
+    stats.posted = m_posted.load(std::memory_order_relaxed);
+    stats.rejected = m_rejected.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONTROL THREAD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void ControlQueue::threadFunction() {
+    FTL_TRACE_THREAD_NAME("control");
+    ControlCommand command;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait(lock, [this] {
+                return m_queued.load(std::memory_order_relaxed) > 0 || !m_running.load();
+            });
+        }
+        if (!m_running.load()) {
+            break;
+        }
+        while (m_running.load() && m_commands.pop(command)) {
+            m_queued.fetch_sub(1);
+            int64_t startedNs = steadyNowNs();
+            EngineResult result;
+            {
+                FTL_TRACE_SCOPE("controlCommand");
+                result = m_executor(command);
+            }
+            complete(command, result, startedNs);
+        }
+    }
+
+    // Stopped: once no post is half done, whatever is left is cancelled
+    while (m_posting.load() > 0) {
+        std::this_thread::yield();
+    }
+    while (m_commands.pop(command)) {
+        m_queued.fetch_sub(1);
+        complete(command, EngineResult::ERROR_NOT_INITIALIZED, steadyNowNs());
+    }
+}
+
+void ControlQueue::complete(const ControlCommand& command, EngineResult result, int64_t startedNs) {
+    ResultSlot& slot = m_results[command.token % RESULT_SLOTS];
+    slot.token.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.result.store(static_cast<int32_t>(result), std::memory_order_relaxed);
+    slot.token.store(command.token, std::memory_order_release);
+
+    if (command.callback) {
+        command.callback(command.token, command.action, result, command.userData);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        double waitMs = (startedNs - command.postedNs) / 1e6;
+        double latencyMs = (steadyNowNs() - command.postedNs) / 1e6;
+        m_stats.completed++;
+        m_stats.maxWaitMs = std::max(m_stats.maxWaitMs, waitMs);
+        m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latencyMs);
+        m_totalLatencyMs += latencyMs;
+        m_stats.meanLatencyMs = m_totalLatencyMs / m_stats.completed;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+    }
+    m_done.notify_all();
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,132 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            CONTROL QUEUE - ONE THREAD RUNS THE ENGINE       ║
+ * ║      Start / Stop / Pause / Seek Posted, Run In Order       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Control operations from any thread go through a lock-free mailbox to a
+ * single control thread, which runs them one at a time in the order they
+ * were posted. Posting never blocks: it returns a token at once, and the
+ * result arrives through an optional callback (on the control thread) or
+ * awaitResult(). Since only the control thread changes playback state,
+ * every state check and the transition that follows it are one step.
+ */
+
+#ifndef FTL_CONTROL_QUEUE_H
+#define FTL_CONTROL_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "MpscQueue.h"
+
+namespace ftl_audio {
+
+enum class EngineResult;
+
+enum class ControlAction : int32_t {
+    START = 0,              // INITIALIZED / PAUSED -> RUNNING
+    STOP = 1,               // RUNNING / PAUSED -> INITIALIZED, otherwise nothing to do
+    PAUSE = 2,              // RUNNING -> PAUSED
+    RESUME = 3,             // Same as START
+    SEEK = 4,               // argument: source frame
+    SET_OUTPUT_MODE = 5,    // argument: OutputMode
+    SET_SOURCE = 6,         // argument: const std::string* path, alive until the command completes
+    RECONFIGURE = 7         // argument: const AudioEngineConfig*, alive until the command completes
+};
+
+using ControlToken = uint64_t;              // 0: not posted
+using ControlCallback = void (*)(ControlToken token, ControlAction action, EngineResult result, void* userData);
+
+struct ControlCommand {
+    ControlToken token = 0;
+    ControlAction action = ControlAction::START;
+    int64_t argument = 0;
+    ControlCallback callback = nullptr;
+    void* userData = nullptr;
+    int64_t postedNs = 0;
+};
+
+struct ControlStats {
+    uint64_t posted = 0;
+    uint64_t completed = 0;
+    uint64_t rejected = 0;          // Mailbox full or queue stopped
+    double maxWaitMs = 0.0;         // Posted -> control thread picks it up
+    double maxLatencyMs = 0.0;      // Posted -> completed
+    double meanLatencyMs = 0.0;
+};
+
+class ControlQueue {
+public:
+    static constexpr int CAPACITY = 256;
+    static constexpr int RESULT_SLOTS = 1024;   // Results kept for awaitResult()
+
+    using Executor = std::function<EngineResult(const ControlCommand&)>;
+
+    ControlQueue() = default;
+    ~ControlQueue() { stop(); }
+
+    void start(Executor executor);
+    /** Finishes the running command; queued ones complete with ERROR_NOT_INITIALIZED */
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    bool onControlThread() const { return std::this_thread::get_id() == m_thread.get_id(); }
+
+    /** Any thread, never blocks. @return Token, or 0 if the mailbox is full or stopped */
+    ControlToken post(ControlAction action, int64_t argument, ControlCallback callback, void* userData);
+
+    /**
+     * Wait up to `timeout` for a posted command. False on timeout, or once
+     * RESULT_SLOTS later commands have completed and its result is gone.
+     */
+    bool awaitResult(ControlToken token, std::chrono::milliseconds timeout, EngineResult* result);
+
+    /** Post and wait; waits for room when the mailbox is full. Inline on the control thread. */
+    EngineResult call(ControlAction action, int64_t argument);
+
+    ControlStats stats() const;
+
+private:
+    struct ResultSlot {
+        std::atomic<ControlToken> token{0};
+        std::atomic<int32_t> result{0};
+    };
+
+    MpscQueue<ControlCommand, CAPACITY> m_commands;
+    std::atomic<ControlToken> m_nextToken{1};
+    std::atomic<int> m_queued{0};                       // Posted, not popped yet
+    std::atomic<int> m_posting{0};                      // Producers between the running check and the push
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_posted{0};
+    std::atomic<uint64_t> m_rejected{0};
+    ResultSlot m_results[RESULT_SLOTS];
+
+    std::thread m_thread;
+    Executor m_executor;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;                     // Control thread: command posted or stop
+    std::mutex m_doneMutex;
+    std::condition_variable m_done;                     // Waiters: a command completed
+
+    // Completion figures: control thread writes, stats() reads
+    mutable std::mutex m_statsMutex;
+    ControlStats m_stats;
+    double m_totalLatencyMs = 0.0;
+
+    void threadFunction();
+    void complete(const ControlCommand& command, EngineResult result, int64_t startedNs);
+
+    ControlQueue(const ControlQueue&) = delete;
+    ControlQueue& operator=(const ControlQueue&) = delete;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_CONTROL_QUEUE_H
@@ -0,0 +1,146 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - SHARED SNAPSHOT              ║
+ * ║          Seqlock-Protected State Export for Kotlin          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * The snapshot lives inside the engine and is handed to Kotlin once as a
+ * direct ByteBuffer. Live meters then poll it with plain memory reads:
+ * no JNI transition, no object allocation, no lock.
+ *
+ * Protocol (single writer, any number of readers):
+ * • Writer bumps `sequence` to an odd value, writes the payload, then
+ *   bumps it to the next even value.
+ * • Reader reads `sequence`, copies the payload, re-reads `sequence`;
+ *   the copy is valid when both reads match and are even.
+ *
+ * The byte layout is mirrored by EngineSnapshot.kt — any change here must
+ * bump SNAPSHOT_LAYOUT_VERSION and update the Kotlin offsets.
+ */
+
+#ifndef FTL_ENGINE_SNAPSHOT_H
+#define FTL_ENGINE_SNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ftl_audio {
+
+constexpr uint32_t SNAPSHOT_LAYOUT_VERSION = 2;
+constexpr int SNAPSHOT_MAX_CHANNELS = 8;
+
+/**
+ * Payload copied into the shared buffer on every publish.
+ * Fixed-width fields only, naturally aligned, no implicit padding.
+ */
+struct EngineSnapshotData {
+    int32_t engineState = 0;          // EngineState ordinal
+    int32_t sampleRate = 0;
+    int32_t channelCount = 0;
+    int32_t framesPerBurst = 0;
+
+    int64_t playheadFrame = 0;        // Source frame at the read head
+    int64_t framesRendered = 0;       // Frames handed to the stream
+    int64_t callbackCount = 0;
+    int64_t missedCallbacks = 0;
+    int64_t bufferUnderruns = 0;
+    int64_t bufferOverruns = 0;
+
+    double averageProcessingTimeUs = 0.0;
+    double maxProcessingTimeUs = 0.0;
+    double callbackLoad = 0.0;
+    double cpuUsagePercent = 0.0;
+    double memoryUsageMB = 0.0;
+    double totalLatencyMs = 0.0;
+    double outputLatencyMs = 0.0;
+
+    int64_t publishTimeNs = 0;        // CLOCK_MONOTONIC of last publish
+    float peakLevels[SNAPSHOT_MAX_CHANNELS] = {}; // Linear peak of last burst
+
+    // Startup and route changes (layout 2)
+    int64_t streamRecoveries = 0;
+    double lastRecoveryMs = 0.0;
+    double timeToFirstAudioMs = 0.0;
+};
+
+/**
+ * Shared block exposed through NewDirectByteBuffer.
+ */
+struct alignas(64) EngineSnapshot {
+    std::atomic<uint32_t> sequence{0};
+    uint32_t layoutVersion = SNAPSHOT_LAYOUT_VERSION;
+    EngineSnapshotData data;
+};
+
+// Offsets the Kotlin reader depends on
+static_assert(offsetof(EngineSnapshot, layoutVersion) == 4, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshot, data) == 8, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, playheadFrame) == 16, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, averageProcessingTimeUs) == 64, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, publishTimeNs) == 120, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, peakLevels) == 128, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, streamRecoveries) == 160, "snapshot layout changed");
+static_assert(offsetof(EngineSnapshotData, timeToFirstAudioMs) == 176, "snapshot layout changed");
+static_assert(sizeof(std::atomic<uint32_t>) == 4, "sequence must be a plain 32-bit word");
+
+/**
+ * Writer side of the seqlock. Publishing may happen from the audio
+ * callback and from control threads, so writers serialize on a spin flag;
+ * the callback uses tryPublish() and simply skips a publish when busy.
+ */
+class SnapshotPublisher {
+public:
+    EngineSnapshot* buffer() { return &m_snapshot; }
+    static constexpr size_t bufferSize() { return sizeof(EngineSnapshot); }
+
+    // Real-time safe: never spins
+    bool tryPublish(const EngineSnapshotData& data) {
+        if (m_writerBusy.test_and_set(std::memory_order_acquire)) {
+            return false;
+        }
+        write(data);
+        m_writerBusy.clear(std::memory_order_release);
+        return true;
+    }
+
+    // Control threads only
+    void publish(const EngineSnapshotData& data) {
+        while (m_writerBusy.test_and_set(std::memory_order_acquire)) {
+            // Callback publishes are a few hundred nanoseconds
+        }
+        write(data);
+        m_writerBusy.clear(std::memory_order_release);
+    }
+
+    // Consistent copy for native readers (JNI fallback path, tests)
+    EngineSnapshotData read() const {
+        EngineSnapshotData copy;
+        uint32_t before, after;
+        do {
+            before = m_snapshot.sequence.load(std::memory_order_acquire);
+            copy = m_snapshot.data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_snapshot.sequence.load(std::memory_order_relaxed);
+        } while ((before & 1u) != 0 || before != after);
+        return copy;
+    }
+
+private:
+    void write(const EngineSnapshotData& data) {
+        uint32_t seq = m_snapshot.sequence.load(std::memory_order_relaxed);
+        m_snapshot.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_snapshot.data = data;
+        m_snapshot.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    EngineSnapshot m_snapshot;
+    std::atomic_flag m_writerBusy = ATOMIC_FLAG_INIT;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_ENGINE_SNAPSHOT_H
@@ -8,19 +8,149 @@
  */
 
 #include "FTLAudioEngine.h"
+#include "AudioFormat.h"
+#include "BinauralRenderer.h"
+#include "LogUtils.h"
+#include "MixKernels.h"
+#include "QualityMeasurement.h"
+#include "SeekIndex.h"
+#include "TraceRecorder.h"
 #include <android/log.h>
 #include <unistd.h>
+#include <time.h>
 #include <cmath>
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 #define LOG_TAG "FTL_AudioEngine"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGI(...) FTL_LOGI(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) FTL_LOGE(LOG_TAG, __VA_ARGS__)
+#define LOGD(...) FTL_LOGD(LOG_TAG, __VA_ARGS__)
 
 namespace ftl_audio {
 
+namespace {
+
+// Decode granularity and ring depth for file playback
+constexpr int32_t DECODE_CHUNK_FRAMES = 1024;
+constexpr int32_t DECODE_RING_MIN_MS = 250;
+
+// Burst prefetch: read size per source, and the ring level that starts the next batch
+constexpr size_t PREFETCH_READ_BYTES = 2 * 1024 * 1024;
+constexpr int32_t PREFETCH_LOW_WATER_DIVISOR = 4;
+constexpr int PREFETCH_RING_MAX_MS = 60000;
+
+// Power saving: the decode ring holds several deep buffers, so one batch refills seconds of audio
+constexpr int64_t POWER_SAVING_RING_BUFFERS = 8;
+constexpr int DEEP_BUFFER_MIN_MS = 50;
+constexpr int DEEP_BUFFER_MAX_MS = 2000;
+
+// Mode switch: bounded wait for the claim and the drain, polled from the control thread. The
+// outgoing callback may briefly wait for the first tail frames the incoming one renders at the claim
+constexpr int32_t HANDOVER_TIMEOUT_MS = 1000;                // Plus a few deep buffers
+constexpr int32_t HANDOVER_TIMEOUT_DEEP_BUFFERS = 4;
+constexpr int32_t HANDOVER_POLL_MS = 2;
+constexpr int32_t HANDOVER_SCRATCH_FRAMES = 256;
+
+// Route-change recovery: a new device can take a moment to accept streams
+constexpr int RECOVERY_ATTEMPTS = 5;
+constexpr int32_t RECOVERY_RETRY_MS = 50;
+
+// Loudness stage: normalization gain changes glide over one meter block
+constexpr int32_t LOUDNESS_RAMP_MS = 100;
+constexpr float MIN_LIMITER_CEILING_DB = -12.0f;
+
+// Decode ring sized in time, never below a handful of bursts (voices use the same depth)
+int32_t streamingRingFrames(const AudioEngineConfig& config) {
+    int32_t ringFrames = std::max(config.sampleRate * DECODE_RING_MIN_MS / 1000, config.framesPerBurst * 8);
+    return std::max(ringFrames, DECODE_CHUNK_FRAMES * 2);
+}
+
+// The settings updateConfiguration() may change (what Kotlin's AudioEngineConfiguration carries),
+// copied field by field so nothing the callback reads is written. Stream options apply at the next open
+void applyTuning(AudioEngineConfig& live, const AudioEngineConfig& tuning) {
+    live.enableLowLatency = tuning.enableLowLatency;
+    live.enableHighResolution = tuning.enableHighResolution;
+    live.enableDSPProcessing = tuning.enableDSPProcessing;
+    live.threadPriority = tuning.threadPriority;
+    live.bufferSizeMultiplier = tuning.bufferSizeMultiplier;
+}
+
+// Everything else is fixed at initialize: it sizes the stream, the rings and the DSP stages, or the
+// callback reads it. outputMode only picks the first stream's mode (setOutputMode changes modes)
+bool sameFixedSettings(const AudioEngineConfig& a, const AudioEngineConfig& b) {
+    return a.sampleRate == b.sampleRate && a.framesPerBurst == b.framesPerBurst &&
+           a.channelCount == b.channelCount && a.audioFormat == b.audioFormat && a.deviceId == b.deviceId &&
+           a.targetLatencyMs == b.targetLatencyMs && a.enableRealTimeCallback == b.enableRealTimeCallback &&
+           a.enableExclusiveMode == b.enableExclusiveMode && a.maxBufferSizeFrames == b.maxBufferSizeFrames &&
+           a.minBufferSizeFrames == b.minBufferSizeFrames && a.offlineRender == b.offlineRender &&
+           a.prewarmStream == b.prewarmStream && a.prewarmIdleMs == b.prewarmIdleMs &&
+           a.burstPrefetch == b.burstPrefetch && a.prefetchRingMs == b.prefetchRingMs &&
+           a.enablePowerSaving == b.enablePowerSaving && a.deepBufferMs == b.deepBufferMs &&
+           a.enableTimeStretch == b.enableTimeStretch;
+}
+
+// AAudio timestamps are CLOCK_MONOTONIC
+int64_t monotonicNowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// CPU time of the calling thread, for the per-mode cost figures
+int64_t threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Stop a stream, let its last callback return, then close it
+void closeStream(AAudioStream* stream) {
+    if (AAudioStream_requestStop(stream) == AAUDIO_OK) {
+        aaudio_stream_state_t state = AAUDIO_STREAM_STATE_UNINITIALIZED;
+        AAudioStream_waitForStateChange(stream, AAUDIO_STREAM_STATE_STOPPING, &state, 100 * 1000 * 1000);
+    }
+    AAudioStream_close(stream);
+}
+
+const char* outputModeName(OutputMode mode) {
+    return mode == OutputMode::POWER_SAVING ? "power saving" : "low latency";
+}
+
+// Wall time per callback stage, only while an offline render collects it
+class StageClock {
+public:
+    explicit StageClock(OfflineRenderStats* stats) : m_stats(stats) {
+        if (m_stats) m_last = std::chrono::steady_clock::now();
+    }
+    
+    void lap(double OfflineRenderStats::* stage) {
+        if (!m_stats) return;
+        auto now = std::chrono::steady_clock::now();
+        m_stats->*stage += std::chrono::duration<double, std::milli>(now - m_last).count();
+        m_last = now;
+    }
+    
+private:
+    OfflineRenderStats* m_stats;
+    std::chrono::steady_clock::time_point m_last;
+};
+
+// Scale a buffer by a gain ramp, skipping the work once it settles at unity
+void applyGainRamp(GainRamp& ramp, float* buffer, int32_t frames, int channelCount) {
+    ramp.refresh();
+    for (int32_t done = 0; done < frames && !ramp.isUnity();) {
+        float gain;
+        float step;
+        int32_t span = ramp.nextSegment(frames - done, gain, step);
+        mix::scaleRamped(buffer + done * channelCount, span, channelCount, gain, step);
+        done += span;
+    }
+}
+
+} // namespace
+
 // ═══════════════════════════════════════════════════════════════════════════════════
 // CONSTRUCTOR & DESTRUCTOR
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -53,25 +183,61 @@ EngineResult FTLAudioEngine::initialize(const AudioEngineConfig& config) {
     }
     
     m_config = config;
+    m_outputMode.store(config.outputMode, std::memory_order_relaxed);
+    m_dspEnabled.store(config.enableDSPProcessing, std::memory_order_relaxed);
     logConfiguration(config);
     
-    // Setup AAudio stream
-    result = setupAAudioStream();
+    // Setup AAudio stream (offline renders have no device; a pre-warmed one opens in the background)
+    if (!m_config.offlineRender && !m_config.prewarmStream) {
+        std::lock_guard<std::mutex> streamLock(m_streamMutex);
+        result = setupAAudioStream(false);
+    }
     if (result != EngineResult::SUCCESS) {
         LOGE("Failed to setup AAudio stream");
         return result;
     }
     
-    // Allocate audio buffer
-    m_bufferSize = config.framesPerBurst * config.channelCount;
-    m_audioBuffer = std::make_unique<float[]>(m_bufferSize);
-    std::fill(m_audioBuffer.get(), m_audioBuffer.get() + m_bufferSize, 0.0f);
+    // Allocate audio buffer (the stream setup already sized it for the device burst)
+    if (!m_audioBuffer) {
+        m_bufferSize = m_config.framesPerBurst * m_config.channelCount;
+        m_audioBuffer = std::make_unique<float[]>(m_bufferSize);
+        std::fill(m_audioBuffer.get(), m_audioBuffer.get() + m_bufferSize, 0.0f);
+    }
+    
+    // Burst prefetch and power saving decode seconds ahead; voices keep the short ring
+    int32_t ringFrames = streamingRingFrames(m_config);
+    int32_t decodeRingFrames = ringFrames;
+    if (m_config.burstPrefetch) {
+        decodeRingFrames = std::max(ringFrames, static_cast<int32_t>(
+            static_cast<int64_t>(m_config.sampleRate) * m_config.prefetchRingMs / 1000));
+    }
+    if (m_config.enablePowerSaving) {
+        decodeRingFrames = std::max(decodeRingFrames, static_cast<int32_t>(
+            static_cast<int64_t>(m_config.sampleRate) * m_config.deepBufferMs / 1000 * POWER_SAVING_RING_BUFFERS));
+    }
+    m_decodeRing.allocate(decodeRingFrames, m_config.channelCount);
+    m_mixer.configure(m_config.sampleRate, m_config.channelCount, ringFrames);
+    m_loudness.configure(m_config.sampleRate, m_config.channelCount);
+    m_limiter.configure(m_config.sampleRate, m_config.channelCount);
+    m_equalizer.configure(m_config.channelCount);
+    m_adaptiveEq.configure(&m_equalizer, m_config.sampleRate, m_config.channelCount, m_config.framesPerBurst);
+    if (m_config.enableTimeStretch) {
+        m_stretcher.configure(m_config.sampleRate, m_config.channelCount);
+    }
     
     // Initialize performance monitoring
     m_currentMetrics = PerformanceMetrics();
     m_lastCallbackTime = std::chrono::high_resolution_clock::now();
     
     m_engineState = EngineState::INITIALIZED;
+    startRecoveryThread();
+    m_control.start([this](const ControlCommand& command) { return runCommand(command); });
+    if (m_config.prewarmStream && !m_config.offlineRender) {
+        // The caller goes on (source open, decode prefill) while the device opens
+        std::lock_guard<std::mutex> lock(m_streamOpenMutex);
+        m_streamOpenThread = std::thread(&FTLAudioEngine::openStreamInBackground, this);
+    }
+    publishSnapshot();
     LOGI("FTL Audio Engine initialized successfully");
     
     return EngineResult::SUCCESS;
@@ -81,14 +247,98 @@ EngineResult FTLAudioEngine::initialize(const AudioEngineConfig& config) {
 // AAUDIO STREAM SETUP
 // ═══════════════════════════════════════════════════════════════════════════════════
 
-EngineResult FTLAudioEngine::setupAAudioStream() {
+EngineResult FTLAudioEngine::setupAAudioStream(bool holdSampleRate) {
+    const OutputMode mode = m_outputMode.load(std::memory_order_relaxed);
+    EngineResult openResult = openOutputStream(mode, holdSampleRate, &m_audioStream);
+    if (openResult != EngineResult::SUCCESS) {
+        return openResult;
+    }
+    
+    // Verify stream properties
+    int actualSampleRate = AAudioStream_getSampleRate(m_audioStream);
+    int actualChannelCount = AAudioStream_getChannelCount(m_audioStream);
+    int actualFramesPerBurst = AAudioStream_getFramesPerBurst(m_audioStream);
+    m_outputPcm16 = AAudioStream_getFormat(m_audioStream) == AAUDIO_FORMAT_PCM_I16;
+    
+    LOGI("Stream configured: SR=%d, Channels=%d, Frames=%d, %s, %s, %s", 
+         actualSampleRate, actualChannelCount, actualFramesPerBurst, m_outputPcm16 ? "16-bit" : "float",
+         AAudioStream_getSharingMode(m_audioStream) == AAUDIO_SHARING_MODE_EXCLUSIVE ? "exclusive" : "shared",
+         outputModeName(mode));
+    
+    // Update config with actual values
+    if (actualSampleRate != m_config.sampleRate) {
+        LOGD("Sample rate adjusted from %d to %d", m_config.sampleRate, actualSampleRate);
+        m_config.sampleRate = actualSampleRate;
+    }
+    
+    // The deep buffer's callbacks are not the device burst; the low-latency size is kept for the way back
+    if (mode == OutputMode::LOW_LATENCY && actualFramesPerBurst != m_config.framesPerBurst) {
+        LOGD("Frames per burst adjusted from %d to %d", m_config.framesPerBurst, actualFramesPerBurst);
+        m_config.framesPerBurst = actualFramesPerBurst;
+    }
+    
+    // 16-bit devices: the graph renders one burst into this float scratch first
+    int scratchSamples = m_config.framesPerBurst * m_config.channelCount;
+    if (!m_audioBuffer || m_bufferSize.load() < scratchSamples) {
+        m_audioBuffer = std::make_unique<float[]>(scratchSamples);
+        m_bufferSize = scratchSamples;
+    }
+    
+    // A new stream counts from 0; the engine's timeline (playhead, automation) carries on
+    m_streamFrameBase.store(m_streamFramesWritten.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    
+    // Until a timestamp is available, assume the whole device buffer is in flight
+    m_presentationLagFrames.store(AAudioStream_getBufferSizeInFrames(m_audioStream),
+                                  std::memory_order_relaxed);
+    
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::openOutputStream(OutputMode mode, bool holdSampleRate, AAudioStream** stream) {
+    // Low latency tries exclusive float first (MMAP, bit-perfect); power saving shares the
+    // mixer's deep buffer. A device without float output gets 16-bit
+    const int requestedRate = m_config.sampleRate;
+    const aaudio_sharing_mode_t sharingMode = mode == OutputMode::POWER_SAVING
+        ? AAUDIO_SHARING_MODE_SHARED : AAUDIO_SHARING_MODE_EXCLUSIVE;
+    aaudio_format_t format = AAUDIO_FORMAT_PCM_FLOAT;
+    aaudio_result_t result = openAAudioStream(sharingMode, format, mode, stream);
+    if (result == AAUDIO_ERROR_INVALID_FORMAT) {
+        LOGI("Device has no float output, falling back to 16-bit");
+        format = AAUDIO_FORMAT_PCM_I16;
+        result = openAAudioStream(sharingMode, format, mode, stream);
+    }
+    
+    // An exclusive stream runs at the hardware rate. Queued audio is at the source
+    // rate and the program path has no resampler, so let the shared mixer convert
+    if (result == AAUDIO_OK && holdSampleRate && sharingMode == AAUDIO_SHARING_MODE_EXCLUSIVE &&
+        AAudioStream_getSampleRate(*stream) != requestedRate) {
+        LOGI("Device runs at %d Hz, reopening shared at %d Hz", AAudioStream_getSampleRate(*stream), requestedRate);
+        AAudioStream_close(*stream);
+        result = openAAudioStream(AAUDIO_SHARING_MODE_SHARED, format, mode, stream);
+    }
+    
+    if (result != AAUDIO_OK) {
+        LOGE("Failed to open AAudio stream: %s", AAudio_convertResultToText(result));
+        return EngineResult::ERROR_HARDWARE_UNAVAILABLE;
+    }
+    if (holdSampleRate && AAudioStream_getSampleRate(*stream) != requestedRate) {
+        LOGE("Device cannot run at %d Hz", requestedRate);
+        AAudioStream_close(*stream);
+        *stream = nullptr;
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    return EngineResult::SUCCESS;
+}
+
+aaudio_result_t FTLAudioEngine::openAAudioStream(aaudio_sharing_mode_t sharingMode, aaudio_format_t format,
+                                                 OutputMode mode, AAudioStream** stream) {
     // Create AAudio stream builder
     AAudioStreamBuilder* builder = nullptr;
     aaudio_result_t result = AAudio_createStreamBuilder(&builder);
     
     if (result != AAUDIO_OK) {
         LOGE("Failed to create AAudio stream builder: %s", AAudio_convertResultToText(result));
-        return EngineResult::ERROR_HARDWARE_UNAVAILABLE;
+        return result;
     }
     
     // Configure stream builder
@@ -96,53 +346,40 @@ EngineResult FTLAudioEngine::setupAAudioStream() {
     AAudioStreamBuilder_setDirection(builder, AAUDIO_DIRECTION_OUTPUT);
     AAudioStreamBuilder_setSampleRate(builder, m_config.sampleRate);
     AAudioStreamBuilder_setChannelCount(builder, m_config.channelCount);
-    AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_FLOAT);
+    AAudioStreamBuilder_setFormat(builder, format);
+    AAudioStreamBuilder_setSharingMode(builder, sharingMode);
     
     // Performance optimization settings
-    if (m_config.enableLowLatency) {
-        AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    const int32_t deepFrames = msToFrames(m_config.deepBufferMs);
+    if (mode == OutputMode::POWER_SAVING) {
+        // Deep buffer: the device wakes the callback once per half of it
+        AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_POWER_SAVING);
+        AAudioStreamBuilder_setBufferCapacityInFrames(builder, deepFrames);
+        AAudioStreamBuilder_setFramesPerDataCallback(builder, deepFrames / 2);
     } else {
-        AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_NONE);
+        if (m_config.enableLowLatency) {
+            AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+        } else {
+            AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_NONE);
+        }
+        AAudioStreamBuilder_setBufferCapacityInFrames(builder, m_config.framesPerBurst * 2);
+        AAudioStreamBuilder_setFramesPerDataCallback(builder, m_config.framesPerBurst);
     }
     
-    AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
-    AAudioStreamBuilder_setBufferCapacityInFrames(builder, m_config.framesPerBurst * 2);
-    AAudioStreamBuilder_setFramesPerDataCallback(builder, m_config.framesPerBurst);
-    
     // Set callback functions
     AAudioStreamBuilder_setDataCallback(builder, audioCallback, this);
     AAudioStreamBuilder_setErrorCallback(builder, errorCallback, this);
     
     // Create the stream
-    result = AAudioStreamBuilder_openStream(builder, &m_audioStream);
+    result = AAudioStreamBuilder_openStream(builder, stream);
     AAudioStreamBuilder_delete(builder);
-    
     if (result != AAUDIO_OK) {
-        LOGE("Failed to open AAudio stream: %s", AAudio_convertResultToText(result));
-        return EngineResult::ERROR_HARDWARE_UNAVAILABLE;
-    }
-    
-    // Verify stream properties
-    int actualSampleRate = AAudioStream_getSampleRate(m_audioStream);
-    int actualChannelCount = AAudioStream_getChannelCount(m_audioStream);
-    int actualFramesPerBurst = AAudioStream_getFramesPerBurst(m_audioStream);
-    
-    LOGI("Stream configured: SR=%d, Channels=%d, Frames=%d", 
-         actualSampleRate, actualChannelCount, actualFramesPerBurst);
-    
-    // Update config with actual values
-    if (actualSampleRate != m_config.sampleRate) {
-        LOGD("Sample rate adjusted from %d to %d", m_config.sampleRate, actualSampleRate);
-        m_config.sampleRate = actualSampleRate;
-    }
-    
-    if (actualFramesPerBurst != m_config.framesPerBurst) {
-        LOGD("Frames per burst adjusted from %d to %d", m_config.framesPerBurst, actualFramesPerBurst);
-        m_config.framesPerBurst = actualFramesPerBurst;
-        m_bufferSize = actualFramesPerBurst * m_config.channelCount;
+        *stream = nullptr;
+    } else if (mode == OutputMode::POWER_SAVING) {
+        // Use the whole capacity, not the default of a couple of bursts
+        AAudioStream_setBufferSizeInFrames(*stream, deepFrames);
     }
-    
-    return EngineResult::SUCCESS;
+    return result;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -150,8 +387,118 @@ EngineResult FTLAudioEngine::setupAAudioStream() {
 // ═══════════════════════════════════════════════════════════════════════════════════
 
 EngineResult FTLAudioEngine::startPlayback() {
-    if (m_engineState.load() != EngineState::INITIALIZED && 
-        m_engineState.load() != EngineState::PAUSED) {
+    return m_control.call(ControlAction::START, 0);
+}
+
+EngineResult FTLAudioEngine::stopPlayback() {
+    return m_control.call(ControlAction::STOP, 0);
+}
+
+EngineResult FTLAudioEngine::pausePlayback() {
+    return m_control.call(ControlAction::PAUSE, 0);
+}
+
+EngineResult FTLAudioEngine::resumePlayback() {
+    return m_control.call(ControlAction::RESUME, 0);
+}
+
+ControlToken FTLAudioEngine::postCommand(ControlAction action, int64_t argument,
+                                         ControlCallback callback, void* userData) {
+    // Their argument points at data only the waiting caller keeps alive
+    if (action == ControlAction::SET_SOURCE || action == ControlAction::RECONFIGURE) {
+        return 0;
+    }
+    return m_control.post(action, argument, callback, userData);
+}
+
+ControlToken FTLAudioEngine::postConfiguration(const AudioEngineConfig& tuning,
+                                               ControlCallback callback, void* userData) {
+    std::lock_guard<std::mutex> lock(m_postedConfigMutex);
+    m_postedConfigs.push_back(tuning);
+    const ControlToken token = m_control.post(ControlAction::RECONFIGURE,
+                                              reinterpret_cast<intptr_t>(&m_postedConfigs.back()),
+                                              callback, userData);
+    if (token == 0) {
+        m_postedConfigs.pop_back();
+    }
+    return token;
+}
+
+ControlToken FTLAudioEngine::postAudioSource(const std::string& filePath,
+                                             ControlCallback callback, void* userData) {
+    // The engine keeps the path until the command runs; list nodes don't move
+    std::lock_guard<std::mutex> lock(m_postedSourceMutex);
+    m_postedSources.push_back(filePath);
+    const ControlToken token = m_control.post(ControlAction::SET_SOURCE,
+                                              reinterpret_cast<intptr_t>(&m_postedSources.back()),
+                                              callback, userData);
+    if (token == 0) {
+        m_postedSources.pop_back();
+    }
+    return token;
+}
+
+bool FTLAudioEngine::awaitCommand(ControlToken token, int32_t timeoutMs, EngineResult* result) {
+    return m_control.awaitResult(token, std::chrono::milliseconds(std::max(timeoutMs, 0)), result);
+}
+
+ControlStats FTLAudioEngine::getControlStats() const {
+    return m_control.stats();
+}
+
+EngineResult FTLAudioEngine::runCommand(const ControlCommand& command) {
+    // Control thread: the only place playback state changes outside recovery and the callback
+    switch (command.action) {
+        case ControlAction::START:
+        case ControlAction::RESUME:                      // AAudio doesn't distinguish start and resume
+            return startNow();
+        case ControlAction::STOP:
+            return stopNow();
+        case ControlAction::PAUSE:
+            return pauseNow();
+        case ControlAction::SEEK:
+            return seekToFrameNow(command.argument);
+        case ControlAction::SET_OUTPUT_MODE:
+            if (command.argument != static_cast<int64_t>(OutputMode::LOW_LATENCY) &&
+                command.argument != static_cast<int64_t>(OutputMode::POWER_SAVING)) {
+                return EngineResult::ERROR_INVALID_CONFIG;
+            }
+            return setOutputModeNow(static_cast<OutputMode>(command.argument));
+        case ControlAction::SET_SOURCE: {
+            const auto* filePath = reinterpret_cast<const std::string*>(command.argument);
+            const EngineResult result = setAudioSourceNow(*filePath);
+            std::lock_guard<std::mutex> lock(m_postedSourceMutex);
+            m_postedSources.remove_if([filePath](const std::string& posted) { return &posted == filePath; });
+            return result;
+        }
+        case ControlAction::RECONFIGURE: {
+            const auto* config = reinterpret_cast<const AudioEngineConfig*>(command.argument);
+            {
+                // Posted settings only carry the tunable fields: lay them over the live config
+                std::lock_guard<std::mutex> lock(m_postedConfigMutex);
+                for (auto it = m_postedConfigs.begin(); it != m_postedConfigs.end(); ++it) {
+                    if (&*it == config) {
+                        AudioEngineConfig merged = m_config;
+                        applyTuning(merged, *it);
+                        m_postedConfigs.erase(it);
+                        return updateConfigurationNow(merged);
+                    }
+                }
+            }
+            return updateConfigurationNow(*config);
+        }
+    }
+    return EngineResult::ERROR_INVALID_CONFIG;
+}
+
+EngineResult FTLAudioEngine::startNow() {
+    awaitStreamOpen();
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
+    const EngineState state = m_engineState.load();
+    if (state == EngineState::RUNNING) {
+        return EngineResult::ERROR_ALREADY_RUNNING;
+    }
+    if (state != EngineState::INITIALIZED && state != EngineState::PAUSED) {
         LOGE("Engine not ready for playback");
         return EngineResult::ERROR_NOT_INITIALIZED;
     }
@@ -161,12 +508,36 @@ EngineResult FTLAudioEngine::startPlayback() {
         return EngineResult::ERROR_NOT_INITIALIZED;
     }
     
+    m_playRequestNs.store(monotonicNowNs(), std::memory_order_relaxed);
+    m_awaitingFirstAudio.store(true, std::memory_order_release);
+    
+    // Pre-warmed stream already runs: the next burst plays, no device start to wait for
+    if (m_streamWarm.exchange(false, std::memory_order_acq_rel)) {
+        m_engineState = EngineState::RUNNING;
+        {
+            std::lock_guard<std::mutex> lock(m_metricsMutex);
+            m_currentMetrics.callbackCount = 0;
+            m_currentMetrics.missedCallbacks = 0;
+        }
+        publishSnapshot();
+        LOGI("Audio playback started on the pre-warmed stream");
+        return EngineResult::SUCCESS;
+    }
+    
+    // A stream just paused, or a warm one that just idled out, settles before it can start
+    aaudio_stream_state_t streamState = AAudioStream_getState(m_audioStream);
+    if (streamState == AAUDIO_STREAM_STATE_PAUSING || streamState == AAUDIO_STREAM_STATE_STOPPING) {
+        aaudio_stream_state_t settled = AAUDIO_STREAM_STATE_UNINITIALIZED;
+        AAudioStream_waitForStateChange(m_audioStream, streamState, &settled, 100 * 1000 * 1000);
+    }
+    
     m_engineState = EngineState::STARTING;
     
     aaudio_result_t result = AAudioStream_requestStart(m_audioStream);
     if (result != AAUDIO_OK) {
         LOGE("Failed to start audio stream: %s", AAudio_convertResultToText(result));
         m_engineState = EngineState::ERROR;
+        publishSnapshot();
         return EngineResult::ERROR_PROCESSING_FAILED;
     }
     
@@ -178,18 +549,24 @@ EngineResult FTLAudioEngine::startPlayback() {
     
     if (result == AAUDIO_OK && nextState == AAUDIO_STREAM_STATE_STARTED) {
         m_engineState = EngineState::RUNNING;
-        m_currentMetrics.callbackCount = 0;
-        m_currentMetrics.missedCallbacks = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_metricsMutex);
+            m_currentMetrics.callbackCount = 0;
+            m_currentMetrics.missedCallbacks = 0;
+        }
+        publishSnapshot();
         LOGI("Audio playback started successfully");
         return EngineResult::SUCCESS;
     } else {
         LOGE("Failed to start playback, state: %s", AAudio_convertStreamStateToText(nextState));
         m_engineState = EngineState::ERROR;
+        publishSnapshot();
         return EngineResult::ERROR_PROCESSING_FAILED;
     }
 }
 
-EngineResult FTLAudioEngine::stopPlayback() {
+EngineResult FTLAudioEngine::stopNow() {
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
     if (m_engineState.load() != EngineState::RUNNING && 
         m_engineState.load() != EngineState::PAUSED) {
         LOGD("Engine not running, no need to stop");
@@ -200,20 +577,23 @@ EngineResult FTLAudioEngine::stopPlayback() {
         return EngineResult::ERROR_NOT_INITIALIZED;
     }
     
-    m_engineState = EngineState::STOPPING;
+    const EngineState previous = m_engineState.exchange(EngineState::STOPPING);
     
     aaudio_result_t result = AAudioStream_requestStop(m_audioStream);
     if (result != AAUDIO_OK) {
         LOGE("Failed to stop audio stream: %s", AAudio_convertResultToText(result));
+        m_engineState = previous;                        // Still playing or paused: a later stop can retry
         return EngineResult::ERROR_PROCESSING_FAILED;
     }
     
     m_engineState = EngineState::INITIALIZED;
+    publishSnapshot();
     LOGI("Audio playback stopped");
     return EngineResult::SUCCESS;
 }
 
-EngineResult FTLAudioEngine::pausePlayback() {
+EngineResult FTLAudioEngine::pauseNow() {
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
     if (m_engineState.load() != EngineState::RUNNING) {
         return EngineResult::ERROR_NOT_INITIALIZED;
     }
@@ -229,14 +609,11 @@ EngineResult FTLAudioEngine::pausePlayback() {
     }
     
     m_engineState = EngineState::PAUSED;
+    publishSnapshot();
     LOGI("Audio playback paused");
     return EngineResult::SUCCESS;
 }
 
-EngineResult FTLAudioEngine::resumePlayback() {
-    return startPlayback(); // AAudio doesn't distinguish between start and resume
-}
-
 // ═══════════════════════════════════════════════════════════════════════════════════
 // AUDIO PROCESSING CALLBACK
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -249,12 +626,45 @@ aaudio_data_callback_result_t FTLAudioEngine::audioCallback(
 ) {
     auto* engine = static_cast<FTLAudioEngine*>(userData);
     float* outputBuffer = static_cast<float*>(audioData);
+    FTL_TRACE_THREAD_NAME("audio");
+    FTL_TRACE_SCOPE("audioCallback");
     
     // Performance timing start
     auto callbackStart = std::chrono::high_resolution_clock::now();
+    int64_t cpuStart = threadCpuNs();
+    OutputMode mode = engine->m_outputMode.load(std::memory_order_relaxed);
+    
+    // Handed over: what it already buffered drains while it stops; it never touches the graph again
+    if (stream == engine->m_retiredStream.load(std::memory_order_acquire)) {
+        size_t frameBytes = static_cast<size_t>(engine->m_config.channelCount) *
+                            (engine->m_outputPcm16 ? sizeof(int16_t) : sizeof(float));
+        std::memset(audioData, 0, static_cast<size_t>(numFrames) * frameBytes);
+        return AAUDIO_CALLBACK_RESULT_STOP;
+    }
     
-    // Process audio (for now, generate silence or simple test tone)
-    engine->processAudioCallback(outputBuffer, numFrames);
+    bool keepRunning;
+    if (engine->m_handoverActive.load(std::memory_order_acquire)) {
+        // Output mode switch: both streams call back until the old one has drained
+        if (stream != engine->m_handoverFrom.load(std::memory_order_relaxed)) {
+            mode = engine->m_handoverMode;
+        }
+        keepRunning = engine->renderHandover(stream, audioData, numFrames);
+    } else {
+        // Frames written before this burst = stream position of its first frame, on the engine's timeline
+        int64_t streamFrame = engine->m_streamFrameBase.load(std::memory_order_relaxed) +
+                              AAudioStream_getFramesWritten(stream);
+        if (engine->m_streamWarm.load(std::memory_order_acquire)) {
+            return engine->renderWarmSilence(audioData, numFrames, streamFrame);
+        }
+        keepRunning = engine->renderOutput(outputBuffer, numFrames, streamFrame);
+    }
+    
+    // First burst after a route change closes the time-to-resume measurement
+    if (engine->m_awaitingResume.load(std::memory_order_relaxed) &&
+        engine->m_awaitingResume.exchange(false, std::memory_order_acq_rel)) {
+        double resumeMs = (monotonicNowNs() - engine->m_disconnectTimeNs.load(std::memory_order_relaxed)) / 1e6;
+        engine->m_lastRecoveryMs.store(resumeMs, std::memory_order_relaxed);
+    }
     
     // Performance timing end
     auto callbackEnd = std::chrono::high_resolution_clock::now();
@@ -263,37 +673,379 @@ aaudio_data_callback_result_t FTLAudioEngine::audioCallback(
     ).count();
     
     // Update performance metrics
-    engine->updateCallbackMetrics(processingTime);
+    engine->updateCallbackMetrics(processingTime, numFrames);
+    OutputModeCounters& counters = engine->m_modeCounters[static_cast<int>(mode)];
+    counters.callbacks.fetch_add(1, std::memory_order_relaxed);
+    counters.audioNs.fetch_add(static_cast<int64_t>(numFrames) * 1000000000LL / engine->m_config.sampleRate,
+                               std::memory_order_relaxed);
+    counters.callbackCpuNs.fetch_add(threadCpuNs() - cpuStart, std::memory_order_relaxed);
     
-    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+    // A scheduled pause stops the stream from inside the callback
+    return keepRunning ? AAUDIO_CALLBACK_RESULT_CONTINUE : AAUDIO_CALLBACK_RESULT_STOP;
 }
 
-void FTLAudioEngine::processAudioCallback(float* outputBuffer, int32_t numFrames) {
-    // For now, generate a simple test tone or silence
-    // This will be replaced with actual audio processing
+aaudio_data_callback_result_t FTLAudioEngine::renderWarmSilence(void* audioData, int32_t numFrames,
+                                                                 int64_t streamFrame) {
+    // Pre-warmed, nobody playing yet: the device path stays hot, the timeline moves on as silence
+    size_t sampleBytes = m_outputPcm16 ? sizeof(int16_t) : sizeof(float);
+    std::memset(audioData, 0, static_cast<size_t>(numFrames) * m_config.channelCount * sampleBytes);
+    m_playhead.recordSpan(streamFrame, PlayheadTracker::NO_SOURCE, numFrames);
+    m_streamFramesWritten.store(streamFrame + numFrames, std::memory_order_relaxed);
     
+    // Idle too long: stop burning power. Whichever of this and a play claims the stream first wins
+    m_warmFrames += numFrames;
+    if (m_warmFrames >= static_cast<int64_t>(m_config.prewarmIdleMs) * m_config.sampleRate / 1000 &&
+        m_streamWarm.exchange(false, std::memory_order_acq_rel)) {
+        FTL_TRACE_INSTANT("prewarmIdle");
+        return AAUDIO_CALLBACK_RESULT_STOP;
+    }
+    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+bool FTLAudioEngine::renderOutput(void* audioData, int32_t numFrames, int64_t streamFrame) {
+    return m_outputPcm16
+        ? renderPcm16(static_cast<int16_t*>(audioData), numFrames, streamFrame)
+        : processAudioCallback(static_cast<float*>(audioData), numFrames, streamFrame);
+}
+
+bool FTLAudioEngine::renderPcm16(int16_t* outputBuffer, int32_t numFrames, int64_t streamFrame) {
+    // The graph runs in float; convert a scratch burst at a time
+    const int channelCount = m_config.channelCount;
+    const int32_t scratchFrames = m_bufferSize.load(std::memory_order_relaxed) / channelCount;
+    bool keepRunning = true;
+    for (int32_t done = 0; done < numFrames;) {
+        int32_t frames = std::min(scratchFrames, numFrames - done);
+        int16_t* out = outputBuffer + static_cast<size_t>(done) * channelCount;
+        if (keepRunning) {
+            keepRunning = processAudioCallback(m_audioBuffer.get(), frames, streamFrame + done);
+            pcm::floatToS16(m_audioBuffer.get(), out, static_cast<size_t>(frames) * channelCount);
+        } else {
+            std::fill(out, out + static_cast<size_t>(frames) * channelCount, static_cast<int16_t>(0));
+        }
+        done += frames;
+    }
+    return keepRunning;
+}
+
+bool FTLAudioEngine::processAudioCallback(float* outputBuffer, int32_t numFrames, int64_t streamFrame) {
     int totalSamples = numFrames * m_config.channelCount;
+    int channelCount = m_config.channelCount;
     
-    if (m_config.enableDSPProcessing) {
-        // Generate a quiet test tone at 440Hz for verification
-        static double phase = 0.0;
-        double phaseIncrement = 2.0 * M_PI * 440.0 / m_config.sampleRate;
-        
-        for (int i = 0; i < numFrames; ++i) {
-            float sample = 0.1f * sin(phase); // Quiet 440Hz tone
-            for (int ch = 0; ch < m_config.channelCount; ++ch) {
-                outputBuffer[i * m_config.channelCount + ch] = sample;
+    // The limiter's delay line sits between the playhead and the speaker
+    refreshLimiter();
+    int64_t audibleFrame = streamFrame + (m_limiterActive ? m_limiter.latencyFrames() : 0);
+    StageClock stages(m_offlineStats);
+    
+    m_burstSourceFrames = 0;
+    if (m_hasSource.load(std::memory_order_acquire)) {
+        FTL_TRACE_COUNTER("decodeRingFrames", m_decodeRing.availableToRead());
+        renderSource(outputBuffer, numFrames, audibleFrame);
+        stages.lap(&OfflineRenderStats::sourceMs);
+        applyLoudness(outputBuffer, numFrames);
+        stages.lap(&OfflineRenderStats::loudnessMs);
+        applyEqualizer(outputBuffer, numFrames);
+        stages.lap(&OfflineRenderStats::eqMs);
+    } else if (m_dspEnabled.load(std::memory_order_relaxed)) {
+        // Generate a quiet test tone at 440Hz for verification, then spread it
+        // to every channel from the last frame back so the mono run is not overwritten
+        m_testTone.setFrequency(440.0, m_config.sampleRate);
+        m_testTone.render(outputBuffer, numFrames, 0.1f);
+        for (int i = numFrames - 1; i >= 0; --i) {
+            float sample = outputBuffer[i];
+            for (int ch = 0; ch < channelCount; ++ch) {
+                outputBuffer[i * channelCount + ch] = sample;
             }
-            phase += phaseIncrement;
-            if (phase > 2.0 * M_PI) phase -= 2.0 * M_PI;
         }
     } else {
         // Generate silence
         std::fill(outputBuffer, outputBuffer + totalSamples, 0.0f);
     }
+    
+    if (!m_hasSource.load(std::memory_order_relaxed)) {
+        m_playhead.recordSpan(audibleFrame, PlayheadTracker::NO_SOURCE, numFrames);
+    }
+    
+    // Split the burst at automation events so each one lands on its exact frame
+    BurstClock clock;
+    clock.outputFrame = m_framesRendered.load(std::memory_order_relaxed);
+    clock.sourceFrame = m_burstSourceFrame;
+    clock.sourceFrames = m_burstSourceFrames;
+    clock.sourceRate = m_burstSourceRate;
+    m_automation.drain();
+    
+    bool keepRunning = true;
+    for (int32_t done = 0; done < numFrames;) {
+        int32_t next = m_automation.nextEventOffset(clock, done, numFrames);
+        if (next > done) {
+            mixSpan(outputBuffer, done, next);
+            done = next;
+            continue;
+        }
+        AutomationEvent event;
+        while (keepRunning && m_automation.popDue(clock, done, event)) {
+            keepRunning = applyAutomation(event);
+        }
+        if (!keepRunning) {
+            std::fill(outputBuffer + done * channelCount, outputBuffer + totalSamples, 0.0f);
+            break;
+        }
+    }
+    
+    stages.lap(&OfflineRenderStats::mixMs);
+    
+    // Last stage: nothing leaves above the true-peak ceiling
+    if (m_limiterActive) {
+        m_limiter.process(outputBuffer, numFrames);
+        m_limiterReductionDb.store(m_limiter.lastReductionDb(), std::memory_order_relaxed);
+    }
+    stages.lap(&OfflineRenderStats::limiterMs);
+    
+    // Per-channel peak of this burst for the level meters
+    int meteredChannels = std::min(channelCount, SNAPSHOT_MAX_CHANNELS);
+    for (int ch = 0; ch < meteredChannels; ++ch) {
+        float peak = 0.0f;
+        for (int i = ch; i < totalSamples; i += channelCount) {
+            peak = std::max(peak, std::fabs(outputBuffer[i]));
+        }
+        m_burstPeaks[ch].store(peak, std::memory_order_relaxed);
+    }
+    stages.lap(&OfflineRenderStats::meterMs);
+    
+    if (m_awaitingFirstAudio.load(std::memory_order_relaxed)) {
+        stampFirstAudio(outputBuffer, numFrames);
+    }
+    
+    m_framesRendered.fetch_add(numFrames, std::memory_order_relaxed);
+    m_streamFramesWritten.store(streamFrame + numFrames, std::memory_order_relaxed);
+    return keepRunning;
+}
+
+void FTLAudioEngine::stampFirstAudio(const float* outputBuffer, int32_t numFrames) {
+    const int channelCount = m_config.channelCount;
+    const int32_t totalSamples = numFrames * channelCount;
+    for (int32_t i = 0; i < totalSamples; ++i) {
+        if (outputBuffer[i] == 0.0f) continue;
+        if (!m_awaitingFirstAudio.exchange(false, std::memory_order_acq_rel)) return;
+        // Reaches the speaker after everything already queued and its place in this burst
+        int64_t elapsedNs = monotonicNowNs() - m_playRequestNs.load(std::memory_order_relaxed);
+        int64_t queuedFrames = m_presentationLagFrames.load(std::memory_order_relaxed) + i / channelCount;
+        m_timeToFirstAudioMs.store(elapsedNs / 1e6 + queuedFrames * 1000.0 / m_config.sampleRate,
+                                   std::memory_order_relaxed);
+        return;
+    }
 }
 
-void FTLAudioEngine::updateCallbackMetrics(double processingTimeUs) {
+void FTLAudioEngine::mixSpan(float* outputBuffer, int32_t from, int32_t to) {
+    int channelCount = m_config.channelCount;
+    
+    // Main program bus gain, then every live voice on top
+    applyGainRamp(m_programGain, outputBuffer + from * channelCount, to - from, channelCount);
+    m_mixer.render(outputBuffer + from * channelCount, to - from);
+}
+
+void FTLAudioEngine::applyLoudness(float* outputBuffer, int32_t numFrames) {
+    FTL_TRACE_SCOPE("loudness");
+    uint32_t serial = m_loudnessTrackSerial.load(std::memory_order_acquire);
+    if (serial != m_seenLoudnessSerial) {
+        m_seenLoudnessSerial = serial;
+        m_loudness.reset();
+    }
+    
+    float gainDb = 0.0f;
+    if (m_loudnessEnabled.load(std::memory_order_relaxed)) {
+        // Measure the track itself: before its gain, and only frames that carry it
+        m_loudness.setTargetLufs(m_loudnessTargetLufs.load(std::memory_order_relaxed));
+        float trackLufs = m_trackLoudnessLufs.load(std::memory_order_relaxed);
+        if (trackLufs != UNKNOWN_TRACK_LOUDNESS) {
+            m_loudness.setTrackLoudness(trackLufs);
+        } else {
+            m_loudness.clearTrackLoudness();
+        }
+        m_loudness.process(outputBuffer, m_burstSourceFrames);
+        m_integratedLufs.store(static_cast<float>(m_loudness.meter().integratedLufs()), std::memory_order_relaxed);
+        gainDb = m_loudness.gainDb();
+    }
+    if (gainDb != m_loudnessGainDb) {
+        m_loudnessGainDb = gainDb;
+        m_loudnessGain.setTarget(std::pow(10.0f, gainDb / 20.0f), msToFrames(LOUDNESS_RAMP_MS));
+    }
+    applyGainRamp(m_loudnessGain, outputBuffer, numFrames, m_config.channelCount);
+}
+
+void FTLAudioEngine::applyEqualizer(float* outputBuffer, int32_t numFrames) {
+    FTL_TRACE_SCOPE("equalizer");
+    // The analysis hears the program before the EQ, so the loop never chases its own output
+    if (m_adaptiveEq.tapEnabled() && m_burstSourceFrames > 0) {
+        m_adaptiveEq.tap(outputBuffer, m_burstSourceFrames);
+    }
+    m_equalizer.process(outputBuffer, numFrames);
+}
+
+void FTLAudioEngine::refreshLimiter() {
+    bool enabled = m_limiterEnabled.load(std::memory_order_relaxed);
+    if (enabled != m_limiterActive) {
+        m_limiterActive = enabled;
+        m_limiter.reset();
+        m_limiterReductionDb.store(0.0f, std::memory_order_relaxed);
+    }
+    float ceilingDb = m_limiterCeilingDb.load(std::memory_order_relaxed);
+    if (ceilingDb != m_limiter.ceilingDb()) {
+        m_limiter.setCeilingDb(ceilingDb);
+    }
+}
+
+bool FTLAudioEngine::applyAutomation(const AutomationEvent& event) {
+    switch (event.action) {
+        case AutomationAction::PROGRAM_GAIN:
+            m_programGain.setTarget(event.value, event.rampFrames);
+            return true;
+        case AutomationAction::VOICE_GAIN:
+            m_mixer.setGain(event.voiceId, event.value, event.rampFrames);
+            return true;
+        case AutomationAction::VOICE_STOP:
+            m_mixer.stop(event.voiceId, event.rampFrames);
+            return true;
+        case AutomationAction::PAUSE: {
+            // The audio thread can't post to the control thread (posting wakes it under a mutex).
+            // Only RUNNING -> PAUSED, so a stop the control thread just made is never undone
+            EngineState running = EngineState::RUNNING;
+            m_engineState.compare_exchange_strong(running, EngineState::PAUSED);
+            return false;
+        }
+    }
+    return true;
+}
+
+void FTLAudioEngine::renderSource(float* outputBuffer, int32_t numFrames, int64_t streamFrame) {
+    FTL_TRACE_SCOPE("renderSource");
+    int channelCount = m_config.channelCount;
+    
+    // While a seek is in flight the ring holds pre-seek audio - play silence instead
+    bool seekPending = applySeekCommit();
+    int32_t framesRead = 0;
+    if (m_config.enableTimeStretch && !seekPending) {
+        framesRead = renderStretched(outputBuffer, numFrames, streamFrame);
+    } else {
+        framesRead = seekPending ? 0 : m_decodeRing.read(outputBuffer, numFrames);
+        int64_t readHead = m_readHeadFrame.load(std::memory_order_relaxed);
+        m_burstSourceFrame = readHead;
+        m_burstSourceFrames = framesRead;
+        m_burstSourceRate = 1.0;
+        m_playhead.recordSpan(streamFrame, readHead, framesRead);
+        m_readHeadFrame.store(readHead + framesRead, std::memory_order_relaxed);
+    }
+    
+    if (framesRead < numFrames) {
+        std::fill(outputBuffer + framesRead * channelCount, outputBuffer + numFrames * channelCount, 0.0f);
+        m_playhead.recordSpan(streamFrame + framesRead, PlayheadTracker::NO_SOURCE, numFrames - framesRead);
+        if (!seekPending && !m_sourceEnded.load(std::memory_order_acquire)) {
+            FTL_TRACE_INSTANT("decodeRingStarved");
+            m_starvedCallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    if (framesRead > 0 && m_awaitingSeekAudio) {
+        // First post-seek frame reaches the speaker after everything already queued
+        m_awaitingSeekAudio = false;
+        int64_t elapsedNs = monotonicNowNs() - m_seekRequestTimeNs.load(std::memory_order_relaxed);
+        double queuedMs = m_presentationLagFrames.load(std::memory_order_relaxed) * 1000.0 / m_config.sampleRate;
+        m_lastSeekLatencyMs.store(elapsedNs / 1e6 + queuedMs, std::memory_order_relaxed);
+    }
+}
+
+int32_t FTLAudioEngine::renderStretched(float* outputBuffer, int32_t numFrames, int64_t streamFrame) {
+    FTL_TRACE_SCOPE("timeStretch");
+    m_stretcher.setTempo(m_tempo.load(std::memory_order_relaxed));
+    m_stretcher.setPitchSemitones(m_pitchSemitones.load(std::memory_order_relaxed));
+    
+    // Every output frame maps back to a source position: the burst's source span and its rate
+    double before = m_stretcher.inputPosition();
+    int32_t produced = m_stretcher.process(outputBuffer, numFrames, &FTLAudioEngine::pullStretchInput, this);
+    double after = m_stretcher.inputPosition();
+    double rate = produced > 0 ? (after - before) / produced : m_tempo.load(std::memory_order_relaxed);
+    
+    // Past the end of the source the stretcher plays out padding: that part is silence
+    int32_t sourceFrames = produced;
+    if (m_stretchInputEnd >= 0 && after > static_cast<double>(m_stretchInputEnd)) {
+        double remaining = std::max(0.0, static_cast<double>(m_stretchInputEnd) - before);
+        sourceFrames = std::min(produced, static_cast<int32_t>(std::ceil(remaining / rate)));
+    }
+    
+    int64_t sourceFrame = m_stretchOrigin + std::llround(before);
+    m_burstSourceFrame = sourceFrame;
+    m_burstSourceFrames = sourceFrames;
+    m_burstSourceRate = rate;
+    m_playhead.recordSpan(streamFrame, sourceFrame, sourceFrames, rate);
+    return sourceFrames;
+}
+
+int32_t FTLAudioEngine::pullStretchInput(float* frames, int32_t count, void* userData) {
+    auto* engine = static_cast<FTLAudioEngine*>(userData);
+    int32_t got = engine->m_decodeRing.read(frames, count);
+    int64_t readHead = engine->m_readHeadFrame.load(std::memory_order_relaxed) + got;
+    engine->m_readHeadFrame.store(readHead, std::memory_order_relaxed);
+    
+    // The source has ended: silence after it lets the frames still inside the stretcher out
+    if (got < count && engine->m_sourceEnded.load(std::memory_order_acquire) &&
+        engine->m_decodeRing.availableToRead() == 0) {
+        if (engine->m_stretchInputEnd < 0) {
+            engine->m_stretchInputEnd = readHead - engine->m_stretchOrigin;
+        }
+        int channelCount = engine->m_config.channelCount;
+        std::fill(frames + static_cast<size_t>(got) * channelCount, frames + static_cast<size_t>(count) * channelCount, 0.0f);
+        got = count;
+    }
+    return got;
+}
+
+void FTLAudioEngine::resetStretcher(int64_t sourceFrame) {
+    m_stretcher.setMode(m_stretchMode.load(std::memory_order_relaxed));
+    m_stretcher.setTempo(m_tempo.load(std::memory_order_relaxed));
+    m_stretcher.setPitchSemitones(m_pitchSemitones.load(std::memory_order_relaxed));
+    m_stretcher.reset();
+    m_stretchOrigin = sourceFrame;
+    m_stretchInputEnd = -1;
+}
+
+bool FTLAudioEngine::stretcherHoldsSource() const {
+    if (!m_config.enableTimeStretch) {
+        return false;
+    }
+    return m_stretchInputEnd < 0 || m_stretcher.inputPosition() < static_cast<double>(m_stretchInputEnd);
+}
+
+bool FTLAudioEngine::applySeekCommit() {
+    uint32_t requested = m_seekRequestSerial.load(std::memory_order_acquire);
+    if (requested == m_appliedSeekSerial) {
+        return false;
+    }
+    
+    uint32_t sequence = m_seekCommitSequence.load(std::memory_order_acquire);
+    if (sequence & 1u) {
+        return true;
+    }
+    uint32_t serial = m_seekCommitSerial.load(std::memory_order_relaxed);
+    int64_t flushPosition = m_seekCommitFlushPosition.load(std::memory_order_relaxed);
+    int64_t sourceFrame = m_seekCommitFrame.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_seekCommitSequence.load(std::memory_order_relaxed) != sequence ||
+        serial == m_appliedSeekSerial) {
+        return true; // Decode thread has not handled the request yet
+    }
+    
+    m_decodeRing.discardUntil(flushPosition);
+    m_readHeadFrame.store(sourceFrame, std::memory_order_relaxed);
+    if (m_config.enableTimeStretch) {
+        resetStretcher(sourceFrame);
+    }
+    m_appliedSeekSerial = serial;
+    m_awaitingSeekAudio = true;
+    
+    // A newer request may already be queued behind this one
+    return serial != requested;
+}
+
+void FTLAudioEngine::updateCallbackMetrics(double processingTimeUs, int32_t numFrames) {
     std::lock_guard<std::mutex> lock(m_metricsMutex);
     
     m_currentMetrics.callbackCount++;
@@ -306,13 +1058,17 @@ void FTLAudioEngine::updateCallbackMetrics(double processingTimeUs) {
     }
     
     // Calculate callback load (percentage of available time used)
-    double availableTimeUs = (1000000.0 * m_config.framesPerBurst) / m_config.sampleRate;
+    double availableTimeUs = (1000000.0 * numFrames) / m_config.sampleRate;
     m_currentMetrics.callbackLoad = (processingTimeUs / availableTimeUs) * 100.0;
     
     // Check for potential underruns
     if (m_currentMetrics.callbackLoad > 80.0) { // More than 80% of available time used
         m_currentMetrics.bufferUnderruns++;
     }
+    m_currentMetrics.bufferUnderruns += m_starvedCallbacks.exchange(0, std::memory_order_relaxed);
+    
+    // Never spin on the audio thread - a skipped publish is picked up next burst
+    m_snapshot.tryPublish(buildSnapshotData(m_currentMetrics));
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -345,7 +1101,9 @@ EngineResult FTLAudioEngine::processAudioBuffer(
 // ═══════════════════════════════════════════════════════════════════════════════════
 
 double FTLAudioEngine::measureLatency() {
-    if (!m_audioStream) {
+    // Never wait on a route-change reopen: no measurement this time
+    std::unique_lock<std::mutex> streamLock(m_streamMutex, std::try_to_lock);
+    if (!streamLock.owns_lock() || !m_audioStream) {
         return -1.0;
     }
     
@@ -357,22 +1115,32 @@ double FTLAudioEngine::measureLatency() {
                                                       &framePosition, &timeNs);
     
     if (result == AAUDIO_OK) {
-        // Calculate latency based on buffer sizes and frame position
         int32_t bufferSize = AAudioStream_getBufferSizeInFrames(m_audioStream);
         int32_t framesPerBurst = AAudioStream_getFramesPerBurst(m_audioStream);
         
-        // Estimate total latency
-        double bufferLatencyMs = (double)(bufferSize + framesPerBurst) * 1000.0 / m_config.sampleRate;
+        // Frames queued ahead of the DAC: written minus presented, aged forward to now
+        int64_t framesWritten = AAudioStream_getFramesWritten(m_audioStream);
+        double presentedNow = framePosition +
+            (monotonicNowNs() - timeNs) * static_cast<double>(m_config.sampleRate) / 1e9;
+        double queuedFrames = std::max(0.0, framesWritten - presentedNow);
+        m_presentationLagFrames.store(static_cast<int64_t>(queuedFrames), std::memory_order_relaxed);
         
-        std::lock_guard<std::mutex> lock(m_metricsMutex);
-        m_currentMetrics.totalLatencyMs = bufferLatencyMs;
-        m_currentMetrics.outputLatencyMs = bufferLatencyMs * 0.8; // Estimate
-        m_currentMetrics.inputLatencyMs = bufferLatencyMs * 0.2;  // Estimate
+        // Plus one burst of callback scheduling ahead of the write
+        double outputLatencyMs = queuedFrames * 1000.0 / m_config.sampleRate;
+        double totalLatencyMs = (queuedFrames + framesPerBurst) * 1000.0 / m_config.sampleRate;
         
-        LOGD("Measured latency: %.2f ms (target: %.2f ms)", 
-             bufferLatencyMs, m_config.targetLatencyMs);
+        {
+            std::lock_guard<std::mutex> lock(m_metricsMutex);
+            m_currentMetrics.totalLatencyMs = totalLatencyMs;
+            m_currentMetrics.outputLatencyMs = outputLatencyMs;
+            m_currentMetrics.inputLatencyMs = 0.0; // Output-only stream
+        }
+        publishSnapshot();
+        
+        LOGD("Measured latency: %.2f ms (queued %.0f of %d frames, target: %.2f ms)", 
+             totalLatencyMs, queuedFrames, bufferSize, m_config.targetLatencyMs);
         
-        return bufferLatencyMs;
+        return totalLatencyMs;
     }
     
     return -1.0;
@@ -384,22 +1152,964 @@ double FTLAudioEngine::measureLatency() {
 
 PerformanceMetrics FTLAudioEngine::getPerformanceMetrics() const {
     std::lock_guard<std::mutex> lock(m_metricsMutex);
-    return m_currentMetrics;
+    PerformanceMetrics metrics = m_currentMetrics;
+    metrics.streamRecoveries = m_streamRecoveries.load(std::memory_order_relaxed);
+    metrics.lastRecoveryMs = m_lastRecoveryMs.load(std::memory_order_relaxed);
+    metrics.timeToFirstAudioMs = m_timeToFirstAudioMs.load(std::memory_order_relaxed);
+    return metrics;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════════
-// CONFIGURATION
+// SHARED SNAPSHOT
 // ═══════════════════════════════════════════════════════════════════════════════════
 
-EngineResult FTLAudioEngine::updateConfiguration(const AudioEngineConfig& config) {
+EngineSnapshot* FTLAudioEngine::getSnapshotBuffer() {
+    return m_snapshot.buffer();
+}
+
+EngineSnapshotData FTLAudioEngine::readSnapshot() const {
+    return m_snapshot.read();
+}
+
+EngineSnapshotData FTLAudioEngine::buildSnapshotData(const PerformanceMetrics& metrics) const {
+    EngineSnapshotData data;
+    data.engineState = static_cast<int32_t>(m_engineState.load(std::memory_order_relaxed));
+    data.sampleRate = m_config.sampleRate;
+    data.channelCount = m_config.channelCount;
+    data.framesPerBurst = m_config.framesPerBurst;
+    
+    // Audible estimate from the last measured presentation lag
+    int64_t presented = m_streamFramesWritten.load(std::memory_order_relaxed) -
+                        m_presentationLagFrames.load(std::memory_order_relaxed);
+    int64_t playhead = m_playhead.sourceFrameAt(presented);
+    data.playheadFrame = playhead != PlayheadTracker::NO_SOURCE
+        ? playhead : m_readHeadFrame.load(std::memory_order_relaxed);
+    data.framesRendered = m_framesRendered.load(std::memory_order_relaxed);
+    data.callbackCount = static_cast<int64_t>(metrics.callbackCount);
+    data.missedCallbacks = static_cast<int64_t>(metrics.missedCallbacks);
+    data.bufferUnderruns = static_cast<int64_t>(metrics.bufferUnderruns);
+    data.bufferOverruns = static_cast<int64_t>(metrics.bufferOverruns);
+    
+    data.averageProcessingTimeUs = metrics.averageProcessingTimeUs;
+    data.maxProcessingTimeUs = metrics.maxProcessingTimeUs;
+    data.callbackLoad = metrics.callbackLoad;
+    data.cpuUsagePercent = metrics.cpuUsagePercent;
+    data.memoryUsageMB = metrics.memoryUsageMB;
+    data.totalLatencyMs = metrics.totalLatencyMs;
+    data.outputLatencyMs = metrics.outputLatencyMs;
+    
+    data.publishTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+    for (int ch = 0; ch < SNAPSHOT_MAX_CHANNELS; ++ch) {
+        data.peakLevels[ch] = m_burstPeaks[ch].load(std::memory_order_relaxed);
+    }
+    data.streamRecoveries = static_cast<int64_t>(m_streamRecoveries.load(std::memory_order_relaxed));
+    data.lastRecoveryMs = m_lastRecoveryMs.load(std::memory_order_relaxed);
+    data.timeToFirstAudioMs = m_timeToFirstAudioMs.load(std::memory_order_relaxed);
+    return data;
+}
+
+void FTLAudioEngine::publishSnapshot() {
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    m_snapshot.publish(buildSnapshotData(m_currentMetrics));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SOURCE PLAYBACK & SEEKING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setAudioSource(const std::string& filePath) {
+    return m_control.call(ControlAction::SET_SOURCE, reinterpret_cast<intptr_t>(&filePath));
+}
+
+EngineResult FTLAudioEngine::setAudioSourceNow(const std::string& filePath) {
+    EngineState state = m_engineState.load();
+    if (state == EngineState::UNINITIALIZED || state == EngineState::ERROR) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    
+    // The queued track was opened (and its first burst read) ahead of time
+    std::unique_ptr<AudioSource> source;
+    IoStats counted;
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (m_prefetchedSource && m_prefetchedPath == filePath) {
+            source = std::move(m_prefetchedSource);
+            m_prefetchedPath.clear();
+            counted = source->ioStats();
+        }
+    }
+    if (!source) {
+        source = openAudioSource(filePath, sourceReadBufferBytes());
+    }
+    if (!source) {
+        LOGE("Cannot play %s", filePath.c_str());
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    const AudioSourceInfo& info = source->info();
+    stopDecodeThread();
+    
+    // No resampler yet: the stream must run at the source rate
+    if (info.sampleRate != m_config.sampleRate) {
+        if (state != EngineState::INITIALIZED) {
+            LOGE("Source rate %d Hz differs from running stream (%d Hz) - stop playback first",
+                 info.sampleRate, m_config.sampleRate);
+            startDecodeThread();
+            return EngineResult::ERROR_ALREADY_RUNNING;
+        }
+        
+        const int32_t previousRate = m_config.sampleRate;
+        const int64_t resumeFrame = getPlayheadFrame();     // Stopped: where the current track stands
+        EngineResult result = EngineResult::SUCCESS;
+        awaitStreamOpen();
+        {
+            std::lock_guard<std::mutex> streamLock(m_streamMutex);
+            cleanupAAudioStream();
+            m_config.sampleRate = info.sampleRate;
+            if (!m_config.offlineRender) {
+                result = setupAAudioStream(true);
+            }
+        }
+        reconfigureForRate();
+        if (result != EngineResult::SUCCESS || m_config.sampleRate != info.sampleRate) {
+            LOGE("Cannot open stream at %d Hz - keeping the current track", info.sampleRate);
+            if (result == EngineResult::SUCCESS) {
+                result = EngineResult::ERROR_INVALID_CONFIG;
+            }
+            
+            // Back to the previous rate, so the current track still plays
+            EngineResult restored = EngineResult::SUCCESS;
+            {
+                std::lock_guard<std::mutex> streamLock(m_streamMutex);
+                cleanupAAudioStream();
+                m_config.sampleRate = previousRate;
+                if (!m_config.offlineRender) {
+                    restored = setupAAudioStream(true);
+                }
+                if (restored == EngineResult::SUCCESS && m_config.sampleRate == previousRate) {
+                    prewarm();
+                }
+            }
+            reconfigureForRate();
+            if (restored != EngineResult::SUCCESS || m_config.sampleRate != previousRate) {
+                LOGE("Cannot reopen stream at %d Hz either", previousRate);
+                m_hasSource.store(false, std::memory_order_release);
+                m_source.reset();
+                m_engineState = EngineState::ERROR;
+                publishSnapshot();
+                return result;
+            }
+            if (m_hasSource.load(std::memory_order_acquire)) {
+                seekToFrameNow(resumeFrame);                 // The rings were resized: refill from the playhead
+                startDecodeThread();
+            }
+            publishSnapshot();
+            return result;
+        }
+        std::lock_guard<std::mutex> streamLock(m_streamMutex);
+        prewarm();
+    }
+    
+    LOGI("Source: %s %d Hz, %d ch, %d bit, %lld frames", info.codec.c_str(), info.sampleRate,
+         info.channelCount, info.bitsPerSample, static_cast<long long>(info.totalFrames));
+    
+    // Mapped sidecar gives O(1) seeks; without one, build it while the track plays
+    stopSeekIndexBuild();
+    if (!m_seekIndexDirectory.empty()) {
+        std::string sidecar = SeekIndex::sidecarPath(m_seekIndexDirectory, filePath);
+        if (!source->loadSeekIndex(sidecar) && info.codec == "flac") {
+            startSeekIndexBuild(filePath, sidecar);
+        }
+    }
+    
+    // A new track is a seek to frame 0: the callback flushes the old track's audio
+    if (m_source) {
+        retireIoStats(m_source->ioStats(), m_sourceIoCounted);
+    }
+    m_sourceIoCounted = counted;
+    m_liveReadRequests.store(0, std::memory_order_relaxed);
+    m_liveBytesRead.store(0, std::memory_order_relaxed);
+    m_source = std::move(source);
+    m_trackLoudnessLufs.store(UNKNOWN_TRACK_LOUDNESS, std::memory_order_relaxed);
+    m_loudnessTrackSerial.fetch_add(1, std::memory_order_release);
+    m_adaptiveEq.resetAnalysis();
+    m_seekTarget.store(0, std::memory_order_relaxed);
+    m_seekRequestTimeNs.store(monotonicNowNs(), std::memory_order_relaxed);
+    m_seekRequestSerial.fetch_add(1, std::memory_order_release);
+    m_hasSource.store(true, std::memory_order_release);
+    
+    startDecodeThread();
+    publishSnapshot();
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::seekToFrame(int64_t sourceFrame) {
+    return m_control.call(ControlAction::SEEK, sourceFrame);
+}
+
+EngineResult FTLAudioEngine::seekToFrameNow(int64_t sourceFrame) {
+    if (!m_hasSource.load(std::memory_order_acquire)) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    if (sourceFrame < 0) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    int64_t totalFrames = m_source->info().totalFrames;
+    if (totalFrames >= 0) {
+        sourceFrame = std::min(sourceFrame, totalFrames);
+    }
+    
+    m_seekTarget.store(sourceFrame, std::memory_order_relaxed);
+    m_seekRequestTimeNs.store(monotonicNowNs(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_seekRequestSerial.fetch_add(1, std::memory_order_release);
+    }
+    m_decodeWake.notify_one();
+    return EngineResult::SUCCESS;
+}
+
+int64_t FTLAudioEngine::getPlayheadFrame() {
+    if (!m_hasSource.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    
+    // A pending seek is already the answer the UI wants to show
+    if (m_seekRequestSerial.load(std::memory_order_acquire) !=
+        m_seekCommitSerial.load(std::memory_order_acquire)) {
+        return m_seekTarget.load(std::memory_order_relaxed);
+    }
+    
+    int64_t presented = m_streamFramesWritten.load(std::memory_order_relaxed) -
+                        m_presentationLagFrames.load(std::memory_order_relaxed);
+    
+    int64_t framePosition = 0;
+    int64_t timeNs = 0;
+    std::unique_lock<std::mutex> streamLock(m_streamMutex, std::try_to_lock);
+    if (streamLock.owns_lock() && m_audioStream && m_engineState.load() == EngineState::RUNNING &&
+        AAudioStream_getTimestamp(m_audioStream, CLOCK_MONOTONIC, &framePosition, &timeNs) == AAUDIO_OK) {
+        // Extrapolate the DAC position from the timestamp to now (stream frames -> engine timeline)
+        int64_t base = m_streamFrameBase.load(std::memory_order_relaxed);
+        int64_t framesWritten = base + AAudioStream_getFramesWritten(m_audioStream);
+        presented = base + framePosition + (monotonicNowNs() - timeNs) * m_config.sampleRate / 1000000000LL;
+        presented = std::min(presented, framesWritten);
+        m_presentationLagFrames.store(framesWritten - presented, std::memory_order_relaxed);
+    }
+    
+    int64_t playhead = m_playhead.sourceFrameAt(presented);
+    return playhead != PlayheadTracker::NO_SOURCE ? playhead : m_readHeadFrame.load(std::memory_order_relaxed);
+}
+
+double FTLAudioEngine::getLastSeekLatencyMs() const {
+    return m_lastSeekLatencyMs.load(std::memory_order_relaxed);
+}
+
+void FTLAudioEngine::setSeekIndexDirectory(const std::string& directory) {
+    m_seekIndexDirectory = directory;
+}
+
+EngineResult FTLAudioEngine::prefetchNextSource(const std::string& filePath) {
+    EngineState state = m_engineState.load();
+    if (state == EngineState::UNINITIALIZED || state == EngineState::ERROR) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        m_prefetchRequest = filePath;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_prefetchRequested.store(true, std::memory_order_release);
+    }
+    m_decodeWake.notify_one();
+    return EngineResult::SUCCESS;
+}
+
+DecodeActivity FTLAudioEngine::getDecodeActivity() const {
+    DecodeActivity activity;
+    activity.wakeups = m_decodeWakeups.load(std::memory_order_relaxed);
+    activity.readRequests = m_retiredReadRequests.load(std::memory_order_relaxed) +
+                            m_liveReadRequests.load(std::memory_order_relaxed);
+    activity.bytesRead = m_retiredBytesRead.load(std::memory_order_relaxed) +
+                         m_liveBytesRead.load(std::memory_order_relaxed);
+    return activity;
+}
+
+size_t FTLAudioEngine::sourceReadBufferBytes() const {
+    return m_config.burstPrefetch || m_config.enablePowerSaving ? PREFETCH_READ_BYTES
+                                                                : FileReader::DEFAULT_BUFFER_SIZE;
+}
+
+void FTLAudioEngine::retireIoStats(const IoStats& stats, const IoStats& counted) {
+    m_retiredReadRequests.fetch_add(stats.readRequests - counted.readRequests, std::memory_order_relaxed);
+    m_retiredBytesRead.fetch_add(stats.bytesRead - counted.bytesRead, std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MIXER VOICES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::playVoice(const std::string& filePath, float gain, int32_t fadeInMs, int32_t* voiceId) {
+    EngineState state = m_engineState.load();
+    if (state == EngineState::UNINITIALIZED || state == EngineState::ERROR) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    
+    // Any rate and layout: the mixer converts on its feeder thread
+    std::unique_ptr<AudioSource> source = openAudioSource(filePath);
+    if (!source) {
+        LOGE("Cannot play voice %s", filePath.c_str());
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    int32_t id = m_mixer.play(std::move(source), gain, msToFrames(fadeInMs));
+    if (id == VoiceMixer::INVALID_VOICE) {
+        return EngineResult::ERROR_NO_VOICE_AVAILABLE;
+    }
+    if (voiceId) {
+        *voiceId = id;
+    }
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setVoiceGain(int32_t voiceId, float gain, int32_t rampMs) {
+    return m_mixer.setGain(voiceId, gain, msToFrames(rampMs))
+        ? EngineResult::SUCCESS : EngineResult::ERROR_INVALID_CONFIG;
+}
+
+EngineResult FTLAudioEngine::stopVoice(int32_t voiceId, int32_t fadeOutMs) {
+    return m_mixer.stop(voiceId, msToFrames(fadeOutMs))
+        ? EngineResult::SUCCESS : EngineResult::ERROR_INVALID_CONFIG;
+}
+
+EngineResult FTLAudioEngine::setProgramGain(float gain, int32_t rampMs) {
+    if (gain < 0.0f) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_programGain.setTarget(gain, msToFrames(rampMs));
+    return EngineResult::SUCCESS;
+}
+
+int FTLAudioEngine::getActiveVoiceCount() const {
+    return m_mixer.activeVoiceCount();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// AUTOMATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::scheduleAutomation(const AutomationEvent& event, uint32_t* eventId) {
+    if (m_engineState.load() == EngineState::UNINITIALIZED) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    if (event.frame < 0 || event.rampFrames < 0) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    uint32_t id = m_automation.schedule(event);
+    if (id == 0) {
+        LOGE("Automation timeline full (%d events)", AutomationScheduler::CAPACITY);
+        return EngineResult::ERROR_OUT_OF_MEMORY;
+    }
+    if (eventId) {
+        *eventId = id;
+    }
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::cancelAutomation(uint32_t eventId) {
+    return m_automation.cancel(eventId) ? EngineResult::SUCCESS : EngineResult::ERROR_INVALID_CONFIG;
+}
+
+void FTLAudioEngine::clearAutomation() {
+    m_automation.clear();
+}
+
+int64_t FTLAudioEngine::getOutputFrame() const {
+    return m_framesRendered.load(std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LOUDNESS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setLoudnessNormalization(bool enabled, float targetLufs) {
+    if (!(targetLufs <= 0.0f && targetLufs >= LoudnessMeter::ABSOLUTE_GATE_LUFS)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_loudnessTargetLufs.store(targetLufs, std::memory_order_relaxed);
+    m_loudnessEnabled.store(enabled, std::memory_order_relaxed);
+    LOGI("Loudness normalization %s (target %.1f LUFS)", enabled ? "enabled" : "disabled", targetLufs);
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setTrackLoudness(float integratedLufs) {
+    if (!(integratedLufs <= 0.0f && integratedLufs >= LoudnessMeter::ABSOLUTE_GATE_LUFS)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_trackLoudnessLufs.store(integratedLufs, std::memory_order_relaxed);
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setTruePeakLimiter(bool enabled, float ceilingDb) {
+    if (!(ceilingDb <= 0.0f && ceilingDb >= MIN_LIMITER_CEILING_DB)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_limiterCeilingDb.store(ceilingDb, std::memory_order_relaxed);
+    m_limiterEnabled.store(enabled, std::memory_order_relaxed);
+    LOGI("True-peak limiter %s (ceiling %.1f dBTP)", enabled ? "enabled" : "disabled", ceilingDb);
+    return EngineResult::SUCCESS;
+}
+
+float FTLAudioEngine::getIntegratedLoudness() const {
+    return m_integratedLufs.load(std::memory_order_relaxed);
+}
+
+float FTLAudioEngine::getLimiterReductionDb() const {
+    return m_limiterReductionDb.load(std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TIME STRETCH
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setTempo(double tempo) {
+    if (!m_config.enableTimeStretch) {
+        LOGE("Tempo needs enableTimeStretch at initialize");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (!(tempo >= TimeStretcher::MIN_TEMPO && tempo <= TimeStretcher::MAX_TEMPO)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_tempo.store(tempo, std::memory_order_relaxed);
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setPitchShift(double semitones) {
+    if (!m_config.enableTimeStretch) {
+        LOGE("Pitch shift needs enableTimeStretch at initialize");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (!(std::fabs(semitones) <= TimeStretcher::MAX_PITCH_SEMITONES)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_pitchSemitones.store(semitones, std::memory_order_relaxed);
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setStretchMode(StretchMode mode) {
+    if (!m_config.enableTimeStretch) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (mode != StretchMode::MUSIC && mode != StretchMode::SPEECH) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_stretchMode.store(mode, std::memory_order_relaxed);
+    LOGI("Time-stretch mode: %s", mode == StretchMode::MUSIC ? "music (phase vocoder)" : "speech (WSOLA)");
+    return EngineResult::SUCCESS;
+}
+
+double FTLAudioEngine::getTempo() const {
+    return m_tempo.load(std::memory_order_relaxed);
+}
+
+double FTLAudioEngine::getPitchShift() const {
+    return m_pitchSemitones.load(std::memory_order_relaxed);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CHANNEL LAYOUT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setDownmixMatrix(int inputChannels, const float* coefficients, int count) {
+    if (inputChannels < 1 || inputChannels > DownmixMatrix::MAX_CHANNELS) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    DownmixMatrix matrix;
+    if (coefficients) {
+        int outputChannels = m_config.channelCount;
+        if (count != inputChannels * outputChannels ||
+            !matrix.assign(inputChannels, outputChannels, coefficients)) {
+            LOGE("Downmix matrix needs %d x %d coefficients, got %d", outputChannels, inputChannels, count);
+            return EngineResult::ERROR_INVALID_CONFIG;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_channelMapMutex);
+        m_customDownmix[inputChannels - 1] = matrix;
+    }
+    m_channelMapSerial.fetch_add(1, std::memory_order_release);
+    LOGI("Downmix for %d-channel sources: %s", inputChannels, coefficients ? "custom" : "BS.775");
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setHeadphoneVirtualizer(bool enabled) {
+    if (enabled && m_config.channelCount != 2) {
+        LOGE("Headphone virtualizer needs a stereo output (have %d channels)", m_config.channelCount);
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    m_headphoneVirtualizer.store(enabled, std::memory_order_relaxed);
+    m_channelMapSerial.fetch_add(1, std::memory_order_release);
+    LOGI("Headphone virtualizer %s", enabled ? "enabled" : "disabled");
+    return EngineResult::SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// EQUALIZER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setEqualizer(bool enabled, const float* gainsDb, int count) {
+    if (m_engineState.load() == EngineState::UNINITIALIZED) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    
+    // Disabled is the flat curve; adaptive correction (if on) keeps running on top of it
+    float bands[Equalizer::BANDS] = {};
+    if (enabled) {
+        if (!gainsDb || count <= 0) {
+            return EngineResult::ERROR_INVALID_CONFIG;
+        }
+        Equalizer::mapCurve(gainsDb, count, bands);
+    }
+    m_adaptiveEq.setCurve(bands);
+    LOGI("Equalizer %s (%d-point curve)", enabled ? "enabled" : "disabled", enabled ? count : 0);
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::setAdaptiveEq(bool enabled, float strength) {
+    if (m_engineState.load() == EngineState::UNINITIALIZED) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    if (!(strength >= 0.0f && strength <= 1.0f)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    m_adaptiveEq.setAdaptive(enabled, strength);
+    // Offline renders step the analysis inline; a live stream gets the background worker
+    if (enabled && !m_config.offlineRender) {
+        m_adaptiveEq.start();
+    } else {
+        m_adaptiveEq.stop();
+    }
+    LOGI("Adaptive EQ %s (strength %.2f)", enabled ? "enabled" : "disabled", strength);
+    return EngineResult::SUCCESS;
+}
+
+int FTLAudioEngine::getEqualizerGains(float* gainsDb, int count) const {
+    float bands[Equalizer::BANDS];
+    m_adaptiveEq.appliedGains(bands);
+    if (gainsDb) {
+        std::copy(bands, bands + std::min(std::max(count, 0), Equalizer::BANDS), gainsDb);
+    }
+    return Equalizer::BANDS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// QUALITY MEASUREMENT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::measureQuality(const std::string& scratchDirectory, QualityReport* report) {
+    if (m_engineState.load() == EngineState::UNINITIALIZED) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    
+    // Playback settings that shape a stereo source. Loudness normalization stays
+    // off: it is a static gain per track, and would rescale the test levels; the
+    // EQ runs its curve without adaptation, which would chase the test signals
+    bool limiterEnabled = m_limiterEnabled.load(std::memory_order_relaxed);
+    float ceilingDb = m_limiterCeilingDb.load(std::memory_order_relaxed);
+    bool virtualizer = m_headphoneVirtualizer.load(std::memory_order_relaxed);
+    std::vector<float> eqCurve(Equalizer::BANDS);
+    m_adaptiveEq.curve(eqCurve.data());
+    OfflineSetup setup = [=](FTLAudioEngine& engine) {
+        engine.setTruePeakLimiter(limiterEnabled, ceilingDb);
+        if (virtualizer) engine.setHeadphoneVirtualizer(true);
+        engine.setEqualizer(true, eqCurve.data(), Equalizer::BANDS);
+    };
+    
+    QualityReport measured;
+    EngineResult result = measureChainQuality(m_config, setup, scratchDirectory, measured);
+    if (result != EngineResult::SUCCESS) {
+        LOGE("Quality measurement failed (%d)", static_cast<int>(result));
+        return result;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        m_currentMetrics.thdPlusN = measured.thdPlusNPercent;
+        m_currentMetrics.signalToNoiseRatio = measured.snrDb;
+    }
+    if (report) {
+        *report = std::move(measured);
+    }
+    return EngineResult::SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SEEK INDEX BUILD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void FTLAudioEngine::startSeekIndexBuild(const std::string& sourcePath, const std::string& sidecarPath) {
+    m_pendingSeekIndexPath = sidecarPath;
+    m_cancelIndexing.store(false, std::memory_order_relaxed);
+    m_seekIndexReady.store(false, std::memory_order_relaxed);
+    
+    // Own file handle and decoder: never contends with the decode thread's reader
+    m_indexThread = std::thread([this, sourcePath, sidecarPath] {
+        FTL_TRACE_THREAD_NAME("seekIndex");
+        FTL_TRACE_SCOPE("buildSeekIndex");
+        if (buildSeekIndex(sourcePath, sidecarPath, &m_cancelIndexing)) {
+            m_seekIndexReady.store(true, std::memory_order_release);
+        }
+    });
+}
+
+void FTLAudioEngine::stopSeekIndexBuild() {
+    if (m_indexThread.joinable()) {
+        m_cancelIndexing.store(true, std::memory_order_relaxed);
+        m_indexThread.join();
+    }
+    m_seekIndexReady.store(false, std::memory_order_relaxed);
+}
+
+void FTLAudioEngine::publishSeekCommit(uint32_t serial, int64_t flushPosition, int64_t sourceFrame) {
+    uint32_t sequence = m_seekCommitSequence.load(std::memory_order_relaxed);
+    m_seekCommitSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_seekCommitSerial.store(serial, std::memory_order_relaxed);
+    m_seekCommitFlushPosition.store(flushPosition, std::memory_order_relaxed);
+    m_seekCommitFrame.store(sourceFrame, std::memory_order_relaxed);
+    m_seekCommitSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void FTLAudioEngine::startDecodeThread() {
+    // Offline renders decode inline
+    if (!m_source || m_config.offlineRender || m_processingThread.joinable()) {
+        return;
+    }
+    m_stopProcessing.store(false, std::memory_order_release);
+    m_processingThread = std::thread(&FTLAudioEngine::processingThreadFunction, this);
+}
+
+void FTLAudioEngine::stopDecodeThread() {
+    if (!m_processingThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_stopProcessing.store(true, std::memory_order_release);
+    }
+    m_decodeWake.notify_one();
+    m_processingThread.join();
+}
+
+/**
+ * Decode-side state: owned by the decode thread, or by renderOffline()
+ * which runs the same steps inline
+ */
+struct FTLAudioEngine::DecodeState {
+    int outChannels = 0;
+    int srcChannels = 0;
+    int32_t chunkFrames = 0;
+    std::vector<float> decoded;
+    std::vector<float> mapped;
+    uint32_t handledSerial = 0;
+    
+    // Channel layout changes apply from the next chunk; the ring (~250 ms) plays out first
+    Downmixer downmix;
+    BinauralRenderer binaural;
+    bool virtualize = false;
+    uint32_t channelMapSerial = 0;
+};
+
+void FTLAudioEngine::prepareDecode(DecodeState& state) {
+    state.outChannels = m_config.channelCount;
+    state.srcChannels = m_source->info().channelCount;
+    state.chunkFrames = std::min(DECODE_CHUNK_FRAMES, m_decodeRing.capacityFrames() / 2);
+    state.decoded.assign(static_cast<size_t>(state.chunkFrames) * state.srcChannels, 0.0f);
+    state.mapped.assign(static_cast<size_t>(state.chunkFrames) * state.outChannels, 0.0f);
+    state.handledSerial = m_seekCommitSerial.load(std::memory_order_relaxed);
+    state.virtualize = false;
+    state.channelMapSerial = m_channelMapSerial.load(std::memory_order_acquire) - 1;
+}
+
+void FTLAudioEngine::refreshChannelMap(DecodeState& state) {
+    uint32_t serial = m_channelMapSerial.load(std::memory_order_acquire);
+    if (serial == state.channelMapSerial) {
+        return;
+    }
+    state.channelMapSerial = serial;
+    bool wasVirtualized = state.virtualize;
+    state.virtualize = state.outChannels == 2 && m_headphoneVirtualizer.load(std::memory_order_relaxed);
+    if (state.virtualize && !wasVirtualized) {
+        state.binaural.configure(m_config.sampleRate, state.srcChannels);
+    }
+    std::lock_guard<std::mutex> lock(m_channelMapMutex);
+    const DownmixMatrix& custom = m_customDownmix[state.srcChannels - 1];
+    state.downmix.configure(custom.outputChannels == state.outChannels
+                                ? custom
+                                : DownmixMatrix::standard(state.srcChannels, state.outChannels));
+}
+
+bool FTLAudioEngine::decodeStep(DecodeState& state) {
+    if (m_seekIndexReady.exchange(false, std::memory_order_acquire)) {
+        m_source->loadSeekIndex(m_pendingSeekIndexPath);
+    }
+    
+    uint32_t requested = m_seekRequestSerial.load(std::memory_order_acquire);
+    if (requested != state.handledSerial) {
+        FTL_TRACE_SCOPE("decodeSeek");
+        state.handledSerial = requested;
+        int64_t target = m_seekTarget.load(std::memory_order_relaxed);
+        if (!m_source->seekToFrame(target)) {
+            LOGE("Seek to frame %lld failed", static_cast<long long>(target));
+        }
+        // Everything written so far predates the seek
+        publishSeekCommit(requested, m_decodeRing.writePosition(), m_source->positionFrames());
+        m_sourceEnded.store(false, std::memory_order_release);
+        state.binaural.reset();
+        return true;
+    }
+    
+    if (m_sourceEnded.load(std::memory_order_relaxed) ||
+        m_decodeRing.availableToWrite() < state.chunkFrames) {
+        return false;
+    }
+    
+    FTL_TRACE_SCOPE("decodeChunk");
+    int32_t frames = m_source->read(state.decoded.data(), state.chunkFrames);
+    if (frames <= 0) {
+        if (frames < 0) {
+            LOGE("Decode error at frame %lld", static_cast<long long>(m_source->positionFrames()));
+        }
+        m_sourceEnded.store(true, std::memory_order_release);
+        return true;
+    }
+    
+    refreshChannelMap(state);
+    const float* frameData = state.decoded.data();
+    if (state.virtualize) {
+        state.binaural.process(state.decoded.data(), state.mapped.data(), frames);
+        frameData = state.mapped.data();
+    } else if (state.srcChannels != state.outChannels) {
+        state.downmix.process(state.decoded.data(), state.mapped.data(), frames);
+        frameData = state.mapped.data();
+    }
+    m_decodeRing.write(frameData, frames);
+    return true;
+}
+
+void FTLAudioEngine::processingThreadFunction() {
+    FTL_TRACE_THREAD_NAME("decode");
+    auto state = std::make_unique<DecodeState>();
+    prepareDecode(*state);
+    
+    // Poll at half the time one chunk lasts; seeks and stop wake us immediately
+    const auto refillInterval = std::chrono::microseconds(
+        static_cast<int64_t>(state->chunkFrames) * 500000 / m_config.sampleRate);
+    int64_t cpuCharged = threadCpuNs();
+    
+    while (!m_stopProcessing.load(std::memory_order_acquire)) {
+        if (decodeStep(*state)) {
+            continue;
+        }
+        
+        // Batch done: storage is still awake, so the queued track is opened now
+        servicePrefetch();
+        const IoStats& io = m_source->ioStats();
+        m_liveReadRequests.store(io.readRequests - m_sourceIoCounted.readRequests, std::memory_order_relaxed);
+        m_liveBytesRead.store(io.bytesRead - m_sourceIoCounted.bytesRead, std::memory_order_relaxed);
+        
+        // Decode work is charged to the output mode it fed; deep buffers drain slowly, so batch
+        OutputMode mode = m_outputMode.load(std::memory_order_relaxed);
+        int64_t cpuNow = threadCpuNs();
+        m_modeCounters[static_cast<int>(mode)].decodeCpuNs.fetch_add(cpuNow - cpuCharged, std::memory_order_relaxed);
+        cpuCharged = cpuNow;
+        bool batch = m_config.burstPrefetch || mode == OutputMode::POWER_SAVING;
+        auto interval = batch ? batchSleep(refillInterval) : refillInterval;
+        std::unique_lock<std::mutex> lock(m_decodeMutex);
+        m_decodeWake.wait_for(lock, interval, [&] {
+            return m_stopProcessing.load(std::memory_order_relaxed) ||
+                   m_seekRequestSerial.load(std::memory_order_relaxed) != state->handledSerial ||
+                   (m_prefetchRequested.load(std::memory_order_relaxed) &&
+                    m_sourceEnded.load(std::memory_order_relaxed));
+        });
+        m_decodeWakeups.fetch_add(1, std::memory_order_relaxed);
+        m_modeCounters[static_cast<int>(mode)].decodeWakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::chrono::microseconds FTLAudioEngine::batchSleep(std::chrono::microseconds pollInterval) const {
+    // Track over: only a seek, a new track or a prefetch has work for us
+    if (m_sourceEnded.load(std::memory_order_relaxed)) {
+        return std::chrono::milliseconds(m_config.prefetchRingMs);
+    }
+    
+    // Audio the callback will still play: frames before a pending seek flush do not count
+    int64_t readHead = std::max(m_decodeRing.readPosition(),
+                                m_seekCommitFlushPosition.load(std::memory_order_relaxed));
+    int64_t queued = m_decodeRing.writePosition() - readHead;
+    int64_t lowWater = m_decodeRing.capacityFrames() / PREFETCH_LOW_WATER_DIVISOR;
+    if (queued <= lowWater) {
+        return pollInterval;                              // Ring full of pre-seek audio until the flush
+    }
+    return std::chrono::microseconds((queued - lowWater) * 1000000 / m_config.sampleRate);
+}
+
+void FTLAudioEngine::servicePrefetch() {
+    if (!m_prefetchRequested.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (m_prefetchedSource && m_prefetchedPath == m_prefetchRequest) {
+            return;
+        }
+        path = m_prefetchRequest;
+    }
+    
+    // Opening parses the header from the first burst, which already holds the track's start
+    FTL_TRACE_SCOPE("decodePrefetch");
+    std::unique_ptr<AudioSource> source = openAudioSource(path, sourceReadBufferBytes());
+    if (!source) {
+        LOGE("Cannot prefetch %s", path.c_str());
+        return;
+    }
+    // The burst happened now: count it now, whether or not the track ever plays
+    retireIoStats(source->ioStats(), IoStats());
+    std::lock_guard<std::mutex> lock(m_prefetchMutex);
+    m_prefetchedSource = std::move(source);
+    m_prefetchedPath = path;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// OFFLINE RENDER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::renderOffline(const OfflineSink& sink, OfflineRenderStats* stats) {
+    if (!m_config.offlineRender) {
+        LOGE("Offline render needs an engine initialized with offlineRender");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (m_engineState.load() != EngineState::INITIALIZED) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    if (!m_source || !m_hasSource.load(std::memory_order_acquire)) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    OfflineRenderStats local;
+    OfflineRenderStats& result = stats ? *stats : local;
+    result = OfflineRenderStats();
+    m_offlineStats = &result;
+    
+    auto state = std::make_unique<DecodeState>();
+    prepareDecode(*state);
+    
+    // Same burst size as the device; the limiter's delay is trimmed so output lines up with the source
+    const int channelCount = m_config.channelCount;
+    const int32_t burst = m_config.framesPerBurst;
+    std::vector<float> buffer(static_cast<size_t>(burst) * channelCount);
+    refreshLimiter();
+    m_limiter.reset();                                   // Nothing carries over from the last track
+    m_equalizer.reset();
+    const int64_t latency = m_limiterActive ? m_limiter.latencyFrames() : 0;
+    // The stretcher reads ahead of the burst it renders: decode far enough that it never runs dry
+    const int32_t ringTarget = m_config.enableTimeStretch
+        ? static_cast<int32_t>(std::ceil(burst * TimeStretcher::MAX_TEMPO)) + m_stretcher.maxLookaheadFrames()
+        : burst;
+    const int64_t adaptiveEqInterval = msToFrames(AdaptiveEq::UPDATE_INTERVAL_MS);
+    int64_t adaptiveEqDue = adaptiveEqInterval;
+    
+    int64_t streamFrame = m_streamFramesWritten.load(std::memory_order_relaxed);
+    const int64_t firstFrame = streamFrame;
+    int64_t sourceFrames = 0;
+    bool sinkOk = true;
+    auto renderStart = std::chrono::steady_clock::now();
+    
+    while (sinkOk) {
+        auto decodeStart = std::chrono::steady_clock::now();
+        while (m_decodeRing.availableToRead() < ringTarget && decodeStep(*state)) {
+        }
+        result.decodeMs += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - decodeStart).count();
+        
+        bool drained = m_sourceEnded.load(std::memory_order_relaxed) && m_decodeRing.availableToRead() == 0 &&
+                       !stretcherHoldsSource();
+        if (drained && streamFrame - firstFrame >= sourceFrames + latency) {
+            break;
+        }
+        
+        bool keepRunning = processAudioCallback(buffer.data(), burst, streamFrame);
+        sourceFrames += m_burstSourceFrames;
+        ++result.bursts;
+        
+        // The adaptive EQ steps inline, on the live worker's interval of audio
+        if (m_adaptiveEq.isAdaptive() && streamFrame + burst - firstFrame >= adaptiveEqDue) {
+            m_adaptiveEq.update();
+            adaptiveEqDue += adaptiveEqInterval;
+        }
+        
+        // Emit [latency, latency + sourceFrames) of the render, relative to its first frame
+        int64_t from = std::max(streamFrame - firstFrame, latency + result.frames);
+        int64_t to = std::min(streamFrame - firstFrame + burst, latency + sourceFrames);
+        if (to > from) {
+            int64_t offset = from - (streamFrame - firstFrame);
+            sinkOk = sink(buffer.data() + offset * channelCount, static_cast<int32_t>(to - from), channelCount);
+            result.frames += to - from;
+        }
+        streamFrame += burst;
+        
+        if (!keepRunning) {
+            m_engineState.store(EngineState::INITIALIZED);
+            break;
+        }
+    }
+    
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - renderStart).count();
+    double audioSeconds = static_cast<double>(result.frames) / m_config.sampleRate;
+    result.realtimeFactor = result.wallSeconds > 0.0 ? audioSeconds / result.wallSeconds : 0.0;
+    m_offlineStats = nullptr;
+    
+    LOGI("Offline render: %lld frames in %.3f s (%.1fx realtime)",
+         static_cast<long long>(result.frames), result.wallSeconds, result.realtimeFactor);
+    return sinkOk ? EngineResult::SUCCESS : EngineResult::ERROR_PROCESSING_FAILED;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONFIGURATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::updateConfiguration(const AudioEngineConfig& config) {
+    return m_control.call(ControlAction::RECONFIGURE, reinterpret_cast<intptr_t>(&config));
+}
+
+EngineResult FTLAudioEngine::updateConfigurationNow(const AudioEngineConfig& config) {
+    awaitStreamOpen();
     // For now, only allow updates when engine is not running
     if (m_engineState.load() == EngineState::RUNNING) {
         return EngineResult::ERROR_ALREADY_RUNNING;
     }
     
-    auto result = validateConfiguration(config);
+    // The open stream, the rings and the DSP stages were sized for these
+    if (!sameFixedSettings(config, m_config)) {
+        LOGE("Only latency, DSP and thread settings change after initialize");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    AudioEngineConfig updated = m_config;
+    applyTuning(updated, config);
+    auto result = validateConfiguration(updated);
     if (result == EngineResult::SUCCESS) {
-        m_config = config;
+        // A prewarmed stream's callback may be running; it reads none of these
+        std::lock_guard<std::mutex> streamLock(m_streamMutex);
+        applyTuning(m_config, config);
+        m_dspEnabled.store(config.enableDSPProcessing, std::memory_order_relaxed);
         LOGI("Configuration updated successfully");
     }
     
@@ -423,22 +2133,55 @@ void FTLAudioEngine::shutdown() {
         return;
     }
     
+    // The command running finishes, queued ones are cancelled. A background open or route
+    // change in progress finishes too; none starts after this
+    m_control.stop();
+    {
+        std::lock_guard<std::mutex> lock(m_postedSourceMutex);
+        m_postedSources.clear();                         // Cancelled with their commands
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_postedConfigMutex);
+        m_postedConfigs.clear();
+    }
+    awaitStreamOpen();
+    stopRecoveryThread();
+    
     // Stop playback if running
     if (m_engineState.load() == EngineState::RUNNING || 
         m_engineState.load() == EngineState::PAUSED) {
-        stopPlayback();
+        stopNow();
+    }
+    
+    // Decode, index, feeder and analysis threads must not outlive the sources or rings
+    m_adaptiveEq.stop();
+    stopSeekIndexBuild();
+    stopDecodeThread();
+    m_mixer.release();
+    m_hasSource.store(false, std::memory_order_release);
+    m_source.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        m_prefetchedSource.reset();
+        m_prefetchedPath.clear();
     }
     
     // Clean up AAudio stream
-    cleanupAAudioStream();
+    {
+        std::lock_guard<std::mutex> streamLock(m_streamMutex);
+        cleanupAAudioStream();
+    }
     
     // Reset state
     m_engineState = EngineState::UNINITIALIZED;
+    publishSnapshot();
     
     LOGI("FTL Audio Engine shutdown complete");
 }
 
 void FTLAudioEngine::cleanupAAudioStream() {
+    m_streamWarm.store(false, std::memory_order_relaxed);
+    closeRetiredStream();
     if (m_audioStream) {
         AAudioStream_close(m_audioStream);
         m_audioStream = nullptr;
@@ -474,9 +2217,31 @@ EngineResult FTLAudioEngine::validateConfiguration(const AudioEngineConfig& conf
         return EngineResult::ERROR_INVALID_CONFIG;
     }
     
+    // Validate prefetch depth (a batch must outlast the low-water margin)
+    if (config.burstPrefetch &&
+        (config.prefetchRingMs < DECODE_RING_MIN_MS * 2 || config.prefetchRingMs > PREFETCH_RING_MAX_MS)) {
+        LOGE("Invalid prefetch ring: %d ms", config.prefetchRingMs);
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
+    // Validate deep buffer (power saving sizes the decode ring from it at initialize)
+    if (config.enablePowerSaving &&
+        (config.deepBufferMs < DEEP_BUFFER_MIN_MS || config.deepBufferMs > DEEP_BUFFER_MAX_MS)) {
+        LOGE("Invalid deep buffer: %d ms", config.deepBufferMs);
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (config.outputMode == OutputMode::POWER_SAVING && !config.enablePowerSaving) {
+        LOGE("Power saving output mode without enablePowerSaving");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    
     return EngineResult::SUCCESS;
 }
 
+int32_t FTLAudioEngine::msToFrames(int32_t ms) const {
+    return static_cast<int32_t>(static_cast<int64_t>(std::max(ms, 0)) * m_config.sampleRate / 1000);
+}
+
 void FTLAudioEngine::logConfiguration(const AudioEngineConfig& config) const {
     LOGI("Audio Engine Configuration:");
     LOGI("  Sample Rate: %d Hz", config.sampleRate);
@@ -484,7 +2249,10 @@ void FTLAudioEngine::logConfiguration(const AudioEngineConfig& config) const {
     LOGI("  Channel Count: %d", config.channelCount);
     LOGI("  Target Latency: %.2f ms", config.targetLatencyMs);
     LOGI("  Low Latency Mode: %s", config.enableLowLatency ? "enabled" : "disabled");
+    LOGI("  Output Mode: %s%s", outputModeName(config.outputMode),
+         config.enablePowerSaving ? "" : " (power saving unavailable)");
     LOGI("  DSP Processing: %s", config.enableDSPProcessing ? "enabled" : "disabled");
+    LOGI("  Time Stretch: %s", config.enableTimeStretch ? "available" : "unavailable");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -493,12 +2261,511 @@ void FTLAudioEngine::logConfiguration(const AudioEngineConfig& config) const {
 
 void FTLAudioEngine::errorCallback(AAudioStream* stream, void* userData, aaudio_result_t error) {
     auto* engine = static_cast<FTLAudioEngine*>(userData);
-    LOGE("AAudio error callback: %s", AAudio_convertResultToText(error));
+    FTL_LOGE_RT(LOG_TAG, "AAudio error callback: %s", AAudio_convertResultToText(error));
+    
+    // Route change: AAudio forbids closing the stream on this thread, the recovery thread reopens it
+    if (error == AAUDIO_ERROR_DISCONNECTED) {
+        std::lock_guard<std::mutex> lock(engine->m_recoveryMutex);
+        if (!engine->m_stopRecovery) {
+            engine->m_disconnectTimeNs.store(monotonicNowNs(), std::memory_order_relaxed);
+            engine->m_disconnectedStream = stream;
+            engine->m_recoveryWake.notify_one();
+            return;
+        }
+    }
     
-    // Handle error - for now just log and set error state
     engine->m_engineState = EngineState::ERROR;
+    engine->publishSnapshot();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// COLD START
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void FTLAudioEngine::openStreamInBackground() {
+    FTL_TRACE_THREAD_NAME("streamOpen");
+    FTL_TRACE_SCOPE("openStreamInBackground");
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
+    
+    // Held at the requested rate: the DSP is configured and the decoder may be filling for it
+    EngineResult result = setupAAudioStream(true);
+    if (result != EngineResult::SUCCESS) {
+        LOGE("Background stream open failed (%d)", static_cast<int>(result));
+        m_engineState = EngineState::ERROR;
+        publishSnapshot();
+        return;
+    }
+    prewarm();
+    publishSnapshot();
+}
+
+void FTLAudioEngine::awaitStreamOpen() {
+    std::lock_guard<std::mutex> lock(m_streamOpenMutex);
+    if (m_streamOpenThread.joinable()) {
+        m_streamOpenThread.join();
+    }
+}
+
+void FTLAudioEngine::prewarm() {
+    if (!m_config.prewarmStream || !m_audioStream || m_engineState.load() != EngineState::INITIALIZED) {
+        return;
+    }
+    m_warmFrames = 0;                                    // No callback runs yet
+    m_streamWarm.store(true, std::memory_order_release);
+    if (AAudioStream_requestStart(m_audioStream) != AAUDIO_OK) {
+        m_streamWarm.store(false, std::memory_order_relaxed);
+        LOGE("Stream pre-warm failed - the first play starts it");
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ROUTE-CHANGE RECOVERY
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void FTLAudioEngine::startRecoveryThread() {
+    if (m_config.offlineRender || m_recoveryThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_recoveryMutex);
+        m_stopRecovery = false;
+        m_disconnectedStream = nullptr;
+    }
+    m_recoveryThread = std::thread(&FTLAudioEngine::recoveryThreadFunction, this);
+}
+
+void FTLAudioEngine::stopRecoveryThread() {
+    if (!m_recoveryThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_recoveryMutex);
+        m_stopRecovery = true;
+    }
+    m_recoveryWake.notify_all();
+    m_recoveryThread.join();
+}
+
+void FTLAudioEngine::recoveryThreadFunction() {
+    FTL_TRACE_THREAD_NAME("streamRecovery");
+    std::unique_lock<std::mutex> lock(m_recoveryMutex);
+    while (true) {
+        m_recoveryWake.wait(lock, [this] { return m_stopRecovery || m_disconnectedStream; });
+        if (m_stopRecovery) {
+            return;
+        }
+        AAudioStream* lostStream = m_disconnectedStream;
+        m_disconnectedStream = nullptr;
+        lock.unlock();
+        recoverStream(lostStream);
+        lock.lock();
+    }
+}
+
+void FTLAudioEngine::recoverStream(AAudioStream* lostStream) {
+    FTL_TRACE_SCOPE("recoverStream");
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
+    if (lostStream != m_audioStream) {
+        return;                                          // Already replaced or closed
+    }
+    
+    // Only the device side is rebuilt: decode ring, playhead, voices and DSP state carry over
+    const EngineState state = m_engineState.load();
+    const bool resume = state == EngineState::RUNNING || state == EngineState::STARTING;
+    const int previousRate = m_config.sampleRate;
+    const bool hasSource = m_hasSource.load(std::memory_order_acquire);
+    cleanupAAudioStream();
+    
+    EngineResult result = EngineResult::ERROR_HARDWARE_UNAVAILABLE;
+    for (int attempt = 0; attempt < RECOVERY_ATTEMPTS; ++attempt) {
+        if (attempt > 0) {
+            std::unique_lock<std::mutex> lock(m_recoveryMutex);
+            if (m_recoveryWake.wait_for(lock, std::chrono::milliseconds(RECOVERY_RETRY_MS),
+                                        [this] { return m_stopRecovery; })) {
+                break;                                   // Shutting down
+            }
+        }
+        result = setupAAudioStream(hasSource);
+        if (result == EngineResult::SUCCESS) {
+            break;
+        }
+    }
+    
+    // Queued program audio holds the rate; without a source only the DSP needs to follow
+    if (result == EngineResult::SUCCESS && m_config.sampleRate != previousRate) {
+        LOGI("Output rate changed from %d to %d Hz", previousRate, m_config.sampleRate);
+        reconfigureForRate();
+    }
+    
+    if (result == EngineResult::SUCCESS && resume) {
+        m_awaitingResume.store(true, std::memory_order_release);
+        aaudio_stream_state_t nextState = AAUDIO_STREAM_STATE_UNINITIALIZED;
+        if (AAudioStream_requestStart(m_audioStream) != AAUDIO_OK ||
+            AAudioStream_waitForStateChange(m_audioStream, AAUDIO_STREAM_STATE_STARTING, &nextState,
+                                            1000 * 1000 * 1000) != AAUDIO_OK ||
+            nextState != AAUDIO_STREAM_STATE_STARTED) {
+            m_awaitingResume.store(false, std::memory_order_relaxed);
+            result = EngineResult::ERROR_PROCESSING_FAILED;
+        }
+    }
+    
+    if (result != EngineResult::SUCCESS) {
+        LOGE("Stream recovery failed (%d) - reinitialize the engine", static_cast<int>(result));
+        m_engineState = EngineState::ERROR;
+        publishSnapshot();
+        return;
+    }
+    if (!resume) {
+        prewarm();
+    }
+    
+    m_streamRecoveries.fetch_add(1, std::memory_order_relaxed);
+    double reopenMs = (monotonicNowNs() - m_disconnectTimeNs.load(std::memory_order_relaxed)) / 1e6;
+    LOGI("Stream recovered in %.1f ms at %d Hz (%s)", reopenMs, m_config.sampleRate,
+         resume ? "playing" : "idle");
+    publishSnapshot();
+}
+
+void FTLAudioEngine::reconfigureForRate() {
+    // Voices were resampled for the old rate
+    m_mixer.configure(m_config.sampleRate, m_config.channelCount, streamingRingFrames(m_config));
+    m_loudness.configure(m_config.sampleRate, m_config.channelCount);
+    m_limiter.configure(m_config.sampleRate, m_config.channelCount);
+    m_adaptiveEq.setSampleRate(m_config.sampleRate);
+    if (m_config.enableTimeStretch) {
+        m_stretcher.configure(m_config.sampleRate, m_config.channelCount);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// OUTPUT MODE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult FTLAudioEngine::setOutputMode(OutputMode mode) {
+    return m_control.call(ControlAction::SET_OUTPUT_MODE, static_cast<int64_t>(mode));
+}
+
+EngineResult FTLAudioEngine::setOutputModeNow(OutputMode mode) {
+    awaitStreamOpen();
+    std::lock_guard<std::mutex> streamLock(m_streamMutex);
+    const EngineState state = m_engineState.load();
+    if (state == EngineState::UNINITIALIZED || state == EngineState::ERROR) {
+        return EngineResult::ERROR_NOT_INITIALIZED;
+    }
+    if (mode == OutputMode::POWER_SAVING && !m_config.enablePowerSaving) {
+        LOGE("Power saving needs enablePowerSaving at initialize (deep decode ring)");
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    if (mode == m_outputMode.load(std::memory_order_relaxed)) {
+        return EngineResult::SUCCESS;
+    }
+    if (m_config.offlineRender) {
+        m_outputMode.store(mode, std::memory_order_relaxed);   // No device to switch
+        return EngineResult::SUCCESS;
+    }
+    
+    if (state == EngineState::RUNNING && m_audioStream) {
+        EngineResult result = handOverStream(mode);
+        if (result == EngineResult::SUCCESS || m_engineState.load() == EngineState::RUNNING) {
+            return result;
+        }
+        // A scheduled pause landed mid-switch: nothing plays, so the stream is simply reopened
+    }
+    return reopenStream(mode);
+}
+
+OutputMode FTLAudioEngine::getOutputMode() const {
+    return m_outputMode.load(std::memory_order_relaxed);
+}
+
+OutputModeActivity FTLAudioEngine::getOutputModeActivity(OutputMode mode) const {
+    const OutputModeCounters& counters = m_modeCounters[static_cast<int>(mode)];
+    OutputModeActivity activity;
+    activity.callbacks = counters.callbacks.load(std::memory_order_relaxed);
+    activity.audioSeconds = counters.audioNs.load(std::memory_order_relaxed) / 1e9;
+    activity.callbackCpuMs = counters.callbackCpuNs.load(std::memory_order_relaxed) / 1e6;
+    activity.decodeCpuMs = counters.decodeCpuNs.load(std::memory_order_relaxed) / 1e6;
+    activity.decodeWakeups = counters.decodeWakeups.load(std::memory_order_relaxed);
+    if (activity.audioSeconds > 0.0) {
+        activity.callbacksPerSecond = activity.callbacks / activity.audioSeconds;
+        activity.cpuMsPerAudioMinute = (activity.callbackCpuMs + activity.decodeCpuMs) * 60.0 / activity.audioSeconds;
+    }
+    return activity;
+}
+
+EngineResult FTLAudioEngine::reopenStream(OutputMode mode) {
+    // Nothing playing: close, open in the new mode, and warm up again if the old stream was warm
+    const bool warm = m_streamWarm.exchange(false, std::memory_order_acq_rel);
+    const OutputMode previous = m_outputMode.load(std::memory_order_relaxed);
+    closeRetiredStream();
+    if (m_audioStream) {
+        closeStream(m_audioStream);
+        m_audioStream = nullptr;
+    }
+    
+    // Held at the current rate: queued audio and the DSP are configured for it
+    m_outputMode.store(mode, std::memory_order_relaxed);
+    EngineResult result = setupAAudioStream(true);
+    if (result != EngineResult::SUCCESS) {
+        LOGE("Cannot open a %s stream (%d), staying %s", outputModeName(mode), static_cast<int>(result),
+             outputModeName(previous));
+        m_outputMode.store(previous, std::memory_order_relaxed);
+        if (setupAAudioStream(true) != EngineResult::SUCCESS) {
+            m_engineState = EngineState::ERROR;
+            publishSnapshot();
+        }
+        return result;
+    }
+    if (warm) {
+        prewarm();
+    }
+    LOGI("Output mode: %s (reopened)", outputModeName(mode));
+    publishSnapshot();
+    return EngineResult::SUCCESS;
+}
+
+EngineResult FTLAudioEngine::handOverStream(OutputMode mode) {
+    FTL_TRACE_SCOPE("handOverStream");
+    closeRetiredStream();
+    AAudioStream* outgoing = m_audioStream;
+    AAudioStream* incoming = nullptr;
+    EngineResult result = openOutputStream(mode, true, &incoming);
+    if (result != EngineResult::SUCCESS) {
+        return result;
+    }
+    if ((AAudioStream_getFormat(incoming) == AAUDIO_FORMAT_PCM_I16) != m_outputPcm16) {
+        LOGE("The %s stream opened in another sample format", outputModeName(mode));
+        AAudioStream_close(incoming);
+        return EngineResult::ERROR_HARDWARE_UNAVAILABLE;
+    }
+    
+    // The tail never exceeds the incoming stream's whole buffer plus the burst it is writing
+    const int channelCount = m_config.channelCount;
+    m_handoverTail.allocate(AAudioStream_getBufferCapacityInFrames(incoming) +
+                            AAudioStream_getFramesPerBurst(incoming), channelCount);
+    if (!m_handoverScratch) {
+        m_handoverScratch = std::make_unique<float[]>(static_cast<size_t>(HANDOVER_SCRATCH_FRAMES) * channelCount);
+    }
+    m_handoverTailFrames.store(-1, std::memory_order_relaxed);
+    m_handoverPadding.store(0, std::memory_order_relaxed);
+    m_handoverClaimed.store(false, std::memory_order_relaxed);
+    m_handoverGapFrames.store(0, std::memory_order_relaxed);
+    m_handoverToken.store(HANDOVER_OLD_IDLE, std::memory_order_relaxed);
+    m_handoverMode = mode;
+    m_handoverFrom.store(outgoing, std::memory_order_relaxed);
+    m_handoverActive.store(true, std::memory_order_release);
+    
+    const auto started = std::chrono::steady_clock::now();
+    const auto timeout = std::chrono::milliseconds(
+        HANDOVER_TIMEOUT_MS + HANDOVER_TIMEOUT_DEEP_BUFFERS * m_config.deepBufferMs);
+    aaudio_stream_state_t nextState = AAUDIO_STREAM_STATE_UNINITIALIZED;
+    const bool running = AAudioStream_requestStart(incoming) == AAUDIO_OK &&
+        AAudioStream_waitForStateChange(incoming, AAUDIO_STREAM_STATE_STARTING, &nextState,
+                                        1000 * 1000 * 1000) == AAUDIO_OK &&
+        nextState == AAUDIO_STREAM_STATE_STARTED;
+    
+    // Claimed, the tail played out by the old stream, and the new one's lead-in silence written
+    auto awaitHandover = [this](std::chrono::steady_clock::time_point deadline) {
+        while (!(m_handoverClaimed.load(std::memory_order_acquire) &&
+                 m_handoverTail.readPosition() >= m_handoverTailFrames.load(std::memory_order_relaxed) &&
+                 m_handoverPadding.load(std::memory_order_relaxed) == 0)) {
+            bool claimed = m_handoverToken.load(std::memory_order_acquire) == HANDOVER_NEW_OWNS;
+            if (std::chrono::steady_clock::now() >= deadline ||
+                (!claimed && m_engineState.load() != EngineState::RUNNING)) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(HANDOVER_POLL_MS));
+        }
+    };
+    if (running) {
+        awaitHandover(started + timeout);
+    }
+    if (m_handoverToken.load(std::memory_order_acquire) != HANDOVER_NEW_OWNS) {
+        if (cancelHandover()) {
+            // Never claimed: the old stream plays on as if nothing happened
+            closeStream(incoming);
+            m_handoverActive.store(false, std::memory_order_release);
+            LOGE("The %s stream did not take over, staying %s", outputModeName(mode),
+                 outputModeName(m_outputMode.load(std::memory_order_relaxed)));
+            return EngineResult::ERROR_PROCESSING_FAILED;
+        }
+        awaitHandover(std::chrono::steady_clock::now() + timeout);   // Claimed as we gave up
+    }
+    
+    // The old stream's buffer still holds its last audio: it stops once that has played (asynchronous,
+    // nothing waits for it under the lock), and the next stream operation closes it
+    m_retiredStream.store(outgoing, std::memory_order_release);
+    AAudioStream_requestStop(outgoing);
+    m_audioStream = incoming;
+    m_outputMode.store(mode, std::memory_order_relaxed);
+    m_handoverActive.store(false, std::memory_order_release);
+    
+    const int64_t gapFrames = m_handoverGapFrames.load(std::memory_order_relaxed);
+    LOGI("Output mode: %s, handed over in %.0f ms (%s %.1f ms)", outputModeName(mode),
+         std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count(),
+         gapFrames >= 0 ? "tail" : "lead-in", std::abs(gapFrames) * 1000.0 / m_config.sampleRate);
+    publishSnapshot();
+    return EngineResult::SUCCESS;
+}
+
+bool FTLAudioEngine::cancelHandover() {
+    // Also mid-burst: the old stream keeps the graph either way, so nothing waits; loses only to a claim
+    int expected = m_handoverToken.load(std::memory_order_acquire);
+    while (expected != HANDOVER_CANCELLED) {
+        if (expected == HANDOVER_NEW_OWNS) {
+            return false;
+        }
+        if (m_handoverToken.compare_exchange_weak(expected, HANDOVER_CANCELLED, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+    return true;
+}
+
+void FTLAudioEngine::closeRetiredStream() {
+    if (AAudioStream* retired = m_retiredStream.exchange(nullptr, std::memory_order_acq_rel)) {
+        closeStream(retired);
+    }
+}
+
+bool FTLAudioEngine::renderHandover(AAudioStream* stream, void* audioData, int32_t numFrames) {
+    if (stream != m_handoverFrom.load(std::memory_order_relaxed)) {
+        return renderIncoming(stream, audioData, numFrames);
+    }
+    
+    // Outgoing stream: renders as usual until the incoming one claims the graph between two bursts
+    int token = HANDOVER_OLD_IDLE;
+    const bool owner = m_handoverToken.compare_exchange_strong(token, HANDOVER_OLD_RENDERING,
+                                                               std::memory_order_acq_rel);
+    if (owner || token == HANDOVER_CANCELLED) {
+        int64_t streamFrame = m_streamFrameBase.load(std::memory_order_relaxed) + AAudioStream_getFramesWritten(stream);
+        bool keepRunning = renderOutput(audioData, numFrames, streamFrame);
+        if (owner) {
+            // Unless cancelled meanwhile, which must stick
+            int rendering = HANDOVER_OLD_RENDERING;
+            m_handoverToken.compare_exchange_strong(rendering, HANDOVER_OLD_IDLE, std::memory_order_acq_rel);
+        }
+        return keepRunning;
+    }
+    playHandoverTail(audioData, numFrames);
+    return true;
+}
+
+void FTLAudioEngine::playHandoverTail(void* audioData, int32_t numFrames) {
+    // The claim publishes the tail whole once rendered; a burst that comes before that plays silence
+    const int channelCount = m_config.channelCount;
+    int32_t wanted = 0;
+    int64_t tailFrames = m_handoverTailFrames.load(std::memory_order_acquire);
+    if (tailFrames >= 0) {
+        wanted = static_cast<int32_t>(std::min<int64_t>(numFrames, tailFrames - m_handoverTail.readPosition()));
+    }
+    
+    // Played out, then silence until the stream stops
+    int32_t played = 0;
+    if (m_outputPcm16) {
+        int16_t* out = static_cast<int16_t*>(audioData);
+        while (played < wanted) {
+            int32_t frames = m_handoverTail.read(m_handoverScratch.get(),
+                                                 std::min(wanted - played, HANDOVER_SCRATCH_FRAMES));
+            if (frames <= 0) {
+                break;
+            }
+            pcm::floatToS16(m_handoverScratch.get(), out + static_cast<size_t>(played) * channelCount,
+                            static_cast<size_t>(frames) * channelCount);
+            played += frames;
+        }
+        std::fill(out + static_cast<size_t>(played) * channelCount,
+                  out + static_cast<size_t>(numFrames) * channelCount, static_cast<int16_t>(0));
+    } else {
+        float* out = static_cast<float*>(audioData);
+        played = std::max(0, m_handoverTail.read(out, wanted));
+        std::fill(out + static_cast<size_t>(played) * channelCount,
+                  out + static_cast<size_t>(numFrames) * channelCount, 0.0f);
+    }
+}
+
+bool FTLAudioEngine::renderIncoming(AAudioStream* stream, void* audioData, int32_t numFrames) {
+    const size_t frameBytes = static_cast<size_t>(m_config.channelCount) *
+                              (m_outputPcm16 ? sizeof(int16_t) : sizeof(float));
+    bool keepRunning = true;
+    if (!m_handoverClaimed.load(std::memory_order_relaxed) && !claimHandover(stream, keepRunning)) {
+        std::memset(audioData, 0, static_cast<size_t>(numFrames) * frameBytes);   // Old stream still plays
+        return true;
+    }
+    
+    // Lead-in silence while the old stream's queued audio plays, then the graph
+    const int64_t padding = m_handoverPadding.load(std::memory_order_relaxed);
+    const int32_t silent = keepRunning ? static_cast<int32_t>(std::min<int64_t>(padding, numFrames)) : numFrames;
+    std::memset(audioData, 0, static_cast<size_t>(silent) * frameBytes);
+    if (padding > 0) {
+        m_handoverPadding.store(padding - std::min<int64_t>(padding, silent), std::memory_order_relaxed);
+    }
+    if (silent < numFrames) {
+        int64_t streamFrame = m_streamFrameBase.load(std::memory_order_relaxed) +
+                              AAudioStream_getFramesWritten(stream) + silent;
+        keepRunning = renderOutput(static_cast<uint8_t*>(audioData) + silent * frameBytes, numFrames - silent,
+                                   streamFrame);
+    }
+    return keepRunning;
+}
+
+bool FTLAudioEngine::claimHandover(AAudioStream* stream, bool& keepRunning) {
+    // Placing the switch needs a presentation timestamp from this stream
+    int64_t position = 0;
+    int64_t timeNs = 0;
+    if (m_engineState.load() != EngineState::RUNNING ||
+        AAudioStream_getTimestamp(stream, CLOCK_MONOTONIC, &position, &timeNs) != AAUDIO_OK || position <= 0) {
+        return false;
+    }
+    int token = HANDOVER_OLD_IDLE;
+    if (!m_handoverToken.compare_exchange_strong(token, HANDOVER_NEW_OWNS, std::memory_order_acq_rel)) {
+        return false;                                    // Old stream mid-burst: next callback
+    }
+    FTL_TRACE_INSTANT("outputHandover");
+    
+    // When the old stream's last rendered frame and this stream's next one reach the speaker. The old
+    // stream may not have counted its last burst yet, so its end comes from the engine timeline
+    const double rate = m_config.sampleRate;
+    AAudioStream* outgoing = m_handoverFrom.load(std::memory_order_relaxed);
+    const int64_t engineFrame = m_streamFramesWritten.load(std::memory_order_relaxed);
+    const int64_t oldWritten = engineFrame - m_streamFrameBase.load(std::memory_order_relaxed);
+    int64_t oldPosition = 0;
+    int64_t oldTimeNs = 0;
+    const int64_t oldEndNs =
+        AAudioStream_getTimestamp(outgoing, CLOCK_MONOTONIC, &oldPosition, &oldTimeNs) == AAUDIO_OK
+            ? oldTimeNs + static_cast<int64_t>((oldWritten - oldPosition) * 1e9 / rate)
+            : monotonicNowNs() + static_cast<int64_t>(AAudioStream_getBufferSizeInFrames(outgoing) * 1e9 / rate);
+    const int64_t written = AAudioStream_getFramesWritten(stream);
+    const int64_t newStartNs = timeNs + static_cast<int64_t>((written - position) * 1e9 / rate);
+    int64_t gapFrames = std::llround((newStartNs - oldEndNs) * rate / 1e9);
+    
+    if (gapFrames > 0) {
+        // The old stream runs dry first: render the gap ahead for it to play out
+        gapFrames = std::min<int64_t>(gapFrames, m_handoverTail.capacityFrames());
+        const int32_t chunkFrames = m_bufferSize.load(std::memory_order_relaxed) / m_config.channelCount;
+        int64_t done = 0;
+        while (done < gapFrames) {
+            int32_t frames = static_cast<int32_t>(std::min<int64_t>(chunkFrames, gapFrames - done));
+            keepRunning = processAudioCallback(m_audioBuffer.get(), frames, engineFrame + done);
+            m_handoverTail.write(m_audioBuffer.get(), frames);
+            done += frames;
+            if (!keepRunning) {
+                break;                                   // Scheduled pause: the tail ends there
+            }
+        }
+        m_handoverTailFrames.store(done, std::memory_order_release);   // Ready: the old stream plays it out
+    } else {
+        // The old stream plays past this one's next frame: lead in with silence
+        m_handoverTailFrames.store(0, std::memory_order_release);
+        m_handoverPadding.store(-gapFrames, std::memory_order_relaxed);
+    }
     
-    // Could implement recovery logic here
+    // The engine frame after the old stream's last one lands right after the tail or lead-in
+    m_streamFrameBase.store(engineFrame + gapFrames - written, std::memory_order_relaxed);
+    m_presentationLagFrames.store(AAudioStream_getBufferSizeInFrames(stream), std::memory_order_relaxed);
+    m_handoverGapFrames.store(gapFrames, std::memory_order_relaxed);
+    m_handoverClaimed.store(true, std::memory_order_release);
+    return true;
 }
 
 } // namespace ftl_audio
\ No newline at end of file
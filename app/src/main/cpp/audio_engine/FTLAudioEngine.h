@@ -20,8 +20,28 @@
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
 #include <aaudio/AAudio.h>
 
+#include "AdaptiveEq.h"
+#include "AudioSource.h"
+#include "AutomationScheduler.h"
+#include "BufferManager.h"
+#include "ControlQueue.h"
+#include "Downmix.h"
+#include "EngineSnapshot.h"
+#include "Equalizer.h"
+#include "LoudnessMeter.h"
+#include "MathUtils.h"
+#include "PlayheadTracker.h"
+#include "TimeStretch.h"
+#include "TruePeakLimiter.h"
+#include "VoiceMixer.h"
+
 namespace ftl_audio {
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -36,7 +56,8 @@ enum class EngineResult {
     ERROR_ALREADY_RUNNING = -4,
     ERROR_NOT_INITIALIZED = -5,
     ERROR_PROCESSING_FAILED = -6,
-    ERROR_LATENCY_TOO_HIGH = -7
+    ERROR_LATENCY_TOO_HIGH = -7,
+    ERROR_NO_VOICE_AVAILABLE = -8
 };
 
 enum class AudioFormat {
@@ -59,6 +80,15 @@ enum class EngineState {
     ERROR
 };
 
+/**
+ * Device output: short exclusive buffers for interaction, or a deep shared
+ * buffer the device drains for hundreds of ms between wakeups (screen off)
+ */
+enum class OutputMode {
+    LOW_LATENCY = 0,
+    POWER_SAVING = 1
+};
+
 // ═══════════════════════════════════════════════════════════════════════════════════
 // CONFIGURATION STRUCTURES
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -85,8 +115,79 @@ struct AudioEngineConfig {
     bool enableExclusiveMode = false;
     int maxBufferSizeFrames = 2048;
     int minBufferSizeFrames = 64;
+    
+    // No device stream: renderOffline() pulls the graph as fast as the CPU allows
+    bool offlineRender = false;
+    
+    // Cold start: initialize() returns before the stream is open; it opens in the background
+    // and runs on silence until the first play, which then needs no device start
+    bool prewarmStream = false;
+    int prewarmIdleMs = 5000;       // A warm stream nobody plays on stops after this
+    
+    // Burst prefetch: sources read in large bursts and the decode thread fills a
+    // prefetchRingMs ring in one batch, then sleeps until a quarter is left, so
+    // storage and the CPU idle for seconds at a time. Channel layout changes
+    // take effect after the buffered audio.
+    bool burstPrefetch = false;
+    int prefetchRingMs = 8000;
+    
+    // Power saving (setOutputMode): a shared POWER_SAVING stream with a deepBufferMs
+    // buffer, called back once per half of it, and batched decode into a ring of
+    // several deep buffers. enablePowerSaving reserves that ring at initialize.
+    bool enablePowerSaving = false;
+    int deepBufferMs = 400;
+    OutputMode outputMode = OutputMode::LOW_LATENCY;   // Mode the first stream opens in
+    
+    // Time-stretch (setTempo / setPitchShift): the callback reads the decode ring through
+    // a phase vocoder or WSOLA stage. enableTimeStretch sizes it at initialize; without
+    // it the ring plays straight through and those calls are refused.
+    bool enableTimeStretch = false;
+};
+
+/**
+ * Decode thread activity since initialize(), for power comparisons
+ */
+struct DecodeActivity {
+    uint64_t wakeups = 0;              // Decode thread returns from sleep
+    uint64_t readRequests = 0;         // read(2) calls by playing and prefetched sources
+    uint64_t bytesRead = 0;
+};
+
+/**
+ * Device and decode cost while one output mode played, since initialize()
+ */
+struct OutputModeActivity {
+    uint64_t callbacks = 0;            // Data callbacks from the device
+    double audioSeconds = 0.0;         // Audio delivered by them
+    double callbackCpuMs = 0.0;        // Audio thread CPU time inside the callbacks
+    double decodeCpuMs = 0.0;          // Decode thread CPU time
+    uint64_t decodeWakeups = 0;
+    double callbacksPerSecond = 0.0;   // Per second of audio
+    double cpuMsPerAudioMinute = 0.0;  // Callback + decode CPU per minute of audio
+};
+
+/**
+ * Result of one offline render; stage times are wall time summed over
+ * every burst
+ */
+struct OfflineRenderStats {
+    int64_t frames = 0;                // Delivered to the sink (source-aligned)
+    int64_t bursts = 0;
+    double wallSeconds = 0.0;
+    double realtimeFactor = 0.0;       // Audio seconds per wall-clock second
+    
+    double decodeMs = 0.0;             // File decode, downmix / binaural
+    double sourceMs = 0.0;             // Ring read, seek commit, playhead
+    double loudnessMs = 0.0;           // R128 meter and normalization gain
+    double eqMs = 0.0;                 // Equalizer and adaptive EQ tap
+    double mixMs = 0.0;                // Automation, program gain, voices
+    double limiterMs = 0.0;            // True-peak limiter
+    double meterMs = 0.0;              // Level meters
 };
 
+/** Receives rendered frames in order; return false to abort the render */
+using OfflineSink = std::function<bool(const float* frames, int32_t numFrames, int channelCount)>;
+
 struct PerformanceMetrics {
     double cpuUsagePercent = 0.0;
     double memoryUsageMB = 0.0;
@@ -101,13 +202,20 @@ struct PerformanceMetrics {
     double totalLatencyMs = 0.0;
     
     // Quality metrics
-    double thdPlusN = 0.0; // Total Harmonic Distortion + Noise
-    double signalToNoiseRatio = 0.0;
+    double thdPlusN = 0.0; // Total Harmonic Distortion + Noise, percent (measureQuality)
+    double signalToNoiseRatio = 0.0; // dB (measureQuality)
     
     // Real-time performance
     uint64_t callbackCount = 0;
     uint64_t missedCallbacks = 0;
     double callbackLoad = 0.0; // Percentage of available time used
+    
+    // Device route changes (headphones unplugged, USB DAC switched)
+    uint64_t streamRecoveries = 0;   // Streams reopened after a disconnect
+    double lastRecoveryMs = 0.0;     // Disconnect -> first burst rendered for the new stream
+    
+    // Play request -> first non-silent frame at the speaker (last start or resume)
+    double timeToFirstAudioMs = 0.0;
 };
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -118,6 +226,7 @@ class AudioRenderer;
 class LatencyMonitor;
 class PerformanceMonitor;
 class AudioProcessor;
+struct QualityReport;
 
 // ═══════════════════════════════════════════════════════════════════════════════════
 // MAIN AUDIO ENGINE CLASS
@@ -129,13 +238,26 @@ public:
     FTLAudioEngine();
     ~FTLAudioEngine();
     
-    // Core lifecycle
+    // Core lifecycle. Start, stop, pause and resume run on the control thread; these post and wait
     EngineResult initialize(const AudioEngineConfig& config);
     EngineResult startPlayback();
     EngineResult stopPlayback();
     EngineResult pausePlayback();
     EngineResult resumePlayback();
-    void shutdown();
+    void shutdown();                       // Not from a command callback
+    
+    // Control commands, run one at a time in the order posted. Posting returns at once; the
+    // result comes to the callback (control thread) or awaitCommand(). 0 when the mailbox is full
+    // or the action takes a pointer (SET_SOURCE, RECONFIGURE); post those with postAudioSource
+    // and postConfiguration, which keep the path / settings until the command runs
+    ControlToken postCommand(ControlAction action, int64_t argument = 0,
+                             ControlCallback callback = nullptr, void* userData = nullptr);
+    ControlToken postConfiguration(const AudioEngineConfig& tuning,   // Only the tunable fields are read
+                                   ControlCallback callback = nullptr, void* userData = nullptr);
+    ControlToken postAudioSource(const std::string& filePath,
+                                 ControlCallback callback = nullptr, void* userData = nullptr);
+    bool awaitCommand(ControlToken token, int32_t timeoutMs, EngineResult* result);
+    ControlStats getControlStats() const;
     
     // Audio processing
     EngineResult processAudioBuffer(
@@ -146,7 +268,9 @@ public:
         int channelCount
     );
     
-    // Configuration
+    // Configuration (on the control thread; posts and waits). Only the low-latency, high-resolution,
+    // DSP, thread-priority and buffer-multiplier settings change; the rest is fixed at initialize
+    // and a config that changes it is refused
     EngineResult updateConfiguration(const AudioEngineConfig& config);
     AudioEngineConfig getCurrentConfiguration() const;
     
@@ -155,8 +279,72 @@ public:
     PerformanceMetrics getPerformanceMetrics() const;
     EngineState getCurrentState() const;
     
-    // Advanced features
+    // Shared snapshot (exported to Kotlin as a direct ByteBuffer)
+    EngineSnapshot* getSnapshotBuffer();
+    static constexpr size_t getSnapshotBufferSize() { return SnapshotPublisher::bufferSize(); }
+    EngineSnapshotData readSnapshot() const;
+    
+    // Source playback & sample-accurate seeking. Source changes and seeks run on the control
+    // thread, in order with start/stop; these post and wait
     EngineResult setAudioSource(const std::string& filePath);
+    EngineResult seekToFrame(int64_t sourceFrame);
+    int64_t getPlayheadFrame();            // Source frame audible at the speaker now
+    double getLastSeekLatencyMs() const;   // Seek request -> first new frame audible
+    void setSeekIndexDirectory(const std::string& directory); // Sidecar cache, built on first play
+    EngineResult prefetchNextSource(const std::string& filePath); // Queued track, opened at the next batch
+    DecodeActivity getDecodeActivity() const;
+    
+    // Output mode (e.g. power saving while the screen is off). While playing, the new stream
+    // opens next to the old one and takes over as it drains, with no gap; blocks until done
+    EngineResult setOutputMode(OutputMode mode);
+    OutputMode getOutputMode() const;
+    OutputModeActivity getOutputModeActivity(OutputMode mode) const;
+    
+    // Tempo and pitch for BPM matching (config.enableTimeStretch), independent of each other and
+    // heard within ~25 ms while playing. The mode applies from the next track or seek
+    EngineResult setTempo(double tempo);                   // 0.7 .. 1.3 source seconds per second
+    EngineResult setPitchShift(double semitones);          // -12 .. +12
+    EngineResult setStretchMode(StretchMode mode);         // MUSIC (phase vocoder) or SPEECH (WSOLA)
+    double getTempo() const;
+    double getPitchShift() const;
+    
+    // Offline render (config.offlineRender): the callback's graph over the whole source
+    EngineResult renderOffline(const OfflineSink& sink, OfflineRenderStats* stats);
+    
+    // Extra voices mixed over the main program (crossfades, previews, prompts)
+    EngineResult playVoice(const std::string& filePath, float gain, int32_t fadeInMs, int32_t* voiceId);
+    EngineResult setVoiceGain(int32_t voiceId, float gain, int32_t rampMs);
+    EngineResult stopVoice(int32_t voiceId, int32_t fadeOutMs);
+    EngineResult setProgramGain(float gain, int32_t rampMs);   // Main source bus
+    int getActiveVoiceCount() const;
+    
+    // Sample-accurate automation (sleep/workout timers, scheduled fades)
+    EngineResult scheduleAutomation(const AutomationEvent& event, uint32_t* eventId);
+    EngineResult cancelAutomation(uint32_t eventId);
+    void clearAutomation();
+    int64_t getOutputFrame() const;        // Output clock: frames played so far
+    
+    // Loudness: per-track R128 normalization, true-peak limiter at the end of the chain
+    EngineResult setLoudnessNormalization(bool enabled, float targetLufs);
+    EngineResult setTrackLoudness(float integratedLufs);   // From metadata; else measured
+    EngineResult setTruePeakLimiter(bool enabled, float ceilingDb);
+    float getIntegratedLoudness() const;   // Current track, LUFS (NO_MEASUREMENT_LUFS until measured)
+    float getLimiterReductionDb() const;   // Deepest reduction in the last burst
+    
+    // Channel layout: multichannel fold-down and headphone virtualizer (decode thread)
+    EngineResult setDownmixMatrix(int inputChannels, const float* coefficients, int count); // nullptr: BS.775
+    EngineResult setHeadphoneVirtualizer(bool enabled);    // Binaural for surround, crossfeed for stereo
+    
+    // Equalizer on the program: 10 octave bands, changes land within a burst while playing.
+    // A curve of any other band count is interpolated (log-spaced over 20 Hz .. 20 kHz)
+    EngineResult setEqualizer(bool enabled, const float* gainsDb, int count);
+    EngineResult setAdaptiveEq(bool enabled, float strength);  // Background analysis corrects the balance
+    int getEqualizerGains(float* gainsDb, int count) const;     // Applied now (curve + correction)
+    
+    // Audio quality of the current chain, measured on offline renders; fills thdPlusN / SNR metrics
+    EngineResult measureQuality(const std::string& scratchDirectory, QualityReport* report);
+    
+    // Advanced features
     EngineResult enableEffect(const std::string& effectName, bool enable);
     EngineResult setEffectParameter(const std::string& effectName, 
                                    const std::string& paramName, 
@@ -175,14 +363,180 @@ private:
     
     // AAudio stream
     AAudioStream* m_audioStream = nullptr;
+    std::mutex m_streamMutex;                            // Open / close / start vs. route-change recovery
+    std::atomic<int64_t> m_streamFrameBase{0};           // Engine frame of the stream's frame 0
+    bool m_outputPcm16 = false;                          // Device without float; set while no stream runs
+    std::atomic<OutputMode> m_outputMode{OutputMode::LOW_LATENCY}; // Mode of m_audioStream
+    
+    // Mode switch while playing: the incoming stream claims the graph from the outgoing one,
+    // which plays out what was rendered ahead for the gap, or the incoming one pads with silence
+    static constexpr int HANDOVER_OLD_IDLE = 0;          // Outgoing stream owns the graph, between bursts
+    static constexpr int HANDOVER_OLD_RENDERING = 1;
+    static constexpr int HANDOVER_NEW_OWNS = 2;
+    static constexpr int HANDOVER_CANCELLED = 3;         // Outgoing stream keeps the graph
+    std::atomic<bool> m_handoverActive{false};
+    std::atomic<int> m_handoverToken{HANDOVER_OLD_IDLE};
+    std::atomic<AAudioStream*> m_handoverFrom{nullptr};
+    OutputMode m_handoverMode = OutputMode::LOW_LATENCY; // Published by m_handoverActive
+    AudioRingBuffer m_handoverTail;                      // Incoming renders ahead, outgoing plays it
+    std::atomic<int64_t> m_handoverTailFrames{-1};       // -1 until the claim sizes it
+    std::atomic<int64_t> m_handoverPadding{0};           // Incoming stream's lead-in silence left
+    std::atomic<bool> m_handoverClaimed{false};
+    std::atomic<int64_t> m_handoverGapFrames{0};         // Positive: tail, negative: padding
+    std::unique_ptr<float[]> m_handoverScratch;          // Outgoing 16-bit stream converts the tail here
+    std::atomic<AAudioStream*> m_retiredStream{nullptr}; // Handed over and stopping; closed by the next stream operation
+    
+    // Per-mode cost, for power comparisons
+    static constexpr int OUTPUT_MODE_COUNT = 2;
+    struct OutputModeCounters {
+        std::atomic<uint64_t> callbacks{0};
+        std::atomic<int64_t> audioNs{0};
+        std::atomic<int64_t> callbackCpuNs{0};
+        std::atomic<int64_t> decodeCpuNs{0};
+        std::atomic<uint64_t> decodeWakeups{0};
+    };
+    OutputModeCounters m_modeCounters[OUTPUT_MODE_COUNT];
+    
+    // Control thread: playback commands from any thread, run in order
+    ControlQueue m_control;
+    std::mutex m_postedSourceMutex;
+    std::list<std::string> m_postedSources;              // postAudioSource paths, until run or shutdown
+    std::mutex m_postedConfigMutex;
+    std::list<AudioEngineConfig> m_postedConfigs;        // postConfiguration settings, likewise
+    
+    // Route changes: the error callback hands the reopen to the recovery thread
+    std::thread m_recoveryThread;
+    std::mutex m_recoveryMutex;
+    std::condition_variable m_recoveryWake;
+    AAudioStream* m_disconnectedStream = nullptr;        // Under m_recoveryMutex
+    bool m_stopRecovery = true;                          // Under m_recoveryMutex; true without a thread
+    std::atomic<int64_t> m_disconnectTimeNs{0};
+    std::atomic<bool> m_awaitingResume{false};           // First burst after a reopen stamps the time
+    std::atomic<uint64_t> m_streamRecoveries{0};
+    std::atomic<double> m_lastRecoveryMs{0.0};
+    
+    // Cold start: background open, pre-warmed stream, time to first audio
+    std::thread m_streamOpenThread;
+    std::mutex m_streamOpenMutex;                        // Serializes joining m_streamOpenThread
+    std::atomic<bool> m_streamWarm{false};               // Running on silence, not claimed by a play yet
+    int64_t m_warmFrames = 0;                            // Audio thread: silence since the warm start
+    std::atomic<int64_t> m_playRequestNs{0};
+    std::atomic<bool> m_awaitingFirstAudio{false};
+    std::atomic<double> m_timeToFirstAudioMs{0.0};
     
     // Performance tracking
     mutable std::mutex m_metricsMutex;
     PerformanceMetrics m_currentMetrics;
     
+    // Lock-free state export
+    SnapshotPublisher m_snapshot;
+    std::atomic<int64_t> m_framesRendered{0};
+    std::atomic<int64_t> m_streamFramesWritten{0};      // Stream position after the last burst
+    std::atomic<float> m_burstPeaks[SNAPSHOT_MAX_CHANNELS] = {}; // Written by audio thread
+    
+    // Decoded source -> callback through a lock-free ring
+    std::unique_ptr<AudioSource> m_source;               // Decode thread owns it while running
+    AudioRingBuffer m_decodeRing;
+    std::atomic<bool> m_hasSource{false};
+    std::atomic<bool> m_sourceEnded{false};
+    std::atomic<uint64_t> m_starvedCallbacks{0};         // Ring ran dry mid-track
+    
+    // Next queued track, opened by the decode thread while storage is awake for a batch
+    std::mutex m_prefetchMutex;
+    std::string m_prefetchRequest;                       // Under m_prefetchMutex
+    std::atomic<bool> m_prefetchRequested{false};
+    std::unique_ptr<AudioSource> m_prefetchedSource;     // Under m_prefetchMutex
+    std::string m_prefetchedPath;                        // Under m_prefetchMutex
+    
+    // Decode activity: live figures published by the decode thread, retired on track change
+    std::atomic<uint64_t> m_decodeWakeups{0};
+    std::atomic<uint64_t> m_liveReadRequests{0};
+    std::atomic<uint64_t> m_liveBytesRead{0};
+    std::atomic<uint64_t> m_retiredReadRequests{0};
+    std::atomic<uint64_t> m_retiredBytesRead{0};
+    IoStats m_sourceIoCounted;                           // m_source reads already retired (its prefetch)
+    
+    // Sidecar seek index: built in the background on first play
+    std::string m_seekIndexDirectory;
+    std::string m_pendingSeekIndexPath;                  // Read by decode thread once ready
+    std::thread m_indexThread;
+    std::atomic<bool> m_cancelIndexing{false};
+    std::atomic<bool> m_seekIndexReady{false};           // Indexer -> decode thread
+    
+    // Seek handshake: control -> decode thread (request), decode thread -> callback (commit)
+    std::atomic<int64_t> m_seekTarget{0};
+    std::atomic<uint32_t> m_seekRequestSerial{0};
+    std::atomic<int64_t> m_seekRequestTimeNs{0};
+    std::atomic<uint32_t> m_seekCommitSequence{0};       // Seqlock over the three fields below
+    std::atomic<uint32_t> m_seekCommitSerial{0};
+    std::atomic<int64_t> m_seekCommitFlushPosition{0};
+    std::atomic<int64_t> m_seekCommitFrame{0};
+    uint32_t m_appliedSeekSerial = 0;                    // Audio thread only
+    bool m_awaitingSeekAudio = false;                    // Audio thread only
+    std::atomic<double> m_lastSeekLatencyMs{0.0};
+    
+    // Mixer: voice slots plus the main program's own gain ramp
+    VoiceMixer m_mixer;
+    GainRamp m_programGain;
+    
+    // Automation timeline, evaluated per burst
+    AutomationScheduler m_automation;
+    int64_t m_burstSourceFrame = 0;                      // Audio thread only
+    int32_t m_burstSourceFrames = 0;                     // Audio thread only
+    double m_burstSourceRate = 1.0;                      // Audio thread only
+    
+    // Time-stretch between the decode ring and the rest of the chain
+    TimeStretcher m_stretcher;                           // Audio thread only
+    std::atomic<double> m_tempo{1.0};
+    std::atomic<double> m_pitchSemitones{0.0};
+    std::atomic<StretchMode> m_stretchMode{StretchMode::MUSIC};
+    int64_t m_stretchOrigin = 0;                         // Audio thread: source frame at stretcher position 0
+    int64_t m_stretchInputEnd = -1;                      // Audio thread: stretcher position of the source end
+    
+    // Loudness stage: normalization gain on the program, limiter on the final mix
+    LoudnessNormalizer m_loudness;                       // Audio thread only
+    GainRamp m_loudnessGain;
+    TruePeakLimiter m_limiter;                           // Audio thread only
+    std::atomic<bool> m_loudnessEnabled{false};
+    std::atomic<float> m_loudnessTargetLufs{LoudnessNormalizer::DEFAULT_TARGET_LUFS};
+    static constexpr float UNKNOWN_TRACK_LOUDNESS = 1.0f;   // Above any real track
+    std::atomic<float> m_trackLoudnessLufs{UNKNOWN_TRACK_LOUDNESS};
+    std::atomic<uint32_t> m_loudnessTrackSerial{0};      // Bumped per track
+    std::atomic<bool> m_limiterEnabled{false};
+    std::atomic<bool> m_dspEnabled{true};                // config.enableDSPProcessing for the callback
+    std::atomic<float> m_limiterCeilingDb{TruePeakLimiter::DEFAULT_CEILING_DB};
+    std::atomic<float> m_integratedLufs{static_cast<float>(LoudnessMeter::NO_MEASUREMENT_LUFS)};
+    std::atomic<float> m_limiterReductionDb{0.0f};
+    uint32_t m_seenLoudnessSerial = 0;                   // Audio thread only
+    float m_loudnessGainDb = 0.0f;                       // Audio thread only
+    bool m_limiterActive = false;                        // Audio thread only
+    
+    // Channel layout: custom matrices per source channel count, read by the decode thread
+    std::mutex m_channelMapMutex;
+    DownmixMatrix m_customDownmix[DownmixMatrix::MAX_CHANNELS]; // [inputs - 1], 0 inputs = standard
+    std::atomic<bool> m_headphoneVirtualizer{false};
+    std::atomic<uint32_t> m_channelMapSerial{0};
+    
+    // Equalizer: coefficients from control threads and the adaptive worker, run by the callback
+    Equalizer m_equalizer;                               // Audio thread only (post() aside)
+    AdaptiveEq m_adaptiveEq;
+    
+    // Offline render: per-stage timing, only while renderOffline() runs
+    OfflineRenderStats* m_offlineStats = nullptr;
+    
+    // 440 Hz verification tone when DSP is on and nothing is loaded
+    fastmath::WavetableOscillator m_testTone;            // Audio thread only
+    
+    // Playhead
+    PlayheadTracker m_playhead;
+    std::atomic<int64_t> m_readHeadFrame{0};             // Source frame at the ring read head
+    std::atomic<int64_t> m_presentationLagFrames{0};     // Frames written but not yet presented
+    
     // Threading
-    std::thread m_processingThread;
+    std::thread m_processingThread;                      // Decode thread
     std::atomic<bool> m_stopProcessing{false};
+    std::mutex m_decodeMutex;
+    std::condition_variable m_decodeWake;
     
     // Buffer management
     std::unique_ptr<float[]> m_audioBuffer;
@@ -193,10 +547,55 @@ private:
     std::chrono::high_resolution_clock::time_point m_lastCallbackTime;
     
     // Internal methods
-    EngineResult setupAAudioStream();
+    EngineResult runCommand(const ControlCommand& command);   // Control thread
+    EngineResult startNow();
+    EngineResult stopNow();
+    EngineResult pauseNow();
+    EngineResult setOutputModeNow(OutputMode mode);
+    EngineResult setAudioSourceNow(const std::string& filePath);
+    EngineResult seekToFrameNow(int64_t sourceFrame);
+    EngineResult updateConfigurationNow(const AudioEngineConfig& config);
+    EngineResult setupAAudioStream(bool holdSampleRate);   // Under m_streamMutex
+    EngineResult openOutputStream(OutputMode mode, bool holdSampleRate, AAudioStream** stream);
+    aaudio_result_t openAAudioStream(aaudio_sharing_mode_t sharingMode, aaudio_format_t format,
+                                     OutputMode mode, AAudioStream** stream);
+    EngineResult reopenStream(OutputMode mode);            // Under m_streamMutex
+    EngineResult handOverStream(OutputMode mode);          // Under m_streamMutex
+    bool cancelHandover();
+    void closeRetiredStream();                             // Under m_streamMutex
+    bool renderHandover(AAudioStream* stream, void* audioData, int32_t numFrames);
+    bool renderIncoming(AAudioStream* stream, void* audioData, int32_t numFrames);
+    bool claimHandover(AAudioStream* stream, bool& keepRunning);
+    void playHandoverTail(void* audioData, int32_t numFrames);
     void cleanupAAudioStream();
-    void processAudioCallback(float* outputBuffer, int32_t numFrames);
-    void updateCallbackMetrics(double processingTimeUs);
+    void reconfigureForRate();
+    void startRecoveryThread();
+    void stopRecoveryThread();
+    void recoveryThreadFunction();
+    void recoverStream(AAudioStream* lostStream);
+    void openStreamInBackground();
+    void awaitStreamOpen();
+    void prewarm();                                        // Under m_streamMutex
+    aaudio_data_callback_result_t renderWarmSilence(void* audioData, int32_t numFrames, int64_t streamFrame);
+    bool renderOutput(void* audioData, int32_t numFrames, int64_t streamFrame);
+    void stampFirstAudio(const float* outputBuffer, int32_t numFrames);
+    bool processAudioCallback(float* outputBuffer, int32_t numFrames, int64_t streamFrame);
+    bool renderPcm16(int16_t* outputBuffer, int32_t numFrames, int64_t streamFrame);
+    void renderSource(float* outputBuffer, int32_t numFrames, int64_t streamFrame);
+    int32_t renderStretched(float* outputBuffer, int32_t numFrames, int64_t streamFrame);
+    static int32_t pullStretchInput(float* frames, int32_t count, void* userData);
+    void resetStretcher(int64_t sourceFrame);
+    bool stretcherHoldsSource() const;
+    void mixSpan(float* outputBuffer, int32_t from, int32_t to);
+    void applyLoudness(float* outputBuffer, int32_t numFrames);
+    void applyEqualizer(float* outputBuffer, int32_t numFrames);
+    void refreshLimiter();
+    bool applyAutomation(const AutomationEvent& event);
+    bool applySeekCommit();
+    void publishSeekCommit(uint32_t serial, int64_t flushPosition, int64_t sourceFrame);
+    void updateCallbackMetrics(double processingTimeUs, int32_t numFrames);
+    void publishSnapshot();
+    EngineSnapshotData buildSnapshotData(const PerformanceMetrics& metrics) const;
     static aaudio_data_callback_result_t audioCallback(
         AAudioStream* stream,
         void* userData,
@@ -209,12 +608,25 @@ private:
         aaudio_result_t error
     );
     
+    struct DecodeState;
+    void prepareDecode(DecodeState& state);
+    void refreshChannelMap(DecodeState& state);
+    bool decodeStep(DecodeState& state);   // False when there is nothing to do
     void processingThreadFunction();
+    std::chrono::microseconds batchSleep(std::chrono::microseconds pollInterval) const;
+    void servicePrefetch();
+    void retireIoStats(const IoStats& stats, const IoStats& counted);
+    size_t sourceReadBufferBytes() const;
+    void startDecodeThread();
+    void stopDecodeThread();
+    void startSeekIndexBuild(const std::string& sourcePath, const std::string& sidecarPath);
+    void stopSeekIndexBuild();
     void updatePerformanceMetrics();
     EngineResult validateConfiguration(const AudioEngineConfig& config) const;
     
     // Helper methods
     double getCurrentTimeMs() const;
+    int32_t msToFrames(int32_t ms) const;
     void logConfiguration(const AudioEngineConfig& config) const;
     
     // Prevent copy and assignment
@@ -0,0 +1,94 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           OFFLINE RENDER - FASTER-THAN-REALTIME JOBS        ║
+ * ║     Production DSP Chain to File or Memory, Many Tracks     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "OfflineRender.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#define LOG_TAG "FTL_OfflineRender"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+EngineResult renderOfflineJob(FTLAudioEngine& engine, OfflineJob& job) {
+    FTL_TRACE_SCOPE("offlineJob");
+    job.samples.clear();
+    job.result = engine.setAudioSource(job.sourcePath);
+    if (job.result != EngineResult::SUCCESS) {
+        return job.result;
+    }
+
+    AudioEngineConfig config = engine.getCurrentConfiguration();
+    job.sampleRate = config.sampleRate;
+    job.channelCount = config.channelCount;
+
+    WavWriter writer;
+    OfflineSink sink;
+    if (job.outputPath.empty()) {
+        sink = [&job](const float* frames, int32_t numFrames, int channelCount) {
+            job.samples.insert(job.samples.end(), frames, frames + static_cast<size_t>(numFrames) * channelCount);
+            return true;
+        };
+    } else {
+        if (!writer.open(job.outputPath, config.sampleRate, config.channelCount, job.outputFormat)) {
+            job.result = EngineResult::ERROR_PROCESSING_FAILED;
+            return job.result;
+        }
+        sink = [&writer](const float* frames, int32_t numFrames, int) {
+            return writer.write(frames, numFrames);
+        };
+    }
+
+    job.result = engine.renderOffline(sink, &job.stats);
+    if (!job.outputPath.empty() && !writer.close() && job.result == EngineResult::SUCCESS) {
+        LOGE("Cannot finish %s", job.outputPath.c_str());
+        job.result = EngineResult::ERROR_PROCESSING_FAILED;
+    }
+    return job.result;
+}
+
+void renderOfflineJobs(const AudioEngineConfig& config, const OfflineSetup& setup,
+                       std::vector<OfflineJob>& jobs, int threads) {
+    AudioEngineConfig offline = config;
+    offline.offlineRender = true;
+    std::atomic<size_t> next{0};
+
+    auto worker = [&] {
+        FTL_TRACE_THREAD_NAME("offlineRender");
+        FTLAudioEngine engine;
+        EngineResult init = engine.initialize(offline);
+        if (init == EngineResult::SUCCESS && setup) {
+            setup(engine);
+        }
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            if (init != EngineResult::SUCCESS) {
+                jobs[i].result = init;
+                continue;
+            }
+            if (renderOfflineJob(engine, jobs[i]) != EngineResult::SUCCESS) {
+                LOGE("Offline render of %s failed (%d)", jobs[i].sourcePath.c_str(),
+                     static_cast<int>(jobs[i].result));
+            }
+        }
+    };
+
+    int workers = std::max(1, std::min(threads, static_cast<int>(jobs.size())));
+    std::vector<std::thread> pool;
+    for (int i = 1; i < workers; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,55 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           OFFLINE RENDER - FASTER-THAN-REALTIME JOBS        ║
+ * ║     Production DSP Chain to File or Memory, Many Tracks     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Each worker owns one engine initialized with `offlineRender`, so a
+ * render runs the exact graph of the audio callback (same burst size,
+ * same stages) but is paced by the CPU instead of the device. Tracks are
+ * independent and spread across workers.
+ */
+
+#ifndef FTL_OFFLINE_RENDER_H
+#define FTL_OFFLINE_RENDER_H
+
+#include "FTLAudioEngine.h"
+#include "WavWriter.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+struct OfflineJob {
+    std::string sourcePath;
+    std::string outputPath;                    // Empty: keep the render in `samples`
+    WavSampleFormat outputFormat = WavSampleFormat::FLOAT_32;
+
+    // Filled in by the render
+    EngineResult result = EngineResult::ERROR_NOT_INITIALIZED;
+    std::vector<float> samples;                // Interleaved, memory renders only
+    int sampleRate = 0;
+    int channelCount = 0;
+    OfflineRenderStats stats;
+};
+
+/** Applies DSP settings (loudness, limiter, channel layout...) to each worker's engine */
+using OfflineSetup = std::function<void(FTLAudioEngine& engine)>;
+
+/** Render one job on an engine already initialized with `offlineRender` */
+EngineResult renderOfflineJob(FTLAudioEngine& engine, OfflineJob& job);
+
+/**
+ * Render every job with up to `threads` workers, each with its own engine.
+ * `config.offlineRender` is forced on; results land in the jobs.
+ */
+void renderOfflineJobs(const AudioEngineConfig& config, const OfflineSetup& setup,
+                       std::vector<OfflineJob>& jobs, int threads);
+
+} // namespace ftl_audio
+
+#endif // FTL_OFFLINE_RENDER_H
@@ -0,0 +1,73 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - PLAYHEAD TRACKER              ║
+ * ║      Sample-Accurate Source Position at the Speaker         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "PlayheadTracker.h"
+
+#include <cmath>
+
+namespace ftl_audio {
+
+void PlayheadTracker::recordSpan(int64_t streamFrame, int64_t sourceFrame, int32_t frames, double sourceRate) {
+    if (frames <= 0) {
+        return;
+    }
+
+    uint64_t index = m_anchorCount.load(std::memory_order_relaxed);
+    Anchor& anchor = m_anchors[index % ANCHOR_COUNT];
+
+    // Per-anchor seqlock so readers never combine fields from two bursts
+    uint32_t seq = anchor.sequence.load(std::memory_order_relaxed);
+    anchor.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    anchor.streamFrame.store(streamFrame, std::memory_order_relaxed);
+    anchor.sourceFrame.store(sourceFrame, std::memory_order_relaxed);
+    anchor.frames.store(frames, std::memory_order_relaxed);
+    anchor.rate.store(sourceRate, std::memory_order_relaxed);
+    anchor.sequence.store(seq + 2, std::memory_order_release);
+
+    m_anchorCount.store(index + 1, std::memory_order_release);
+    if (sourceFrame != NO_SOURCE) {
+        m_lastSourceEnd.store(sourceFrame + std::llround(frames * sourceRate), std::memory_order_release);
+    }
+}
+
+int64_t PlayheadTracker::sourceFrameAt(int64_t streamFrame) const {
+    uint64_t count = m_anchorCount.load(std::memory_order_acquire);
+    uint64_t history = count < ANCHOR_COUNT ? count : ANCHOR_COUNT;
+
+    // Newest first: the presented frame is almost always within the last few bursts
+    for (uint64_t back = 1; back <= history; ++back) {
+        const Anchor& anchor = m_anchors[(count - back) % ANCHOR_COUNT];
+
+        uint32_t before = anchor.sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        int64_t start = anchor.streamFrame.load(std::memory_order_relaxed);
+        int64_t source = anchor.sourceFrame.load(std::memory_order_relaxed);
+        int32_t frames = anchor.frames.load(std::memory_order_relaxed);
+        double rate = anchor.rate.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (anchor.sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        if (streamFrame >= start && streamFrame < start + frames) {
+            if (source == NO_SOURCE) {
+                return NO_SOURCE;
+            }
+            return source + static_cast<int64_t>((streamFrame - start) * rate);
+        }
+        if (start + frames <= streamFrame) {
+            // Anchors are in stream order; anything older cannot contain it
+            break;
+        }
+    }
+    return NO_SOURCE;
+}
+
+} // namespace ftl_audio
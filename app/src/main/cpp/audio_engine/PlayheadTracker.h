@@ -0,0 +1,61 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - PLAYHEAD TRACKER              ║
+ * ║      Sample-Accurate Source Position at the Speaker         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * The callback writes stream frames; the DAC presents them later. Each
+ * burst records an anchor (stream frame -> source frame). Control threads
+ * combine the AAudio presentation timestamp with these anchors to answer
+ * "which source sample is audible right now", across seeks and underruns.
+ */
+
+#ifndef FTL_PLAYHEAD_TRACKER_H
+#define FTL_PLAYHEAD_TRACKER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace ftl_audio {
+
+class PlayheadTracker {
+public:
+    // Enough history to cover deep (power-saving) buffers at small bursts
+    static constexpr int ANCHOR_COUNT = 1024;
+    static constexpr int64_t NO_SOURCE = -1;
+
+    /**
+     * Audio thread only. Stream frames [streamFrame, streamFrame + frames)
+     * carry source frames starting at `sourceFrame` (NO_SOURCE for silence),
+     * `sourceRate` source frames per stream frame (time-stretched playback).
+     */
+    void recordSpan(int64_t streamFrame, int64_t sourceFrame, int32_t frames, double sourceRate = 1.0);
+
+    /**
+     * Any thread. Source frame at stream position `streamFrame`, or
+     * NO_SOURCE if that span was silence or has aged out of the history.
+     */
+    int64_t sourceFrameAt(int64_t streamFrame) const;
+
+    /** Any thread. Most recent source frame written (end of the last source span) */
+    int64_t lastWrittenSourceFrame() const { return m_lastSourceEnd.load(std::memory_order_acquire); }
+
+private:
+    struct Anchor {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<int64_t> streamFrame{0};
+        std::atomic<int64_t> sourceFrame{NO_SOURCE};
+        std::atomic<int32_t> frames{0};
+        std::atomic<double> rate{1.0};
+    };
+
+    Anchor m_anchors[ANCHOR_COUNT];
+    std::atomic<uint64_t> m_anchorCount{0};
+    std::atomic<int64_t> m_lastSourceEnd{0};
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_PLAYHEAD_TRACKER_H
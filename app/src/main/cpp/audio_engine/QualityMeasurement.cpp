@@ -0,0 +1,264 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║         QUALITY MEASUREMENT - THD+N, SNR, IMD, RESPONSE     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "QualityMeasurement.h"
+#include "Resampler.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+
+#define LOG_TAG "FTL_Quality"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr int FFT_SIZE = analysis::DEFAULT_FFT_SIZE;
+constexpr int SETTLE_FRAMES = 8192;        // Limiter look-ahead, crossfeed and resampler state
+constexpr int TAIL_FRAMES = 4096;          // Keeps the window clear of end-of-source handling
+constexpr int64_t SIGNAL_FRAMES = SETTLE_FRAMES + FFT_SIZE + TAIL_FRAMES;
+constexpr int SOURCE_CHANNELS = 2;
+constexpr int MULTITONE_COUNT = 30;
+constexpr int32_t RESAMPLER_BLOCK_FRAMES = 1024;
+
+constexpr double TONE_HZ = 1000.0;
+constexpr double TONE_AMPLITUDE = 0.70794578;      // -3 dBFS
+constexpr double LOW_TONE_AMPLITUDE = 0.001;       // -60 dBFS
+constexpr double SMPTE_LOW_HZ = 60.0;
+constexpr double SMPTE_HIGH_HZ = 7000.0;
+constexpr double MULTITONE_PEAK = 0.5;
+
+// A channel whose 1 kHz tone is this far below the source carries no program
+constexpr double SILENT_CHANNEL_DB = 40.0;
+
+enum TestSignal { TONE, LOW_TONE, SMPTE, MULTITONE, SWEEP, SIGNAL_COUNT };
+const char* const SIGNAL_NAMES[SIGNAL_COUNT] = {"tone", "lowtone", "smpte", "multitone", "sweep"};
+
+std::atomic<unsigned> g_measurementCounter{0};
+
+/** Stereo test signals at `sourceRate` whose tones sit on bins of the analysis rate */
+struct TestSignals {
+    int rate = 0;                          // Analysis (output) rate
+    int toneBin = 0;
+    int smpteLowBin = 0;
+    int smpteHighBin = 0;
+    std::vector<int> multitoneBins;
+    std::vector<std::vector<float>> sources;
+    std::vector<float> sweepReference;     // The sweep at the analysis rate, FFT_SIZE mono frames
+};
+
+TestSignals makeTestSignals(int rate, int sourceRate) {
+    TestSignals signals;
+    signals.rate = rate;
+    signals.toneBin = analysis::binOf(TONE_HZ, rate, FFT_SIZE);
+    signals.smpteLowBin = analysis::binOf(SMPTE_LOW_HZ, rate, FFT_SIZE);
+    signals.smpteHighBin = analysis::binOf(SMPTE_HIGH_HZ, rate, FFT_SIZE);
+    signals.multitoneBins = analysis::multitoneBins(MULTITONE_COUNT, rate, FFT_SIZE);
+
+    auto hz = [&](int bin) { return analysis::binFrequency(bin, rate, FFT_SIZE); };
+    auto toSource = [&](int64_t frames) { return (frames * sourceRate + rate - 1) / rate; };
+    std::vector<double> multitoneHz;
+    for (int bin : signals.multitoneBins) {
+        multitoneHz.push_back(hz(bin));
+    }
+
+    const int64_t frames = toSource(SIGNAL_FRAMES);
+    signals.sources.assign(SIGNAL_COUNT, std::vector<float>(frames * SOURCE_CHANNELS, 0.0f));
+    analysis::generateTone(signals.sources[TONE].data(), frames, SOURCE_CHANNELS, hz(signals.toneBin),
+                           TONE_AMPLITUDE, sourceRate);
+    analysis::generateTone(signals.sources[LOW_TONE].data(), frames, SOURCE_CHANNELS, hz(signals.toneBin),
+                           LOW_TONE_AMPLITUDE, sourceRate);
+    analysis::generateTwoTone(signals.sources[SMPTE].data(), frames, SOURCE_CHANNELS, hz(signals.smpteLowBin),
+                              TONE_AMPLITUDE * 0.8, hz(signals.smpteHighBin), TONE_AMPLITUDE * 0.2, sourceRate);
+    analysis::generateMultitone(signals.sources[MULTITONE].data(), frames, SOURCE_CHANNELS, multitoneHz,
+                                MULTITONE_PEAK, sourceRate);
+
+    // Sweep in the first half of the window, silence after: the chain's delay stays inside it
+    const double sweepEndHz = std::min(22000.0, 0.46 * std::min(rate, sourceRate));
+    analysis::generateLogSweep(signals.sources[SWEEP].data() + toSource(SETTLE_FRAMES) * SOURCE_CHANNELS,
+                               toSource(FFT_SIZE / 2), SOURCE_CHANNELS, 10.0, sweepEndHz, TONE_AMPLITUDE, sourceRate);
+    signals.sweepReference.assign(FFT_SIZE, 0.0f);
+    analysis::generateLogSweep(signals.sweepReference.data(), FFT_SIZE / 2, 1, 10.0, sweepEndHz,
+                               TONE_AMPLITUDE, rate);
+    return signals;
+}
+
+/** Worst channel of every measurement over the renders of each test signal */
+EngineResult analyzeRenders(const TestSignals& signals, const std::vector<const float*>& renders,
+                            int channels, QualityReport& report) {
+    const int rate = signals.rate;
+    analysis::Fft fft(FFT_SIZE);
+    auto window = [&](TestSignal signal) { return renders[signal] + SETTLE_FRAMES * channels; };
+    std::vector<double> power;
+    std::vector<std::complex<double>> sweepIn;
+    std::vector<std::complex<double>> sweepOut;
+    fft.transform(signals.sweepReference.data(), 1, 0, false, sweepIn);
+
+    bool measured = false;
+    double thdPlusN = 0.0;
+    double thd = 0.0;
+    double lowLevel = 0.0;
+    double imd = 0.0;
+    double multitoneDistortion = 0.0;
+    for (int ch = 0; ch < channels; ++ch) {
+        fft.powerSpectrum(window(TONE), channels, ch, power);
+        analysis::ToneResult tone = analysis::analyzeTone(power, signals.toneBin, rate, FFT_SIZE);
+        if (tone.fundamentalDbfs < analysis::ratioToDb(TONE_AMPLITUDE) - SILENT_CHANNEL_DB) continue;
+
+        thdPlusN = std::max(thdPlusN, tone.thdPlusN);
+        thd = std::max(thd, tone.thd);
+        report.snrDb = measured ? std::min(report.snrDb, tone.snrDb) : tone.snrDb;
+
+        fft.powerSpectrum(window(LOW_TONE), channels, ch, power);
+        lowLevel = std::max(lowLevel, analysis::analyzeTone(power, signals.toneBin, rate, FFT_SIZE).thdPlusN);
+
+        fft.powerSpectrum(window(SMPTE), channels, ch, power);
+        imd = std::max(imd, analysis::analyzeSmpteImd(power, signals.smpteLowBin, signals.smpteHighBin));
+
+        fft.powerSpectrum(window(MULTITONE), channels, ch, power);
+        multitoneDistortion = std::max(multitoneDistortion,
+                                       analysis::analyzeMultitone(power, signals.multitoneBins, rate, FFT_SIZE));
+
+        fft.transform(window(SWEEP), channels, ch, false, sweepOut);
+        std::vector<analysis::ResponsePoint> response = analysis::frequencyResponse(sweepIn, sweepOut, rate, FFT_SIZE);
+        for (const analysis::ResponsePoint& point : response) {
+            report.responseMinDb = measured ? std::min(report.responseMinDb, point.db) : point.db;
+            report.responseMaxDb = measured ? std::max(report.responseMaxDb, point.db) : point.db;
+            measured = true;
+        }
+        if (report.response.empty()) report.response = std::move(response);
+        measured = true;
+    }
+    if (!measured) {
+        LOGE("No output channel carries the test signal");
+        return EngineResult::ERROR_PROCESSING_FAILED;
+    }
+
+    report.thdPlusNPercent = thdPlusN * 100.0;
+    report.thdPlusNDb = analysis::ratioToDb(thdPlusN);
+    report.thdDb = analysis::ratioToDb(thd);
+    report.lowLevelThdPlusNDb = analysis::ratioToDb(lowLevel);
+    report.imdPercent = imd * 100.0;
+    report.multitoneDistortionDb = analysis::ratioToDb(multitoneDistortion);
+    return EngineResult::SUCCESS;
+}
+
+bool writeSignal(const std::string& path, const std::vector<float>& samples, int sampleRate) {
+    WavWriter writer;
+    if (!writer.open(path, sampleRate, SOURCE_CHANNELS, WavSampleFormat::FLOAT_32)) return false;
+    bool written = writer.write(samples.data(), static_cast<int32_t>(samples.size() / SOURCE_CHANNELS));
+    return writer.close() && written;
+}
+
+double elapsedMsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE CHAIN
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult measureChainQuality(const AudioEngineConfig& config, const OfflineSetup& setup,
+                                 const std::string& scratchDirectory, QualityReport& report) {
+    FTL_TRACE_SCOPE("measureQuality");
+    auto started = std::chrono::steady_clock::now();
+    report = QualityReport();
+    const int rate = config.sampleRate;
+    // The engine runs at the source's rate, so the sources are written at the output rate
+    TestSignals signals = makeTestSignals(rate, rate);
+
+    std::string prefix = scratchDirectory + "/ftl_quality_" + std::to_string(getpid()) + "_" +
+                         std::to_string(g_measurementCounter++) + "_";
+    std::vector<OfflineJob> jobs(SIGNAL_COUNT);
+    EngineResult result = EngineResult::SUCCESS;
+    for (int i = 0; i < SIGNAL_COUNT && result == EngineResult::SUCCESS; ++i) {
+        jobs[i].sourcePath = prefix + SIGNAL_NAMES[i] + ".wav";
+        if (!writeSignal(jobs[i].sourcePath, signals.sources[i], rate)) {
+            LOGE("Cannot write test signal %s", jobs[i].sourcePath.c_str());
+            result = EngineResult::ERROR_PROCESSING_FAILED;
+        }
+    }
+    if (result == EngineResult::SUCCESS) {
+        renderOfflineJobs(config, setup, jobs, SIGNAL_COUNT);
+    }
+    for (const OfflineJob& job : jobs) {
+        if (!job.sourcePath.empty()) std::remove(job.sourcePath.c_str());
+        if (result == EngineResult::SUCCESS && job.result != EngineResult::SUCCESS) result = job.result;
+    }
+    if (result != EngineResult::SUCCESS) {
+        return result;
+    }
+
+    const int channels = jobs[TONE].channelCount;
+    std::vector<const float*> renders;
+    for (const OfflineJob& job : jobs) {
+        if (job.channelCount != channels || job.sampleRate != rate ||
+            job.samples.size() < static_cast<size_t>(SETTLE_FRAMES + FFT_SIZE) * channels) {
+            LOGE("Render of %s is short or not at %d Hz", job.sourcePath.c_str(), rate);
+            return EngineResult::ERROR_PROCESSING_FAILED;
+        }
+        renders.push_back(job.samples.data());
+    }
+
+    result = analyzeRenders(signals, renders, channels, report);
+    if (result != EngineResult::SUCCESS) {
+        return result;
+    }
+    report.elapsedMs = elapsedMsSince(started);
+    LOGI("THD+N %.6f%% (%.1f dB), SNR %.1f dB, IMD %.6f%%, response %+.3f/%+.3f dB in %.0f ms",
+         report.thdPlusNPercent, report.thdPlusNDb, report.snrDb, report.imdPercent,
+         report.responseMinDb, report.responseMaxDb, report.elapsedMs);
+    return EngineResult::SUCCESS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// VOICE RESAMPLER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+EngineResult measureResamplerQuality(int inputRate, int outputRate, QualityReport& report) {
+    FTL_TRACE_SCOPE("measureResamplerQuality");
+    auto started = std::chrono::steady_clock::now();
+    report = QualityReport();
+    if (inputRate <= 0 || outputRate <= 0) {
+        return EngineResult::ERROR_INVALID_CONFIG;
+    }
+    TestSignals signals = makeTestSignals(outputRate, inputRate);
+
+    StreamResampler resampler;
+    std::vector<std::vector<float>> outputs(SIGNAL_COUNT);
+    std::vector<const float*> renders;
+    for (int i = 0; i < SIGNAL_COUNT; ++i) {
+        resampler.configure(inputRate, outputRate, SOURCE_CHANNELS, RESAMPLER_BLOCK_FRAMES);
+        const std::vector<float>& source = signals.sources[i];
+        const int64_t frames = static_cast<int64_t>(source.size() / SOURCE_CHANNELS);
+        std::vector<float>& output = outputs[i];
+        std::vector<float> block(static_cast<size_t>(resampler.maxOutputFrames(RESAMPLER_BLOCK_FRAMES)) * SOURCE_CHANNELS);
+        for (int64_t at = 0; at < frames; at += RESAMPLER_BLOCK_FRAMES) {
+            int32_t count = static_cast<int32_t>(std::min<int64_t>(RESAMPLER_BLOCK_FRAMES, frames - at));
+            int32_t written = resampler.process(source.data() + at * SOURCE_CHANNELS, count, block.data());
+            output.insert(output.end(), block.begin(), block.begin() + static_cast<size_t>(written) * SOURCE_CHANNELS);
+        }
+        if (output.size() < static_cast<size_t>(SETTLE_FRAMES + FFT_SIZE) * SOURCE_CHANNELS) {
+            return EngineResult::ERROR_PROCESSING_FAILED;
+        }
+        renders.push_back(output.data());
+    }
+
+    EngineResult result = analyzeRenders(signals, renders, SOURCE_CHANNELS, report);
+    report.elapsedMs = elapsedMsSince(started);
+    return result;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,67 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║         QUALITY MEASUREMENT - THD+N, SNR, IMD, RESPONSE     ║
+ * ║       Test Signals Rendered Offline Through the Chain       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Each test signal is written as a float WAV at the output rate and
+ * rendered by an offline engine, so it passes the exact decode, mix and
+ * limiter stages of playback. A settle prefix is skipped before the
+ * 65536-frame analysis window; every output channel is analyzed and the
+ * worst one is reported. The voice resampler, which the main source path
+ * never runs, is measured on its own.
+ */
+
+#ifndef FTL_QUALITY_MEASUREMENT_H
+#define FTL_QUALITY_MEASUREMENT_H
+
+#include "OfflineRender.h"
+#include "SignalAnalysis.h"
+
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+struct QualityReport {
+    // 1 kHz sine at -3 dBFS
+    double thdPlusNPercent = 0.0;
+    double thdPlusNDb = 0.0;
+    double thdDb = 0.0;
+    double snrDb = 0.0;
+
+    // 1 kHz sine at -60 dBFS (low-level linearity, exposes gain quantization)
+    double lowLevelThdPlusNDb = 0.0;
+
+    // SMPTE: 60 Hz and 7 kHz at 4:1, peak -3 dBFS
+    double imdPercent = 0.0;
+
+    // 30 log-spaced tones, peak -6 dBFS
+    double multitoneDistortionDb = 0.0;
+
+    // Log sweep, 1/3-octave bands 20 Hz .. 20 kHz relative to 1 kHz
+    double responseMinDb = 0.0;
+    double responseMaxDb = 0.0;
+    std::vector<analysis::ResponsePoint> response;
+
+    double elapsedMs = 0.0;
+};
+
+/**
+ * Measure the chain `config` + `setup` describe. Test WAVs are written to
+ * (and removed from) `scratchDirectory`; `config.offlineRender` is forced on.
+ */
+EngineResult measureChainQuality(const AudioEngineConfig& config, const OfflineSetup& setup,
+                                 const std::string& scratchDirectory, QualityReport& report);
+
+/**
+ * The voice resampler (StreamResampler) alone, `inputRate` -> `outputRate`.
+ * Tones are generated at the input rate on bins of the output rate.
+ */
+EngineResult measureResamplerQuality(int inputRate, int outputRate, QualityReport& report);
+
+} // namespace ftl_audio
+
+#endif // FTL_QUALITY_MEASUREMENT_H
@@ -0,0 +1,407 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               VOICE MIXER - MULTI-SOURCE PLAYBACK           ║
+ * ║      Crossfades, Previews and Prompts in One AAudio Stream  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ */
+
+#include "VoiceMixer.h"
+#include "Downmix.h"
+#include "MixKernels.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+
+#define LOG_TAG "FTL_VoiceMixer"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+// Source frames decoded per feeder step, and the smallest step worth waking for
+constexpr int32_t FEED_CHUNK_FRAMES = 1024;
+constexpr int32_t FEED_MIN_FRAMES = 64;
+
+// Ring reads per voice are staged through scratch in pieces of this size
+constexpr int32_t SCRATCH_FRAMES = 1024;
+
+// A stop that raced with a gain change still fades instead of clicking
+constexpr int32_t STOP_SAFETY_FADE_FRAMES = 256;
+
+constexpr uint32_t GENERATION_MASK = 0x7FFFFFF;
+
+int32_t makeVoiceId(int slot, uint32_t generation) {
+    return static_cast<int32_t>(((generation & GENERATION_MASK) << 4) | static_cast<uint32_t>(slot));
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// GAIN RAMP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void GainRamp::reset(float gain) {
+    m_target.store(gain, std::memory_order_relaxed);
+    m_rampFrames.store(0, std::memory_order_relaxed);
+    m_seenSerial = m_serial.load(std::memory_order_acquire);
+    m_gain = gain;
+    m_rampTarget = gain;
+    m_step = 0.0f;
+    m_remaining = 0;
+}
+
+void GainRamp::setTarget(float gain, int32_t rampFrames) {
+    m_target.store(gain, std::memory_order_relaxed);
+    m_rampFrames.store(rampFrames, std::memory_order_relaxed);
+    m_serial.fetch_add(1, std::memory_order_release);
+}
+
+void GainRamp::refresh() {
+    uint32_t serial = m_serial.load(std::memory_order_acquire);
+    if (serial == m_seenSerial) {
+        return;
+    }
+    m_seenSerial = serial;
+
+    float target = m_target.load(std::memory_order_relaxed);
+    int32_t frames = m_rampFrames.load(std::memory_order_relaxed);
+    if (frames <= 0) {
+        m_gain = target;
+        m_remaining = 0;
+        return;
+    }
+    m_rampTarget = target;
+    m_step = (target - m_gain) / static_cast<float>(frames);
+    m_remaining = frames;
+}
+
+int32_t GainRamp::nextSegment(int32_t maxFrames, float& gain, float& step) {
+    refresh();
+    gain = m_gain;
+    if (m_remaining == 0) {
+        step = 0.0f;
+        return maxFrames;
+    }
+
+    int32_t frames = std::min(maxFrames, m_remaining);
+    step = m_step;
+    m_remaining -= frames;
+    // Land exactly on the target; accumulated float steps drift
+    m_gain = m_remaining == 0 ? m_rampTarget : m_gain + m_step * static_cast<float>(frames);
+    return frames;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SETUP & TEARDOWN
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+VoiceMixer::VoiceMixer()
+    : m_voices(std::make_unique<Voice[]>(MAX_MIXER_VOICES)) {
+}
+
+VoiceMixer::~VoiceMixer() {
+    release();
+}
+
+void VoiceMixer::configure(int sampleRate, int channelCount, int32_t ringFrames) {
+    release();
+
+    m_sampleRate = sampleRate;
+    m_channelCount = channelCount;
+    for (int i = 0; i < MAX_MIXER_VOICES; ++i) {
+        Voice& voice = m_voices[i];
+        if (voice.ring.capacityFrames() < ringFrames || voice.ring.channelCount() != channelCount) {
+            voice.ring.allocate(ringFrames, channelCount);
+        }
+    }
+    m_scratch = std::make_unique<float[]>(static_cast<size_t>(SCRATCH_FRAMES) * channelCount);
+
+    m_stopFeeder.store(false, std::memory_order_release);
+    m_feederThread = std::thread(&VoiceMixer::feederThreadFunction, this);
+    LOGI("Voice mixer: %d slots, %d Hz, %d ch", MAX_MIXER_VOICES, sampleRate, channelCount);
+}
+
+void VoiceMixer::release() {
+    stopFeeder();
+    for (int i = 0; i < MAX_MIXER_VOICES; ++i) {
+        Voice& voice = m_voices[i];
+        voice.source.reset();
+        voice.sourceEnded.store(false, std::memory_order_relaxed);
+        voice.state.store(FREE, std::memory_order_release);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONTROL SIDE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int32_t VoiceMixer::play(std::unique_ptr<AudioSource> source, float gain, int32_t fadeInFrames) {
+    if (!source || !m_scratch) {
+        return INVALID_VOICE;
+    }
+
+    for (int slot = 0; slot < MAX_MIXER_VOICES; ++slot) {
+        Voice& voice = m_voices[slot];
+        int32_t expected = FREE;
+        if (!voice.state.compare_exchange_strong(expected, PREPARING, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        // Nobody else reads or writes a PREPARING slot
+        const AudioSourceInfo& info = source->info();
+        voice.ring.reset();
+        voice.sourceEnded.store(false, std::memory_order_relaxed);
+        voice.resampler.configure(info.sampleRate, m_sampleRate, m_channelCount, FEED_CHUNK_FRAMES);
+        voice.gain.reset(fadeInFrames > 0 ? 0.0f : gain);
+        if (fadeInFrames > 0) {
+            voice.gain.setTarget(gain, fadeInFrames);
+        }
+        voice.source = std::move(source);
+        uint32_t generation = voice.generation.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        voice.state.store(PLAYING, std::memory_order_release);
+        wakeFeeder();
+        return makeVoiceId(slot, generation);
+    }
+
+    LOGE("All %d voices busy", MAX_MIXER_VOICES);
+    return INVALID_VOICE;
+}
+
+VoiceMixer::Voice* VoiceMixer::voiceFor(int32_t voiceId) const {
+    if (voiceId < 0) {
+        return nullptr;
+    }
+    int slot = voiceId & 0xF;
+    uint32_t generation = static_cast<uint32_t>(voiceId) >> 4;
+    Voice& voice = m_voices[slot];
+    if ((voice.generation.load(std::memory_order_relaxed) & GENERATION_MASK) != generation) {
+        return nullptr; // Slot has been reused since this id was handed out
+    }
+    return &voice;
+}
+
+bool VoiceMixer::setGain(int32_t voiceId, float gain, int32_t rampFrames) {
+    Voice* voice = voiceFor(voiceId);
+    if (!voice || voice->state.load(std::memory_order_acquire) != PLAYING) {
+        return false;
+    }
+    voice->gain.setTarget(gain, rampFrames);
+    return true;
+}
+
+bool VoiceMixer::stop(int32_t voiceId, int32_t fadeOutFrames) {
+    Voice* voice = voiceFor(voiceId);
+    if (!voice) {
+        return false;
+    }
+    int32_t expected = PLAYING;
+    if (!voice->state.compare_exchange_strong(expected, STOPPING, std::memory_order_acq_rel)) {
+        return expected == STOPPING;
+    }
+    voice->gain.setTarget(0.0f, fadeOutFrames);
+    return true;
+}
+
+void VoiceMixer::stopAll(int32_t fadeOutFrames) {
+    for (int slot = 0; slot < MAX_MIXER_VOICES; ++slot) {
+        Voice& voice = m_voices[slot];
+        int32_t expected = PLAYING;
+        if (voice.state.compare_exchange_strong(expected, STOPPING, std::memory_order_acq_rel)) {
+            voice.gain.setTarget(0.0f, fadeOutFrames);
+        }
+    }
+}
+
+bool VoiceMixer::isActive(int32_t voiceId) const {
+    Voice* voice = voiceFor(voiceId);
+    if (!voice) {
+        return false;
+    }
+    int32_t state = voice->state.load(std::memory_order_acquire);
+    return state == PREPARING || state == PLAYING || state == STOPPING;
+}
+
+int VoiceMixer::activeVoiceCount() const {
+    int count = 0;
+    for (int slot = 0; slot < MAX_MIXER_VOICES; ++slot) {
+        count += m_voices[slot].state.load(std::memory_order_acquire) != FREE ? 1 : 0;
+    }
+    return count;
+}
+
+int32_t VoiceMixer::bufferedFrames(int32_t voiceId) const {
+    Voice* voice = voiceFor(voiceId);
+    return voice ? voice->ring.availableToRead() : 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// AUDIO SIDE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int VoiceMixer::render(float* output, int32_t numFrames) {
+    FTL_TRACE_SCOPE("voiceMixer");
+    if (!m_scratch) {
+        return 0;
+    }
+
+    const int channels = m_channelCount;
+    float* scratch = m_scratch.get();
+    int mixed = 0;
+
+    for (int slot = 0; slot < MAX_MIXER_VOICES; ++slot) {
+        Voice& voice = m_voices[slot];
+        int32_t state = voice.state.load(std::memory_order_acquire);
+        if (state != PLAYING && state != STOPPING) {
+            continue;
+        }
+
+        int32_t done = 0;
+        while (done < numFrames) {
+            int32_t wanted = std::min(numFrames - done, SCRATCH_FRAMES);
+            int32_t got = voice.ring.read(scratch, wanted);
+
+            // Ring runs dry: the voice is silent for the rest of the burst
+            for (int32_t offset = 0; offset < got;) {
+                float gain;
+                float step;
+                int32_t frames = voice.gain.nextSegment(got - offset, gain, step);
+                if (gain != 0.0f || step != 0.0f) {
+                    mix::addRamped(output + static_cast<size_t>(done + offset) * channels,
+                                   scratch + static_cast<size_t>(offset) * channels,
+                                   frames, channels, gain, step);
+                }
+                offset += frames;
+            }
+            done += got;
+            if (got < wanted) {
+                break;
+            }
+        }
+        ++mixed;
+
+        if (state == STOPPING && !voice.gain.isRamping()) {
+            if (voice.gain.current() == 0.0f) {
+                voice.state.store(FINISHED, std::memory_order_release);
+                continue;
+            }
+            voice.gain.setTarget(0.0f, STOP_SAFETY_FADE_FRAMES);
+        }
+        if (voice.sourceEnded.load(std::memory_order_acquire) && voice.ring.availableToRead() == 0) {
+            voice.state.store(FINISHED, std::memory_order_release);
+        }
+    }
+    return mixed;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FEEDER THREAD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void VoiceMixer::wakeFeeder() {
+    {
+        std::lock_guard<std::mutex> lock(m_feederMutex);
+        m_feederKick = true;
+    }
+    m_feederWake.notify_one();
+}
+
+void VoiceMixer::stopFeeder() {
+    if (!m_feederThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_feederMutex);
+        m_stopFeeder.store(true, std::memory_order_release);
+    }
+    m_feederWake.notify_one();
+    m_feederThread.join();
+}
+
+bool VoiceMixer::feedVoice(Voice& voice, std::vector<float>& decoded,
+                           std::vector<float>& mapped, std::vector<float>& resampled) {
+    if (voice.sourceEnded.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    int32_t inputFrames = std::min(FEED_CHUNK_FRAMES, voice.resampler.maxInputFrames(voice.ring.availableToWrite()));
+    if (inputFrames < FEED_MIN_FRAMES) {
+        return false;
+    }
+
+    const int srcChannels = voice.source->info().channelCount;
+    decoded.resize(std::max(decoded.size(), static_cast<size_t>(inputFrames) * srcChannels));
+    int32_t frames = voice.source->read(decoded.data(), inputFrames);
+    if (frames <= 0) {
+        if (frames < 0) {
+            LOGE("Voice decode error at frame %lld", static_cast<long long>(voice.source->positionFrames()));
+        }
+        voice.sourceEnded.store(true, std::memory_order_release);
+        return false;
+    }
+
+    const float* frameData = decoded.data();
+    if (srcChannels != m_channelCount) {
+        Downmixer downmix;
+        downmix.configure(DownmixMatrix::standard(srcChannels, m_channelCount));
+        downmix.process(decoded.data(), mapped.data(), frames);
+        frameData = mapped.data();
+    }
+
+    int32_t produced = voice.resampler.process(frameData, frames, resampled.data());
+    voice.ring.write(resampled.data(), produced);
+    return true;
+}
+
+void VoiceMixer::feederThreadFunction() {
+    FTL_TRACE_THREAD_NAME("voiceFeeder");
+    std::vector<float> decoded;
+    std::vector<float> mapped(static_cast<size_t>(FEED_CHUNK_FRAMES) * m_channelCount);
+    std::vector<float> resampled;
+
+    // Poll at half a chunk while voices play; sleep outright when none do
+    const auto refillInterval = std::chrono::microseconds(
+        static_cast<int64_t>(FEED_CHUNK_FRAMES) * 500000 / m_sampleRate);
+
+    while (!m_stopFeeder.load(std::memory_order_acquire)) {
+        bool busy = false;
+        bool progressed = false;
+
+        for (int slot = 0; slot < MAX_MIXER_VOICES; ++slot) {
+            Voice& voice = m_voices[slot];
+            int32_t state = voice.state.load(std::memory_order_acquire);
+            if (state == FINISHED) {
+                voice.source.reset();
+                voice.sourceEnded.store(false, std::memory_order_relaxed);
+                voice.state.store(FREE, std::memory_order_release);
+            } else if (state == PLAYING || state == STOPPING) {
+                busy = true;
+                size_t needed = static_cast<size_t>(voice.resampler.maxOutputFrames(FEED_CHUNK_FRAMES)) * m_channelCount;
+                if (resampled.size() < needed) {
+                    resampled.resize(needed);
+                }
+                progressed |= feedVoice(voice, decoded, mapped, resampled);
+            }
+        }
+        if (progressed) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_feederMutex);
+        auto woken = [this] { return m_feederKick || m_stopFeeder.load(std::memory_order_relaxed); };
+        if (busy) {
+            m_feederWake.wait_for(lock, refillInterval, woken);
+        } else {
+            m_feederWake.wait(lock, woken);
+        }
+        m_feederKick = false;
+    }
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,162 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               VOICE MIXER - MULTI-SOURCE PLAYBACK           ║
+ * ║      Crossfades, Previews and Prompts in One AAudio Stream  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A fixed set of voice slots mixed on top of the engine's main program.
+ * Each slot owns a decode ring, a gain ramp and a resampler, so sources
+ * at any rate share the single output stream.
+ *
+ * Slot lifecycle (one atomic state per slot, no locks anywhere):
+ *   FREE -> PREPARING   control thread claims the slot (CAS) and installs the source
+ *   PREPARING -> PLAYING   published to the feeder and the callback
+ *   PLAYING -> STOPPING    control thread requests a fade-out
+ *   PLAYING/STOPPING -> FINISHED   callback: faded to zero or source drained
+ *   FINISHED -> FREE       feeder thread releases the source
+ *
+ * The callback only ever reads rings and ramps of PLAYING/STOPPING slots
+ * and never frees anything.
+ */
+
+#ifndef FTL_VOICE_MIXER_H
+#define FTL_VOICE_MIXER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AudioSource.h"
+#include "BufferManager.h"
+#include "Resampler.h"
+
+namespace ftl_audio {
+
+constexpr int MAX_MIXER_VOICES = 16;
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// GAIN RAMP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Linear gain ramp set from any thread and advanced by the audio thread.
+ * A new target restarts the ramp from wherever the gain currently is.
+ */
+class GainRamp {
+public:
+    /** Jump to `gain` with no ramp. Only while the audio thread is not using it. */
+    void reset(float gain);
+
+    /** Control side: ramp to `gain` over `rampFrames` */
+    void setTarget(float gain, int32_t rampFrames);
+
+    /**
+     * Audio side: next span of at most `maxFrames` with a single slope
+     * @return Frames covered by `gain` + `step` per frame
+     */
+    int32_t nextSegment(int32_t maxFrames, float& gain, float& step);
+
+    /** Audio side: pick up a target set since the last call */
+    void refresh();
+
+    /** Audio side: current gain and whether a ramp is still running */
+    float current() const { return m_gain; }
+    bool isRamping() const { return m_remaining > 0; }
+    bool isUnity() const { return m_remaining == 0 && m_gain == 1.0f; }
+
+private:
+    std::atomic<float> m_target{1.0f};
+    std::atomic<int32_t> m_rampFrames{0};
+    std::atomic<uint32_t> m_serial{0};
+
+    // Audio thread only
+    uint32_t m_seenSerial = 0;
+    float m_gain = 1.0f;
+    float m_step = 0.0f;
+    float m_rampTarget = 1.0f;
+    int32_t m_remaining = 0;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// VOICE MIXER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+class VoiceMixer {
+public:
+    static constexpr int32_t INVALID_VOICE = -1;
+
+    VoiceMixer();
+    ~VoiceMixer();
+
+    /**
+     * Size rings and scratch for the output format and start the feeder.
+     * Releases any voices. Call only while the callback is not running.
+     */
+    void configure(int sampleRate, int channelCount, int32_t ringFrames);
+
+    /** Stop the feeder and release every voice (callback must not be running) */
+    void release();
+
+    // Control side - any thread
+    int32_t play(std::unique_ptr<AudioSource> source, float gain, int32_t fadeInFrames);
+    bool setGain(int32_t voiceId, float gain, int32_t rampFrames);
+    bool stop(int32_t voiceId, int32_t fadeOutFrames);
+    void stopAll(int32_t fadeOutFrames);
+    bool isActive(int32_t voiceId) const;
+    int activeVoiceCount() const;                    // Slots in use, including ones awaiting release
+    int32_t bufferedFrames(int32_t voiceId) const;   // Decoded, not yet mixed
+
+    /**
+     * Audio side: add every live voice into `output`
+     * @return Number of voices mixed
+     */
+    int render(float* output, int32_t numFrames);
+
+private:
+    enum SlotState : int32_t { FREE, PREPARING, PLAYING, STOPPING, FINISHED };
+
+    struct alignas(64) Voice {
+        std::atomic<int32_t> state{FREE};
+        std::atomic<uint32_t> generation{0};
+        std::atomic<bool> sourceEnded{false};
+        AudioRingBuffer ring;
+        GainRamp gain;
+
+        // Feeder thread only once PLAYING
+        std::unique_ptr<AudioSource> source;
+        StreamResampler resampler;
+    };
+
+    int m_sampleRate = 0;
+    int m_channelCount = 0;
+    std::unique_ptr<Voice[]> m_voices;
+    std::unique_ptr<float[]> m_scratch;                  // Audio thread: one ring read
+
+    // Feeder: decodes, converts and resamples into every live ring
+    std::thread m_feederThread;
+    std::atomic<bool> m_stopFeeder{false};
+    std::mutex m_feederMutex;
+    std::condition_variable m_feederWake;
+    bool m_feederKick = false;                           // Guarded by m_feederMutex
+
+    Voice* voiceFor(int32_t voiceId) const;
+    void feederThreadFunction();
+    bool feedVoice(Voice& voice, std::vector<float>& decoded,
+                   std::vector<float>& mapped, std::vector<float>& resampled);
+    void wakeFeeder();
+    void stopFeeder();
+
+    VoiceMixer(const VoiceMixer&) = delete;
+    VoiceMixer& operator=(const VoiceMixer&) = delete;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_VOICE_MIXER_H
@@ -0,0 +1,44 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              AUDIO SOURCE - DECODER INTERFACE               ║
+ * ║        Native File Sources Feeding the Decode Ring          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "AudioSource.h"
+#include "FlacSource.h"
+#include "WavSource.h"
+
+#include <android/log.h>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "FTL_AudioSource"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+std::unique_ptr<AudioSource> openAudioSource(const std::string& path, size_t readBufferBytes) {
+    uint8_t magic[12] = {};
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOGE("Cannot open audio source: %s", path.c_str());
+        return nullptr;
+    }
+    size_t got = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+
+    if (got >= 12 && std::memcmp(magic, "RIFF", 4) == 0 && std::memcmp(magic + 8, "WAVE", 4) == 0) {
+        auto source = std::make_unique<WavSource>(readBufferBytes);
+        if (source->open(path)) return source;
+    } else if (got >= 4 && (std::memcmp(magic, "fLaC", 4) == 0 || std::memcmp(magic, "ID3", 3) == 0)) {
+        auto source = std::make_unique<FlacSource>(readBufferBytes);
+        if (source->open(path)) return source;
+    } else {
+        LOGE("Unsupported audio format: %s", path.c_str());
+    }
+
+    return nullptr;
+}
+
+} // namespace ftl_audio
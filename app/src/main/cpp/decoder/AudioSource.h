@@ -0,0 +1,74 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              AUDIO SOURCE - DECODER INTERFACE               ║
+ * ║        Native File Sources Feeding the Decode Ring          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Sources decode to interleaved float at their native rate and channel
+ * count. They are driven from the engine's decode thread only and are
+ * not thread-safe.
+ */
+
+#ifndef FTL_AUDIO_SOURCE_H
+#define FTL_AUDIO_SOURCE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "FileReader.h"
+
+namespace ftl_audio {
+
+struct AudioSourceInfo {
+    std::string codec;           // "wav", "flac"
+    int sampleRate = 0;
+    int channelCount = 0;
+    int bitsPerSample = 0;
+    int64_t totalFrames = -1;    // -1 when the container does not say
+};
+
+class AudioSource {
+public:
+    virtual ~AudioSource() = default;
+
+    virtual const AudioSourceInfo& info() const = 0;
+
+    /**
+     * Decode up to `numFrames` interleaved frames into `out`.
+     * @return Frames written; 0 at end of stream, negative on decode error
+     */
+    virtual int32_t read(float* out, int32_t numFrames) = 0;
+
+    /**
+     * Position the next read() exactly at `frame` (sample-accurate).
+     * @return False if `frame` is out of range or the file is damaged
+     */
+    virtual bool seekToFrame(int64_t frame) = 0;
+
+    /** Frame index the next read() will return */
+    virtual int64_t positionFrames() const = 0;
+
+    /** I/O issued against the underlying file so far */
+    virtual const IoStats& ioStats() const = 0;
+
+    /**
+     * Attach a sidecar seek index (see SeekIndex.h) for O(1) seeks.
+     * @return False if the codec has no use for one or the sidecar is stale
+     */
+    virtual bool loadSeekIndex(const std::string& /* sidecarPath */) { return false; }
+};
+
+/**
+ * Open a file by sniffing its header (RIFF/WAVE or fLaC).
+ * @param readBufferBytes File read-ahead (larger = fewer, bigger reads)
+ * @return nullptr if the file is missing or the format is unsupported
+ */
+std::unique_ptr<AudioSource> openAudioSource(const std::string& path,
+                                             size_t readBufferBytes = FileReader::DEFAULT_BUFFER_SIZE);
+
+} // namespace ftl_audio
+
+#endif // FTL_AUDIO_SOURCE_H
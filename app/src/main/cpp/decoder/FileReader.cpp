@@ -0,0 +1,126 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 FILE READER - BUFFERED I/O                  ║
+ * ║           Seekable Byte Source for Native Decoders          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "FileReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ftl_audio {
+
+FileReader::FileReader(size_t bufferSize)
+    : m_buffer(std::make_unique<uint8_t[]>(bufferSize)),
+      m_bufferSize(bufferSize) {
+}
+
+FileReader::~FileReader() {
+    close();
+}
+
+bool FileReader::open(const std::string& path) {
+    close();
+
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(m_fd, &info) != 0) {
+        close();
+        return false;
+    }
+
+    m_fileSize = info.st_size;
+    m_bufferOffset = 0;
+    m_bufferPos = 0;
+    m_bufferFill = 0;
+    m_probing = false;
+    return true;
+}
+
+void FileReader::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_fileSize = 0;
+}
+
+bool FileReader::seek(int64_t offset) {
+    if (offset < 0 || offset > m_fileSize) {
+        return false;
+    }
+
+    // Inside the current window: just move the cursor
+    if (offset >= m_bufferOffset && offset <= m_bufferOffset + static_cast<int64_t>(m_bufferFill)) {
+        m_bufferPos = static_cast<size_t>(offset - m_bufferOffset);
+        return true;
+    }
+
+    m_stats.seekRequests++;
+    m_bufferOffset = offset;
+    m_bufferPos = 0;
+    m_bufferFill = 0;
+    m_probing = true;
+    return true;
+}
+
+bool FileReader::refill() {
+    if (m_fd < 0) {
+        return false;
+    }
+
+    m_bufferOffset += static_cast<int64_t>(m_bufferFill);
+    m_bufferPos = 0;
+    m_bufferFill = 0;
+
+    if (m_bufferOffset >= m_fileSize) {
+        return false;
+    }
+
+    // Sequential reads after the probe get the whole buffer again
+    size_t want = m_probing ? std::min(m_bufferSize, PROBE_SIZE) : m_bufferSize;
+    m_probing = false;
+
+    ssize_t result;
+    do {
+        result = ::pread(m_fd, m_buffer.get(), want, m_bufferOffset);
+    } while (result < 0 && errno == EINTR);
+
+    m_stats.readRequests++;
+    if (result <= 0) {
+        return false;
+    }
+
+    m_stats.bytesRead += static_cast<uint64_t>(result);
+    m_bufferFill = static_cast<size_t>(result);
+    return true;
+}
+
+size_t FileReader::read(void* dst, size_t count) {
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t copied = 0;
+
+    while (copied < count) {
+        if (m_bufferPos == m_bufferFill && !refill()) {
+            break;
+        }
+        size_t chunk = std::min(count - copied, m_bufferFill - m_bufferPos);
+        std::memcpy(out + copied, m_buffer.get() + m_bufferPos, chunk);
+        m_bufferPos += chunk;
+        copied += chunk;
+    }
+
+    return copied;
+}
+
+} // namespace ftl_audio
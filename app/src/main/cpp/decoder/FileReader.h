@@ -0,0 +1,89 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 FILE READER - BUFFERED I/O                  ║
+ * ║           Seekable Byte Source for Native Decoders          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Thin POSIX wrapper with a read-ahead buffer. Seeks that land inside the
+ * current buffer cost no I/O. Counts every byte and request that reaches
+ * the OS so decoders can report their real I/O footprint.
+ *
+ * A large buffer turns playback into a few big burst reads (burst
+ * prefetch); the first refill after a seek stays probe-sized so a FLAC
+ * bisection does not pull a whole burst per step.
+ */
+
+#ifndef FTL_FILE_READER_H
+#define FTL_FILE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ftl_audio {
+
+struct IoStats {
+    uint64_t bytesRead = 0;      // Bytes returned by read(2)
+    uint64_t readRequests = 0;   // read(2) calls
+    uint64_t seekRequests = 0;   // Seeks that invalidated the buffer
+};
+
+class FileReader {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t PROBE_SIZE = DEFAULT_BUFFER_SIZE;   // First refill after a seek
+
+    explicit FileReader(size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~FileReader();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+
+    int64_t size() const { return m_fileSize; }
+    int64_t tell() const { return m_bufferOffset + static_cast<int64_t>(m_bufferPos); }
+    bool seek(int64_t offset);
+
+    /** Read up to `count` bytes, returns bytes copied (short only at EOF) */
+    size_t read(void* dst, size_t count);
+
+    /** Skip forward `count` bytes */
+    bool skip(int64_t count) { return seek(tell() + count); }
+
+    /** Single-byte fast path for bit readers */
+    inline bool readByte(uint8_t& value) {
+        if (m_bufferPos == m_bufferFill && !refill()) {
+            return false;
+        }
+        value = m_buffer[m_bufferPos++];
+        return true;
+    }
+
+    const IoStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = IoStats(); }
+
+private:
+    bool refill();
+
+    int m_fd = -1;
+    int64_t m_fileSize = 0;
+
+    std::unique_ptr<uint8_t[]> m_buffer;
+    size_t m_bufferSize;
+    size_t m_bufferPos = 0;
+    size_t m_bufferFill = 0;
+    int64_t m_bufferOffset = 0;   // File offset of m_buffer[0]
+    bool m_probing = false;       // Buffer invalidated by a seek: refill probe-sized
+
+    IoStats m_stats;
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_FILE_READER_H
@@ -0,0 +1,824 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                FLAC SOURCE - LOSSLESS DECODER               ║
+ * ║       Bit-Exact FLAC Decode with Seektable/Frame Index      ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "FlacSource.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <cstring>
+
+#define LOG_TAG "FTL_FlacSource"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr int METADATA_STREAMINFO = 0;
+constexpr int METADATA_SEEKTABLE = 3;
+constexpr uint64_t SEEKPOINT_PLACEHOLDER = 0xFFFFFFFFFFFFFFFFull;
+
+constexpr int CHANNEL_LEFT_SIDE = 8;
+constexpr int CHANNEL_RIGHT_SIDE = 9;
+constexpr int CHANNEL_MID_SIDE = 10;
+
+constexpr int MAX_LPC_ORDER = 32;
+constexpr int MAX_BISECTION_STEPS = 32;
+
+uint8_t crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t readBE24(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+}
+
+uint64_t readBE64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+// CRC-16 (poly 0x8005) used by the frame footer
+struct Crc16Table {
+    uint16_t values[256];
+    Crc16Table() {
+        for (int i = 0; i < 256; ++i) {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+            }
+            values[i] = crc;
+        }
+    }
+};
+
+const Crc16Table& crc16Table() {
+    static const Crc16Table table;
+    return table;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BIT READER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool FlacSource::fillBits(int count) {
+    while (m_bitCount < count) {
+        uint8_t byte;
+        if (!m_reader.readByte(byte)) {
+            m_ioError = true;
+            return false;
+        }
+        m_bitCache = (m_bitCache << 8) | byte;
+        m_bitCount += 8;
+    }
+    return true;
+}
+
+uint32_t FlacSource::readBits(int count) {
+    if (count == 0 || !fillBits(count)) {
+        return 0;
+    }
+    m_bitCount -= count;
+    return static_cast<uint32_t>((m_bitCache >> m_bitCount) & ((1ull << count) - 1));
+}
+
+int32_t FlacSource::readSigned(int count) {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t raw = readBits(count);
+    // Sign-extend from `count` bits
+    uint32_t signBit = 1u << (count - 1);
+    return static_cast<int32_t>((raw ^ signBit) - signBit);
+}
+
+uint32_t FlacSource::readUnary() {
+    uint32_t zeros = 0;
+    while (true) {
+        if (m_bitCount == 0 && !fillBits(8)) {
+            return zeros;
+        }
+        uint64_t bits = m_bitCache & ((1ull << m_bitCount) - 1);
+        if (bits == 0) {
+            zeros += m_bitCount;
+            m_bitCount = 0;
+            continue;
+        }
+        int highest = 63 - __builtin_clzll(bits);
+        zeros += m_bitCount - 1 - highest;
+        m_bitCount = highest;
+        return zeros;
+    }
+}
+
+int64_t FlacSource::bitPosition() const {
+    return m_reader.tell() * 8 - m_bitCount;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// STREAM SETUP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool FlacSource::open(const std::string& path) {
+    if (!m_reader.open(path)) {
+        LOGE("Cannot open %s", path.c_str());
+        return false;
+    }
+    m_path = path;
+    return parseMetadata();
+}
+
+bool FlacSource::parseMetadata() {
+    uint8_t marker[10];
+    if (m_reader.read(marker, 4) != 4) {
+        return false;
+    }
+
+    // Tolerate an ID3v2 tag in front of the stream marker
+    if (std::memcmp(marker, "ID3", 3) == 0) {
+        if (m_reader.read(marker + 4, 6) != 6) {
+            return false;
+        }
+        int64_t tagSize = (static_cast<int64_t>(marker[6] & 0x7F) << 21) | ((marker[7] & 0x7F) << 14) |
+                          ((marker[8] & 0x7F) << 7) | (marker[9] & 0x7F);
+        if (!m_reader.seek(10 + tagSize) || m_reader.read(marker, 4) != 4) {
+            return false;
+        }
+    }
+
+    if (std::memcmp(marker, "fLaC", 4) != 0) {
+        LOGE("Missing fLaC stream marker");
+        return false;
+    }
+
+    bool haveStreamInfo = false;
+    bool lastBlock = false;
+    std::vector<FlacSeekPoint> seekTable;
+
+    while (!lastBlock) {
+        uint8_t blockHeader[4];
+        if (m_reader.read(blockHeader, 4) != 4) {
+            LOGE("Truncated metadata");
+            return false;
+        }
+        lastBlock = (blockHeader[0] & 0x80) != 0;
+        int type = blockHeader[0] & 0x7F;
+        uint32_t length = readBE24(blockHeader + 1);
+        int64_t blockStart = m_reader.tell();
+
+        if (type == METADATA_STREAMINFO && length >= 34) {
+            uint8_t info[34];
+            if (m_reader.read(info, sizeof(info)) != sizeof(info)) {
+                return false;
+            }
+            m_minBlockSize = (info[0] << 8) | info[1];
+            m_maxBlockSize = (info[2] << 8) | info[3];
+            m_info.sampleRate = static_cast<int>((static_cast<uint32_t>(info[10]) << 12) |
+                                                 (info[11] << 4) | (info[12] >> 4));
+            m_info.channelCount = ((info[12] >> 1) & 0x07) + 1;
+            m_info.bitsPerSample = (((info[12] & 0x01) << 4) | (info[13] >> 4)) + 1;
+            int64_t totalSamples = (static_cast<int64_t>(info[13] & 0x0F) << 32) |
+                                   (static_cast<int64_t>(info[14]) << 24) | (info[15] << 16) |
+                                   (info[16] << 8) | info[17];
+            m_info.totalFrames = totalSamples > 0 ? totalSamples : -1;
+            haveStreamInfo = true;
+        } else if (type == METADATA_SEEKTABLE) {
+            uint8_t point[18];
+            for (uint32_t i = 0; i < length / 18; ++i) {
+                if (m_reader.read(point, sizeof(point)) != sizeof(point)) {
+                    return false;
+                }
+                uint64_t sample = readBE64(point);
+                if (sample != SEEKPOINT_PLACEHOLDER) {
+                    seekTable.push_back({static_cast<int64_t>(sample), static_cast<int64_t>(readBE64(point + 8))});
+                }
+            }
+        }
+
+        if (!m_reader.seek(blockStart + length)) {
+            LOGE("Metadata block runs past end of file");
+            return false;
+        }
+    }
+
+    if (!haveStreamInfo || m_info.sampleRate <= 0 || m_maxBlockSize < 16 ||
+        m_info.bitsPerSample < 4 || m_info.bitsPerSample > 32) {
+        LOGE("Invalid or missing STREAMINFO");
+        return false;
+    }
+
+    m_info.codec = "flac";
+    m_firstFrameOffset = m_reader.tell();
+    m_indexSpacing = static_cast<int64_t>(m_maxBlockSize) * 8;
+
+    // Seektable offsets are relative to the first frame header
+    for (const auto& point : seekTable) {
+        recordFramePosition(point.sample, m_firstFrameOffset + point.offset);
+    }
+
+    m_channelData.assign(static_cast<size_t>(m_info.channelCount) * m_maxBlockSize, 0);
+    m_frameFloat.assign(static_cast<size_t>(m_info.channelCount) * m_maxBlockSize, 0.0f);
+    resetBits();
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FRAME HEADER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool FlacSource::readFrameHeader(FrameHeader& header) {
+    static const int sampleRates[] = {0, 88200, 176400, 192000, 8000, 16000, 22050,
+                                      24000, 32000, 44100, 48000, 96000};
+    static const int sampleSizes[] = {0, 8, 12, 0, 16, 20, 24, 32};
+
+    uint8_t raw[16];
+    int length = 0;
+    auto next = [&]() {
+        uint8_t byte = static_cast<uint8_t>(readBits(8));
+        raw[length++] = byte;
+        return byte;
+    };
+
+    uint8_t b0 = next();
+    uint8_t b1 = next();
+    if (m_ioError || b0 != 0xFF || (b1 & 0xFE) != 0xF8) {
+        return false;
+    }
+    bool variableBlockSize = (b1 & 0x01) != 0;
+
+    uint8_t b2 = next();
+    uint8_t b3 = next();
+    int blockSizeCode = b2 >> 4;
+    int sampleRateCode = b2 & 0x0F;
+    header.channelAssignment = b3 >> 4;
+    int sampleSizeCode = (b3 >> 1) & 0x07;
+
+    if (blockSizeCode == 0 || sampleRateCode == 15 || sampleSizeCode == 3 ||
+        header.channelAssignment > CHANNEL_MID_SIDE || (b3 & 0x01) != 0) {
+        return false;
+    }
+
+    // UTF-8 style coded frame/sample number
+    uint8_t lead = next();
+    uint64_t number;
+    int extraBytes;
+    if ((lead & 0x80) == 0) { number = lead; extraBytes = 0; }
+    else if ((lead & 0xE0) == 0xC0) { number = lead & 0x1F; extraBytes = 1; }
+    else if ((lead & 0xF0) == 0xE0) { number = lead & 0x0F; extraBytes = 2; }
+    else if ((lead & 0xF8) == 0xF0) { number = lead & 0x07; extraBytes = 3; }
+    else if ((lead & 0xFC) == 0xF8) { number = lead & 0x03; extraBytes = 4; }
+    else if ((lead & 0xFE) == 0xFC) { number = lead & 0x01; extraBytes = 5; }
+    else if (lead == 0xFE) { number = 0; extraBytes = 6; }
+    else { return false; }
+
+    for (int i = 0; i < extraBytes; ++i) {
+        uint8_t byte = next();
+        if ((byte & 0xC0) != 0x80) {
+            return false;
+        }
+        number = (number << 6) | (byte & 0x3F);
+    }
+
+    if (blockSizeCode == 1) header.blockSize = 192;
+    else if (blockSizeCode <= 5) header.blockSize = 576 << (blockSizeCode - 2);
+    else if (blockSizeCode == 6) header.blockSize = next() + 1;
+    else if (blockSizeCode == 7) { int hi = next(); header.blockSize = ((hi << 8) | next()) + 1; }
+    else header.blockSize = 256 << (blockSizeCode - 8);
+
+    int sampleRate = m_info.sampleRate;
+    if (sampleRateCode >= 1 && sampleRateCode <= 11) sampleRate = sampleRates[sampleRateCode];
+    else if (sampleRateCode == 12) sampleRate = next() * 1000;
+    else if (sampleRateCode == 13) { int hi = next(); sampleRate = (hi << 8) | next(); }
+    else if (sampleRateCode == 14) { int hi = next(); sampleRate = ((hi << 8) | next()) * 10; }
+
+    uint8_t expectedCrc = crc8(raw, length);
+    uint8_t crc = static_cast<uint8_t>(readBits(8));
+    if (m_ioError || crc != expectedCrc) {
+        return false;
+    }
+
+    header.bitsPerSample = sampleSizeCode == 0 ? m_info.bitsPerSample : sampleSizes[sampleSizeCode];
+    int channels = header.channelAssignment >= CHANNEL_LEFT_SIDE ? 2 : header.channelAssignment + 1;
+
+    // Streams never change shape mid-file; reject CRC-valid false syncs that do
+    if (sampleRate != m_info.sampleRate || channels != m_info.channelCount ||
+        header.bitsPerSample != m_info.bitsPerSample || header.blockSize > m_maxBlockSize) {
+        return false;
+    }
+
+    header.firstSample = variableBlockSize
+        ? static_cast<int64_t>(number)
+        : static_cast<int64_t>(number) * m_maxBlockSize;
+    return true;
+}
+
+bool FlacSource::syncToNextFrame(FrameHeader& header, int64_t& frameOffset, int64_t scanLimit) {
+    int64_t position = (bitPosition() + 7) / 8;
+
+    while (position < scanLimit) {
+        if (!m_reader.seek(position)) {
+            return false;
+        }
+        resetBits();
+        m_ioError = false;
+
+        uint8_t byte;
+        bool found = false;
+        while (m_reader.readByte(byte)) {
+            if (byte == 0xFF) {
+                uint8_t second;
+                if (!m_reader.readByte(second)) {
+                    break;
+                }
+                if ((second & 0xFE) == 0xF8) {
+                    position = m_reader.tell() - 2;
+                    found = true;
+                    break;
+                }
+                if (second == 0xFF) {
+                    // Could be the first byte of the real sync
+                    m_reader.seek(m_reader.tell() - 1);
+                }
+            }
+            if (m_reader.tell() >= scanLimit) {
+                break;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        m_reader.seek(position);
+        resetBits();
+        if (readFrameHeader(header)) {
+            frameOffset = position;
+            return true;
+        }
+        position += 1;
+    }
+    return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FRAME DECODING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool FlacSource::decodeFrame() {
+    alignToByte();
+    int64_t frameOffset = bitPosition() / 8;
+    m_ioError = false;
+
+    FrameHeader header;
+    if (!readFrameHeader(header)) {
+        if (frameOffset >= m_reader.size()) {
+            return false; // Clean end of stream
+        }
+        // Lost sync (damaged data): resynchronize on the next valid header
+        m_reader.seek(frameOffset + 1);
+        resetBits();
+        if (!syncToNextFrame(header, frameOffset, m_reader.size())) {
+            return false;
+        }
+        LOGD("Resynchronized at byte %lld", static_cast<long long>(frameOffset));
+    }
+
+    int channels = m_info.channelCount;
+    for (int ch = 0; ch < channels; ++ch) {
+        int bits = header.bitsPerSample;
+        // The side channel carries one extra bit
+        if ((header.channelAssignment == CHANNEL_LEFT_SIDE && ch == 1) ||
+            (header.channelAssignment == CHANNEL_RIGHT_SIDE && ch == 0) ||
+            (header.channelAssignment == CHANNEL_MID_SIDE && ch == 1)) {
+            bits += 1;
+        }
+        if (bits > 32 || !decodeSubframe(ch, bits, header.blockSize)) {
+            LOGE("Subframe decode failed at byte %lld", static_cast<long long>(frameOffset));
+            return false;
+        }
+    }
+
+    // Footer CRC-16 (frame integrity is already guarded by header CRC and sync checks)
+    alignToByte();
+    readBits(16);
+    if (m_ioError) {
+        return false;
+    }
+
+    int n = header.blockSize;
+    int32_t* a = m_channelData.data();
+    int32_t* b = a + m_maxBlockSize;
+    switch (header.channelAssignment) {
+        case CHANNEL_LEFT_SIDE:
+            for (int i = 0; i < n; ++i) b[i] = a[i] - b[i];
+            break;
+        case CHANNEL_RIGHT_SIDE:
+            for (int i = 0; i < n; ++i) a[i] += b[i];
+            break;
+        case CHANNEL_MID_SIDE:
+            for (int i = 0; i < n; ++i) {
+                int32_t side = b[i];
+                int32_t mid = static_cast<int32_t>((static_cast<uint32_t>(a[i]) << 1) | (side & 1));
+                a[i] = (mid + side) >> 1;
+                b[i] = (mid - side) >> 1;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Interleave into float
+    const float scale = 1.0f / static_cast<float>(1ull << (header.bitsPerSample - 1));
+    for (int ch = 0; ch < channels; ++ch) {
+        const int32_t* src = m_channelData.data() + static_cast<size_t>(ch) * m_maxBlockSize;
+        float* dst = m_frameFloat.data() + ch;
+        for (int i = 0; i < n; ++i) {
+            dst[static_cast<size_t>(i) * channels] = src[i] * scale;
+        }
+    }
+
+    m_frame = header;
+    m_frameFill = n;
+    m_frameCursor = 0;
+    recordFramePosition(header.firstSample, frameOffset);
+    return true;
+}
+
+bool FlacSource::decodeSubframe(int channel, int bitsPerSample, int blockSize) {
+    int32_t* out = m_channelData.data() + static_cast<size_t>(channel) * m_maxBlockSize;
+
+    if (readBits(1) != 0) {
+        return false; // Zero padding bit
+    }
+    uint32_t type = readBits(6);
+
+    int wasted = 0;
+    if (readBits(1)) {
+        wasted = static_cast<int>(readUnary()) + 1;
+        bitsPerSample -= wasted;
+    }
+    if (bitsPerSample <= 0) {
+        return false;
+    }
+
+    if (type == 0) {
+        int32_t value = readSigned(bitsPerSample);
+        std::fill(out, out + blockSize, value);
+    } else if (type == 1) {
+        for (int i = 0; i < blockSize; ++i) {
+            out[i] = readSigned(bitsPerSample);
+        }
+    } else if (type >= 8 && type <= 12) {
+        int order = static_cast<int>(type - 8);
+        if (order > blockSize) return false;
+        for (int i = 0; i < order; ++i) {
+            out[i] = readSigned(bitsPerSample);
+        }
+        if (!decodeResidual(out, blockSize, order)) return false;
+
+        // Fixed polynomial predictors, accumulated in 64 bits for 24/32-bit streams
+        switch (order) {
+            case 0:
+                break;
+            case 1:
+                for (int i = 1; i < blockSize; ++i) out[i] += out[i - 1];
+                break;
+            case 2:
+                for (int i = 2; i < blockSize; ++i)
+                    out[i] += static_cast<int32_t>(2LL * out[i - 1] - out[i - 2]);
+                break;
+            case 3:
+                for (int i = 3; i < blockSize; ++i)
+                    out[i] += static_cast<int32_t>(3LL * out[i - 1] - 3LL * out[i - 2] + out[i - 3]);
+                break;
+            case 4:
+                for (int i = 4; i < blockSize; ++i)
+                    out[i] += static_cast<int32_t>(4LL * out[i - 1] - 6LL * out[i - 2] +
+                                                   4LL * out[i - 3] - out[i - 4]);
+                break;
+        }
+    } else if (type >= 32) {
+        int order = static_cast<int>(type - 31);
+        if (order > blockSize || order > MAX_LPC_ORDER) return false;
+        for (int i = 0; i < order; ++i) {
+            out[i] = readSigned(bitsPerSample);
+        }
+
+        int precision = static_cast<int>(readBits(4)) + 1;
+        if (precision == 16) return false;
+        int shift = readSigned(5);
+        if (shift < 0) return false;
+
+        int32_t coefs[MAX_LPC_ORDER];
+        for (int i = 0; i < order; ++i) {
+            coefs[i] = readSigned(precision);
+        }
+        if (!decodeResidual(out, blockSize, order)) return false;
+
+        for (int i = order; i < blockSize; ++i) {
+            int64_t sum = 0;
+            for (int j = 0; j < order; ++j) {
+                sum += static_cast<int64_t>(coefs[j]) * out[i - 1 - j];
+            }
+            out[i] += static_cast<int32_t>(sum >> shift);
+        }
+    } else {
+        return false; // Reserved subframe type
+    }
+
+    if (wasted > 0) {
+        for (int i = 0; i < blockSize; ++i) {
+            out[i] = static_cast<int32_t>(static_cast<uint32_t>(out[i]) << wasted);
+        }
+    }
+    return !m_ioError;
+}
+
+bool FlacSource::decodeResidual(int32_t* samples, int blockSize, int predictorOrder) {
+    uint32_t method = readBits(2);
+    if (method > 1) return false;
+
+    int paramBits = method == 0 ? 4 : 5;
+    uint32_t escapeCode = method == 0 ? 15u : 31u;
+    int partitionOrder = static_cast<int>(readBits(4));
+    int partitions = 1 << partitionOrder;
+    int partitionSize = blockSize >> partitionOrder;
+    if ((partitionSize << partitionOrder) != blockSize || partitionSize < predictorOrder) {
+        return false;
+    }
+
+    int index = predictorOrder;
+    for (int p = 0; p < partitions; ++p) {
+        int count = p == 0 ? partitionSize - predictorOrder : partitionSize;
+        uint32_t parameter = readBits(paramBits);
+
+        if (parameter == escapeCode) {
+            int rawBits = static_cast<int>(readBits(5));
+            for (int i = 0; i < count; ++i) {
+                samples[index++] = readSigned(rawBits);
+            }
+            continue;
+        }
+
+        int k = static_cast<int>(parameter);
+        for (int i = 0; i < count; ++i) {
+            uint32_t quotient = readUnary();
+            uint32_t value = (quotient << k) | readBits(k);
+            // Zig-zag back to signed
+            samples[index++] = static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+        }
+        if (m_ioError) return false;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// READ
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int32_t FlacSource::read(float* out, int32_t numFrames) {
+    FTL_TRACE_SCOPE("flac.read");
+    int channels = m_info.channelCount;
+    int32_t written = 0;
+
+    while (written < numFrames) {
+        if (m_frameCursor >= m_frameFill) {
+            if (m_info.totalFrames >= 0 && m_position >= m_info.totalFrames) {
+                break;
+            }
+            if (!decodeFrame()) {
+                break;
+            }
+        }
+
+        int32_t count = std::min(numFrames - written, m_frameFill - m_frameCursor);
+        std::memcpy(out + static_cast<size_t>(written) * channels,
+                    m_frameFloat.data() + static_cast<size_t>(m_frameCursor) * channels,
+                    static_cast<size_t>(count) * channels * sizeof(float));
+        m_frameCursor += count;
+        m_position += count;
+        written += count;
+    }
+
+    return written;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SEEKING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void FlacSource::recordFramePosition(int64_t sample, int64_t offset) {
+    if (m_frameIndex.empty() || sample >= m_frameIndex.back().sample + m_indexSpacing) {
+        m_frameIndex.push_back({sample, offset});
+        return;
+    }
+
+    // Out-of-order discovery (seektable or bisection): keep sorted, skip near-duplicates
+    auto it = std::lower_bound(m_frameIndex.begin(), m_frameIndex.end(), sample,
+                               [](const FlacSeekPoint& p, int64_t s) { return p.sample < s; });
+    if (it != m_frameIndex.end() && it->sample - sample < m_indexSpacing) return;
+    if (it != m_frameIndex.begin() && sample - (it - 1)->sample < m_indexSpacing) return;
+    m_frameIndex.insert(it, {sample, offset});
+}
+
+FlacSeekPoint FlacSource::findSeekPoint(int64_t targetSample) const {
+    auto it = std::upper_bound(m_frameIndex.begin(), m_frameIndex.end(), targetSample,
+                               [](int64_t s, const FlacSeekPoint& p) { return s < p.sample; });
+    if (it == m_frameIndex.begin()) {
+        return {0, m_firstFrameOffset};
+    }
+    return *(it - 1);
+}
+
+bool FlacSource::bisectToward(int64_t targetSample, FlacSeekPoint& lower) {
+    FlacSeekPoint upper{m_info.totalFrames, m_reader.size()};
+    auto above = std::upper_bound(m_frameIndex.begin(), m_frameIndex.end(), targetSample,
+                                  [](int64_t s, const FlacSeekPoint& p) { return s < p.sample; });
+    if (above != m_frameIndex.end()) {
+        upper = *above;
+    }
+    if (upper.sample <= lower.sample) {
+        return false;
+    }
+
+    const int64_t closeEnough = static_cast<int64_t>(m_maxBlockSize) * 2;
+    for (int step = 0; step < MAX_BISECTION_STEPS && targetSample - lower.sample > closeEnough; ++step) {
+        if (upper.offset - lower.offset < 2) {
+            break;
+        }
+
+        // Interpolate on bitrate; aim slightly early so we land before the target
+        double fraction = static_cast<double>(targetSample - closeEnough / 2 - lower.sample) /
+                          static_cast<double>(upper.sample - lower.sample);
+        fraction = std::max(0.0, std::min(1.0, fraction));
+        int64_t guess = lower.offset + 1 +
+                        static_cast<int64_t>(fraction * static_cast<double>(upper.offset - lower.offset - 1));
+        guess = std::min(guess, upper.offset - 1);
+
+        m_reader.seek(guess);
+        resetBits();
+        FrameHeader header;
+        int64_t frameOffset = 0;
+        if (!syncToNextFrame(header, frameOffset, upper.offset)) {
+            // No frame between guess and upper bound
+            upper.offset = guess;
+            continue;
+        }
+
+        recordFramePosition(header.firstSample, frameOffset);
+        if (header.firstSample <= targetSample) {
+            lower = {header.firstSample, frameOffset};
+        } else {
+            upper = {header.firstSample, guess};
+        }
+    }
+    return true;
+}
+
+bool FlacSource::seekToFrame(int64_t frame) {
+    FTL_TRACE_SCOPE("flac.seek");
+    if (frame < 0 || (m_info.totalFrames >= 0 && frame > m_info.totalFrames)) {
+        return false;
+    }
+
+    if (m_info.totalFrames >= 0 && frame == m_info.totalFrames) {
+        m_reader.seek(m_reader.size());
+        resetBits();
+        m_frameFill = 0;
+        m_frameCursor = 0;
+        m_position = frame;
+        return true;
+    }
+
+    // Inside the frame we already decoded
+    if (m_frameFill > 0 && frame >= m_frame.firstSample && frame < m_frame.firstSample + m_frameFill) {
+        m_frameCursor = static_cast<int>(frame - m_frame.firstSample);
+        m_position = frame;
+        return true;
+    }
+
+    FlacSeekPoint start;
+    if (!m_seekIndex.lookup(frame, start.sample, start.offset)) {
+        start = findSeekPoint(frame);
+        if (frame - start.sample > static_cast<int64_t>(m_maxBlockSize) * 2 && m_info.totalFrames > 0) {
+            bisectToward(frame, start);
+        }
+    }
+
+    m_reader.seek(start.offset);
+    resetBits();
+    m_frameFill = 0;
+    m_frameCursor = 0;
+
+    // Decode forward to the frame that contains the target sample
+    while (decodeFrame()) {
+        if (frame < m_frame.firstSample + m_frameFill) {
+            if (frame < m_frame.firstSample) {
+                return false; // Index pointed past the target - damaged file
+            }
+            m_frameCursor = static_cast<int>(frame - m_frame.firstSample);
+            m_position = frame;
+            return true;
+        }
+    }
+
+    LOGE("Seek to %lld failed", static_cast<long long>(frame));
+    return false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SIDECAR SEEK INDEX
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool FlacSource::loadSeekIndex(const std::string& sidecarPath) {
+    SourceStamp stamp;
+    if (!SourceStamp::of(m_path, stamp) || !m_seekIndex.map(sidecarPath, stamp)) {
+        return false;
+    }
+    if (m_seekIndex.header().spacingFrames != static_cast<uint32_t>(m_maxBlockSize) ||
+        m_seekIndex.header().totalFrames < m_info.totalFrames) {
+        m_seekIndex.unmap();
+        return false;
+    }
+    return true;
+}
+
+bool FlacSource::scanFrames(std::vector<FlacSeekPoint>& frames, const std::atomic<bool>* cancel) {
+    const uint16_t* table = crc16Table().values;
+
+    int64_t frameOffset = m_firstFrameOffset;
+    FrameHeader header;
+    m_reader.seek(frameOffset);
+    resetBits();
+    if (!readFrameHeader(header)) {
+        return false;
+    }
+
+    while (true) {
+        frames.push_back({header.firstSample, frameOffset});
+        int64_t nextSample = header.firstSample + header.blockSize;
+        if (m_info.totalFrames >= 0 && nextSample >= m_info.totalFrames) {
+            return true;
+        }
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        // A frame ends where the CRC-16 over its bytes (footer included) is zero
+        // and a header for the next sample number follows
+        m_reader.seek(frameOffset);
+        uint16_t crc = 0;
+        uint16_t crcBeforePrevious = 0;
+        int previous = -1;
+        int64_t position = frameOffset;
+        bool found = false;
+        uint8_t byte;
+
+        while (m_reader.readByte(byte)) {
+            if (previous == 0xFF && (byte & 0xFE) == 0xF8 && crcBeforePrevious == 0 &&
+                position - 1 > frameOffset) {
+                int64_t candidate = position - 1;
+                int64_t resume = m_reader.tell();
+                FrameHeader next;
+                m_reader.seek(candidate);
+                resetBits();
+                if (readFrameHeader(next) && next.firstSample == nextSample) {
+                    frameOffset = candidate;
+                    header = next;
+                    found = true;
+                    break;
+                }
+                m_reader.seek(resume);
+            }
+            crcBeforePrevious = crc;
+            crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ byte]);
+            previous = byte;
+            ++position;
+        }
+
+        if (!found) {
+            // Last frame of a stream whose length STREAMINFO left open, or a truncated file
+            return m_info.totalFrames < 0;
+        }
+    }
+}
+
+} // namespace ftl_audio
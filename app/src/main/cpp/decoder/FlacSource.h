@@ -0,0 +1,116 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                FLAC SOURCE - LOSSLESS DECODER               ║
+ * ║       Bit-Exact FLAC Decode with Seektable/Frame Index      ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Seeking uses, in order of preference:
+ * 1. A mapped sidecar seek index (O(1), see SeekIndex.h)
+ * 2. SEEKTABLE points and frames already visited (the frame index)
+ * 3. Interpolated bisection over the file, validating frame headers
+ * then decodes forward to the exact sample.
+ */
+
+#ifndef FTL_FLAC_SOURCE_H
+#define FTL_FLAC_SOURCE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "AudioSource.h"
+#include "SeekIndex.h"
+
+namespace ftl_audio {
+
+/**
+ * Known frame start: first sample and byte offset of its sync code
+ */
+struct FlacSeekPoint {
+    int64_t sample = 0;
+    int64_t offset = 0;
+};
+
+class FlacSource : public AudioSource {
+public:
+    explicit FlacSource(size_t readBufferBytes = FileReader::DEFAULT_BUFFER_SIZE) : m_reader(readBufferBytes) {}
+
+    bool open(const std::string& path);
+
+    const AudioSourceInfo& info() const override { return m_info; }
+    int32_t read(float* out, int32_t numFrames) override;
+    bool seekToFrame(int64_t frame) override;
+    int64_t positionFrames() const override { return m_position; }
+    const IoStats& ioStats() const override { return m_reader.stats(); }
+    bool loadSeekIndex(const std::string& sidecarPath) override;
+
+    /**
+     * Walk every frame boundary without decoding audio (sync code + header
+     * CRC-8 + running frame CRC-16 + sample continuity). Leaves the read
+     * position undefined - reopen or seek before decoding.
+     */
+    bool scanFrames(std::vector<FlacSeekPoint>& frames, const std::atomic<bool>* cancel = nullptr);
+
+    /** Sorted frame index (seektable + frames discovered while decoding/seeking) */
+    const std::vector<FlacSeekPoint>& frameIndex() const { return m_frameIndex; }
+    int64_t firstFrameOffset() const { return m_firstFrameOffset; }
+    int maxBlockSize() const { return m_maxBlockSize; }
+
+private:
+    struct FrameHeader {
+        int64_t firstSample = 0;
+        int blockSize = 0;
+        int channelAssignment = 0;
+        int bitsPerSample = 0;
+    };
+
+    // Bit-level access over the buffered file reader
+    bool fillBits(int count);
+    uint32_t readBits(int count);
+    int32_t readSigned(int count);
+    uint32_t readUnary();
+    void alignToByte() { m_bitCount -= m_bitCount & 7; }
+    int64_t bitPosition() const;
+    void resetBits() { m_bitCache = 0; m_bitCount = 0; }
+
+    bool parseMetadata();
+    bool readFrameHeader(FrameHeader& header);
+    bool syncToNextFrame(FrameHeader& header, int64_t& frameOffset, int64_t scanLimit);
+    bool decodeFrame();
+    bool decodeSubframe(int channel, int bitsPerSample, int blockSize);
+    bool decodeResidual(int32_t* residual, int blockSize, int predictorOrder);
+
+    void recordFramePosition(int64_t sample, int64_t offset);
+    FlacSeekPoint findSeekPoint(int64_t targetSample) const;
+    bool bisectToward(int64_t targetSample, FlacSeekPoint& lower);
+
+    FileReader m_reader;
+    AudioSourceInfo m_info;
+    std::string m_path;
+    SeekIndex m_seekIndex;
+
+    int m_minBlockSize = 0;
+    int m_maxBlockSize = 0;
+    int64_t m_firstFrameOffset = 0;
+    std::vector<FlacSeekPoint> m_frameIndex;
+    int64_t m_indexSpacing = 0;        // Minimum samples between learned index points
+
+    // Bit reader state
+    uint64_t m_bitCache = 0;
+    int m_bitCount = 0;
+    bool m_ioError = false;
+
+    // Current decoded frame
+    std::vector<int32_t> m_channelData;   // channelCount * maxBlockSize
+    std::vector<float> m_frameFloat;      // Interleaved float of the current frame
+    FrameHeader m_frame;
+    int m_frameCursor = 0;                // Next frame sample to hand out
+    int m_frameFill = 0;                  // Samples in the current frame
+    int64_t m_position = 0;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_FLAC_SOURCE_H
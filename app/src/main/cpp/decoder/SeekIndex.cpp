@@ -0,0 +1,219 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               SEEK INDEX - SIDECAR FRAME TABLE              ║
+ * ║        Memory-Mapped O(1) Seeking for Long FLAC Files       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "SeekIndex.h"
+#include "FlacSource.h"
+
+#include <android/log.h>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_TAG "FTL_SeekIndex"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr char SEEK_INDEX_MAGIC[8] = {'F', 'T', 'L', 'S', 'I', 'D', 'X', '\0'};
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SOURCE IDENTITY
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool SourceStamp::of(const std::string& path, SourceStamp& stamp) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    stamp.size = static_cast<uint64_t>(info.st_size);
+    stamp.mtimeNs = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    return true;
+}
+
+std::string sidecarFileFor(const std::string& cacheDirectory, const std::string& sourcePath,
+                           const char* extension) {
+    // FNV-1a of the path: stable, flat file names in the cache directory
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : sourcePath) {
+        hash = (hash ^ c) * 0x100000001b3ull;
+    }
+    char name[48];
+    std::snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(hash), extension);
+    return cacheDirectory + "/" + name;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SIDECAR FILE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+SeekIndex::~SeekIndex() {
+    unmap();
+}
+
+std::string SeekIndex::sidecarPath(const std::string& cacheDirectory, const std::string& sourcePath) {
+    return sidecarFileFor(cacheDirectory, sourcePath, ".ftlidx");
+}
+
+bool SeekIndex::write(const std::string& path, const SeekIndexHeader& header,
+                      const std::vector<uint64_t>& entries) {
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOGE("Cannot create %s", tempPath.c_str());
+        return false;
+    }
+
+    SeekIndexHeader out = header;
+    std::memcpy(out.magic, SEEK_INDEX_MAGIC, sizeof(out.magic));
+    out.version = SEEK_INDEX_VERSION;
+    out.entryCount = entries.size();
+
+    bool ok = std::fwrite(&out, sizeof(out), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(uint64_t), entries.size(), file) == entries.size();
+    ok = (std::fclose(file) == 0) && ok;
+
+    // Readers only ever see a complete sidecar
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        LOGE("Failed to write %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SeekIndex::map(const std::string& path, const SourceStamp& stamp) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SeekIndexHeader))) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const auto* header = static_cast<const SeekIndexHeader*>(mapping);
+    bool valid = std::memcmp(header->magic, SEEK_INDEX_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == SEEK_INDEX_VERSION &&
+                 header->spacingFrames > 0 &&
+                 header->sourceSize == stamp.size &&
+                 header->sourceMtimeNs == stamp.mtimeNs &&
+                 sizeof(SeekIndexHeader) + header->entryCount * sizeof(uint64_t) == length;
+    if (!valid) {
+        munmap(mapping, length);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mappedBytes = length;
+    m_header = header;
+    m_entries = reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(mapping) + sizeof(SeekIndexHeader));
+    return true;
+}
+
+void SeekIndex::unmap() {
+    if (m_mapping) {
+        munmap(m_mapping, m_mappedBytes);
+    }
+    m_mapping = nullptr;
+    m_mappedBytes = 0;
+    m_header = nullptr;
+    m_entries = nullptr;
+}
+
+bool SeekIndex::lookup(int64_t sample, int64_t& frameSample, int64_t& frameOffset) const {
+    if (!m_entries || sample < 0) {
+        return false;
+    }
+
+    uint64_t slot = static_cast<uint64_t>(sample) / m_header->spacingFrames;
+    if (slot >= m_header->entryCount) {
+        return false;
+    }
+
+    uint64_t entry = m_entries[slot];
+    frameOffset = static_cast<int64_t>(entry >> 16);
+    frameSample = static_cast<int64_t>(slot * m_header->spacingFrames) - static_cast<int64_t>(entry & 0xFFFF);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// INDEX BUILDER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool buildSeekIndex(const std::string& sourcePath, const std::string& sidecarPath,
+                    const std::atomic<bool>* cancel) {
+    SourceStamp stamp;
+    if (!SourceStamp::of(sourcePath, stamp)) {
+        return false;
+    }
+
+    FlacSource source;
+    if (!source.open(sourcePath)) {
+        return false;
+    }
+
+    std::vector<FlacSeekPoint> frames;
+    if (!source.scanFrames(frames, cancel) || frames.empty()) {
+        return false;
+    }
+
+    const AudioSourceInfo& info = source.info();
+    const int64_t spacing = source.maxBlockSize();
+    const FlacSeekPoint& last = frames.back();
+    int64_t totalFrames = info.totalFrames >= 0 ? info.totalFrames : last.sample + spacing;
+
+    // One slot per grid sample: the frame containing it and how far in it sits
+    std::vector<uint64_t> entries;
+    entries.reserve(static_cast<size_t>((totalFrames + spacing - 1) / spacing));
+    size_t frame = 0;
+    for (int64_t sample = 0; sample < totalFrames; sample += spacing) {
+        while (frame + 1 < frames.size() && frames[frame + 1].sample <= sample) {
+            ++frame;
+        }
+        int64_t into = sample - frames[frame].sample;
+        if (into < 0 || into > 0xFFFF) {
+            LOGE("Frame table gap near sample %lld", static_cast<long long>(sample));
+            return false;
+        }
+        entries.push_back(SeekIndex::packEntry(frames[frame].offset, into));
+    }
+
+    SeekIndexHeader header = {};
+    header.spacingFrames = static_cast<uint32_t>(spacing);
+    header.sourceSize = stamp.size;
+    header.sourceMtimeNs = stamp.mtimeNs;
+    header.totalFrames = totalFrames;
+    header.sampleRate = static_cast<uint32_t>(info.sampleRate);
+    header.channelCount = static_cast<uint32_t>(info.channelCount);
+
+    if (!SeekIndex::write(sidecarPath, header, entries)) {
+        return false;
+    }
+    LOGI("Seek index: %zu frames, %zu entries -> %s", frames.size(), entries.size(), sidecarPath.c_str());
+    return true;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,114 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               SEEK INDEX - SIDECAR FRAME TABLE              ║
+ * ║        Memory-Mapped O(1) Seeking for Long FLAC Files       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Sidecar layout (native endian, written once, mapped read-only):
+ *   SeekIndexHeader (64 bytes)
+ *   uint64_t entries[entryCount]   entry k = frame containing sample k * spacing,
+ *                                  packed as (byteOffset << 16) | samplesIntoFrame
+ *
+ * A seek reads one entry, jumps to the frame and decodes at most
+ * spacing + one block forward. Sidecars are keyed to the source's size and
+ * mtime; a stale one is ignored and rebuilt.
+ */
+
+#ifndef FTL_SEEK_INDEX_H
+#define FTL_SEEK_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+constexpr uint32_t SEEK_INDEX_VERSION = 1;
+
+struct SeekIndexHeader {
+    char magic[8];               // "FTLSIDX"
+    uint32_t version;
+    uint32_t spacingFrames;
+    uint64_t sourceSize;
+    int64_t sourceMtimeNs;
+    int64_t totalFrames;
+    uint32_t sampleRate;
+    uint32_t channelCount;
+    uint64_t entryCount;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(SeekIndexHeader) == 64, "Sidecar header is 64 bytes");
+
+/**
+ * Identity of a source file at the time its index was built
+ */
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtimeNs = 0;
+
+    static bool of(const std::string& path, SourceStamp& stamp);
+};
+
+/**
+ * Flat cache file name for `sourcePath`: a hash of the path plus
+ * `extension` (".ftlidx"), shared by every kind of per-track sidecar
+ */
+std::string sidecarFileFor(const std::string& cacheDirectory, const std::string& sourcePath,
+                           const char* extension);
+
+class SeekIndex {
+public:
+    SeekIndex() = default;
+    ~SeekIndex();
+
+    /** Sidecar file name for `sourcePath` inside `cacheDirectory` */
+    static std::string sidecarPath(const std::string& cacheDirectory, const std::string& sourcePath);
+
+    /** Write a sidecar atomically (temp file + rename) */
+    static bool write(const std::string& path, const SeekIndexHeader& header,
+                      const std::vector<uint64_t>& entries);
+
+    /** Map a sidecar; fails if missing, corrupt or not built from `stamp` */
+    bool map(const std::string& path, const SourceStamp& stamp);
+    void unmap();
+    bool isMapped() const { return m_entries != nullptr; }
+
+    /**
+     * O(1): frame start at or before `sample`
+     * @return False if the sample lies outside the indexed range
+     */
+    bool lookup(int64_t sample, int64_t& frameSample, int64_t& frameOffset) const;
+
+    const SeekIndexHeader& header() const { return *m_header; }
+    size_t mappedBytes() const { return m_mappedBytes; }
+
+    static uint64_t packEntry(int64_t frameOffset, int64_t samplesIntoFrame) {
+        return (static_cast<uint64_t>(frameOffset) << 16) | static_cast<uint64_t>(samplesIntoFrame);
+    }
+
+private:
+    void* m_mapping = nullptr;
+    size_t m_mappedBytes = 0;
+    const SeekIndexHeader* m_header = nullptr;
+    const uint64_t* m_entries = nullptr;
+
+    SeekIndex(const SeekIndex&) = delete;
+    SeekIndex& operator=(const SeekIndex&) = delete;
+};
+
+/**
+ * Scan `sourcePath` and write its sidecar (library scan or first play).
+ * Only FLAC benefits - WAV seeks are already byte-offset math.
+ * @param cancel Optional flag polled during the scan
+ */
+bool buildSeekIndex(const std::string& sourcePath, const std::string& sidecarPath,
+                    const std::atomic<bool>* cancel = nullptr);
+
+} // namespace ftl_audio
+
+#endif // FTL_SEEK_INDEX_H
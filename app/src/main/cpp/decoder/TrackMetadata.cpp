@@ -0,0 +1,1037 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              TRACK METADATA - HEADER-ONLY PARSER            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Each container walker reads fixed-size headers into stack buffers and
+ * seeks over everything else. Tags keep the first value seen, so an
+ * ID3v2 tag in front of a FLAC stream wins over its Vorbis comment.
+ */
+
+#include "TrackMetadata.h"
+#include "FileReader.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#define LOG_TAG "FTL_TrackMetadata"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+// Text blocks larger than this are skipped (cover art lives in its own frames)
+constexpr size_t MAX_TAG_BLOCK_BYTES = 64 * 1024;
+constexpr size_t MAX_TEXT_FRAME_BYTES = 4096;
+
+// How far past an ID3v2 tag the first MPEG frame may start
+constexpr int64_t MPEG_SYNC_SEARCH_BYTES = 64 * 1024;
+constexpr size_t MPEG_SYNC_WINDOW = 8192;      // Half scanned, half for the next frame
+constexpr int MP4_MAX_DEPTH = 8;
+
+// DSD1024; anything above is a corrupt header
+constexpr int MAX_DSD_RATE = 49152000;
+
+uint16_t readLE16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+uint64_t readLE64(const uint8_t* p) { return readLE32(p) | (static_cast<uint64_t>(readLE32(p + 4)) << 32); }
+uint16_t readBE16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t readBE24(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+}
+uint32_t readBE32(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 24) | readBE24(p + 1); }
+uint64_t readBE64(const uint8_t* p) { return (static_cast<uint64_t>(readBE32(p)) << 32) | readBE32(p + 4); }
+uint32_t readSyncsafe(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0] & 0x7F) << 21) | ((p[1] & 0x7F) << 14) | ((p[2] & 0x7F) << 7) | (p[3] & 0x7F);
+}
+
+bool readAt(FileReader& reader, int64_t offset, void* dst, size_t count) {
+    return reader.seek(offset) && reader.read(dst, count) == count;
+}
+
+/** Average bits per second, clamped so corrupt lengths cannot overflow */
+int bitRateOf(int64_t bytes, double seconds) {
+    if (bytes <= 0 || seconds <= 0.0) {
+        return 0;
+    }
+    return static_cast<int>(std::min(static_cast<double>(bytes) * 8.0 / seconds, static_cast<double>(INT32_MAX)));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TAG TEXT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+enum class TagField { NONE, TITLE, ARTIST, ALBUM, YEAR, TRACK };
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+/** Up to the first NUL */
+std::string latin1ToUtf8(const uint8_t* p, size_t size) {
+    std::string out;
+    for (size_t i = 0; i < size && p[i] != 0; ++i) appendUtf8(out, p[i]);
+    return out;
+}
+
+/** Well-formed UTF-8: no overlong forms, surrogates or code points past U+10FFFF */
+bool isValidUtf8(const uint8_t* p, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        uint8_t lead = p[i];
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        }
+        size_t count = 0;
+        uint32_t codePoint = 0;
+        uint32_t minimum = 0;
+        if ((lead & 0xE0) == 0xC0) {
+            count = 1; codePoint = lead & 0x1F; minimum = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            count = 2; codePoint = lead & 0x0F; minimum = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            count = 3; codePoint = lead & 0x07; minimum = 0x10000;
+        } else {
+            return false;
+        }
+        if (i + count >= size) return false;        // Truncated sequence
+        for (size_t k = 1; k <= count; ++k) {
+            if ((p[i + k] & 0xC0) != 0x80) return false;
+            codePoint = (codePoint << 6) | (p[i + k] & 0x3F);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint < 0xE000)) {
+            return false;
+        }
+        i += count + 1;
+    }
+    return true;
+}
+
+/**
+ * Up to the first NUL. Mistagged files often put Latin-1 in "UTF-8" fields;
+ * text that isn't well-formed UTF-8 is read as Latin-1 instead
+ */
+std::string utf8Text(const uint8_t* p, size_t size) {
+    size_t length = 0;
+    while (length < size && p[length] != 0) ++length;
+    if (!isValidUtf8(p, length)) {
+        return latin1ToUtf8(p, length);
+    }
+    return std::string(reinterpret_cast<const char*>(p), length);
+}
+
+/** Up to the first NUL; a BOM overrides `bigEndian` */
+std::string utf16ToUtf8(const uint8_t* p, size_t size, bool bigEndian) {
+    size_t i = 0;
+    if (size >= 2 && ((p[0] == 0xFF && p[1] == 0xFE) || (p[0] == 0xFE && p[1] == 0xFF))) {
+        bigEndian = p[0] == 0xFE;
+        i = 2;
+    }
+    std::string out;
+    for (; i + 1 < size; i += 2) {
+        uint32_t unit = bigEndian ? readBE16(p + i) : readLE16(p + i);
+        if (unit == 0) break;
+        if (unit >= 0xD800 && unit < 0xDC00 && i + 3 < size) {
+            uint32_t low = bigEndian ? readBE16(p + i + 2) : readLE16(p + i + 2);
+            if (low >= 0xDC00 && low < 0xE000) {
+                unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                i += 2;
+            }
+        }
+        appendUtf8(out, unit);
+    }
+    return out;
+}
+
+std::string trimmed(std::string text) {
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\0')) text.pop_back();
+    size_t start = 0;
+    while (start < text.size() && text[start] == ' ') ++start;
+    return text.substr(start);
+}
+
+/** "2019-05-01" -> 2019, "3/12" -> 3 */
+int leadingNumber(const std::string& text) {
+    int value = 0;
+    size_t i = 0;
+    while (i < text.size() && text[i] == ' ') ++i;
+    for (int digits = 0; i < text.size() && text[i] >= '0' && text[i] <= '9' && digits < 9; ++i, ++digits) {
+        value = value * 10 + (text[i] - '0');
+    }
+    return value;
+}
+
+void assignTag(TrackMetadata& metadata, TagField field, const std::string& raw) {
+    std::string value = trimmed(raw);
+    if (value.empty()) {
+        return;
+    }
+    switch (field) {
+        case TagField::TITLE:  if (metadata.title.empty()) metadata.title = value; break;
+        case TagField::ARTIST: if (metadata.artist.empty()) metadata.artist = value; break;
+        case TagField::ALBUM:  if (metadata.album.empty()) metadata.album = value; break;
+        case TagField::YEAR:   if (metadata.year == 0) metadata.year = leadingNumber(value); break;
+        case TagField::TRACK:  if (metadata.trackNumber == 0) metadata.trackNumber = leadingNumber(value); break;
+        case TagField::NONE:   break;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ID3
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+TagField id3Field(const char* id, int version) {
+    if (version == 2) {
+        if (std::memcmp(id, "TT2", 3) == 0) return TagField::TITLE;
+        if (std::memcmp(id, "TP1", 3) == 0) return TagField::ARTIST;
+        if (std::memcmp(id, "TAL", 3) == 0) return TagField::ALBUM;
+        if (std::memcmp(id, "TYE", 3) == 0) return TagField::YEAR;
+        if (std::memcmp(id, "TRK", 3) == 0) return TagField::TRACK;
+        return TagField::NONE;
+    }
+    if (std::memcmp(id, "TIT2", 4) == 0) return TagField::TITLE;
+    if (std::memcmp(id, "TPE1", 4) == 0) return TagField::ARTIST;
+    if (std::memcmp(id, "TALB", 4) == 0) return TagField::ALBUM;
+    if (std::memcmp(id, "TYER", 4) == 0 || std::memcmp(id, "TDRC", 4) == 0) return TagField::YEAR;
+    if (std::memcmp(id, "TRCK", 4) == 0) return TagField::TRACK;
+    return TagField::NONE;
+}
+
+/** Text frame payload: encoding byte, then the (first) string */
+std::string id3Text(const uint8_t* p, size_t size) {
+    if (size < 1) {
+        return std::string();
+    }
+    switch (p[0]) {
+        case 0:  return latin1ToUtf8(p + 1, size - 1);
+        case 1:  return utf16ToUtf8(p + 1, size - 1, true);
+        case 2:  return utf16ToUtf8(p + 1, size - 1, true);
+        case 3:  return utf8Text(p + 1, size - 1);
+        default: return std::string();
+    }
+}
+
+/** Undo unsynchronisation: FF 00 -> FF */
+size_t resynchronise(uint8_t* p, size_t size) {
+    size_t out = 0;
+    for (size_t i = 0; i < size; ++i) {
+        p[out++] = p[i];
+        if (p[i] == 0xFF && i + 1 < size && p[i + 1] == 0x00) ++i;
+    }
+    return out;
+}
+
+/**
+ * ID3v2 tag at `offset`: text frames only, everything else seeked over
+ * @param tagEnd Receives the offset just past the tag (footer included)
+ */
+bool parseId3v2(FileReader& reader, int64_t offset, TrackMetadata& metadata, int64_t* tagEnd) {
+    uint8_t header[10];
+    if (!readAt(reader, offset, header, sizeof(header)) || std::memcmp(header, "ID3", 3) != 0 ||
+        header[3] < 2 || header[3] > 4 || ((header[6] | header[7] | header[8] | header[9]) & 0x80) != 0) {
+        return false;
+    }
+    const int version = header[3];
+    const uint8_t flags = header[5];
+    const int64_t framesEnd = offset + 10 + readSyncsafe(header + 6);
+    if (tagEnd) {
+        *tagEnd = framesEnd + ((version == 4 && (flags & 0x10)) ? 10 : 0);
+    }
+
+    int64_t position = offset + 10;
+    if ((flags & 0x40) && version >= 3) {
+        uint8_t extended[4];
+        if (!readAt(reader, position, extended, sizeof(extended))) {
+            return false;
+        }
+        position += version == 3 ? 4 + readBE32(extended) : readSyncsafe(extended);
+    }
+
+    const size_t frameHeaderBytes = version == 2 ? 6 : 10;
+    uint8_t text[MAX_TEXT_FRAME_BYTES];
+    while (position + static_cast<int64_t>(frameHeaderBytes) <= framesEnd) {
+        uint8_t frame[10];
+        if (!readAt(reader, position, frame, frameHeaderBytes) || frame[0] == 0) {
+            break;   // Padding
+        }
+        uint32_t size = version == 2 ? readBE24(frame + 3) : version == 3 ? readBE32(frame + 4) : readSyncsafe(frame + 4);
+        uint16_t frameFlags = version == 2 ? 0 : readBE16(frame + 8);
+        int64_t dataStart = position + static_cast<int64_t>(frameHeaderBytes);
+        if (size == 0 || dataStart + size > framesEnd) {
+            break;
+        }
+        position = dataStart + size;
+
+        TagField field = id3Field(reinterpret_cast<const char*>(frame), version);
+        bool packed = version == 3 ? (frameFlags & 0x00C0) != 0 : version == 4 && (frameFlags & 0x000C) != 0;
+        if (field == TagField::NONE || packed || size > sizeof(text) || reader.read(text, size) != size) {
+            continue;
+        }
+        size_t length = size;
+        uint8_t* payload = text;
+        if (version == 4 && (frameFlags & 0x0001)) {
+            // Data length indicator
+            if (length < 4) continue;
+            payload += 4;
+            length -= 4;
+        }
+        if ((flags & 0x80) || (version == 4 && (frameFlags & 0x0002))) {
+            length = resynchronise(payload, length);
+        }
+        assignTag(metadata, field, id3Text(payload, length));
+    }
+    return true;
+}
+
+/** ID3v1 tag in the last 128 bytes */
+bool parseId3v1(FileReader& reader, TrackMetadata& metadata) {
+    uint8_t tag[128];
+    if (reader.size() < static_cast<int64_t>(sizeof(tag)) ||
+        !readAt(reader, reader.size() - sizeof(tag), tag, sizeof(tag)) || std::memcmp(tag, "TAG", 3) != 0) {
+        return false;
+    }
+    assignTag(metadata, TagField::TITLE, latin1ToUtf8(tag + 3, 30));
+    assignTag(metadata, TagField::ARTIST, latin1ToUtf8(tag + 33, 30));
+    assignTag(metadata, TagField::ALBUM, latin1ToUtf8(tag + 63, 30));
+    assignTag(metadata, TagField::YEAR, latin1ToUtf8(tag + 93, 4));
+    // ID3v1.1: a zero byte ends the comment early and the track follows
+    if (tag[125] == 0 && tag[126] != 0 && metadata.trackNumber == 0) {
+        metadata.trackNumber = tag[126];
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WAV
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void parseRiffInfo(const uint8_t* p, size_t size, TrackMetadata& metadata) {
+    for (size_t position = 4; position + 8 <= size;) {
+        uint32_t length = readLE32(p + position + 4);
+        const uint8_t* id = p + position;
+        if (length > size - position - 8) {
+            break;
+        }
+        const uint8_t* value = p + position + 8;
+        TagField field = TagField::NONE;
+        if (std::memcmp(id, "INAM", 4) == 0) field = TagField::TITLE;
+        else if (std::memcmp(id, "IART", 4) == 0) field = TagField::ARTIST;
+        else if (std::memcmp(id, "IPRD", 4) == 0) field = TagField::ALBUM;
+        else if (std::memcmp(id, "ICRD", 4) == 0) field = TagField::YEAR;
+        else if (std::memcmp(id, "ITRK", 4) == 0 || std::memcmp(id, "IPRT", 4) == 0) field = TagField::TRACK;
+        if (field != TagField::NONE) {
+            // INFO strings are nominally ASCII; most taggers write UTF-8
+            assignTag(metadata, field, utf8Text(value, length));
+        }
+        position += 8 + length + (length & 1);
+    }
+}
+
+bool parseWav(FileReader& reader, TrackMetadata& metadata) {
+    bool haveFormat = false;
+    int64_t dataBytes = -1;
+    int blockAlign = 0;
+    int bitsPerSample = 0;
+
+    int64_t position = 12;
+    uint8_t chunkHeader[8];
+    while (readAt(reader, position, chunkHeader, sizeof(chunkHeader))) {
+        uint32_t chunkSize = readLE32(chunkHeader + 4);
+        int64_t chunkStart = position + 8;
+
+        if (std::memcmp(chunkHeader, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            size_t toRead = std::min<size_t>(chunkSize, sizeof(fmt));
+            if (chunkSize < 16 || reader.read(fmt, toRead) != toRead) {
+                return false;
+            }
+            metadata.channelCount = readLE16(fmt + 2);
+            metadata.sampleRate = static_cast<int>(readLE32(fmt + 4));
+            blockAlign = readLE16(fmt + 12);
+            bitsPerSample = readLE16(fmt + 14);
+            // Extensible: valid bits may be fewer than the container (24 in 32)
+            if (readLE16(fmt) == 0xFFFE && chunkSize >= 40 && readLE16(fmt + 18) > 0) {
+                bitsPerSample = readLE16(fmt + 18);
+            }
+            haveFormat = true;
+        } else if (std::memcmp(chunkHeader, "data", 4) == 0) {
+            dataBytes = chunkSize;
+            if (chunkSize == 0 || chunkSize == 0xFFFFFFFFu || chunkStart + dataBytes > reader.size()) {
+                dataBytes = reader.size() - chunkStart;
+            }
+        } else if (std::memcmp(chunkHeader, "LIST", 4) == 0 && chunkSize >= 4 && chunkSize <= MAX_TAG_BLOCK_BYTES) {
+            std::vector<uint8_t> list(chunkSize);
+            if (reader.read(list.data(), chunkSize) == chunkSize && std::memcmp(list.data(), "INFO", 4) == 0) {
+                parseRiffInfo(list.data(), chunkSize, metadata);
+            }
+        } else if (std::memcmp(chunkHeader, "id3 ", 4) == 0 || std::memcmp(chunkHeader, "ID3 ", 4) == 0) {
+            parseId3v2(reader, chunkStart, metadata, nullptr);
+        }
+
+        // Tag chunks may follow the audio; only walk on if the file has bytes there
+        position = chunkStart + chunkSize + (chunkSize & 1);
+        if (dataBytes >= 0 && position + 8 > reader.size()) {
+            break;
+        }
+    }
+
+    if (!haveFormat || dataBytes < 0 || metadata.channelCount <= 0 || metadata.sampleRate <= 0 || blockAlign <= 0) {
+        return false;
+    }
+    metadata.codec = "wav";
+    metadata.bitsPerSample = bitsPerSample;
+    metadata.totalFrames = dataBytes / blockAlign;
+    metadata.bitRate = static_cast<int>(std::min<int64_t>(INT32_MAX, static_cast<int64_t>(metadata.sampleRate) * blockAlign * 8));
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FLAC
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void parseStreamInfo(const uint8_t* info, TrackMetadata& metadata) {
+    metadata.sampleRate = static_cast<int>((static_cast<uint32_t>(info[10]) << 12) | (info[11] << 4) | (info[12] >> 4));
+    metadata.channelCount = ((info[12] >> 1) & 0x07) + 1;
+    metadata.bitsPerSample = (((info[12] & 0x01) << 4) | (info[13] >> 4)) + 1;
+    int64_t totalSamples = (static_cast<int64_t>(info[13] & 0x0F) << 32) | readBE32(info + 14);
+    metadata.totalFrames = totalSamples > 0 ? totalSamples : -1;
+}
+
+void parseVorbisComment(const uint8_t* p, size_t size, TrackMetadata& metadata) {
+    if (size < 4) {
+        return;
+    }
+    size_t position = 4 + static_cast<size_t>(readLE32(p));   // Vendor string
+    if (position + 4 > size) {
+        return;
+    }
+    uint32_t count = readLE32(p + position);
+    position += 4;
+    for (uint32_t i = 0; i < count && position + 4 <= size; ++i) {
+        uint32_t length = readLE32(p + position);
+        position += 4;
+        if (length > size - position) {
+            break;
+        }
+        std::string entry(reinterpret_cast<const char*>(p + position), length);
+        position += length;
+
+        size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            continue;
+        }
+        std::string key = entry.substr(0, equals);
+        std::transform(key.begin(), key.end(), key.begin(), [](char c) {
+            return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        });
+        TagField field = TagField::NONE;
+        if (key == "TITLE") field = TagField::TITLE;
+        else if (key == "ARTIST") field = TagField::ARTIST;
+        else if (key == "ALBUM") field = TagField::ALBUM;
+        else if (key == "DATE" || key == "YEAR") field = TagField::YEAR;
+        else if (key == "TRACKNUMBER") field = TagField::TRACK;
+        assignTag(metadata, field, utf8Text(p + position - length + equals + 1, length - equals - 1));
+    }
+}
+
+bool parseFlac(FileReader& reader, int64_t offset, TrackMetadata& metadata) {
+    uint8_t marker[4];
+    if (!readAt(reader, offset, marker, sizeof(marker)) || std::memcmp(marker, "fLaC", 4) != 0) {
+        return false;
+    }
+
+    bool haveStreamInfo = false;
+    bool lastBlock = false;
+    int64_t position = offset + 4;
+    while (!lastBlock) {
+        uint8_t blockHeader[4];
+        if (!readAt(reader, position, blockHeader, sizeof(blockHeader))) {
+            return false;
+        }
+        lastBlock = (blockHeader[0] & 0x80) != 0;
+        int type = blockHeader[0] & 0x7F;
+        uint32_t length = readBE24(blockHeader + 1);
+
+        if (type == 0 && length >= 34) {
+            uint8_t info[34];
+            if (reader.read(info, sizeof(info)) != sizeof(info)) {
+                return false;
+            }
+            parseStreamInfo(info, metadata);
+            haveStreamInfo = true;
+        } else if (type == 4 && length <= MAX_TAG_BLOCK_BYTES) {
+            std::vector<uint8_t> comment(length);
+            if (reader.read(comment.data(), length) == length) {
+                parseVorbisComment(comment.data(), length, metadata);
+            }
+        }
+        position += 4 + static_cast<int64_t>(length);
+        if (position > reader.size()) {
+            return false;
+        }
+    }
+
+    if (!haveStreamInfo || metadata.sampleRate <= 0) {
+        return false;
+    }
+    metadata.codec = "flac";
+    if (metadata.totalFrames > 0) {
+        metadata.bitRate = bitRateOf(reader.size() - position, metadata.durationSeconds());
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// DSF
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool parseDsf(FileReader& reader, TrackMetadata& metadata) {
+    // DSD chunk (28 bytes) then fmt chunk (52 bytes)
+    uint8_t header[80];
+    if (!readAt(reader, 0, header, sizeof(header)) || std::memcmp(header + 28, "fmt ", 4) != 0 ||
+        readLE32(header + 40) != 1) {
+        return false;
+    }
+    metadata.channelCount = static_cast<int>(readLE32(header + 52));
+    metadata.sampleRate = static_cast<int>(readLE32(header + 56));
+    metadata.totalFrames = static_cast<int64_t>(readLE64(header + 64));
+    if (metadata.channelCount <= 0 || metadata.channelCount > 6 || metadata.sampleRate <= 0 ||
+        metadata.sampleRate > MAX_DSD_RATE || metadata.totalFrames < 0) {
+        return false;
+    }
+    // The bits field only tells the bit order (1 = LSB first, 8 = MSB first)
+    metadata.codec = "dsf";
+    metadata.bitsPerSample = 1;
+    metadata.bitRate = metadata.sampleRate * metadata.channelCount;
+
+    uint64_t metadataOffset = readLE64(header + 20);
+    if (metadataOffset > 0 && metadataOffset + 10 <= static_cast<uint64_t>(reader.size())) {
+        parseId3v2(reader, static_cast<int64_t>(metadataOffset), metadata, nullptr);
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MPEG AUDIO
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+struct MpegFrame {
+    bool mpeg1 = false;
+    int layer = 0;
+    int bitRate = 0;
+    int sampleRate = 0;
+    int channelCount = 0;
+    int samplesPerFrame = 0;
+    int length = 0;              // Bytes, padding included
+    int sideInfoBytes = 0;       // Layer III only
+};
+
+bool parseMpegHeader(const uint8_t* h, MpegFrame& frame) {
+    static const int BIT_RATES[5][15] = {
+        {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},   // MPEG-1 layer I
+        {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},      // MPEG-1 layer II
+        {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},       // MPEG-1 layer III
+        {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},      // MPEG-2/2.5 layer I
+        {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},           // MPEG-2/2.5 layer II/III
+    };
+    static const int SAMPLE_RATES[3] = {44100, 48000, 32000};
+
+    if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) {
+        return false;
+    }
+    int versionBits = (h[1] >> 3) & 0x03;
+    int layerBits = (h[1] >> 1) & 0x03;
+    int bitRateIndex = h[2] >> 4;
+    int rateIndex = (h[2] >> 2) & 0x03;
+    if (versionBits == 1 || layerBits == 0 || bitRateIndex == 0 || bitRateIndex == 15 || rateIndex == 3) {
+        return false;
+    }
+
+    frame.mpeg1 = versionBits == 3;
+    frame.layer = 4 - layerBits;
+    int table = frame.mpeg1 ? frame.layer - 1 : (frame.layer == 1 ? 3 : 4);
+    frame.bitRate = BIT_RATES[table][bitRateIndex] * 1000;
+    frame.sampleRate = SAMPLE_RATES[rateIndex] >> (frame.mpeg1 ? 0 : versionBits == 2 ? 1 : 2);
+    frame.channelCount = (h[3] >> 6) == 3 ? 1 : 2;
+    int padding = (h[2] >> 1) & 0x01;
+
+    if (frame.layer == 1) {
+        frame.samplesPerFrame = 384;
+        frame.length = (12 * frame.bitRate / frame.sampleRate + padding) * 4;
+    } else {
+        frame.samplesPerFrame = (frame.layer == 3 && !frame.mpeg1) ? 576 : 1152;
+        frame.length = frame.samplesPerFrame / 8 * frame.bitRate / frame.sampleRate + padding;
+    }
+    if (frame.layer == 3) {
+        frame.sideInfoBytes = frame.mpeg1 ? (frame.channelCount == 1 ? 17 : 32) : (frame.channelCount == 1 ? 9 : 17);
+    }
+    return true;
+}
+
+/**
+ * Frame count (and LAME gapless trim) from a Xing/Info or VBRI header in
+ * the first frame. @return Frames, 0 without a header
+ */
+int64_t readVbrHeader(const uint8_t* frameBytes, size_t available, const MpegFrame& frame,
+                      int64_t& streamBytes, int& trimSamples) {
+    size_t xing = 4 + static_cast<size_t>(frame.sideInfoBytes);
+    if (xing + 8 <= available &&
+        (std::memcmp(frameBytes + xing, "Xing", 4) == 0 || std::memcmp(frameBytes + xing, "Info", 4) == 0)) {
+        uint32_t flags = readBE32(frameBytes + xing + 4);
+        size_t position = xing + 8;
+        int64_t frames = 0;
+        if ((flags & 0x1) && position + 4 <= available) {
+            frames = readBE32(frameBytes + position);
+            position += 4;
+        }
+        if (flags & 0x2) {
+            if (position + 4 <= available) streamBytes = readBE32(frameBytes + position);
+            position += 4;
+        }
+        if (flags & 0x4) position += 100;   // Seek TOC
+        if (flags & 0x8) position += 4;     // Quality
+        // LAME extension: 12-bit encoder delay and padding 21 bytes in
+        if (position + 24 <= available && (std::memcmp(frameBytes + position, "LAME", 4) == 0 ||
+                                           std::memcmp(frameBytes + position, "Lavc", 4) == 0 ||
+                                           std::memcmp(frameBytes + position, "Lavf", 4) == 0)) {
+            uint32_t delayPadding = readBE24(frameBytes + position + 21);
+            trimSamples = static_cast<int>((delayPadding >> 12) + (delayPadding & 0xFFF));
+        }
+        return frames;
+    }
+    // VBRI sits at a fixed 32 bytes past the header
+    if (36 + 18 <= available && std::memcmp(frameBytes + 36, "VBRI", 4) == 0) {
+        streamBytes = readBE32(frameBytes + 36 + 10);
+        return readBE32(frameBytes + 36 + 14);
+    }
+    return 0;
+}
+
+bool parseMpegAudio(FileReader& reader, int64_t offset, TrackMetadata& metadata) {
+    // Find two consecutive frame headers (a lone FF Ex in junk is common)
+    uint8_t window[MPEG_SYNC_WINDOW];
+    MpegFrame frame;
+    int64_t frameStart = -1;
+    size_t available = 0;
+    for (int64_t base = offset; frameStart < 0 && base < offset + MPEG_SYNC_SEARCH_BYTES;
+         base += MPEG_SYNC_WINDOW / 2) {
+        if (!reader.seek(base)) {
+            break;
+        }
+        available = reader.read(window, sizeof(window));
+        if (available < 4) {
+            break;
+        }
+        for (size_t i = 0; i + 4 <= available && i < MPEG_SYNC_WINDOW / 2; ++i) {
+            MpegFrame next;
+            if (!parseMpegHeader(window + i, frame)) {
+                continue;
+            }
+            size_t following = i + static_cast<size_t>(frame.length);
+            bool confirmed = following + 4 > available ? base + static_cast<int64_t>(following) >= reader.size() - 128
+                                                       : parseMpegHeader(window + following, next) &&
+                                                         next.sampleRate == frame.sampleRate;
+            if (confirmed) {
+                frameStart = base + static_cast<int64_t>(i);
+                std::memmove(window, window + i, available - i);
+                available -= i;
+                break;
+            }
+        }
+        if (available < sizeof(window)) {
+            break;   // End of file
+        }
+    }
+    if (frameStart < 0) {
+        return false;
+    }
+
+    metadata.codec = "mp3";
+    metadata.sampleRate = frame.sampleRate;
+    metadata.channelCount = frame.channelCount;
+    metadata.bitsPerSample = 0;
+
+    int64_t streamBytes = 0;
+    int trimSamples = 0;
+    int64_t frames = readVbrHeader(window, std::min<size_t>(available, frame.length), frame, streamBytes, trimSamples);
+
+    // ID3v1 moves the end of the audio; also the only tags some files have
+    int64_t audioEnd = reader.size();
+    if ((frames == 0 || metadata.title.empty()) && parseId3v1(reader, metadata)) {
+        audioEnd -= 128;
+    }
+
+    if (frames > 0) {
+        metadata.totalFrames = std::max<int64_t>(0, frames * frame.samplesPerFrame - trimSamples);
+        if (streamBytes <= 0) {
+            streamBytes = audioEnd - frameStart;
+        }
+        metadata.bitRate = bitRateOf(streamBytes, static_cast<double>(frames * frame.samplesPerFrame) / frame.sampleRate);
+    } else {
+        // CBR: the first frame's rate holds throughout
+        metadata.bitRate = frame.bitRate;
+        metadata.totalFrames = (audioEnd - frameStart) * 8 * frame.sampleRate / frame.bitRate;
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MP4
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+struct Mp4Box {
+    char type[4];
+    int64_t body = 0;
+    int64_t end = 0;
+};
+
+struct Mp4Track {
+    bool audio = false;
+    uint32_t timescale = 0;
+    uint64_t duration = 0;
+    std::string codec;
+    int sampleRate = 0;
+    int channelCount = 0;
+    int bitsPerSample = 0;
+    int bitRate = 0;
+};
+
+struct Mp4Parse {
+    TrackMetadata& metadata;
+    Mp4Track track;
+    bool haveAudio = false;
+};
+
+bool readBox(FileReader& reader, int64_t position, int64_t limit, Mp4Box& box) {
+    uint8_t header[16];
+    if (!readAt(reader, position, header, 8)) {
+        return false;
+    }
+    std::memcpy(box.type, header + 4, 4);
+    uint64_t size = readBE32(header);
+    int64_t headerBytes = 8;
+    if (size == 1) {
+        if (reader.read(header + 8, 8) != 8) return false;
+        size = readBE64(header + 8);
+        headerBytes = 16;
+    } else if (size == 0) {
+        size = static_cast<uint64_t>(limit - position);
+    }
+    if (size < static_cast<uint64_t>(headerBytes) || size > static_cast<uint64_t>(limit - position)) {
+        return false;
+    }
+    box.body = position + headerBytes;
+    box.end = position + static_cast<int64_t>(size);
+    return true;
+}
+
+bool boxIs(const Mp4Box& box, const char* type) { return std::memcmp(box.type, type, 4) == 0; }
+
+/** MPEG-4 descriptor length: up to four 7-bit groups */
+size_t descriptorLength(const uint8_t* p, size_t size, size_t& position) {
+    size_t length = 0;
+    for (int i = 0; i < 4 && position < size; ++i) {
+        uint8_t byte = p[position++];
+        length = (length << 7) | (byte & 0x7F);
+        if (!(byte & 0x80)) break;
+    }
+    return length;
+}
+
+void parseEsds(const uint8_t* p, size_t size, Mp4Track& track) {
+    static const int AAC_RATES[13] = {96000, 88200, 64000, 48000, 44100, 32000, 24000,
+                                      22050, 16000, 12000, 11025, 8000, 7350};
+    size_t position = 4;   // Full box
+    if (position + 2 > size || p[position++] != 0x03) {
+        return;
+    }
+    descriptorLength(p, size, position);
+    if (position + 3 > size) return;
+    position += 2;   // ES_ID
+    uint8_t flags = p[position++];
+    if (flags & 0x80) position += 2;
+    if ((flags & 0x40) && position < size) position += 1 + p[position];
+    if (flags & 0x20) position += 2;
+
+    if (position + 2 > size || p[position++] != 0x04) {
+        return;
+    }
+    descriptorLength(p, size, position);
+    if (position + 13 > size) return;
+    uint8_t objectType = p[position];
+    if (objectType == 0x69 || objectType == 0x6B) {
+        track.codec = "mp3";
+    }
+    track.bitRate = static_cast<int>(readBE32(p + position + 9));
+    position += 13;
+
+    if (position + 2 > size || p[position++] != 0x05) {
+        return;
+    }
+    descriptorLength(p, size, position);
+    if (position + 2 > size || track.codec != "aac") return;
+    // AudioSpecificConfig: 5-bit object type, 4-bit rate index, 4-bit channel layout
+    int rateIndex = ((p[position] & 0x07) << 1) | (p[position + 1] >> 7);
+    int layout = (p[position + 1] >> 3) & 0x0F;
+    if (rateIndex < 13 && track.sampleRate == 0) {
+        track.sampleRate = AAC_RATES[rateIndex];
+    }
+    if (layout >= 1 && layout <= 7) {
+        track.channelCount = layout == 7 ? 8 : layout;
+    }
+}
+
+void parseSampleEntry(FileReader& reader, const Mp4Box& stsd, Mp4Track& track) {
+    Mp4Box entry;
+    uint8_t fields[28];
+    if (!readBox(reader, stsd.body + 8, stsd.end, entry) || !readAt(reader, entry.body, fields, sizeof(fields))) {
+        return;
+    }
+    if (boxIs(entry, "mp4a")) track.codec = "aac";
+    else if (boxIs(entry, "alac")) track.codec = "alac";
+    else if (boxIs(entry, "fLaC")) track.codec = "flac";
+    else track.codec = std::string(entry.type, 4);
+
+    int version = readBE16(fields + 8);
+    track.channelCount = readBE16(fields + 16);
+    track.sampleRate = static_cast<int>(readBE32(fields + 24) >> 16);
+    track.bitsPerSample = track.codec == "alac" || track.codec == "flac" ? readBE16(fields + 18) : 0;
+    int64_t children = entry.body + 28 + (version == 1 ? 16 : version == 2 ? 36 : 0);
+
+    for (Mp4Box child; children < entry.end && readBox(reader, children, entry.end, child); children = child.end) {
+        uint8_t body[256];
+        size_t size = static_cast<size_t>(std::min<int64_t>(child.end - child.body, sizeof(body)));
+        if (!readAt(reader, child.body, body, size)) {
+            break;
+        }
+        if (boxIs(child, "esds")) {
+            parseEsds(body, size, track);
+        } else if (boxIs(child, "alac") && size >= 28) {
+            // Magic cookie after the full box header
+            track.bitsPerSample = body[4 + 5];
+            track.channelCount = body[4 + 9];
+            track.bitRate = static_cast<int>(readBE32(body + 4 + 16));
+            track.sampleRate = static_cast<int>(readBE32(body + 4 + 20));
+        } else if (boxIs(child, "dfLa") && size >= 8 + 34 && (body[4] & 0x7F) == 0) {
+            TrackMetadata info;
+            parseStreamInfo(body + 8, info);
+            track.sampleRate = info.sampleRate;
+            track.channelCount = info.channelCount;
+            track.bitsPerSample = info.bitsPerSample;
+        }
+    }
+}
+
+void parseIlstItem(FileReader& reader, const Mp4Box& item, TrackMetadata& metadata) {
+    TagField field = TagField::NONE;
+    if (boxIs(item, "\xA9nam")) field = TagField::TITLE;
+    else if (boxIs(item, "\xA9" "ART")) field = TagField::ARTIST;
+    else if (boxIs(item, "\xA9" "alb")) field = TagField::ALBUM;
+    else if (boxIs(item, "\xA9" "day")) field = TagField::YEAR;
+    else if (boxIs(item, "trkn")) field = TagField::TRACK;
+    Mp4Box data;
+    if (field == TagField::NONE || !readBox(reader, item.body, item.end, data) || !boxIs(data, "data")) {
+        return;
+    }
+    // Type and locale words, then the value
+    int64_t length = data.end - data.body - 8;
+    uint8_t value[MAX_TEXT_FRAME_BYTES];
+    if (length <= 0 || length > static_cast<int64_t>(sizeof(value)) ||
+        !readAt(reader, data.body + 8, value, static_cast<size_t>(length))) {
+        return;
+    }
+    if (field == TagField::TRACK) {
+        if (length >= 4 && metadata.trackNumber == 0) metadata.trackNumber = readBE16(value + 2);
+    } else {
+        assignTag(metadata, field, utf8Text(value, static_cast<size_t>(length)));
+    }
+}
+
+void walkMp4(FileReader& reader, int64_t begin, int64_t end, Mp4Parse& parse, int depth) {
+    if (depth > MP4_MAX_DEPTH) {
+        return;
+    }
+    for (Mp4Box box; begin + 8 <= end && readBox(reader, begin, end, box); begin = box.end) {
+        if (boxIs(box, "moov") || boxIs(box, "mdia") || boxIs(box, "minf") || boxIs(box, "stbl") ||
+            boxIs(box, "udta")) {
+            walkMp4(reader, box.body, box.end, parse, depth + 1);
+        } else if (boxIs(box, "trak")) {
+            parse.track = Mp4Track();
+            walkMp4(reader, box.body, box.end, parse, depth + 1);
+            if (parse.track.audio && !parse.haveAudio) {
+                const Mp4Track& track = parse.track;
+                TrackMetadata& metadata = parse.metadata;
+                metadata.codec = track.codec;
+                metadata.sampleRate = track.sampleRate > 0 ? track.sampleRate : static_cast<int>(track.timescale);
+                metadata.channelCount = track.channelCount;
+                metadata.bitsPerSample = track.bitsPerSample;
+                metadata.bitRate = track.bitRate;
+                double frames = track.timescale > 0 ? static_cast<double>(track.duration) * metadata.sampleRate / track.timescale : 0.0;
+                if (frames > 0.0 && frames < 9.0e18) {
+                    metadata.totalFrames = static_cast<int64_t>(frames + 0.5);
+                }
+                parse.haveAudio = true;
+            }
+        } else if (boxIs(box, "meta")) {
+            // ISO meta is a full box; QuickTime's is not
+            uint8_t probe[8];
+            if (readAt(reader, box.body, probe, sizeof(probe))) {
+                int64_t children = std::memcmp(probe + 4, "hdlr", 4) == 0 ? box.body : box.body + 4;
+                walkMp4(reader, children, box.end, parse, depth + 1);
+            }
+        } else if (boxIs(box, "ilst")) {
+            for (Mp4Box item; box.body + 8 <= box.end && readBox(reader, box.body, box.end, item); box.body = item.end) {
+                parseIlstItem(reader, item, parse.metadata);
+            }
+        } else if (boxIs(box, "hdlr")) {
+            uint8_t hdlr[12];
+            if (readAt(reader, box.body, hdlr, sizeof(hdlr))) {
+                parse.track.audio = std::memcmp(hdlr + 8, "soun", 4) == 0;
+            }
+        } else if (boxIs(box, "mdhd")) {
+            uint8_t mdhd[32] = {};
+            size_t size = static_cast<size_t>(std::min<int64_t>(box.end - box.body, sizeof(mdhd)));
+            if (size >= 20 && readAt(reader, box.body, mdhd, size)) {
+                bool wide = mdhd[0] == 1;
+                parse.track.timescale = readBE32(mdhd + (wide ? 20 : 12));
+                parse.track.duration = wide ? readBE64(mdhd + 24) : readBE32(mdhd + 16);
+            }
+        } else if (boxIs(box, "stsd")) {
+            parseSampleEntry(reader, box, parse.track);
+        }
+    }
+}
+
+bool parseMp4(FileReader& reader, TrackMetadata& metadata) {
+    Mp4Parse parse{metadata, Mp4Track{}, false};
+    walkMp4(reader, 0, reader.size(), parse, 0);
+    if (!parse.haveAudio || metadata.sampleRate <= 0 || metadata.channelCount <= 0) {
+        return false;
+    }
+    if (metadata.bitRate <= 0) {
+        metadata.bitRate = bitRateOf(reader.size(), metadata.durationSeconds());
+    }
+    return true;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENTRY POINTS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool readTrackMetadata(const std::string& path, TrackMetadata& metadata) {
+    metadata = TrackMetadata();
+    metadata.path = path;
+
+    FileReader reader(METADATA_READ_BYTES);
+    uint8_t head[12];
+    if (!reader.open(path) || reader.read(head, sizeof(head)) != sizeof(head)) {
+        metadata.bytesRead = reader.stats().bytesRead;
+        return false;
+    }
+
+    bool parsed = false;
+    if (std::memcmp(head, "RIFF", 4) == 0 && std::memcmp(head + 8, "WAVE", 4) == 0) {
+        parsed = parseWav(reader, metadata);
+    } else if (std::memcmp(head, "fLaC", 4) == 0) {
+        parsed = parseFlac(reader, 0, metadata);
+    } else if (std::memcmp(head, "DSD ", 4) == 0) {
+        parsed = parseDsf(reader, metadata);
+    } else if (std::memcmp(head + 4, "ftyp", 4) == 0) {
+        parsed = parseMp4(reader, metadata);
+    } else if (std::memcmp(head, "ID3", 3) == 0) {
+        int64_t tagEnd = 0;
+        uint8_t marker[4];
+        if (parseId3v2(reader, 0, metadata, &tagEnd)) {
+            bool flac = readAt(reader, tagEnd, marker, sizeof(marker)) && std::memcmp(marker, "fLaC", 4) == 0;
+            parsed = flac ? parseFlac(reader, tagEnd, metadata) : parseMpegAudio(reader, tagEnd, metadata);
+        }
+    } else {
+        // Bare MPEG audio, possibly behind junk: two consecutive frame headers
+        parsed = parseMpegAudio(reader, 0, metadata);
+    }
+
+    metadata.parsed = parsed;
+    metadata.bytesRead = reader.stats().bytesRead;
+    return parsed;
+}
+
+std::vector<TrackMetadata> readTrackMetadataBatch(const std::vector<std::string>& paths, int threads,
+                                                  MetadataBatchStats* stats, const std::atomic<bool>* cancel) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TrackMetadata> results(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        results[i].path = paths[i];
+    }
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    threads = static_cast<int>(std::min<size_t>(std::min(threads, MAX_METADATA_THREADS),
+                                                std::max<size_t>(paths.size(), 1)));
+
+    // Files are independent: workers pull the next index until the list runs out
+    std::atomic<size_t> next{0};
+    std::atomic<int> attempted{0};
+    auto work = [&] {
+        for (;;) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                return;
+            }
+            size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= paths.size()) {
+                return;
+            }
+            readTrackMetadata(paths[index], results[index]);
+            attempted.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    MetadataBatchStats batch;
+    for (const TrackMetadata& metadata : results) {
+        batch.parsed += metadata.parsed ? 1 : 0;
+        batch.bytesRead += metadata.bytesRead;
+    }
+    batch.failed = attempted.load() - batch.parsed;
+    batch.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LOGI("Metadata batch: %d parsed, %d failed on %d threads, %.0f files/s, %.1f KB/file",
+         batch.parsed, batch.failed, threads, batch.filesPerSecond(),
+         batch.parsed + batch.failed > 0 ? batch.bytesRead / 1024.0 / (batch.parsed + batch.failed) : 0.0);
+    if (stats) {
+        *stats = batch;
+    }
+    return results;
+}
+
+} // namespace ftl_audio
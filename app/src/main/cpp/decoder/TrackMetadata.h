@@ -0,0 +1,86 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              TRACK METADATA - HEADER-ONLY PARSER            ║
+ * ║     Exact Stream Parameters & Tags for the Library Scan     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Reads sample rate, bit depth, channels, length and the common tags
+ * straight from the container headers, never touching audio data:
+ *   WAV   fmt / data chunks, LIST INFO and id3 chunks
+ *   FLAC  STREAMINFO and VORBIS_COMMENT blocks
+ *   DSF   DSD / fmt chunks and the trailing ID3v2 tag
+ *   MP3   ID3v2 (v2.2-v2.4) or ID3v1, first frame header, Xing/Info/VBRI
+ *         frame counts and the LAME encoder delay/padding
+ *   MP4   moov/trak sample entry (AAC, ALAC, FLAC), mdhd, ilst tags
+ *
+ * Everything goes through a FileReader with a METADATA_READ_BYTES
+ * buffer, so a typical file costs one or two small reads; large blocks
+ * (cover art, mdat) are skipped with a seek. Files are independent, so
+ * a batch spreads them over a few worker threads.
+ */
+
+#ifndef FTL_TRACK_METADATA_H
+#define FTL_TRACK_METADATA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+constexpr size_t METADATA_READ_BYTES = 16 * 1024;
+constexpr int MAX_METADATA_THREADS = 8;
+
+struct TrackMetadata {
+    std::string path;
+    bool parsed = false;            // False if missing or not a container we read
+    std::string codec;              // "wav", "flac", "dsf", "mp3", "aac", "alac"
+    int sampleRate = 0;
+    int channelCount = 0;
+    int bitsPerSample = 0;          // 0 for lossy codecs, 1 for DSD
+    int64_t totalFrames = -1;       // -1 when the headers do not say
+    int bitRate = 0;                // Average over the file, bits per second
+    std::string title;              // Tags, UTF-8; empty / 0 when absent
+    std::string artist;
+    std::string album;
+    int year = 0;
+    int trackNumber = 0;
+    uint64_t bytesRead = 0;         // Bytes fetched from storage for this file
+
+    double durationSeconds() const {
+        return sampleRate > 0 && totalFrames > 0 ? static_cast<double>(totalFrames) / sampleRate : 0.0;
+    }
+};
+
+/**
+ * Parse one file's headers
+ * @return metadata.parsed
+ */
+bool readTrackMetadata(const std::string& path, TrackMetadata& metadata);
+
+struct MetadataBatchStats {
+    int parsed = 0;
+    int failed = 0;              // Missing, unreadable or unsupported
+    double seconds = 0.0;        // Wall time
+    uint64_t bytesRead = 0;
+
+    double filesPerSecond() const { return seconds > 0.0 ? (parsed + failed) / seconds : 0.0; }
+};
+
+/**
+ * Parse a library scan's files on `threads` workers (0 = one per core, at
+ * most MAX_METADATA_THREADS). Blocking: call from a background thread.
+ * @param cancel Optional flag polled between files; entries not reached stay unparsed
+ * @return One entry per path, in input order
+ */
+std::vector<TrackMetadata> readTrackMetadataBatch(const std::vector<std::string>& paths, int threads = 0,
+                                                  MetadataBatchStats* stats = nullptr,
+                                                  const std::atomic<bool>* cancel = nullptr);
+
+} // namespace ftl_audio
+
+#endif // FTL_TRACK_METADATA_H
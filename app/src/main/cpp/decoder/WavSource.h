@@ -0,0 +1,47 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 WAV SOURCE - PCM DECODER                    ║
+ * ║      RIFF/WAVE PCM & IEEE Float, Byte-Offset Seeking        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ */
+
+#ifndef FTL_WAV_SOURCE_H
+#define FTL_WAV_SOURCE_H
+
+#include <vector>
+
+#include "AudioSource.h"
+
+namespace ftl_audio {
+
+class WavSource : public AudioSource {
+public:
+    explicit WavSource(size_t readBufferBytes = FileReader::DEFAULT_BUFFER_SIZE) : m_reader(readBufferBytes) {}
+
+    bool open(const std::string& path);
+
+    const AudioSourceInfo& info() const override { return m_info; }
+    int32_t read(float* out, int32_t numFrames) override;
+    bool seekToFrame(int64_t frame) override;
+    int64_t positionFrames() const override { return m_position; }
+    const IoStats& ioStats() const override { return m_reader.stats(); }
+
+private:
+    enum class SampleEncoding { U8, S16, S24, S32, F32, F64 };
+
+    bool parseHeader();
+
+    FileReader m_reader;
+    AudioSourceInfo m_info;
+    SampleEncoding m_encoding = SampleEncoding::S16;
+    int m_blockAlign = 0;          // Bytes per frame
+    int64_t m_dataOffset = 0;      // First byte of the data chunk
+    int64_t m_position = 0;
+    std::vector<uint8_t> m_scratch;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_WAV_SOURCE_H
@@ -0,0 +1,151 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 WAV WRITER - RENDER OUTPUT                  ║
+ * ║       Streaming RIFF/WAVE Output for Offline Renders        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "WavWriter.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#define LOG_TAG "FTL_WavWriter"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr long HEADER_BYTES = 44;
+constexpr size_t FILE_BUFFER_BYTES = 1 << 16;
+
+void putLE16(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void putLE32(uint8_t* p, uint32_t v) {
+    putLE16(p, v);
+    putLE16(p + 2, v >> 16);
+}
+
+int bytesPerSample(WavSampleFormat format) {
+    switch (format) {
+        case WavSampleFormat::PCM_16: return 2;
+        case WavSampleFormat::PCM_24: return 3;
+        case WavSampleFormat::FLOAT_32: return 4;
+    }
+    return 4;
+}
+
+int32_t quantize(float sample, float scale) {
+    float clamped = std::max(-1.0f, std::min(sample, 1.0f));
+    return static_cast<int32_t>(std::lround(std::min(clamped * scale, scale - 1.0f)));
+}
+
+} // namespace
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::open(const std::string& path, int sampleRate, int channelCount, WavSampleFormat format) {
+    close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        LOGE("Cannot create %s", path.c_str());
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, FILE_BUFFER_BYTES);
+    m_channelCount = channelCount;
+    m_format = format;
+    m_framesWritten = 0;
+    m_failed = false;
+
+    // Sizes stay zero until close()
+    int sampleBytes = bytesPerSample(format);
+    uint8_t header[HEADER_BYTES] = {};
+    std::memcpy(header, "RIFF", 4);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    putLE32(header + 16, 16);
+    putLE16(header + 20, format == WavSampleFormat::FLOAT_32 ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM);
+    putLE16(header + 22, static_cast<uint32_t>(channelCount));
+    putLE32(header + 24, static_cast<uint32_t>(sampleRate));
+    putLE32(header + 28, static_cast<uint32_t>(sampleRate * channelCount * sampleBytes));
+    putLE16(header + 32, static_cast<uint32_t>(channelCount * sampleBytes));
+    putLE16(header + 34, static_cast<uint32_t>(sampleBytes * 8));
+    std::memcpy(header + 36, "data", 4);
+    m_failed = std::fwrite(header, 1, HEADER_BYTES, m_file) != HEADER_BYTES;
+    return !m_failed;
+}
+
+float WavWriter::nextDither() {
+    // xorshift32, uniform in [-0.5, 0.5) LSB
+    m_ditherState ^= m_ditherState << 13;
+    m_ditherState ^= m_ditherState >> 17;
+    m_ditherState ^= m_ditherState << 5;
+    return static_cast<float>(m_ditherState) * (1.0f / 4294967296.0f) - 0.5f;
+}
+
+bool WavWriter::write(const float* frames, int32_t numFrames) {
+    if (!m_file || m_failed) {
+        return false;
+    }
+    size_t samples = static_cast<size_t>(numFrames) * m_channelCount;
+
+    if (m_format == WavSampleFormat::FLOAT_32) {
+        // Little-endian hosts only, as everywhere else in the engine
+        m_failed = std::fwrite(frames, sizeof(float), samples, m_file) != samples;
+    } else {
+        int sampleBytes = bytesPerSample(m_format);
+        m_scratch.resize(samples * sampleBytes);
+        uint8_t* out = m_scratch.data();
+        if (m_format == WavSampleFormat::PCM_16) {
+            // TPDF dither: the sum of two uniform LSB-wide variables
+            constexpr float SCALE = 32768.0f;
+            for (size_t i = 0; i < samples; ++i) {
+                float dither = (nextDither() + nextDither()) / SCALE;
+                putLE16(out + i * 2, static_cast<uint32_t>(quantize(frames[i] + dither, SCALE)));
+            }
+        } else {
+            constexpr float SCALE = 8388608.0f;
+            for (size_t i = 0; i < samples; ++i) {
+                uint32_t value = static_cast<uint32_t>(quantize(frames[i], SCALE));
+                out[i * 3] = static_cast<uint8_t>(value);
+                out[i * 3 + 1] = static_cast<uint8_t>(value >> 8);
+                out[i * 3 + 2] = static_cast<uint8_t>(value >> 16);
+            }
+        }
+        m_failed = std::fwrite(out, 1, m_scratch.size(), m_file) != m_scratch.size();
+    }
+    if (!m_failed) {
+        m_framesWritten += numFrames;
+    }
+    return !m_failed;
+}
+
+bool WavWriter::close() {
+    if (!m_file) {
+        return false;
+    }
+    uint64_t dataBytes = static_cast<uint64_t>(m_framesWritten) * m_channelCount * bytesPerSample(m_format);
+    if (dataBytes > 0xFFFFFFFFull - HEADER_BYTES) {
+        LOGE("Render exceeds the 4 GB RIFF limit");
+        m_failed = true;
+    }
+    uint8_t size[4];
+    putLE32(size, static_cast<uint32_t>(dataBytes + HEADER_BYTES - 8));
+    bool ok = !m_failed && std::fseek(m_file, 4, SEEK_SET) == 0 && std::fwrite(size, 1, 4, m_file) == 4;
+    putLE32(size, static_cast<uint32_t>(dataBytes));
+    ok = ok && std::fseek(m_file, 40, SEEK_SET) == 0 && std::fwrite(size, 1, 4, m_file) == 4;
+    ok = std::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    return ok;
+}
+
+} // namespace ftl_audio
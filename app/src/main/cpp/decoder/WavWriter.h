@@ -0,0 +1,60 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 WAV WRITER - RENDER OUTPUT                  ║
+ * ║       Streaming RIFF/WAVE Output for Offline Renders        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Writes interleaved float frames as 16-bit (TPDF dithered), 24-bit or
+ * 32-bit float PCM. Sizes are patched into the header on close(), so a
+ * file is only valid once close() has returned true.
+ */
+
+#ifndef FTL_WAV_WRITER_H
+#define FTL_WAV_WRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+enum class WavSampleFormat {
+    PCM_16,
+    PCM_24,
+    FLOAT_32
+};
+
+class WavWriter {
+public:
+    WavWriter() = default;
+    ~WavWriter();
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    bool open(const std::string& path, int sampleRate, int channelCount, WavSampleFormat format);
+    bool write(const float* frames, int32_t numFrames);
+
+    /** Patch the header sizes and close; false if any write failed */
+    bool close();
+
+    int64_t framesWritten() const { return m_framesWritten; }
+
+private:
+    std::FILE* m_file = nullptr;
+    int m_channelCount = 0;
+    WavSampleFormat m_format = WavSampleFormat::FLOAT_32;
+    int64_t m_framesWritten = 0;
+    bool m_failed = false;
+    uint32_t m_ditherState = 0x2545F491u;
+    std::vector<uint8_t> m_scratch;
+
+    float nextDither();
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_WAV_WRITER_H
@@ -0,0 +1,447 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            WAVEFORM PYRAMID - PEAK OVERVIEW SIDECAR         ║
+ * ║     Multi-Resolution Min/Max/RMS for Seek Bar & Visuals     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * The decode pass only reduces 20 ms bins; every coarser level is merged
+ * from the one below in full precision and quantized once at the end.
+ */
+
+#include "WaveformPyramid.h"
+#include "AudioSource.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define FTL_WAVE_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_WAVE_SSE 1
+#endif
+
+#define LOG_TAG "FTL_Waveform"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr char WAVEFORM_MAGIC[8] = {'F', 'T', 'L', 'W', 'A', 'V', 'E', '\0'};
+
+// Base bins decoded per read
+constexpr int64_t DECODE_CHUNK_BINS = 16;
+
+WaveformBin quantize(const PeakAccumulator& acc) {
+    WaveformBin bin = {0, 0, 0};
+    if (acc.samples == 0) {
+        return bin;
+    }
+    double rms = std::sqrt(acc.sumSquares / static_cast<double>(acc.samples));
+    bin.min = static_cast<int8_t>(std::max(-127.0, std::min(127.0, std::floor(acc.min * 127.0))));
+    bin.max = static_cast<int8_t>(std::max(-127.0, std::min(127.0, std::ceil(acc.max * 127.0))));
+    bin.rms = static_cast<uint8_t>(std::min(255.0, std::round(rms * 255.0)));
+    return bin;
+}
+
+void merge(PeakAccumulator& into, const PeakAccumulator& from) {
+    if (from.samples == 0) {
+        return;
+    }
+    if (into.samples == 0) {
+        into = from;
+        return;
+    }
+    into.min = std::min(into.min, from.min);
+    into.max = std::max(into.max, from.max);
+    into.sumSquares += from.sumSquares;
+    into.samples += from.samples;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// PEAK KERNEL
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void accumulatePeaks(const float* samples, size_t count, PeakAccumulator& acc) {
+    if (count == 0) {
+        return;
+    }
+    if (acc.samples == 0) {
+        acc.min = samples[0];
+        acc.max = samples[0];
+    }
+
+    float minimum = acc.min;
+    float maximum = acc.max;
+    size_t i = 0;
+#if defined(FTL_WAVE_NEON)
+    if (count >= 4) {
+        float32x4_t low = vdupq_n_f32(minimum);
+        float32x4_t high = vdupq_n_f32(maximum);
+        float32x4_t energy = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t x = vld1q_f32(samples + i);
+            low = vminq_f32(low, x);
+            high = vmaxq_f32(high, x);
+            energy = vfmaq_f32(energy, x, x);
+        }
+        minimum = vminvq_f32(low);
+        maximum = vmaxvq_f32(high);
+        acc.sumSquares += vaddvq_f32(energy);
+    }
+#elif defined(FTL_WAVE_SSE)
+    if (count >= 4) {
+        __m128 low = _mm_set1_ps(minimum);
+        __m128 high = _mm_set1_ps(maximum);
+        __m128 energy = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_loadu_ps(samples + i);
+            low = _mm_min_ps(low, x);
+            high = _mm_max_ps(high, x);
+            energy = _mm_add_ps(energy, _mm_mul_ps(x, x));
+        }
+        float lows[4], highs[4], energies[4];
+        _mm_storeu_ps(lows, low);
+        _mm_storeu_ps(highs, high);
+        _mm_storeu_ps(energies, energy);
+        for (int k = 0; k < 4; ++k) {
+            minimum = std::min(minimum, lows[k]);
+            maximum = std::max(maximum, highs[k]);
+        }
+        acc.sumSquares += static_cast<double>(energies[0]) + energies[1] + energies[2] + energies[3];
+    }
+#endif
+    double tail = 0.0;
+    for (; i < count; ++i) {
+        float x = samples[i];
+        minimum = std::min(minimum, x);
+        maximum = std::max(maximum, x);
+        tail += static_cast<double>(x) * x;
+    }
+    acc.min = minimum;
+    acc.max = maximum;
+    acc.sumSquares += tail;
+    acc.samples += static_cast<int64_t>(count);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SIDECAR FILE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+WaveformPyramid::~WaveformPyramid() {
+    unmap();
+}
+
+std::string WaveformPyramid::sidecarPath(const std::string& cacheDirectory, const std::string& sourcePath) {
+    return sidecarFileFor(cacheDirectory, sourcePath, ".ftlwave");
+}
+
+bool WaveformPyramid::write(const std::string& path, const WaveformHeader& header,
+                            const std::vector<WaveformLevel>& levels, const std::vector<WaveformBin>& bins) {
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOGE("Cannot create %s", tempPath.c_str());
+        return false;
+    }
+
+    WaveformHeader out = header;
+    std::memcpy(out.magic, WAVEFORM_MAGIC, sizeof(out.magic));
+    out.version = WAVEFORM_VERSION;
+    out.levelCount = static_cast<uint32_t>(levels.size());
+
+    bool ok = std::fwrite(&out, sizeof(out), 1, file) == 1 &&
+              std::fwrite(levels.data(), sizeof(WaveformLevel), levels.size(), file) == levels.size() &&
+              std::fwrite(bins.data(), sizeof(WaveformBin), bins.size(), file) == bins.size();
+    ok = (std::fclose(file) == 0) && ok;
+
+    // Readers only ever see a complete sidecar
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        LOGE("Failed to write %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool WaveformPyramid::map(const std::string& path, const SourceStamp& stamp) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(WaveformHeader))) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const auto* header = static_cast<const WaveformHeader*>(mapping);
+    bool valid = std::memcmp(header->magic, WAVEFORM_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == WAVEFORM_VERSION &&
+                 header->levelCount >= 1 && header->levelCount <= MAX_LEVELS &&
+                 header->sourceSize == stamp.size &&
+                 header->sourceMtimeNs == stamp.mtimeNs &&
+                 sizeof(WaveformHeader) + header->levelCount * sizeof(WaveformLevel) <= length;
+
+    // Levels are laid out back to back and end exactly at the end of the file
+    const auto* levels = reinterpret_cast<const WaveformLevel*>(static_cast<const uint8_t*>(mapping) +
+                                                                sizeof(WaveformHeader));
+    uint64_t expected = sizeof(WaveformHeader) + static_cast<uint64_t>(header->levelCount) * sizeof(WaveformLevel);
+    for (uint32_t i = 0; valid && i < header->levelCount; ++i) {
+        valid = levels[i].framesPerBin > 0 && levels[i].binCount > 0 && levels[i].byteOffset == expected;
+        expected += static_cast<uint64_t>(levels[i].binCount) * sizeof(WaveformBin);
+    }
+    if (!valid || expected != length) {
+        munmap(mapping, length);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mappedBytes = length;
+    m_header = header;
+    m_levels = levels;
+    return true;
+}
+
+void WaveformPyramid::unmap() {
+    if (m_mapping) {
+        munmap(m_mapping, m_mappedBytes);
+    }
+    m_mapping = nullptr;
+    m_mappedBytes = 0;
+    m_header = nullptr;
+    m_levels = nullptr;
+}
+
+const WaveformBin* WaveformPyramid::bins(int index) const {
+    return reinterpret_cast<const WaveformBin*>(static_cast<const uint8_t*>(m_mapping) + m_levels[index].byteOffset);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// RENDERING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int WaveformPyramid::levelFor(double framesPerColumn) const {
+    int best = 0;
+    for (int i = 1; i < levelCount(); ++i) {
+        if (m_levels[i].framesPerBin <= framesPerColumn) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+int WaveformPyramid::render(int64_t startFrame, int64_t endFrame, int columns, WaveformBin* out) const {
+    if (!m_header || columns <= 0) {
+        return 0;
+    }
+    startFrame = std::max<int64_t>(0, startFrame);
+    endFrame = std::min(endFrame, m_header->totalFrames);
+    if (endFrame <= startFrame) {
+        return 0;
+    }
+
+    const int64_t span = endFrame - startFrame;
+    const int index = levelFor(static_cast<double>(span) / columns);
+    const WaveformLevel& level = m_levels[index];
+    const WaveformBin* source = bins(index);
+    const int64_t lastBin = static_cast<int64_t>(level.binCount) - 1;
+
+    for (int column = 0; column < columns; ++column) {
+        int64_t from = startFrame + span * column / columns;
+        int64_t to = std::max(from + 1, startFrame + span * (column + 1) / columns);
+        int64_t first = std::min(lastBin, from / level.framesPerBin);
+        int64_t last = std::max(first, std::min(lastBin, (to - 1) / level.framesPerBin));
+
+        int minimum = 127;
+        int maximum = -127;
+        double energy = 0.0;
+        for (int64_t b = first; b <= last; ++b) {
+            minimum = std::min<int>(minimum, source[b].min);
+            maximum = std::max<int>(maximum, source[b].max);
+            energy += static_cast<double>(source[b].rms) * source[b].rms;
+        }
+        out[column].min = static_cast<int8_t>(minimum);
+        out[column].max = static_cast<int8_t>(maximum);
+        out[column].rms = static_cast<uint8_t>(std::round(std::sqrt(energy / static_cast<double>(last - first + 1))));
+    }
+    return columns;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// PYRAMID BUILDER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool buildWaveform(const std::string& sourcePath, const std::string& sidecarPath,
+                   WaveformBuildStats* stats, const std::atomic<bool>* cancel) {
+    auto started = std::chrono::steady_clock::now();
+
+    SourceStamp stamp;
+    if (!SourceStamp::of(sourcePath, stamp)) {
+        return false;
+    }
+
+    std::unique_ptr<AudioSource> source = openAudioSource(sourcePath);
+    if (!source) {
+        return false;
+    }
+
+    const AudioSourceInfo& info = source->info();
+    const int channelCount = info.channelCount;
+    const int64_t framesPerBin = std::max<int64_t>(1, static_cast<int64_t>(info.sampleRate) *
+                                                      WaveformPyramid::BASE_BIN_MS / 1000);
+    const int32_t chunkFrames = static_cast<int32_t>(framesPerBin * DECODE_CHUNK_BINS);
+    std::vector<float> buffer(static_cast<size_t>(chunkFrames) * channelCount);
+
+    // Level 0: one accumulator per 20 ms, all channels folded together
+    std::vector<PeakAccumulator> base;
+    if (info.totalFrames > 0) {
+        base.reserve(static_cast<size_t>((info.totalFrames + framesPerBin - 1) / framesPerBin));
+    }
+    PeakAccumulator bin;
+    int64_t framesInBin = 0;
+    int64_t totalFrames = 0;
+    while (true) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        int32_t got = source->read(buffer.data(), chunkFrames);
+        if (got < 0) {
+            LOGE("Decode error in %s", sourcePath.c_str());
+            return false;
+        }
+        if (got == 0) {
+            break;
+        }
+        // Reads may stop short of a bin boundary (codec blocks): carry the open bin
+        int64_t offset = 0;
+        while (offset < got) {
+            int64_t take = std::min<int64_t>(got - offset, framesPerBin - framesInBin);
+            accumulatePeaks(buffer.data() + offset * channelCount, static_cast<size_t>(take * channelCount), bin);
+            framesInBin += take;
+            offset += take;
+            if (framesInBin == framesPerBin) {
+                base.push_back(bin);
+                bin = PeakAccumulator();
+                framesInBin = 0;
+            }
+        }
+        totalFrames += got;
+    }
+    if (framesInBin > 0) {
+        base.push_back(bin);
+    }
+    if (base.empty()) {
+        return false;
+    }
+
+    // Coarser levels merge groups of LEVEL_FACTOR bins until one fits a seek bar
+    std::vector<std::vector<PeakAccumulator>> accumulated;
+    accumulated.push_back(std::move(base));
+    while (static_cast<int>(accumulated.size()) < WaveformPyramid::MAX_LEVELS &&
+           accumulated.back().size() > WaveformPyramid::COARSEST_BINS) {
+        const std::vector<PeakAccumulator>& finer = accumulated.back();
+        std::vector<PeakAccumulator> coarser((finer.size() + WaveformPyramid::LEVEL_FACTOR - 1) /
+                                             WaveformPyramid::LEVEL_FACTOR);
+        for (size_t i = 0; i < finer.size(); ++i) {
+            merge(coarser[i / WaveformPyramid::LEVEL_FACTOR], finer[i]);
+        }
+        accumulated.push_back(std::move(coarser));
+    }
+
+    std::vector<WaveformLevel> levels;
+    std::vector<WaveformBin> bins;
+    uint64_t offset = sizeof(WaveformHeader) + accumulated.size() * sizeof(WaveformLevel);
+    uint64_t binFrames = static_cast<uint64_t>(framesPerBin);
+    for (const std::vector<PeakAccumulator>& level : accumulated) {
+        levels.push_back({static_cast<uint32_t>(binFrames), static_cast<uint32_t>(level.size()), offset});
+        for (const PeakAccumulator& acc : level) {
+            bins.push_back(quantize(acc));
+        }
+        offset += level.size() * sizeof(WaveformBin);
+        binFrames *= WaveformPyramid::LEVEL_FACTOR;
+    }
+
+    WaveformHeader header = {};
+    header.sourceSize = stamp.size;
+    header.sourceMtimeNs = stamp.mtimeNs;
+    header.totalFrames = totalFrames;
+    header.sampleRate = static_cast<uint32_t>(info.sampleRate);
+    header.channelCount = static_cast<uint32_t>(channelCount);
+
+    if (!WaveformPyramid::write(sidecarPath, header, levels, bins)) {
+        return false;
+    }
+
+    WaveformBuildStats built;
+    built.audioSeconds = static_cast<double>(totalFrames) / info.sampleRate;
+    built.buildSeconds = secondsSince(started);
+    built.bytes = offset;
+    if (stats) {
+        *stats = built;
+    }
+    LOGI("Waveform: %zu levels, %llu bytes, %.0fx realtime -> %s", levels.size(),
+         static_cast<unsigned long long>(built.bytes), built.realtimeFactor(), sidecarPath.c_str());
+    return true;
+}
+
+WaveformBatchStats buildWaveforms(const std::vector<std::string>& sourcePaths,
+                                  const std::string& cacheDirectory,
+                                  const std::atomic<bool>* cancel) {
+    WaveformBatchStats batch;
+    for (const std::string& path : sourcePaths) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        std::string sidecar = WaveformPyramid::sidecarPath(cacheDirectory, path);
+        SourceStamp stamp;
+        WaveformPyramid existing;
+        if (SourceStamp::of(path, stamp) && existing.map(sidecar, stamp)) {
+            ++batch.skipped;
+            continue;
+        }
+
+        WaveformBuildStats stats;
+        if (buildWaveform(path, sidecar, &stats, cancel)) {
+            ++batch.built;
+            batch.audioSeconds += stats.audioSeconds;
+            batch.buildSeconds += stats.buildSeconds;
+            batch.bytes += stats.bytes;
+        } else if (!(cancel && cancel->load(std::memory_order_relaxed))) {
+            ++batch.failed;
+        }
+    }
+    LOGI("Waveform batch: %d built, %d fresh, %d failed, %.0fx realtime, %.0f bytes/track",
+         batch.built, batch.skipped, batch.failed, batch.realtimeFactor(), batch.bytesPerTrack());
+    return batch;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,169 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            WAVEFORM PYRAMID - PEAK OVERVIEW SIDECAR         ║
+ * ║     Multi-Resolution Min/Max/RMS for Seek Bar & Visuals     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Sidecar layout (native endian, written once, mapped read-only):
+ *   WaveformHeader (64 bytes)
+ *   WaveformLevel  levels[levelCount]      level 0 finest, each next 4x coarser
+ *   WaveformBin    bins[...]               every level's bins, level order
+ *
+ * Level 0 bins cover 20 ms of the track (all channels folded together);
+ * levels are added until one fits in a seek bar. A track is decoded once
+ * and every zoom renders from the mapped file by reading at most a few
+ * bins per pixel column. Sidecars are keyed to the source's size and
+ * mtime like seek indexes (SeekIndex.h); a stale one is ignored and rebuilt.
+ */
+
+#ifndef FTL_WAVEFORM_PYRAMID_H
+#define FTL_WAVEFORM_PYRAMID_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SeekIndex.h"
+
+namespace ftl_audio {
+
+constexpr uint32_t WAVEFORM_VERSION = 1;
+
+struct WaveformHeader {
+    char magic[8];               // "FTLWAVE"
+    uint32_t version;
+    uint32_t levelCount;
+    uint64_t sourceSize;
+    int64_t sourceMtimeNs;
+    int64_t totalFrames;
+    uint32_t sampleRate;
+    uint32_t channelCount;
+    uint64_t reserved[2];
+};
+
+static_assert(sizeof(WaveformHeader) == 64, "Sidecar header is 64 bytes");
+
+struct WaveformLevel {
+    uint32_t framesPerBin;
+    uint32_t binCount;
+    uint64_t byteOffset;         // From the start of the file
+};
+
+static_assert(sizeof(WaveformLevel) == 16, "Level table entries are 16 bytes");
+
+/**
+ * One bin: peaks as signed 1/127 steps (rounded outward, a clip still
+ * reads full scale) and RMS in 1/255 steps
+ */
+struct WaveformBin {
+    int8_t min;
+    int8_t max;
+    uint8_t rms;
+};
+
+static_assert(sizeof(WaveformBin) == 3, "Bins are packed");
+
+/**
+ * Running min/max/energy of a span of samples
+ */
+struct PeakAccumulator {
+    float min = 0.0f;
+    float max = 0.0f;
+    double sumSquares = 0.0;
+    int64_t samples = 0;
+};
+
+/** Fold `count` samples into `acc` (NEON on ARM, SSE on x86) */
+void accumulatePeaks(const float* samples, size_t count, PeakAccumulator& acc);
+
+class WaveformPyramid {
+public:
+    static constexpr int BASE_BIN_MS = 20;
+    static constexpr uint32_t LEVEL_FACTOR = 4;
+    static constexpr int MAX_LEVELS = 8;
+    // Levels stop once one has at most this many bins
+    static constexpr uint32_t COARSEST_BINS = 128;
+
+    WaveformPyramid() = default;
+    ~WaveformPyramid();
+
+    /** Sidecar file name for `sourcePath` inside `cacheDirectory` */
+    static std::string sidecarPath(const std::string& cacheDirectory, const std::string& sourcePath);
+
+    /** Write a sidecar atomically (temp file + rename) */
+    static bool write(const std::string& path, const WaveformHeader& header,
+                      const std::vector<WaveformLevel>& levels, const std::vector<WaveformBin>& bins);
+
+    /** Map a sidecar; fails if missing, corrupt or not built from `stamp` */
+    bool map(const std::string& path, const SourceStamp& stamp);
+    void unmap();
+    bool isMapped() const { return m_header != nullptr; }
+
+    const WaveformHeader& header() const { return *m_header; }
+    int levelCount() const { return m_header ? static_cast<int>(m_header->levelCount) : 0; }
+    const WaveformLevel& level(int index) const { return m_levels[index]; }
+    const WaveformBin* bins(int index) const;
+    size_t mappedBytes() const { return m_mappedBytes; }
+
+    /** Coarsest level whose bins are no wider than `framesPerColumn` */
+    int levelFor(double framesPerColumn) const;
+
+    /**
+     * One bin per column over [startFrame, endFrame), from the level that
+     * fits the zoom: min of mins, max of maxes, RMS of the bins' RMS.
+     * @return Columns written (0 if not mapped or the range is empty)
+     */
+    int render(int64_t startFrame, int64_t endFrame, int columns, WaveformBin* out) const;
+
+private:
+    void* m_mapping = nullptr;
+    size_t m_mappedBytes = 0;
+    const WaveformHeader* m_header = nullptr;
+    const WaveformLevel* m_levels = nullptr;
+
+    WaveformPyramid(const WaveformPyramid&) = delete;
+    WaveformPyramid& operator=(const WaveformPyramid&) = delete;
+};
+
+struct WaveformBuildStats {
+    double audioSeconds = 0.0;   // Track duration decoded
+    double buildSeconds = 0.0;   // Wall time
+    uint64_t bytes = 0;          // Sidecar size
+
+    double realtimeFactor() const { return buildSeconds > 0.0 ? audioSeconds / buildSeconds : 0.0; }
+};
+
+/**
+ * Decode `sourcePath` once and write its pyramid (library scan or first view)
+ * @param cancel Optional flag polled between decode chunks
+ */
+bool buildWaveform(const std::string& sourcePath, const std::string& sidecarPath,
+                   WaveformBuildStats* stats = nullptr, const std::atomic<bool>* cancel = nullptr);
+
+struct WaveformBatchStats {
+    int built = 0;
+    int skipped = 0;             // Sidecar already fresh
+    int failed = 0;
+    double audioSeconds = 0.0;
+    double buildSeconds = 0.0;
+    uint64_t bytes = 0;
+
+    double realtimeFactor() const { return buildSeconds > 0.0 ? audioSeconds / buildSeconds : 0.0; }
+    double bytesPerTrack() const { return built > 0 ? static_cast<double>(bytes) / built : 0.0; }
+};
+
+/**
+ * Build the sidecars of a library scan into `cacheDirectory`, skipping
+ * tracks whose sidecar is still fresh. Blocking: call from a background thread.
+ */
+WaveformBatchStats buildWaveforms(const std::vector<std::string>& sourcePaths,
+                                  const std::string& cacheDirectory,
+                                  const std::atomic<bool>* cancel = nullptr);
+
+} // namespace ftl_audio
+
+#endif // FTL_WAVEFORM_PYRAMID_H
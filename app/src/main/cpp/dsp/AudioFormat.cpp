@@ -1,8 +1,81 @@
 /**
  * ╔══════════════════════════════════════════════════════════════╗
- * ║                   AUDIO FORMAT - STUB                       ║
- * ║              Placeholder for future implementation          ║
+ * ║                AUDIO FORMAT - PCM CONVERSION                ║
+ * ║           Integer/Float Sample Conversion Kernels           ║
  * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Plain loops written so the compiler can vectorize them under -O3.
  */
 
-// Stub implementation - will be implemented in future iterations
\ No newline at end of file
+#include "AudioFormat.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace ftl_audio {
+namespace pcm {
+
+void u8ToFloat(const uint8_t* src, float* dst, size_t count) {
+    constexpr float scale = 1.0f / 128.0f;
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = (static_cast<int>(src[i]) - 128) * scale;
+    }
+}
+
+void s16ToFloat(const uint8_t* src, float* dst, size_t count) {
+    constexpr float scale = 1.0f / 32768.0f;
+    for (size_t i = 0; i < count; ++i) {
+        int16_t value = static_cast<int16_t>(src[2 * i] | (src[2 * i + 1] << 8));
+        dst[i] = value * scale;
+    }
+}
+
+void s24ToFloat(const uint8_t* src, float* dst, size_t count) {
+    constexpr float scale = 1.0f / 8388608.0f;
+    for (size_t i = 0; i < count; ++i) {
+        // Assemble in the top 24 bits, arithmetic shift sign-extends
+        int32_t value = static_cast<int32_t>((static_cast<uint32_t>(src[3 * i]) << 8) |
+                                             (static_cast<uint32_t>(src[3 * i + 1]) << 16) |
+                                             (static_cast<uint32_t>(src[3 * i + 2]) << 24)) >> 8;
+        dst[i] = value * scale;
+    }
+}
+
+void s32ToFloat(const uint8_t* src, float* dst, size_t count) {
+    constexpr float scale = 1.0f / 2147483648.0f;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t value;
+        std::memcpy(&value, src + 4 * i, sizeof(value));
+        dst[i] = value * scale;
+    }
+}
+
+void f32ToFloat(const uint8_t* src, float* dst, size_t count) {
+    std::memcpy(dst, src, count * sizeof(float));
+}
+
+void f64ToFloat(const uint8_t* src, float* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double value;
+        std::memcpy(&value, src + 8 * i, sizeof(value));
+        dst[i] = static_cast<float>(value);
+    }
+}
+
+void int32ToFloat(const int32_t* src, float* dst, size_t count, int bitsPerSample) {
+    const float scale = 1.0f / static_cast<float>(1u << (bitsPerSample - 1));
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+void floatToS16(const float* src, int16_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float value = src[i] * 32768.0f;
+        value = value < -32768.0f ? -32768.0f : (value > 32767.0f ? 32767.0f : value);
+        dst[i] = static_cast<int16_t>(std::lrintf(value));
+    }
+}
+
+} // namespace pcm
+} // namespace ftl_audio
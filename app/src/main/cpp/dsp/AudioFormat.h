@@ -0,0 +1,42 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                AUDIO FORMAT - PCM CONVERSION                ║
+ * ║           Integer/Float Sample Conversion Kernels           ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * All kernels convert `count` samples (not frames) from little-endian
+ * packed source data to normalized float in [-1, 1), except floatToS16
+ * which goes the other way for devices without a float output.
+ */
+
+#ifndef FTL_DSP_AUDIO_FORMAT_H
+#define FTL_DSP_AUDIO_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ftl_audio {
+namespace pcm {
+
+void u8ToFloat(const uint8_t* src, float* dst, size_t count);
+void s16ToFloat(const uint8_t* src, float* dst, size_t count);
+void s24ToFloat(const uint8_t* src, float* dst, size_t count);
+void s32ToFloat(const uint8_t* src, float* dst, size_t count);
+void f32ToFloat(const uint8_t* src, float* dst, size_t count);
+void f64ToFloat(const uint8_t* src, float* dst, size_t count);
+
+/**
+ * Decoded integer samples (right-justified, `bitsPerSample` significant
+ * bits) to float, as produced by lossless decoders
+ */
+void int32ToFloat(const int32_t* src, float* dst, size_t count, int bitsPerSample);
+
+/** Float to 16-bit for a PCM_I16 output stream: rounded and clipped, no dither */
+void floatToS16(const float* src, int16_t* dst, size_t count);
+
+} // namespace pcm
+} // namespace ftl_audio
+
+#endif // FTL_DSP_AUDIO_FORMAT_H
@@ -0,0 +1,74 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          BINAURAL RENDERER - VIRTUAL SPEAKERS ON HEADPHONES ║
+ * ║      Spherical-Head HRIRs for 7.1 → 2 and Stereo Crossfeed  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Every source channel is placed as a virtual speaker at its nominal
+ * azimuth (ITU-R BS.775 / BS.2051) and reaches each ear through the
+ * Brown-Duda spherical-head model: an interaural delay (Woodworth) and a
+ * one-pole/one-zero head-shadow shelf. A stereo source on ±30° speakers
+ * is a natural crossfeed. The response is minimum-phase past the delay,
+ * so no FIR is needed: each (channel, ear) pair is a lane of a SIMD
+ * vector and a frame costs one gather plus one vector IIR step per four
+ * lanes. The renderer is specialized at compile time per channel count.
+ */
+
+#ifndef FTL_DSP_BINAURAL_RENDERER_H
+#define FTL_DSP_BINAURAL_RENDERER_H
+
+#include <cstdint>
+
+namespace ftl_audio {
+
+class BinauralRenderer {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr float HEAD_RADIUS_M = 0.0875f;
+    static constexpr float SPEED_OF_SOUND_MS = 343.0f;
+    static constexpr float SPEAKER_GAIN = 0.5f;             // Per ear; near-ear treble lifts back to ~unity
+
+    /** Speaker positions for `inputChannels` (WAVE order); not on the audio thread */
+    void configure(int sampleRate, int inputChannels);
+    void reset();
+
+    int inputChannels() const { return m_inputChannels; }
+
+    /** Render interleaved `inputChannels` frames to interleaved stereo; dst must not alias src */
+    void process(const float* src, float* dst, int32_t frames);
+
+    /** Virtual speaker azimuth in degrees (0 = front, +90 = right); false for LFE */
+    static bool speakerAzimuth(int inputChannels, int channel, float& degrees);
+
+private:
+    static constexpr int LANES = MAX_CHANNELS * 2;          // Lane 2c: left ear of channel c, 2c + 1: right ear
+    static constexpr int HISTORY_FRAMES = 256;              // > longest interaural delay at 384 kHz
+    static constexpr int HISTORY_MASK = HISTORY_FRAMES - 1;
+
+    using Kernel = void (BinauralRenderer::*)(const float* src, float* dst, int32_t frames);
+
+    int m_inputChannels = 0;
+    Kernel m_kernel = nullptr;
+
+    // Head-shadow shelf per lane: y = b0 x + b1 x1 - a1 y1 (speaker gain folded into b)
+    alignas(16) float m_b0[LANES] = {};
+    alignas(16) float m_b1[LANES] = {};
+    alignas(16) float m_a1[LANES] = {};
+    alignas(16) float m_x1[LANES] = {};
+    alignas(16) float m_y1[LANES] = {};
+    alignas(16) float m_lane[LANES] = {};
+    int32_t m_delay[LANES] = {};
+
+    // Input history, MAX_CHANNELS floats per frame
+    alignas(16) float m_history[HISTORY_FRAMES * MAX_CHANNELS] = {};
+    int32_t m_position = 0;
+
+    template <int IN>
+    void render(const float* src, float* dst, int32_t frames);
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_BINAURAL_RENDERER_H
@@ -1,8 +1,95 @@
 /**
  * ╔══════════════════════════════════════════════════════════════╗
- * ║                  BUFFER MANAGER - STUB                      ║
- * ║              Placeholder for future implementation          ║
+ * ║                BUFFER MANAGER - DECODE RING                 ║
+ * ║         Lock-Free SPSC Ring Between Decoder and Callback    ║
  * ╚══════════════════════════════════════════════════════════════╝
  */
 
-// Stub implementation - will be implemented in future iterations
\ No newline at end of file
+#include "BufferManager.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ftl_audio {
+
+void AudioRingBuffer::allocate(int32_t capacityFrames, int32_t channelCount) {
+    int32_t capacity = 1;
+    while (capacity < capacityFrames) {
+        capacity <<= 1;
+    }
+
+    m_capacityFrames = capacity;
+    m_channelCount = channelCount;
+    m_mask = capacity - 1;
+    m_storage = std::make_unique<float[]>(static_cast<size_t>(capacity) * channelCount);
+    reset();
+}
+
+void AudioRingBuffer::reset() {
+    m_writePosition.store(0, std::memory_order_relaxed);
+    m_readPosition.store(0, std::memory_order_relaxed);
+}
+
+int32_t AudioRingBuffer::availableToWrite() const {
+    int64_t used = m_writePosition.load(std::memory_order_relaxed) -
+                   m_readPosition.load(std::memory_order_acquire);
+    return m_capacityFrames - static_cast<int32_t>(used);
+}
+
+int32_t AudioRingBuffer::availableToRead() const {
+    return static_cast<int32_t>(m_writePosition.load(std::memory_order_acquire) -
+                                m_readPosition.load(std::memory_order_relaxed));
+}
+
+int32_t AudioRingBuffer::write(const float* frames, int32_t numFrames) {
+    int32_t count = std::min(numFrames, availableToWrite());
+    if (count <= 0) {
+        return 0;
+    }
+
+    int64_t position = m_writePosition.load(std::memory_order_relaxed);
+    int32_t start = static_cast<int32_t>(position & m_mask);
+    int32_t firstPart = std::min(count, m_capacityFrames - start);
+
+    std::memcpy(m_storage.get() + static_cast<size_t>(start) * m_channelCount, frames,
+                static_cast<size_t>(firstPart) * m_channelCount * sizeof(float));
+    if (count > firstPart) {
+        std::memcpy(m_storage.get(), frames + static_cast<size_t>(firstPart) * m_channelCount,
+                    static_cast<size_t>(count - firstPart) * m_channelCount * sizeof(float));
+    }
+
+    m_writePosition.store(position + count, std::memory_order_release);
+    return count;
+}
+
+int32_t AudioRingBuffer::read(float* frames, int32_t numFrames) {
+    int32_t count = std::min(numFrames, availableToRead());
+    if (count <= 0) {
+        return 0;
+    }
+
+    int64_t position = m_readPosition.load(std::memory_order_relaxed);
+    int32_t start = static_cast<int32_t>(position & m_mask);
+    int32_t firstPart = std::min(count, m_capacityFrames - start);
+
+    std::memcpy(frames, m_storage.get() + static_cast<size_t>(start) * m_channelCount,
+                static_cast<size_t>(firstPart) * m_channelCount * sizeof(float));
+    if (count > firstPart) {
+        std::memcpy(frames + static_cast<size_t>(firstPart) * m_channelCount, m_storage.get(),
+                    static_cast<size_t>(count - firstPart) * m_channelCount * sizeof(float));
+    }
+
+    m_readPosition.store(position + count, std::memory_order_release);
+    return count;
+}
+
+void AudioRingBuffer::discardUntil(int64_t position) {
+    int64_t current = m_readPosition.load(std::memory_order_relaxed);
+    int64_t written = m_writePosition.load(std::memory_order_acquire);
+    int64_t target = std::min(position, written);
+    if (target > current) {
+        m_readPosition.store(target, std::memory_order_release);
+    }
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,71 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                BUFFER MANAGER - DECODE RING                 ║
+ * ║         Lock-Free SPSC Ring Between Decoder and Callback    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Interleaved float frames. Exactly one producer (decode thread) and one
+ * consumer (audio callback). Read/write positions are monotonically
+ * increasing 64-bit frame counters, so a position doubles as a stable
+ * name for "the frame written at that point" — the engine uses this to
+ * flush stale audio after a seek without stopping either thread.
+ */
+
+#ifndef FTL_BUFFER_MANAGER_H
+#define FTL_BUFFER_MANAGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace ftl_audio {
+
+class AudioRingBuffer {
+public:
+    AudioRingBuffer() = default;
+
+    /**
+     * Allocate storage. Capacity is rounded up to a power of two frames.
+     * Not thread-safe: call before either side starts.
+     */
+    void allocate(int32_t capacityFrames, int32_t channelCount);
+
+    int32_t capacityFrames() const { return m_capacityFrames; }
+    int32_t channelCount() const { return m_channelCount; }
+
+    // Producer side
+    int32_t availableToWrite() const;
+    int32_t write(const float* frames, int32_t numFrames);
+    int64_t writePosition() const { return m_writePosition.load(std::memory_order_relaxed); }
+
+    // Consumer side
+    int32_t availableToRead() const;
+    int32_t read(float* frames, int32_t numFrames);
+    int64_t readPosition() const { return m_readPosition.load(std::memory_order_relaxed); }
+
+    /**
+     * Consumer-side flush: drop everything written before `position`.
+     * The producer publishes the position; the consumer applies it.
+     */
+    void discardUntil(int64_t position);
+
+    /**
+     * Drop all content. Only valid while neither side is running.
+     */
+    void reset();
+
+private:
+    std::unique_ptr<float[]> m_storage;
+    int32_t m_capacityFrames = 0;
+    int32_t m_channelCount = 0;
+    int64_t m_mask = 0;
+
+    alignas(64) std::atomic<int64_t> m_writePosition{0};
+    alignas(64) std::atomic<int64_t> m_readPosition{0};
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_BUFFER_MANAGER_H
@@ -0,0 +1,231 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              DOWNMIX - MULTICHANNEL MATRIX MIXING           ║
+ * ║          5.1 / 7.1 Sources on Stereo (or Any) Outputs       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Stereo outputs mix two frames per vector: each input sample is
+ * broadcast to {x0, x0, x1, x1} and multiplied by that input's
+ * {L, R, L, R} column. With the channel count a template parameter the
+ * inner loop unrolls completely.
+ */
+
+#include "Downmix.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_DOWNMIX_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_DOWNMIX_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr float MINUS_3DB = 0.70710678f;
+
+template <int IN>
+void stereoKernel(const float* src, float* dst, int32_t frames, const float* columns, const DownmixMatrix& matrix) {
+    int32_t i = 0;
+#if defined(FTL_DOWNMIX_NEON)
+    for (; i + 2 <= frames; i += 2) {
+        const float* x = src + i * IN;
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (int c = 0; c < IN; ++c) {
+            float32x4_t pair = vcombine_f32(vld1_dup_f32(x + c), vld1_dup_f32(x + IN + c));
+            acc = vmlaq_f32(acc, pair, vld1q_f32(columns + c * 4));
+        }
+        vst1q_f32(dst + i * 2, acc);
+    }
+#elif defined(FTL_DOWNMIX_SSE)
+    for (; i + 2 <= frames; i += 2) {
+        const float* x = src + i * IN;
+        __m128 acc = _mm_setzero_ps();
+        for (int c = 0; c < IN; ++c) {
+            __m128 pair = _mm_movelh_ps(_mm_load1_ps(x + c), _mm_load1_ps(x + IN + c));
+            acc = _mm_add_ps(acc, _mm_mul_ps(pair, _mm_load_ps(columns + c * 4)));
+        }
+        _mm_storeu_ps(dst + i * 2, acc);
+    }
+#endif
+    for (; i < frames; ++i) {
+        const float* x = src + i * IN;
+        float left = 0.0f;
+        float right = 0.0f;
+        for (int c = 0; c < IN; ++c) {
+            left += matrix.coefficients[0][c] * x[c];
+            right += matrix.coefficients[1][c] * x[c];
+        }
+        dst[i * 2] = left;
+        dst[i * 2 + 1] = right;
+    }
+}
+
+template <int IN>
+void monoKernel(const float* src, float* dst, int32_t frames, const float* /* columns */, const DownmixMatrix& matrix) {
+    float row[IN];
+    for (int c = 0; c < IN; ++c) {
+        row[c] = matrix.coefficients[0][c];
+    }
+    for (int32_t i = 0; i < frames; ++i) {
+        const float* x = src + i * IN;
+        float sum = 0.0f;
+        for (int c = 0; c < IN; ++c) {
+            sum += row[c] * x[c];
+        }
+        dst[i] = sum;
+    }
+}
+
+void genericKernel(const float* src, float* dst, int32_t frames, const float* /* columns */, const DownmixMatrix& matrix) {
+    const int in = matrix.inputChannels;
+    const int out = matrix.outputChannels;
+    for (int32_t i = 0; i < frames; ++i) {
+        const float* x = src + i * in;
+        for (int o = 0; o < out; ++o) {
+            float sum = 0.0f;
+            for (int c = 0; c < in; ++c) {
+                sum += matrix.coefficients[o][c] * x[c];
+            }
+            dst[i * out + o] = sum;
+        }
+    }
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LAYOUTS & MATRICES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+ChannelLayout layoutForChannelCount(int channelCount) {
+    switch (channelCount) {
+        case 1: return ChannelLayout::MONO;
+        case 3: return ChannelLayout::THREE_ZERO;
+        case 4: return ChannelLayout::QUAD;
+        case 5: return ChannelLayout::FIVE_ZERO;
+        case 6: return ChannelLayout::FIVE_ONE;
+        case 7: return ChannelLayout::SIX_ONE;
+        case 8: return ChannelLayout::SEVEN_ONE;
+        default: return ChannelLayout::STEREO;
+    }
+}
+
+DownmixMatrix DownmixMatrix::standard(int inputChannels, int outputChannels) {
+    DownmixMatrix matrix;
+    matrix.inputChannels = std::max(1, std::min(inputChannels, MAX_CHANNELS));
+    matrix.outputChannels = std::max(1, std::min(outputChannels, MAX_CHANNELS));
+    const int in = matrix.inputChannels;
+    const int out = matrix.outputChannels;
+
+    if (in <= out || out > 2) {
+        // Not a fold-down: drop extra channels, repeat the last one into missing ones
+        for (int o = 0; o < out; ++o) {
+            matrix.coefficients[o][std::min(o, in - 1)] = 1.0f;
+        }
+        return matrix;
+    }
+
+    // BS.775 stereo fold-down; L and R always pass through at unity
+    float (&left)[MAX_CHANNELS] = matrix.coefficients[0];
+    float (&right)[MAX_CHANNELS] = matrix.coefficients[1];
+    left[0] = 1.0f;
+    right[1] = 1.0f;
+    switch (layoutForChannelCount(in)) {
+        case ChannelLayout::THREE_ZERO:
+            left[2] = right[2] = MINUS_3DB;
+            break;
+        case ChannelLayout::QUAD:
+            left[2] = right[3] = MINUS_3DB;
+            break;
+        case ChannelLayout::FIVE_ZERO:
+            left[2] = right[2] = MINUS_3DB;
+            left[3] = right[4] = MINUS_3DB;
+            break;
+        case ChannelLayout::FIVE_ONE:
+            left[2] = right[2] = MINUS_3DB;
+            left[4] = right[5] = MINUS_3DB;
+            break;
+        case ChannelLayout::SIX_ONE:
+            left[2] = right[2] = MINUS_3DB;
+            left[4] = right[4] = 0.5f;          // Back centre split between both sides
+            left[5] = right[6] = MINUS_3DB;
+            break;
+        case ChannelLayout::SEVEN_ONE:
+            left[2] = right[2] = MINUS_3DB;
+            left[4] = right[5] = MINUS_3DB;
+            left[6] = right[7] = MINUS_3DB;
+            break;
+        default:
+            break;
+    }
+
+    if (out == 1) {
+        // Mono: average of the stereo fold-down
+        for (int c = 0; c < in; ++c) {
+            left[c] = 0.5f * (left[c] + right[c]);
+            right[c] = 0.0f;
+        }
+    }
+    return matrix;
+}
+
+bool DownmixMatrix::assign(int inputs, int outputs, const float* rowMajor) {
+    if (inputs < 1 || inputs > MAX_CHANNELS || outputs < 1 || outputs > MAX_CHANNELS || !rowMajor) {
+        return false;
+    }
+    *this = DownmixMatrix();
+    inputChannels = inputs;
+    outputChannels = outputs;
+    for (int o = 0; o < outputs; ++o) {
+        for (int c = 0; c < inputs; ++c) {
+            coefficients[o][c] = rowMajor[o * inputs + c];
+        }
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// DOWNMIXER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void Downmixer::configure(const DownmixMatrix& matrix) {
+    m_matrix = matrix;
+    for (int c = 0; c < DownmixMatrix::MAX_CHANNELS; ++c) {
+        m_columns[c][0] = m_columns[c][2] = matrix.coefficients[0][c];
+        m_columns[c][1] = m_columns[c][3] = matrix.coefficients[1][c];
+    }
+
+    static constexpr Kernel STEREO_KERNELS[DownmixMatrix::MAX_CHANNELS] = {
+        stereoKernel<1>, stereoKernel<2>, stereoKernel<3>, stereoKernel<4>,
+        stereoKernel<5>, stereoKernel<6>, stereoKernel<7>, stereoKernel<8>
+    };
+    static constexpr Kernel MONO_KERNELS[DownmixMatrix::MAX_CHANNELS] = {
+        monoKernel<1>, monoKernel<2>, monoKernel<3>, monoKernel<4>,
+        monoKernel<5>, monoKernel<6>, monoKernel<7>, monoKernel<8>
+    };
+    const int in = matrix.inputChannels;
+    if (in < 1 || in > DownmixMatrix::MAX_CHANNELS) {
+        m_kernel = nullptr;
+    } else if (matrix.outputChannels == 2) {
+        m_kernel = STEREO_KERNELS[in - 1];
+    } else if (matrix.outputChannels == 1) {
+        m_kernel = MONO_KERNELS[in - 1];
+    } else {
+        m_kernel = genericKernel;
+    }
+}
+
+void Downmixer::process(const float* src, float* dst, int32_t frames) const {
+    FTL_TRACE_SCOPE("downmix");
+    if (m_kernel) {
+        m_kernel(src, dst, frames, &m_columns[0][0], m_matrix);
+    }
+}
+
+} // namespace ftl_audio
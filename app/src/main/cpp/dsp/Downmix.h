@@ -0,0 +1,76 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              DOWNMIX - MULTICHANNEL MATRIX MIXING           ║
+ * ║          5.1 / 7.1 Sources on Stereo (or Any) Outputs       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Channels follow the WAVE / FLAC order: FL FR FC LFE BL BR SL SR.
+ * The default matrices are ITU-R BS.775 (centre and surrounds at -3 dB,
+ * LFE dropped); any matrix can be supplied instead. Common layouts run
+ * through kernels specialized at compile time for their input/output
+ * channel counts; the rest use a generic loop.
+ */
+
+#ifndef FTL_DSP_DOWNMIX_H
+#define FTL_DSP_DOWNMIX_H
+
+#include <cstdint>
+
+namespace ftl_audio {
+
+/** Speaker order of a source with `channelCount` channels */
+enum class ChannelLayout {
+    MONO,            // C
+    STEREO,          // L R
+    THREE_ZERO,      // L R C
+    QUAD,            // L R BL BR
+    FIVE_ZERO,       // L R C BL BR
+    FIVE_ONE,        // L R C LFE BL BR
+    SIX_ONE,         // L R C LFE BC SL SR
+    SEVEN_ONE        // L R C LFE BL BR SL SR
+};
+
+ChannelLayout layoutForChannelCount(int channelCount);
+
+struct DownmixMatrix {
+    static constexpr int MAX_CHANNELS = 8;
+
+    int inputChannels = 0;
+    int outputChannels = 0;
+    float coefficients[MAX_CHANNELS][MAX_CHANNELS] = {};   // [output][input]
+
+    /**
+     * Default matrix: ITU-R BS.775 for mono/stereo outputs, otherwise
+     * channels are dropped or the last one repeated (the old remap)
+     */
+    static DownmixMatrix standard(int inputChannels, int outputChannels);
+
+    /** Row-major [output][input]; false if the sizes are out of range */
+    bool assign(int inputs, int outputs, const float* rowMajor);
+};
+
+class Downmixer {
+public:
+    /** Pick the kernel for the matrix; not on the audio thread */
+    void configure(const DownmixMatrix& matrix);
+
+    const DownmixMatrix& matrix() const { return m_matrix; }
+
+    /** dst = matrix * src, interleaved; dst must not alias src */
+    void process(const float* src, float* dst, int32_t frames) const;
+
+private:
+    using Kernel = void (*)(const float* src, float* dst, int32_t frames, const float* columns, const DownmixMatrix& matrix);
+
+    DownmixMatrix m_matrix;
+    Kernel m_kernel = nullptr;
+
+    // Stereo kernels: per input channel {L, R, L, R}, so one vector mixes two frames
+    alignas(16) float m_columns[DownmixMatrix::MAX_CHANNELS][4] = {};
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_DOWNMIX_H
@@ -0,0 +1,235 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            EQUALIZER - 10-BAND OCTAVE PEAKING EQ            ║
+ * ║      Lock-Free Coefficient Updates While the Stream Runs    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * RBJ peaking sections in transposed direct form II. A frame runs through
+ * every active band before the next, so the cascade's state never leaves
+ * registers and L1 whatever the band count.
+ */
+
+#include "Equalizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define FTL_EQ_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FTL_EQ_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+// ISO 266 octave centers
+constexpr double BAND_FREQUENCIES[Equalizer::BANDS] = {
+    31.5, 63.0, 125.0, 250.0, 500.0, 1000.0, 2000.0, 4000.0, 8000.0, 16000.0
+};
+
+constexpr double CURVE_LOW_HZ = 20.0;
+constexpr double CURVE_HIGH_HZ = 20000.0;
+
+// Keeps silent filter state out of the denormal range (-400 dB of DC at the output)
+constexpr double DENORMAL_GUARD = 1e-20;
+
+} // namespace
+
+double Equalizer::bandFrequency(int band) {
+    return BAND_FREQUENCIES[band];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// DESIGN (any thread)
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+Equalizer::Coefficients Equalizer::design(int sampleRate, const float* gainsDb) {
+    Coefficients c;
+    for (int band = 0; band < BANDS; ++band) {
+        float gainDb = std::max(-MAX_GAIN_DB, std::min(MAX_GAIN_DB, gainsDb[band]));
+        c.gainsDb[band] = gainDb;
+        // A band above Nyquist (16 kHz at 32 kHz) stays flat
+        if (std::fabs(gainDb) < FLAT_DB || BAND_FREQUENCIES[band] >= sampleRate * 0.45) {
+            c.b0[band] = 1.0;
+            continue;
+        }
+
+        // RBJ cookbook peaking EQ, normalized by a0
+        double a = std::pow(10.0, gainDb / 40.0);
+        double w0 = 2.0 * M_PI * BAND_FREQUENCIES[band] / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * BAND_Q);
+        double cosw0 = std::cos(w0);
+        double a0 = 1.0 + alpha / a;
+        c.b0[band] = (1.0 + alpha * a) / a0;
+        c.b1[band] = -2.0 * cosw0 / a0;
+        c.b2[band] = (1.0 - alpha * a) / a0;
+        c.a1[band] = -2.0 * cosw0 / a0;
+        c.a2[band] = (1.0 - alpha / a) / a0;
+        c.activeMask |= 1u << band;
+    }
+    return c;
+}
+
+void Equalizer::mapCurve(const float* gainsDb, int count, float* bandGainsDb) {
+    if (count == BANDS) {
+        std::copy(gainsDb, gainsDb + BANDS, bandGainsDb);
+        return;
+    }
+    for (int band = 0; band < BANDS; ++band) {
+        if (count <= 0) {
+            bandGainsDb[band] = 0.0f;
+            continue;
+        }
+        if (count == 1) {
+            bandGainsDb[band] = gainsDb[0];
+            continue;
+        }
+        double position = std::log(BAND_FREQUENCIES[band] / CURVE_LOW_HZ) /
+                          std::log(CURVE_HIGH_HZ / CURVE_LOW_HZ) * (count - 1);
+        position = std::max(0.0, std::min(static_cast<double>(count - 1), position));
+        int lower = std::min(static_cast<int>(position), count - 2);
+        double fraction = position - lower;
+        bandGainsDb[band] = static_cast<float>(gainsDb[lower] * (1.0 - fraction) + gainsDb[lower + 1] * fraction);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// PROCESSING (audio thread)
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void Equalizer::configure(int channelCount) {
+    m_channelCount = std::max(1, std::min(channelCount, MAX_CHANNELS));
+    m_seenSequence = m_sequence.load(std::memory_order_acquire);
+    m_active = Coefficients();
+    m_activeCount = 0;
+    reset();
+}
+
+void Equalizer::reset() {
+    std::memset(m_state, 0, sizeof(m_state));
+}
+
+void Equalizer::post(const Coefficients& coefficients) {
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_posted = coefficients;
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool Equalizer::pickUpPosted(Coefficients& coefficients) {
+    uint32_t before = m_sequence.load(std::memory_order_acquire);
+    if (before == m_seenSequence || (before & 1u)) {
+        return false;
+    }
+    coefficients = m_posted;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_sequence.load(std::memory_order_relaxed) != before) {
+        return false;                                   // Torn: a post is under way, retry next burst
+    }
+    m_seenSequence = before;
+    return true;
+}
+
+void Equalizer::activate(const Coefficients& coefficients) {
+    // A band that starts running again must not resume from stale state
+    uint32_t started = coefficients.activeMask & ~m_active.activeMask;
+    m_active = coefficients;
+    m_activeCount = 0;
+    for (int band = 0; band < BANDS; ++band) {
+        if (!(m_active.activeMask & (1u << band))) continue;
+        m_activeBands[m_activeCount++] = band;
+        if (started & (1u << band)) {
+            for (int pair = 0; pair < PAIRS; ++pair) {
+                std::memset(m_state[pair][band], 0, sizeof(m_state[pair][band]));
+            }
+        }
+    }
+}
+
+void Equalizer::process(float* buffer, int32_t frames) {
+    Coefficients update;
+    if (pickUpPosted(update)) {
+        activate(update);
+    }
+    if (m_activeCount == 0) {
+        return;
+    }
+
+    const int channelCount = m_channelCount;
+    const Coefficients& c = m_active;
+    for (int first = 0; first < channelCount; first += 2) {
+        const bool pair = first + 1 < channelCount;
+        double (&state)[BANDS][2][2] = m_state[first / 2];
+        float* x = buffer + first;
+        // Every active band in cascade per frame: the state stays in registers / L1
+#if defined(FTL_EQ_NEON)
+        const float64x2_t guard = vdupq_n_f64(DENORMAL_GUARD);
+        for (int32_t i = 0; i < frames; ++i, x += channelCount) {
+            float32x2_t in = pair ? vld1_f32(x) : vset_lane_f32(x[0], vdup_n_f32(0.0f), 0);
+            float64x2_t v = vaddq_f64(vcvt_f64_f32(in), guard);
+            for (int k = 0; k < m_activeCount; ++k) {
+                const int band = m_activeBands[k];
+                float64x2_t s1 = vld1q_f64(state[band][0]);
+                float64x2_t s2 = vld1q_f64(state[band][1]);
+                float64x2_t y = vfmaq_n_f64(s1, v, c.b0[band]);
+                vst1q_f64(state[band][0], vfmsq_n_f64(vfmaq_n_f64(s2, v, c.b1[band]), y, c.a1[band]));
+                vst1q_f64(state[band][1], vfmsq_n_f64(vmulq_n_f64(v, c.b2[band]), y, c.a2[band]));
+                v = y;
+            }
+            float32x2_t out = vcvt_f32_f64(v);
+            if (pair) {
+                vst1_f32(x, out);
+            } else {
+                x[0] = vget_lane_f32(out, 0);
+            }
+        }
+#elif defined(FTL_EQ_SSE)
+        const __m128d guard = _mm_set1_pd(DENORMAL_GUARD);
+        for (int32_t i = 0; i < frames; ++i, x += channelCount) {
+            __m128 in = pair ? _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x)))
+                             : _mm_set_ss(x[0]);
+            __m128d v = _mm_add_pd(_mm_cvtps_pd(in), guard);
+            for (int k = 0; k < m_activeCount; ++k) {
+                const int band = m_activeBands[k];
+                __m128d s1 = _mm_load_pd(state[band][0]);
+                __m128d s2 = _mm_load_pd(state[band][1]);
+                __m128d y = _mm_add_pd(_mm_mul_pd(v, _mm_set1_pd(c.b0[band])), s1);
+                _mm_store_pd(state[band][0], _mm_sub_pd(_mm_add_pd(_mm_mul_pd(v, _mm_set1_pd(c.b1[band])), s2),
+                                                        _mm_mul_pd(y, _mm_set1_pd(c.a1[band]))));
+                _mm_store_pd(state[band][1], _mm_sub_pd(_mm_mul_pd(v, _mm_set1_pd(c.b2[band])),
+                                                        _mm_mul_pd(y, _mm_set1_pd(c.a2[band]))));
+                v = y;
+            }
+            __m128 out = _mm_cvtpd_ps(v);
+            if (pair) {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(x), _mm_castps_si128(out));
+            } else {
+                _mm_store_ss(x, out);
+            }
+        }
+#else
+        for (int lane = 0; lane < (pair ? 2 : 1); ++lane) {
+            float* sample = x + lane;
+            for (int32_t i = 0; i < frames; ++i, sample += channelCount) {
+                double v = *sample + DENORMAL_GUARD;
+                for (int k = 0; k < m_activeCount; ++k) {
+                    const int band = m_activeBands[k];
+                    double y = v * c.b0[band] + state[band][0][lane];
+                    state[band][0][lane] = v * c.b1[band] - y * c.a1[band] + state[band][1][lane];
+                    state[band][1][lane] = v * c.b2[band] - y * c.a2[band];
+                    v = y;
+                }
+                *sample = static_cast<float>(v);
+            }
+        }
+#endif
+    }
+}
+
+} // namespace ftl_audio
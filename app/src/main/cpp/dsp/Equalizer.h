@@ -0,0 +1,97 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            EQUALIZER - 10-BAND OCTAVE PEAKING EQ            ║
+ * ║      Lock-Free Coefficient Updates While the Stream Runs    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Ten peaking biquads on the ISO octave centers (31.5 Hz .. 16 kHz),
+ * designed and run in double precision (two channels per SIMD vector,
+ * like the loudness meter) so the low bands keep their noise floor far
+ * below the -100 dB THD+N target.
+ *
+ * A control thread designs a coefficient set and post()s it into a
+ * seqlocked slot (the EngineSnapshot protocol, latest set wins); the
+ * callback picks it up at the start of its next burst without waiting,
+ * keeping the filter state. Bands at 0 dB are not run at all, and a flat
+ * EQ leaves the buffer bit-exact.
+ */
+
+#ifndef FTL_DSP_EQUALIZER_H
+#define FTL_DSP_EQUALIZER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace ftl_audio {
+
+class Equalizer {
+public:
+    static constexpr int BANDS = 10;
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr float MAX_GAIN_DB = 12.0f;
+    static constexpr double BAND_Q = 1.41;              // One octave between -3 dB points
+    static constexpr float FLAT_DB = 0.01f;             // Bands closer to 0 dB are bypassed
+
+    /** Center frequency of band `band` (Hz) */
+    static double bandFrequency(int band);
+
+    struct Coefficients {
+        float gainsDb[BANDS] = {};
+        double b0[BANDS] = {};
+        double b1[BANDS] = {};
+        double b2[BANDS] = {};
+        double a1[BANDS] = {};
+        double a2[BANDS] = {};
+        uint32_t activeMask = 0;                        // Bit per band that is not flat
+    };
+
+    /** Peaking filters for `gainsDb` (clamped to +/-MAX_GAIN_DB) at `sampleRate` */
+    static Coefficients design(int sampleRate, const float* gainsDb);
+
+    /**
+     * Resample a curve onto the bands: `count` gains log-spaced over
+     * 20 Hz .. 20 kHz (count == BANDS is taken as is)
+     */
+    static void mapCurve(const float* gainsDb, int count, float* bandGainsDb);
+
+    /** Flat, state cleared. Not thread-safe: call while the callback is idle */
+    void configure(int channelCount);
+
+    /** Clear the filter state, keep the coefficients (audio thread, or callback idle) */
+    void reset();
+
+    /** Control side; posters must serialize among themselves */
+    void post(const Coefficients& coefficients);
+
+    /** Audio thread: take the newest posted set, then filter interleaved frames in place */
+    void process(float* buffer, int32_t frames);
+
+    /** Audio thread */
+    bool isFlat() const { return m_active.activeMask == 0; }
+
+private:
+    static constexpr int PAIRS = MAX_CHANNELS / 2;
+
+    // Posted set: odd sequence while a post is writing
+    std::atomic<uint32_t> m_sequence{0};
+    Coefficients m_posted;
+
+    // Audio thread only
+    uint32_t m_seenSequence = 0;
+    Coefficients m_active;
+    int m_activeBands[BANDS] = {};
+    int m_activeCount = 0;
+    int m_channelCount = 0;
+
+    // Transposed direct form II, [pair][band][s1, s2][lane]
+    alignas(16) double m_state[PAIRS][BANDS][2][2] = {};
+
+    bool pickUpPosted(Coefficients& coefficients);
+    void activate(const Coefficients& coefficients);
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_EQUALIZER_H
@@ -0,0 +1,294 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            LOUDNESS METER - EBU R128 / ITU-R BS.1770        ║
+ * ║      Streaming Integrated Loudness and Track Normalization  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * K-weighting coefficients are derived for any sample rate from the
+ * analog prototypes (the BS.1770 48 kHz table is their bilinear
+ * transform). The filters run in double: the 38 Hz high-pass has poles
+ * within 1e-3 of the unit circle at 192 kHz.
+ */
+
+#include "LoudnessMeter.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define FTL_LOUDNESS_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FTL_LOUDNESS_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+// Keeps silent filter state out of the denormal range; removed by the high-pass
+constexpr double DENORMAL_GUARD = 1e-20;
+
+double powerToLufs(double power) {
+    double lufs = power > 0.0 ? -0.691 + 10.0 * std::log10(power) : LoudnessMeter::NO_MEASUREMENT_LUFS;
+    return std::max(lufs, LoudnessMeter::NO_MEASUREMENT_LUFS);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONFIGURATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void LoudnessMeter::configure(int sampleRate, int channelCount) {
+    m_channelCount = std::max(1, std::min(channelCount, MAX_CHANNELS));
+    m_subBlockFrames = std::max(1, sampleRate / 10);
+
+    // Stage 1: high shelf, +4 dB above ~1.5 kHz (head diffraction)
+    double f0 = 1681.974450955533;
+    double gainDb = 3.999843853973347;
+    double q = 0.7071752369554196;
+    double k = std::tan(M_PI * f0 / sampleRate);
+    double vh = std::pow(10.0, gainDb / 20.0);
+    double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    m_shelf = {(vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+               2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+
+    // Stage 2: RLB high-pass at ~38 Hz
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = std::tan(M_PI * f0 / sampleRate);
+    a0 = 1.0 + k / q + k * k;
+    m_highpass = {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+
+    // Channel weights: front 1.0, surrounds 1.41, LFE excluded
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch) {
+        double weight = ch < m_channelCount ? 1.0 : 0.0;
+        if (m_channelCount >= 6 && ch == 3) {
+            weight = 0.0;
+        } else if ((m_channelCount == 4 && ch >= 2) || (m_channelCount >= 5 && ch >= 3 && ch < m_channelCount)) {
+            weight = 1.41;
+        }
+        m_weights[ch] = weight;
+    }
+    reset();
+}
+
+void LoudnessMeter::reset() {
+    std::fill(&m_state[0][0][0], &m_state[0][0][0] + PAIRS * 4 * 2, 0.0);
+    std::fill(m_sumSquares, m_sumSquares + MAX_CHANNELS, 0.0);
+    std::fill(m_subBlockPower, m_subBlockPower + SUB_BLOCKS, 0.0);
+    std::fill(m_binPower, m_binPower + HISTOGRAM_BINS, 0.0);
+    std::fill(m_binCount, m_binCount + HISTOGRAM_BINS, 0);
+    m_subBlockFill = 0;
+    m_subBlockIndex = 0;
+    m_subBlocksSeen = 0;
+    m_gatedBlocks = 0;
+    m_momentaryLufs = NO_MEASUREMENT_LUFS;
+    ++m_blockSerial;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MEASUREMENT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void LoudnessMeter::process(const float* input, int32_t frames) {
+    const int channelCount = m_channelCount;
+    const Biquad& s = m_shelf;
+    const Biquad& h = m_highpass;
+
+    while (frames > 0) {
+        int32_t chunk = std::min(frames, m_subBlockFrames - m_subBlockFill);
+
+        for (int first = 0; first < channelCount; first += 2) {
+            const bool pair = first + 1 < channelCount;
+            const float* x = input + first;
+            double (&state)[4][2] = m_state[first / 2];
+#if defined(FTL_LOUDNESS_NEON)
+            float64x2_t s1 = vld1q_f64(state[0]), s2 = vld1q_f64(state[1]);
+            float64x2_t t1 = vld1q_f64(state[2]), t2 = vld1q_f64(state[3]);
+            float64x2_t sum = vld1q_f64(m_sumSquares + first);
+            const float64x2_t sb0 = vdupq_n_f64(s.b0), sb1 = vdupq_n_f64(s.b1), sb2 = vdupq_n_f64(s.b2);
+            const float64x2_t sa1 = vdupq_n_f64(s.a1), sa2 = vdupq_n_f64(s.a2);
+            const float64x2_t hb0 = vdupq_n_f64(h.b0), hb1 = vdupq_n_f64(h.b1), hb2 = vdupq_n_f64(h.b2);
+            const float64x2_t ha1 = vdupq_n_f64(h.a1), ha2 = vdupq_n_f64(h.a2);
+            const float64x2_t guard = vdupq_n_f64(DENORMAL_GUARD);
+            for (int32_t i = 0; i < chunk; ++i, x += channelCount) {
+                float32x2_t in = pair ? vld1_f32(x) : vset_lane_f32(x[0], vdup_n_f32(0.0f), 0);
+                float64x2_t v = vaddq_f64(vcvt_f64_f32(in), guard);
+                float64x2_t y = vfmaq_f64(s1, v, sb0);
+                s1 = vfmsq_f64(vfmaq_f64(s2, v, sb1), y, sa1);
+                s2 = vfmsq_f64(vmulq_f64(v, sb2), y, sa2);
+                float64x2_t z = vfmaq_f64(t1, y, hb0);
+                t1 = vfmsq_f64(vfmaq_f64(t2, y, hb1), z, ha1);
+                t2 = vfmsq_f64(vmulq_f64(y, hb2), z, ha2);
+                sum = vfmaq_f64(sum, z, z);
+            }
+            vst1q_f64(state[0], s1);
+            vst1q_f64(state[1], s2);
+            vst1q_f64(state[2], t1);
+            vst1q_f64(state[3], t2);
+            vst1q_f64(m_sumSquares + first, sum);
+#elif defined(FTL_LOUDNESS_SSE)
+            __m128d s1 = _mm_load_pd(state[0]), s2 = _mm_load_pd(state[1]);
+            __m128d t1 = _mm_load_pd(state[2]), t2 = _mm_load_pd(state[3]);
+            __m128d sum = _mm_load_pd(m_sumSquares + first);
+            const __m128d sb0 = _mm_set1_pd(s.b0), sb1 = _mm_set1_pd(s.b1), sb2 = _mm_set1_pd(s.b2);
+            const __m128d sa1 = _mm_set1_pd(s.a1), sa2 = _mm_set1_pd(s.a2);
+            const __m128d hb0 = _mm_set1_pd(h.b0), hb1 = _mm_set1_pd(h.b1), hb2 = _mm_set1_pd(h.b2);
+            const __m128d ha1 = _mm_set1_pd(h.a1), ha2 = _mm_set1_pd(h.a2);
+            const __m128d guard = _mm_set1_pd(DENORMAL_GUARD);
+            for (int32_t i = 0; i < chunk; ++i, x += channelCount) {
+                __m128 in = pair ? _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x)))
+                                 : _mm_set_ss(x[0]);
+                __m128d v = _mm_add_pd(_mm_cvtps_pd(in), guard);
+                __m128d y = _mm_add_pd(_mm_mul_pd(v, sb0), s1);
+                s1 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(v, sb1), s2), _mm_mul_pd(y, sa1));
+                s2 = _mm_sub_pd(_mm_mul_pd(v, sb2), _mm_mul_pd(y, sa2));
+                __m128d z = _mm_add_pd(_mm_mul_pd(y, hb0), t1);
+                t1 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(y, hb1), t2), _mm_mul_pd(z, ha1));
+                t2 = _mm_sub_pd(_mm_mul_pd(y, hb2), _mm_mul_pd(z, ha2));
+                sum = _mm_add_pd(sum, _mm_mul_pd(z, z));
+            }
+            _mm_store_pd(state[0], s1);
+            _mm_store_pd(state[1], s2);
+            _mm_store_pd(state[2], t1);
+            _mm_store_pd(state[3], t2);
+            _mm_store_pd(m_sumSquares + first, sum);
+#else
+            for (int lane = 0; lane < (pair ? 2 : 1); ++lane) {
+                double s1 = state[0][lane], s2 = state[1][lane];
+                double t1 = state[2][lane], t2 = state[3][lane];
+                double sum = m_sumSquares[first + lane];
+                const float* in = x + lane;
+                for (int32_t i = 0; i < chunk; ++i, in += channelCount) {
+                    double v = *in + DENORMAL_GUARD;
+                    double y = v * s.b0 + s1;
+                    s1 = v * s.b1 - y * s.a1 + s2;
+                    s2 = v * s.b2 - y * s.a2;
+                    double z = y * h.b0 + t1;
+                    t1 = y * h.b1 - z * h.a1 + t2;
+                    t2 = y * h.b2 - z * h.a2;
+                    sum += z * z;
+                }
+                state[0][lane] = s1;
+                state[1][lane] = s2;
+                state[2][lane] = t1;
+                state[3][lane] = t2;
+                m_sumSquares[first + lane] = sum;
+            }
+#endif
+        }
+
+        input += chunk * channelCount;
+        frames -= chunk;
+        m_subBlockFill += chunk;
+        if (m_subBlockFill == m_subBlockFrames) {
+            closeSubBlock();
+        }
+    }
+}
+
+void LoudnessMeter::closeSubBlock() {
+    double power = 0.0;
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        power += m_weights[ch] * m_sumSquares[ch] / m_subBlockFrames;
+        m_sumSquares[ch] = 0.0;
+    }
+    m_subBlockFill = 0;
+    m_subBlockPower[m_subBlockIndex] = power;
+    m_subBlockIndex = (m_subBlockIndex + 1) % SUB_BLOCKS;
+    if (++m_subBlocksSeen < SUB_BLOCKS) {
+        return;
+    }
+
+    // Equal-length sub-blocks: their mean is the 400 ms block's mean square
+    double blockPower = 0.0;
+    for (double subBlock : m_subBlockPower) {
+        blockPower += subBlock;
+    }
+    blockPower /= SUB_BLOCKS;
+    m_momentaryLufs = powerToLufs(blockPower);
+    ++m_blockSerial;
+
+    if (m_momentaryLufs > ABSOLUTE_GATE_LUFS) {
+        int bin = static_cast<int>((m_momentaryLufs - HISTOGRAM_MIN_LUFS) / HISTOGRAM_STEP_LU);
+        bin = std::min(bin, HISTOGRAM_BINS - 1);
+        m_binPower[bin] += blockPower;
+        ++m_binCount[bin];
+        ++m_gatedBlocks;
+    }
+}
+
+double LoudnessMeter::integratedLufs() const {
+    if (m_gatedBlocks == 0) {
+        return NO_MEASUREMENT_LUFS;
+    }
+
+    double total = 0.0;
+    for (double power : m_binPower) {
+        total += power;
+    }
+    double relativeGate = powerToLufs(total / m_gatedBlocks) + RELATIVE_GATE_LU;
+
+    // The bin holding the gate is kept whole: at most 0.1 LU of blocks misjudged
+    int first = static_cast<int>(std::floor((relativeGate - HISTOGRAM_MIN_LUFS) / HISTOGRAM_STEP_LU));
+    first = std::max(0, std::min(first, HISTOGRAM_BINS - 1));
+    double gated = 0.0;
+    int64_t count = 0;
+    for (int bin = first; bin < HISTOGRAM_BINS; ++bin) {
+        gated += m_binPower[bin];
+        count += m_binCount[bin];
+    }
+    return count > 0 ? powerToLufs(gated / count) : NO_MEASUREMENT_LUFS;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// NORMALIZER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void LoudnessNormalizer::configure(int sampleRate, int channelCount) {
+    m_meter.configure(sampleRate, channelCount);
+    reset();
+}
+
+void LoudnessNormalizer::reset() {
+    m_meter.reset();
+    m_hasTrackLufs = false;
+    m_estimateDb = 0.0f;
+    m_hasEstimate = false;
+    m_seenSerial = m_meter.blockSerial();
+}
+
+void LoudnessNormalizer::process(const float* input, int32_t frames) {
+    FTL_TRACE_SCOPE("loudnessMeter");
+    m_meter.process(input, frames);
+    uint32_t blocks = m_meter.blockSerial() - m_seenSerial;
+    m_seenSerial = m_meter.blockSerial();
+    if (blocks == 0 || m_meter.gatedBlockCount() < MIN_ESTIMATE_BLOCKS) {
+        return;
+    }
+
+    float desired = m_targetLufs - static_cast<float>(m_meter.integratedLufs());
+    desired = std::max(MAX_CUT_DB, std::min(desired, MAX_BOOST_DB));
+    if (!m_hasEstimate) {
+        // First estimate is already ~2 s of program: take it at once
+        m_estimateDb = desired;
+        m_hasEstimate = true;
+        return;
+    }
+    float slew = MAX_SLEW_DB_PER_BLOCK * static_cast<float>(blocks);
+    m_estimateDb += std::max(-slew, std::min(desired - m_estimateDb, slew));
+}
+
+float LoudnessNormalizer::gainDb() const {
+    if (m_hasTrackLufs) {
+        return std::max(MAX_CUT_DB, std::min(m_targetLufs - m_trackLufs, MAX_BOOST_DB));
+    }
+    return m_estimateDb;
+}
+
+} // namespace ftl_audio
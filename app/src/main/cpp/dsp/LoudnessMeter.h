@@ -0,0 +1,130 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            LOUDNESS METER - EBU R128 / ITU-R BS.1770        ║
+ * ║      Streaming Integrated Loudness and Track Normalization  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * K-weighting (shelf + high-pass biquads, in double precision, two
+ * channels per SIMD vector), 400 ms blocks every 100 ms, absolute and
+ * relative gating over a fixed 0.1 LU histogram - so the integrated
+ * value never needs the block history and the meter never allocates
+ * after configure().
+ */
+
+#ifndef FTL_DSP_LOUDNESS_METER_H
+#define FTL_DSP_LOUDNESS_METER_H
+
+#include <cstdint>
+
+namespace ftl_audio {
+
+class LoudnessMeter {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+    static constexpr double RELATIVE_GATE_LU = -10.0;
+    static constexpr double NO_MEASUREMENT_LUFS = -200.0;   // Finite: the build uses -ffast-math
+
+    /** Coefficients for `sampleRate`; clears the measurement */
+    void configure(int sampleRate, int channelCount);
+    void reset();
+
+    /** Measure interleaved frames (not modified) */
+    void process(const float* input, int32_t frames);
+
+    /** Gated loudness of everything measured since reset, NO_MEASUREMENT_LUFS before any */
+    double integratedLufs() const;
+
+    /** Loudness of the last complete 400 ms block, NO_MEASUREMENT_LUFS before the first */
+    double momentaryLufs() const { return m_momentaryLufs; }
+
+    /** Complete 400 ms blocks above the absolute gate */
+    int64_t gatedBlockCount() const { return m_gatedBlocks; }
+
+    /** Incremented whenever a block completes - cheap "anything new?" check */
+    uint32_t blockSerial() const { return m_blockSerial; }
+
+private:
+    static constexpr int PAIRS = MAX_CHANNELS / 2;
+    static constexpr int SUB_BLOCKS = 4;                // 4 x 100 ms = one 400 ms block
+    static constexpr double HISTOGRAM_MIN_LUFS = ABSOLUTE_GATE_LUFS;
+    static constexpr double HISTOGRAM_STEP_LU = 0.1;
+    static constexpr int HISTOGRAM_BINS = 800;          // -70 .. +10 LUFS
+
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+    };
+
+    int m_channelCount = 0;
+    int32_t m_subBlockFrames = 0;
+    Biquad m_shelf{};
+    Biquad m_highpass{};
+    double m_weights[MAX_CHANNELS] = {};
+
+    // Filter state, [pair][s1 shelf, s2 shelf, s1 hp, s2 hp][lane]
+    alignas(16) double m_state[PAIRS][4][2] = {};
+    alignas(16) double m_sumSquares[MAX_CHANNELS] = {};
+    int32_t m_subBlockFill = 0;
+
+    // Weighted mean square of the last four 100 ms sub-blocks
+    double m_subBlockPower[SUB_BLOCKS] = {};
+    int m_subBlockIndex = 0;
+    int m_subBlocksSeen = 0;
+
+    double m_binPower[HISTOGRAM_BINS] = {};
+    int64_t m_binCount[HISTOGRAM_BINS] = {};
+    int64_t m_gatedBlocks = 0;
+    double m_momentaryLufs = NO_MEASUREMENT_LUFS;
+    uint32_t m_blockSerial = 0;
+
+    void closeSubBlock();
+};
+
+/**
+ * Per-track gain toward a loudness target: from metadata when the track
+ * carries it, otherwise from the meter, slewed so the estimate can settle
+ * without pumping.
+ */
+class LoudnessNormalizer {
+public:
+    static constexpr float DEFAULT_TARGET_LUFS = -18.0f;
+    static constexpr float MAX_BOOST_DB = 12.0f;
+    static constexpr float MAX_CUT_DB = -24.0f;
+    static constexpr int64_t MIN_ESTIMATE_BLOCKS = 20;  // ~2 s of gated audio
+    static constexpr float MAX_SLEW_DB_PER_BLOCK = 0.1f; // 1 dB/s
+
+    /** Clears the estimate and any metadata */
+    void configure(int sampleRate, int channelCount);
+
+    /** New track: forget the estimate and any metadata */
+    void reset();
+
+    void setTargetLufs(float lufs) { m_targetLufs = lufs; }
+
+    /** Integrated loudness from track metadata; without it the meter's estimate is used */
+    void setTrackLoudness(float lufs) { m_trackLufs = lufs; m_hasTrackLufs = true; }
+    void clearTrackLoudness() { m_hasTrackLufs = false; }
+
+    /** Measure program audio (before the normalization gain) */
+    void process(const float* input, int32_t frames);
+
+    /** Gain to apply now */
+    float gainDb() const;
+
+    const LoudnessMeter& meter() const { return m_meter; }
+
+private:
+    LoudnessMeter m_meter;
+    float m_targetLufs = DEFAULT_TARGET_LUFS;
+    float m_trackLufs = 0.0f;
+    bool m_hasTrackLufs = false;
+    float m_estimateDb = 0.0f;
+    bool m_hasEstimate = false;
+    uint32_t m_seenSerial = 0;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_LOUDNESS_METER_H
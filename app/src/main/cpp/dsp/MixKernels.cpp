@@ -0,0 +1,174 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 MIX KERNELS - SIMD GAIN & SUM               ║
+ * ║          Interleaved Float Mixing for the Audio Callback    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Ramps are vectorized for 1, 2 and 4 channel layouts, where one vector
+ * of four samples always covers whole frames; other layouts use the
+ * scalar loop.
+ */
+
+#include "MixKernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_MIX_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_MIX_SSE 1
+#endif
+
+namespace ftl_audio {
+namespace mix {
+
+namespace {
+
+bool vectorizableRamp(int32_t channelCount) {
+    return channelCount == 1 || channelCount == 2 || channelCount == 4;
+}
+
+// Gains for samples 0..3 of a vector, and how far the ramp moves per vector
+void rampLanes(int32_t channelCount, float gain, float step, float lanes[4], float& vectorStep) {
+    for (int k = 0; k < 4; ++k) {
+        lanes[k] = gain + step * static_cast<float>(k / channelCount);
+    }
+    vectorStep = step * static_cast<float>(4 / channelCount);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONSTANT GAIN
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void addScaled(float* dst, const float* src, size_t count, float gain) {
+    size_t i = 0;
+#if defined(FTL_MIX_NEON)
+    float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+    }
+#elif defined(FTL_MIX_SSE)
+    __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// RAMPED GAIN
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void addRamped(float* dst, const float* src, int32_t frames, int32_t channelCount, float gain, float step) {
+    if (step == 0.0f) {
+        addScaled(dst, src, static_cast<size_t>(frames) * channelCount, gain);
+        return;
+    }
+
+    size_t count = static_cast<size_t>(frames) * channelCount;
+    size_t i = 0;
+#if defined(FTL_MIX_NEON) || defined(FTL_MIX_SSE)
+    if (vectorizableRamp(channelCount)) {
+        float lanes[4];
+        float vectorStep;
+        rampLanes(channelCount, gain, step, lanes, vectorStep);
+#if defined(FTL_MIX_NEON)
+        float32x4_t g = vld1q_f32(lanes);
+        float32x4_t dg = vdupq_n_f32(vectorStep);
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+            g = vaddq_f32(g, dg);
+        }
+#else
+        __m128 g = _mm_loadu_ps(lanes);
+        __m128 dg = _mm_set1_ps(vectorStep);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+            g = _mm_add_ps(g, dg);
+        }
+#endif
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * (gain + step * static_cast<float>(i / channelCount));
+    }
+}
+
+void scaleRamped(float* buffer, int32_t frames, int32_t channelCount, float gain, float step) {
+    size_t count = static_cast<size_t>(frames) * channelCount;
+    size_t i = 0;
+#if defined(FTL_MIX_NEON) || defined(FTL_MIX_SSE)
+    if (vectorizableRamp(channelCount)) {
+        float lanes[4];
+        float vectorStep;
+        rampLanes(channelCount, gain, step, lanes, vectorStep);
+#if defined(FTL_MIX_NEON)
+        float32x4_t g = vld1q_f32(lanes);
+        float32x4_t dg = vdupq_n_f32(vectorStep);
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), g));
+            g = vaddq_f32(g, dg);
+        }
+#else
+        __m128 g = _mm_loadu_ps(lanes);
+        __m128 dg = _mm_set1_ps(vectorStep);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), g));
+            g = _mm_add_ps(g, dg);
+        }
+#endif
+    }
+#endif
+    for (; i < count; ++i) {
+        buffer[i] *= gain + step * static_cast<float>(i / channelCount);
+    }
+}
+
+void scaleFrames(float* buffer, const float* gains, int32_t frames, int32_t channelCount) {
+    int32_t i = 0;
+#if defined(FTL_MIX_NEON)
+    if (channelCount == 1) {
+        for (; i + 4 <= frames; i += 4) {
+            vst1q_f32(buffer + i, vmulq_f32(vld1q_f32(buffer + i), vld1q_f32(gains + i)));
+        }
+    } else if (channelCount == 2) {
+        for (; i + 2 <= frames; i += 2) {
+            float32x2_t g = vld1_f32(gains + i);
+            float32x4_t lanes = vcombine_f32(vdup_lane_f32(g, 0), vdup_lane_f32(g, 1));
+            vst1q_f32(buffer + i * 2, vmulq_f32(vld1q_f32(buffer + i * 2), lanes));
+        }
+    } else if (channelCount == 4) {
+        for (; i < frames; ++i) {
+            vst1q_f32(buffer + i * 4, vmulq_n_f32(vld1q_f32(buffer + i * 4), gains[i]));
+        }
+    }
+#elif defined(FTL_MIX_SSE)
+    if (channelCount == 1) {
+        for (; i + 4 <= frames; i += 4) {
+            _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), _mm_loadu_ps(gains + i)));
+        }
+    } else if (channelCount == 2) {
+        for (; i + 2 <= frames; i += 2) {
+            __m128 lanes = _mm_set_ps(gains[i + 1], gains[i + 1], gains[i], gains[i]);
+            _mm_storeu_ps(buffer + i * 2, _mm_mul_ps(_mm_loadu_ps(buffer + i * 2), lanes));
+        }
+    } else if (channelCount == 4) {
+        for (; i < frames; ++i) {
+            _mm_storeu_ps(buffer + i * 4, _mm_mul_ps(_mm_loadu_ps(buffer + i * 4), _mm_set1_ps(gains[i])));
+        }
+    }
+#endif
+    for (; i < frames; ++i) {
+        for (int32_t ch = 0; ch < channelCount; ++ch) {
+            buffer[i * channelCount + ch] *= gains[i];
+        }
+    }
+}
+
+} // namespace mix
+} // namespace ftl_audio
@@ -0,0 +1,38 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 MIX KERNELS - SIMD GAIN & SUM               ║
+ * ║          Interleaved Float Mixing for the Audio Callback    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * NEON on ARM, SSE on x86, scalar elsewhere. Ramped kernels advance the
+ * gain once per frame, so every channel of a frame gets the same gain.
+ * All kernels are allocation-free and safe on the audio thread.
+ */
+
+#ifndef FTL_DSP_MIX_KERNELS_H
+#define FTL_DSP_MIX_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ftl_audio {
+namespace mix {
+
+/** dst[i] += src[i] * gain */
+void addScaled(float* dst, const float* src, size_t count, float gain);
+
+/** dst += src * (gain + step * frame) */
+void addRamped(float* dst, const float* src, int32_t frames, int32_t channelCount, float gain, float step);
+
+/** buffer *= (gain + step * frame), in place */
+void scaleRamped(float* buffer, int32_t frames, int32_t channelCount, float gain, float step);
+
+/** buffer *= gains[frame], in place - one gain per frame (limiter envelopes) */
+void scaleFrames(float* buffer, const float* gains, int32_t frames, int32_t channelCount);
+
+} // namespace mix
+} // namespace ftl_audio
+
+#endif // FTL_DSP_MIX_KERNELS_H
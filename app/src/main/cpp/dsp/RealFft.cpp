@@ -0,0 +1,196 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              REAL FFT - SIMD SPECTRA FOR THE CALLBACK       ║
+ * ║        Float Real-Input Transform, Split Re / Im Layout     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Even samples go to the real and odd samples to the imaginary part of
+ * an N/2-point transform Z; the real spectrum follows from
+ * X[k] = E[k] + W^k O[k] with E, O the spectra of the even and odd
+ * halves, recovered from Z[k] and conj(Z[N/2 - k]). The inverse runs the
+ * same steps backwards, through the forward butterflies on conjugates.
+ */
+
+#include "RealFft.h"
+
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_FFT_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_FFT_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+} // namespace
+
+RealFft::RealFft(int size) : m_size(size), m_half(size / 2) {
+    const int half = m_half;
+    int bits = 0;
+    while ((1 << bits) < half) {
+        ++bits;
+    }
+    m_bitReverse.resize(half);
+    for (int i = 0; i < half; ++i) {
+        uint32_t reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((static_cast<uint32_t>(i) >> b) & 1u) << (bits - 1 - b);
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    // Per-stage twiddles back to back, so a butterfly run loads them contiguously
+    m_twiddleRe.resize(half > 1 ? half - 1 : 1);
+    m_twiddleIm.resize(m_twiddleRe.size());
+    for (int span = 2; span <= half; span *= 2) {
+        for (int k = 0; k < span / 2; ++k) {
+            double angle = -2.0 * PI * k / span;
+            m_twiddleRe[span / 2 - 1 + k] = static_cast<float>(std::cos(angle));
+            m_twiddleIm[span / 2 - 1 + k] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    m_unpackRe.resize(half + 1);
+    m_unpackIm.resize(half + 1);
+    for (int k = 0; k <= half; ++k) {
+        double angle = -2.0 * PI * k / size;
+        m_unpackRe[k] = static_cast<float>(std::cos(angle));
+        m_unpackIm[k] = static_cast<float>(std::sin(angle));
+    }
+    m_re.assign(half, 0.0f);
+    m_im.assign(half, 0.0f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TRANSFORMS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void RealFft::forward(const float* input, float* re, float* im) {
+    const int half = m_half;
+    for (int m = 0; m < half; ++m) {
+        uint32_t j = m_bitReverse[m];
+        m_re[j] = input[2 * m];
+        m_im[j] = input[2 * m + 1];
+    }
+    butterflies();
+
+    // Bins 0 and N/2 are real: the sum and difference of the even and odd DC terms
+    re[0] = m_re[0] + m_im[0];
+    im[0] = 0.0f;
+    re[half] = m_re[0] - m_im[0];
+    im[half] = 0.0f;
+    for (int k = 1; k < half; ++k) {
+        float zr = m_re[k], zi = m_im[k];
+        float cr = m_re[half - k], ci = -m_im[half - k];      // conj(Z[N/2 - k])
+        float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        float or_ = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);  // (Z - conj) / 2i
+        float wr = m_unpackRe[k], wi = m_unpackIm[k];
+        re[k] = er + wr * or_ - wi * oi;
+        im[k] = ei + wr * oi + wi * or_;
+    }
+}
+
+void RealFft::inverse(const float* re, const float* im, float* output) {
+    const int half = m_half;
+    for (int k = 0; k < half; ++k) {
+        float xr = re[k], xi = im[k];
+        float cr = re[half - k], ci = -im[half - k];          // conj(X[N/2 - k])
+        float er = 0.5f * (xr + cr), ei = 0.5f * (xi + ci);
+        float dr = 0.5f * (xr - cr), di = 0.5f * (xi - ci);
+        float wr = m_unpackRe[k], wi = -m_unpackIm[k];          // W^-k
+        float or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+        // Z = E + iO, conjugated so the forward butterflies run the inverse
+        uint32_t j = m_bitReverse[k];
+        m_re[j] = er - oi;
+        m_im[j] = -(ei + or_);
+    }
+    butterflies();
+
+    const float scale = 1.0f / static_cast<float>(half);
+    for (int m = 0; m < half; ++m) {
+        output[2 * m] = m_re[m] * scale;
+        output[2 * m + 1] = -m_im[m] * scale;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BUTTERFLIES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void RealFft::butterflies() {
+    float* re = m_re.data();
+    float* im = m_im.data();
+    const int half = m_half;
+
+    // Spans 2 and 4 together as one radix-4 pass (twiddles 1 and -i); MIN_SIZE keeps half >= 8
+    for (int s = 0; s < half; s += 4) {
+        float ar = re[s] + re[s + 1], ai = im[s] + im[s + 1];
+        float br = re[s] - re[s + 1], bi = im[s] - im[s + 1];
+        float cr = re[s + 2] + re[s + 3], ci = im[s + 2] + im[s + 3];
+        float dr = re[s + 2] - re[s + 3], di = im[s + 2] - im[s + 3];
+        re[s] = ar + cr;
+        im[s] = ai + ci;
+        re[s + 2] = ar - cr;
+        im[s + 2] = ai - ci;
+        re[s + 1] = br + di;                              // b + (-i) d
+        im[s + 1] = bi - dr;
+        re[s + 3] = br - di;
+        im[s + 3] = bi + dr;
+    }
+
+    for (int span = 8; span <= half; span *= 2) {
+        const int step = span / 2;
+        const float* wRe = m_twiddleRe.data() + step - 1;
+        const float* wIm = m_twiddleIm.data() + step - 1;
+        for (int s = 0; s < half; s += span) {
+            float* aRe = re + s;
+            float* aIm = im + s;
+            float* bRe = aRe + step;
+            float* bIm = aIm + step;
+            int k = 0;
+#if defined(FTL_FFT_NEON)
+            for (; k + 4 <= step; k += 4) {
+                float32x4_t wr = vld1q_f32(wRe + k), wi = vld1q_f32(wIm + k);
+                float32x4_t br = vld1q_f32(bRe + k), bi = vld1q_f32(bIm + k);
+                float32x4_t tr = vmlsq_f32(vmulq_f32(br, wr), bi, wi);
+                float32x4_t ti = vmlaq_f32(vmulq_f32(br, wi), bi, wr);
+                float32x4_t ar = vld1q_f32(aRe + k), ai = vld1q_f32(aIm + k);
+                vst1q_f32(aRe + k, vaddq_f32(ar, tr));
+                vst1q_f32(aIm + k, vaddq_f32(ai, ti));
+                vst1q_f32(bRe + k, vsubq_f32(ar, tr));
+                vst1q_f32(bIm + k, vsubq_f32(ai, ti));
+            }
+#elif defined(FTL_FFT_SSE)
+            for (; k + 4 <= step; k += 4) {
+                __m128 wr = _mm_loadu_ps(wRe + k), wi = _mm_loadu_ps(wIm + k);
+                __m128 br = _mm_loadu_ps(bRe + k), bi = _mm_loadu_ps(bIm + k);
+                __m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+                __m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+                __m128 ar = _mm_loadu_ps(aRe + k), ai = _mm_loadu_ps(aIm + k);
+                _mm_storeu_ps(aRe + k, _mm_add_ps(ar, tr));
+                _mm_storeu_ps(aIm + k, _mm_add_ps(ai, ti));
+                _mm_storeu_ps(bRe + k, _mm_sub_ps(ar, tr));
+                _mm_storeu_ps(bIm + k, _mm_sub_ps(ai, ti));
+            }
+#endif
+            for (; k < step; ++k) {
+                float tr = bRe[k] * wRe[k] - bIm[k] * wIm[k];
+                float ti = bRe[k] * wIm[k] + bIm[k] * wRe[k];
+                float ar = aRe[k], ai = aIm[k];
+                aRe[k] = ar + tr;
+                aIm[k] = ai + ti;
+                bRe[k] = ar - tr;
+                bIm[k] = ai - ti;
+            }
+        }
+    }
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,61 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              REAL FFT - SIMD SPECTRA FOR THE CALLBACK       ║
+ * ║        Float Real-Input Transform, Split Re / Im Layout     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A real signal of N samples is packed into N/2 complex points, run
+ * through a radix-2 FFT whose butterflies are NEON on ARM and SSE2 on
+ * x86 (four at a time, twiddles contiguous per stage), and unpacked to
+ * the N/2 + 1 bins of the real spectrum. Spectra are split into real and
+ * imaginary arrays so per-bin work vectorizes as well. Tables and
+ * scratch are allocated by the constructor; forward() and inverse() are
+ * allocation-free and safe on the audio thread.
+ *
+ * analysis::Fft stays the double-precision reference for measurements.
+ */
+
+#ifndef FTL_DSP_REAL_FFT_H
+#define FTL_DSP_REAL_FFT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ftl_audio {
+
+class RealFft {
+public:
+    static constexpr int MIN_SIZE = 16;
+
+    /** @param size  Power of two, at least MIN_SIZE */
+    explicit RealFft(int size = 2048);
+
+    int size() const { return m_size; }
+    int bins() const { return m_size / 2 + 1; }
+
+    /** `size()` samples -> bins() complex values, unscaled */
+    void forward(const float* input, float* re, float* im);
+
+    /** bins() complex values -> `size()` samples; inverse(forward(x)) == x. `re` and `im` are kept. */
+    void inverse(const float* re, const float* im, float* output);
+
+private:
+    int m_size;
+    int m_half;                         // Complex points
+
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<float> m_twiddleRe;     // Stage of span L at [L/2 - 1, L - 1): e^(-2 pi i k / L)
+    std::vector<float> m_twiddleIm;
+    std::vector<float> m_unpackRe;      // e^(-2 pi i k / N), k = 0 .. N/2
+    std::vector<float> m_unpackIm;
+    std::vector<float> m_re;            // Complex scratch
+    std::vector<float> m_im;
+
+    void butterflies();
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_REAL_FFT_H
@@ -0,0 +1,89 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              RESAMPLER - STREAMING RATE CONVERSION          ║
+ * ║        Cubic Interpolation for Mixer Voices Off-Rate        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "Resampler.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ftl_audio {
+
+void StreamResampler::configure(int inputRate, int outputRate, int channelCount, int32_t maxInputFrames) {
+    m_inputRate = inputRate;
+    m_outputRate = outputRate;
+    m_channelCount = channelCount;
+    m_step = static_cast<double>(inputRate) / outputRate;
+    m_work.assign(static_cast<size_t>(HISTORY_FRAMES + maxInputFrames) * channelCount, 0.0f);
+    reset();
+}
+
+void StreamResampler::reset() {
+    std::fill(m_work.begin(), m_work.end(), 0.0f);
+    m_position = HISTORY_FRAMES;
+}
+
+int32_t StreamResampler::maxOutputFrames(int32_t inputFrames) const {
+    if (isPassthrough()) {
+        return inputFrames;
+    }
+    return static_cast<int32_t>(std::ceil(inputFrames / m_step)) + 2;
+}
+
+int32_t StreamResampler::maxInputFrames(int32_t outputFrames) const {
+    if (isPassthrough()) {
+        return outputFrames;
+    }
+    return std::max(0, static_cast<int32_t>((outputFrames - 3) * m_step));
+}
+
+int32_t StreamResampler::process(const float* input, int32_t inputFrames, float* output) {
+    FTL_TRACE_SCOPE("resample");
+    const int channels = m_channelCount;
+    if (isPassthrough()) {
+        std::memcpy(output, input, static_cast<size_t>(inputFrames) * channels * sizeof(float));
+        return inputFrames;
+    }
+
+    // Block goes after the carried history so taps never straddle two buffers
+    float* work = m_work.data();
+    std::memcpy(work + HISTORY_FRAMES * channels, input,
+                static_cast<size_t>(inputFrames) * channels * sizeof(float));
+    const int64_t totalFrames = HISTORY_FRAMES + inputFrames;
+
+    int32_t produced = 0;
+    double position = m_position;
+    for (;;) {
+        int64_t index = static_cast<int64_t>(position);
+        if (index + 2 >= totalFrames) {
+            break;
+        }
+        float t = static_cast<float>(position - index);
+        const float* y0 = work + (index - 1) * channels;
+        const float* y1 = y0 + channels;
+        const float* y2 = y1 + channels;
+        const float* y3 = y2 + channels;
+        float* out = output + static_cast<size_t>(produced) * channels;
+        for (int ch = 0; ch < channels; ++ch) {
+            float a = -0.5f * y0[ch] + 1.5f * y1[ch] - 1.5f * y2[ch] + 0.5f * y3[ch];
+            float b = y0[ch] - 2.5f * y1[ch] + 2.0f * y2[ch] - 0.5f * y3[ch];
+            float c = 0.5f * (y2[ch] - y0[ch]);
+            out[ch] = ((a * t + b) * t + c) * t + y1[ch];
+        }
+        ++produced;
+        position += m_step;
+    }
+
+    // Keep the last frames as history for the next block
+    std::memmove(work, work + static_cast<size_t>(inputFrames) * channels,
+                 static_cast<size_t>(HISTORY_FRAMES) * channels * sizeof(float));
+    m_position = position - inputFrames;
+    return produced;
+}
+
+} // namespace ftl_audio
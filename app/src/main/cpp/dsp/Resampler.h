@@ -0,0 +1,62 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              RESAMPLER - STREAMING RATE CONVERSION          ║
+ * ║        Cubic Interpolation for Mixer Voices Off-Rate        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Catmull-Rom interpolation over interleaved float frames. Runs on the
+ * producer side of a ring (never in the callback), carries its history
+ * between blocks and consumes every input frame it is given. Equal rates
+ * pass samples through untouched.
+ */
+
+#ifndef FTL_DSP_RESAMPLER_H
+#define FTL_DSP_RESAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ftl_audio {
+
+class StreamResampler {
+public:
+    /**
+     * Set rates and reserve room for blocks of up to `maxInputFrames`.
+     * Clears history.
+     */
+    void configure(int inputRate, int outputRate, int channelCount, int32_t maxInputFrames);
+    void reset();
+
+    bool isPassthrough() const { return m_inputRate == m_outputRate; }
+
+    /** Input frames consumed per output frame */
+    double step() const { return m_step; }
+
+    /** Upper bound on the frames `process` writes for `inputFrames` */
+    int32_t maxOutputFrames(int32_t inputFrames) const;
+
+    /** Largest input block whose output is guaranteed to fit `outputFrames` */
+    int32_t maxInputFrames(int32_t outputFrames) const;
+
+    /**
+     * Convert one block
+     * @return Frames written to `output`
+     */
+    int32_t process(const float* input, int32_t inputFrames, float* output);
+
+private:
+    static constexpr int HISTORY_FRAMES = 3;
+
+    int m_inputRate = 0;
+    int m_outputRate = 0;
+    int m_channelCount = 0;
+    double m_step = 1.0;
+    double m_position = HISTORY_FRAMES;   // Read position in m_work, in input frames
+    std::vector<float> m_work;            // History followed by the current block
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_RESAMPLER_H
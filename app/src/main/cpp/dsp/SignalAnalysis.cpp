@@ -0,0 +1,328 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           SIGNAL ANALYSIS - FFT AUDIO MEASUREMENTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Band powers are summed bin by bin outside the tone, never as "total
+ * minus tone": at -140 dB the subtraction would cancel to rounding noise.
+ */
+
+#include "SignalAnalysis.h"
+
+#include <algorithm>
+
+namespace ftl_audio {
+namespace analysis {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Periodic 4-term Blackman-Harris (-92 dB sidelobes, 7-bin main lobe)
+constexpr double BH_A0 = 0.35875;
+constexpr double BH_A1 = 0.48829;
+constexpr double BH_A2 = 0.14128;
+constexpr double BH_A3 = 0.01168;
+
+constexpr int MAX_HARMONIC = 10;
+
+struct BandBins {
+    int first;
+    int last;
+};
+
+BandBins audioBand(int sampleRate, int fftSize) {
+    int nyquistBin = fftSize / 2;
+    int first = std::max(1, static_cast<int>(std::ceil(BAND_LOW_HZ * fftSize / sampleRate)));
+    int last = std::min(nyquistBin, static_cast<int>(std::floor(BAND_HIGH_HZ * fftSize / sampleRate)));
+    return {first, last};
+}
+
+/** Power in bin +/- TONE_HALF_WIDTH */
+double tonePower(const std::vector<double>& power, int bin) {
+    double sum = 0.0;
+    int first = std::max(0, bin - TONE_HALF_WIDTH);
+    int last = std::min(static_cast<int>(power.size()) - 1, bin + TONE_HALF_WIDTH);
+    for (int k = first; k <= last; ++k) {
+        sum += power[k];
+    }
+    return sum;
+}
+
+/** Marks bin +/- TONE_HALF_WIDTH as belonging to a tone */
+void maskTone(std::vector<char>& mask, int bin) {
+    int first = std::max(0, bin - TONE_HALF_WIDTH);
+    int last = std::min(static_cast<int>(mask.size()) - 1, bin + TONE_HALF_WIDTH);
+    for (int k = first; k <= last; ++k) {
+        mask[k] = 1;
+    }
+}
+
+double unmaskedPower(const std::vector<double>& power, const std::vector<char>& mask, BandBins band) {
+    double sum = 0.0;
+    for (int k = band.first; k <= band.last; ++k) {
+        if (!mask[k]) sum += power[k];
+    }
+    return sum;
+}
+
+/** Sample n of a sine, phase reduced to one cycle before scaling by 2 pi */
+double sineAt(double hz, int64_t n, int sampleRate, double phase) {
+    double cycles = hz * static_cast<double>(n) / sampleRate;
+    return std::sin(2.0 * PI * (cycles - std::floor(cycles)) + phase);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FFT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+Fft::Fft(int size) : m_size(size) {
+    int bits = 0;
+    while ((1 << bits) < size) ++bits;
+
+    m_bitReverse.resize(size);
+    for (int i = 0; i < size; ++i) {
+        uint32_t reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((static_cast<uint32_t>(i) >> b) & 1u) << (bits - 1 - b);
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    m_twiddles.resize(size / 2);
+    for (int k = 0; k < size / 2; ++k) {
+        double angle = -2.0 * PI * k / size;
+        m_twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    m_window.resize(size);
+    for (int n = 0; n < size; ++n) {
+        double x = 2.0 * PI * n / size;
+        m_window[n] = BH_A0 - BH_A1 * std::cos(x) + BH_A2 * std::cos(2.0 * x) - BH_A3 * std::cos(3.0 * x);
+    }
+}
+
+void Fft::forward(std::complex<double>* data) const {
+    for (int i = 0; i < m_size; ++i) {
+        int j = static_cast<int>(m_bitReverse[i]);
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (int length = 2; length <= m_size; length <<= 1) {
+        int half = length >> 1;
+        int stride = m_size / length;
+        for (int start = 0; start < m_size; start += length) {
+            for (int k = 0; k < half; ++k) {
+                std::complex<double> odd = data[start + k + half] * m_twiddles[k * stride];
+                data[start + k + half] = data[start + k] - odd;
+                data[start + k] += odd;
+            }
+        }
+    }
+}
+
+void Fft::transform(const float* input, int channelCount, int channel, bool windowed,
+                    std::vector<std::complex<double>>& spectrum) const {
+    spectrum.resize(m_size);
+    for (int n = 0; n < m_size; ++n) {
+        double sample = input[static_cast<size_t>(n) * channelCount + channel];
+        spectrum[n] = std::complex<double>(windowed ? sample * m_window[n] : sample, 0.0);
+    }
+    forward(spectrum.data());
+}
+
+void Fft::powerSpectrum(const float* input, int channelCount, int channel, std::vector<double>& power) const {
+    std::vector<std::complex<double>> spectrum;
+    transform(input, channelCount, channel, true, spectrum);
+    power.resize(m_size / 2 + 1);
+    for (int k = 0; k <= m_size / 2; ++k) {
+        power[k] = std::norm(spectrum[k]);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TEST SIGNALS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int binOf(double hz, int sampleRate, int fftSize) {
+    return static_cast<int>(std::lround(hz * fftSize / sampleRate));
+}
+
+double binFrequency(int bin, int sampleRate, int fftSize) {
+    return static_cast<double>(bin) * sampleRate / fftSize;
+}
+
+void generateTone(float* out, int64_t frames, int channelCount, double hz, double amplitude, int sampleRate) {
+    for (int64_t n = 0; n < frames; ++n) {
+        float sample = static_cast<float>(amplitude * sineAt(hz, n, sampleRate, 0.0));
+        for (int ch = 0; ch < channelCount; ++ch) {
+            out[n * channelCount + ch] = sample;
+        }
+    }
+}
+
+void generateTwoTone(float* out, int64_t frames, int channelCount, double lowHz, double lowAmplitude,
+                     double highHz, double highAmplitude, int sampleRate) {
+    for (int64_t n = 0; n < frames; ++n) {
+        double value = lowAmplitude * sineAt(lowHz, n, sampleRate, 0.0) +
+                       highAmplitude * sineAt(highHz, n, sampleRate, 0.0);
+        float sample = static_cast<float>(value);
+        for (int ch = 0; ch < channelCount; ++ch) {
+            out[n * channelCount + ch] = sample;
+        }
+    }
+}
+
+std::vector<int> multitoneBins(int count, int sampleRate, int fftSize) {
+    // Odd bins: every second-order product (sum or difference) lands on an even bin
+    const int minSpacing = 4 * TONE_HALF_WIDTH + 2;
+    BandBins band = audioBand(sampleRate, fftSize);
+    double low = std::max(30.0 * fftSize / sampleRate, static_cast<double>(band.first + TONE_HALF_WIDTH));
+    double high = static_cast<double>(band.last - TONE_HALF_WIDTH - 1);
+
+    std::vector<int> bins;
+    for (int i = 0; i < count; ++i) {
+        double position = count > 1 ? static_cast<double>(i) / (count - 1) : 0.0;
+        int bin = static_cast<int>(low * std::pow(high / low, position)) | 1;
+        if (!bins.empty()) bin = std::max(bin, bins.back() + minSpacing);
+        if (bin > high) break;
+        bins.push_back(bin);
+    }
+    return bins;
+}
+
+void generateMultitone(float* out, int64_t frames, int channelCount, const std::vector<double>& frequencies,
+                       double peak, int sampleRate) {
+    size_t count = frequencies.size();
+    if (count == 0 || frames <= 0) return;
+    // Schroeder phases keep the crest factor low; the sum is then scaled to `peak`
+    std::vector<double> phases(count);
+    for (size_t i = 0; i < count; ++i) {
+        phases[i] = -PI * static_cast<double>(i) * static_cast<double>(i + 1) / count;
+    }
+    std::vector<double> sum(frames, 0.0);
+    double largest = 0.0;
+    for (int64_t n = 0; n < frames; ++n) {
+        for (size_t i = 0; i < count; ++i) {
+            sum[n] += sineAt(frequencies[i], n, sampleRate, phases[i]);
+        }
+        largest = std::max(largest, std::fabs(sum[n]));
+    }
+    double scale = largest > 0.0 ? peak / largest : 0.0;
+    for (int64_t n = 0; n < frames; ++n) {
+        float sample = static_cast<float>(scale * sum[n]);
+        for (int ch = 0; ch < channelCount; ++ch) {
+            out[n * channelCount + ch] = sample;
+        }
+    }
+}
+
+void generateLogSweep(float* out, int64_t frames, int channelCount, double startHz, double endHz,
+                      double amplitude, int sampleRate) {
+    double duration = static_cast<double>(frames) / sampleRate;
+    double rate = std::log(endHz / startHz);
+    int64_t fadeFrames = std::min<int64_t>(frames / 2, sampleRate / 100);
+    for (int64_t n = 0; n < frames; ++n) {
+        double t = static_cast<double>(n) / sampleRate;
+        double phase = 2.0 * PI * startHz * duration / rate * (std::exp(t / duration * rate) - 1.0);
+        double gain = amplitude;
+        int64_t edge = std::min(n, frames - 1 - n);
+        if (edge < fadeFrames) {
+            gain *= 0.5 - 0.5 * std::cos(PI * static_cast<double>(edge) / fadeFrames);
+        }
+        float sample = static_cast<float>(gain * std::sin(phase));
+        for (int ch = 0; ch < channelCount; ++ch) {
+            out[n * channelCount + ch] = sample;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MEASUREMENTS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+ToneResult analyzeTone(const std::vector<double>& power, int bin, int sampleRate, int fftSize) {
+    ToneResult result;
+    BandBins band = audioBand(sampleRate, fftSize);
+    double fundamental = tonePower(power, bin);
+    if (fundamental <= 0.0) return result;
+
+    std::vector<char> mask(power.size(), 0);
+    maskTone(mask, bin);
+    double residual = unmaskedPower(power, mask, band);
+
+    double harmonics = 0.0;
+    for (int h = 2; h <= MAX_HARMONIC; ++h) {
+        int harmonicBin = bin * h;
+        if (harmonicBin + TONE_HALF_WIDTH > band.last) break;
+        harmonics += tonePower(power, harmonicBin);
+        maskTone(mask, harmonicBin);
+    }
+    double noise = unmaskedPower(power, mask, band);
+
+    // One-sided power of a windowed unit-peak sine is N * sum(w^2) / 4
+    double windowEnergy = fftSize * (BH_A0 * BH_A0 + 0.5 * (BH_A1 * BH_A1 + BH_A2 * BH_A2 + BH_A3 * BH_A3));
+    double fullScale = static_cast<double>(fftSize) * windowEnergy / 4.0;
+
+    result.thdPlusN = std::sqrt(residual / fundamental);
+    result.thd = std::sqrt(harmonics / fundamental);
+    result.snrDb = noise > 0.0 ? 10.0 * std::log10(fundamental / noise) : 600.0;
+    result.fundamentalDbfs = 10.0 * std::log10(fundamental / fullScale);
+    return result;
+}
+
+double analyzeSmpteImd(const std::vector<double>& power, int lowBin, int highBin) {
+    double carrier = tonePower(power, highBin);
+    if (carrier <= 0.0) return 0.0;
+    double sidebands = 0.0;
+    for (int order = 1; order <= 2; ++order) {
+        sidebands += tonePower(power, highBin - order * lowBin);
+        sidebands += tonePower(power, highBin + order * lowBin);
+    }
+    return std::sqrt(sidebands / carrier);
+}
+
+double analyzeMultitone(const std::vector<double>& power, const std::vector<int>& bins,
+                        int sampleRate, int fftSize) {
+    BandBins band = audioBand(sampleRate, fftSize);
+    std::vector<char> mask(power.size(), 0);
+    double tones = 0.0;
+    for (int bin : bins) {
+        tones += tonePower(power, bin);
+        maskTone(mask, bin);
+    }
+    if (tones <= 0.0) return 0.0;
+    return std::sqrt(unmaskedPower(power, mask, band) / tones);
+}
+
+std::vector<ResponsePoint> frequencyResponse(const std::vector<std::complex<double>>& input,
+                                             const std::vector<std::complex<double>>& output,
+                                             int sampleRate, int fftSize) {
+    std::vector<ResponsePoint> points;
+    BandBins band = audioBand(sampleRate, fftSize);
+    double reference = 0.0;
+    // ISO 1/3-octave centres 20 Hz .. 20 kHz are 1 kHz * 2^(k/3), k = -17 .. 13
+    for (int k = -17; k <= 13; ++k) {
+        double centre = 1000.0 * std::pow(2.0, k / 3.0);
+        int first = std::max(band.first, static_cast<int>(std::ceil(centre * std::pow(2.0, -1.0 / 6.0) * fftSize / sampleRate)));
+        int last = std::min(band.last, static_cast<int>(std::floor(centre * std::pow(2.0, 1.0 / 6.0) * fftSize / sampleRate)));
+        double in = 0.0;
+        double out = 0.0;
+        for (int bin = first; bin <= last; ++bin) {
+            in += std::norm(input[bin]);
+            out += std::norm(output[bin]);
+        }
+        if (in <= 0.0) continue;
+        double db = out > 0.0 ? 10.0 * std::log10(out / in) : -600.0;
+        if (k == 0) reference = db;
+        points.push_back({centre, db});
+    }
+    for (ResponsePoint& point : points) {
+        point.db -= reference;
+    }
+    return points;
+}
+
+} // namespace analysis
+} // namespace ftl_audio
@@ -0,0 +1,125 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           SIGNAL ANALYSIS - FFT AUDIO MEASUREMENTS          ║
+ * ║     THD+N, SNR, IMD, Multitone and Frequency Response       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Test tones sit exactly on FFT bins (coherent sampling) and spectra use
+ * the periodic 4-term Blackman-Harris window, so each tone's energy lands
+ * in exactly seven bins and everything else in the band is distortion or
+ * noise - no leakage floor, the measurement reaches far below the
+ * -100 dB (0.001%) THD+N target. Everything runs in double precision.
+ */
+
+#ifndef FTL_DSP_SIGNAL_ANALYSIS_H
+#define FTL_DSP_SIGNAL_ANALYSIS_H
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace ftl_audio {
+namespace analysis {
+
+constexpr int DEFAULT_FFT_SIZE = 65536;
+constexpr double BAND_LOW_HZ = 20.0;
+constexpr double BAND_HIGH_HZ = 20000.0;
+
+// A windowed coherent tone occupies its bin +/- TONE_HALF_WIDTH
+constexpr int TONE_HALF_WIDTH = 3;
+
+/** Radix-2 complex FFT with precomputed twiddles; const methods are thread-safe */
+class Fft {
+public:
+    explicit Fft(int size = DEFAULT_FFT_SIZE);
+
+    int size() const { return m_size; }
+
+    void forward(std::complex<double>* data) const;
+
+    /**
+     * Spectrum of `size()` frames of one channel of an interleaved block
+     * @param windowed  Blackman-Harris (tones) or rectangular (sweeps)
+     */
+    void transform(const float* input, int channelCount, int channel, bool windowed,
+                   std::vector<std::complex<double>>& spectrum) const;
+
+    /** |X[k]|^2 for bins 0..size()/2, Blackman-Harris windowed */
+    void powerSpectrum(const float* input, int channelCount, int channel, std::vector<double>& power) const;
+
+private:
+    int m_size;
+    std::vector<std::complex<double>> m_twiddles;
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<double> m_window;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TEST SIGNALS (interleaved, every channel identical)
+// ═══════════════════════════════════════════════════════════════════════════════════
+// Frequencies come from binFrequency() of the analysis rate; the signal may be
+// generated at another rate (a resampler under test) and stays coherent after it.
+
+/** Nearest bin of `hz` for an FFT of `fftSize` at `sampleRate` */
+int binOf(double hz, int sampleRate, int fftSize);
+double binFrequency(int bin, int sampleRate, int fftSize);
+
+/** Sine, `amplitude` linear peak */
+void generateTone(float* out, int64_t frames, int channelCount, double hz, double amplitude, int sampleRate);
+
+/** Two tones (SMPTE IMD: 60 Hz and 7 kHz at 4:1) */
+void generateTwoTone(float* out, int64_t frames, int channelCount, double lowHz, double lowAmplitude,
+                     double highHz, double highAmplitude, int sampleRate);
+
+/** Up to `count` log-spaced odd bins across the audio band, at least 2 tone widths apart */
+std::vector<int> multitoneBins(int count, int sampleRate, int fftSize);
+
+/** Equal-amplitude tones with Schroeder phases (low crest factor), scaled to `peak` */
+void generateMultitone(float* out, int64_t frames, int channelCount, const std::vector<double>& frequencies,
+                       double peak, int sampleRate);
+
+/** Exponential sweep with 10 ms raised-cosine ends */
+void generateLogSweep(float* out, int64_t frames, int channelCount, double startHz, double endHz,
+                      double amplitude, int sampleRate);
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MEASUREMENTS (on a powerSpectrum)
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+struct ToneResult {
+    double thdPlusN = 0.0;       // Ratio: RMS of everything else in band / fundamental
+    double thd = 0.0;            // Harmonics 2..10 only
+    double snrDb = 0.0;          // Fundamental over noise with harmonics removed
+    double fundamentalDbfs = 0.0;
+};
+
+ToneResult analyzeTone(const std::vector<double>& power, int bin, int sampleRate, int fftSize);
+
+/** SMPTE IMD ratio: sidebands at high +/- 1, 2 x low over the high tone */
+double analyzeSmpteImd(const std::vector<double>& power, int lowBin, int highBin);
+
+/** Everything in band outside the tones, over the tones' total power */
+double analyzeMultitone(const std::vector<double>& power, const std::vector<int>& bins,
+                        int sampleRate, int fftSize);
+
+struct ResponsePoint {
+    double hz;
+    double db;
+};
+
+/** |Y/X| in 1/3-octave bands across the audio band (rectangular spectra of a sweep) */
+std::vector<ResponsePoint> frequencyResponse(const std::vector<std::complex<double>>& input,
+                                             const std::vector<std::complex<double>>& output,
+                                             int sampleRate, int fftSize);
+
+inline double ratioToDb(double ratio) {
+    return ratio > 1e-30 ? 20.0 * std::log10(ratio) : -600.0;
+}
+
+} // namespace analysis
+} // namespace ftl_audio
+
+#endif // FTL_DSP_SIGNAL_ANALYSIS_H
@@ -0,0 +1,626 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          TIME STRETCH - TEMPO & PITCH FOR THE CALLBACK      ║
+ * ║     Phase Vocoder for Music, WSOLA for Speech, Any Channels ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Frame j is read at input position a_j (hops of hop * tempo / pitch)
+ * and overlap-added at j * hop. After each frame the first hop of the
+ * overlap-add buffer is complete and becomes a segment of stretched
+ * audio; its first frame sits at the middle of frame j - overlap / 2, so
+ * a segment maps linearly onto the input between two frame centers.
+ * Reset pads the input with silence so that the first segment out starts
+ * exactly at input position 0 with every overlapping frame present.
+ */
+
+#include "TimeStretch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_STRETCH_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_STRETCH_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double TWO_PI = 2.0 * PI;
+
+constexpr int32_t REFERENCE_RATE = 48000;
+constexpr int32_t REFERENCE_FFT_SIZE = 2048;        // ~43 ms
+constexpr double MIN_PITCH_RATIO = 0.5;             // -MAX_PITCH_SEMITONES
+
+// Periodic Hann at 4x overlap sums (squared) to 1.5
+constexpr float VOCODER_OVERLAP_GAIN = 1.5f;
+
+// Peaks below this fraction of the loudest bin are noise and follow their neighbours
+constexpr float PEAK_FLOOR = 1e-4f;
+
+// Rise in spectral magnitude, relative to the frame's total, that counts as an onset
+constexpr float TRANSIENT_FLUX = 0.35f;
+
+// WSOLA similarity search: every COARSE_STRIDE-th lag, then each lag around the best
+constexpr int32_t COARSE_STRIDE = 4;
+
+double principalAngle(double angle) {
+    return angle - TWO_PI * std::floor(angle / TWO_PI + 0.5);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// VECTOR KERNELS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+// out = a * b
+void multiply(const float* a, const float* b, float* out, int32_t count) {
+    int32_t i = 0;
+#if defined(FTL_STRETCH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+#elif defined(FTL_STRETCH_SSE)
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = a[i] * b[i];
+    }
+}
+
+// acc += a * b
+void multiplyAdd(float* acc, const float* a, const float* b, int32_t count) {
+    int32_t i = 0;
+#if defined(FTL_STRETCH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(acc + i, vmlaq_f32(vld1q_f32(acc + i), vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+#elif defined(FTL_STRETCH_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 product = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), product));
+    }
+#endif
+    for (; i < count; ++i) {
+        acc[i] += a[i] * b[i];
+    }
+}
+
+// acc += a
+void accumulate(float* acc, const float* a, int32_t count) {
+    int32_t i = 0;
+#if defined(FTL_STRETCH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vld1q_f32(a + i)));
+    }
+#elif defined(FTL_STRETCH_SSE)
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_loadu_ps(a + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        acc[i] += a[i];
+    }
+}
+
+// |re + i im|
+void magnitudes(const float* re, const float* im, float* out, int32_t count) {
+    int32_t i = 0;
+#if defined(FTL_STRETCH_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+        vst1q_f32(out + i, vsqrtq_f32(vmlaq_f32(vmulq_f32(r, r), m, m)));
+    }
+#elif defined(FTL_STRETCH_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+        _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m))));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+    }
+}
+
+// (re + i im) *= (rotRe + i rotIm), in place
+void rotate(float* re, float* im, const float* rotRe, const float* rotIm, int32_t count) {
+    int32_t i = 0;
+#if defined(FTL_STRETCH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+        float32x4_t cr = vld1q_f32(rotRe + i), ci = vld1q_f32(rotIm + i);
+        vst1q_f32(re + i, vmlsq_f32(vmulq_f32(r, cr), m, ci));
+        vst1q_f32(im + i, vmlaq_f32(vmulq_f32(r, ci), m, cr));
+    }
+#elif defined(FTL_STRETCH_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+        __m128 cr = _mm_loadu_ps(rotRe + i), ci = _mm_loadu_ps(rotIm + i);
+        _mm_storeu_ps(re + i, _mm_sub_ps(_mm_mul_ps(r, cr), _mm_mul_ps(m, ci)));
+        _mm_storeu_ps(im + i, _mm_add_ps(_mm_mul_ps(r, ci), _mm_mul_ps(m, cr)));
+    }
+#endif
+    for (; i < count; ++i) {
+        float r = re[i];
+        re[i] = r * rotRe[i] - im[i] * rotIm[i];
+        im[i] = r * rotIm[i] + im[i] * rotRe[i];
+    }
+}
+
+float dot(const float* a, const float* b, int32_t count) {
+    int32_t i = 0;
+    float sum = 0.0f;
+#if defined(FTL_STRETCH_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(FTL_STRETCH_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void periodicHann(std::vector<float>& window, int32_t size, float gain) {
+    window.resize(size);
+    for (int32_t n = 0; n < size; ++n) {
+        window[n] = gain * static_cast<float>(0.5 - 0.5 * std::cos(TWO_PI * n / size));
+    }
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CONFIGURATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void TimeStretcher::configure(int sampleRate, int channelCount) {
+    m_sampleRate = sampleRate;
+    m_channelCount = std::max(1, std::min(channelCount, MAX_CHANNELS));
+
+    // Same frame duration at every rate: 2048 at 44.1 / 48 kHz, 4096 at 88.2 / 96 kHz
+    m_fftSize = REFERENCE_FFT_SIZE;
+    while (static_cast<int64_t>(m_fftSize) * REFERENCE_RATE < static_cast<int64_t>(REFERENCE_FFT_SIZE) * sampleRate) {
+        m_fftSize *= 2;
+    }
+    m_hop = m_fftSize / VOCODER_OVERLAP;
+    m_searchFrames = m_hop / 2;
+    m_maxAnalysisHop = static_cast<int32_t>(std::ceil(m_hop * MAX_TEMPO / MIN_PITCH_RATIO)) + 1;
+
+    m_fft = std::make_unique<RealFft>(m_fftSize);
+    periodicHann(m_analysisWindow, m_fftSize, 1.0f);
+    periodicHann(m_synthesisWindow, m_fftSize, 1.0f / VOCODER_OVERLAP_GAIN);
+    periodicHann(m_wsolaWindow, m_fftSize / 2, 1.0f);
+
+    const int32_t bins = m_fftSize / 2 + 1;
+    m_frame.assign(m_fftSize, 0.0f);
+    for (std::vector<float>* spectrum : {&m_midRe, &m_midIm, &m_prevMidRe, &m_prevMidIm, &m_magnitude,
+                                         &m_prevMagnitude, &m_angle, &m_prevAngle, &m_rotRe, &m_rotIm}) {
+        spectrum->assign(bins, 0.0f);
+    }
+    m_peaks.reserve(bins);
+
+    // Silence padding, a frame, the search either side and the hops in between
+    m_inputCapacity = 4 * m_fftSize + 4 * m_maxAnalysisHop;
+    m_stretchedCapacity = 4 * m_hop + 8;
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch) {
+        bool used = ch < m_channelCount;
+        m_input[ch].assign(used ? m_inputCapacity : 0, 0.0f);
+        m_specRe[ch].assign(used ? bins : 0, 0.0f);
+        m_specIm[ch].assign(used ? bins : 0, 0.0f);
+        m_ola[ch].assign(used ? m_fftSize : 0, 0.0f);
+        m_stretched[ch].assign(used ? m_stretchedCapacity : 0, 0.0f);
+    }
+    m_pullScratch.assign(static_cast<size_t>(PULL_FRAMES) * m_channelCount, 0.0f);
+    m_mono.assign(2 * m_hop + 2 * m_searchFrames, 0.0f);
+    m_energy.assign(m_hop + 2 * m_searchFrames + 1, 0.0);
+    m_transients = 0;
+    reset();
+}
+
+void TimeStretcher::reset() {
+    m_activeMode = m_mode;
+    for (std::vector<float>* state : {&m_prevMidRe, &m_prevMidIm, &m_prevMagnitude, &m_prevAngle}) {
+        std::fill(state->begin(), state->end(), 0.0f);
+    }
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        std::fill(m_ola[ch].begin(), m_ola[ch].end(), 0.0f);
+    }
+
+    // Frame overlap / 2 is centred on position 0; everything before it reads silence
+    const int32_t length = frameLength();
+    m_primingHop = std::max(1, std::min(static_cast<int32_t>(std::lround(m_hop * m_tempo / m_pitch)), m_maxAnalysisHop));
+    m_hopRemainder = 0.0;
+    m_nextFrame = -(length / 2 + static_cast<int64_t>(overlap() / 2) * m_primingHop);
+    m_lastFrame = m_nextFrame - m_primingHop;
+    m_lastHop = m_primingHop;
+    m_hops = 0;
+
+    m_inputBase = m_nextFrame - (m_activeMode == StretchMode::SPEECH ? m_searchFrames : 0);
+    m_inputFrames = static_cast<int32_t>(-m_inputBase);
+    m_keepFrom = m_inputBase;
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        std::fill(m_input[ch].begin(), m_input[ch].begin() + m_inputFrames, 0.0f);
+    }
+
+    m_stretchedBase = 0;
+    m_stretchedEnd = 0;
+    m_readPosition = 0.0;
+    m_nextSegmentStart = 0.0;
+}
+
+void TimeStretcher::setTempo(double tempo) {
+    m_tempo = std::max(MIN_TEMPO, std::min(tempo, MAX_TEMPO));
+}
+
+void TimeStretcher::setPitchSemitones(double semitones) {
+    semitones = std::max(-MAX_PITCH_SEMITONES, std::min(semitones, MAX_PITCH_SEMITONES));
+    m_pitch = std::pow(2.0, semitones / 12.0);
+}
+
+void TimeStretcher::setMode(StretchMode mode) {
+    m_mode = mode;
+}
+
+int32_t TimeStretcher::maxLookaheadFrames() const {
+    // Half a frame, the frames up to the one centred on the output, one more hop held stretched
+    int32_t search = m_activeMode == StretchMode::SPEECH ? m_searchFrames : 0;
+    return frameLength() / 2 + (overlap() / 2 + 1) * m_maxAnalysisHop + search;
+}
+
+int32_t TimeStretcher::frameLength() const {
+    return m_activeMode == StretchMode::MUSIC ? m_fftSize : m_fftSize / 2;
+}
+
+int TimeStretcher::overlap() const {
+    return m_activeMode == StretchMode::MUSIC ? VOCODER_OVERLAP : WSOLA_OVERLAP;
+}
+
+int32_t TimeStretcher::analysisHop() {
+    m_hopRemainder += m_hop * m_tempo / m_pitch;
+    int32_t hop = static_cast<int32_t>(m_hopRemainder);
+    m_hopRemainder -= hop;
+    return std::max(1, std::min(hop, m_maxAnalysisHop));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// OUTPUT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int32_t TimeStretcher::process(float* output, int32_t frames, Pull pull, void* userData) {
+    const int channelCount = m_channelCount;
+    int32_t produced = 0;
+    while (produced < frames) {
+        int64_t base = static_cast<int64_t>(m_readPosition);
+        if (base + 2 >= m_stretchedEnd) {
+            if (!runHop(pull, userData)) {
+                break;
+            }
+            continue;
+        }
+
+        // One segment at a time: each is read back at the pitch it was stretched for
+        const int64_t segment = base / m_hop;
+        const double step = m_segments[segment % SEGMENT_HISTORY].pitch;
+        while (produced < frames && base + 2 < m_stretchedEnd && base / m_hop == segment) {
+            const float t = static_cast<float>(m_readPosition - static_cast<double>(base));
+            const int32_t i1 = static_cast<int32_t>(base - m_stretchedBase);
+            const int32_t i0 = base > m_stretchedBase ? i1 - 1 : i1;
+            float* out = output + static_cast<size_t>(produced) * channelCount;
+            for (int ch = 0; ch < channelCount; ++ch) {
+                const float* s = m_stretched[ch].data();
+                float y0 = s[i0], y1 = s[i1], y2 = s[i1 + 1], y3 = s[i1 + 2];
+                float a = -0.5f * y0 + 1.5f * y1 - 1.5f * y2 + 0.5f * y3;
+                float b = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+                float c = 0.5f * (y2 - y0);
+                out[ch] = ((a * t + b) * t + c) * t + y1;
+            }
+            ++produced;
+            m_readPosition += step;
+            base = static_cast<int64_t>(m_readPosition);
+        }
+    }
+    return produced;
+}
+
+double TimeStretcher::inputPosition() const {
+    const int64_t segment = static_cast<int64_t>(m_readPosition) / m_hop;
+    const double offset = (m_readPosition - static_cast<double>(segment * m_hop)) / m_hop;
+    if ((segment + 1) * m_hop <= m_stretchedEnd) {
+        const Segment& s = m_segments[segment % SEGMENT_HISTORY];
+        return s.inputStart + offset * (s.inputEnd - s.inputStart);
+    }
+    // Not stretched yet: it will start where the last segment ended
+    return m_nextSegmentStart + offset * m_hop * m_tempo / m_pitch;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// HOPS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool TimeStretcher::fillInput(int64_t until, Pull pull, void* userData) {
+    const int channelCount = m_channelCount;
+    while (m_inputBase + m_inputFrames < until) {
+        int32_t want = static_cast<int32_t>(std::min<int64_t>(PULL_FRAMES, until - (m_inputBase + m_inputFrames)));
+        if (m_inputFrames + want > m_inputCapacity) {
+            int32_t drop = static_cast<int32_t>(m_keepFrom - m_inputBase);
+            for (int ch = 0; ch < channelCount; ++ch) {
+                std::memmove(m_input[ch].data(), m_input[ch].data() + drop,
+                             static_cast<size_t>(m_inputFrames - drop) * sizeof(float));
+            }
+            m_inputBase += drop;
+            m_inputFrames -= drop;
+        }
+        int32_t got = pull(m_pullScratch.data(), want, userData);
+        if (got <= 0) {
+            return false;
+        }
+        for (int ch = 0; ch < channelCount; ++ch) {
+            float* dst = m_input[ch].data() + m_inputFrames;
+            for (int32_t i = 0; i < got; ++i) {
+                dst[i] = m_pullScratch[static_cast<size_t>(i) * channelCount + ch];
+            }
+        }
+        m_inputFrames += got;
+    }
+    return true;
+}
+
+bool TimeStretcher::runHop(Pull pull, void* userData) {
+    const int32_t length = frameLength();
+    const int ov = overlap();
+    const bool speech = m_activeMode == StretchMode::SPEECH;
+    const int64_t nominal = m_nextFrame;
+    if (!fillInput(nominal + length + (speech ? m_searchFrames : 0), pull, userData)) {
+        return false;
+    }
+
+    int64_t chosen = nominal;
+    if (speech) {
+        chosen = wsolaFrame(nominal);
+    } else {
+        vocoderFrame(nominal);
+    }
+    m_centers[m_hops % CENTER_HISTORY] = static_cast<double>(chosen) + length / 2;
+    m_lastHop = static_cast<int32_t>(chosen - m_lastFrame);
+    m_lastFrame = chosen;
+
+    // Frames j - overlap + 1 .. j all reached the first hop of the buffer; before that it fades in
+    if (m_hops >= ov) {
+        emitSegment();
+    }
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        float* ola = m_ola[ch].data();
+        std::memmove(ola, ola + m_hop, static_cast<size_t>(m_fftSize - m_hop) * sizeof(float));
+        std::fill(ola + m_fftSize - m_hop, ola + m_fftSize, 0.0f);
+    }
+
+    // Up to the frame centred on position 0 the spacing is the one the padding assumed
+    ++m_hops;
+    m_nextFrame = nominal + (m_hops <= ov / 2 ? m_primingHop : analysisHop());
+    m_keepFrom = speech ? std::min(m_nextFrame - m_searchFrames, chosen + m_hop) : m_nextFrame;
+    return true;
+}
+
+void TimeStretcher::emitSegment() {
+    const int ov = overlap();
+    // Keep one frame before the read position for the interpolator
+    int64_t keep = std::max(m_stretchedBase, static_cast<int64_t>(m_readPosition) - 1);
+    if (m_stretchedEnd - m_stretchedBase + m_hop > m_stretchedCapacity) {
+        int32_t drop = static_cast<int32_t>(keep - m_stretchedBase);
+        int32_t held = static_cast<int32_t>(m_stretchedEnd - m_stretchedBase);
+        for (int ch = 0; ch < m_channelCount; ++ch) {
+            std::memmove(m_stretched[ch].data(), m_stretched[ch].data() + drop,
+                         static_cast<size_t>(held - drop) * sizeof(float));
+        }
+        m_stretchedBase = keep;
+    }
+    const int32_t offset = static_cast<int32_t>(m_stretchedEnd - m_stretchedBase);
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        std::memcpy(m_stretched[ch].data() + offset, m_ola[ch].data(), static_cast<size_t>(m_hop) * sizeof(float));
+    }
+
+    Segment& segment = m_segments[(m_stretchedEnd / m_hop) % SEGMENT_HISTORY];
+    segment.inputStart = m_centers[(m_hops - ov / 2) % CENTER_HISTORY];
+    segment.inputEnd = m_centers[(m_hops - ov / 2 + 1) % CENTER_HISTORY];
+    segment.pitch = m_pitch;
+    m_nextSegmentStart = segment.inputEnd;
+    m_stretchedEnd += m_hop;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// PHASE VOCODER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void TimeStretcher::vocoderFrame(int64_t start) {
+    const int32_t size = m_fftSize;
+    const int32_t bins = size / 2 + 1;
+    const int channelCount = m_channelCount;
+
+    for (int ch = 0; ch < channelCount; ++ch) {
+        multiply(inputAt(ch, start), m_analysisWindow.data(), m_frame.data(), size);
+        m_fft->forward(m_frame.data(), m_specRe[ch].data(), m_specIm[ch].data());
+    }
+    std::copy(m_specRe[0].begin(), m_specRe[0].end(), m_midRe.begin());
+    std::copy(m_specIm[0].begin(), m_specIm[0].end(), m_midIm.begin());
+    for (int ch = 1; ch < channelCount; ++ch) {
+        accumulate(m_midRe.data(), m_specRe[ch].data(), bins);
+        accumulate(m_midIm.data(), m_specIm[ch].data(), bins);
+    }
+    magnitudes(m_midRe.data(), m_midIm.data(), m_magnitude.data(), bins);
+
+    // Onset: a broadband rise in magnitude over the last hop
+    bool onset = false;
+    if (m_preserveTransients && m_hops > VOCODER_OVERLAP / 2) {
+        float rise = 0.0f;
+        float total = 0.0f;
+        for (int32_t k = 0; k < bins; ++k) {
+            rise += std::max(0.0f, m_magnitude[k] - m_prevMagnitude[k]);
+            total += m_magnitude[k];
+        }
+        onset = total > 0.0f && rise > TRANSIENT_FLUX * total;
+    }
+
+    // The frames up to the one centred on the start keep the input's phases, like an onset
+    if (onset || m_hops <= VOCODER_OVERLAP / 2) {
+        std::fill(m_angle.begin(), m_angle.end(), 0.0f);
+        std::fill(m_rotRe.begin(), m_rotRe.end(), 1.0f);
+        std::fill(m_rotIm.begin(), m_rotIm.end(), 0.0f);
+        m_transients += onset ? 1 : 0;
+    } else {
+        analyzePhases(static_cast<int32_t>(start - m_lastFrame));
+    }
+
+    // Pitching up: what would fold past Nyquist on read-back is dropped here
+    if (m_pitch > 1.0) {
+        int32_t limit = static_cast<int32_t>((bins - 1) / m_pitch) + 1;
+        std::fill(m_rotRe.begin() + limit, m_rotRe.end(), 0.0f);
+        std::fill(m_rotIm.begin() + limit, m_rotIm.end(), 0.0f);
+    }
+
+    for (int ch = 0; ch < channelCount; ++ch) {
+        rotate(m_specRe[ch].data(), m_specIm[ch].data(), m_rotRe.data(), m_rotIm.data(), bins);
+        m_fft->inverse(m_specRe[ch].data(), m_specIm[ch].data(), m_frame.data());
+        multiplyAdd(m_ola[ch].data(), m_frame.data(), m_synthesisWindow.data(), size);
+    }
+
+    m_midRe.swap(m_prevMidRe);
+    m_midIm.swap(m_prevMidIm);
+    m_magnitude.swap(m_prevMagnitude);
+    m_angle.swap(m_prevAngle);
+}
+
+void TimeStretcher::analyzePhases(int32_t hop) {
+    const int32_t bins = m_fftSize / 2 + 1;
+    const float* magnitude = m_magnitude.data();
+
+    float loudest = 0.0f;
+    for (int32_t k = 0; k < bins; ++k) {
+        loudest = std::max(loudest, magnitude[k]);
+    }
+    const float floor = loudest * PEAK_FLOOR;
+    m_peaks.clear();
+    for (int32_t k = 2; k + 2 < bins; ++k) {
+        float m = magnitude[k];
+        if (m > floor && m > magnitude[k - 1] && m > magnitude[k - 2] &&
+            m >= magnitude[k + 1] && m >= magnitude[k + 2]) {
+            m_peaks.push_back(k);
+        }
+    }
+    if (m_peaks.empty()) {
+        std::fill(m_angle.begin(), m_angle.end(), 0.0f);
+        std::fill(m_rotRe.begin(), m_rotRe.end(), 1.0f);
+        std::fill(m_rotIm.begin(), m_rotIm.end(), 0.0f);
+        return;
+    }
+
+    // Each peak advances at its measured frequency over the synthesis hop; its region
+    // (down to the quietest bin towards the next peak) turns with it
+    const double stretch = static_cast<double>(m_hop) / hop;
+    int32_t regionStart = 0;
+    for (size_t i = 0; i < m_peaks.size(); ++i) {
+        const int32_t peak = m_peaks[i];
+        const double omega = TWO_PI * peak / m_fftSize;
+        const double phase = std::atan2(m_midIm[peak], m_midRe[peak]);
+        const double previous = std::atan2(m_prevMidIm[peak], m_prevMidRe[peak]);
+        const double expected = omega * hop;
+        const double advance = (expected + principalAngle(phase - previous - expected)) * stretch;
+        const float angle = static_cast<float>(principalAngle(previous + m_prevAngle[peak] + advance - phase));
+        const float rotRe = std::cos(angle);
+        const float rotIm = std::sin(angle);
+
+        int32_t regionEnd = bins;
+        if (i + 1 < m_peaks.size()) {
+            regionEnd = peak + 1;
+            for (int32_t k = peak + 1; k < m_peaks[i + 1]; ++k) {
+                if (magnitude[k] < magnitude[regionEnd]) regionEnd = k;
+            }
+        }
+        for (int32_t k = regionStart; k < regionEnd; ++k) {
+            m_angle[k] = angle;
+            m_rotRe[k] = rotRe;
+            m_rotIm[k] = rotIm;
+        }
+        regionStart = regionEnd;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WSOLA
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int64_t TimeStretcher::wsolaFrame(int64_t nominal) {
+    const int32_t length = m_fftSize / 2;
+    const int32_t overlapFrames = length - m_hop;
+    const int32_t search = m_searchFrames;
+    const int channelCount = m_channelCount;
+    int64_t chosen = nominal;
+
+    // Past the frame centred on the start, look for the lag that best continues the last frame
+    if (m_hops > WSOLA_OVERLAP / 2) {
+        const int64_t natural = m_lastFrame + m_hop;
+        const int32_t span = overlapFrames + 2 * search;
+        float* target = m_mono.data();
+        float* candidates = target + overlapFrames;
+        std::copy(inputAt(0, natural), inputAt(0, natural) + overlapFrames, target);
+        std::copy(inputAt(0, nominal - search), inputAt(0, nominal - search) + span, candidates);
+        for (int ch = 1; ch < channelCount; ++ch) {
+            accumulate(target, inputAt(ch, natural), overlapFrames);
+            accumulate(candidates, inputAt(ch, nominal - search), span);
+        }
+        m_energy[0] = 0.0;
+        for (int32_t i = 0; i < span; ++i) {
+            m_energy[i + 1] = m_energy[i] + static_cast<double>(candidates[i]) * candidates[i];
+        }
+
+        auto score = [&](int32_t lag) {
+            double energy = m_energy[lag + overlapFrames] - m_energy[lag];
+            return dot(target, candidates + lag, overlapFrames) / std::sqrt(energy + 1e-9);
+        };
+        int32_t best = search;
+        double bestScore = score(search);
+        for (int32_t lag = 0; lag <= 2 * search; lag += COARSE_STRIDE) {
+            double s = score(lag);
+            if (s > bestScore) {
+                bestScore = s;
+                best = lag;
+            }
+        }
+        const int32_t coarse = best;
+        for (int32_t lag = std::max(0, coarse - COARSE_STRIDE + 1);
+             lag <= std::min(2 * search, coarse + COARSE_STRIDE - 1); ++lag) {
+            double s = score(lag);
+            if (s > bestScore) {
+                bestScore = s;
+                best = lag;
+            }
+        }
+        chosen = nominal - search + best;
+    }
+
+    for (int ch = 0; ch < channelCount; ++ch) {
+        multiplyAdd(m_ola[ch].data(), inputAt(ch, chosen), m_wsolaWindow.data(), length);
+    }
+    return chosen;
+}
+
+} // namespace ftl_audio
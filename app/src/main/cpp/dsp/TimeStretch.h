@@ -0,0 +1,183 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          TIME STRETCH - TEMPO & PITCH FOR THE CALLBACK      ║
+ * ║     Phase Vocoder for Music, WSOLA for Speech, Any Channels ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Tempo and pitch are independent: the signal is stretched in time by
+ * pitch / tempo, then read back at `pitch` stretched frames per output
+ * frame through a Catmull-Rom interpolator, so the net input consumption
+ * is `tempo` frames per output frame and frequencies scale by `pitch`.
+ *
+ * MUSIC runs a phase vocoder (Hann frames of ~43 ms, 4x overlap) with
+ * identity phase locking: only spectral peaks have their phase advanced,
+ * the bins around each peak keep their phase offset to it. Phases come
+ * from the sum of all channels and the same rotation is applied to each
+ * one, so the stereo image does not smear. A spectral-flux onset resets
+ * the phases to the input's (transient preservation), which keeps drum
+ * hits sharp instead of smeared over a frame. When pitching up, bins
+ * that would fold past Nyquist are cleared before synthesis.
+ *
+ * SPEECH runs WSOLA (~21 ms frames, 2x overlap): each frame is taken
+ * within +-5 ms of its nominal position where it best continues the
+ * previous one (normalized cross-correlation, SIMD dot products), so
+ * voices keep their waveform and never sound phasey.
+ *
+ * Both share one hop (~11 ms), and every output frame maps back to an
+ * exact input position, so the caller's playhead never drifts. Tempo and
+ * pitch changes are heard within two hops; the mode applies from the next
+ * reset(). configure() allocates; everything else is allocation-free and
+ * safe on the audio thread.
+ */
+
+#ifndef FTL_DSP_TIME_STRETCH_H
+#define FTL_DSP_TIME_STRETCH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RealFft.h"
+
+namespace ftl_audio {
+
+enum class StretchMode : int32_t {
+    MUSIC = 0,          // Phase vocoder
+    SPEECH = 1          // WSOLA
+};
+
+class TimeStretcher {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr double MIN_TEMPO = 0.7;
+    static constexpr double MAX_TEMPO = 1.3;
+    static constexpr double MAX_PITCH_SEMITONES = 12.0;
+
+    /** Fills up to `count` interleaved input frames; fewer when no more are ready */
+    using Pull = int32_t (*)(float* frames, int32_t count, void* userData);
+
+    /** Frame size from the rate (~43 ms); allocates, not on the audio thread */
+    void configure(int sampleRate, int channelCount);
+
+    /** Drops buffered audio and phase history; the next input frame pulled is position 0 */
+    void reset();
+
+    void setTempo(double tempo);                    // Clamped to [MIN_TEMPO, MAX_TEMPO]
+    void setPitchSemitones(double semitones);       // Clamped to +-MAX_PITCH_SEMITONES
+    void setMode(StretchMode mode);                 // From the next reset()
+    void setTransientPreservation(bool enabled) { m_preserveTransients = enabled; }
+
+    double tempo() const { return m_tempo; }
+    double pitchRatio() const { return m_pitch; }
+    StretchMode mode() const { return m_activeMode; }
+
+    /**
+     * Render up to `frames` interleaved frames, pulling input as needed
+     * @return Frames written; fewer only when `pull` ran dry
+     */
+    int32_t process(float* output, int32_t frames, Pull pull, void* userData);
+
+    /** Input position (frames since reset) of the next output frame */
+    double inputPosition() const;
+
+    int32_t hopFrames() const { return m_hop; }
+    /** Input frames read ahead of inputPosition() at most */
+    int32_t maxLookaheadFrames() const;
+    /** Phase resets on onsets since configure() (MUSIC) */
+    uint64_t transientCount() const { return m_transients; }
+
+private:
+    static constexpr int VOCODER_OVERLAP = 4;
+    static constexpr int WSOLA_OVERLAP = 2;
+    static constexpr int CENTER_HISTORY = 4;
+    static constexpr int SEGMENT_HISTORY = 8;
+    static constexpr int32_t PULL_FRAMES = 512;
+
+    struct Segment {
+        double inputStart = 0.0;        // Input position of its first stretched frame
+        double inputEnd = 0.0;          // ... and of the next segment's first
+        double pitch = 1.0;             // Read-back ratio it was stretched for
+    };
+
+    int m_sampleRate = 0;
+    int m_channelCount = 0;
+    int32_t m_fftSize = 0;              // Vocoder frame
+    int32_t m_hop = 0;                  // Synthesis hop, both modes
+    int32_t m_searchFrames = 0;         // WSOLA tolerance
+    int32_t m_maxAnalysisHop = 0;
+
+    double m_tempo = 1.0;
+    double m_pitch = 1.0;
+    StretchMode m_mode = StretchMode::MUSIC;
+    StretchMode m_activeMode = StretchMode::MUSIC;
+    bool m_preserveTransients = true;
+    uint64_t m_transients = 0;
+
+    std::unique_ptr<RealFft> m_fft;
+    std::vector<float> m_analysisWindow;        // Hann, fftSize
+    std::vector<float> m_synthesisWindow;       // Hann / overlap gain
+    std::vector<float> m_wsolaWindow;           // Hann, fftSize / 2
+
+    // Input, per channel: positions [m_inputBase, m_inputBase + m_inputFrames)
+    std::vector<float> m_input[MAX_CHANNELS];
+    int32_t m_inputCapacity = 0;
+    int64_t m_inputBase = 0;
+    int32_t m_inputFrames = 0;
+    int64_t m_keepFrom = 0;                     // Oldest position the next hop reads
+    std::vector<float> m_pullScratch;
+
+    // Analysis frames
+    int64_t m_nextFrame = 0;                    // Nominal start of the next frame
+    double m_hopRemainder = 0.0;
+    int32_t m_primingHop = 0;                   // Hop until the first segment is out
+    int64_t m_lastFrame = 0;                    // Chosen start of the last frame
+    int32_t m_lastHop = 0;
+    int64_t m_hops = 0;                         // Since reset
+    double m_centers[CENTER_HISTORY] = {};      // Input position at each frame's middle
+
+    // Phase vocoder state (bins = fftSize / 2 + 1)
+    std::vector<float> m_frame;
+    std::vector<float> m_specRe[MAX_CHANNELS];
+    std::vector<float> m_specIm[MAX_CHANNELS];
+    std::vector<float> m_midRe, m_midIm;
+    std::vector<float> m_prevMidRe, m_prevMidIm;
+    std::vector<float> m_magnitude, m_prevMagnitude;
+    std::vector<float> m_angle, m_prevAngle;    // Synthesis minus analysis phase per bin
+    std::vector<float> m_rotRe, m_rotIm;
+    std::vector<int32_t> m_peaks;
+
+    // WSOLA: mono sum over the search window and its running energy
+    std::vector<float> m_mono;
+    std::vector<double> m_energy;
+
+    // Overlap-add, per channel, fftSize long; the first hop is complete after each frame
+    std::vector<float> m_ola[MAX_CHANNELS];
+
+    // Stretched audio, per channel, absolute positions [m_stretchedBase, m_stretchedEnd)
+    std::vector<float> m_stretched[MAX_CHANNELS];
+    int32_t m_stretchedCapacity = 0;
+    int64_t m_stretchedBase = 0;
+    int64_t m_stretchedEnd = 0;
+    double m_readPosition = 0.0;                // Absolute stretched position of the next output frame
+    Segment m_segments[SEGMENT_HISTORY];        // Segment i covers [i * hop, (i + 1) * hop)
+    double m_nextSegmentStart = 0.0;
+
+    int32_t frameLength() const;
+    int overlap() const;
+    int32_t analysisHop();
+    bool fillInput(int64_t until, Pull pull, void* userData);
+    bool runHop(Pull pull, void* userData);
+    void vocoderFrame(int64_t start);
+    int64_t wsolaFrame(int64_t nominal);
+    void analyzePhases(int32_t hop);
+    void emitSegment();
+    const float* inputAt(int ch, int64_t position) const {
+        return m_input[ch].data() + (position - m_inputBase);
+    }
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_TIME_STRETCH_H
@@ -0,0 +1,254 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           TRUE-PEAK LIMITER - 4X OVERSAMPLED LOOKAHEAD      ║
+ * ║       Last Stage of the Chain: Nothing Leaves Above Ceiling ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Timing: the detector reports the interval ending DETECTION_DELAY frames
+ * back. With a lookahead of L frames the minimum runs over L + 2 required
+ * gains and the average over L + 1, so the gain applied to a sample that
+ * left the (L + DETECTION_DELAY + 1)-frame delay line is no larger than
+ * the requirement on either side of it.
+ */
+
+#include "TruePeakLimiter.h"
+#include "MixKernels.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_PEAK_NEON 1
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#define FTL_PEAK_SSE 1
+#endif
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr int OVERSAMPLING = 4;
+
+// Gain this close to unity snaps to it, so a released limiter is bit-transparent
+constexpr float UNITY_SNAP = 1e-6f;
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// DETECTOR
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+TruePeakDetector::TruePeakDetector() {
+    // Blackman-windowed sinc, 4 * TAPS - 1 long, centred on a tap of phase 3
+    constexpr int LENGTH = OVERSAMPLING * TAPS - 1;
+    constexpr int CENTER = LENGTH / 2;
+    double sums[OVERSAMPLING] = {};
+    double taps[TAPS][OVERSAMPLING] = {};
+    for (int j = 0; j < TAPS; ++j) {
+        for (int phase = 0; phase < OVERSAMPLING; ++phase) {
+            int k = phase + OVERSAMPLING * j;
+            if (k >= LENGTH) {
+                continue;
+            }
+            double t = static_cast<double>(k - CENTER) / OVERSAMPLING;
+            double sinc = t == 0.0 ? 1.0 : std::sin(M_PI * t) / (M_PI * t);
+            double x = 2.0 * M_PI * k / (LENGTH - 1);
+            double window = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+            taps[j][phase] = sinc * window;
+            sums[phase] += taps[j][phase];
+        }
+    }
+    // Unity DC gain on every phase
+    for (int j = 0; j < TAPS; ++j) {
+        for (int phase = 0; phase < OVERSAMPLING; ++phase) {
+            m_coefficients[j][phase] = static_cast<float>(taps[j][phase] / sums[phase]);
+        }
+    }
+}
+
+void TruePeakDetector::configure(int channelCount) {
+    m_channelCount = std::max(1, std::min(channelCount, MAX_CHANNELS));
+    reset();
+}
+
+void TruePeakDetector::reset() {
+    std::fill(&m_history[0][0], &m_history[0][0] + MAX_CHANNELS * TAPS * 2, 0.0f);
+    m_position = 0;
+}
+
+float TruePeakDetector::push(const float* frame) {
+    m_position = (m_position + TAPS - 1) % TAPS;
+    const int position = m_position;
+
+#if defined(FTL_PEAK_NEON)
+    float32x4_t peak = vdupq_n_f32(0.0f);
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        float* history = m_history[ch];
+        history[position] = history[position + TAPS] = frame[ch];
+        const float* x = history + position;
+        float32x4_t acc = vmulq_n_f32(vld1q_f32(m_coefficients[0]), x[0]);
+        for (int j = 1; j < TAPS; ++j) {
+            acc = vmlaq_n_f32(acc, vld1q_f32(m_coefficients[j]), x[j]);
+        }
+        peak = vmaxq_f32(peak, vabsq_f32(acc));
+    }
+    float32x2_t half = vmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+    return std::max(vget_lane_f32(half, 0), vget_lane_f32(half, 1));
+#elif defined(FTL_PEAK_SSE)
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 peak = _mm_setzero_ps();
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        float* history = m_history[ch];
+        history[position] = history[position + TAPS] = frame[ch];
+        const float* x = history + position;
+        __m128 acc = _mm_mul_ps(_mm_load_ps(m_coefficients[0]), _mm_set1_ps(x[0]));
+        for (int j = 1; j < TAPS; ++j) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(m_coefficients[j]), _mm_set1_ps(x[j])));
+        }
+        peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, acc));
+    }
+    peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+    peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, 1));
+    return _mm_cvtss_f32(peak);
+#else
+    float peak = 0.0f;
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        float* history = m_history[ch];
+        history[position] = history[position + TAPS] = frame[ch];
+        const float* x = history + position;
+        for (int phase = 0; phase < OVERSAMPLING; ++phase) {
+            float acc = 0.0f;
+            for (int j = 0; j < TAPS; ++j) {
+                acc += m_coefficients[j][phase] * x[j];
+            }
+            peak = std::max(peak, std::fabs(acc));
+        }
+    }
+    return peak;
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LIMITER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void TruePeakLimiter::configure(int sampleRate, int channelCount, float lookaheadMs, float releaseMs) {
+    m_detector.configure(channelCount);
+    m_channelCount = std::max(1, std::min(channelCount, TruePeakDetector::MAX_CHANNELS));
+    m_lookahead = std::max(1, static_cast<int32_t>(std::lround(lookaheadMs * sampleRate / 1000.0f)));
+    m_delayFrames = m_lookahead + TruePeakDetector::DETECTION_DELAY + 1;
+    m_releaseDecay = std::exp(-1.0f / std::max(1.0f, releaseMs * sampleRate / 1000.0f));
+
+    m_delay.assign(static_cast<size_t>(m_delayFrames) * m_channelCount, 0.0f);
+    m_minValue.assign(m_lookahead + 2, 1.0f);
+    m_minFrame.assign(m_lookahead + 2, 0);
+    m_average.assign(m_lookahead + 1, 1.0f);
+    setCeilingDb(m_ceilingDb);
+    reset();
+}
+
+void TruePeakLimiter::reset() {
+    m_detector.reset();
+    std::fill(m_delay.begin(), m_delay.end(), 0.0f);
+    std::fill(m_average.begin(), m_average.end(), 1.0f);
+    m_delayPosition = 0;
+    m_minHead = 0;
+    m_minCount = 0;
+    m_frame = 0;
+    m_averagePosition = 0;
+    m_averageSum = static_cast<double>(m_average.size());
+    m_reduction = 0.0f;
+    m_lastReductionDb = 0.0f;
+}
+
+void TruePeakLimiter::setCeilingDb(float ceilingDb) {
+    m_ceilingDb = std::min(ceilingDb, 0.0f);
+    m_ceiling = std::pow(10.0f, m_ceilingDb / 20.0f);
+}
+
+float TruePeakLimiter::nextGain(float peak) {
+    float required = peak > m_ceiling ? m_ceiling / peak : 1.0f;
+
+    // Sliding minimum over the last lookahead + 2 requirements
+    const int32_t window = static_cast<int32_t>(m_minValue.size());
+    while (m_minCount > 0) {
+        int32_t back = (m_minHead + m_minCount - 1) % window;
+        if (m_minValue[back] < required) {
+            break;
+        }
+        --m_minCount;
+    }
+    int32_t slot = (m_minHead + m_minCount) % window;
+    m_minValue[slot] = required;
+    m_minFrame[slot] = m_frame;
+    ++m_minCount;
+    if (m_minFrame[m_minHead] <= m_frame - window) {
+        m_minHead = (m_minHead + 1) % window;
+        --m_minCount;
+    }
+    float windowMin = m_minValue[m_minHead];
+    ++m_frame;
+
+    // Instant attack (the average does the smoothing), exponential release.
+    // Decaying the reduction rather than the gain keeps the tail exact in float.
+    m_reduction *= m_releaseDecay;
+    if (m_reduction < UNITY_SNAP) {
+        m_reduction = 0.0f;
+    }
+    float released = 1.0f - m_reduction;
+    if (windowMin < released) {
+        released = windowMin;
+        m_reduction = 1.0f - windowMin;
+    }
+
+    // Moving average over lookahead + 1; re-summed once per lap so it never drifts
+    const int32_t length = static_cast<int32_t>(m_average.size());
+    m_averageSum += released - m_average[m_averagePosition];
+    m_average[m_averagePosition] = released;
+    if (++m_averagePosition == length) {
+        m_averagePosition = 0;
+        m_averageSum = 0.0;
+        for (float value : m_average) {
+            m_averageSum += value;
+        }
+    }
+    return static_cast<float>(m_averageSum / length);
+}
+
+void TruePeakLimiter::process(float* buffer, int32_t frames) {
+    FTL_TRACE_SCOPE("limiter");
+    const int channelCount = m_channelCount;
+    float deepest = 1.0f;
+
+    while (frames > 0) {
+        int32_t block = std::min(frames, BLOCK_FRAMES);
+        float blockMin = 1.0f;
+        for (int32_t i = 0; i < block; ++i) {
+            float* frame = buffer + i * channelCount;
+            float gain = nextGain(m_detector.push(frame));
+            m_gains[i] = gain;
+            blockMin = std::min(blockMin, gain);
+
+            // Swap the frame with the one leaving the delay line
+            float* delayed = m_delay.data() + static_cast<size_t>(m_delayPosition) * channelCount;
+            for (int ch = 0; ch < channelCount; ++ch) {
+                std::swap(frame[ch], delayed[ch]);
+            }
+            if (++m_delayPosition == m_delayFrames) {
+                m_delayPosition = 0;
+            }
+        }
+        if (blockMin < 1.0f) {
+            mix::scaleFrames(buffer, m_gains, block, channelCount);
+            deepest = std::min(deepest, blockMin);
+        }
+        buffer += block * channelCount;
+        frames -= block;
+    }
+    m_lastReductionDb = 20.0f * std::log10(deepest);
+}
+
+} // namespace ftl_audio
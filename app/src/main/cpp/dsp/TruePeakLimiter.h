@@ -0,0 +1,115 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           TRUE-PEAK LIMITER - 4X OVERSAMPLED LOOKAHEAD      ║
+ * ║       Last Stage of the Chain: Nothing Leaves Above Ceiling ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Peaks are detected on a 4x polyphase interpolation of the signal (the
+ * BS.1770 true-peak method), so inter-sample overs that a DAC would
+ * reconstruct are caught as well. The required gain runs through a
+ * sliding minimum over the lookahead window and a moving average of the
+ * same length, which reaches the required gain by the time the peak
+ * leaves the delay line - no overshoot, no clicks. Below the ceiling the
+ * gain is exactly 1.0 and the limiter is a pure delay.
+ */
+
+#ifndef FTL_DSP_TRUE_PEAK_LIMITER_H
+#define FTL_DSP_TRUE_PEAK_LIMITER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ftl_audio {
+
+/**
+ * Per-frame true peak across channels, 4x oversampled
+ * The value returned by push() belongs to the input DETECTION_DELAY
+ * frames back (and the interval just before it).
+ */
+class TruePeakDetector {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr int TAPS = 12;                    // Per polyphase branch
+    static constexpr int DETECTION_DELAY = 5;
+
+    TruePeakDetector();
+
+    void configure(int channelCount);
+    void reset();
+
+    /** Feed one interleaved frame, return the largest |sample| of 4 interpolated points */
+    float push(const float* frame);
+
+private:
+    int m_channelCount = 0;
+    int m_position = 0;
+
+    // Lane r of tap j: coefficient j of phase r (phase 3 is the original sample)
+    alignas(16) float m_coefficients[TAPS][4];
+
+    // Per channel, written twice so the last TAPS inputs are always contiguous
+    alignas(16) float m_history[MAX_CHANNELS][TAPS * 2] = {};
+};
+
+class TruePeakLimiter {
+public:
+    static constexpr float DEFAULT_CEILING_DB = -1.0f;
+    static constexpr float DEFAULT_LOOKAHEAD_MS = 1.5f;
+    static constexpr float DEFAULT_RELEASE_MS = 80.0f;
+
+    /** Allocates the delay line; not on the audio thread */
+    void configure(int sampleRate, int channelCount,
+                   float lookaheadMs = DEFAULT_LOOKAHEAD_MS, float releaseMs = DEFAULT_RELEASE_MS);
+    void reset();
+
+    void setCeilingDb(float ceilingDb);
+    float ceilingDb() const { return m_ceilingDb; }
+
+    /** Frames between a sample going in and coming out */
+    int32_t latencyFrames() const { return m_delayFrames; }
+
+    /** Limit interleaved frames in place (delayed by latencyFrames()) */
+    void process(float* buffer, int32_t frames);
+
+    /** Deepest gain reduction in the last process() call, in dB (<= 0) */
+    float lastReductionDb() const { return m_lastReductionDb; }
+
+private:
+    static constexpr int32_t BLOCK_FRAMES = 128;
+
+    TruePeakDetector m_detector;
+    int m_channelCount = 0;
+    int32_t m_lookahead = 0;               // Averaging window, frames
+    int32_t m_delayFrames = 0;
+    float m_ceilingDb = DEFAULT_CEILING_DB;
+    float m_ceiling = 1.0f;
+    float m_releaseDecay = 0.0f;
+    float m_reduction = 0.0f;              // 1 - released gain
+    float m_lastReductionDb = 0.0f;
+
+    // Audio delay line, interleaved
+    std::vector<float> m_delay;
+    int32_t m_delayPosition = 0;
+
+    // Sliding minimum of the required gain (monotonic queue over a ring)
+    std::vector<float> m_minValue;
+    std::vector<int64_t> m_minFrame;
+    int32_t m_minHead = 0;
+    int32_t m_minCount = 0;
+    int64_t m_frame = 0;
+
+    // Moving average of the released gain
+    std::vector<float> m_average;
+    int32_t m_averagePosition = 0;
+    double m_averageSum = 0.0;
+
+    float m_gains[BLOCK_FRAMES];
+
+    float nextGain(float peak);
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_DSP_TRUE_PEAK_LIMITER_H
@@ -0,0 +1,444 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - HOST AAUDIO BACKEND           ║
+ * ║         Null Output Device Driving the Data Callback        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Each open stream owns a device thread that calls the data callback one
+ * burst at a time, either paced to wall clock (real-time behaviour for
+ * latency tests) or free-running (benchmarks). Output is discarded after
+ * the optional test tap has seen it. Tests can emulate the device's rate
+ * and format support and inject disconnects.
+ */
+
+#include <aaudio/AAudio.h>
+#include "HostAudioBackend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct AAudioStreamBuilderStruct {
+    int32_t deviceId = 0;
+    int32_t sampleRate = 48000;
+    int32_t channelCount = 2;
+    aaudio_format_t format = AAUDIO_FORMAT_PCM_FLOAT;
+    aaudio_performance_mode_t performanceMode = AAUDIO_PERFORMANCE_MODE_NONE;
+    aaudio_sharing_mode_t sharingMode = AAUDIO_SHARING_MODE_SHARED;
+    int32_t bufferCapacityFrames = 0;
+    int32_t framesPerCallback = 0;
+    AAudioStream_dataCallback dataCallback = nullptr;
+    void* dataUserData = nullptr;
+    AAudioStream_errorCallback errorCallback = nullptr;
+    void* errorUserData = nullptr;
+};
+
+struct AAudioStreamStruct {
+    AAudioStreamBuilderStruct config;
+    int32_t framesPerBurst = 256;
+    int32_t bufferSizeFrames = 512;
+    ftl_audio::host::BackendSettings settings;
+
+    std::mutex mutex;
+    std::condition_variable stateChanged;
+    aaudio_stream_state_t state = AAUDIO_STREAM_STATE_OPEN;
+    bool closing = false;
+    bool disconnectPending = false;
+    std::thread deviceThread;
+
+    std::atomic<int64_t> framesWritten{0};
+    std::atomic<int32_t> xrunCount{0};
+    Clock::time_point playStart;  // Wall time of stream frame 0 (pacing model)
+    std::vector<float> buffer;
+    std::vector<int16_t> pcm16;   // PCM_I16 streams: what the callback writes
+};
+
+namespace {
+
+std::mutex g_backendMutex;
+ftl_audio::host::BackendSettings g_settings;
+ftl_audio::host::OutputTap g_outputTap = nullptr;
+void* g_outputTapUserData = nullptr;
+ftl_audio::host::PresentationTap g_presentationTap = nullptr;
+void* g_presentationTapUserData = nullptr;
+std::atomic<AAudioStream*> g_lastOpenedStream{nullptr};
+
+int64_t framesToNanos(int64_t frames, int32_t sampleRate) {
+    return frames * 1000000000LL / sampleRate;
+}
+
+void setState(AAudioStream* stream, aaudio_stream_state_t state) {
+    stream->state = state;
+    stream->stateChanged.notify_all();
+}
+
+void deviceThreadMain(AAudioStream* stream) {
+    const int32_t burst = stream->framesPerBurst;
+    const int32_t channels = stream->config.channelCount;
+    const auto burstPeriod = std::chrono::nanoseconds(framesToNanos(burst, stream->config.sampleRate));
+    Clock::time_point deadline = Clock::now();
+
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    while (!stream->closing) {
+        if (stream->disconnectPending) {
+            // Like AAudio: the error callback runs off the data callback, and the
+            // stream must be closed from yet another thread
+            stream->disconnectPending = false;
+            setState(stream, AAUDIO_STREAM_STATE_DISCONNECTED);
+            if (stream->config.errorCallback) {
+                lock.unlock();
+                stream->config.errorCallback(stream, stream->config.errorUserData, AAUDIO_ERROR_DISCONNECTED);
+                lock.lock();
+            }
+            continue;
+        }
+        if (stream->state == AAUDIO_STREAM_STATE_STARTING) {
+            stream->playStart = Clock::now() - std::chrono::nanoseconds(
+                framesToNanos(stream->framesWritten.load(), stream->config.sampleRate));
+            deadline = Clock::now();
+            setState(stream, AAUDIO_STREAM_STATE_STARTED);
+        } else if (stream->state == AAUDIO_STREAM_STATE_PAUSING) {
+            setState(stream, AAUDIO_STREAM_STATE_PAUSED);
+        } else if (stream->state == AAUDIO_STREAM_STATE_STOPPING) {
+            setState(stream, AAUDIO_STREAM_STATE_STOPPED);
+        }
+
+        if (stream->state != AAUDIO_STREAM_STATE_STARTED) {
+            stream->stateChanged.wait(lock);
+            continue;
+        }
+
+        // Call out without holding the lock so control calls never wait on DSP
+        lock.unlock();
+        const bool pcm16 = stream->config.format == AAUDIO_FORMAT_PCM_I16;
+        void* audioData = pcm16 ? static_cast<void*>(stream->pcm16.data()) : stream->buffer.data();
+        aaudio_data_callback_result_t result = stream->config.dataCallback(
+            stream, stream->config.dataUserData, audioData, burst);
+        if (pcm16) {
+            for (size_t i = 0; i < stream->pcm16.size(); ++i) {
+                stream->buffer[i] = stream->pcm16[i] * (1.0f / 32768.0f);
+            }
+        }
+
+        int64_t position = stream->framesWritten.fetch_add(burst);
+        {
+            std::lock_guard<std::mutex> tapLock(g_backendMutex);
+            if (g_outputTap) {
+                g_outputTap(stream->buffer.data(), burst, channels, position, g_outputTapUserData);
+            }
+            if (g_presentationTap) {
+                // Same model as getTimestamp: frame F plays bufferSizeFrames after it was due
+                auto presented = stream->playStart + std::chrono::nanoseconds(
+                    framesToNanos(position + stream->bufferSizeFrames, stream->config.sampleRate));
+                g_presentationTap(stream, stream->buffer.data(), burst, channels,
+                                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      presented.time_since_epoch()).count(),
+                                  g_presentationTapUserData);
+            }
+        }
+
+        if (stream->settings.realtimePacing) {
+            deadline += burstPeriod;
+            auto now = Clock::now();
+            if (deadline < now) {
+                // Callback overran its period - the hardware would have glitched
+                stream->xrunCount.fetch_add(1);
+                deadline = now;
+            }
+            std::this_thread::sleep_until(deadline);
+        }
+        lock.lock();
+
+        if (result == AAUDIO_CALLBACK_RESULT_STOP && stream->state == AAUDIO_STREAM_STATE_STARTED) {
+            setState(stream, AAUDIO_STREAM_STATE_STOPPED);
+        }
+    }
+}
+
+aaudio_result_t requestState(AAudioStream* stream, aaudio_stream_state_t transient,
+                             std::initializer_list<aaudio_stream_state_t> allowedFrom) {
+    if (!stream) return AAUDIO_ERROR_INVALID_HANDLE;
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->state == AAUDIO_STREAM_STATE_DISCONNECTED) return AAUDIO_ERROR_DISCONNECTED;
+    if (std::find(allowedFrom.begin(), allowedFrom.end(), stream->state) == allowedFrom.end()) {
+        return AAUDIO_ERROR_INVALID_STATE;
+    }
+    setState(stream, transient);
+    return AAUDIO_OK;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// HOST CONTROLS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+namespace ftl_audio {
+namespace host {
+
+void setBackendSettings(const BackendSettings& settings) {
+    std::lock_guard<std::mutex> lock(g_backendMutex);
+    g_settings = settings;
+}
+
+BackendSettings getBackendSettings() {
+    std::lock_guard<std::mutex> lock(g_backendMutex);
+    return g_settings;
+}
+
+void setOutputTap(OutputTap tap, void* userData) {
+    std::lock_guard<std::mutex> lock(g_backendMutex);
+    g_outputTap = tap;
+    g_outputTapUserData = userData;
+}
+
+void setPresentationTap(PresentationTap tap, void* userData) {
+    std::lock_guard<std::mutex> lock(g_backendMutex);
+    g_presentationTap = tap;
+    g_presentationTapUserData = userData;
+}
+
+AAudioStream* getLastOpenedStream() {
+    return g_lastOpenedStream.load();
+}
+
+void injectDisconnect(AAudioStream* stream) {
+    if (!stream) return;
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->closing || stream->state == AAUDIO_STREAM_STATE_DISCONNECTED) return;
+    stream->disconnectPending = true;
+    stream->stateChanged.notify_all();
+}
+
+} // namespace host
+} // namespace ftl_audio
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// AAUDIO API
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+extern "C" {
+
+const char* AAudio_convertResultToText(aaudio_result_t returnCode) {
+    switch (returnCode) {
+        case AAUDIO_OK: return "AAUDIO_OK";
+        case AAUDIO_ERROR_DISCONNECTED: return "AAUDIO_ERROR_DISCONNECTED";
+        case AAUDIO_ERROR_ILLEGAL_ARGUMENT: return "AAUDIO_ERROR_ILLEGAL_ARGUMENT";
+        case AAUDIO_ERROR_INTERNAL: return "AAUDIO_ERROR_INTERNAL";
+        case AAUDIO_ERROR_INVALID_STATE: return "AAUDIO_ERROR_INVALID_STATE";
+        case AAUDIO_ERROR_INVALID_HANDLE: return "AAUDIO_ERROR_INVALID_HANDLE";
+        case AAUDIO_ERROR_UNIMPLEMENTED: return "AAUDIO_ERROR_UNIMPLEMENTED";
+        case AAUDIO_ERROR_UNAVAILABLE: return "AAUDIO_ERROR_UNAVAILABLE";
+        case AAUDIO_ERROR_NO_MEMORY: return "AAUDIO_ERROR_NO_MEMORY";
+        case AAUDIO_ERROR_TIMEOUT: return "AAUDIO_ERROR_TIMEOUT";
+        case AAUDIO_ERROR_INVALID_FORMAT: return "AAUDIO_ERROR_INVALID_FORMAT";
+        case AAUDIO_ERROR_OUT_OF_RANGE: return "AAUDIO_ERROR_OUT_OF_RANGE";
+        case AAUDIO_ERROR_INVALID_RATE: return "AAUDIO_ERROR_INVALID_RATE";
+        default: return "Unrecognized AAudio error";
+    }
+}
+
+const char* AAudio_convertStreamStateToText(aaudio_stream_state_t state) {
+    static const char* const names[] = {
+        "AAUDIO_STREAM_STATE_UNINITIALIZED", "AAUDIO_STREAM_STATE_UNKNOWN",
+        "AAUDIO_STREAM_STATE_OPEN", "AAUDIO_STREAM_STATE_STARTING",
+        "AAUDIO_STREAM_STATE_STARTED", "AAUDIO_STREAM_STATE_PAUSING",
+        "AAUDIO_STREAM_STATE_PAUSED", "AAUDIO_STREAM_STATE_FLUSHING",
+        "AAUDIO_STREAM_STATE_FLUSHED", "AAUDIO_STREAM_STATE_STOPPING",
+        "AAUDIO_STREAM_STATE_STOPPED", "AAUDIO_STREAM_STATE_CLOSING",
+        "AAUDIO_STREAM_STATE_CLOSED", "AAUDIO_STREAM_STATE_DISCONNECTED"
+    };
+    if (state < 0 || state > AAUDIO_STREAM_STATE_DISCONNECTED) return "Unrecognized AAudio state";
+    return names[state];
+}
+
+aaudio_result_t AAudio_createStreamBuilder(AAudioStreamBuilder** builder) {
+    *builder = new AAudioStreamBuilderStruct();
+    return AAUDIO_OK;
+}
+
+void AAudioStreamBuilder_setDeviceId(AAudioStreamBuilder* b, int32_t deviceId) { b->deviceId = deviceId; }
+void AAudioStreamBuilder_setDirection(AAudioStreamBuilder*, aaudio_direction_t) {}
+void AAudioStreamBuilder_setSampleRate(AAudioStreamBuilder* b, int32_t rate) { b->sampleRate = rate; }
+void AAudioStreamBuilder_setChannelCount(AAudioStreamBuilder* b, int32_t count) { b->channelCount = count; }
+void AAudioStreamBuilder_setFormat(AAudioStreamBuilder* b, aaudio_format_t format) { b->format = format; }
+void AAudioStreamBuilder_setPerformanceMode(AAudioStreamBuilder* b, aaudio_performance_mode_t mode) {
+    b->performanceMode = mode;
+}
+void AAudioStreamBuilder_setSharingMode(AAudioStreamBuilder* b, aaudio_sharing_mode_t mode) {
+    b->sharingMode = mode;
+}
+void AAudioStreamBuilder_setBufferCapacityInFrames(AAudioStreamBuilder* b, int32_t frames) {
+    b->bufferCapacityFrames = frames;
+}
+void AAudioStreamBuilder_setFramesPerDataCallback(AAudioStreamBuilder* b, int32_t frames) {
+    b->framesPerCallback = frames;
+}
+void AAudioStreamBuilder_setDataCallback(AAudioStreamBuilder* b, AAudioStream_dataCallback cb, void* user) {
+    b->dataCallback = cb;
+    b->dataUserData = user;
+}
+void AAudioStreamBuilder_setErrorCallback(AAudioStreamBuilder* b, AAudioStream_errorCallback cb, void* user) {
+    b->errorCallback = cb;
+    b->errorUserData = user;
+}
+
+aaudio_result_t AAudioStreamBuilder_openStream(AAudioStreamBuilder* builder, AAudioStream** streamOut) {
+    if (!builder || !streamOut) return AAUDIO_ERROR_ILLEGAL_ARGUMENT;
+    if (!builder->dataCallback) return AAUDIO_ERROR_UNIMPLEMENTED; // Blocking writes not emulated
+    if (builder->channelCount < 1 || builder->sampleRate < 8000) return AAUDIO_ERROR_ILLEGAL_ARGUMENT;
+    ftl_audio::host::BackendSettings settings = ftl_audio::host::getBackendSettings();
+    bool floatFormat = builder->format == AAUDIO_FORMAT_PCM_FLOAT;
+    if (!(floatFormat && settings.deviceSupportsFloat) && builder->format != AAUDIO_FORMAT_PCM_I16) {
+        return AAUDIO_ERROR_INVALID_FORMAT;
+    }
+
+    auto* stream = new AAudioStreamStruct();
+    stream->config = *builder;
+    stream->settings = settings;
+    // Exclusive (MMAP) streams get the hardware rate; the shared mixer resamples to the request
+    if (builder->sharingMode == AAUDIO_SHARING_MODE_EXCLUSIVE && settings.deviceSampleRate > 0) {
+        stream->config.sampleRate = settings.deviceSampleRate;
+    }
+    stream->framesPerBurst = builder->framesPerCallback > 0 ? builder->framesPerCallback : 192;
+    stream->bufferSizeFrames = std::max(builder->bufferCapacityFrames,
+                                        stream->framesPerBurst * stream->settings.presentationLatencyBursts);
+    stream->buffer.assign(static_cast<size_t>(stream->framesPerBurst) * builder->channelCount, 0.0f);
+    if (builder->format == AAUDIO_FORMAT_PCM_I16) {
+        stream->pcm16.assign(stream->buffer.size(), 0);
+    }
+    stream->deviceThread = std::thread(deviceThreadMain, stream);
+
+    g_lastOpenedStream.store(stream);
+    *streamOut = stream;
+    return AAUDIO_OK;
+}
+
+aaudio_result_t AAudioStreamBuilder_delete(AAudioStreamBuilder* builder) {
+    delete builder;
+    return AAUDIO_OK;
+}
+
+aaudio_result_t AAudioStream_requestStart(AAudioStream* stream) {
+    return requestState(stream, AAUDIO_STREAM_STATE_STARTING,
+                        {AAUDIO_STREAM_STATE_OPEN, AAUDIO_STREAM_STATE_PAUSED,
+                         AAUDIO_STREAM_STATE_STOPPED, AAUDIO_STREAM_STATE_STARTED});
+}
+
+aaudio_result_t AAudioStream_requestPause(AAudioStream* stream) {
+    return requestState(stream, AAUDIO_STREAM_STATE_PAUSING,
+                        {AAUDIO_STREAM_STATE_STARTED, AAUDIO_STREAM_STATE_STARTING,
+                         AAUDIO_STREAM_STATE_PAUSED});
+}
+
+aaudio_result_t AAudioStream_requestStop(AAudioStream* stream) {
+    return requestState(stream, AAUDIO_STREAM_STATE_STOPPING,
+                        {AAUDIO_STREAM_STATE_STARTED, AAUDIO_STREAM_STATE_STARTING,
+                         AAUDIO_STREAM_STATE_PAUSING, AAUDIO_STREAM_STATE_PAUSED,
+                         AAUDIO_STREAM_STATE_OPEN, AAUDIO_STREAM_STATE_STOPPING,
+                         AAUDIO_STREAM_STATE_STOPPED});
+}
+
+aaudio_result_t AAudioStream_waitForStateChange(AAudioStream* stream,
+                                                aaudio_stream_state_t inputState,
+                                                aaudio_stream_state_t* nextState,
+                                                int64_t timeoutNanoseconds) {
+    if (!stream) return AAUDIO_ERROR_INVALID_HANDLE;
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    bool changed = stream->stateChanged.wait_for(lock, std::chrono::nanoseconds(timeoutNanoseconds),
+                                                 [&] { return stream->state != inputState; });
+    if (nextState) *nextState = stream->state;
+    return changed ? AAUDIO_OK : AAUDIO_ERROR_TIMEOUT;
+}
+
+aaudio_result_t AAudioStream_close(AAudioStream* stream) {
+    if (!stream) return AAUDIO_ERROR_INVALID_HANDLE;
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        stream->closing = true;
+        setState(stream, AAUDIO_STREAM_STATE_CLOSING);
+    }
+    if (stream->deviceThread.joinable()) {
+        stream->deviceThread.join();
+    }
+    AAudioStream* expected = stream;
+    g_lastOpenedStream.compare_exchange_strong(expected, nullptr);
+    delete stream;
+    return AAUDIO_OK;
+}
+
+aaudio_stream_state_t AAudioStream_getState(AAudioStream* stream) {
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    return stream->state;
+}
+
+int32_t AAudioStream_getSampleRate(AAudioStream* stream) { return stream->config.sampleRate; }
+int32_t AAudioStream_getChannelCount(AAudioStream* stream) { return stream->config.channelCount; }
+int32_t AAudioStream_getFramesPerBurst(AAudioStream* stream) { return stream->framesPerBurst; }
+int32_t AAudioStream_getBufferSizeInFrames(AAudioStream* stream) { return stream->bufferSizeFrames; }
+int32_t AAudioStream_getBufferCapacityInFrames(AAudioStream* stream) {
+    return std::max(stream->config.bufferCapacityFrames, stream->bufferSizeFrames);
+}
+
+aaudio_result_t AAudioStream_setBufferSizeInFrames(AAudioStream* stream, int32_t numFrames) {
+    stream->bufferSizeFrames = std::max(stream->framesPerBurst,
+                                        std::min(numFrames, AAudioStream_getBufferCapacityInFrames(stream)));
+    return stream->bufferSizeFrames;
+}
+
+aaudio_performance_mode_t AAudioStream_getPerformanceMode(AAudioStream* stream) {
+    return stream->config.performanceMode;
+}
+
+aaudio_sharing_mode_t AAudioStream_getSharingMode(AAudioStream* stream) {
+    return stream->config.sharingMode;
+}
+
+aaudio_format_t AAudioStream_getFormat(AAudioStream* stream) { return stream->config.format; }
+
+int64_t AAudioStream_getFramesWritten(AAudioStream* stream) { return stream->framesWritten.load(); }
+
+int64_t AAudioStream_getFramesRead(AAudioStream* stream) {
+    return std::max<int64_t>(0, stream->framesWritten.load() - stream->bufferSizeFrames);
+}
+
+int32_t AAudioStream_getXRunCount(AAudioStream* stream) { return stream->xrunCount.load(); }
+
+aaudio_result_t AAudioStream_getTimestamp(AAudioStream* stream, clockid_t /* clockid */,
+                                          int64_t* framePosition, int64_t* timeNanoseconds) {
+    if (!stream) return AAUDIO_ERROR_INVALID_HANDLE;
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->state != AAUDIO_STREAM_STATE_STARTED) return AAUDIO_ERROR_INVALID_STATE;
+
+    // Frame F leaves the "DAC" bufferSizeFrames after the callback produced it
+    auto now = Clock::now();
+    int64_t written = stream->framesWritten.load();
+    int64_t presented;
+    if (stream->settings.realtimePacing) {
+        int64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - stream->playStart).count();
+        presented = elapsedNs * stream->config.sampleRate / 1000000000LL - stream->bufferSizeFrames;
+        if (presented > written - stream->bufferSizeFrames) {
+            // Callbacks running late: report the last written frame at its own time, not now
+            presented = written - stream->bufferSizeFrames;
+            now = stream->playStart + std::chrono::nanoseconds(
+                framesToNanos(presented + stream->bufferSizeFrames, stream->config.sampleRate));
+        }
+    } else {
+        presented = written - stream->bufferSizeFrames;
+    }
+
+    *framePosition = std::max<int64_t>(0, presented);
+    *timeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    return AAUDIO_OK;
+}
+
+} // extern "C"
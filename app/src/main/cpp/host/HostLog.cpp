@@ -0,0 +1,45 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - HOST LOG BACKEND             ║
+ * ║              stderr Sink for Desktop Test Builds            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include <android/log.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+int minimumPriority() {
+    static const int priority = std::getenv("FTL_HOST_LOG_VERBOSE") ? ANDROID_LOG_VERBOSE : ANDROID_LOG_WARN;
+    return priority;
+}
+
+char priorityLetter(int prio) {
+    static const char letters[] = "??VDIWEFS";
+    return (prio >= 0 && prio <= ANDROID_LOG_SILENT) ? letters[prio] : '?';
+}
+
+} // namespace
+
+extern "C" {
+
+int __android_log_write(int prio, const char* tag, const char* text) {
+    if (prio < minimumPriority()) return 0;
+    return std::fprintf(stderr, "%c/%s: %s\n", priorityLetter(prio), tag ? tag : "", text ? text : "");
+}
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    if (prio < minimumPriority()) return 0;
+    char message[1024];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+    return __android_log_write(prio, tag, message);
+}
+
+} // extern "C"
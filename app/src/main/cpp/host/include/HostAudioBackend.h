@@ -0,0 +1,68 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          FTL AUDIO ENGINE - HOST BACKEND CONTROLS           ║
+ * ║            Test Hooks for the Null Output Device            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Host-only extensions to the AAudio shim. Tests and benchmarks use these
+ * to pace the null device, observe rendered output and emulate device
+ * events. None of this exists on Android.
+ */
+
+#ifndef FTL_HOST_AUDIO_BACKEND_H
+#define FTL_HOST_AUDIO_BACKEND_H
+
+#include <aaudio/AAudio.h>
+
+namespace ftl_audio {
+namespace host {
+
+/**
+ * Observer for every burst the null device pulls from the data callback.
+ * Runs on the callback thread right after the engine returns.
+ */
+using OutputTap = void (*)(const float* frames, int32_t numFrames, int32_t channelCount,
+                           int64_t streamFramePosition, void* userData);
+
+/**
+ * Same bursts, tagged with their stream and the steady-clock time their
+ * first frame reaches the "speaker" (paced streams). Lets a test line up
+ * two streams playing at once.
+ */
+using PresentationTap = void (*)(AAudioStream* stream, const float* frames, int32_t numFrames,
+                                 int32_t channelCount, int64_t presentationTimeNs, void* userData);
+
+/**
+ * Global backend behaviour applied to streams opened afterwards
+ */
+struct BackendSettings {
+    bool realtimePacing = true;     // Sleep one burst period between callbacks
+    int32_t presentationLatencyBursts = 2; // Frames in flight behind the callback
+
+    // Emulated output device
+    int32_t deviceSampleRate = 0;   // Exclusive streams run at this rate, shared ones resample; 0: any rate
+    bool deviceSupportsFloat = true; // False: only PCM_I16 streams open (the tap still sees float)
+};
+
+void setBackendSettings(const BackendSettings& settings);
+BackendSettings getBackendSettings();
+
+void setOutputTap(OutputTap tap, void* userData);
+void setPresentationTap(PresentationTap tap, void* userData);
+
+/** Most recently opened stream, or nullptr */
+AAudioStream* getLastOpenedStream();
+
+/**
+ * Route change (headphones unplugged, USB DAC switched): the stream stops
+ * calling back, turns DISCONNECTED and reports AAUDIO_ERROR_DISCONNECTED
+ * to its error callback from the device thread, as AAudio does.
+ */
+void injectDisconnect(AAudioStream* stream);
+
+} // namespace host
+} // namespace ftl_audio
+
+#endif // FTL_HOST_AUDIO_BACKEND_H
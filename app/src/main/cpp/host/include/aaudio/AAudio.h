@@ -0,0 +1,154 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - HOST AAUDIO BACKEND           ║
+ * ║          AAudio API Subset for Desktop Test Builds          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Only used when building outside the NDK. Declares the slice of the
+ * AAudio C API the engine calls, backed by a null output device that
+ * drives the data callback from its own thread (see HostAAudio.cpp).
+ * Values mirror the NDK header so logs and error codes read the same.
+ */
+
+#ifndef FTL_HOST_AAUDIO_H
+#define FTL_HOST_AAUDIO_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t aaudio_result_t;
+typedef int32_t aaudio_stream_state_t;
+typedef int32_t aaudio_data_callback_result_t;
+typedef int32_t aaudio_performance_mode_t;
+typedef int32_t aaudio_sharing_mode_t;
+typedef int32_t aaudio_direction_t;
+typedef int32_t aaudio_format_t;
+
+typedef struct AAudioStreamStruct AAudioStream;
+typedef struct AAudioStreamBuilderStruct AAudioStreamBuilder;
+
+enum {
+    AAUDIO_OK = 0,
+    AAUDIO_ERROR_BASE = -900,
+    AAUDIO_ERROR_DISCONNECTED = -899,
+    AAUDIO_ERROR_ILLEGAL_ARGUMENT = -898,
+    AAUDIO_ERROR_INTERNAL = -896,
+    AAUDIO_ERROR_INVALID_STATE = -895,
+    AAUDIO_ERROR_INVALID_HANDLE = -892,
+    AAUDIO_ERROR_UNIMPLEMENTED = -890,
+    AAUDIO_ERROR_UNAVAILABLE = -889,
+    AAUDIO_ERROR_NO_MEMORY = -887,
+    AAUDIO_ERROR_TIMEOUT = -885,
+    AAUDIO_ERROR_INVALID_FORMAT = -883,
+    AAUDIO_ERROR_OUT_OF_RANGE = -882,
+    AAUDIO_ERROR_INVALID_RATE = -880
+};
+
+enum {
+    AAUDIO_STREAM_STATE_UNINITIALIZED = 0,
+    AAUDIO_STREAM_STATE_UNKNOWN,
+    AAUDIO_STREAM_STATE_OPEN,
+    AAUDIO_STREAM_STATE_STARTING,
+    AAUDIO_STREAM_STATE_STARTED,
+    AAUDIO_STREAM_STATE_PAUSING,
+    AAUDIO_STREAM_STATE_PAUSED,
+    AAUDIO_STREAM_STATE_FLUSHING,
+    AAUDIO_STREAM_STATE_FLUSHED,
+    AAUDIO_STREAM_STATE_STOPPING,
+    AAUDIO_STREAM_STATE_STOPPED,
+    AAUDIO_STREAM_STATE_CLOSING,
+    AAUDIO_STREAM_STATE_CLOSED,
+    AAUDIO_STREAM_STATE_DISCONNECTED
+};
+
+enum {
+    AAUDIO_CALLBACK_RESULT_CONTINUE = 0,
+    AAUDIO_CALLBACK_RESULT_STOP
+};
+
+enum {
+    AAUDIO_PERFORMANCE_MODE_NONE = 10,
+    AAUDIO_PERFORMANCE_MODE_POWER_SAVING,
+    AAUDIO_PERFORMANCE_MODE_LOW_LATENCY
+};
+
+enum {
+    AAUDIO_SHARING_MODE_EXCLUSIVE = 0,
+    AAUDIO_SHARING_MODE_SHARED
+};
+
+enum {
+    AAUDIO_DIRECTION_OUTPUT = 0,
+    AAUDIO_DIRECTION_INPUT
+};
+
+enum {
+    AAUDIO_FORMAT_INVALID = -1,
+    AAUDIO_FORMAT_UNSPECIFIED = 0,
+    AAUDIO_FORMAT_PCM_I16,
+    AAUDIO_FORMAT_PCM_FLOAT
+};
+
+typedef aaudio_data_callback_result_t (*AAudioStream_dataCallback)(
+    AAudioStream* stream, void* userData, void* audioData, int32_t numFrames);
+typedef void (*AAudioStream_errorCallback)(
+    AAudioStream* stream, void* userData, aaudio_result_t error);
+
+// Utilities
+const char* AAudio_convertResultToText(aaudio_result_t returnCode);
+const char* AAudio_convertStreamStateToText(aaudio_stream_state_t state);
+
+// Builder
+aaudio_result_t AAudio_createStreamBuilder(AAudioStreamBuilder** builder);
+void AAudioStreamBuilder_setDeviceId(AAudioStreamBuilder* builder, int32_t deviceId);
+void AAudioStreamBuilder_setDirection(AAudioStreamBuilder* builder, aaudio_direction_t direction);
+void AAudioStreamBuilder_setSampleRate(AAudioStreamBuilder* builder, int32_t sampleRate);
+void AAudioStreamBuilder_setChannelCount(AAudioStreamBuilder* builder, int32_t channelCount);
+void AAudioStreamBuilder_setFormat(AAudioStreamBuilder* builder, aaudio_format_t format);
+void AAudioStreamBuilder_setPerformanceMode(AAudioStreamBuilder* builder, aaudio_performance_mode_t mode);
+void AAudioStreamBuilder_setSharingMode(AAudioStreamBuilder* builder, aaudio_sharing_mode_t sharingMode);
+void AAudioStreamBuilder_setBufferCapacityInFrames(AAudioStreamBuilder* builder, int32_t numFrames);
+void AAudioStreamBuilder_setFramesPerDataCallback(AAudioStreamBuilder* builder, int32_t numFrames);
+void AAudioStreamBuilder_setDataCallback(AAudioStreamBuilder* builder,
+                                         AAudioStream_dataCallback callback, void* userData);
+void AAudioStreamBuilder_setErrorCallback(AAudioStreamBuilder* builder,
+                                          AAudioStream_errorCallback callback, void* userData);
+aaudio_result_t AAudioStreamBuilder_openStream(AAudioStreamBuilder* builder, AAudioStream** stream);
+aaudio_result_t AAudioStreamBuilder_delete(AAudioStreamBuilder* builder);
+
+// Stream
+aaudio_result_t AAudioStream_requestStart(AAudioStream* stream);
+aaudio_result_t AAudioStream_requestPause(AAudioStream* stream);
+aaudio_result_t AAudioStream_requestStop(AAudioStream* stream);
+aaudio_result_t AAudioStream_waitForStateChange(AAudioStream* stream,
+                                                aaudio_stream_state_t inputState,
+                                                aaudio_stream_state_t* nextState,
+                                                int64_t timeoutNanoseconds);
+aaudio_result_t AAudioStream_close(AAudioStream* stream);
+aaudio_stream_state_t AAudioStream_getState(AAudioStream* stream);
+int32_t AAudioStream_getSampleRate(AAudioStream* stream);
+int32_t AAudioStream_getChannelCount(AAudioStream* stream);
+int32_t AAudioStream_getFramesPerBurst(AAudioStream* stream);
+int32_t AAudioStream_getBufferSizeInFrames(AAudioStream* stream);
+int32_t AAudioStream_getBufferCapacityInFrames(AAudioStream* stream);
+aaudio_result_t AAudioStream_setBufferSizeInFrames(AAudioStream* stream, int32_t numFrames);
+aaudio_performance_mode_t AAudioStream_getPerformanceMode(AAudioStream* stream);
+aaudio_sharing_mode_t AAudioStream_getSharingMode(AAudioStream* stream);
+aaudio_format_t AAudioStream_getFormat(AAudioStream* stream);
+int64_t AAudioStream_getFramesWritten(AAudioStream* stream);
+int64_t AAudioStream_getFramesRead(AAudioStream* stream);
+int32_t AAudioStream_getXRunCount(AAudioStream* stream);
+aaudio_result_t AAudioStream_getTimestamp(AAudioStream* stream, clockid_t clockid,
+                                          int64_t* framePosition, int64_t* timeNanoseconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FTL_HOST_AAUDIO_H
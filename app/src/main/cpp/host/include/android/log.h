@@ -0,0 +1,39 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - HOST LOG BACKEND             ║
+ * ║          Android Logging Subset for Desktop Builds          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Routes __android_log_print to stderr. Messages below WARN are dropped
+ * unless FTL_HOST_LOG_VERBOSE is set in the environment.
+ */
+
+#ifndef FTL_HOST_ANDROID_LOG_H
+#define FTL_HOST_ANDROID_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT
+} android_LogPriority;
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+int __android_log_write(int prio, const char* tag, const char* text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FTL_HOST_ANDROID_LOG_H
@@ -18,8 +18,18 @@
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
 
 #include "../audio_engine/FTLAudioEngine.h"
+#include "../audio_engine/QualityMeasurement.h"
+#include "../decoder/SeekIndex.h"
+#include "../decoder/TrackMetadata.h"
+#include "../decoder/WaveformPyramid.h"
+#include "../utils/LogUtils.h"
+#include "../utils/TraceRecorder.h"
 #include "jni_helpers.h"
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -27,9 +37,9 @@
 // ═══════════════════════════════════════════════════════════════════════════════════
 
 #define LOG_TAG "FTL_Audio_JNI"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGI(...) FTL_LOGI(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) FTL_LOGE(LOG_TAG, __VA_ARGS__)
+#define LOGD(...) FTL_LOGD(LOG_TAG, __VA_ARGS__)
 
 // Namespace for all FTL audio functions
 namespace ftl_audio {
@@ -63,11 +73,44 @@ jlong generateEngineHandle() {
 
 extern "C" {
 
+/**
+ * Library load hook - resolves class/method IDs once so that polling
+ * paths never call FindClass/GetMethodID
+ */
+JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM* vm, void* /* reserved */) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        LOGE("Failed to obtain JNIEnv in JNI_OnLoad");
+        return JNI_ERR;
+    }
+    
+    if (!ftl_audio::initializeJniCache(env)) {
+        LOGE("Failed to cache JNI IDs - metrics objects will be unavailable");
+    }
+    
+    return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL
+JNI_OnUnload(JavaVM* vm, void* /* reserved */) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        ftl_audio::releaseJniCache(env);
+    }
+}
+
 /**
  * Initialize native audio engine
+ * With prewarmStream the device stream opens in the background and idles on
+ * silence, so this returns before the device is up and the first play is instant.
+ * With burstPrefetch files are read and decoded seconds ahead in large batches.
+ * The decode ring is always sized for the power-saving output mode, so the
+ * app can switch to it when the screen turns off.
  * 
  * Java signature: 
- * nativeInitializeEngine(sampleRate: Int, framesPerBurst: Int, channelCount: Int, format: Int, deviceId: Int): Long
+ * nativeInitializeEngine(sampleRate: Int, framesPerBurst: Int, channelCount: Int, format: Int, deviceId: Int,
+ *                        prewarmStream: Boolean, burstPrefetch: Boolean): Long
  */
 JNIEXPORT jlong JNICALL
 Java_com_ftl_audioplayer_audio_AudioEngine_nativeInitializeEngine(
@@ -77,8 +120,11 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeInitializeEngine(
     jint framesPerBurst, 
     jint channelCount,
     jint format,
-    jint deviceId
+    jint deviceId,
+    jboolean prewarmStream,
+    jboolean burstPrefetch
 ) {
+    FTL_TRACE_SCOPE("jni.nativeInitializeEngine");
     LOGI("Initializing FTL Audio Engine: SR=%d, Frames=%d, Channels=%d", 
          sampleRate, framesPerBurst, channelCount);
     
@@ -95,6 +141,10 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeInitializeEngine(
         config.deviceId = deviceId;
         config.enableLowLatency = true;
         config.targetLatencyMs = 10.0; // <10ms target
+        config.prewarmStream = prewarmStream == JNI_TRUE;
+        config.burstPrefetch = burstPrefetch == JNI_TRUE;
+        config.enablePowerSaving = true;
+        config.enableTimeStretch = true;
         
         // Initialize the engine
         auto result = engine->initialize(config);
@@ -120,85 +170,57 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeInitializeEngine(
 }
 
 /**
- * Start playback on native engine
+ * Post a playback command to the engine's control thread; never blocks
+ * @param action ControlAction: 0 start, 1 stop, 2 pause, 3 resume, 4 seek (source frame), 5 output mode
+ * @return Token for nativeAwaitCommand, or 0 if it couldn't be posted
  */
-JNIEXPORT jboolean JNICALL
-Java_com_ftl_audioplayer_audio_AudioEngine_nativeStartPlayback(
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativePostCommand(
     JNIEnv *env, 
     jobject /* this */,
-    jlong engineHandle
+    jlong engineHandle,
+    jint action,
+    jlong argument
 ) {
+    FTL_TRACE_SCOPE("jni.nativePostCommand");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
     if (!engine) {
-        LOGE("Invalid engine handle for start playback: %lld", engineHandle);
-        return JNI_FALSE;
-    }
-    
-    auto result = engine->startPlayback();
-    if (result == ftl_audio::EngineResult::SUCCESS) {
-        LOGI("Playback started successfully");
-        return JNI_TRUE;
-    } else {
-        LOGE("Failed to start playback: %d", static_cast<int>(result));
-        return JNI_FALSE;
+        LOGE("Invalid engine handle for post command: %lld", engineHandle);
+        return 0;
     }
-}
-
-/**
- * Stop playback on native engine
- */
-JNIEXPORT jboolean JNICALL
-Java_com_ftl_audioplayer_audio_AudioEngine_nativeStopPlayback(
-    JNIEnv *env, 
-    jobject /* this */,
-    jlong engineHandle
-) {
-    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
-    if (!engine) {
-        LOGE("Invalid engine handle for stop playback: %lld", engineHandle);
-        return JNI_FALSE;
+    if (action < static_cast<jint>(ftl_audio::ControlAction::START) ||
+        action > static_cast<jint>(ftl_audio::ControlAction::SET_OUTPUT_MODE)) {
+        LOGE("Unknown control action: %d", action);
+        return 0;
     }
     
-    auto result = engine->stopPlayback();
-    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+    return static_cast<jlong>(engine->postCommand(static_cast<ftl_audio::ControlAction>(action),
+                                                  static_cast<int64_t>(argument)));
 }
 
 /**
- * Pause playback on native engine
+ * Wait up to timeoutMs for a posted command
+ * @return EngineResult code, or Int.MIN_VALUE while it is still pending
  */
-JNIEXPORT jboolean JNICALL
-Java_com_ftl_audioplayer_audio_AudioEngine_nativePausePlayback(
+JNIEXPORT jint JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeAwaitCommand(
     JNIEnv *env, 
     jobject /* this */,
-    jlong engineHandle
+    jlong engineHandle,
+    jlong token,
+    jint timeoutMs
 ) {
+    FTL_TRACE_SCOPE("jni.nativeAwaitCommand");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
     if (!engine) {
-        LOGE("Invalid engine handle for pause playback: %lld", engineHandle);
-        return JNI_FALSE;
+        return static_cast<jint>(ftl_audio::EngineResult::ERROR_NOT_INITIALIZED);
     }
     
-    auto result = engine->pausePlayback();
-    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
-}
-
-/**
- * Resume playback on native engine
- */
-JNIEXPORT jboolean JNICALL
-Java_com_ftl_audioplayer_audio_AudioEngine_nativeResumePlayback(
-    JNIEnv *env, 
-    jobject /* this */,
-    jlong engineHandle
-) {
-    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
-    if (!engine) {
-        LOGE("Invalid engine handle for resume playback: %lld", engineHandle);
-        return JNI_FALSE;
+    ftl_audio::EngineResult result = ftl_audio::EngineResult::SUCCESS;
+    if (!engine->awaitCommand(static_cast<ftl_audio::ControlToken>(token), timeoutMs, &result)) {
+        return std::numeric_limits<jint>::min();
     }
-    
-    auto result = engine->resumePlayback();
-    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+    return static_cast<jint>(result);
 }
 
 /**
@@ -215,6 +237,7 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeProcessAudioBuffer(
     jint sampleRate,
     jint channelCount
 ) {
+    FTL_TRACE_SCOPE("jni.nativeProcessAudioBuffer");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
     if (!engine) {
         LOGE("Invalid engine handle for process audio buffer: %lld", engineHandle);
@@ -276,15 +299,51 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeMeasureLatency(
     jobject /* this */,
     jlong engineHandle
 ) {
+    FTL_TRACE_SCOPE("jni.nativeMeasureLatency");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
     if (!engine) {
         LOGE("Invalid engine handle for measure latency: %lld", engineHandle);
         return -1.0;
     }
     
-    double latencyMs = engine->measureLatency();
-    LOGI("Measured audio latency: %.2f ms", latencyMs);
-    return latencyMs;
+    // Polled from the UI - result is published in the snapshot, no per-call logging
+    return engine->measureLatency();
+}
+
+/**
+ * Wake-ups and CPU time spent in one output mode since initialize
+ * @return [callbacks, audioSeconds, callbackCpuMs, decodeCpuMs, decodeWakeups,
+ *          callbacksPerSecond, cpuMsPerAudioMinute]
+ */
+JNIEXPORT jdoubleArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetOutputModeActivity(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean powerSaving
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetOutputModeActivity");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return nullptr;
+    }
+    
+    ftl_audio::OutputModeActivity activity = engine->getOutputModeActivity(
+        powerSaving == JNI_TRUE ? ftl_audio::OutputMode::POWER_SAVING : ftl_audio::OutputMode::LOW_LATENCY);
+    const jdouble values[] = {
+        static_cast<jdouble>(activity.callbacks),
+        activity.audioSeconds,
+        activity.callbackCpuMs,
+        activity.decodeCpuMs,
+        static_cast<jdouble>(activity.decodeWakeups),
+        activity.callbacksPerSecond,
+        activity.cpuMsPerAudioMinute
+    };
+    jdoubleArray array = env->NewDoubleArray(7);
+    if (array) {
+        env->SetDoubleArrayRegion(array, 0, 7, values);
+    }
+    return array;
 }
 
 /**
@@ -297,6 +356,7 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetPerformanceMetrics(
     jobject /* this */,
     jlong engineHandle
 ) {
+    FTL_TRACE_SCOPE("jni.nativeGetPerformanceMetrics");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
     if (!engine) {
         LOGE("Invalid engine handle for get performance metrics: %lld", engineHandle);
@@ -310,28 +370,907 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetPerformanceMetrics(
 }
 
 /**
- * Update native engine configuration
+ * Expose the engine's seqlock snapshot as a direct ByteBuffer
+ * Called once per engine; Kotlin then reads metrics, state, playhead,
+ * peaks and latency without any further JNI transitions.
+ * The buffer is only valid until nativeShutdownEngine for this handle.
+ */
+JNIEXPORT jobject JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetSnapshotBuffer(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetSnapshotBuffer");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        LOGE("Invalid engine handle for snapshot buffer: %lld", engineHandle);
+        return nullptr;
+    }
+    
+    return env->NewDirectByteBuffer(
+        engine->getSnapshotBuffer(),
+        static_cast<jlong>(ftl_audio::FTLAudioEngine::getSnapshotBufferSize())
+    );
+}
+
+/**
+ * Acquire fence for EngineSnapshotReader below API 33 (NativeReadFence, no VarHandle fences):
+ * orders the snapshot payload loads against the seqlock's sequence loads
+ */
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_audio_NativeReadFence_nativeAcquireFence(
+    JNIEnv* /* env */,
+    jobject /* this */
+) {
+    FTL_TRACE_SCOPE("jni.nativeAcquireFence");
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+/**
+ * Post a WAV/FLAC file as the engine's source (decoded natively); never blocks
+ * Runs on the control thread in order with the other commands
+ * @return Token for nativeAwaitCommand, or 0 if it couldn't be posted
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativePostAudioSource(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jstring filePath
+) {
+    FTL_TRACE_SCOPE("jni.nativePostAudioSource");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || !filePath) {
+        LOGE("Invalid arguments for set audio source: %lld", engineHandle);
+        return 0;
+    }
+    
+    const char* path = env->GetStringUTFChars(filePath, nullptr);
+    if (!path) {
+        return 0;
+    }
+    std::string pathString(path);
+    env->ReleaseStringUTFChars(filePath, path);
+    
+    return static_cast<jlong>(engine->postAudioSource(pathString));
+}
+
+/**
+ * Directory for sidecar seek indexes (built on first play of a long FLAC)
+ */
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetSeekIndexDirectory(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jstring directory
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetSeekIndexDirectory");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || !directory) {
+        return;
+    }
+    
+    const char* path = env->GetStringUTFChars(directory, nullptr);
+    if (path) {
+        engine->setSeekIndexDirectory(path);
+        env->ReleaseStringUTFChars(directory, path);
+    }
+}
+
+/**
+ * Queue the next track: opened with its first burst at the decode thread's next batch
  */
 JNIEXPORT jboolean JNICALL
-Java_com_ftl_audioplayer_audio_AudioEngine_nativeUpdateConfiguration(
+Java_com_ftl_audioplayer_audio_AudioEngine_nativePrefetchNextSource(
     JNIEnv *env, 
     jobject /* this */,
     jlong engineHandle,
-    jobject configObject
+    jstring filePath
 ) {
+    FTL_TRACE_SCOPE("jni.nativePrefetchNextSource");
     auto* engine = ftl_audio::getEngineByHandle(engineHandle);
-    if (!engine) {
-        LOGE("Invalid engine handle for update configuration: %lld", engineHandle);
+    if (!engine || !filePath) {
+        return JNI_FALSE;
+    }
+    
+    const char* path = env->GetStringUTFChars(filePath, nullptr);
+    if (!path) {
+        return JNI_FALSE;
+    }
+    auto result = engine->prefetchNextSource(path);
+    env->ReleaseStringUTFChars(filePath, path);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Build a sidecar seek index ahead of playback (library scan)
+ * Blocking: call from a background thread
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeBuildSeekIndex(
+    JNIEnv *env, 
+    jobject /* this */,
+    jstring filePath,
+    jstring directory
+) {
+    FTL_TRACE_SCOPE("jni.nativeBuildSeekIndex");
+    if (!filePath || !directory) {
         return JNI_FALSE;
     }
     
-    // Convert Kotlin configuration object to C++ config
-    auto config = ftl_audio::extractAudioEngineConfiguration(env, configObject);
+    const char* source = env->GetStringUTFChars(filePath, nullptr);
+    const char* dir = env->GetStringUTFChars(directory, nullptr);
+    bool built = false;
+    if (source && dir) {
+        built = ftl_audio::buildSeekIndex(source, ftl_audio::SeekIndex::sidecarPath(dir, source));
+    }
+    if (source) env->ReleaseStringUTFChars(filePath, source);
+    if (dir) env->ReleaseStringUTFChars(directory, dir);
+    return built ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Build waveform pyramid sidecars for a library scan, skipping fresh ones
+ * Blocking: call from a background thread
+ * @return [built, skipped, failed, audioSeconds, buildSeconds, bytes]
+ */
+JNIEXPORT jdoubleArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeBuildWaveforms(
+    JNIEnv *env, 
+    jobject /* this */,
+    jobjectArray filePaths,
+    jstring directory
+) {
+    FTL_TRACE_SCOPE("jni.nativeBuildWaveforms");
+    if (!filePaths || !directory) {
+        return nullptr;
+    }
+    
+    jsize count = env->GetArrayLength(filePaths);
+    std::vector<std::string> files;
+    files.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto path = static_cast<jstring>(env->GetObjectArrayElement(filePaths, i));
+        const char* chars = path ? env->GetStringUTFChars(path, nullptr) : nullptr;
+        files.emplace_back(chars ? chars : "");
+        if (chars) env->ReleaseStringUTFChars(path, chars);
+        if (path) env->DeleteLocalRef(path);
+    }
+    
+    const char* dir = env->GetStringUTFChars(directory, nullptr);
+    if (!dir) {
+        return nullptr;
+    }
+    ftl_audio::WaveformBatchStats stats = ftl_audio::buildWaveforms(files, dir);
+    env->ReleaseStringUTFChars(directory, dir);
+    
+    const jdouble values[] = {
+        static_cast<jdouble>(stats.built),
+        static_cast<jdouble>(stats.skipped),
+        static_cast<jdouble>(stats.failed),
+        stats.audioSeconds,
+        stats.buildSeconds,
+        static_cast<jdouble>(stats.bytes)
+    };
+    jdoubleArray array = env->NewDoubleArray(6);
+    if (array) {
+        env->SetDoubleArrayRegion(array, 0, 6, values);
+    }
+    return array;
+}
+
+/**
+ * Waveform overview of [startMs, endMs) in `columns` columns, built on first view
+ * @return columns x (min, max, rms) bytes, or null if the file cannot be read or the range is empty
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetWaveform(
+    JNIEnv *env, 
+    jobject /* this */,
+    jstring filePath,
+    jstring directory,
+    jlong startMs,
+    jlong endMs,
+    jint columns
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetWaveform");
+    if (!filePath || !directory || columns <= 0) {
+        return nullptr;
+    }
+    
+    const char* source = env->GetStringUTFChars(filePath, nullptr);
+    const char* dir = env->GetStringUTFChars(directory, nullptr);
+    std::vector<ftl_audio::WaveformBin> bins;
+    if (source && dir) {
+        std::string sidecar = ftl_audio::WaveformPyramid::sidecarPath(dir, source);
+        ftl_audio::SourceStamp stamp;
+        ftl_audio::WaveformPyramid pyramid;
+        bool mapped = ftl_audio::SourceStamp::of(source, stamp) &&
+                      (pyramid.map(sidecar, stamp) ||
+                       (ftl_audio::buildWaveform(source, sidecar) && pyramid.map(sidecar, stamp)));
+        if (mapped) {
+            int64_t rate = pyramid.header().sampleRate;
+            int64_t startFrame = startMs * rate / 1000;
+            int64_t endFrame = endMs < 0 ? pyramid.header().totalFrames : endMs * rate / 1000;
+            bins.resize(static_cast<size_t>(columns));
+            bins.resize(static_cast<size_t>(pyramid.render(startFrame, endFrame, columns, bins.data())));
+        }
+    }
+    if (source) env->ReleaseStringUTFChars(filePath, source);
+    if (dir) env->ReleaseStringUTFChars(directory, dir);
+    if (bins.empty()) {
+        return nullptr;
+    }
+    
+    jsize length = static_cast<jsize>(bins.size() * sizeof(ftl_audio::WaveformBin));
+    jbyteArray array = env->NewByteArray(length);
+    if (array) {
+        env->SetByteArrayRegion(array, 0, length, reinterpret_cast<const jbyte*>(bins.data()));
+    }
+    return array;
+}
+
+/**
+ * Header-only metadata for a library scan, parsed on `threads` workers
+ * Blocking: call from a background thread
+ * @param numbers Filled with 9 values per track: [parsed, sampleRate, channels,
+ *                bitsPerSample, totalFrames, durationMs, bitRate, year, trackNumber]
+ * @return 4 strings per track: [codec, title, artist, album]
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeReadTrackMetadata(
+    JNIEnv *env,
+    jobject /* this */,
+    jobjectArray filePaths,
+    jint threads,
+    jlongArray numbers
+) {
+    FTL_TRACE_SCOPE("jni.nativeReadTrackMetadata");
+    constexpr jsize NUMBERS_PER_TRACK = 9;
+    constexpr jsize STRINGS_PER_TRACK = 4;
+    if (!filePaths || !numbers) {
+        return nullptr;
+    }
+
+    jsize count = env->GetArrayLength(filePaths);
+    if (env->GetArrayLength(numbers) < count * NUMBERS_PER_TRACK) {
+        LOGE("Metadata number array too short for %d tracks", static_cast<int>(count));
+        return nullptr;
+    }
+    std::vector<std::string> files;
+    files.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto path = static_cast<jstring>(env->GetObjectArrayElement(filePaths, i));
+        const char* chars = path ? env->GetStringUTFChars(path, nullptr) : nullptr;
+        files.emplace_back(chars ? chars : "");
+        if (chars) env->ReleaseStringUTFChars(path, chars);
+        if (path) env->DeleteLocalRef(path);
+    }
+
+    std::vector<ftl_audio::TrackMetadata> tracks = ftl_audio::readTrackMetadataBatch(files, threads);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray strings = stringClass ? env->NewObjectArray(count * STRINGS_PER_TRACK, stringClass, nullptr) : nullptr;
+    if (!strings) {
+        return nullptr;
+    }
+    std::vector<jlong> values(static_cast<size_t>(count * NUMBERS_PER_TRACK), 0);
+    for (jsize i = 0; i < count; ++i) {
+        const ftl_audio::TrackMetadata& track = tracks[static_cast<size_t>(i)];
+        jlong* row = values.data() + i * NUMBERS_PER_TRACK;
+        row[0] = track.parsed ? 1 : 0;
+        if (!track.parsed) {
+            continue;
+        }
+        row[1] = track.sampleRate;
+        row[2] = track.channelCount;
+        row[3] = track.bitsPerSample;
+        row[4] = track.totalFrames;
+        row[5] = static_cast<jlong>(track.durationSeconds() * 1000.0 + 0.5);
+        row[6] = track.bitRate;
+        row[7] = track.year;
+        row[8] = track.trackNumber;
+
+        const std::string* fields[] = {&track.codec, &track.title, &track.artist, &track.album};
+        for (jsize f = 0; f < STRINGS_PER_TRACK; ++f) {
+            if (fields[f]->empty()) continue;
+            jstring value = env->NewStringUTF(fields[f]->c_str());
+            if (!value) {
+                return nullptr;
+            }
+            env->SetObjectArrayElement(strings, i * STRINGS_PER_TRACK + f, value);
+            env->DeleteLocalRef(value);
+        }
+    }
+    env->SetLongArrayRegion(numbers, 0, count * NUMBERS_PER_TRACK, values.data());
+    return strings;
+}
+
+/**
+ * Native EngineState, including changes the engine made itself (sleep-timer pause, stream error)
+ */
+JNIEXPORT jint JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetEngineState(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetEngineState");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return static_cast<jint>(ftl_audio::EngineState::UNINITIALIZED);
+    }
+    return static_cast<jint>(engine->getCurrentState());
+}
+
+/**
+ * Source frame audible at the speaker right now (timestamp-corrected)
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetPlayheadFrame(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetPlayheadFrame");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return -1;
+    }
+    return static_cast<jlong>(engine->getPlayheadFrame());
+}
+
+/**
+ * Start a mixer voice over the main program (crossfade-in, preview, prompt)
+ * @return Voice id, or -1 when the file cannot be opened or all slots are busy
+ */
+JNIEXPORT jint JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativePlayVoice(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jstring filePath,
+    jfloat gain,
+    jint fadeInMs
+) {
+    FTL_TRACE_SCOPE("jni.nativePlayVoice");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || !filePath) {
+        return -1;
+    }
+    
+    const char* path = env->GetStringUTFChars(filePath, nullptr);
+    if (!path) {
+        return -1;
+    }
+    std::string pathString(path);
+    env->ReleaseStringUTFChars(filePath, path);
     
-    auto result = engine->updateConfiguration(config);
+    int32_t voiceId = -1;
+    auto result = engine->playVoice(pathString, gain, fadeInMs, &voiceId);
+    if (result != ftl_audio::EngineResult::SUCCESS) {
+        LOGE("Voice start failed: %d", static_cast<int>(result));
+        return -1;
+    }
+    return voiceId;
+}
+
+/**
+ * Ramp a voice's gain (linear, over rampMs)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetVoiceGain(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jint voiceId,
+    jfloat gain,
+    jint rampMs
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetVoiceGain");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setVoiceGain(voiceId, gain, rampMs);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Fade a voice out and release its slot
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeStopVoice(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jint voiceId,
+    jint fadeOutMs
+) {
+    FTL_TRACE_SCOPE("jni.nativeStopVoice");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->stopVoice(voiceId, fadeOutMs);
     return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
 }
 
+/**
+ * Ramp the main program's gain (crossfade-out, ducking under prompts)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetProgramGain(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jfloat gain,
+    jint rampMs
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetProgramGain");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setProgramGain(gain, rampMs);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Enable/disable per-track loudness normalization
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetLoudnessNormalization(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean enabled,
+    jfloat targetLufs
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetLoudnessNormalization");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setLoudnessNormalization(enabled == JNI_TRUE, targetLufs);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Integrated loudness of the current track from its metadata
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetTrackLoudness(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jfloat integratedLufs
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetTrackLoudness");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setTrackLoudness(integratedLufs);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Enable/disable the true-peak limiter at the end of the chain
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetTruePeakLimiter(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean enabled,
+    jfloat ceilingDb
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetTruePeakLimiter");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setTruePeakLimiter(enabled == JNI_TRUE, ceilingDb);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Playback tempo (source seconds per second), pitch kept
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetTempo(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jdouble tempo
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetTempo");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setTempo(tempo);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Pitch shift in semitones, tempo kept
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetPitchShift(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jdouble semitones
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetPitchShift");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setPitchShift(semitones);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Time-stretch algorithm: 0 music (phase vocoder), 1 speech (WSOLA)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetStretchMode(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jint mode
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetStretchMode");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setStretchMode(static_cast<ftl_audio::StretchMode>(mode));
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Fold-down matrix for sources with `inputChannels` channels (null: BS.775)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetDownmixMatrix(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jint inputChannels,
+    jfloatArray coefficients
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetDownmixMatrix");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    
+    if (!coefficients) {
+        auto result = engine->setDownmixMatrix(inputChannels, nullptr, 0);
+        return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+    }
+    
+    jsize count = env->GetArrayLength(coefficients);
+    if (count > ftl_audio::DownmixMatrix::MAX_CHANNELS * ftl_audio::DownmixMatrix::MAX_CHANNELS) {
+        return JNI_FALSE;
+    }
+    float matrix[ftl_audio::DownmixMatrix::MAX_CHANNELS * ftl_audio::DownmixMatrix::MAX_CHANNELS];
+    env->GetFloatArrayRegion(coefficients, 0, count, matrix);
+    auto result = engine->setDownmixMatrix(inputChannels, matrix, count);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Enable/disable binaural rendering / crossfeed for headphones
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetHeadphoneVirtualizer(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean enabled
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetHeadphoneVirtualizer");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setHeadphoneVirtualizer(enabled == JNI_TRUE);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Loudness of the current track measured so far
+ */
+JNIEXPORT jfloat JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetIntegratedLoudness(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetIntegratedLoudness");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return static_cast<jfloat>(ftl_audio::LoudnessMeter::NO_MEASUREMENT_LUFS);
+    }
+    return engine->getIntegratedLoudness();
+}
+
+/**
+ * EQ curve in dB, log-spaced over 20 Hz .. 20 kHz (null or disabled: flat)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetEqualizer(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean enabled,
+    jfloatArray gainsDb
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetEqualizer");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    
+    if (enabled != JNI_TRUE || !gainsDb) {
+        auto result = engine->setEqualizer(false, nullptr, 0);
+        return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+    }
+    
+    jsize count = env->GetArrayLength(gainsDb);
+    std::vector<float> gains(static_cast<size_t>(count));
+    env->GetFloatArrayRegion(gainsDb, 0, count, gains.data());
+    auto result = engine->setEqualizer(true, gains.data(), count);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Enable/disable the native adaptive EQ (strength 0..1)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeSetAdaptiveEq(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jboolean enabled,
+    jfloat strength
+) {
+    FTL_TRACE_SCOPE("jni.nativeSetAdaptiveEq");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return JNI_FALSE;
+    }
+    auto result = engine->setAdaptiveEq(enabled == JNI_TRUE, strength);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Band gains the EQ runs with (curve + adaptive correction)
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeGetEqualizerGains(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeGetEqualizerGains");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return nullptr;
+    }
+    float gains[ftl_audio::Equalizer::BANDS];
+    int count = engine->getEqualizerGains(gains, ftl_audio::Equalizer::BANDS);
+    if (count <= 0) {
+        return nullptr;
+    }
+    jfloatArray array = env->NewFloatArray(count);
+    if (array) {
+        env->SetFloatArrayRegion(array, 0, count, gains);
+    }
+    return array;
+}
+
+/**
+ * Measure THD+N / SNR / IMD / response of the current chain (offline, tens of ms)
+ * 
+ * @return [thdPlusN %, thdPlusN dB, SNR dB, -60 dBFS THD+N dB, IMD %,
+ *          multitone dB, response min dB, response max dB, elapsed ms], or null
+ */
+JNIEXPORT jdoubleArray JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeMeasureQuality(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jstring scratchDirectory
+) {
+    FTL_TRACE_SCOPE("jni.nativeMeasureQuality");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || !scratchDirectory) {
+        return nullptr;
+    }
+    const char* directory = env->GetStringUTFChars(scratchDirectory, nullptr);
+    if (!directory) {
+        return nullptr;
+    }
+    ftl_audio::QualityReport report;
+    auto result = engine->measureQuality(directory, &report);
+    env->ReleaseStringUTFChars(scratchDirectory, directory);
+    if (result != ftl_audio::EngineResult::SUCCESS) {
+        return nullptr;
+    }
+    
+    const jdouble values[] = {
+        report.thdPlusNPercent, report.thdPlusNDb, report.snrDb, report.lowLevelThdPlusNDb,
+        report.imdPercent, report.multitoneDistortionDb, report.responseMinDb, report.responseMaxDb,
+        report.elapsedMs
+    };
+    jsize count = static_cast<jsize>(sizeof(values) / sizeof(values[0]));
+    jdoubleArray array = env->NewDoubleArray(count);
+    if (array) {
+        env->SetDoubleArrayRegion(array, 0, count, values);
+    }
+    return array;
+}
+
+/**
+ * Schedule a sample-accurate automation event
+ * OUTPUT clock: timeMs is a delay from now. SOURCE clock: timeMs is the
+ * track position at which the event fires.
+ * 
+ * @return Event id, or 0 on failure
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeScheduleAutomation(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jint action,
+    jint clock,
+    jlong timeMs,
+    jint voiceId,
+    jfloat value,
+    jint rampMs
+) {
+    FTL_TRACE_SCOPE("jni.nativeScheduleAutomation");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine) {
+        return 0;
+    }
+    if (action < 0 || action > static_cast<jint>(ftl_audio::AutomationAction::PAUSE) ||
+        clock < 0 || clock > static_cast<jint>(ftl_audio::AutomationClock::SOURCE)) {
+        LOGE("Invalid automation event: action %d, clock %d", action, clock);
+        return 0;
+    }
+    
+    int64_t sampleRate = engine->getCurrentConfiguration().sampleRate;
+    ftl_audio::AutomationEvent event;
+    event.action = static_cast<ftl_audio::AutomationAction>(action);
+    event.clock = static_cast<ftl_audio::AutomationClock>(clock);
+    event.frame = static_cast<int64_t>(std::max<jlong>(timeMs, 0)) * sampleRate / 1000;
+    if (event.clock == ftl_audio::AutomationClock::OUTPUT) {
+        event.frame += engine->getOutputFrame();
+    }
+    event.value = value;
+    event.rampFrames = static_cast<int32_t>(static_cast<int64_t>(std::max<jint>(rampMs, 0)) * sampleRate / 1000);
+    event.voiceId = voiceId;
+    
+    uint32_t eventId = 0;
+    auto result = engine->scheduleAutomation(event, &eventId);
+    return (result == ftl_audio::EngineResult::SUCCESS) ? static_cast<jlong>(eventId) : 0;
+}
+
+/**
+ * Cancel a scheduled automation event that has not fired yet
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeCancelAutomation(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jlong eventId
+) {
+    FTL_TRACE_SCOPE("jni.nativeCancelAutomation");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || eventId <= 0) {
+        return JNI_FALSE;
+    }
+    auto result = engine->cancelAutomation(static_cast<uint32_t>(eventId));
+    return (result == ftl_audio::EngineResult::SUCCESS) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Drop every pending automation event
+ */
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeClearAutomation(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle
+) {
+    FTL_TRACE_SCOPE("jni.nativeClearAutomation");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (engine) {
+        engine->clearAutomation();
+    }
+}
+
+/**
+ * Start a trace capture (process-wide flight recorder)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeStartTrace(
+    JNIEnv *env, 
+    jobject /* this */
+) {
+    FTL_TRACE_SCOPE("jni.nativeStartTrace");
+    return ftl_audio::trace::start() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Stop recording; the capture stays available for a dump
+ */
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeStopTrace(
+    JNIEnv *env, 
+    jobject /* this */
+) {
+    FTL_TRACE_SCOPE("jni.nativeStopTrace");
+    ftl_audio::trace::stop();
+}
+
+/**
+ * Write the capture as Chrome trace-event JSON (Perfetto, chrome://tracing)
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativeDumpTrace(
+    JNIEnv *env, 
+    jobject /* this */,
+    jstring path
+) {
+    FTL_TRACE_SCOPE("jni.nativeDumpTrace");
+    if (!path) {
+        return JNI_FALSE;
+    }
+    const char* file = env->GetStringUTFChars(path, nullptr);
+    if (!file) {
+        return JNI_FALSE;
+    }
+    bool written = ftl_audio::trace::writeChromeTrace(file);
+    env->ReleaseStringUTFChars(path, file);
+    return written ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Post new engine settings (latency, DSP, stream-open options) to the control thread; never blocks
+ * Rate, burst and ring sizes stay as initialized
+ * @return Token for nativeAwaitCommand, or 0 if it couldn't be posted
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_audio_AudioEngine_nativePostConfiguration(
+    JNIEnv *env, 
+    jobject /* this */,
+    jlong engineHandle,
+    jobject configObject
+) {
+    FTL_TRACE_SCOPE("jni.nativePostConfiguration");
+    auto* engine = ftl_audio::getEngineByHandle(engineHandle);
+    if (!engine || !configObject) {
+        LOGE("Invalid arguments for update configuration: %lld", engineHandle);
+        return 0;
+    }
+    
+    // Only the fields Kotlin carries are read; the control thread lays them over the live config
+    auto tuning = ftl_audio::extractAudioEngineConfiguration(env, configObject);
+    return static_cast<jlong>(engine->postConfiguration(tuning));
+}
+
 /**
  * Shutdown native audio engine and clean up resources
  */
@@ -341,6 +1280,7 @@ Java_com_ftl_audioplayer_audio_AudioEngine_nativeShutdownEngine(
     jobject /* this */,
     jlong engineHandle
 ) {
+    FTL_TRACE_SCOPE("jni.nativeShutdownEngine");
     LOGI("Shutting down audio engine with handle: %lld", engineHandle);
     
     {
@@ -0,0 +1,269 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - INFERENCE JNI               ║
+ * ║        Native Genre / Mood / EQ Models for Kotlin           ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Backs com.ftl.audioplayer.ai.NativeInferenceEngine. Audio goes in once
+ * per call and only the answers come back: features never cross the JVM,
+ * and whole-library tagging runs on the tagger's own background thread
+ * while Kotlin polls progress.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../ml/LibraryTagger.h"
+#include "../utils/TraceRecorder.h"
+
+#define LOG_TAG "FTL_Inference_JNI"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+// Result row: analyzed, genre, genre confidence, mood, mood confidence, EQ bands
+// (zero-padded to TAG_EQ_BANDS, the Kotlin EQ_OUTPUT_SIZE)
+constexpr int TAG_EQ_BANDS = 32;
+constexpr int TAG_ROW_HEADER = 5;
+constexpr int TAG_ROW_WIDTH = TAG_ROW_HEADER + TAG_EQ_BANDS;
+
+static std::unordered_map<jlong, std::shared_ptr<LibraryTagger>> g_taggerMap;
+static std::mutex g_taggerMapMutex;
+
+// Shared so a release() racing a long analyze() cannot free the tagger under it
+static std::shared_ptr<LibraryTagger> getTaggerByHandle(jlong handle) {
+    std::lock_guard<std::mutex> lock(g_taggerMapMutex);
+    auto it = g_taggerMap.find(handle);
+    return it != g_taggerMap.end() ? it->second : nullptr;
+}
+
+static void writeRow(const TrackTags& tags, jfloat* row) {
+    std::fill(row, row + TAG_ROW_WIDTH, 0.0f);
+    row[0] = tags.analyzed ? 1.0f : 0.0f;
+    row[1] = static_cast<jfloat>(tags.genre);
+    row[2] = tags.genreConfidence;
+    row[3] = static_cast<jfloat>(tags.mood);
+    row[4] = tags.moodConfidence;
+    size_t bands = std::min(tags.eq.size(), static_cast<size_t>(TAG_EQ_BANDS));
+    std::copy(tags.eq.begin(), tags.eq.begin() + bands, row + TAG_ROW_HEADER);
+}
+
+} // namespace ftl_audio
+
+extern "C" {
+
+/**
+ * Create a tagger with no models loaded
+ * @return Handle (> 0)
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeCreate(
+    JNIEnv* /* env */,
+    jobject /* this */
+) {
+    static std::atomic<jlong> handleCounter{1000};
+    jlong handle = handleCounter.fetch_add(1);
+    std::lock_guard<std::mutex> lock(ftl_audio::g_taggerMapMutex);
+    ftl_audio::g_taggerMap[handle] = std::make_shared<ftl_audio::LibraryTagger>();
+    return handle;
+}
+
+/**
+ * Load a .ftlm image into a slot (0 genre, 1 mood, 2 EQ)
+ * @param quantize Run it int8 (true) or float32
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeLoadModel(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jint slot,
+    jbyteArray image,
+    jboolean quantize
+) {
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger || !image || slot < 0 || slot >= ftl_audio::TAG_MODEL_COUNT) {
+        return JNI_FALSE;
+    }
+    jsize size = env->GetArrayLength(image);
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    env->GetByteArrayRegion(image, 0, size, reinterpret_cast<jbyte*>(bytes.data()));
+    auto precision = quantize ? ftl_audio::InferencePrecision::INT8 : ftl_audio::InferencePrecision::FLOAT32;
+    return tagger->loadModel(static_cast<ftl_audio::TagModel>(slot), bytes.data(), bytes.size(), precision)
+               ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeHasModel(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jlong handle,
+    jint slot
+) {
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger || slot < 0 || slot >= ftl_audio::TAG_MODEL_COUNT) {
+        return JNI_FALSE;
+    }
+    return tagger->hasModel(static_cast<ftl_audio::TagModel>(slot)) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Features and every loaded model on one interleaved clip
+ * @return One result row, or null
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeAnalyze(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jfloatArray samples,
+    jint sampleRate,
+    jint channelCount
+) {
+    FTL_TRACE_SCOPE("jni.nativeAnalyze");
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger || !samples || channelCount <= 0) {
+        return nullptr;
+    }
+    jsize count = env->GetArrayLength(samples);
+    jfloat* data = env->GetFloatArrayElements(samples, nullptr);
+    if (!data) {
+        return nullptr;
+    }
+    ftl_audio::TrackTags tags;
+    bool ok = tagger->analyze(data, count / channelCount, channelCount, sampleRate, tags);
+    env->ReleaseFloatArrayElements(samples, data, JNI_ABORT);
+    if (!ok) {
+        return nullptr;
+    }
+
+    jfloat row[ftl_audio::TAG_ROW_WIDTH];
+    ftl_audio::writeRow(tags, row);
+    jfloatArray result = env->NewFloatArray(ftl_audio::TAG_ROW_WIDTH);
+    if (result) {
+        env->SetFloatArrayRegion(result, 0, ftl_audio::TAG_ROW_WIDTH, row);
+    }
+    return result;
+}
+
+/**
+ * Tag files in the background; poll nativeGetTaggingProgress
+ * @return False if a run is in progress or no model is loaded
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeStartTagging(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jobjectArray paths
+) {
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger || !paths) {
+        return JNI_FALSE;
+    }
+    jsize count = env->GetArrayLength(paths);
+    std::vector<std::string> files;
+    files.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto path = static_cast<jstring>(env->GetObjectArrayElement(paths, i));
+        const char* chars = path ? env->GetStringUTFChars(path, nullptr) : nullptr;
+        files.emplace_back(chars ? chars : "");
+        if (chars) env->ReleaseStringUTFChars(path, chars);
+        if (path) env->DeleteLocalRef(path);
+    }
+    return tagger->start(std::move(files)) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @return [completed, total, running (0/1)]
+ */
+JNIEXPORT jintArray JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeGetTaggingProgress(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle
+) {
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger) {
+        return nullptr;
+    }
+    const jint values[] = {tagger->completed(), tagger->total(), tagger->isRunning() ? 1 : 0};
+    jintArray array = env->NewIntArray(3);
+    if (array) {
+        env->SetIntArrayRegion(array, 0, 3, values);
+    }
+    return array;
+}
+
+/**
+ * Result rows from `fromIndex` on, in input order, TAG_ROW_WIDTH floats each
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeGetTaggingResults(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jint fromIndex
+) {
+    auto tagger = ftl_audio::getTaggerByHandle(handle);
+    if (!tagger) {
+        return nullptr;
+    }
+    std::vector<ftl_audio::TrackTags> tags = tagger->results();
+    size_t first = static_cast<size_t>(std::max(0, static_cast<int>(fromIndex)));
+    size_t rows = first < tags.size() ? tags.size() - first : 0;
+    std::vector<jfloat> flat(rows * ftl_audio::TAG_ROW_WIDTH);
+    for (size_t i = 0; i < rows; ++i) {
+        ftl_audio::writeRow(tags[first + i], flat.data() + i * ftl_audio::TAG_ROW_WIDTH);
+    }
+    jfloatArray array = env->NewFloatArray(static_cast<jsize>(flat.size()));
+    if (array) {
+        env->SetFloatArrayRegion(array, 0, static_cast<jsize>(flat.size()), flat.data());
+    }
+    return array;
+}
+
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeCancelTagging(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jlong handle
+) {
+    if (auto tagger = ftl_audio::getTaggerByHandle(handle)) {
+        tagger->cancel();
+    }
+}
+
+/**
+ * Cancel any run and free the tagger (the worker is joined)
+ */
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_ai_NativeInferenceEngine_nativeRelease(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jlong handle
+) {
+    std::shared_ptr<ftl_audio::LibraryTagger> tagger;
+    {
+        std::lock_guard<std::mutex> lock(ftl_audio::g_taggerMapMutex);
+        auto it = ftl_audio::g_taggerMap.find(handle);
+        if (it == ftl_audio::g_taggerMap.end()) {
+            LOGE("Invalid tagger handle for release: %lld", static_cast<long long>(handle));
+            return;
+        }
+        tagger = std::move(it->second);
+        ftl_audio::g_taggerMap.erase(it);
+    }
+    tagger->cancel();
+}
+
+} // extern "C"
@@ -21,37 +21,103 @@ namespace JNISignatures {
     // D = double, J = long, V = void
     // Constructor signature: cpuUsage, memoryUsage, bufferUnderruns, bufferOverruns, 
     //                       avgProcessingTime, maxProcessingTime, callbackCount, missedCallbacks, callbackLoad
-    static const char* PERFORMANCE_METRICS_CONSTRUCTOR = "(DDJJDDJJD)V";
+    static const char* PERFORMANCE_METRICS_CONSTRUCTOR = "(DDJJDDJJDDDJDD)V";
+    
+    static const char* PERFORMANCE_METRICS_CLASS = "com/ftl/audioplayer/audio/PerformanceMetrics";
+    static const char* ENGINE_CONFIGURATION_CLASS = "com/ftl/audioplayer/audio/AudioEngineConfiguration";
 }
 
+// Populated once in JNI_OnLoad, read-only afterwards
+static JniCache g_jniCache;
+
 // Static field cache for performance
 std::unordered_map<std::string, jfieldID> FieldCache::fieldCache;
 std::mutex FieldCache::cacheMutex;
 
 // ═══════════════════════════════════════════════════════════════════════════════════
-// PERFORMANCE METRICS OBJECT CREATION
+// JNI ID CACHE
 // ═══════════════════════════════════════════════════════════════════════════════════
 
-jobject createPerformanceMetricsObject(JNIEnv* env, const PerformanceMetrics& metrics) {
-    // Find PerformanceMetrics class
-    jclass metricsClass = env->FindClass("com/ftl/audioplayer/audio/PerformanceMetrics");
+namespace {
+
+/** Field ID, or null with the NoSuchFieldError cleared and the field logged */
+jfieldID lookupField(JNIEnv* env, jclass clazz, const char* name, const char* sig) {
+    jfieldID field = env->GetFieldID(clazz, name, sig);
+    if (!field) {
+        checkAndClearException(env);
+        LOGE("Could not find AudioEngineConfiguration.%s (%s)", name, sig);
+    }
+    return field;
+}
+
+} // namespace
+
+bool initializeJniCache(JNIEnv* env) {
+    jclass metricsClass = env->FindClass(JNISignatures::PERFORMANCE_METRICS_CLASS);
     if (!metricsClass) {
         LOGE("Could not find PerformanceMetrics class");
-        return nullptr;
+        checkAndClearException(env);
+        return false;
     }
     
-    // Get constructor method ID (updated signature for new fields)
-    jmethodID constructor = env->GetMethodID(metricsClass, "<init>", JNISignatures::PERFORMANCE_METRICS_CONSTRUCTOR);
-    if (!constructor) {
-        LOGE("Could not find PerformanceMetrics constructor");
+    g_jniCache.performanceMetricsConstructor = env->GetMethodID(
+        metricsClass, "<init>", JNISignatures::PERFORMANCE_METRICS_CONSTRUCTOR);
+    if (!g_jniCache.performanceMetricsConstructor) {
+        checkAndClearException(env);
+        LOGE("Could not find PerformanceMetrics.<init>%s", JNISignatures::PERFORMANCE_METRICS_CONSTRUCTOR);
         env->DeleteLocalRef(metricsClass);
+        return false;
+    }
+    g_jniCache.performanceMetricsClass = static_cast<jclass>(env->NewGlobalRef(metricsClass));
+    env->DeleteLocalRef(metricsClass);
+    
+    jclass configClass = env->FindClass(JNISignatures::ENGINE_CONFIGURATION_CLASS);
+    if (!configClass) {
+        LOGE("Could not find AudioEngineConfiguration class");
+        checkAndClearException(env);
+        releaseJniCache(env);
+        return false;
+    }
+    
+    // Each lookup is checked before the next: JNI calls are not allowed with an exception pending
+    bool found = (g_jniCache.configEnableLowLatency = lookupField(env, configClass, "enableLowLatencyMode", "Z")) &&
+                 (g_jniCache.configEnableHighResolution = lookupField(env, configClass, "enableHighResolution", "Z")) &&
+                 (g_jniCache.configEnableDSPProcessing = lookupField(env, configClass, "enableDSPProcessing", "Z")) &&
+                 (g_jniCache.configBufferSizeMultiplier = lookupField(env, configClass, "bufferSizeMultiplier", "F")) &&
+                 (g_jniCache.configThreadPriority = lookupField(env, configClass, "threadPriority", "I"));
+    env->DeleteLocalRef(configClass);
+    if (!found) {
+        releaseJniCache(env);
+        return false;
+    }
+    return true;
+}
+
+void releaseJniCache(JNIEnv* env) {
+    if (g_jniCache.performanceMetricsClass) {
+        env->DeleteGlobalRef(g_jniCache.performanceMetricsClass);
+    }
+    g_jniCache = JniCache();
+}
+
+const JniCache& getJniCache() {
+    return g_jniCache;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// PERFORMANCE METRICS OBJECT CREATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+jobject createPerformanceMetricsObject(JNIEnv* env, const PerformanceMetrics& metrics) {
+    if (!g_jniCache.performanceMetricsClass || !g_jniCache.performanceMetricsConstructor) {
+        LOGE("PerformanceMetrics IDs not cached - JNI_OnLoad failed?");
         return nullptr;
     }
     
     // Create new instance
-    jobject metricsObject = env->NewObject(
-        metricsClass, 
-        constructor,
+    return env->NewObject(
+        g_jniCache.performanceMetricsClass, 
+        g_jniCache.performanceMetricsConstructor,
         metrics.cpuUsagePercent,
         metrics.memoryUsageMB,
         static_cast<jlong>(metrics.bufferUnderruns),
@@ -60,11 +126,13 @@ jobject createPerformanceMetricsObject(JNIEnv* env, const PerformanceMetrics& me
         metrics.maxProcessingTimeUs,
         static_cast<jlong>(metrics.callbackCount),
         static_cast<jlong>(metrics.missedCallbacks),
-        metrics.callbackLoad
+        metrics.callbackLoad,
+        metrics.thdPlusN,
+        metrics.signalToNoiseRatio,
+        static_cast<jlong>(metrics.streamRecoveries),
+        metrics.lastRecoveryMs,
+        metrics.timeToFirstAudioMs
     );
-    
-    env->DeleteLocalRef(metricsClass);
-    return metricsObject;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════════
@@ -79,41 +147,31 @@ AudioEngineConfig extractAudioEngineConfiguration(JNIEnv* env, jobject configObj
         return config;
     }
     
-    jclass configClass = env->GetObjectClass(configObject);
-    if (!configClass) {
-        LOGE("Could not get configuration class");
-        return config;
-    }
+    const JniCache& cache = g_jniCache;
     
     // Extract boolean fields
-    jfieldID enableLowLatencyField = FieldCache::getFieldID(env, configClass, "enableLowLatencyMode", "Z");
-    if (enableLowLatencyField) {
-        config.enableLowLatency = env->GetBooleanField(configObject, enableLowLatencyField);
+    if (cache.configEnableLowLatency) {
+        config.enableLowLatency = env->GetBooleanField(configObject, cache.configEnableLowLatency);
     }
     
-    jfieldID enableHighResField = FieldCache::getFieldID(env, configClass, "enableHighResolution", "Z");
-    if (enableHighResField) {
-        config.enableHighResolution = env->GetBooleanField(configObject, enableHighResField);
+    if (cache.configEnableHighResolution) {
+        config.enableHighResolution = env->GetBooleanField(configObject, cache.configEnableHighResolution);
     }
     
-    jfieldID enableDSPField = FieldCache::getFieldID(env, configClass, "enableDSPProcessing", "Z");
-    if (enableDSPField) {
-        config.enableDSPProcessing = env->GetBooleanField(configObject, enableDSPField);
+    if (cache.configEnableDSPProcessing) {
+        config.enableDSPProcessing = env->GetBooleanField(configObject, cache.configEnableDSPProcessing);
     }
     
     // Extract float fields
-    jfieldID bufferMultiplierField = FieldCache::getFieldID(env, configClass, "bufferSizeMultiplier", "F");
-    if (bufferMultiplierField) {
-        config.bufferSizeMultiplier = env->GetFloatField(configObject, bufferMultiplierField);
+    if (cache.configBufferSizeMultiplier) {
+        config.bufferSizeMultiplier = env->GetFloatField(configObject, cache.configBufferSizeMultiplier);
     }
     
     // Extract int fields
-    jfieldID threadPriorityField = FieldCache::getFieldID(env, configClass, "threadPriority", "I");
-    if (threadPriorityField) {
-        config.threadPriority = env->GetIntField(configObject, threadPriorityField);
+    if (cache.configThreadPriority) {
+        config.threadPriority = env->GetIntField(configObject, cache.configThreadPriority);
     }
     
-    env->DeleteLocalRef(configClass);
     return config;
 }
 
@@ -17,6 +17,33 @@
 
 namespace ftl_audio {
 
+/**
+ * Class and member IDs resolved once in JNI_OnLoad.
+ * Classes are held as global references for the lifetime of the library.
+ */
+struct JniCache {
+    jclass performanceMetricsClass = nullptr;
+    jmethodID performanceMetricsConstructor = nullptr;
+    
+    jfieldID configEnableLowLatency = nullptr;
+    jfieldID configEnableHighResolution = nullptr;
+    jfieldID configEnableDSPProcessing = nullptr;
+    jfieldID configBufferSizeMultiplier = nullptr;
+    jfieldID configThreadPriority = nullptr;
+};
+
+/**
+ * Resolve and cache all IDs used by the hot JNI paths (call from JNI_OnLoad)
+ */
+bool initializeJniCache(JNIEnv* env);
+
+/**
+ * Drop global references held by the cache (call from JNI_OnUnload)
+ */
+void releaseJniCache(JNIEnv* env);
+
+const JniCache& getJniCache();
+
 /**
  * Create a Kotlin PerformanceMetrics object from C++ data
  */
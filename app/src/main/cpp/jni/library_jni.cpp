@@ -0,0 +1,366 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               FTL AUDIO ENGINE - LIBRARY JNI                ║
+ * ║        Native Search Index & Library Snapshot for Kotlin    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Backs com.ftl.audioplayer.data.search.NativeSearchIndex and
+ * com.ftl.audioplayer.data.snapshot.NativeLibrarySnapshot. Tags cross the
+ * JVM once, when the library is scanned; each keystroke then sends only
+ * the query and gets back ranked track IDs for Room to load, and a cold
+ * start reads rows straight from the mapped snapshot.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../library/LibrarySnapshot.h"
+#include "../library/SearchIndex.h"
+#include "../utils/TraceRecorder.h"
+
+#define LOG_TAG "FTL_Library_JNI"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+static std::unordered_map<jlong, std::shared_ptr<SearchIndex>> g_searchIndexMap;
+static std::mutex g_searchIndexMapMutex;
+
+// Shared so a release() racing a search cannot free the index under it
+static std::shared_ptr<SearchIndex> getSearchIndexByHandle(jlong handle) {
+    std::lock_guard<std::mutex> lock(g_searchIndexMapMutex);
+    auto it = g_searchIndexMap.find(handle);
+    return it != g_searchIndexMap.end() ? it->second : nullptr;
+}
+
+// Track columns per row of nativeWriteSnapshot's arrays
+constexpr jsize SNAPSHOT_NUMBERS_PER_TRACK = 11;
+constexpr jsize SNAPSHOT_STRINGS_PER_TRACK = 6;
+
+static std::unordered_map<jlong, std::shared_ptr<LibrarySnapshot>> g_snapshotMap;
+static std::mutex g_snapshotMapMutex;
+
+/**
+ * JNI hands out modified UTF-8, where a character outside the BMP is two
+ * 3-byte surrogates; rejoin them so the index and Kotlin's decoder see
+ * standard UTF-8.
+ */
+static std::string standardUtf8(const char* chars) {
+    std::string text(chars);
+    size_t i = 0;
+    size_t out = 0;
+    while (i < text.size()) {
+        auto byte = [&](size_t k) { return static_cast<unsigned char>(text[k]); };
+        if (i + 6 <= text.size() && byte(i) == 0xED && (byte(i + 1) & 0xF0) == 0xA0 &&
+            byte(i + 3) == 0xED && (byte(i + 4) & 0xF0) == 0xB0) {
+            uint32_t high = ((byte(i + 1) & 0x0F) << 6) | (byte(i + 2) & 0x3F);
+            uint32_t low = ((byte(i + 4) & 0x0F) << 6) | (byte(i + 5) & 0x3F);
+            uint32_t cp = 0x10000 + (high << 10) + low;
+            text[out++] = static_cast<char>(0xF0 | (cp >> 18));
+            text[out++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            text[out++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            text[out++] = static_cast<char>(0x80 | (cp & 0x3F));
+            i += 6;
+        } else {
+            text[out++] = text[i++];
+        }
+    }
+    text.resize(out);
+    return text;
+}
+
+static std::string stringAt(JNIEnv* env, jobjectArray array, jsize index) {
+    auto value = static_cast<jstring>(env->GetObjectArrayElement(array, index));
+    if (!value) {
+        return {};
+    }
+    const char* chars = env->GetStringUTFChars(value, nullptr);
+    std::string text = chars ? standardUtf8(chars) : std::string();
+    if (chars) env->ReleaseStringUTFChars(value, chars);
+    env->DeleteLocalRef(value);
+    return text;
+}
+
+static std::vector<int64_t> longsOf(JNIEnv* env, jlongArray array) {
+    jsize count = env->GetArrayLength(array);
+    std::vector<jlong> values(static_cast<size_t>(count));
+    env->GetLongArrayRegion(array, 0, count, values.data());
+    return std::vector<int64_t>(values.begin(), values.end());
+}
+
+} // namespace ftl_audio
+
+extern "C" {
+
+/**
+ * Create an empty index
+ * @return Handle (> 0)
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeCreate(
+    JNIEnv* /* env */,
+    jobject /* this */
+) {
+    static std::atomic<jlong> handleCounter{1000};
+    jlong handle = handleCounter.fetch_add(1);
+    std::lock_guard<std::mutex> lock(ftl_audio::g_searchIndexMapMutex);
+    ftl_audio::g_searchIndexMap[handle] = std::make_shared<ftl_audio::SearchIndex>();
+    return handle;
+}
+
+/**
+ * Add or replace tracks; the four arrays are parallel
+ * @return False if the arrays disagree in length
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeUpsert(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jlongArray trackIds,
+    jobjectArray titles,
+    jobjectArray artists,
+    jobjectArray albums
+) {
+    FTL_TRACE_SCOPE("jni.nativeSearchUpsert");
+    auto index = ftl_audio::getSearchIndexByHandle(handle);
+    if (!index || !trackIds || !titles || !artists || !albums) {
+        return JNI_FALSE;
+    }
+    jsize count = env->GetArrayLength(trackIds);
+    if (env->GetArrayLength(titles) != count || env->GetArrayLength(artists) != count ||
+        env->GetArrayLength(albums) != count) {
+        LOGE("Search upsert: mismatched array lengths");
+        return JNI_FALSE;
+    }
+    std::vector<int64_t> ids = ftl_audio::longsOf(env, trackIds);
+    std::vector<ftl_audio::SearchEntry> entries(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        entries[i].trackId = ids[i];
+        entries[i].title = ftl_audio::stringAt(env, titles, i);
+        entries[i].artist = ftl_audio::stringAt(env, artists, i);
+        entries[i].album = ftl_audio::stringAt(env, albums, i);
+    }
+    index->upsert(entries);
+    return JNI_TRUE;
+}
+
+/**
+ * @return Number of the tracks that were indexed
+ */
+JNIEXPORT jint JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeRemove(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jlongArray trackIds
+) {
+    auto index = ftl_audio::getSearchIndexByHandle(handle);
+    if (!index || !trackIds) {
+        return 0;
+    }
+    return static_cast<jint>(index->remove(ftl_audio::longsOf(env, trackIds)));
+}
+
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeClear(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jlong handle
+) {
+    if (auto index = ftl_audio::getSearchIndexByHandle(handle)) {
+        index->clear();
+    }
+}
+
+/**
+ * @return Track IDs, best match first (empty for a blank query)
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeSearch(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle,
+    jstring query,
+    jint limit
+) {
+    FTL_TRACE_SCOPE("jni.nativeSearch");
+    auto index = ftl_audio::getSearchIndexByHandle(handle);
+    if (!index || !query) {
+        return nullptr;
+    }
+    const char* chars = env->GetStringUTFChars(query, nullptr);
+    if (!chars) {
+        return nullptr;
+    }
+    std::string text = ftl_audio::standardUtf8(chars);
+    env->ReleaseStringUTFChars(query, chars);
+
+    size_t count = limit > 0 ? static_cast<size_t>(limit) : ftl_audio::SEARCH_DEFAULT_LIMIT;
+    std::vector<ftl_audio::SearchHit> hits = index->search(text, count);
+    std::vector<jlong> ids(hits.size());
+    for (size_t i = 0; i < hits.size(); ++i) ids[i] = static_cast<jlong>(hits[i].trackId);
+    jlongArray array = env->NewLongArray(static_cast<jsize>(ids.size()));
+    if (array) {
+        env->SetLongArrayRegion(array, 0, static_cast<jsize>(ids.size()), ids.data());
+    }
+    return array;
+}
+
+/**
+ * @return [tracks, words, trigrams, posting bytes, memory bytes]
+ */
+JNIEXPORT jlongArray JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeGetStats(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle
+) {
+    auto index = ftl_audio::getSearchIndexByHandle(handle);
+    if (!index) {
+        return nullptr;
+    }
+    ftl_audio::SearchIndexStats stats = index->stats();
+    const jlong values[] = {
+        static_cast<jlong>(stats.tracks), static_cast<jlong>(stats.words), static_cast<jlong>(stats.trigrams),
+        static_cast<jlong>(stats.postingBytes), static_cast<jlong>(stats.memoryBytes)};
+    jlongArray array = env->NewLongArray(5);
+    if (array) {
+        env->SetLongArrayRegion(array, 0, 5, values);
+    }
+    return array;
+}
+
+JNIEXPORT void JNICALL
+Java_com_ftl_audioplayer_data_search_NativeSearchIndex_nativeRelease(
+    JNIEnv* /* env */,
+    jobject /* this */,
+    jlong handle
+) {
+    std::lock_guard<std::mutex> lock(ftl_audio::g_searchIndexMapMutex);
+    if (ftl_audio::g_searchIndexMap.erase(handle) == 0) {
+        LOGE("Invalid search index handle for release: %lld", static_cast<long long>(handle));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LIBRARY SNAPSHOT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+/**
+ * Write a snapshot of the tracks table (after a scan)
+ * @param numbers Per track: id, duration ms, file size, date added, sample rate,
+ *                bit rate, channels, bit depth, year, track number, flags
+ * @param strings Per track: title, artist, album, file path, MIME type, codec
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_ftl_audioplayer_data_snapshot_NativeLibrarySnapshot_nativeWrite(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring path,
+    jlongArray numbers,
+    jobjectArray strings,
+    jlong createdMs
+) {
+    FTL_TRACE_SCOPE("jni.nativeWriteSnapshot");
+    if (!path || !numbers || !strings) {
+        return JNI_FALSE;
+    }
+    jsize count = env->GetArrayLength(strings) / ftl_audio::SNAPSHOT_STRINGS_PER_TRACK;
+    if (env->GetArrayLength(numbers) != count * ftl_audio::SNAPSHOT_NUMBERS_PER_TRACK ||
+        env->GetArrayLength(strings) != count * ftl_audio::SNAPSHOT_STRINGS_PER_TRACK) {
+        LOGE("Snapshot write: mismatched array lengths");
+        return JNI_FALSE;
+    }
+    std::vector<int64_t> values = ftl_audio::longsOf(env, numbers);
+    std::vector<ftl_audio::SnapshotTrack> tracks(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        ftl_audio::SnapshotTrack& track = tracks[static_cast<size_t>(i)];
+        const int64_t* row = values.data() + i * ftl_audio::SNAPSHOT_NUMBERS_PER_TRACK;
+        track.id = row[0];
+        track.durationMs = row[1];
+        track.fileSize = row[2];
+        track.dateAdded = row[3];
+        track.sampleRate = static_cast<uint32_t>(row[4]);
+        track.bitRate = static_cast<uint32_t>(row[5]);
+        track.channels = static_cast<uint32_t>(row[6]);
+        track.bitDepth = static_cast<uint32_t>(row[7]);
+        track.year = static_cast<uint32_t>(row[8]);
+        track.trackNumber = static_cast<uint32_t>(row[9]);
+        track.flags = static_cast<uint32_t>(row[10]);
+        std::string* fields[] = {&track.title, &track.artist, &track.album,
+                                 &track.filePath, &track.mimeType, &track.codec};
+        for (jsize f = 0; f < ftl_audio::SNAPSHOT_STRINGS_PER_TRACK; ++f) {
+            *fields[f] = ftl_audio::stringAt(env, strings, i * ftl_audio::SNAPSHOT_STRINGS_PER_TRACK + f);
+        }
+    }
+
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return JNI_FALSE;
+    }
+    std::string file(chars);
+    env->ReleaseStringUTFChars(path, chars);
+    return ftl_audio::LibrarySnapshot::write(file, tracks, createdMs) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Map a snapshot
+ * @return Handle (> 0), or 0 if missing or invalid
+ */
+JNIEXPORT jlong JNICALL
+Java_com_ftl_audioplayer_data_snapshot_NativeLibrarySnapshot_nativeOpen(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring path
+) {
+    FTL_TRACE_SCOPE("jni.nativeOpenSnapshot");
+    if (!path) {
+        return 0;
+    }
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    if (!chars) {
+        return 0;
+    }
+    auto snapshot = std::make_shared<ftl_audio::LibrarySnapshot>();
+    bool mapped = snapshot->map(chars);
+    env->ReleaseStringUTFChars(path, chars);
+    if (!mapped) {
+        return 0;
+    }
+    static std::atomic<jlong> handleCounter{1000};
+    jlong handle = handleCounter.fetch_add(1);
+    std::lock_guard<std::mutex> lock(ftl_audio::g_snapshotMapMutex);
+    ftl_audio::g_snapshotMap[handle] = std::move(snapshot);
+    return handle;
+}
+
+/**
+ * The whole mapping as a direct ByteBuffer (layout in LibrarySnapshot.h).
+ * Read-only memory: the buffer must never be written. Mappings are kept
+ * for the life of the process, since Kotlin lists read through them.
+ */
+JNIEXPORT jobject JNICALL
+Java_com_ftl_audioplayer_data_snapshot_NativeLibrarySnapshot_nativeGetBuffer(
+    JNIEnv* env,
+    jobject /* this */,
+    jlong handle
+) {
+    std::lock_guard<std::mutex> lock(ftl_audio::g_snapshotMapMutex);
+    auto it = ftl_audio::g_snapshotMap.find(handle);
+    if (it == ftl_audio::g_snapshotMap.end()) {
+        return nullptr;
+    }
+    return env->NewDirectByteBuffer(const_cast<void*>(it->second->data()),
+                                    static_cast<jlong>(it->second->mappedBytes()));
+}
+
+} // extern "C"
@@ -0,0 +1,395 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             LIBRARY SNAPSHOT - COLUMNAR TRACK LIST          ║
+ * ║       Memory-Mapped Rows & Sort Orders for Cold Start       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Sorting happens once, at write time: every distinct string gets a rank
+ * by its folded form (the search index's normalization, so "Éclair" sorts
+ * with "eclair"), and the orders compare ranks. Mapping checks only the
+ * header and section bounds; string and row indices are checked when
+ * read, so opening a snapshot touches no page but the first.
+ */
+
+#include "LibrarySnapshot.h"
+#include "SearchIndex.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <numeric>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+#include <unordered_map>
+
+#define LOG_TAG "FTL_LibrarySnapshot"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[8] = {'F', 'T', 'L', 'S', 'N', 'A', 'P', '\0'};
+
+constexpr uint32_t ORDER_SECTION = SNAPSHOT_COLUMNS;
+constexpr uint32_t STRING_OFFSETS_SECTION = SNAPSHOT_COLUMNS + SNAPSHOT_ORDERS;
+constexpr uint32_t STRING_BYTES_SECTION = STRING_OFFSETS_SECTION + 1;
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+/** Bytes of every section but the string bytes */
+uint64_t sectionBytes(uint32_t section, uint32_t rows, uint32_t strings) {
+    if (section < SNAPSHOT_WIDE_COLUMNS) return static_cast<uint64_t>(rows) * sizeof(int64_t);
+    if (section < STRING_OFFSETS_SECTION) return static_cast<uint64_t>(rows) * sizeof(uint32_t);
+    return (static_cast<uint64_t>(strings) + 1) * sizeof(uint32_t);
+}
+
+/** Interned strings of a write, ranked for sorting */
+class StringTable {
+public:
+    uint32_t intern(const std::string& text) {
+        auto inserted = m_index.emplace(text, static_cast<uint32_t>(m_strings.size()));
+        if (inserted.second) {
+            m_strings.push_back(&inserted.first->first);
+        }
+        return inserted.first->second;
+    }
+
+    size_t size() const { return m_strings.size(); }
+    const std::string& at(uint32_t index) const { return *m_strings[index]; }
+
+    /** Rank of each string by folded text, then by bytes */
+    std::vector<uint32_t> ranks() const {
+        std::vector<std::string> folded(m_strings.size());
+        for (size_t i = 0; i < m_strings.size(); ++i) {
+            folded[i] = SearchIndex::normalize(*m_strings[i]);
+        }
+        std::vector<uint32_t> byRank(m_strings.size());
+        std::iota(byRank.begin(), byRank.end(), 0u);
+        std::sort(byRank.begin(), byRank.end(), [&](uint32_t a, uint32_t b) {
+            int order = folded[a].compare(folded[b]);
+            return order != 0 ? order < 0 : *m_strings[a] < *m_strings[b];
+        });
+        std::vector<uint32_t> rank(m_strings.size());
+        for (uint32_t r = 0; r < byRank.size(); ++r) rank[byRank[r]] = r;
+        return rank;
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> m_index;
+    std::vector<const std::string*> m_strings;
+};
+
+bool writeAll(FILE* file, const void* data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes;
+}
+
+bool pad(FILE* file, uint64_t& position) {
+    static const uint8_t ZEROS[8] = {};
+    uint64_t aligned = align8(position);
+    bool ok = writeAll(file, ZEROS, static_cast<size_t>(aligned - position));
+    position = aligned;
+    return ok;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WRITER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool LibrarySnapshot::write(const std::string& path, const std::vector<SnapshotTrack>& tracks, int64_t createdMs,
+                            SnapshotWriteStats* stats) {
+    auto started = std::chrono::steady_clock::now();
+    const auto rows = static_cast<uint32_t>(tracks.size());
+
+    // Columns
+    std::vector<std::vector<int64_t>> wide(SNAPSHOT_WIDE_COLUMNS, std::vector<int64_t>(rows));
+    std::vector<std::vector<uint32_t>> narrow(SNAPSHOT_COLUMNS - SNAPSHOT_WIDE_COLUMNS, std::vector<uint32_t>(rows));
+    auto narrowAt = [&](SnapshotColumn column) -> std::vector<uint32_t>& {
+        return narrow[column - SNAPSHOT_WIDE_COLUMNS];
+    };
+    StringTable strings;
+    uint32_t hiResCount = 0;
+    for (uint32_t row = 0; row < rows; ++row) {
+        const SnapshotTrack& track = tracks[row];
+        wide[COLUMN_ID][row] = track.id;
+        wide[COLUMN_DURATION_MS][row] = track.durationMs;
+        wide[COLUMN_FILE_SIZE][row] = track.fileSize;
+        wide[COLUMN_DATE_ADDED][row] = track.dateAdded;
+        narrowAt(COLUMN_SAMPLE_RATE)[row] = track.sampleRate;
+        narrowAt(COLUMN_BIT_RATE)[row] = track.bitRate;
+        narrowAt(COLUMN_CHANNELS)[row] = track.channels;
+        narrowAt(COLUMN_BIT_DEPTH)[row] = track.bitDepth;
+        narrowAt(COLUMN_YEAR)[row] = track.year;
+        narrowAt(COLUMN_TRACK_NUMBER)[row] = track.trackNumber;
+        narrowAt(COLUMN_FLAGS)[row] = track.flags;
+        narrowAt(COLUMN_TITLE)[row] = strings.intern(track.title);
+        narrowAt(COLUMN_ARTIST)[row] = strings.intern(track.artist);
+        narrowAt(COLUMN_ALBUM)[row] = strings.intern(track.album);
+        narrowAt(COLUMN_FILE_PATH)[row] = strings.intern(track.filePath);
+        narrowAt(COLUMN_MIME_TYPE)[row] = strings.intern(track.mimeType);
+        narrowAt(COLUMN_CODEC)[row] = strings.intern(track.codec);
+        if (track.flags & SNAPSHOT_FLAG_HI_RES) ++hiResCount;
+    }
+
+    // Orders: compare string ranks, never strings
+    std::vector<uint32_t> rank = strings.ranks();
+    std::vector<uint32_t> title(rows), artist(rows), album(rows);
+    for (uint32_t row = 0; row < rows; ++row) {
+        title[row] = rank[narrowAt(COLUMN_TITLE)[row]];
+        artist[row] = rank[narrowAt(COLUMN_ARTIST)[row]];
+        album[row] = rank[narrowAt(COLUMN_ALBUM)[row]];
+    }
+    const std::vector<uint32_t>& trackNumber = narrowAt(COLUMN_TRACK_NUMBER);
+    const std::vector<uint32_t>& sampleRate = narrowAt(COLUMN_SAMPLE_RATE);
+    const std::vector<uint32_t>& bitDepth = narrowAt(COLUMN_BIT_DEPTH);
+    const std::vector<uint32_t>& flags = narrowAt(COLUMN_FLAGS);
+    const std::vector<int64_t>& ids = wide[COLUMN_ID];
+
+    std::vector<std::vector<uint32_t>> orders(SNAPSHOT_ORDERS, std::vector<uint32_t>(rows));
+    for (auto& order : orders) std::iota(order.begin(), order.end(), 0u);
+    std::sort(orders[ORDER_TITLE].begin(), orders[ORDER_TITLE].end(), [&](uint32_t a, uint32_t b) {
+        return std::tie(title[a], ids[a]) < std::tie(title[b], ids[b]);
+    });
+    std::sort(orders[ORDER_ARTIST].begin(), orders[ORDER_ARTIST].end(), [&](uint32_t a, uint32_t b) {
+        return std::tie(artist[a], album[a], trackNumber[a], title[a], ids[a]) <
+               std::tie(artist[b], album[b], trackNumber[b], title[b], ids[b]);
+    });
+    std::sort(orders[ORDER_ALBUM].begin(), orders[ORDER_ALBUM].end(), [&](uint32_t a, uint32_t b) {
+        return std::tie(album[a], trackNumber[a], title[a], ids[a]) <
+               std::tie(album[b], trackNumber[b], title[b], ids[b]);
+    });
+    std::sort(orders[ORDER_SAMPLE_RATE].begin(), orders[ORDER_SAMPLE_RATE].end(), [&](uint32_t a, uint32_t b) {
+        uint32_t hiResA = flags[a] & SNAPSHOT_FLAG_HI_RES;
+        uint32_t hiResB = flags[b] & SNAPSHOT_FLAG_HI_RES;
+        return std::tie(hiResB, sampleRate[b], bitDepth[b], title[a], ids[a]) <
+               std::tie(hiResA, sampleRate[a], bitDepth[a], title[b], ids[b]);
+    });
+
+    // String table
+    std::vector<uint32_t> stringOffsets(strings.size() + 1, 0);
+    std::string stringBytes;
+    for (uint32_t i = 0; i < strings.size(); ++i) {
+        stringBytes += strings.at(i);
+        if (stringBytes.size() > UINT32_MAX) {
+            LOGE("Snapshot strings exceed 4 GB");
+            return false;
+        }
+        stringOffsets[i + 1] = static_cast<uint32_t>(stringBytes.size());
+    }
+
+    // Layout
+    std::vector<uint64_t> offsets(SNAPSHOT_SECTIONS);
+    uint64_t position = sizeof(SnapshotHeader) + SNAPSHOT_SECTIONS * sizeof(uint64_t);
+    for (uint32_t s = 0; s < SNAPSHOT_SECTIONS; ++s) {
+        position = align8(position);
+        offsets[s] = position;
+        position += s == STRING_BYTES_SECTION ? stringBytes.size()
+                                              : sectionBytes(s, rows, static_cast<uint32_t>(strings.size()));
+    }
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.rowCount = rows;
+    header.stringCount = static_cast<uint32_t>(strings.size());
+    header.hiResCount = hiResCount;
+    header.sectionCount = SNAPSHOT_SECTIONS;
+    header.createdMs = createdMs;
+    header.fileBytes = position;
+
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOGE("Cannot create %s", tempPath.c_str());
+        return false;
+    }
+    uint64_t written = sizeof(header) + offsets.size() * sizeof(uint64_t);
+    bool ok = writeAll(file, &header, sizeof(header)) &&
+              writeAll(file, offsets.data(), offsets.size() * sizeof(uint64_t));
+    for (const auto& column : wide) {
+        ok = ok && pad(file, written) && writeAll(file, column.data(), column.size() * sizeof(int64_t));
+        written += column.size() * sizeof(int64_t);
+    }
+    for (const auto& column : narrow) {
+        ok = ok && pad(file, written) && writeAll(file, column.data(), column.size() * sizeof(uint32_t));
+        written += column.size() * sizeof(uint32_t);
+    }
+    for (const auto& order : orders) {
+        ok = ok && pad(file, written) && writeAll(file, order.data(), order.size() * sizeof(uint32_t));
+        written += order.size() * sizeof(uint32_t);
+    }
+    ok = ok && pad(file, written) && writeAll(file, stringOffsets.data(), stringOffsets.size() * sizeof(uint32_t));
+    written += stringOffsets.size() * sizeof(uint32_t);
+    ok = ok && pad(file, written) && writeAll(file, stringBytes.data(), stringBytes.size());
+    written += stringBytes.size();
+    ok = (std::fclose(file) == 0) && ok && written == position;
+
+    // Readers only ever see a complete snapshot
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        LOGE("Failed to write %s", path.c_str());
+        return false;
+    }
+
+    SnapshotWriteStats result;
+    result.rows = rows;
+    result.strings = header.stringCount;
+    result.bytes = position;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (stats) {
+        *stats = result;
+    }
+    LOGI("Library snapshot: %u tracks, %u strings, %llu bytes in %.0f ms -> %s", rows, result.strings,
+         static_cast<unsigned long long>(position), result.seconds * 1000.0, path.c_str());
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// READER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+LibrarySnapshot::~LibrarySnapshot() {
+    unmap();
+}
+
+bool LibrarySnapshot::map(const std::string& path) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    constexpr size_t PREFIX = sizeof(SnapshotHeader) + SNAPSHOT_SECTIONS * sizeof(uint64_t);
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(PREFIX)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const auto* header = static_cast<const SnapshotHeader*>(mapping);
+    const auto* sections = reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(mapping) +
+                                                             sizeof(SnapshotHeader));
+    bool valid = std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == SNAPSHOT_VERSION &&
+                 header->sectionCount == SNAPSHOT_SECTIONS &&
+                 header->fileBytes == length &&
+                 header->hiResCount <= header->rowCount;
+
+    // Sections are aligned, ascending and inside the file
+    uint64_t end = PREFIX;
+    for (uint32_t s = 0; valid && s < STRING_BYTES_SECTION; ++s) {
+        uint64_t bytes = sectionBytes(s, header->rowCount, header->stringCount);
+        valid = sections[s] % 8 == 0 && sections[s] >= end && sections[s] + bytes <= length;
+        end = sections[s] + bytes;
+    }
+    if (valid) {
+        const auto* stringOffsets = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(mapping) +
+                                                                      sections[STRING_OFFSETS_SECTION]);
+        valid = sections[STRING_BYTES_SECTION] >= end &&
+                sections[STRING_BYTES_SECTION] + stringOffsets[header->stringCount] == length;
+    }
+    if (!valid) {
+        munmap(mapping, length);
+        LOGE("Ignoring invalid snapshot %s", path.c_str());
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mappedBytes = length;
+    m_header = header;
+    m_sections = sections;
+    return true;
+}
+
+void LibrarySnapshot::unmap() {
+    if (m_mapping) {
+        munmap(m_mapping, m_mappedBytes);
+    }
+    m_mapping = nullptr;
+    m_mappedBytes = 0;
+    m_header = nullptr;
+    m_sections = nullptr;
+}
+
+const uint8_t* LibrarySnapshot::section(uint32_t index) const {
+    return static_cast<const uint8_t*>(m_mapping) + m_sections[index];
+}
+
+const int64_t* LibrarySnapshot::wideColumn(SnapshotColumn column) const {
+    return column < SNAPSHOT_WIDE_COLUMNS ? reinterpret_cast<const int64_t*>(section(column)) : nullptr;
+}
+
+const uint32_t* LibrarySnapshot::narrowColumn(SnapshotColumn column) const {
+    return column >= SNAPSHOT_WIDE_COLUMNS && column < SNAPSHOT_COLUMNS
+               ? reinterpret_cast<const uint32_t*>(section(column)) : nullptr;
+}
+
+const uint32_t* LibrarySnapshot::order(SnapshotOrder order) const {
+    return reinterpret_cast<const uint32_t*>(section(ORDER_SECTION + order));
+}
+
+const char* LibrarySnapshot::string(uint32_t index, uint32_t& length) const {
+    const auto* offsets = reinterpret_cast<const uint32_t*>(section(STRING_OFFSETS_SECTION));
+    length = 0;
+    if (index >= m_header->stringCount || offsets[index] > offsets[index + 1] ||
+        offsets[index + 1] > offsets[m_header->stringCount]) {
+        return "";
+    }
+    length = offsets[index + 1] - offsets[index];
+    return reinterpret_cast<const char*>(section(STRING_BYTES_SECTION)) + offsets[index];
+}
+
+std::string LibrarySnapshot::text(SnapshotColumn column, uint32_t row) const {
+    const uint32_t* indices = column >= SNAPSHOT_FIRST_STRING_COLUMN ? narrowColumn(column) : nullptr;
+    if (!indices || row >= rowCount()) {
+        return {};
+    }
+    uint32_t length;
+    const char* chars = string(indices[row], length);
+    return std::string(chars, length);
+}
+
+SnapshotTrack LibrarySnapshot::track(uint32_t row) const {
+    SnapshotTrack track;
+    if (row >= rowCount()) {
+        return track;
+    }
+    track.id = wideColumn(COLUMN_ID)[row];
+    track.durationMs = wideColumn(COLUMN_DURATION_MS)[row];
+    track.fileSize = wideColumn(COLUMN_FILE_SIZE)[row];
+    track.dateAdded = wideColumn(COLUMN_DATE_ADDED)[row];
+    track.sampleRate = narrowColumn(COLUMN_SAMPLE_RATE)[row];
+    track.bitRate = narrowColumn(COLUMN_BIT_RATE)[row];
+    track.channels = narrowColumn(COLUMN_CHANNELS)[row];
+    track.bitDepth = narrowColumn(COLUMN_BIT_DEPTH)[row];
+    track.year = narrowColumn(COLUMN_YEAR)[row];
+    track.trackNumber = narrowColumn(COLUMN_TRACK_NUMBER)[row];
+    track.flags = narrowColumn(COLUMN_FLAGS)[row];
+    track.title = text(COLUMN_TITLE, row);
+    track.artist = text(COLUMN_ARTIST, row);
+    track.album = text(COLUMN_ALBUM, row);
+    track.filePath = text(COLUMN_FILE_PATH, row);
+    track.mimeType = text(COLUMN_MIME_TYPE, row);
+    track.codec = text(COLUMN_CODEC, row);
+    return track;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,170 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             LIBRARY SNAPSHOT - COLUMNAR TRACK LIST          ║
+ * ║       Memory-Mapped Rows & Sort Orders for Cold Start       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A read-only copy of the tracks table, written after each library scan
+ * and mapped at startup so the library list has rows before Room has
+ * loaded anything. Room stays the source of truth; the snapshot only
+ * bridges the first seconds.
+ *
+ * File layout (native endian, every section 8-byte aligned):
+ *   SnapshotHeader   (64 bytes)
+ *   uint64_t         sectionOffsets[SNAPSHOT_SECTIONS]
+ *   int64_t          column[rowCount]        per SNAPSHOT_WIDE_COLUMNS
+ *   uint32_t         column[rowCount]        per narrow column; string
+ *                                            columns hold string indices
+ *   uint32_t         order[rowCount]         per SnapshotOrder: row numbers
+ *   uint32_t         stringOffsets[stringCount + 1]
+ *   char             stringBytes[]           UTF-8, not terminated
+ *
+ * Strings are interned, so an artist or album repeated over hundreds of
+ * tracks is stored once. Reading row i of an order is two array loads
+ * plus the string lookups: nothing is parsed or allocated up front, and
+ * the Kotlin side reads the same mapping through a direct ByteBuffer.
+ */
+
+#ifndef FTL_LIBRARY_SNAPSHOT_H
+#define FTL_LIBRARY_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// int64 columns, then uint32 columns; the order is the file's section order
+enum SnapshotColumn : uint32_t {
+    COLUMN_ID = 0,
+    COLUMN_DURATION_MS,
+    COLUMN_FILE_SIZE,
+    COLUMN_DATE_ADDED,
+    COLUMN_SAMPLE_RATE,
+    COLUMN_BIT_RATE,
+    COLUMN_CHANNELS,
+    COLUMN_BIT_DEPTH,
+    COLUMN_YEAR,                    // 0 when unknown
+    COLUMN_TRACK_NUMBER,            // 0 when unknown
+    COLUMN_FLAGS,                   // SNAPSHOT_FLAG_*
+    COLUMN_TITLE,
+    COLUMN_ARTIST,
+    COLUMN_ALBUM,
+    COLUMN_FILE_PATH,
+    COLUMN_MIME_TYPE,
+    COLUMN_CODEC,
+    SNAPSHOT_COLUMNS
+};
+
+constexpr uint32_t SNAPSHOT_WIDE_COLUMNS = COLUMN_SAMPLE_RATE;
+constexpr uint32_t SNAPSHOT_FIRST_STRING_COLUMN = COLUMN_TITLE;
+
+constexpr uint32_t SNAPSHOT_FLAG_HI_RES = 1u << 0;
+constexpr uint32_t SNAPSHOT_FLAG_FAVORITE = 1u << 1;
+
+/** The library screen's views */
+enum SnapshotOrder : uint32_t {
+    ORDER_TITLE = 0,                // Title
+    ORDER_ARTIST,                   // Artist, album, track number
+    ORDER_ALBUM,                    // Album, track number
+    ORDER_SAMPLE_RATE,              // Hi-res first, then sample rate and bit depth, highest first
+    SNAPSHOT_ORDERS
+};
+
+// Columns, orders, string offsets, string bytes
+constexpr uint32_t SNAPSHOT_SECTIONS = SNAPSHOT_COLUMNS + SNAPSHOT_ORDERS + 2;
+
+struct SnapshotHeader {
+    char magic[8];                  // "FTLSNAP"
+    uint32_t version;
+    uint32_t rowCount;
+    uint32_t stringCount;
+    uint32_t hiResCount;            // Leading rows of ORDER_SAMPLE_RATE that are hi-res
+    uint32_t sectionCount;
+    uint32_t reserved0;
+    int64_t createdMs;              // Wall clock at write
+    uint64_t fileBytes;
+    uint64_t reserved[2];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header is 64 bytes");
+
+/** One track as the writer takes it (a row of the tracks table) */
+struct SnapshotTrack {
+    int64_t id = 0;
+    int64_t durationMs = 0;
+    int64_t fileSize = 0;
+    int64_t dateAdded = 0;
+    uint32_t sampleRate = 0;
+    uint32_t bitRate = 0;
+    uint32_t channels = 0;
+    uint32_t bitDepth = 0;
+    uint32_t year = 0;
+    uint32_t trackNumber = 0;
+    uint32_t flags = 0;
+    std::string title;
+    std::string artist;
+    std::string album;
+    std::string filePath;
+    std::string mimeType;
+    std::string codec;
+};
+
+struct SnapshotWriteStats {
+    uint32_t rows = 0;
+    uint32_t strings = 0;           // Distinct strings after interning
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+};
+
+class LibrarySnapshot {
+public:
+    LibrarySnapshot() = default;
+    ~LibrarySnapshot();
+
+    /** Sort, intern and write atomically (temp file + rename) */
+    static bool write(const std::string& path, const std::vector<SnapshotTrack>& tracks, int64_t createdMs,
+                      SnapshotWriteStats* stats = nullptr);
+
+    /** Map a snapshot; fails if missing, corrupt or from another version */
+    bool map(const std::string& path);
+    void unmap();
+    bool isMapped() const { return m_header != nullptr; }
+
+    const SnapshotHeader& header() const { return *m_header; }
+    uint32_t rowCount() const { return m_header ? m_header->rowCount : 0; }
+    const void* data() const { return m_mapping; }
+    size_t mappedBytes() const { return m_mappedBytes; }
+
+    const int64_t* wideColumn(SnapshotColumn column) const;
+    const uint32_t* narrowColumn(SnapshotColumn column) const;
+    /** Row numbers in `order`: position -> row */
+    const uint32_t* order(SnapshotOrder order) const;
+
+    /** String `index` (not terminated) */
+    const char* string(uint32_t index, uint32_t& length) const;
+    std::string text(SnapshotColumn column, uint32_t row) const;
+
+    /** Materialize one row (tests and the bench; Kotlin reads the mapping itself) */
+    SnapshotTrack track(uint32_t row) const;
+
+private:
+    const uint8_t* section(uint32_t index) const;
+
+    void* m_mapping = nullptr;
+    size_t m_mappedBytes = 0;
+    const SnapshotHeader* m_header = nullptr;
+    const uint64_t* m_sections = nullptr;
+
+    LibrarySnapshot(const LibrarySnapshot&) = delete;
+    LibrarySnapshot& operator=(const LibrarySnapshot&) = delete;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_LIBRARY_SNAPSHOT_H
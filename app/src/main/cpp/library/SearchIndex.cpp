@@ -0,0 +1,707 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              SEARCH INDEX - TRIGRAM LIBRARY SEARCH          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Each distinct word is stored once in an ordered vocabulary, so a
+ * prefix is a range scan. Words of three or more code points are also
+ * listed under their trigrams (three 21-bit code points packed into 64
+ * bits): a substring intersects those lists, and a typo needs only a
+ * share of them before the edit distance is checked. Queries touch
+ * words, never track text; track scores come from the matched words'
+ * posting lists, accumulated in per-thread scratch arrays.
+ */
+
+#include "SearchIndex.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+#define LOG_TAG "FTL_SearchIndex"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+// Score of one token by where it matched, times the field weight
+constexpr float FIELD_WEIGHT[] = {1.0f, 0.8f, 0.6f};   // Title, artist, album
+constexpr float MATCH_FIELD_START = 1.0f;
+constexpr float MATCH_WORD_PREFIX = 0.8f;
+constexpr float MATCH_SUBSTRING = 0.4f;
+constexpr float MATCH_FUZZY = 0.25f;                    // Halved for two edits
+constexpr float MATCH_WHOLE_FIELD = 0.5f;               // Extra when the query is the whole field
+
+enum ScoreTable { TABLE_PREFIX, TABLE_WHOLE, TABLE_SUBSTRING, TABLE_FUZZY_1, TABLE_FUZZY_2, SCORE_TABLES };
+
+constexpr size_t FUZZY_MIN_POINTS = 4;
+constexpr size_t FUZZY_TWO_EDIT_POINTS = 8;
+constexpr size_t FUZZY_MAX_POINTS = 32;                 // Longer tokens are not typo-checked
+constexpr size_t MAX_QUERY_TOKENS = 16;
+
+constexpr int64_t DEAD_DOC = INT64_MIN;
+
+// Compact once a quarter of the documents are superseded
+constexpr size_t COMPACT_MIN_DEAD = 1024;
+// Batches at least this large (library scans) trim posting capacity afterwards
+constexpr size_t TRIM_BATCH = 1024;
+
+constexpr char32_t SPACE = U' ';
+constexpr char32_t DROP = 0;
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TEXT FOLDING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+// U+00C0..U+00FF; \x01 ae, \x02 th, \x03 ss
+constexpr char LATIN1_FOLD[] =
+    "aaaaaa" "\x01" "ceeeeiiiidnooooo" " " "ouuuuy" "\x02" "\x03"
+    "aaaaaa" "\x01" "ceeeeiiiidnooooo" " " "ouuuuy" "\x02" "y";
+static_assert(sizeof(LATIN1_FOLD) == 64 + 1, "U+00C0..U+00FF");
+
+// U+0100..U+017F; \x04 ij, \x05 oe
+constexpr char LATIN_EXT_A_FOLD[] =
+    "aaaaaa" "cccccccc" "dddd" "eeeeeeeeee" "gggggggg" "hhhh" "iiiiiiiiii" "\x04\x04" "jj" "kkk"
+    "llllllllll" "nnnnnnn" "nn" "oooooo" "\x05\x05" "rrrrrr" "ssssssss" "tttttt" "uuuuuuuuuuuu"
+    "ww" "yyy" "zzzzzz" "s";
+static_assert(sizeof(LATIN_EXT_A_FOLD) == 128 + 1, "U+0100..U+017F");
+
+void appendFolded(char c, std::u32string& out) {
+    switch (c) {
+        case '\x01': out += U"ae"; break;
+        case '\x02': out += U"th"; break;
+        case '\x03': out += U"ss"; break;
+        case '\x04': out += U"ij"; break;
+        case '\x05': out += U"oe"; break;
+        default: out += static_cast<char32_t>(c); break;
+    }
+}
+
+char32_t foldGreek(char32_t cp) {
+    switch (cp) {
+        case 0x386: case 0x3AC: return 0x3B1;
+        case 0x388: case 0x3AD: return 0x3B5;
+        case 0x389: case 0x3AE: return 0x3B7;
+        case 0x38A: case 0x3AF: case 0x3CA: case 0x390: return 0x3B9;
+        case 0x38C: case 0x3CC: return 0x3BF;
+        case 0x38E: case 0x3CD: case 0x3CB: case 0x3B0: return 0x3C5;
+        case 0x38F: case 0x3CE: return 0x3C9;
+        case 0x3C2: return 0x3C3;       // Final sigma
+        default: break;
+    }
+    return cp >= 0x391 && cp <= 0x3A9 ? cp + 0x20 : cp;
+}
+
+char32_t foldCyrillic(char32_t cp) {
+    if (cp >= 0x400 && cp <= 0x40F) cp += 0x50;
+    else if (cp >= 0x410 && cp <= 0x42F) cp += 0x20;
+    return cp == 0x451 ? 0x435 : cp;    // ё as е
+}
+
+/** Lowercase / fold one code point; DROP removes it, SPACE separates words */
+void foldCodePoint(char32_t cp, std::u32string& out) {
+    if (cp >= 0xFF01 && cp <= 0xFF5E) {
+        cp -= 0xFEE0;                   // Fullwidth ASCII
+    }
+    if (cp < 0x80) {
+        if (cp >= 'A' && cp <= 'Z') out += cp + ('a' - 'A');
+        else if ((cp >= 'a' && cp <= 'z') || (cp >= '0' && cp <= '9')) out += cp;
+        else if (cp != '\'') out += SPACE;
+        return;
+    }
+    if (cp < 0xC0) {
+        out += SPACE;
+    } else if (cp < 0x100) {
+        appendFolded(LATIN1_FOLD[cp - 0xC0], out);
+    } else if (cp < 0x180) {
+        appendFolded(LATIN_EXT_A_FOLD[cp - 0x100], out);
+    } else if (cp >= 0x300 && cp <= 0x36F) {
+        // Combining marks: decomposed (NFD) tags fold like precomposed ones
+    } else if (cp >= 0x370 && cp <= 0x3FF) {
+        out += foldGreek(cp);
+    } else if (cp >= 0x400 && cp <= 0x4FF) {
+        out += foldCyrillic(cp);
+    } else if (cp == 0x2018 || cp == 0x2019) {
+        // Typographic apostrophes, dropped like '
+    } else if ((cp >= 0x2000 && cp <= 0x206F) || (cp >= 0x3000 && cp <= 0x3003) || cp == 0xFFFD) {
+        out += SPACE;
+    } else {
+        out += cp;
+    }
+}
+
+/** Decode UTF-8; malformed bytes come back as U+FFFD */
+char32_t nextCodePoint(const std::string& text, size_t& i) {
+    auto byte = [&](size_t k) { return static_cast<uint8_t>(text[k]); };
+    uint8_t lead = byte(i++);
+    if (lead < 0x80) return lead;
+    int extra = lead >= 0xF5 ? -1 : lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC2 ? 1 : -1;
+    if (extra < 0) return 0xFFFD;
+    char32_t cp = lead & (0x3F >> extra);
+    for (int k = 0; k < extra; ++k) {
+        if (i >= text.size() || (byte(i) & 0xC0) != 0x80) return 0xFFFD;
+        cp = (cp << 6) | (byte(i++) & 0x3F);
+    }
+    return cp;
+}
+
+void appendUtf8(std::string& out, char32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+/** Folded code points, words separated by one space, no leading / trailing space */
+std::u32string foldText(const std::string& text) {
+    std::u32string folded;
+    folded.reserve(text.size());
+    for (size_t i = 0; i < text.size();) {
+        foldCodePoint(nextCodePoint(text, i), folded);
+    }
+    std::u32string words;
+    words.reserve(folded.size());
+    for (char32_t cp : folded) {
+        if (cp == SPACE && (words.empty() || words.back() == SPACE)) continue;
+        words += cp;
+    }
+    if (!words.empty() && words.back() == SPACE) words.pop_back();
+    return words;
+}
+
+std::string toUtf8(const std::u32string& points, size_t maxBytes) {
+    std::string text;
+    for (char32_t cp : points) {
+        size_t before = text.size();
+        appendUtf8(text, cp);
+        if (text.size() > maxBytes) {
+            text.resize(before);
+            break;
+        }
+    }
+    while (!text.empty() && text.back() == ' ') text.pop_back();
+    return text;
+}
+
+std::u32string toPoints(const std::string& text) {
+    std::u32string points;
+    points.reserve(text.size());
+    for (size_t i = 0; i < text.size();) points += nextCodePoint(text, i);
+    return points;
+}
+
+std::vector<std::u32string> splitWords(const std::u32string& text) {
+    std::vector<std::u32string> words;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(SPACE, start);
+        if (end == std::u32string::npos) end = text.size();
+        if (end > start) words.emplace_back(text, start, end - start);
+        start = end + 1;
+    }
+    return words;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TRIGRAMS, POSTINGS & EDIT DISTANCE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+uint64_t makeKey(char32_t a, char32_t b, char32_t c) {
+    return (static_cast<uint64_t>(a & 0x1FFFFF) << 42) | (static_cast<uint64_t>(b & 0x1FFFFF) << 21) | (c & 0x1FFFFF);
+}
+
+std::vector<uint64_t> trigramsOf(const std::u32string& word) {
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i + 3 <= word.size(); ++i) {
+        keys.push_back(makeKey(word[i], word[i + 1], word[i + 2]));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+int maxEditsFor(size_t points) {
+    return points >= FUZZY_TWO_EDIT_POINTS ? 2 : points >= FUZZY_MIN_POINTS ? 1 : 0;
+}
+
+void appendVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        bytes.push_back(static_cast<uint8_t>(byte | (value ? 0x80 : 0)));
+    } while (value);
+}
+
+/** Visit (doc, flags) entries of a posting list */
+template <typename Visit>
+void forEachEntry(const std::vector<uint8_t>& bytes, int flagBits, Visit&& visit) {
+    uint32_t doc = 0;
+    size_t i = 0;
+    while (i < bytes.size()) {
+        uint64_t value = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+            byte = bytes[i++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while ((byte & 0x80) && i < bytes.size());
+        doc += static_cast<uint32_t>(value >> flagBits);
+        visit(doc, static_cast<unsigned>(value & ((1u << flagBits) - 1)));
+    }
+}
+
+/**
+ * Fewest edits (insert, delete, substitute, swap adjacent) turning
+ * `token` into a prefix of `word` - what the user meant to be typing.
+ * @return maxEdits + 1 once every alignment is past maxEdits
+ */
+int prefixEditDistance(const std::u32string& token, const std::u32string& word, int maxEdits) {
+    const size_t m = token.size();
+    int prev2[FUZZY_MAX_POINTS + 1];
+    int prev[FUZZY_MAX_POINTS + 1];
+    int row[FUZZY_MAX_POINTS + 1];
+    for (size_t i = 0; i <= m; ++i) prev[i] = static_cast<int>(i);
+    int best = prev[m];
+    for (size_t j = 1; j <= word.size(); ++j) {
+        row[0] = static_cast<int>(j);
+        int columnMin = row[0];
+        for (size_t i = 1; i <= m; ++i) {
+            int cost = token[i - 1] == word[j - 1] ? 0 : 1;
+            int value = std::min({prev[i - 1] + cost, prev[i] + 1, row[i - 1] + 1});
+            if (i > 1 && j > 1 && token[i - 1] == word[j - 2] && token[i - 2] == word[j - 1]) {
+                value = std::min(value, prev2[i - 2] + 1);
+            }
+            row[i] = value;
+            columnMin = std::min(columnMin, value);
+        }
+        best = std::min(best, row[m]);
+        if (best == 0 || columnMin > maxEdits) break;
+        std::copy(prev, prev + m + 1, prev2);
+        std::copy(row, row + m + 1, prev);
+    }
+    return std::min(best, maxEdits + 1);
+}
+
+/** Dense per-document accumulators, reused across queries on the same thread */
+struct QueryScratch {
+    std::vector<float> tokenBest;
+    std::vector<float> total;
+    std::vector<uint8_t> matched;       // Tokens matched so far
+    std::vector<uint32_t> touched;
+    std::vector<uint32_t> pool;         // Every document the first token reached
+    std::vector<uint8_t> shared;        // Fuzzy: trigrams shared, per word
+    std::vector<uint32_t> sharedWords;
+
+    void fit(size_t docs, size_t words) {
+        if (tokenBest.size() < docs) {
+            tokenBest.resize(docs, 0.0f);
+            total.resize(docs, 0.0f);
+            matched.resize(docs, 0);
+        }
+        if (shared.size() < words) shared.resize(words, 0);
+    }
+};
+
+QueryScratch& queryScratch() {
+    thread_local QueryScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// NORMALIZATION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+std::string SearchIndex::normalize(const std::string& text) {
+    return toUtf8(foldText(text), SIZE_MAX);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// UPDATES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void SearchIndex::upsert(const std::vector<SearchEntry>& entries) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    for (const SearchEntry& entry : entries) {
+        dropLocked(entry.trackId);
+        addLocked(entry);
+    }
+    compactIfNeededLocked();
+    if (entries.size() >= TRIM_BATCH) {
+        trimLocked();
+        LOGI("Search index: %zu tracks, %zu words after a batch of %zu",
+             m_docByTrack.size(), m_words.size(), entries.size());
+    }
+}
+
+void SearchIndex::upsert(const SearchEntry& entry) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    dropLocked(entry.trackId);
+    addLocked(entry);
+    compactIfNeededLocked();
+}
+
+size_t SearchIndex::remove(const std::vector<int64_t>& trackIds) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    size_t removed = 0;
+    for (int64_t id : trackIds) {
+        if (dropLocked(id)) ++removed;
+    }
+    compactIfNeededLocked();
+    return removed;
+}
+
+void SearchIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_trackOfDoc = {};
+    m_docByTrack = {};
+    m_words = {};
+    m_vocabulary.clear();
+    m_wordTrigrams = {};
+    m_deadDocs = 0;
+}
+
+uint32_t SearchIndex::wordIdLocked(const std::string& text) {
+    auto inserted = m_vocabulary.emplace(text, static_cast<uint32_t>(m_words.size()));
+    if (!inserted.second) {
+        return inserted.first->second;
+    }
+    uint32_t id = inserted.first->second;
+    m_words.push_back(Word{&inserted.first->first, Posting()});
+    // Word ids only grow, so every trigram list stays sorted
+    for (uint64_t key : trigramsOf(toPoints(text))) {
+        m_wordTrigrams[key].push_back(id);
+    }
+    return id;
+}
+
+void SearchIndex::addLocked(const SearchEntry& entry) {
+    auto doc = static_cast<uint32_t>(m_trackOfDoc.size());
+    m_trackOfDoc.push_back(entry.trackId);
+    m_docByTrack[entry.trackId] = doc;
+
+    // Field uses of each distinct word in this track
+    std::vector<std::pair<uint32_t, unsigned>> uses;
+    const std::string* fields[FIELD_COUNT] = {&entry.title, &entry.artist, &entry.album};
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        std::vector<std::u32string> words = splitWords(foldText(*fields[f]));
+        size_t bytes = 0;
+        for (size_t w = 0; w < words.size(); ++w) {
+            std::string text = toUtf8(words[w], SIZE_MAX);
+            bytes += text.size() + 1;
+            if (bytes > SEARCH_MAX_FIELD_BYTES + 1) break;
+            unsigned use = w > 0 ? IN_FIELD : words.size() == 1 ? WHOLE_FIELD : STARTS_FIELD;
+            uint32_t id = wordIdLocked(text);
+            auto it = std::find_if(uses.begin(), uses.end(), [id](const auto& u) { return u.first == id; });
+            if (it == uses.end()) it = uses.insert(uses.end(), {id, 0u});
+            unsigned shift = 2 * f;
+            unsigned current = (it->second >> shift) & 3;
+            it->second = (it->second & ~(3u << shift)) | (std::max(current, use) << shift);
+        }
+    }
+    for (const auto& use : uses) {
+        Posting& posting = m_words[use.first].docs;
+        uint32_t delta = doc - (posting.count > 0 ? posting.last : 0);
+        appendVarint(posting.bytes, (static_cast<uint64_t>(delta) << FLAG_BITS) | use.second);
+        posting.last = doc;
+        ++posting.count;
+    }
+}
+
+bool SearchIndex::dropLocked(int64_t trackId) {
+    auto it = m_docByTrack.find(trackId);
+    if (it == m_docByTrack.end()) {
+        return false;
+    }
+    m_trackOfDoc[it->second] = DEAD_DOC;
+    m_docByTrack.erase(it);
+    ++m_deadDocs;
+    return true;
+}
+
+void SearchIndex::compactIfNeededLocked() {
+    if (m_deadDocs < COMPACT_MIN_DEAD || m_deadDocs * 4 < m_trackOfDoc.size()) {
+        return;
+    }
+    LOGI("Search index compacting: %zu superseded of %zu documents", m_deadDocs, m_trackOfDoc.size());
+
+    // Renumber live documents in order, so rewritten postings stay ascending
+    std::vector<uint32_t> renumbered(m_trackOfDoc.size(), UINT32_MAX);
+    std::vector<int64_t> live;
+    live.reserve(m_trackOfDoc.size() - m_deadDocs);
+    for (uint32_t doc = 0; doc < m_trackOfDoc.size(); ++doc) {
+        if (m_trackOfDoc[doc] == DEAD_DOC) continue;
+        renumbered[doc] = static_cast<uint32_t>(live.size());
+        m_docByTrack[m_trackOfDoc[doc]] = renumbered[doc];
+        live.push_back(m_trackOfDoc[doc]);
+    }
+
+    // Rewrite postings, dropping words no live track uses
+    std::vector<Word> words;
+    std::vector<uint32_t> wordIds(m_words.size(), UINT32_MAX);
+    for (uint32_t id = 0; id < m_words.size(); ++id) {
+        Posting rewritten;
+        forEachEntry(m_words[id].docs.bytes, FLAG_BITS, [&](uint32_t doc, unsigned flags) {
+            uint32_t number = renumbered[doc];
+            if (number == UINT32_MAX) return;
+            uint32_t delta = number - (rewritten.count > 0 ? rewritten.last : 0);
+            appendVarint(rewritten.bytes, (static_cast<uint64_t>(delta) << FLAG_BITS) | flags);
+            rewritten.last = number;
+            ++rewritten.count;
+        });
+        if (rewritten.count == 0) {
+            m_vocabulary.erase(*m_words[id].text);
+            continue;
+        }
+        wordIds[id] = static_cast<uint32_t>(words.size());
+        words.push_back(Word{m_words[id].text, std::move(rewritten)});
+    }
+    for (auto& item : m_vocabulary) item.second = wordIds[item.second];
+    for (auto it = m_wordTrigrams.begin(); it != m_wordTrigrams.end();) {
+        std::vector<uint32_t>& list = it->second;
+        size_t kept = 0;
+        for (uint32_t id : list) {
+            if (wordIds[id] != UINT32_MAX) list[kept++] = wordIds[id];
+        }
+        list.resize(kept);
+        it = list.empty() ? m_wordTrigrams.erase(it) : std::next(it);
+    }
+
+    m_trackOfDoc = std::move(live);
+    m_words = std::move(words);
+    m_deadDocs = 0;
+    trimLocked();
+}
+
+void SearchIndex::trimLocked() {
+    for (Word& word : m_words) word.docs.bytes.shrink_to_fit();
+    for (auto& item : m_wordTrigrams) item.second.shrink_to_fit();
+    m_words.shrink_to_fit();
+    m_trackOfDoc.shrink_to_fit();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// QUERIES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void SearchIndex::matchWords(const std::string& token, const std::u32string& points, bool fuzzy,
+                             std::vector<WordMatch>& matches) const {
+    matches.clear();
+    // Prefixes: a range of the ordered vocabulary
+    for (auto it = m_vocabulary.lower_bound(token);
+         it != m_vocabulary.end() && it->first.compare(0, token.size(), token) == 0; ++it) {
+        matches.push_back({it->second, MatchKind::PREFIX, 0, it->first.size() == token.size()});
+    }
+
+    // Inside words: intersect the token's trigram lists, then confirm
+    std::vector<uint64_t> keys = trigramsOf(points);
+    if (!keys.empty()) {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint64_t key : keys) {
+            auto it = m_wordTrigrams.find(key);
+            if (it == m_wordTrigrams.end()) {
+                lists.clear();
+                break;
+            }
+            lists.push_back(&it->second);
+        }
+        if (!lists.empty()) {
+            std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+            for (uint32_t id : *lists[0]) {
+                bool everywhere = true;
+                for (size_t l = 1; l < lists.size() && everywhere; ++l) {
+                    everywhere = std::binary_search(lists[l]->begin(), lists[l]->end(), id);
+                }
+                const std::string& text = *m_words[id].text;
+                if (everywhere && text.find(token, 1) != std::string::npos && text.compare(0, token.size(), token) != 0) {
+                    matches.push_back({id, MatchKind::SUBSTRING, 0, false});
+                }
+            }
+        }
+    }
+
+    // Typos: words sharing enough trigrams (each edit breaks at most three), then edit distance
+    const int maxEdits = fuzzy ? maxEditsFor(points.size()) : 0;
+    if (maxEdits == 0 || points.size() > FUZZY_MAX_POINTS) {
+        return;
+    }
+    const int minShared = std::max(1, static_cast<int>(keys.size()) - 3 * maxEdits);
+    QueryScratch& scratch = queryScratch();
+    scratch.fit(0, m_words.size());
+    scratch.sharedWords.clear();
+    for (uint64_t key : keys) {
+        auto it = m_wordTrigrams.find(key);
+        if (it == m_wordTrigrams.end()) continue;
+        for (uint32_t id : it->second) {
+            if (scratch.shared[id]++ == 0) scratch.sharedWords.push_back(id);
+        }
+    }
+    std::vector<uint32_t> exact;
+    for (const WordMatch& match : matches) exact.push_back(match.word);
+    std::sort(exact.begin(), exact.end());
+    for (uint32_t id : scratch.sharedWords) {
+        int shared = scratch.shared[id];
+        scratch.shared[id] = 0;
+        if (shared < minShared || std::binary_search(exact.begin(), exact.end(), id)) continue;
+        int edits = prefixEditDistance(points, toPoints(*m_words[id].text), maxEdits);
+        if (edits > 0 && edits <= maxEdits) {
+            matches.push_back({id, MatchKind::FUZZY, edits, false});
+        }
+    }
+}
+
+void SearchIndex::collect(const std::vector<std::string>& tokens, const std::vector<std::u32string>& points,
+                          bool fuzzy, std::vector<SearchHit>& hits) const {
+    QueryScratch& scratch = queryScratch();
+    scratch.fit(m_trackOfDoc.size(), m_words.size());
+    scratch.pool.clear();
+    const bool singleToken = tokens.size() == 1;
+
+    // Score of every combination of field uses per kind of match, so decoding never branches per field
+    float tables[SCORE_TABLES][1u << FLAG_BITS];
+    for (int table = 0; table < SCORE_TABLES; ++table) {
+        for (unsigned flags = 0; flags < (1u << FLAG_BITS); ++flags) {
+            float best = 0.0f;
+            for (int f = 0; f < FIELD_COUNT; ++f) {
+                unsigned use = (flags >> (2 * f)) & 3;
+                if (use == 0) continue;
+                float kind = table == TABLE_FUZZY_1 ? MATCH_FUZZY
+                           : table == TABLE_FUZZY_2 ? MATCH_FUZZY / 2
+                           : table == TABLE_SUBSTRING ? MATCH_SUBSTRING
+                           : use >= STARTS_FIELD ? MATCH_FIELD_START : MATCH_WORD_PREFIX;
+                float value = kind * FIELD_WEIGHT[f];
+                // The query is an entire field: the artist "Queen" above "Queen of Hearts"
+                if (table == TABLE_WHOLE && use == WHOLE_FIELD && singleToken) value += MATCH_WHOLE_FIELD * FIELD_WEIGHT[f];
+                best = std::max(best, value);
+            }
+            tables[table][flags] = best;
+        }
+    }
+    auto tableFor = [](const WordMatch& match) {
+        switch (match.kind) {
+            case MatchKind::PREFIX: return match.whole ? TABLE_WHOLE : TABLE_PREFIX;
+            case MatchKind::SUBSTRING: return TABLE_SUBSTRING;
+            case MatchKind::FUZZY: break;
+        }
+        return match.edits > 1 ? TABLE_FUZZY_2 : TABLE_FUZZY_1;
+    };
+
+    std::vector<WordMatch> matches;
+    for (size_t t = 0; t < tokens.size(); ++t) {
+        matchWords(tokens[t], points[t], fuzzy, matches);
+        scratch.touched.clear();
+        const bool anyDead = m_deadDocs > 0;
+        for (const WordMatch& match : matches) {
+            const float* scoreOf = tables[tableFor(match)];
+            forEachEntry(m_words[match.word].docs.bytes, FLAG_BITS, [&](uint32_t doc, unsigned flags) {
+                // Only documents that matched every earlier token
+                if (scratch.matched[doc] != t || (anyDead && m_trackOfDoc[doc] == DEAD_DOC)) return;
+                float& best = scratch.tokenBest[doc];
+                if (best == 0.0f) scratch.touched.push_back(doc);
+                best = std::max(best, scoreOf[flags]);
+            });
+        }
+        for (uint32_t doc : scratch.touched) {
+            scratch.total[doc] += scratch.tokenBest[doc];
+            scratch.tokenBest[doc] = 0.0f;
+            scratch.matched[doc] = static_cast<uint8_t>(t + 1);
+        }
+        if (t == 0) scratch.pool = scratch.touched;
+    }
+
+    hits.clear();
+    hits.reserve(scratch.pool.size());
+    for (uint32_t doc : scratch.pool) {
+        if (scratch.matched[doc] == tokens.size()) hits.push_back({m_trackOfDoc[doc], scratch.total[doc]});
+        scratch.total[doc] = 0.0f;
+        scratch.matched[doc] = 0;
+    }
+}
+
+std::vector<SearchHit> SearchIndex::search(const std::string& query, size_t limit) const {
+    std::vector<std::u32string> points = splitWords(foldText(query));
+    if (points.empty() || limit == 0) {
+        return {};
+    }
+    // Matched-token counts are bytes
+    if (points.size() > MAX_QUERY_TOKENS) points.resize(MAX_QUERY_TOKENS);
+    std::vector<std::string> tokens;
+    for (const std::u32string& word : points) tokens.push_back(toUtf8(word, SIZE_MAX));
+
+    std::vector<SearchHit> hits;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        collect(tokens, points, false, hits);
+        bool typoTolerant = std::any_of(points.begin(), points.end(),
+                                        [](const std::u32string& p) { return maxEditsFor(p.size()) > 0; });
+        if (hits.size() < SEARCH_FUZZY_BELOW_HITS && typoTolerant) {
+            collect(tokens, points, true, hits);
+        }
+    }
+
+    auto better = [](const SearchHit& a, const SearchHit& b) {
+        return a.score != b.score ? a.score > b.score : a.trackId < b.trackId;
+    };
+    size_t count = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), better);
+    hits.resize(count);
+    return hits;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// STATISTICS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+size_t SearchIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_docByTrack.size();
+}
+
+SearchIndexStats SearchIndex::stats() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    // Hash nodes hold a next pointer and have a bucket pointer; tree nodes three pointers and a color
+    constexpr size_t HASH_NODE = 2 * sizeof(void*);
+    constexpr size_t TREE_NODE = 4 * sizeof(void*);
+
+    SearchIndexStats stats;
+    stats.tracks = m_docByTrack.size();
+    stats.words = m_words.size();
+    stats.trigrams = m_wordTrigrams.size();
+    for (const Word& word : m_words) stats.postingBytes += word.docs.bytes.capacity();
+
+    size_t vocabulary = 0;
+    for (const auto& item : m_vocabulary) {
+        const char* data = item.first.data();
+        bool inlined = data >= reinterpret_cast<const char*>(&item.first) &&
+                       data < reinterpret_cast<const char*>(&item.first + 1);
+        vocabulary += TREE_NODE + sizeof(item) + (inlined ? 0 : item.first.capacity() + 1);
+    }
+    size_t trigramLists = 0;
+    for (const auto& item : m_wordTrigrams) {
+        trigramLists += HASH_NODE + sizeof(item) + item.second.capacity() * sizeof(uint32_t);
+    }
+    stats.memoryBytes = stats.postingBytes + vocabulary + trigramLists +
+                        m_wordTrigrams.bucket_count() * sizeof(void*) +
+                        m_words.capacity() * sizeof(Word) +
+                        m_trackOfDoc.capacity() * sizeof(int64_t) +
+                        m_docByTrack.size() * (HASH_NODE + sizeof(std::pair<const int64_t, uint32_t>)) +
+                        m_docByTrack.bucket_count() * sizeof(void*);
+    return stats;
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,133 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              SEARCH INDEX - TRIGRAM LIBRARY SEARCH          ║
+ * ║     Prefix, Substring & Typo-Tolerant Search Per Keystroke  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * In-memory index over title, artist and album. Text is normalized
+ * (lowercase, diacritics and ligatures folded, combining marks dropped,
+ * punctuation to spaces) and split into words. Each distinct word keeps
+ * a compressed posting list of the tracks using it, and words are
+ * indexed by their trigrams, so a query token matches:
+ *   any length  as a word prefix     ("be" -> "Beatles")
+ *   3+ chars    inside a word        ("atle" -> "Beatles")
+ *   4+ chars    within 1-2 edits     ("beatels" -> "Beatles"), only when
+ *                                    the exact pass finds few tracks
+ * Every token must match one of the fields. Postings carry which fields
+ * use the word and whether it starts them, so ranking never rereads the
+ * text. Updates append under a new document number; superseded ones are
+ * dropped at the next compaction.
+ */
+
+#ifndef FTL_LIBRARY_SEARCH_INDEX_H
+#define FTL_LIBRARY_SEARCH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ftl_audio {
+
+constexpr size_t SEARCH_DEFAULT_LIMIT = 200;
+constexpr size_t SEARCH_MAX_FIELD_BYTES = 512;     // Normalized text indexed per field
+constexpr size_t SEARCH_FUZZY_BELOW_HITS = 10;     // Exact hits under which typos are tried
+
+struct SearchEntry {
+    int64_t trackId = 0;
+    std::string title;
+    std::string artist;
+    std::string album;
+};
+
+struct SearchHit {
+    int64_t trackId = 0;
+    float score = 0.0f;
+};
+
+struct SearchIndexStats {
+    size_t tracks = 0;
+    size_t words = 0;               // Distinct normalized words
+    size_t trigrams = 0;            // Distinct word trigrams
+    size_t postingBytes = 0;
+    size_t memoryBytes = 0;         // Estimate of everything the index holds
+};
+
+class SearchIndex {
+public:
+    SearchIndex() = default;
+
+    SearchIndex(const SearchIndex&) = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+
+    /** Add or replace tracks by ID; a large batch also trims posting capacity */
+    void upsert(const std::vector<SearchEntry>& entries);
+    void upsert(const SearchEntry& entry);
+    /** @return Number of tracks that were indexed */
+    size_t remove(const std::vector<int64_t>& trackIds);
+    void clear();
+
+    /** Best `limit` tracks, highest score first (ties by track ID) */
+    std::vector<SearchHit> search(const std::string& query, size_t limit = SEARCH_DEFAULT_LIMIT) const;
+
+    size_t size() const;
+    SearchIndexStats stats() const;
+
+    /** Folded form used for indexing and queries: words separated by single spaces */
+    static std::string normalize(const std::string& text);
+
+private:
+    enum Field { TITLE = 0, ARTIST = 1, ALBUM = 2, FIELD_COUNT = 3 };
+
+    // Per field, two bits of a posting entry
+    enum FieldUse : uint8_t { IN_FIELD = 1, STARTS_FIELD = 2, WHOLE_FIELD = 3 };
+    static constexpr int FLAG_BITS = 2 * FIELD_COUNT;
+
+    struct Posting {
+        std::vector<uint8_t> bytes;     // Varints of (doc delta << FLAG_BITS | field uses)
+        uint32_t last = 0;
+        uint32_t count = 0;
+    };
+
+    struct Word {
+        const std::string* text;        // Key in m_vocabulary
+        Posting docs;
+    };
+
+    enum class MatchKind { PREFIX, SUBSTRING, FUZZY };
+
+    struct WordMatch {
+        uint32_t word;
+        MatchKind kind;
+        int edits;                      // FUZZY only
+        bool whole;                     // The word is the token itself
+    };
+
+    void addLocked(const SearchEntry& entry);
+    bool dropLocked(int64_t trackId);
+    void compactIfNeededLocked();
+    void trimLocked();
+    uint32_t wordIdLocked(const std::string& text);
+
+    void matchWords(const std::string& token, const std::u32string& points, bool fuzzy,
+                    std::vector<WordMatch>& matches) const;
+    void collect(const std::vector<std::string>& tokens, const std::vector<std::u32string>& points,
+                 bool fuzzy, std::vector<SearchHit>& hits) const;
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<int64_t> m_trackOfDoc;                      // Doc number -> track, DEAD_DOC once superseded
+    std::unordered_map<int64_t, uint32_t> m_docByTrack;
+    std::map<std::string, uint32_t> m_vocabulary;           // Ordered: prefixes are ranges
+    std::vector<Word> m_words;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_wordTrigrams;
+    size_t m_deadDocs = 0;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_LIBRARY_SEARCH_INDEX_H
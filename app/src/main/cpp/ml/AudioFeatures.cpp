@@ -0,0 +1,220 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║         AUDIO FEATURES - MODEL INPUT EXTRACTION             ║
+ * ║      Log-Mel, Spectral and Dynamics Summary of a Clip       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "AudioFeatures.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr double MEL_LOW_HZ = 30.0;
+constexpr double MEL_HIGH_HZ = 16000.0;
+constexpr double ROLLOFF_SHARE = 0.85;
+constexpr double LOG_FLOOR = 1e-10;
+
+constexpr int STATS_OFFSET = 0;
+constexpr int MEL_MEAN_OFFSET = 4;
+constexpr int MEL_STD_OFFSET = MEL_MEAN_OFFSET + FEATURE_MEL_BANDS;
+constexpr int SPECTRAL_OFFSET = MEL_STD_OFFSET + FEATURE_MEL_BANDS;
+constexpr int DYNAMICS_OFFSET = SPECTRAL_OFFSET + 8;
+static_assert(DYNAMICS_OFFSET + 4 == FEATURE_SIZE, "feature layout");
+
+double hzToMel(double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); }
+double melToHz(double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); }
+
+struct RunningStats {
+    double sum = 0.0;
+    double squares = 0.0;
+
+    void add(double value) {
+        sum += value;
+        squares += value * value;
+    }
+    float mean(int count) const { return static_cast<float>(sum / count); }
+    float deviation(int count) const {
+        double m = sum / count;
+        return static_cast<float>(std::sqrt(std::max(0.0, squares / count - m * m)));
+    }
+};
+
+} // namespace
+
+FeatureExtractor::FeatureExtractor() : m_fft(FEATURE_FFT_SIZE) {}
+
+void FeatureExtractor::configure(int sampleRate) {
+    m_sampleRate = sampleRate;
+    m_bands.assign(FEATURE_MEL_BANDS, MelBand());
+    const int bins = FEATURE_FFT_SIZE / 2;
+    const double binHz = static_cast<double>(sampleRate) / FEATURE_FFT_SIZE;
+    const double lowMel = hzToMel(MEL_LOW_HZ);
+    const double highMel = hzToMel(std::min(MEL_HIGH_HZ, 0.475 * sampleRate));
+
+    // Triangles between consecutive edges, at least one bin wide at the bottom
+    std::vector<double> edges(FEATURE_MEL_BANDS + 2);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        edges[i] = melToHz(lowMel + (highMel - lowMel) * i / (FEATURE_MEL_BANDS + 1)) / binHz;
+    }
+    for (int b = 0; b < FEATURE_MEL_BANDS; ++b) {
+        double left = edges[b], centre = edges[b + 1], right = edges[b + 2];
+        int first = std::max(1, static_cast<int>(std::ceil(left)));
+        int last = std::min(bins, static_cast<int>(std::floor(right)));
+        MelBand& band = m_bands[b];
+        band.firstBin = first;
+        for (int k = first; k <= last; ++k) {
+            double weight = k <= centre ? (k - left) / std::max(centre - left, 1e-9)
+                                        : (right - k) / std::max(right - centre, 1e-9);
+            band.weights.push_back(static_cast<float>(std::max(0.0, weight)));
+        }
+        if (band.weights.empty()) {
+            band.firstBin = std::min(bins, std::max(1, static_cast<int>(std::lround(centre))));
+            band.weights.push_back(1.0f);
+        }
+    }
+}
+
+void FeatureExtractor::extract(const float* input, int64_t frames, int channelCount, int sampleRate,
+                               float* features) {
+    FTL_TRACE_SCOPE("features.extract");
+    std::fill(features, features + FEATURE_SIZE, 0.0f);
+    if (!input || frames <= 0 || channelCount <= 0 || sampleRate <= 0) {
+        return;
+    }
+    if (sampleRate != m_sampleRate) {
+        configure(sampleRate);
+    }
+
+    // Mono mix, zero-padded to at least one analysis frame
+    m_mono.assign(static_cast<size_t>(std::max<int64_t>(frames, FEATURE_FFT_SIZE)), 0.0f);
+    const float channelScale = 1.0f / static_cast<float>(channelCount);
+    for (int64_t n = 0; n < frames; ++n) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < channelCount; ++ch) sum += input[n * channelCount + ch];
+        m_mono[n] = sum * channelScale;
+    }
+
+    // Time-domain statistics
+    double sum = 0.0, squares = 0.0;
+    float peak = 0.0f;
+    int64_t crossings = 0;
+    for (int64_t n = 0; n < frames; ++n) {
+        float x = m_mono[n];
+        sum += x;
+        squares += static_cast<double>(x) * x;
+        peak = std::max(peak, std::fabs(x));
+        if (n > 0 && (m_mono[n - 1] >= 0.0f) != (x >= 0.0f)) ++crossings;
+    }
+    const double rms = std::sqrt(squares / frames);
+    features[STATS_OFFSET] = static_cast<float>(sum / frames);
+    features[STATS_OFFSET + 1] = peak;
+    features[STATS_OFFSET + 2] = static_cast<float>(rms);
+    features[STATS_OFFSET + 3] = static_cast<float>(crossings) / static_cast<float>(frames);
+
+    // Spectral frames
+    const int hop = FEATURE_FFT_SIZE / 2;
+    const int bins = FEATURE_FFT_SIZE / 2;
+    const int frameCount = static_cast<int>((static_cast<int64_t>(m_mono.size()) - FEATURE_FFT_SIZE) / hop + 1);
+    const double powerScale = 1.0 / (static_cast<double>(FEATURE_FFT_SIZE) * FEATURE_FFT_SIZE);
+
+    RunningStats mel[FEATURE_MEL_BANDS];
+    RunningStats centroid, rolloff, flux, flatness;
+    m_magnitude.assign(bins + 1, 0.0f);
+    m_previousMagnitude.assign(bins + 1, 0.0f);
+    m_frameLevels.resize(frameCount);
+    m_frameFlux.resize(frameCount);
+    std::vector<double> power(bins + 1);
+
+    for (int f = 0; f < frameCount; ++f) {
+        const float* frame = m_mono.data() + static_cast<size_t>(f) * hop;
+        m_fft.transform(frame, 1, 0, true, m_spectrum);
+
+        double total = 0.0, weighted = 0.0, logSum = 0.0, magnitudeSum = 0.0, rise = 0.0;
+        for (int k = 1; k <= bins; ++k) {
+            power[k] = std::norm(m_spectrum[k]) * powerScale;
+            total += power[k];
+            weighted += k * power[k];
+            logSum += std::log(power[k] + LOG_FLOOR);
+            m_magnitude[k] = static_cast<float>(std::sqrt(power[k]));
+            magnitudeSum += m_magnitude[k];
+            if (f > 0) rise += std::max(0.0f, m_magnitude[k] - m_previousMagnitude[k]);
+        }
+        std::swap(m_magnitude, m_previousMagnitude);
+
+        for (int b = 0; b < FEATURE_MEL_BANDS; ++b) {
+            const MelBand& band = m_bands[b];
+            double energy = 0.0;
+            for (size_t i = 0; i < band.weights.size(); ++i) energy += band.weights[i] * power[band.firstBin + i];
+            mel[b].add(std::log10(energy + LOG_FLOOR));
+        }
+
+        double rolloffBin = 0.0;
+        if (total > 0.0) {
+            double cumulative = 0.0;
+            for (int k = 1; k <= bins; ++k) {
+                cumulative += power[k];
+                if (cumulative >= ROLLOFF_SHARE * total) {
+                    rolloffBin = k;
+                    break;
+                }
+            }
+            centroid.add(weighted / total / bins);
+            flatness.add(std::exp(logSum / bins) / (total / bins + LOG_FLOOR));
+        } else {
+            centroid.add(0.0);
+            flatness.add(0.0);
+        }
+        rolloff.add(rolloffBin / bins);
+        double frameFlux = magnitudeSum > 0.0 ? rise / magnitudeSum : 0.0;
+        flux.add(frameFlux);
+        m_frameFlux[f] = static_cast<float>(frameFlux);
+
+        double frameSquares = 0.0;
+        for (int n = 0; n < FEATURE_FFT_SIZE; ++n) frameSquares += static_cast<double>(frame[n]) * frame[n];
+        m_frameLevels[f] = static_cast<float>(std::sqrt(frameSquares / FEATURE_FFT_SIZE));
+    }
+
+    for (int b = 0; b < FEATURE_MEL_BANDS; ++b) {
+        features[MEL_MEAN_OFFSET + b] = mel[b].mean(frameCount);
+        features[MEL_STD_OFFSET + b] = mel[b].deviation(frameCount);
+    }
+    const RunningStats* spectral[] = {&centroid, &rolloff, &flux, &flatness};
+    for (int i = 0; i < 4; ++i) {
+        features[SPECTRAL_OFFSET + 2 * i] = spectral[i]->mean(frameCount);
+        features[SPECTRAL_OFFSET + 2 * i + 1] = spectral[i]->deviation(frameCount);
+    }
+
+    // Dynamics
+    features[DYNAMICS_OFFSET] = rms > 0.0 ? static_cast<float>(peak / rms / 10.0) : 0.0f;
+
+    double meanLevel = 0.0;
+    for (float level : m_frameLevels) meanLevel += level;
+    meanLevel /= frameCount;
+    int quiet = 0;
+    for (float level : m_frameLevels) quiet += level < meanLevel ? 1 : 0;
+    std::vector<float> sorted(m_frameLevels);
+    std::sort(sorted.begin(), sorted.end());
+    auto levelDb = [](float level) { return 20.0 * std::log10(level + 1e-6); };
+    double range = levelDb(sorted[static_cast<size_t>(0.95 * (frameCount - 1))]) -
+                   levelDb(sorted[static_cast<size_t>(0.10 * (frameCount - 1))]);
+    features[DYNAMICS_OFFSET + 1] = static_cast<float>(range / 60.0);
+    features[DYNAMICS_OFFSET + 2] = static_cast<float>(quiet) / static_cast<float>(frameCount);
+
+    // Onsets: local flux maxima a standard deviation above the mean
+    double threshold = flux.mean(frameCount) + flux.deviation(frameCount);
+    int onsets = 0;
+    for (int f = 1; f + 1 < frameCount; ++f) {
+        float value = m_frameFlux[f];
+        if (value > threshold && value >= m_frameFlux[f - 1] && value > m_frameFlux[f + 1]) ++onsets;
+    }
+    double seconds = static_cast<double>(frames) / sampleRate;
+    features[DYNAMICS_OFFSET + 3] = static_cast<float>(onsets / seconds / 10.0);
+}
+
+} // namespace ftl_audio
@@ -0,0 +1,65 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║         AUDIO FEATURES - MODEL INPUT EXTRACTION             ║
+ * ║      Log-Mel, Spectral and Dynamics Summary of a Clip       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * One 128-value vector per clip, the input of the genre, mood and EQ
+ * models. The clip is mixed to mono and framed at FEATURE_FFT_SIZE with
+ * 50% overlap (Blackman-Harris window); per-frame values are summarized
+ * by mean and standard deviation over the clip:
+ *
+ *   [0..4)      mean, peak |x|, RMS, zero-crossing rate (the layout the
+ *               Kotlin fallback fills, so it stays a drop-in)
+ *   [4..60)     log10 mel band energy, mean      (56 bands, 30 Hz - 16 kHz)
+ *   [60..116)   log10 mel band energy, std dev
+ *   [116..124)  centroid, 85% rolloff (fraction of Nyquist), flux,
+ *               flatness - mean, std dev each
+ *   [124..128)  crest factor, frame level range (p95 - p10, dB / 60),
+ *               low-energy frame ratio, onsets per second / 10
+ */
+
+#ifndef FTL_ML_AUDIO_FEATURES_H
+#define FTL_ML_AUDIO_FEATURES_H
+
+#include "SignalAnalysis.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ftl_audio {
+
+constexpr int FEATURE_SIZE = 128;
+constexpr int FEATURE_MEL_BANDS = 56;
+constexpr int FEATURE_FFT_SIZE = 2048;
+
+/** Reusable extractor; keeps its filterbank and scratch, one thread at a time */
+class FeatureExtractor {
+public:
+    FeatureExtractor();
+
+    /** Features of `frames` interleaved frames into `features[FEATURE_SIZE]` */
+    void extract(const float* input, int64_t frames, int channelCount, int sampleRate, float* features);
+
+private:
+    struct MelBand {
+        int firstBin;
+        std::vector<float> weights;
+    };
+
+    void configure(int sampleRate);
+
+    analysis::Fft m_fft;
+    int m_sampleRate = 0;
+    std::vector<MelBand> m_bands;
+    std::vector<float> m_mono;
+    std::vector<std::complex<double>> m_spectrum;
+    std::vector<float> m_magnitude, m_previousMagnitude;
+    std::vector<float> m_frameLevels, m_frameFlux;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_ML_AUDIO_FEATURES_H
@@ -0,0 +1,230 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            INFERENCE KERNELS - SIMD GEMM FLOAT & INT8       ║
+ * ║        Dense and Conv1D Building Blocks for Model Heads     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * int8 products are widened to int16 and summed pairwise into int32
+ * (SSE2 madd, NEON mull/mlal + pairwise add). Quantized values stay
+ * within +/-127, so a pair of products never exceeds int16 range.
+ */
+
+#include "InferenceKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_NN_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FTL_NN_SSE 1
+#endif
+
+namespace ftl_audio {
+namespace nn {
+
+namespace {
+
+float dotF32(const float* x, const float* w, int depth) {
+    float sum = 0.0f;
+    for (int k = 0; k < depth; ++k) sum += x[k] * w[k];
+    return sum;
+}
+
+int32_t dotI8(const int8_t* x, const int8_t* w, int depth) {
+    int32_t sum = 0;
+    for (int k = 0; k < depth; ++k) sum += static_cast<int32_t>(x[k]) * w[k];
+    return sum;
+}
+
+#if defined(FTL_NN_NEON)
+float horizontalSum(float32x4_t v) {
+    float32x2_t pair = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+}
+
+int32_t horizontalSum(int32x4_t v) {
+    int32x2_t pair = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+    return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+int32x4_t dotAccumulate(int32x4_t acc, int8x16_t x, int8x16_t w) {
+#if defined(__ARM_FEATURE_DOTPROD)
+    return vdotq_s32(acc, x, w);
+#else
+    int16x8_t products = vmull_s8(vget_low_s8(x), vget_low_s8(w));
+    products = vmlal_s8(products, vget_high_s8(x), vget_high_s8(w));
+    return vpadalq_s16(acc, products);
+#endif
+}
+#elif defined(FTL_NN_SSE)
+// Sign-extend the low / high eight bytes to int16
+__m128i widenLow(__m128i v) { return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8); }
+__m128i widenHigh(__m128i v) { return _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8); }
+
+// Four int32 partial sums of 16 products, the input already widened
+__m128i dotWidened(__m128i low, __m128i high, const int8_t* weights) {
+    __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights));
+    return _mm_add_epi32(_mm_madd_epi16(low, widenLow(w)), _mm_madd_epi16(high, widenHigh(w)));
+}
+
+// Eight-wide step for depths that are not a multiple of 16 (Conv1D windows)
+__m128i dotWidened8(__m128i low, const int8_t* weights) {
+    return _mm_madd_epi16(low, widenLow(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights))));
+}
+
+// Lane j of the result is the sum of a_j's lanes
+__m128 horizontalSum4(__m128 a0, __m128 a1, __m128 a2, __m128 a3) {
+    _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+    return _mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3));
+}
+
+__m128i horizontalSum4(__m128i a0, __m128i a1, __m128i a2, __m128i a3) {
+    __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(a0, a1), _mm_unpackhi_epi32(a0, a1));
+    __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(a2, a3), _mm_unpackhi_epi32(a2, a3));
+    return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+}
+#endif
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FLOAT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void dotRowsF32(const float* input, int rows, int inputStride, const float* weights, int depth,
+                int outputs, float* out) {
+    for (int r = 0; r < rows; ++r) {
+        const float* x = input + static_cast<size_t>(r) * inputStride;
+        float* y = out + static_cast<size_t>(r) * outputs;
+        int c = 0;
+#if defined(FTL_NN_NEON) || defined(FTL_NN_SSE)
+        for (; c + 4 <= outputs; c += 4) {
+            const float* w0 = weights + static_cast<size_t>(c) * depth;
+            const float* w1 = w0 + depth;
+            const float* w2 = w1 + depth;
+            const float* w3 = w2 + depth;
+            int k = 0;
+#if defined(FTL_NN_NEON)
+            float32x4_t a0 = vdupq_n_f32(0.0f), a1 = a0, a2 = a0, a3 = a0;
+            for (; k + 4 <= depth; k += 4) {
+                float32x4_t v = vld1q_f32(x + k);
+                a0 = vmlaq_f32(a0, v, vld1q_f32(w0 + k));
+                a1 = vmlaq_f32(a1, v, vld1q_f32(w1 + k));
+                a2 = vmlaq_f32(a2, v, vld1q_f32(w2 + k));
+                a3 = vmlaq_f32(a3, v, vld1q_f32(w3 + k));
+            }
+            float sums[4] = {horizontalSum(a0), horizontalSum(a1), horizontalSum(a2), horizontalSum(a3)};
+#else
+            __m128 a0 = _mm_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+            for (; k + 4 <= depth; k += 4) {
+                __m128 v = _mm_loadu_ps(x + k);
+                a0 = _mm_add_ps(a0, _mm_mul_ps(v, _mm_loadu_ps(w0 + k)));
+                a1 = _mm_add_ps(a1, _mm_mul_ps(v, _mm_loadu_ps(w1 + k)));
+                a2 = _mm_add_ps(a2, _mm_mul_ps(v, _mm_loadu_ps(w2 + k)));
+                a3 = _mm_add_ps(a3, _mm_mul_ps(v, _mm_loadu_ps(w3 + k)));
+            }
+            float sums[4];
+            _mm_storeu_ps(sums, horizontalSum4(a0, a1, a2, a3));
+#endif
+            int tail = depth - k;
+            y[c] = sums[0] + dotF32(x + k, w0 + k, tail);
+            y[c + 1] = sums[1] + dotF32(x + k, w1 + k, tail);
+            y[c + 2] = sums[2] + dotF32(x + k, w2 + k, tail);
+            y[c + 3] = sums[3] + dotF32(x + k, w3 + k, tail);
+        }
+#endif
+        for (; c < outputs; ++c) {
+            y[c] = dotF32(x, weights + static_cast<size_t>(c) * depth, depth);
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// INT8
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void dotRowsI8(const int8_t* input, int rows, int inputStride, const int8_t* weights, int depth,
+               int outputs, int32_t* out) {
+    for (int r = 0; r < rows; ++r) {
+        const int8_t* x = input + static_cast<size_t>(r) * inputStride;
+        int32_t* y = out + static_cast<size_t>(r) * outputs;
+        int c = 0;
+#if defined(FTL_NN_NEON) || defined(FTL_NN_SSE)
+        for (; c + 4 <= outputs; c += 4) {
+            const int8_t* w0 = weights + static_cast<size_t>(c) * depth;
+            const int8_t* w1 = w0 + depth;
+            const int8_t* w2 = w1 + depth;
+            const int8_t* w3 = w2 + depth;
+            int k = 0;
+#if defined(FTL_NN_NEON)
+            int32x4_t a0 = vdupq_n_s32(0), a1 = a0, a2 = a0, a3 = a0;
+            for (; k + 16 <= depth; k += 16) {
+                int8x16_t v = vld1q_s8(x + k);
+                a0 = dotAccumulate(a0, v, vld1q_s8(w0 + k));
+                a1 = dotAccumulate(a1, v, vld1q_s8(w1 + k));
+                a2 = dotAccumulate(a2, v, vld1q_s8(w2 + k));
+                a3 = dotAccumulate(a3, v, vld1q_s8(w3 + k));
+            }
+            if (k + 8 <= depth) {
+                int8x8_t v = vld1_s8(x + k);
+                a0 = vpadalq_s16(a0, vmull_s8(v, vld1_s8(w0 + k)));
+                a1 = vpadalq_s16(a1, vmull_s8(v, vld1_s8(w1 + k)));
+                a2 = vpadalq_s16(a2, vmull_s8(v, vld1_s8(w2 + k)));
+                a3 = vpadalq_s16(a3, vmull_s8(v, vld1_s8(w3 + k)));
+                k += 8;
+            }
+            int32_t sums[4] = {horizontalSum(a0), horizontalSum(a1), horizontalSum(a2), horizontalSum(a3)};
+#else
+            __m128i a0 = _mm_setzero_si128(), a1 = a0, a2 = a0, a3 = a0;
+            for (; k + 16 <= depth; k += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + k));
+                __m128i low = widenLow(v);
+                __m128i high = widenHigh(v);
+                a0 = _mm_add_epi32(a0, dotWidened(low, high, w0 + k));
+                a1 = _mm_add_epi32(a1, dotWidened(low, high, w1 + k));
+                a2 = _mm_add_epi32(a2, dotWidened(low, high, w2 + k));
+                a3 = _mm_add_epi32(a3, dotWidened(low, high, w3 + k));
+            }
+            if (k + 8 <= depth) {
+                __m128i low = widenLow(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + k)));
+                a0 = _mm_add_epi32(a0, dotWidened8(low, w0 + k));
+                a1 = _mm_add_epi32(a1, dotWidened8(low, w1 + k));
+                a2 = _mm_add_epi32(a2, dotWidened8(low, w2 + k));
+                a3 = _mm_add_epi32(a3, dotWidened8(low, w3 + k));
+                k += 8;
+            }
+            int32_t sums[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), horizontalSum4(a0, a1, a2, a3));
+#endif
+            int tail = depth - k;
+            y[c] = sums[0] + dotI8(x + k, w0 + k, tail);
+            y[c + 1] = sums[1] + dotI8(x + k, w1 + k, tail);
+            y[c + 2] = sums[2] + dotI8(x + k, w2 + k, tail);
+            y[c + 3] = sums[3] + dotI8(x + k, w3 + k, tail);
+        }
+#endif
+        for (; c < outputs; ++c) {
+            y[c] = dotI8(x, weights + static_cast<size_t>(c) * depth, depth);
+        }
+    }
+}
+
+float quantizeSymmetric(const float* input, size_t count, int8_t* out) {
+    float largest = 0.0f;
+    for (size_t i = 0; i < count; ++i) largest = std::max(largest, std::fabs(input[i]));
+    if (largest <= 0.0f) {
+        std::fill(out, out + count, static_cast<int8_t>(0));
+        return 0.0f;
+    }
+    const float inverse = 127.0f / largest;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<int8_t>(std::lrintf(input[i] * inverse));
+    }
+    return largest / 127.0f;
+}
+
+} // namespace nn
+} // namespace ftl_audio
@@ -0,0 +1,43 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            INFERENCE KERNELS - SIMD GEMM FLOAT & INT8       ║
+ * ║        Dense and Conv1D Building Blocks for Model Heads     ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Every layer reduces to the same product: each input row dotted with
+ * each weight row. Rows are read at a stride, so a channels-last Conv1D
+ * runs on its input in place (a window of `kernel` frames is one
+ * contiguous row). Four weight rows share each input load. NEON (with
+ * SDOT when available) on ARM, SSE2 on x86, scalar elsewhere; any
+ * depth works, the tail runs scalar.
+ */
+
+#ifndef FTL_ML_INFERENCE_KERNELS_H
+#define FTL_ML_INFERENCE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ftl_audio {
+namespace nn {
+
+/** out[r * outputs + c] = dot(input + r * inputStride, weights + c * depth) */
+void dotRowsF32(const float* input, int rows, int inputStride, const float* weights, int depth,
+                int outputs, float* out);
+
+/** Same product on int8 (values in -127..127), exact int32 accumulation */
+void dotRowsI8(const int8_t* input, int rows, int inputStride, const int8_t* weights, int depth,
+               int outputs, int32_t* out);
+
+/**
+ * Symmetric int8 quantization of `count` values, round to nearest.
+ * @return Scale (value = q * scale); 0 for an all-zero input
+ */
+float quantizeSymmetric(const float* input, size_t count, int8_t* out);
+
+} // namespace nn
+} // namespace ftl_audio
+
+#endif // FTL_ML_INFERENCE_KERNELS_H
@@ -0,0 +1,390 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          INFERENCE MODEL - NATIVE MLP / CNN RUNTIME         ║
+ * ║       float32 or int8 Execution of Small Model Heads        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "InferenceModel.h"
+#include "InferenceKernels.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "FTL_Inference"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+constexpr char MODEL_MAGIC[4] = {'F', 'T', 'L', 'M'};
+
+// Far above any model head we ship; rejects corrupt headers before allocating
+constexpr int64_t MAX_TENSOR_ELEMENTS = 1 << 24;
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool u32(uint32_t& value) { return bytes(&value, sizeof(value)); }
+
+    bool floats(std::vector<float>& values, size_t count) {
+        if (count > (m_size - m_offset) / sizeof(float)) return false;
+        values.resize(count);
+        return bytes(values.data(), count * sizeof(float));
+    }
+
+    bool bytes(void* out, size_t count) {
+        if (count > m_size - m_offset) return false;
+        std::memcpy(out, m_data + m_offset, count);
+        m_offset += count;
+        return true;
+    }
+
+    bool atEnd() const { return m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+void appendFloats(std::vector<uint8_t>& out, const std::vector<float>& values) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+    out.insert(out.end(), bytes, bytes + values.size() * sizeof(float));
+}
+
+bool hasWeights(LayerType type) {
+    return type == LayerType::DENSE || type == LayerType::CONV1D;
+}
+
+void activate(Activation activation, float* values, int positions, int channels) {
+    size_t count = static_cast<size_t>(positions) * channels;
+    switch (activation) {
+        case Activation::NONE:
+            break;
+        case Activation::RELU:
+            for (size_t i = 0; i < count; ++i) values[i] = std::max(values[i], 0.0f);
+            break;
+        case Activation::TANH:
+            for (size_t i = 0; i < count; ++i) values[i] = std::tanh(values[i]);
+            break;
+        case Activation::SIGMOID:
+            for (size_t i = 0; i < count; ++i) values[i] = 1.0f / (1.0f + std::exp(-values[i]));
+            break;
+        case Activation::SOFTMAX:
+            for (int p = 0; p < positions; ++p) {
+                float* row = values + static_cast<size_t>(p) * channels;
+                float largest = *std::max_element(row, row + channels);
+                float sum = 0.0f;
+                for (int c = 0; c < channels; ++c) {
+                    row[c] = std::exp(row[c] - largest);
+                    sum += row[c];
+                }
+                for (int c = 0; c < channels; ++c) row[c] /= sum;
+            }
+            break;
+    }
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MODEL FILE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool decodeModel(const uint8_t* data, size_t size, ModelSpec& spec) {
+    Reader reader(data, size);
+    char magic[4];
+    uint32_t version, inputLength, inputChannels, layerCount;
+    if (!reader.bytes(magic, sizeof(magic)) || std::memcmp(magic, MODEL_MAGIC, sizeof(magic)) != 0 ||
+        !reader.u32(version) || version != MODEL_FILE_VERSION ||
+        !reader.u32(inputLength) || !reader.u32(inputChannels) || !reader.u32(layerCount)) {
+        return false;
+    }
+    if (static_cast<int64_t>(inputLength) * inputChannels > MAX_TENSOR_ELEMENTS || layerCount > 256) {
+        return false;
+    }
+
+    spec = ModelSpec();
+    spec.inputLength = static_cast<int>(inputLength);
+    spec.inputChannels = static_cast<int>(inputChannels);
+    int length = spec.inputLength;
+    int channels = spec.inputChannels;
+    for (uint32_t i = 0; i < layerCount; ++i) {
+        uint32_t type, activation, outputs, kernel, stride;
+        if (!reader.u32(type) || !reader.u32(activation) || !reader.u32(outputs) ||
+            !reader.u32(kernel) || !reader.u32(stride) || activation > static_cast<uint32_t>(Activation::SOFTMAX) ||
+            outputs > MAX_TENSOR_ELEMENTS || kernel == 0 || stride == 0) {
+            return false;
+        }
+        LayerSpec layer;
+        layer.type = static_cast<LayerType>(type);
+        layer.activation = static_cast<Activation>(activation);
+        layer.outputs = static_cast<int>(outputs);
+        layer.kernel = static_cast<int>(kernel);
+        layer.stride = static_cast<int>(stride);
+
+        // Track shapes just far enough to know how many weights follow
+        int64_t depth = 0;
+        switch (layer.type) {
+            case LayerType::DENSE:
+                depth = static_cast<int64_t>(length) * channels;
+                length = 1;
+                channels = layer.outputs;
+                break;
+            case LayerType::CONV1D:
+                if (layer.kernel > length) return false;
+                depth = static_cast<int64_t>(layer.kernel) * channels;
+                length = (length - layer.kernel) / layer.stride + 1;
+                channels = layer.outputs;
+                break;
+            case LayerType::GLOBAL_AVERAGE_POOL:
+                length = 1;
+                break;
+            default:
+                return false;
+        }
+        if (hasWeights(layer.type)) {
+            if (depth * layer.outputs > MAX_TENSOR_ELEMENTS ||
+                !reader.floats(layer.weights, static_cast<size_t>(depth * layer.outputs)) ||
+                !reader.floats(layer.bias, static_cast<size_t>(layer.outputs))) {
+                return false;
+            }
+        }
+        spec.layers.push_back(std::move(layer));
+    }
+    return reader.atEnd();
+}
+
+std::vector<uint8_t> encodeModel(const ModelSpec& spec) {
+    std::vector<uint8_t> out(MODEL_MAGIC, MODEL_MAGIC + sizeof(MODEL_MAGIC));
+    appendU32(out, MODEL_FILE_VERSION);
+    appendU32(out, static_cast<uint32_t>(spec.inputLength));
+    appendU32(out, static_cast<uint32_t>(spec.inputChannels));
+    appendU32(out, static_cast<uint32_t>(spec.layers.size()));
+    for (const LayerSpec& layer : spec.layers) {
+        appendU32(out, static_cast<uint32_t>(layer.type));
+        appendU32(out, static_cast<uint32_t>(layer.activation));
+        appendU32(out, static_cast<uint32_t>(layer.outputs));
+        appendU32(out, static_cast<uint32_t>(layer.kernel));
+        appendU32(out, static_cast<uint32_t>(layer.stride));
+        if (hasWeights(layer.type)) {
+            appendFloats(out, layer.weights);
+            appendFloats(out, layer.bias);
+        }
+    }
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BUILD & LOAD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool InferenceModel::build(const ModelSpec& spec, InferencePrecision precision) {
+    m_layers.clear();
+    m_macs = 0;
+    if (spec.inputLength <= 0 || spec.inputChannels <= 0 || spec.layers.empty()) {
+        LOGE("Model has no input or no layers");
+        return false;
+    }
+
+    std::vector<Layer> layers;
+    int length = spec.inputLength;
+    int channels = spec.inputChannels;
+    int largest = length * channels;
+    int64_t macs = 0;
+    for (const LayerSpec& source : spec.layers) {
+        Layer layer;
+        layer.type = source.type;
+        layer.activation = source.activation;
+        layer.inputLength = length;
+        layer.inputChannels = channels;
+        layer.kernel = source.kernel;
+        layer.stride = source.stride;
+        switch (source.type) {
+            case LayerType::DENSE:
+                layer.depth = length * channels;
+                layer.outputLength = 1;
+                layer.outputChannels = source.outputs;
+                break;
+            case LayerType::CONV1D:
+                if (source.kernel <= 0 || source.stride <= 0 || source.kernel > length) {
+                    LOGE("Conv1D kernel %d / stride %d does not fit length %d", source.kernel, source.stride, length);
+                    return false;
+                }
+                layer.depth = source.kernel * channels;
+                layer.outputLength = (length - source.kernel) / source.stride + 1;
+                layer.outputChannels = source.outputs;
+                break;
+            case LayerType::GLOBAL_AVERAGE_POOL:
+                layer.depth = 0;
+                layer.outputLength = 1;
+                layer.outputChannels = channels;
+                break;
+            default:
+                LOGE("Unknown layer type %u", static_cast<unsigned>(source.type));
+                return false;
+        }
+
+        if (hasWeights(source.type)) {
+            size_t weightCount = static_cast<size_t>(layer.depth) * layer.outputChannels;
+            if (layer.outputChannels <= 0 || source.weights.size() != weightCount ||
+                source.bias.size() != static_cast<size_t>(layer.outputChannels)) {
+                LOGE("Layer weights do not match its shape (%zu weights, depth %d x %d outputs)",
+                     source.weights.size(), layer.depth, layer.outputChannels);
+                return false;
+            }
+            layer.bias = source.bias;
+            if (precision == InferencePrecision::INT8) {
+                layer.quantizedWeights.resize(weightCount);
+                layer.weightScales.resize(layer.outputChannels);
+                for (int c = 0; c < layer.outputChannels; ++c) {
+                    size_t offset = static_cast<size_t>(c) * layer.depth;
+                    layer.weightScales[c] = nn::quantizeSymmetric(source.weights.data() + offset, layer.depth,
+                                                                  layer.quantizedWeights.data() + offset);
+                }
+            } else {
+                layer.weights = source.weights;
+            }
+            macs += static_cast<int64_t>(layer.outputLength) * layer.outputChannels * layer.depth;
+        }
+
+        length = layer.outputLength;
+        channels = layer.outputChannels;
+        largest = std::max(largest, length * channels);
+        layers.push_back(std::move(layer));
+    }
+
+    m_layers = std::move(layers);
+    m_precision = precision;
+    m_inputSize = spec.inputLength * spec.inputChannels;
+    m_outputSize = length * channels;
+    m_largestTensor = largest;
+    m_macs = macs;
+    return true;
+}
+
+bool InferenceModel::loadFromMemory(const uint8_t* data, size_t size, InferencePrecision precision) {
+    ModelSpec spec;
+    if (!decodeModel(data, size, spec)) {
+        LOGE("Not a valid FTLM model image (%zu bytes)", size);
+        m_layers.clear();
+        return false;
+    }
+    return build(spec, precision);
+}
+
+bool InferenceModel::load(const std::string& path, InferencePrecision precision) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOGE("Cannot open model %s", path.c_str());
+        m_layers.clear();
+        return false;
+    }
+    std::vector<uint8_t> image;
+    uint8_t block[16384];
+    size_t count;
+    while ((count = std::fread(block, 1, sizeof(block), file)) > 0) {
+        image.insert(image.end(), block, block + count);
+    }
+    std::fclose(file);
+    return loadFromMemory(image.data(), image.size(), precision);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// EXECUTION
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void InferenceModel::run(const float* input, int batch, float* output) {
+    if (m_layers.empty() || batch <= 0) {
+        return;
+    }
+    FTL_TRACE_SCOPE("inference");
+    size_t tensor = static_cast<size_t>(batch) * m_largestTensor;
+    if (m_ping.size() < tensor) {
+        m_ping.resize(tensor);
+        m_pong.resize(tensor);
+    }
+
+    const float* current = input;
+    for (size_t i = 0; i < m_layers.size(); ++i) {
+        float* next = (i + 1 == m_layers.size()) ? output : (i % 2 == 0 ? m_ping.data() : m_pong.data());
+        runLayer(m_layers[i], current, batch, next);
+        current = next;
+    }
+}
+
+void InferenceModel::runLayer(const Layer& layer, const float* input, int batch, float* output) {
+    const size_t inputItem = static_cast<size_t>(layer.inputLength) * layer.inputChannels;
+    const size_t outputItem = static_cast<size_t>(layer.outputLength) * layer.outputChannels;
+
+    if (layer.type == LayerType::GLOBAL_AVERAGE_POOL) {
+        const float scale = 1.0f / static_cast<float>(layer.inputLength);
+        for (int b = 0; b < batch; ++b) {
+            const float* item = input + b * inputItem;
+            float* out = output + b * outputItem;
+            std::fill(out, out + layer.inputChannels, 0.0f);
+            for (int t = 0; t < layer.inputLength; ++t) {
+                for (int c = 0; c < layer.inputChannels; ++c) out[c] += item[t * layer.inputChannels + c];
+            }
+            for (int c = 0; c < layer.inputChannels; ++c) out[c] *= scale;
+        }
+        activate(layer.activation, output, batch, layer.outputChannels);
+        return;
+    }
+
+    // Dense: one row per item. Conv1D: one row per output position, read in place
+    // from the channels-last input; consecutive windows are `stride` frames apart.
+    const bool dense = layer.type == LayerType::DENSE;
+    const int rows = dense ? batch : layer.outputLength;
+    const int rowStride = dense ? layer.depth : layer.stride * layer.inputChannels;
+    const int passes = dense ? 1 : batch;
+    const int outputs = layer.outputChannels;
+
+    if (m_precision == InferencePrecision::FLOAT32) {
+        for (int pass = 0; pass < passes; ++pass) {
+            nn::dotRowsF32(input + pass * inputItem, rows, rowStride, layer.weights.data(), layer.depth, outputs,
+                           output + pass * outputItem);
+        }
+        for (size_t i = 0; i < static_cast<size_t>(batch) * layer.outputLength; ++i) {
+            float* row = output + i * outputs;
+            for (int c = 0; c < outputs; ++c) row[c] += layer.bias[c];
+        }
+    } else {
+        // Each item gets its own activation scale
+        m_quantized.resize(batch * inputItem);
+        m_rowScales.resize(batch);
+        m_accumulators.resize(batch * outputItem);
+        for (int b = 0; b < batch; ++b) {
+            m_rowScales[b] = nn::quantizeSymmetric(input + b * inputItem, inputItem, m_quantized.data() + b * inputItem);
+        }
+        for (int pass = 0; pass < passes; ++pass) {
+            nn::dotRowsI8(m_quantized.data() + pass * inputItem, rows, rowStride, layer.quantizedWeights.data(),
+                          layer.depth, outputs, m_accumulators.data() + pass * outputItem);
+        }
+        for (int b = 0; b < batch; ++b) {
+            const float rowScale = m_rowScales[b];
+            for (int t = 0; t < layer.outputLength; ++t) {
+                size_t offset = b * outputItem + static_cast<size_t>(t) * outputs;
+                for (int c = 0; c < outputs; ++c) {
+                    output[offset + c] = static_cast<float>(m_accumulators[offset + c]) * rowScale * layer.weightScales[c] +
+                                         layer.bias[c];
+                }
+            }
+        }
+    }
+    activate(layer.activation, output, batch * layer.outputLength, outputs);
+}
+
+} // namespace ftl_audio
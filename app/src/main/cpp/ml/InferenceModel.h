@@ -0,0 +1,125 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          INFERENCE MODEL - NATIVE MLP / CNN RUNTIME         ║
+ * ║       float32 or int8 Execution of Small Model Heads        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * The genre, mood and EQ-suggestion models are a few dense / Conv1D
+ * layers on a feature vector, far too small for a GPU delegate to pay
+ * off. Tensors are (length, channels), channels last; a dense layer
+ * flattens its input. INT8 quantizes weights per output channel and
+ * activations per row on the fly (symmetric, no zero points) and
+ * accumulates in int32; biases and activations stay float.
+ *
+ * Model file (.ftlm, little-endian):
+ *   "FTLM" | u32 version | u32 inputLength | u32 inputChannels | u32 layerCount
+ *   per layer: u32 type | u32 activation | u32 outputs | u32 kernel | u32 stride
+ *              DENSE / CONV1D: f32 weights[outputs][depth] | f32 bias[outputs]
+ * where depth is the flattened input (DENSE) or kernel * inputChannels (CONV1D).
+ */
+
+#ifndef FTL_ML_INFERENCE_MODEL_H
+#define FTL_ML_INFERENCE_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ftl_audio {
+
+enum class LayerType : uint32_t {
+    DENSE = 1,
+    CONV1D = 2,                 // Valid padding
+    GLOBAL_AVERAGE_POOL = 3,    // (length, channels) -> (1, channels)
+};
+
+enum class Activation : uint32_t {
+    NONE = 0,
+    RELU = 1,
+    TANH = 2,
+    SIGMOID = 3,
+    SOFTMAX = 4,                // Across channels, per position
+};
+
+enum class InferencePrecision {
+    FLOAT32,
+    INT8,
+};
+
+struct LayerSpec {
+    LayerType type = LayerType::DENSE;
+    Activation activation = Activation::NONE;
+    int outputs = 0;            // Units / filters; ignored by pooling
+    int kernel = 1;
+    int stride = 1;
+    std::vector<float> weights; // [outputs][depth]
+    std::vector<float> bias;    // [outputs]
+};
+
+struct ModelSpec {
+    int inputLength = 1;
+    int inputChannels = 0;
+    std::vector<LayerSpec> layers;
+};
+
+constexpr uint32_t MODEL_FILE_VERSION = 1;
+
+/** Parse a .ftlm image; false on a bad header, unknown layer or wrong size */
+bool decodeModel(const uint8_t* data, size_t size, ModelSpec& spec);
+std::vector<uint8_t> encodeModel(const ModelSpec& spec);
+
+class InferenceModel {
+public:
+    /** Validate shapes and prepare weights (quantized for INT8) */
+    bool build(const ModelSpec& spec, InferencePrecision precision);
+    bool loadFromMemory(const uint8_t* data, size_t size, InferencePrecision precision);
+    bool load(const std::string& path, InferencePrecision precision);
+
+    bool isLoaded() const { return !m_layers.empty(); }
+    InferencePrecision precision() const { return m_precision; }
+    int inputSize() const { return m_inputSize; }
+    int outputSize() const { return m_outputSize; }
+
+    /** Multiply-accumulates per inference */
+    int64_t macsPerInference() const { return m_macs; }
+
+    /**
+     * Run `batch` inputs of inputSize() floats into batch x outputSize().
+     * Scratch is owned by the model: one thread per model at a time.
+     */
+    void run(const float* input, int batch, float* output);
+
+private:
+    struct Layer {
+        LayerType type;
+        Activation activation;
+        int inputLength, inputChannels;
+        int outputLength, outputChannels;
+        int kernel, stride, depth;
+        std::vector<float> weights;
+        std::vector<int8_t> quantizedWeights;
+        std::vector<float> weightScales;    // Per output channel
+        std::vector<float> bias;
+    };
+
+    void runLayer(const Layer& layer, const float* input, int batch, float* output);
+
+    std::vector<Layer> m_layers;
+    InferencePrecision m_precision = InferencePrecision::FLOAT32;
+    int m_inputSize = 0;
+    int m_outputSize = 0;
+    int m_largestTensor = 0;
+    int64_t m_macs = 0;
+
+    std::vector<float> m_ping, m_pong;
+    std::vector<int8_t> m_quantized;
+    std::vector<float> m_rowScales;
+    std::vector<int32_t> m_accumulators;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_ML_INFERENCE_MODEL_H
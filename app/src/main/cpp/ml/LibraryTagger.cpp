@@ -0,0 +1,239 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           LIBRARY TAGGER - BATCH GENRE / MOOD / EQ          ║
+ * ║     Decode, Featurize and Infer Whole Libraries Natively    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "LibraryTagger.h"
+#include "AudioSource.h"
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define LOG_TAG "FTL_LibraryTagger"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+
+namespace {
+
+// Android's THREAD_PRIORITY_BACKGROUND: the scheduler keeps it off the big cores
+constexpr int BACKGROUND_NICE = 10;
+constexpr int32_t DECODE_CHUNK_FRAMES = 4096;
+
+void argmax(const float* scores, int count, int& index, float& confidence) {
+    const float* best = std::max_element(scores, scores + count);
+    index = static_cast<int>(best - scores);
+    confidence = *best;
+}
+
+} // namespace
+
+LibraryTagger::~LibraryTagger() {
+    cancel();
+    wait();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MODELS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool LibraryTagger::setModel(TagModel which, const ModelSpec& spec, InferencePrecision precision) {
+    InferenceModel model;
+    if (!model.build(spec, precision)) {
+        return false;
+    }
+    if (model.inputSize() != FEATURE_SIZE) {
+        LOGE("Tag model takes %d inputs, features have %d", model.inputSize(), FEATURE_SIZE);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_models.model[static_cast<int>(which)] = std::move(model);
+    return true;
+}
+
+bool LibraryTagger::loadModel(TagModel which, const uint8_t* data, size_t size, InferencePrecision precision) {
+    ModelSpec spec;
+    if (!decodeModel(data, size, spec)) {
+        LOGE("Not a valid FTLM model image (%zu bytes)", size);
+        return false;
+    }
+    return setModel(which, spec, precision);
+}
+
+bool LibraryTagger::hasModel(TagModel which) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_models.model[static_cast<int>(which)].isLoaded();
+}
+
+void LibraryTagger::infer(Models& models, const float* features, int batch, TrackTags* const* tags) {
+    std::vector<float> scores;
+    for (int which = 0; which < TAG_MODEL_COUNT; ++which) {
+        InferenceModel& model = models.model[which];
+        if (!model.isLoaded()) continue;
+        const int outputs = model.outputSize();
+        scores.resize(static_cast<size_t>(batch) * outputs);
+        model.run(features, batch, scores.data());
+        for (int b = 0; b < batch; ++b) {
+            const float* row = scores.data() + static_cast<size_t>(b) * outputs;
+            switch (static_cast<TagModel>(which)) {
+                case TagModel::GENRE:
+                    argmax(row, outputs, tags[b]->genre, tags[b]->genreConfidence);
+                    break;
+                case TagModel::MOOD:
+                    argmax(row, outputs, tags[b]->mood, tags[b]->moodConfidence);
+                    break;
+                case TagModel::EQ:
+                    tags[b]->eq.assign(row, row + outputs);
+                    break;
+            }
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SINGLE CLIP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool LibraryTagger::analyze(const float* input, int64_t frames, int channelCount, int sampleRate,
+                            TrackTags& tags) {
+    if (!input || frames <= 0 || channelCount <= 0 || sampleRate <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    float features[FEATURE_SIZE];
+    m_extractor.extract(input, frames, channelCount, sampleRate, features);
+    TrackTags* target = &tags;
+    infer(m_models, features, 1, &target);
+    tags.analyzed = true;
+    return true;
+}
+
+bool LibraryTagger::extractFileFeatures(const std::string& path, FeatureExtractor& extractor, float* features) {
+    FTL_TRACE_SCOPE("tagger.decodeClip");
+    std::unique_ptr<AudioSource> source = openAudioSource(path);
+    if (!source) {
+        return false;
+    }
+    const AudioSourceInfo& info = source->info();
+    const int64_t clipFrames = static_cast<int64_t>(CLIP_SECONDS * info.sampleRate);
+    int64_t wanted = clipFrames;
+    if (info.totalFrames > clipFrames) {
+        if (!source->seekToFrame((info.totalFrames - clipFrames) / 2)) {
+            return false;
+        }
+    } else if (info.totalFrames >= 0) {
+        wanted = info.totalFrames;
+    }
+
+    std::vector<float> clip(static_cast<size_t>(wanted) * info.channelCount);
+    int64_t frames = 0;
+    while (frames < wanted) {
+        int32_t chunk = static_cast<int32_t>(std::min<int64_t>(DECODE_CHUNK_FRAMES, wanted - frames));
+        int32_t got = source->read(clip.data() + frames * info.channelCount, chunk);
+        if (got < 0) return false;
+        if (got == 0) break;
+        frames += got;
+    }
+    if (frames == 0) {
+        return false;
+    }
+    extractor.extract(clip.data(), frames, info.channelCount, info.sampleRate, features);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BATCH
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool LibraryTagger::start(std::vector<std::string> paths) {
+    if (isRunning()) {
+        return false;
+    }
+    wait();
+
+    Models models;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        bool any = false;
+        for (const InferenceModel& model : m_models.model) any = any || model.isLoaded();
+        if (!any) {
+            LOGE("No tag model loaded");
+            return false;
+        }
+        models = m_models;
+        m_results.clear();
+        m_results.reserve(paths.size());
+    }
+
+    m_cancel.store(false, std::memory_order_release);
+    m_completed.store(0, std::memory_order_release);
+    m_total.store(static_cast<int>(paths.size()), std::memory_order_release);
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread(&LibraryTagger::runBatch, this, std::move(paths), std::move(models));
+    return true;
+}
+
+void LibraryTagger::cancel() {
+    m_cancel.store(true, std::memory_order_release);
+}
+
+void LibraryTagger::wait() {
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+std::vector<TrackTags> LibraryTagger::results() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_results;
+}
+
+void LibraryTagger::runBatch(std::vector<std::string> paths, Models models) {
+    FTL_TRACE_THREAD_NAME("ftl_tagger");
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), BACKGROUND_NICE) != 0) {
+        LOGE("Cannot lower tagger priority, tagging at normal priority");
+    }
+    LOGI("Tagging %zu files", paths.size());
+
+    FeatureExtractor extractor;
+    std::vector<float> features(static_cast<size_t>(TAG_BATCH) * FEATURE_SIZE);
+    std::vector<TrackTags> batch;
+    std::vector<TrackTags*> decoded;
+
+    for (size_t first = 0; first < paths.size() && !m_cancel.load(std::memory_order_acquire); first += TAG_BATCH) {
+        FTL_TRACE_SCOPE("tagger.batch");
+        size_t count = std::min(paths.size() - first, static_cast<size_t>(TAG_BATCH));
+        batch.assign(count, TrackTags());
+        decoded.clear();
+        size_t processed = 0;
+        for (; processed < count && !m_cancel.load(std::memory_order_acquire); ++processed) {
+            TrackTags& tags = batch[processed];
+            tags.path = paths[first + processed];
+            float* slot = features.data() + decoded.size() * FEATURE_SIZE;
+            if (extractFileFeatures(tags.path, extractor, slot)) {
+                tags.analyzed = true;
+                decoded.push_back(&tags);
+            }
+        }
+        if (!decoded.empty()) {
+            infer(models, features.data(), static_cast<int>(decoded.size()), decoded.data());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.insert(m_results.end(), batch.begin(), batch.begin() + processed);
+        m_completed.store(static_cast<int>(m_results.size()), std::memory_order_release);
+    }
+
+    LOGI("Tagged %d of %zu files%s", completed(), paths.size(),
+         m_cancel.load(std::memory_order_acquire) ? " (cancelled)" : "");
+    m_running.store(false, std::memory_order_release);
+}
+
+} // namespace ftl_audio
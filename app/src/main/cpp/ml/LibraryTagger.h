@@ -0,0 +1,107 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           LIBRARY TAGGER - BATCH GENRE / MOOD / EQ          ║
+ * ║     Decode, Featurize and Infer Whole Libraries Natively    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Owns the genre, mood and EQ-suggestion models. analyze() serves one
+ * clip on the caller's thread; start() tags a list of files on a
+ * background-priority worker (nice 10, the Android background class)
+ * with its own copy of the models. Each file contributes a clip of up to
+ * CLIP_SECONDS from its middle; features of TAG_BATCH files go through
+ * each model as one batch. Nothing crosses the JVM until results().
+ */
+
+#ifndef FTL_ML_LIBRARY_TAGGER_H
+#define FTL_ML_LIBRARY_TAGGER_H
+
+#include "AudioFeatures.h"
+#include "InferenceModel.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ftl_audio {
+
+enum class TagModel {
+    GENRE = 0,
+    MOOD = 1,
+    EQ = 2,
+};
+
+constexpr int TAG_MODEL_COUNT = 3;
+constexpr double CLIP_SECONDS = 30.0;
+constexpr int TAG_BATCH = 16;
+
+struct TrackTags {
+    std::string path;
+    bool analyzed = false;          // False if the file could not be decoded
+    int genre = -1;                 // Argmax class, -1 without a genre model
+    float genreConfidence = 0.0f;
+    int mood = -1;
+    float moodConfidence = 0.0f;
+    std::vector<float> eq;          // EQ model outputs (dB per band), empty without one
+};
+
+class LibraryTagger {
+public:
+    LibraryTagger() = default;
+    ~LibraryTagger();
+
+    LibraryTagger(const LibraryTagger&) = delete;
+    LibraryTagger& operator=(const LibraryTagger&) = delete;
+
+    /** Models take FEATURE_SIZE inputs; a later batch run picks up changes */
+    bool setModel(TagModel which, const ModelSpec& spec, InferencePrecision precision);
+    bool loadModel(TagModel which, const uint8_t* data, size_t size, InferencePrecision precision);
+    bool hasModel(TagModel which) const;
+
+    /** Tag one interleaved clip on the calling thread */
+    bool analyze(const float* input, int64_t frames, int channelCount, int sampleRate, TrackTags& tags);
+
+    /** Decode a file's analysis clip and extract its features */
+    static bool extractFileFeatures(const std::string& path, FeatureExtractor& extractor, float* features);
+
+    /**
+     * Tag `paths` in the background.
+     * @return False if a run is in progress or no model is loaded
+     */
+    bool start(std::vector<std::string> paths);
+    void cancel();
+    void wait();
+
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    int completed() const { return m_completed.load(std::memory_order_acquire); }
+    int total() const { return m_total.load(std::memory_order_acquire); }
+
+    /** Tags finished so far, in input order */
+    std::vector<TrackTags> results() const;
+
+private:
+    struct Models {
+        InferenceModel model[TAG_MODEL_COUNT];
+    };
+
+    static void infer(Models& models, const float* features, int batch, TrackTags* const* tags);
+    void runBatch(std::vector<std::string> paths, Models models);
+
+    mutable std::mutex m_mutex;         // m_models, m_results
+    Models m_models;
+    FeatureExtractor m_extractor;       // analyze() only, under m_mutex
+    std::vector<TrackTags> m_results;
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_cancel{false};
+    std::atomic<int> m_completed{0};
+    std::atomic<int> m_total{0};
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_ML_LIBRARY_TAGGER_H
@@ -0,0 +1,190 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL BENCH - RESULT FILE FORMAT (HOST)            ║
+ * ║      Shared by ftl_audio_bench and ftl_bench_compare        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * One JSON document per run: a header describing the machine and build,
+ * then one object per benchmark. Times are per item (frame or sample,
+ * see `unit`) so runs with different repetition counts compare directly.
+ * Schema 2 adds a `quality` list: audio measurements of the same build
+ * (THD+N, SNR, IMD, response) with the spec limit each must meet.
+ */
+
+#ifndef FTL_BENCH_FORMAT_H
+#define FTL_BENCH_FORMAT_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace ftl_bench {
+
+constexpr int SCHEMA_VERSION = 2;
+constexpr int OLDEST_SCHEMA_VERSION = 1;       // No quality list
+
+struct BenchResult {
+    std::string name;
+    std::string unit;               // "ns/frame" or "ns/sample"
+    double median = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double spread = 0.0;            // Median absolute deviation / median
+    long long items = 0;            // Items per timed operation
+};
+
+struct QualityResult {
+    std::string name;
+    std::string unit;               // "dB"
+    double value = 0.0;
+    bool higherIsBetter = false;
+    bool hasLimit = false;
+    double limit = 0.0;             // Spec bound on `value`
+
+    bool meetsLimit() const {
+        return !hasLimit || (higherIsBetter ? value >= limit : value <= limit);
+    }
+};
+
+struct BenchRun {
+    int schema = SCHEMA_VERSION;
+    std::string arch;
+    std::string simd;
+    std::string buildType;
+    std::string compiler;
+    int cpu = -1;                   // Pinned CPU, -1 when unpinned
+    int repetitions = 0;
+    std::vector<BenchResult> benchmarks;
+    std::vector<QualityResult> quality;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WRITE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+inline void writeBenchRun(FILE* out, const BenchRun& run) {
+    std::fprintf(out, "{\n  \"schema\": %d,\n  \"tool\": \"ftl_audio_bench\",\n", run.schema);
+    std::fprintf(out, "  \"arch\": \"%s\",\n  \"simd\": \"%s\",\n  \"buildType\": \"%s\",\n",
+                 run.arch.c_str(), run.simd.c_str(), run.buildType.c_str());
+    std::fprintf(out, "  \"compiler\": \"%s\",\n  \"cpu\": %d,\n  \"repetitions\": %d,\n",
+                 run.compiler.c_str(), run.cpu, run.repetitions);
+    std::fprintf(out, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < run.benchmarks.size(); ++i) {
+        const BenchResult& b = run.benchmarks[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"unit\": \"%s\", \"median\": %.6g, \"min\": %.6g, "
+                          "\"max\": %.6g, \"spread\": %.4f, \"items\": %lld}%s\n",
+                     b.name.c_str(), b.unit.c_str(), b.median, b.min, b.max, b.spread, b.items,
+                     i + 1 < run.benchmarks.size() ? "," : "");
+    }
+    std::fprintf(out, "  ],\n  \"quality\": [\n");
+    for (size_t i = 0; i < run.quality.size(); ++i) {
+        const QualityResult& q = run.quality[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": %.3f, \"better\": \"%s\"",
+                     q.name.c_str(), q.unit.c_str(), q.value, q.higherIsBetter ? "higher" : "lower");
+        if (q.hasLimit) std::fprintf(out, ", \"limit\": %.3f", q.limit);
+        std::fprintf(out, "}%s\n", i + 1 < run.quality.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// READ
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+namespace detail {
+
+/** Value of `"key": "..."` or `"key": number` inside `text`, empty if absent */
+inline std::string field(const std::string& text, const char* key) {
+    std::string quoted = std::string("\"") + key + "\"";
+    size_t at = text.find(quoted);
+    if (at == std::string::npos) return std::string();
+    at = text.find(':', at + quoted.size());
+    if (at == std::string::npos) return std::string();
+    at = text.find_first_not_of(" \t\n", at + 1);
+    if (at == std::string::npos) return std::string();
+    if (text[at] == '"') {
+        size_t end = text.find('"', at + 1);
+        return end == std::string::npos ? std::string() : text.substr(at + 1, end - at - 1);
+    }
+    size_t end = text.find_first_of(",}\n", at);
+    return text.substr(at, end == std::string::npos ? std::string::npos : end - at);
+}
+
+inline double number(const std::string& text, const char* key) {
+    std::string value = field(text, key);
+    return value.empty() ? 0.0 : std::strtod(value.c_str(), nullptr);
+}
+
+} // namespace detail
+
+/** Parse a file written by writeBenchRun; false if it is not one */
+inline bool readBenchRun(const std::string& path, BenchRun& run) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    std::string text;
+    char buffer[4096];
+    size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, got);
+    }
+    std::fclose(file);
+
+    size_t list = text.find("\"benchmarks\"");
+    if (list == std::string::npos) return false;
+    std::string header = text.substr(0, list);
+    run.schema = static_cast<int>(detail::number(header, "schema"));
+    run.arch = detail::field(header, "arch");
+    run.simd = detail::field(header, "simd");
+    run.buildType = detail::field(header, "buildType");
+    run.compiler = detail::field(header, "compiler");
+    run.cpu = static_cast<int>(detail::number(header, "cpu"));
+    run.repetitions = static_cast<int>(detail::number(header, "repetitions"));
+
+    size_t qualityList = text.find("\"quality\"", list);
+    std::string benchmarks = text.substr(0, qualityList);
+
+    run.benchmarks.clear();
+    for (size_t open = benchmarks.find('{', list); open != std::string::npos; open = benchmarks.find('{', open + 1)) {
+        size_t close = benchmarks.find('}', open);
+        if (close == std::string::npos) return false;
+        std::string object = benchmarks.substr(open, close - open + 1);
+        BenchResult result;
+        result.name = detail::field(object, "name");
+        result.unit = detail::field(object, "unit");
+        result.median = detail::number(object, "median");
+        result.min = detail::number(object, "min");
+        result.max = detail::number(object, "max");
+        result.spread = detail::number(object, "spread");
+        result.items = static_cast<long long>(detail::number(object, "items"));
+        if (result.name.empty() || result.median <= 0.0) return false;
+        run.benchmarks.push_back(result);
+        open = close;
+    }
+
+    run.quality.clear();
+    if (qualityList != std::string::npos) {
+        for (size_t open = text.find('{', qualityList); open != std::string::npos; open = text.find('{', open + 1)) {
+            size_t close = text.find('}', open);
+            if (close == std::string::npos) return false;
+            std::string object = text.substr(open, close - open + 1);
+            QualityResult result;
+            result.name = detail::field(object, "name");
+            result.unit = detail::field(object, "unit");
+            result.value = detail::number(object, "value");
+            result.higherIsBetter = detail::field(object, "better") == "higher";
+            result.hasLimit = !detail::field(object, "limit").empty();
+            result.limit = detail::number(object, "limit");
+            if (result.name.empty()) return false;
+            run.quality.push_back(result);
+            open = close;
+        }
+    }
+    return run.schema >= OLDEST_SCHEMA_VERSION && run.schema <= SCHEMA_VERSION;
+}
+
+} // namespace ftl_bench
+
+#endif // FTL_BENCH_FORMAT_H
@@ -0,0 +1,1425 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          FTL AUDIO BENCH - DSP KERNEL SUITE (HOST CLI)      ║
+ * ║     Per-Kernel Cost with Warmup, Pinning and Repetitions    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ *   ftl_audio_bench [options]
+ *     -o <path>            Write JSON here (default stdout)
+ *     -r <n>               Timed repetitions per benchmark (default 15)
+ *     --filter <text>      Only benchmarks whose name contains text
+ *     --cpu <n>            Pin to this CPU (default: the one we start on)
+ *     --no-pin             Leave scheduling to the OS
+ *     --quick              Short warmup and repetitions (smoke runs)
+ *     --list               Print benchmark names and exit
+ *
+ * Every kernel runs at its production block size (one 256-frame burst,
+ * one 1024-frame decode chunk) on noise, so branches and denormals match
+ * real playback. Results are nanoseconds per frame (per sample for the
+ * format conversions); compare runs with ftl_bench_compare.
+ *
+ * Inference cases time the tag model shapes (a 128-256-128-10 MLP and a
+ * strided Conv1D head) per inference, alone and in a TAG_BATCH batch;
+ * the stderr line also gives inferences per second.
+ *
+ * The EQ cases time the ten-band cascade per frame and one adaptive
+ * analysis step (UPDATE_INTERVAL_MS of program per update); the stderr
+ * line gives the worker's share of a core at that update rate.
+ *
+ * The stretch cases time the time-stretcher per output frame at tempo
+ * 1.2 and +2 semitones, stereo, in both modes at 48 and 96 kHz, next to
+ * one real FFT round trip at the vocoder's frame size; the stderr line
+ * gives the share of a core one stereo stream takes at its rate.
+ *
+ * The waveform cases time the peak reduction per decoded chunk and a
+ * whole pyramid sidecar build of the 10 s source; the stderr line gives
+ * the build's speed as a multiple of realtime.
+ *
+ * The metadata cases scan a synthetic 50k-track library (sparse FLAC,
+ * MP3 and WAV files with realistic tags and sizes) per file: the batch
+ * parser on its workers and on one thread, against opening each file
+ * with the decoders as playback does. Pinned runs keep the workers on
+ * one core; --no-pin shows their scaling. The stderr line gives files/s.
+ *
+ * The search cases build the trigram index over a synthetic 100k-track
+ * library and replay 1000 typed queries (growing prefixes, two-word and
+ * misspelled queries) against it, next to a LIKE-style substring scan of
+ * the same rows; the stderr lines give the index size per 10k tracks and
+ * the p50 / p99 query latency of the last repetition.
+ *
+ * The snapshot cases write the columnar library snapshot of the same
+ * 100k tracks, then time a cold start both ways: mapping it and reading
+ * the first screen of title-ordered rows, against materializing every
+ * row and sorting by title first (what loading the whole table costs).
+ * The stderr line gives the heap each way; the page cache is warm, so
+ * the first-rows time is the floor, not the cold-flash time.
+ *
+ * The log cases time one engine-style log line through the synchronous
+ * __android_log_print macros, against the deferred FTL_LOG* path and its
+ * real-time variant (bursts of LOG_BURST, then a flush, so the median is
+ * the end-to-end cost including the log thread's formatting). The
+ * stderr line gives what the calling thread alone paid. Output goes to
+ * /dev/null while they run.
+ *
+ * The trace cases time one FTL_TRACE_SCOPE event with no capture running
+ * (the probe left in release code) and while recording; the stderr line
+ * checks each against its budget (5 ns idle, 50 ns recorded).
+ *
+ * The math cases time each fastmath kernel per sample on a burst of
+ * inputs in its working range, right after the libm loop it replaces;
+ * the stderr line gives the speedup over that loop.
+ *
+ * The quality section renders test signals through the same build and
+ * records THD+N, SNR, IMD and response against the spec, so a faster
+ * kernel that costs audio quality fails the comparison too.
+ */
+
+#include "BenchFormat.h"
+
+#include "AudioFeatures.h"
+#include "AdaptiveEq.h"
+#include "AudioSource.h"
+#include "AudioFormat.h"
+#include "BinauralRenderer.h"
+#include "BufferManager.h"
+#include "Downmix.h"
+#include "Equalizer.h"
+#include "FTLAudioEngine.h"
+#include "InferenceModel.h"
+#include "LibrarySnapshot.h"
+#include "LibraryTagger.h"
+#include "LogUtils.h"
+#include "LoudnessMeter.h"
+#include "MathUtils.h"
+#include "MixKernels.h"
+#include "QualityMeasurement.h"
+#include "RealFft.h"
+#include "Resampler.h"
+#include "SearchIndex.h"
+#include "TimeStretch.h"
+#include "TraceRecorder.h"
+#include "TrackMetadata.h"
+#include "TruePeakLimiter.h"
+#include "WavWriter.h"
+#include "WaveformPyramid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef FTL_BENCH_BUILD_TYPE
+#define FTL_BENCH_BUILD_TYPE ""
+#endif
+
+using namespace ftl_audio;
+using ftl_bench::BenchResult;
+using ftl_bench::BenchRun;
+using ftl_bench::QualityResult;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int RATE = 48000;
+constexpr int32_t BURST = 256;
+constexpr int32_t CHUNK = 1024;
+constexpr int CALLBACK_SOURCE_SECONDS = 10;
+
+struct Options {
+    std::string output;
+    int repetitions = 15;
+    std::string filter;
+    int cpu = -1;
+    bool pin = true;
+    bool quick = false;
+    bool list = false;
+};
+
+struct Benchmark {
+    std::string name;
+    const char* unit;
+    long long items;                   // Frames (samples, inferences) per op
+    std::function<void()> op;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// INPUTS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+/** Deterministic full-scale noise, the same every run */
+std::vector<float> noise(size_t samples, float amplitude, uint32_t seed = 0x2545F491u) {
+    std::vector<float> out(samples);
+    for (float& sample : out) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        sample = amplitude * (static_cast<float>(seed) * (2.0f / 4294967296.0f) - 1.0f);
+    }
+    return out;
+}
+
+std::vector<uint8_t> noiseBytes(size_t bytes) {
+    std::vector<uint8_t> out(bytes);
+    uint32_t seed = 0x9E3779B9u;
+    for (uint8_t& byte : out) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+/** Float WAV of noise in a scratch directory, for the callback benchmarks */
+std::string writeSource(const std::string& directory, int channels) {
+    std::string path = directory + "/bench_" + std::to_string(channels) + "ch.wav";
+    WavWriter writer;
+    if (!writer.open(path, RATE, channels, WavSampleFormat::FLOAT_32)) {
+        return std::string();
+    }
+    std::vector<float> block = noise(static_cast<size_t>(RATE) * channels, 0.3f, 0x1234567u + channels);
+    for (int second = 0; second < CALLBACK_SOURCE_SECONDS; ++second) {
+        writer.write(block.data(), RATE);
+    }
+    return writer.close() ? path : std::string();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SUITE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void addFormatBenchmarks(std::vector<Benchmark>& suite) {
+    constexpr size_t SAMPLES = CHUNK * 2;
+    auto bytes = std::make_shared<std::vector<uint8_t>>(noiseBytes(SAMPLES * 8));
+    auto out = std::make_shared<std::vector<float>>(SAMPLES);
+    // Float sources must hold finite values
+    auto floats = std::make_shared<std::vector<float>>(noise(SAMPLES, 0.5f));
+    auto doubles = std::make_shared<std::vector<double>>(floats->begin(), floats->end());
+
+    using Convert = void (*)(const uint8_t*, float*, size_t);
+    struct Entry { const char* name; Convert convert; const uint8_t* source; };
+    const Entry entries[] = {
+        {"format.u8ToFloat", pcm::u8ToFloat, bytes->data()},
+        {"format.s16ToFloat", pcm::s16ToFloat, bytes->data()},
+        {"format.s24ToFloat", pcm::s24ToFloat, bytes->data()},
+        {"format.s32ToFloat", pcm::s32ToFloat, bytes->data()},
+        {"format.f32ToFloat", pcm::f32ToFloat, reinterpret_cast<const uint8_t*>(floats->data())},
+        {"format.f64ToFloat", pcm::f64ToFloat, reinterpret_cast<const uint8_t*>(doubles->data())},
+    };
+    for (const Entry& entry : entries) {
+        Convert convert = entry.convert;
+        const uint8_t* source = entry.source;
+        suite.push_back({entry.name, "ns/sample", static_cast<long long>(SAMPLES),
+                         [convert, source, out, bytes, floats, doubles] { convert(source, out->data(), SAMPLES); }});
+    }
+
+    auto ints = std::make_shared<std::vector<int32_t>>(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i) (*ints)[i] = static_cast<int32_t>((*floats)[i] * 32767.0f);
+    suite.push_back({"format.int32ToFloat16", "ns/sample", static_cast<long long>(SAMPLES),
+                     [=] { pcm::int32ToFloat(ints->data(), out->data(), SAMPLES, 16); }});
+}
+
+void addMixBenchmarks(std::vector<Benchmark>& suite) {
+    auto src = std::make_shared<std::vector<float>>(noise(BURST * 2, 0.5f));
+    auto dst = std::make_shared<std::vector<float>>(noise(BURST * 2, 0.5f, 77));
+
+    // Each op runs the kernel twice with opposite gains so the buffer stays bounded
+    suite.push_back({"mix.addScaled", "ns/frame", BURST * 2, [=] {
+        mix::addScaled(dst->data(), src->data(), BURST * 2, 0.5f);
+        mix::addScaled(dst->data(), src->data(), BURST * 2, -0.5f);
+    }});
+    suite.push_back({"mix.addRamped", "ns/frame", BURST * 2, [=] {
+        mix::addRamped(dst->data(), src->data(), BURST, 2, 0.25f, 1e-4f);
+        mix::addRamped(dst->data(), src->data(), BURST, 2, -0.25f, -1e-4f);
+    }});
+    suite.push_back({"mix.scaleRamped", "ns/frame", BURST * 2, [=] {
+        mix::scaleRamped(dst->data(), BURST, 2, 1.25f, 0.0f);
+        mix::scaleRamped(dst->data(), BURST, 2, 0.8f, 0.0f);
+    }});
+}
+
+/** libm median per fastmath case, for the stderr comparison */
+std::map<std::string, double>& libmMedians() {
+    static std::map<std::string, double> medians;
+    return medians;
+}
+
+/**
+ * One libm call per sample, as bionic runs it. Kept from the vectorizer,
+ * which under -ffast-math would call glibc's libmvec here and time a
+ * vector library Android does not have.
+ */
+template <typename Function>
+#if !defined(__clang__)
+__attribute__((noinline, optimize("no-tree-vectorize")))
+#else
+__attribute__((noinline))
+#endif
+void libmLoop(const float* in, float* out, int count, Function function) {
+#if defined(__clang__)
+#pragma clang loop vectorize(disable)
+#endif
+    for (int i = 0; i < count; ++i) out[i] = function(in[i]);
+}
+
+void addMathBenchmarks(std::vector<Benchmark>& suite) {
+    constexpr int SAMPLES = BURST * 2;
+    auto in = std::make_shared<std::vector<float>>(noise(SAMPLES, 1.0f));
+    auto out = std::make_shared<std::vector<float>>(SAMPLES);
+    auto exponents = std::make_shared<std::vector<float>>(SAMPLES);
+    auto positive = std::make_shared<std::vector<float>>(SAMPLES);
+    auto angles = std::make_shared<std::vector<float>>(SAMPLES);
+    auto db = std::make_shared<std::vector<float>>(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i) {
+        (*exponents)[i] = 8.0f * (*in)[i];
+        (*positive)[i] = std::fabs((*in)[i]) + 1e-3f;
+        (*angles)[i] = 12.0f * (*in)[i];
+        (*db)[i] = 60.0f * (*in)[i] - 30.0f;
+    }
+
+    // Each kernel next to the libm loop it replaces (".libm" first, so the stderr line can compare)
+    suite.push_back({"math.exp.libm", "ns/sample", SAMPLES, [=] {
+        libmLoop(exponents->data(), out->data(), SAMPLES, [](float x) { return std::exp(x); });
+    }});
+    suite.push_back({"math.exp", "ns/sample", SAMPLES, [=] {
+        fastmath::exp(exponents->data(), out->data(), SAMPLES);
+    }});
+    suite.push_back({"math.log.libm", "ns/sample", SAMPLES, [=] {
+        libmLoop(positive->data(), out->data(), SAMPLES, [](float x) { return std::log(x); });
+    }});
+    suite.push_back({"math.log", "ns/sample", SAMPLES, [=] {
+        fastmath::log(positive->data(), out->data(), SAMPLES);
+    }});
+    suite.push_back({"math.pow.libm", "ns/sample", SAMPLES, [=] {
+        libmLoop(positive->data(), out->data(), SAMPLES, [](float x) { return std::pow(x, 1.0f / 2.4f); });
+    }});
+    suite.push_back({"math.pow", "ns/sample", SAMPLES, [=] {
+        fastmath::pow(positive->data(), 1.0f / 2.4f, out->data(), SAMPLES);
+    }});
+    suite.push_back({"math.sin.libm", "ns/sample", SAMPLES, [=] {
+        libmLoop(angles->data(), out->data(), SAMPLES, [](float x) { return std::sin(x); });
+    }});
+    suite.push_back({"math.sin", "ns/sample", SAMPLES, [=] {
+        fastmath::sin(angles->data(), out->data(), SAMPLES);
+    }});
+    suite.push_back({"math.dbToGain.libm", "ns/sample", SAMPLES, [=] {
+        libmLoop(db->data(), out->data(), SAMPLES, [](float x) { return std::pow(10.0f, x / 20.0f); });
+    }});
+    suite.push_back({"math.dbToGain", "ns/sample", SAMPLES, [=] {
+        fastmath::dbToGain(db->data(), out->data(), SAMPLES);
+    }});
+
+    // The engine's test tone: phase accumulator and sin() per sample, against the wavetable
+    auto phase = std::make_shared<double>(0.0);
+    suite.push_back({"math.oscillator.libm", "ns/sample", SAMPLES, [=] {
+        double increment = 2.0 * M_PI * 440.0 / RATE;
+        for (int i = 0; i < SAMPLES; ++i) {
+            (*out)[i] = 0.1f * static_cast<float>(std::sin(*phase));
+            *phase += increment;
+            if (*phase > 2.0 * M_PI) *phase -= 2.0 * M_PI;
+        }
+    }});
+    auto oscillator = std::make_shared<fastmath::WavetableOscillator>();
+    oscillator->setFrequency(440.0, RATE);
+    suite.push_back({"math.oscillator", "ns/sample", SAMPLES, [=] {
+        oscillator->render(out->data(), SAMPLES, 0.1f);
+    }});
+}
+
+void addResamplerBenchmarks(std::vector<Benchmark>& suite) {
+    const int rates[][2] = {{44100, 48000}, {48000, 44100}, {96000, 48000}};
+    for (const auto& rate : rates) {
+        auto resampler = std::make_shared<StreamResampler>();
+        resampler->configure(rate[0], rate[1], 2, CHUNK);
+        auto input = std::make_shared<std::vector<float>>(noise(CHUNK * 2, 0.5f));
+        auto output = std::make_shared<std::vector<float>>(static_cast<size_t>(resampler->maxOutputFrames(CHUNK)) * 2);
+        std::string name = "resampler." + std::to_string(rate[0]) + "to" + std::to_string(rate[1]);
+        suite.push_back({name, "ns/frame", CHUNK,
+                         [=] { resampler->process(input->data(), CHUNK, output->data()); }});
+    }
+}
+
+void addChannelBenchmarks(std::vector<Benchmark>& suite) {
+    for (int channels : {6, 8}) {
+        auto downmixer = std::make_shared<Downmixer>();
+        downmixer->configure(DownmixMatrix::standard(channels, 2));
+        auto input = std::make_shared<std::vector<float>>(noise(static_cast<size_t>(CHUNK) * channels, 0.3f));
+        auto output = std::make_shared<std::vector<float>>(CHUNK * 2);
+        suite.push_back({"downmix." + std::to_string(channels) + "to2", "ns/frame", CHUNK,
+                         [=] { downmixer->process(input->data(), output->data(), CHUNK); }});
+
+        auto binaural = std::make_shared<BinauralRenderer>();
+        binaural->configure(RATE, channels);
+        suite.push_back({"binaural." + std::to_string(channels) + "to2", "ns/frame", CHUNK,
+                         [=] { binaural->process(input->data(), output->data(), CHUNK); }});
+    }
+    auto binaural = std::make_shared<BinauralRenderer>();
+    binaural->configure(RATE, 2);
+    auto input = std::make_shared<std::vector<float>>(noise(CHUNK * 2, 0.3f));
+    auto output = std::make_shared<std::vector<float>>(CHUNK * 2);
+    suite.push_back({"binaural.crossfeed2", "ns/frame", CHUNK,
+                     [=] { binaural->process(input->data(), output->data(), CHUNK); }});
+}
+
+void addDynamicsBenchmarks(std::vector<Benchmark>& suite) {
+    // Hot input so the limiter actually works; refilled each op because it limits in place
+    auto input = std::make_shared<std::vector<float>>(noise(BURST * 2, 1.4f));
+    auto buffer = std::make_shared<std::vector<float>>(BURST * 2);
+    auto limiter = std::make_shared<TruePeakLimiter>();
+    limiter->configure(RATE, 2);
+    suite.push_back({"limiter.truePeak", "ns/frame", BURST, [=] {
+        std::memcpy(buffer->data(), input->data(), BURST * 2 * sizeof(float));
+        limiter->process(buffer->data(), BURST);
+    }});
+
+    auto detector = std::make_shared<TruePeakDetector>();
+    detector->configure(2);
+    auto peak = std::make_shared<float>(0.0f);
+    suite.push_back({"analyzer.truePeak", "ns/frame", BURST, [=] {
+        float largest = 0.0f;
+        for (int32_t i = 0; i < BURST; ++i) largest = std::max(largest, detector->push(input->data() + i * 2));
+        *peak = largest;
+    }});
+
+    auto meter = std::make_shared<LoudnessMeter>();
+    meter->configure(RATE, 2);
+    suite.push_back({"analyzer.loudness", "ns/frame", BURST, [=] { meter->process(input->data(), BURST); }});
+
+    auto meter6 = std::make_shared<LoudnessMeter>();
+    meter6->configure(RATE, 6);
+    auto input6 = std::make_shared<std::vector<float>>(noise(BURST * 6, 0.3f));
+    suite.push_back({"analyzer.loudness6", "ns/frame", BURST, [=] { meter6->process(input6->data(), BURST); }});
+}
+
+void addEqBenchmarks(std::vector<Benchmark>& suite) {
+    // Every band active; refilled each op so the boosts do not compound
+    const float gains[Equalizer::BANDS] = {3.0f, -2.0f, 1.5f, -1.0f, 2.0f, -3.0f, 1.0f, -1.5f, 2.5f, -2.0f};
+    auto input = std::make_shared<std::vector<float>>(noise(BURST * 2, 0.3f));
+    auto buffer = std::make_shared<std::vector<float>>(BURST * 2);
+    auto eq = std::make_shared<Equalizer>();
+    eq->configure(2);
+    eq->post(Equalizer::design(RATE, gains));
+    suite.push_back({"eq.process", "ns/frame", BURST, [=] {
+        std::memcpy(buffer->data(), input->data(), BURST * 2 * sizeof(float));
+        eq->process(buffer->data(), BURST);
+    }});
+
+    // One worker step: drain an update interval of program, analyze, maybe post
+    constexpr int32_t UPDATE_FRAMES = RATE / 1000 * AdaptiveEq::UPDATE_INTERVAL_MS;
+    auto program = std::make_shared<std::vector<float>>(noise(static_cast<size_t>(UPDATE_FRAMES) * 2, 0.3f));
+    auto adaptiveTarget = std::make_shared<Equalizer>();
+    adaptiveTarget->configure(2);
+    auto adaptive = std::make_shared<AdaptiveEq>();
+    adaptive->configure(adaptiveTarget.get(), RATE, 2, BURST);
+    adaptive->setAdaptive(true, 1.0f);
+    suite.push_back({"eq.adaptiveUpdate", "ns/update", 1, [=] {
+        (void)adaptiveTarget;                           // Kept alive for the posts
+        for (int32_t done = 0; done < UPDATE_FRAMES; done += BURST) {
+            adaptive->tap(program->data() + static_cast<size_t>(done) * 2, std::min(BURST, UPDATE_FRAMES - done));
+        }
+        adaptive->update();
+    }});
+}
+
+void addRingBenchmarks(std::vector<Benchmark>& suite) {
+    auto ring = std::make_shared<AudioRingBuffer>();
+    ring->allocate(RATE / 4, 2);
+    auto input = std::make_shared<std::vector<float>>(noise(BURST * 2, 0.5f));
+    auto output = std::make_shared<std::vector<float>>(BURST * 2);
+    suite.push_back({"ring.writeRead", "ns/frame", BURST, [=] {
+        ring->write(input->data(), BURST);
+        ring->read(output->data(), BURST);
+    }});
+}
+
+/** Random weights in the shape of the shipped tag models; timing does not depend on values */
+/** Endless input for the stretcher: one second of noise, looped */
+struct LoopedInput {
+    std::vector<float> samples;
+    int64_t position = 0;
+
+    static int32_t pull(float* frames, int32_t count, void* userData) {
+        auto* self = static_cast<LoopedInput*>(userData);
+        const int64_t length = static_cast<int64_t>(self->samples.size()) / 2;
+        for (int32_t i = 0; i < count; ++i) {
+            const float* frame = self->samples.data() + (self->position++ % length) * 2;
+            frames[i * 2] = frame[0];
+            frames[i * 2 + 1] = frame[1];
+        }
+        return count;
+    }
+};
+
+void addStretchBenchmarks(std::vector<Benchmark>& suite) {
+    auto fft = std::make_shared<RealFft>(2048);
+    auto frame = std::make_shared<std::vector<float>>(noise(2048, 0.5f));
+    auto re = std::make_shared<std::vector<float>>(fft->bins());
+    auto im = std::make_shared<std::vector<float>>(fft->bins());
+    suite.push_back({"fft.real2048", "ns/frame", 2048, [=] {
+        fft->forward(frame->data(), re->data(), im->data());
+        fft->inverse(re->data(), im->data(), frame->data());
+    }});
+
+    // A DJ-style setting: faster and pitched up, so both the stretch and the read-back work
+    const struct {
+        const char* name;
+        StretchMode mode;
+        int rate;
+    } variants[] = {
+        {"stretch.music48k", StretchMode::MUSIC, 48000},
+        {"stretch.music96k", StretchMode::MUSIC, 96000},
+        {"stretch.speech48k", StretchMode::SPEECH, 48000},
+        {"stretch.speech96k", StretchMode::SPEECH, 96000},
+    };
+    for (const auto& variant : variants) {
+        auto stretcher = std::make_shared<TimeStretcher>();
+        stretcher->configure(variant.rate, 2);
+        stretcher->setMode(variant.mode);
+        stretcher->setTempo(1.2);
+        stretcher->setPitchSemitones(2.0);
+        stretcher->reset();
+        auto input = std::make_shared<LoopedInput>();
+        input->samples = noise(static_cast<size_t>(variant.rate) * 2, 0.3f, 0x5EEDu + variant.rate);
+        auto output = std::make_shared<std::vector<float>>(BURST * 2);
+        suite.push_back({variant.name, "ns/frame", BURST, [=] {
+            stretcher->process(output->data(), BURST, &LoopedInput::pull, input.get());
+        }});
+    }
+}
+
+LayerSpec benchLayer(LayerType type, int depth, int outputs, Activation activation, int kernel = 1, int stride = 1) {
+    LayerSpec layer;
+    layer.type = type;
+    layer.activation = activation;
+    layer.outputs = outputs;
+    layer.kernel = kernel;
+    layer.stride = stride;
+    layer.weights = noise(static_cast<size_t>(depth) * outputs, std::sqrt(6.0f / depth), 0x51EDu + depth);
+    layer.bias = noise(outputs, 0.1f, 0xB1A5u + outputs);
+    return layer;
+}
+
+void addInferenceBenchmarks(std::vector<Benchmark>& suite) {
+    ModelSpec mlp;
+    mlp.inputChannels = FEATURE_SIZE;
+    mlp.layers.push_back(benchLayer(LayerType::DENSE, FEATURE_SIZE, 256, Activation::RELU));
+    mlp.layers.push_back(benchLayer(LayerType::DENSE, 256, 128, Activation::RELU));
+    mlp.layers.push_back(benchLayer(LayerType::DENSE, 128, 10, Activation::SOFTMAX));
+
+    ModelSpec cnn;
+    cnn.inputLength = FEATURE_SIZE;
+    cnn.inputChannels = 1;
+    cnn.layers.push_back(benchLayer(LayerType::CONV1D, 8, 16, Activation::RELU, 8, 2));
+    cnn.layers.push_back(benchLayer(LayerType::CONV1D, 5 * 16, 32, Activation::RELU, 5, 2));
+    LayerSpec pool;
+    pool.type = LayerType::GLOBAL_AVERAGE_POOL;
+    cnn.layers.push_back(pool);
+    cnn.layers.push_back(benchLayer(LayerType::DENSE, 32, 8, Activation::SOFTMAX));
+
+    struct Variant { const char* name; const ModelSpec* spec; InferencePrecision precision; int batch; };
+    const Variant variants[] = {
+        {"inference.mlpFloat", &mlp, InferencePrecision::FLOAT32, 1},
+        {"inference.mlpInt8", &mlp, InferencePrecision::INT8, 1},
+        {"inference.mlpInt8Batch", &mlp, InferencePrecision::INT8, TAG_BATCH},
+        {"inference.cnnFloat", &cnn, InferencePrecision::FLOAT32, 1},
+        {"inference.cnnInt8", &cnn, InferencePrecision::INT8, 1},
+    };
+    for (const Variant& variant : variants) {
+        auto model = std::make_shared<InferenceModel>();
+        if (!model->build(*variant.spec, variant.precision)) continue;
+        auto input = std::make_shared<std::vector<float>>(noise(static_cast<size_t>(variant.batch) * FEATURE_SIZE, 2.0f));
+        auto output = std::make_shared<std::vector<float>>(static_cast<size_t>(variant.batch) * model->outputSize());
+        int batch = variant.batch;
+        suite.push_back({variant.name, "ns/inference", batch,
+                         [=] { model->run(input->data(), batch, output->data()); }});
+    }
+
+    // Feature extraction of a 5 s stereo clip, per frame
+    constexpr int CLIP_FRAMES = RATE * 5;
+    auto extractor = std::make_shared<FeatureExtractor>();
+    auto clip = std::make_shared<std::vector<float>>(noise(static_cast<size_t>(CLIP_FRAMES) * 2, 0.3f));
+    auto features = std::make_shared<std::vector<float>>(FEATURE_SIZE);
+    suite.push_back({"features.extract", "ns/frame", CLIP_FRAMES,
+                     [=] { extractor->extract(clip->data(), CLIP_FRAMES, 2, RATE, features->data()); }});
+}
+
+/** Whole audio callback per burst, rendering a file through the engine's offline path */
+void addCallbackBenchmarks(std::vector<Benchmark>& suite, const std::string& scratch) {
+    struct Variant {
+        const char* name;
+        int sourceChannels;
+        bool fullChain;
+    };
+    const Variant variants[] = {
+        {"callback.stereo", 2, false},
+        {"callback.stereoFullChain", 2, true},
+        {"callback.surround6FullChain", 6, true},
+    };
+    for (const Variant& variant : variants) {
+        std::string path = writeSource(scratch, variant.sourceChannels);
+        if (path.empty()) {
+            std::fprintf(stderr, "cannot write callback source in %s\n", scratch.c_str());
+            continue;
+        }
+        auto engine = std::make_shared<FTLAudioEngine>();
+        AudioEngineConfig config;
+        config.sampleRate = RATE;
+        config.framesPerBurst = BURST;
+        config.offlineRender = true;
+        if (engine->initialize(config) != EngineResult::SUCCESS) {
+            continue;
+        }
+        if (variant.fullChain) {
+            engine->setLoudnessNormalization(true, -18.0f);
+            engine->setTruePeakLimiter(true, -1.0f);
+            engine->setHeadphoneVirtualizer(true);
+        }
+        auto sink = [](const float*, int32_t, int) { return true; };
+        suite.push_back({variant.name, "ns/frame", static_cast<long long>(RATE) * CALLBACK_SOURCE_SECONDS,
+                         [engine, path, sink] {
+            engine->setAudioSource(path);
+            engine->renderOffline(sink, nullptr);
+        }});
+    }
+}
+
+void addWaveformBenchmarks(std::vector<Benchmark>& suite, const std::string& scratch) {
+    auto chunk = std::make_shared<std::vector<float>>(noise(CHUNK * 2, 0.5f));
+    suite.push_back({"waveform.peaks", "ns/frame", CHUNK, [=] {
+        PeakAccumulator acc;
+        accumulatePeaks(chunk->data(), chunk->size(), acc);
+    }});
+
+    // Library scan: decode the 10 s source once and write its sidecar
+    std::string path = writeSource(scratch, 2);
+    if (path.empty()) {
+        std::fprintf(stderr, "cannot write waveform source in %s\n", scratch.c_str());
+        return;
+    }
+    std::string sidecar = scratch + "/bench.ftlwave";
+    suite.push_back({"waveform.build", "ns/frame", static_cast<long long>(RATE) * CALLBACK_SOURCE_SECONDS,
+                     [path, sidecar] {
+        buildWaveform(path, sidecar);
+    }});
+}
+
+constexpr int METADATA_LIBRARY_TRACKS = 50000;
+constexpr int METADATA_DECODER_TRACKS = 5000;
+
+void putBE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+void putText(std::vector<uint8_t>& out, const std::string& text) { out.insert(out.end(), text.begin(), text.end()); }
+
+/** A library file: header bytes at their offsets, the rest left as holes */
+struct LibraryFormat {
+    const char* extension;
+    std::vector<std::pair<off_t, std::vector<uint8_t>>> segments;
+    off_t size;
+};
+
+std::vector<LibraryFormat> libraryFormats() {
+    std::vector<LibraryFormat> formats;
+
+    // FLAC: 16/44.1 stereo, four minutes, tags and 8 KB padding; 30 MB
+    std::vector<uint8_t> flac;
+    putText(flac, "fLaC");
+    putBE(flac, 34, 4);
+    putBE(flac, 0x10001000, 4);
+    flac.resize(flac.size() + 6, 0);
+    putBE(flac, (44100ull << 44) | (1ull << 41) | (15ull << 36) | (44100ull * 240), 8);
+    flac.resize(flac.size() + 16, 0);
+    std::vector<uint8_t> comment;
+    putLE(comment, 5, 4);
+    putText(comment, "bench");
+    const char* entries[] = {"TITLE=Synthetic Track", "ARTIST=Bench Artist", "ALBUM=Bench Album",
+                             "DATE=2020", "TRACKNUMBER=5"};
+    putLE(comment, 5, 4);
+    for (const char* entry : entries) {
+        putLE(comment, std::strlen(entry), 4);
+        putText(comment, entry);
+    }
+    flac.push_back(4);
+    putBE(flac, comment.size(), 3);
+    flac.insert(flac.end(), comment.begin(), comment.end());
+    flac.push_back(0x81);
+    putBE(flac, 8192, 3);
+    formats.push_back({".flac", {{0, flac}}, 30 << 20});
+
+    // MP3: ID3v2.4 with 100 KB of cover art, then a LAME Info frame; 8 MB
+    std::vector<uint8_t> frames;
+    const char* texts[][2] = {{"TIT2", "Synthetic Track"}, {"TPE1", "Bench Artist"},
+                              {"TALB", "Bench Album"}, {"TRCK", "5"}};
+    for (const auto& text : texts) {
+        putText(frames, text[0]);
+        putBE(frames, std::strlen(text[1]) + 1, 4);
+        putBE(frames, 0, 2);
+        frames.push_back(3);
+        putText(frames, text[1]);
+    }
+    const uint32_t artBytes = 100 * 1024;
+    putText(frames, "APIC");
+    for (int shift = 21; shift >= 0; shift -= 7) frames.push_back((artBytes >> shift) & 0x7F);
+    putBE(frames, 0, 2);
+    const uint32_t tagBytes = static_cast<uint32_t>(frames.size()) + artBytes;
+    std::vector<uint8_t> id3 = {'I', 'D', '3', 4, 0, 0};
+    for (int shift = 21; shift >= 0; shift -= 7) id3.push_back((tagBytes >> shift) & 0x7F);
+    id3.insert(id3.end(), frames.begin(), frames.end());
+    std::vector<uint8_t> info = {0xFF, 0xFB, 0x90, 0x40};
+    info.resize(36, 0);
+    putText(info, "Info");
+    putBE(info, 0x3, 4);
+    putBE(info, 19000, 4);
+    putBE(info, 8 << 20, 4);
+    putText(info, "LAME3.100");
+    info.resize(417, 0);
+    info.insert(info.end(), {0xFF, 0xFB, 0x90, 0x40});
+    formats.push_back({".mp3", {{0, id3}, {10 + tagBytes, info}}, 8 << 20});
+
+    // WAV: 24/96 stereo, a minute, INFO chunk ahead of the data; 34 MB
+    const uint32_t dataBytes = 96000 * 6 * 60;
+    std::vector<uint8_t> wav;
+    putText(wav, "RIFF");
+    putLE(wav, 4 + 24 + 8 + 28 + 8 + dataBytes, 4);
+    putText(wav, "WAVEfmt ");
+    putLE(wav, 16, 4);
+    putLE(wav, 1, 2);
+    putLE(wav, 2, 2);
+    putLE(wav, 96000, 4);
+    putLE(wav, 96000 * 6, 4);
+    putLE(wav, 6, 2);
+    putLE(wav, 24, 2);
+    putText(wav, "LIST");
+    putLE(wav, 28, 4);
+    putText(wav, "INFOINAM");
+    putLE(wav, 16, 4);
+    putText(wav, "Synthetic Track");
+    wav.push_back(0);
+    putText(wav, "data");
+    putLE(wav, dataBytes, 4);
+    formats.push_back({".wav", {{0, wav}}, static_cast<off_t>(wav.size() + dataBytes)});
+    return formats;
+}
+
+std::string libraryPath(const std::string& directory, int index, const LibraryFormat& format) {
+    return directory + "/" + std::to_string(index) + format.extension;
+}
+
+/** Half FLAC, a third MP3, the rest WAV */
+const LibraryFormat& libraryFormatFor(const std::vector<LibraryFormat>& formats, int index) {
+    int slot = index % 6;
+    return formats[slot < 3 ? 0 : slot < 5 ? 1 : 2];
+}
+
+bool writeLibrary(const std::string& directory, std::vector<std::string>& paths) {
+    if (mkdir(directory.c_str(), 0755) != 0) {
+        return false;
+    }
+    std::vector<LibraryFormat> formats = libraryFormats();
+    for (int index = 0; index < METADATA_LIBRARY_TRACKS; ++index) {
+        const LibraryFormat& format = libraryFormatFor(formats, index);
+        std::string path = libraryPath(directory, index, format);
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ftruncate(fd, format.size) == 0;
+        for (const auto& segment : format.segments) {
+            ok = ok && pwrite(fd, segment.second.data(), segment.second.size(), segment.first) ==
+                           static_cast<ssize_t>(segment.second.size());
+        }
+        ::close(fd);
+        if (!ok) {
+            return false;
+        }
+        paths.push_back(path);
+    }
+    return true;
+}
+
+void removeLibrary(const std::string& directory) {
+    std::vector<LibraryFormat> formats = libraryFormats();
+    for (int index = 0; index < METADATA_LIBRARY_TRACKS; ++index) {
+        unlink(libraryPath(directory, index, libraryFormatFor(formats, index)).c_str());
+    }
+    rmdir(directory.c_str());
+}
+
+void addMetadataBenchmarks(std::vector<Benchmark>& suite, const std::string& scratch) {
+    auto library = std::make_shared<std::vector<std::string>>();
+    if (!writeLibrary(scratch + "/library", *library)) {
+        std::fprintf(stderr, "cannot write the metadata library in %s\n", scratch.c_str());
+        return;
+    }
+    suite.push_back({"metadata.scan", "ns/file", METADATA_LIBRARY_TRACKS, [library] {
+        readTrackMetadataBatch(*library);
+    }});
+    suite.push_back({"metadata.scanSerial", "ns/file", METADATA_LIBRARY_TRACKS, [library] {
+        readTrackMetadataBatch(*library, 1);
+    }});
+
+    // Playback's open path: headers through the decoder plus its first read-ahead
+    auto playable = std::make_shared<std::vector<std::string>>();
+    for (const std::string& path : *library) {
+        if (path.compare(path.size() - 4, 4, ".mp3") != 0 && playable->size() < METADATA_DECODER_TRACKS) {
+            playable->push_back(path);
+        }
+    }
+    suite.push_back({"metadata.decoderOpen", "ns/file", METADATA_DECODER_TRACKS, [playable] {
+        for (const std::string& path : *playable) {
+            openAudioSource(path);
+        }
+    }});
+}
+
+constexpr int SEARCH_LIBRARY_TRACKS = 100000;
+constexpr int SEARCH_QUERIES = 1000;
+constexpr int SEARCH_LIKE_QUERIES = 20;
+
+/** Deterministic word soup with a few accented and common words, skewed like real tags */
+class TagGenerator {
+public:
+    explicit TagGenerator(uint32_t seed) : m_seed(seed) {
+        static const char* const SYLLABLES[] = {
+            "la", "ve", "ro", "ma", "ti", "ka", "ne", "so", "du", "ri", "mo", "be", "an", "el", "tor",
+            "sun", "day", "nigh", "ly", "ing", "st", "ar", "ch", "gra", "blu", "pe", "qu", "zo", "wi", "fe",
+            "h\xC3\xA9", "s\xC3\xB6", "\xC3\xB1" "a", "cr", "ph", "oo", "ey", "dr", "mi", "ck"};
+        static const char* const COMMON[] = {"the", "of", "love", "you", "in", "me", "my", "night", "a", "and"};
+        for (const char* word : COMMON) m_words.push_back(word);
+        while (m_words.size() < VOCABULARY) {
+            std::string word;
+            for (int s = 1 + next() % 4; s > 0; --s) word += SYLLABLES[next() % 40];
+            m_words.push_back(word);
+        }
+    }
+
+    std::string words(int minWords, int maxWords) {
+        std::string text;
+        for (int w = minWords + next() % (maxWords - minWords + 1); w > 0; --w) {
+            if (!text.empty()) text += ' ';
+            double u = (next() % 1000000) / 1000000.0;
+            std::string word = m_words[static_cast<size_t>(u * u * u * VOCABULARY)];
+            if (next() % 3 == 0) word[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(word[0])));
+            text += word;
+        }
+        return text;
+    }
+
+    uint32_t next() {
+        m_seed = m_seed * 1664525u + 1013904223u;
+        return m_seed >> 8;
+    }
+
+private:
+    static constexpr size_t VOCABULARY = 40000;
+    uint32_t m_seed;
+    std::vector<std::string> m_words;
+};
+
+std::vector<SearchEntry> searchLibrary() {
+    TagGenerator tags(0x5EA2C4u);
+    std::vector<std::string> artists(SEARCH_LIBRARY_TRACKS / 20);
+    std::vector<std::string> albums(SEARCH_LIBRARY_TRACKS / 10);
+    for (std::string& artist : artists) artist = tags.words(1, 3);
+    for (std::string& album : albums) album = tags.words(1, 4);
+    std::vector<SearchEntry> library(SEARCH_LIBRARY_TRACKS);
+    for (int i = 0; i < SEARCH_LIBRARY_TRACKS; ++i) {
+        // Tracks come album by album, as a scan finds them
+        int album = i / 10;
+        library[i] = SearchEntry{i + 1, tags.words(1, 6), artists[album / 2 % artists.size()], albums[album]};
+    }
+    return library;
+}
+
+/** What a user types: growing prefixes of titles and artists, two-word queries, some typos */
+std::vector<std::string> searchQueries(const std::vector<SearchEntry>& library) {
+    TagGenerator pick(0xC0FFEEu);
+    std::vector<std::string> queries;
+    while (queries.size() < SEARCH_QUERIES) {
+        const SearchEntry& track = library[pick.next() % library.size()];
+        switch (pick.next() % 4) {
+            case 0:
+            case 1: {
+                const std::string& field = pick.next() % 2 ? track.title : track.artist;
+                for (size_t length = 1; length <= std::min<size_t>(field.size(), 8); ++length) {
+                    queries.push_back(field.substr(0, length));
+                }
+                break;
+            }
+            case 2:
+                queries.push_back(track.artist.substr(0, track.artist.find(' ')) + " " +
+                                  track.title.substr(0, track.title.find(' ')));
+                break;
+            default: {
+                std::string word = track.title.substr(0, track.title.find(' '));
+                if (word.size() >= 5) std::swap(word[2], word[3]);
+                queries.push_back(word);
+                break;
+            }
+        }
+    }
+    queries.resize(SEARCH_QUERIES);
+    return queries;
+}
+
+/** SQLite LIKE: ASCII case-insensitive substring */
+bool likeMatch(const std::string& text, const std::string& pattern) {
+    auto equal = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(text.begin(), text.end(), pattern.begin(), pattern.end(), equal) != text.end();
+}
+
+// Per-query latencies of the last search.query repetition, for the percentiles on stderr
+std::vector<double>& searchLatencies() {
+    static std::vector<double> latencies;
+    return latencies;
+}
+
+double searchMegabytesPer10k = 0.0;
+
+void addSearchBenchmarks(std::vector<Benchmark>& suite) {
+    auto library = std::make_shared<std::vector<SearchEntry>>(searchLibrary());
+    auto queries = std::make_shared<std::vector<std::string>>(searchQueries(*library));
+    auto index = std::make_shared<SearchIndex>();
+    index->upsert(*library);
+    searchMegabytesPer10k = index->stats().memoryBytes * 10000.0 / SEARCH_LIBRARY_TRACKS / (1024.0 * 1024.0);
+
+    suite.push_back({"search.build", "ns/track", SEARCH_LIBRARY_TRACKS, [library] {
+        SearchIndex fresh;
+        fresh.upsert(*library);
+    }});
+    suite.push_back({"search.query", "ns/query", SEARCH_QUERIES, [index, queries] {
+        std::vector<double>& latencies = searchLatencies();
+        latencies.clear();
+        for (const std::string& query : *queries) {
+            auto start = Clock::now();
+            index->search(query);
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+    }});
+
+    // Today's path: LIKE '%q%' on title, artist and album of every row (rows already in memory)
+    auto likeHits = std::make_shared<size_t>(0);
+    suite.push_back({"search.likeScan", "ns/query", SEARCH_LIKE_QUERIES, [library, queries, likeHits] {
+        for (int q = 0; q < SEARCH_LIKE_QUERIES; ++q) {
+            const std::string& query = (*queries)[q * (SEARCH_QUERIES / SEARCH_LIKE_QUERIES)];
+            for (const SearchEntry& track : *library) {
+                if (likeMatch(track.artist, query) || likeMatch(track.title, query) || likeMatch(track.album, query)) {
+                    ++*likeHits;
+                }
+            }
+        }
+    }});
+}
+
+constexpr uint32_t SNAPSHOT_FIRST_SCREEN = 50;
+
+double snapshotMappedMegabytes = 0.0;
+double snapshotHeapMegabytes = 0.0;
+
+/** Heap behind one materialized row (strings past the small-string buffer) */
+size_t heapBytes(const SnapshotTrack& track) {
+    size_t bytes = sizeof(SnapshotTrack);
+    for (const std::string* text : {&track.title, &track.artist, &track.album, &track.filePath,
+                                    &track.mimeType, &track.codec}) {
+        if (text->capacity() > std::string().capacity()) bytes += text->capacity() + 1;
+    }
+    return bytes;
+}
+
+void addSnapshotBenchmarks(std::vector<Benchmark>& suite, const std::string& scratch) {
+    auto tracks = std::make_shared<std::vector<SnapshotTrack>>();
+    const uint32_t rates[] = {44100, 44100, 48000, 96000, 192000};
+    for (const SearchEntry& entry : searchLibrary()) {
+        SnapshotTrack track;
+        track.id = entry.trackId;
+        track.title = entry.title;
+        track.artist = entry.artist;
+        track.album = entry.album;
+        track.durationMs = 120000 + entry.trackId * 7919 % 300000;
+        track.fileSize = track.durationMs * 120;
+        track.dateAdded = 1700000000000 + entry.trackId;
+        track.sampleRate = rates[entry.trackId % 5];
+        track.bitDepth = entry.trackId % 3 ? 16 : 24;
+        track.bitRate = track.sampleRate * track.bitDepth;
+        track.channels = 2;
+        track.trackNumber = static_cast<uint32_t>(entry.trackId % 10 + 1);
+        track.flags = track.sampleRate > 48000 || track.bitDepth > 16 ? SNAPSHOT_FLAG_HI_RES : 0;
+        track.filePath = "/storage/emulated/0/Music/" + entry.artist + "/" + entry.album + "/" + entry.title + ".flac";
+        track.mimeType = "audio/x-flac";
+        track.codec = "FLAC";
+        tracks->push_back(std::move(track));
+    }
+    const std::string path = scratch + "/library.ftlsnap";
+    if (!LibrarySnapshot::write(path, *tracks, 0)) {
+        std::fprintf(stderr, "cannot write the library snapshot in %s\n", scratch.c_str());
+        return;
+    }
+    size_t heap = 0;
+    for (const SnapshotTrack& track : *tracks) heap += heapBytes(track);
+    snapshotHeapMegabytes = heap / (1024.0 * 1024.0);
+    {
+        LibrarySnapshot snapshot;
+        snapshot.map(path);
+        snapshotMappedMegabytes = snapshot.mappedBytes() / (1024.0 * 1024.0);
+    }
+
+    suite.push_back({"snapshot.write", "ns/track", SEARCH_LIBRARY_TRACKS, [tracks, path] {
+        LibrarySnapshot::write(path + ".bench", *tracks, 0);
+    }});
+    suite.push_back({"snapshot.firstRows", "ns/open", 1, [path] {
+        LibrarySnapshot snapshot;
+        if (!snapshot.map(path)) return;
+        const uint32_t* byTitle = snapshot.order(ORDER_TITLE);
+        std::vector<SnapshotTrack> screen;
+        for (uint32_t i = 0; i < SNAPSHOT_FIRST_SCREEN; ++i) screen.push_back(snapshot.track(byTitle[i]));
+    }});
+    // Every row as an object, then sorted by title, before the first one shows
+    suite.push_back({"snapshot.materializeAll", "ns/open", 1, [path] {
+        LibrarySnapshot snapshot;
+        if (!snapshot.map(path)) return;
+        std::vector<SnapshotTrack> rows;
+        rows.reserve(snapshot.rowCount());
+        for (uint32_t row = 0; row < snapshot.rowCount(); ++row) rows.push_back(snapshot.track(row));
+        std::sort(rows.begin(), rows.end(), [](const SnapshotTrack& a, const SnapshotTrack& b) {
+            return a.title < b.title;
+        });
+    }});
+}
+
+constexpr int LOG_BURST = 64;                     // Fits one thread ring
+
+/** Caller-side ns per call of each burst, for the stderr line */
+std::vector<double>& logCallerNs() {
+    static std::vector<double> samples;
+    return samples;
+}
+
+/** stderr (the host log sink) to /dev/null for the log cases, so the terminal does not skew them */
+class QuietStderr {
+public:
+    QuietStderr() : m_saved(dup(STDERR_FILENO)) {
+        std::fflush(stderr);
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDERR_FILENO);
+            close(devNull);
+        }
+    }
+
+    ~QuietStderr() {
+        std::fflush(stderr);
+        if (m_saved >= 0) {
+            dup2(m_saved, STDERR_FILENO);
+            close(m_saved);
+        }
+    }
+
+private:
+    int m_saved;
+};
+
+void addLogBenchmarks(std::vector<Benchmark>& suite) {
+    // WARN: the lowest level the host backend prints, so the old path pays its formatting and write
+    suite.push_back({"log.sync", "ns/call", LOG_BURST, [] {
+        for (int i = 0; i < LOG_BURST; ++i) {
+            __android_log_print(ANDROID_LOG_WARN, "FTL_Bench", "Latency %.2f ms, %d frames, state %s",
+                                0.25 * i, BURST * i, "PLAYING");
+        }
+    }});
+    suite.push_back({"log.deferred", "ns/call", LOG_BURST, [] {
+        auto start = Clock::now();
+        for (int i = 0; i < LOG_BURST; ++i) {
+            FTL_LOGW("FTL_Bench", "Latency %.2f ms, %d frames, state %s", 0.25 * i, BURST * i, "PLAYING");
+        }
+        logCallerNs().push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / LOG_BURST);
+        log::flush();
+    }});
+    suite.push_back({"log.realtime", "ns/call", LOG_BURST, [] {
+        auto start = Clock::now();
+        for (int i = 0; i < LOG_BURST; ++i) {
+            FTL_LOGW_RT("FTL_Bench", "Latency %.2f ms, %d frames, state %s", 0.25 * i, BURST * i, "PLAYING");
+        }
+        logCallerNs().push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / LOG_BURST);
+        log::flush();
+    }});
+}
+
+constexpr int TRACE_SCOPES = 1024;
+constexpr double TRACE_EVENT_BUDGET_NS = 50.0;
+constexpr double TRACE_IDLE_BUDGET_NS = 5.0;
+
+void addTraceBenchmarks(std::vector<Benchmark>& suite) {
+    // Each scope is two events (begin and end); capture is stopped again so no other case records
+    suite.push_back({"trace.idleProbe", "ns/event", 2 * TRACE_SCOPES, [] {
+        for (int i = 0; i < TRACE_SCOPES; ++i) {
+            FTL_TRACE_SCOPE("idle");
+        }
+    }});
+    suite.push_back({"trace.recordedScope", "ns/event", 2 * TRACE_SCOPES, [] {
+        trace::start();
+        for (int i = 0; i < TRACE_SCOPES; ++i) {
+            FTL_TRACE_SCOPE("timed");
+        }
+        trace::stop();
+    }});
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// QUALITY
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+// Spec: THD+N < 0.001% (-100 dB), SNR > 120 dB, response +/-0.1 dB
+constexpr double SPEC_DISTORTION_DB = -100.0;
+constexpr double SPEC_SNR_DB = 120.0;
+constexpr double SPEC_RESPONSE_DB = 0.1;
+
+struct QualityCase {
+    const char* name;
+    bool distortionSpec;               // Held to the distortion and noise limits
+    bool flatSpec;                     // Held to the response limit
+    std::function<EngineResult(QualityReport&)> measure;
+};
+
+std::vector<QualityCase> qualityCases(const std::string& scratch) {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = BURST;
+    config.offlineRender = true;
+    OfflineSetup eq = [](FTLAudioEngine& engine) {
+        const float curve[Equalizer::BANDS] = {4.0f, 2.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, -2.0f, 2.0f, 3.0f};
+        engine.setEqualizer(true, curve, Equalizer::BANDS);
+    };
+    OfflineSetup fullChain = [](FTLAudioEngine& engine) {
+        engine.setTruePeakLimiter(true, -1.0f);
+        engine.setHeadphoneVirtualizer(true);      // Crossfeed shapes the response on purpose
+    };
+    return {
+        {"quality.chain", true, true, [config, scratch](QualityReport& report) {
+            return measureChainQuality(config, nullptr, scratch, report);
+        }},
+        {"quality.fullChain", true, false, [config, scratch, fullChain](QualityReport& report) {
+            return measureChainQuality(config, fullChain, scratch, report);
+        }},
+        // Shapes the response on purpose; must not cost distortion or noise
+        {"quality.eq", true, false, [config, scratch, eq](QualityReport& report) {
+            return measureChainQuality(config, eq, scratch, report);
+        }},
+        // Voices only (previews, prompts): tracked against the baseline, no spec
+        {"quality.voiceResampler44k1", false, false, [](QualityReport& report) {
+            return measureResamplerQuality(44100, RATE, report);
+        }},
+    };
+}
+
+void addQualityResults(const QualityCase& qualityCase, const QualityReport& report, std::vector<QualityResult>& out) {
+    auto add = [&](const char* metric, double value, bool higherIsBetter, bool hasLimit, double limit) {
+        QualityResult result;
+        result.name = std::string(qualityCase.name) + "." + metric;
+        result.unit = "dB";
+        result.value = value;
+        result.higherIsBetter = higherIsBetter;
+        result.hasLimit = hasLimit;
+        result.limit = limit;
+        out.push_back(result);
+    };
+    bool distortion = qualityCase.distortionSpec;
+    add("thdPlusN", report.thdPlusNDb, false, distortion, SPEC_DISTORTION_DB);
+    add("snr", report.snrDb, true, distortion, SPEC_SNR_DB);
+    add("lowLevelThdPlusN", report.lowLevelThdPlusNDb, false, distortion, SPEC_DISTORTION_DB);
+    add("imd", analysis::ratioToDb(report.imdPercent / 100.0), false, distortion, SPEC_DISTORTION_DB);
+    add("multitone", report.multitoneDistortionDb, false, distortion, SPEC_DISTORTION_DB);
+    add("responseDeviation", std::max(std::fabs(report.responseMinDb), std::fabs(report.responseMaxDb)),
+        false, qualityCase.flatSpec, SPEC_RESPONSE_DB);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// RUNNER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+double secondsOf(const std::function<void()>& op, long long count) {
+    auto start = Clock::now();
+    for (long long i = 0; i < count; ++i) {
+        op();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+BenchResult measure(const Benchmark& benchmark, const Options& options) {
+    const double warmupSeconds = options.quick ? 0.005 : 0.2;
+    const double repetitionSeconds = options.quick ? 0.002 : 0.05;
+
+    // Warmup: caches, branch predictors, CPU frequency; also sizes the repetitions
+    long long ops = 1;
+    double elapsed = 0.0;
+    long long done = 0;
+    while (elapsed < warmupSeconds) {
+        elapsed += secondsOf(benchmark.op, ops);
+        done += ops;
+        ops *= 2;
+    }
+    long long opsPerRepetition = std::max(1LL, static_cast<long long>(repetitionSeconds * done / elapsed));
+
+    std::vector<double> samples;
+    for (int r = 0; r < options.repetitions; ++r) {
+        double seconds = secondsOf(benchmark.op, opsPerRepetition);
+        samples.push_back(seconds * 1e9 / (static_cast<double>(opsPerRepetition) * benchmark.items));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = benchmark.name;
+    result.unit = benchmark.unit;
+    result.items = benchmark.items;
+    result.median = samples[samples.size() / 2];
+    result.min = samples.front();
+    result.max = samples.back();
+    std::vector<double> deviations;
+    for (double sample : samples) {
+        deviations.push_back(std::fabs(sample - result.median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    result.spread = result.median > 0.0 ? deviations[deviations.size() / 2] / result.median : 0.0;
+    return result;
+}
+
+int pinToCpu(const Options& options) {
+#if defined(__linux__)
+    if (!options.pin) return -1;
+    int cpu = options.cpu >= 0 ? options.cpu : sched_getcpu();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        std::fprintf(stderr, "cannot pin to CPU %d, running unpinned\n", cpu);
+        return -1;
+    }
+    return cpu;
+#else
+    (void)options;
+    return -1;
+#endif
+}
+
+const char* archName() {
+#if defined(__aarch64__)
+    return "arm64";
+#elif defined(__arm__)
+    return "arm";
+#elif defined(__x86_64__)
+    return "x86_64";
+#elif defined(__i386__)
+    return "x86";
+#else
+    return "unknown";
+#endif
+}
+
+const char* simdName() {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return "neon";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+bool parse(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            options.output = argv[++i];
+        } else if (arg == "-r" && hasValue) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--cpu" && hasValue) {
+            options.cpu = std::atoi(argv[++i]);
+        } else if (arg == "--no-pin") {
+            options.pin = false;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            return false;
+        }
+    }
+    if (options.quick && options.repetitions == 15) {
+        options.repetitions = 3;
+    }
+    return options.repetitions > 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) {
+        std::fprintf(stderr, "usage: ftl_audio_bench [-o out.json] [-r reps] [--filter text] "
+                             "[--cpu n | --no-pin] [--quick] [--list]\n");
+        return 2;
+    }
+
+    char scratchTemplate[] = "/tmp/ftl_bench_XXXXXX";
+    const char* scratch = mkdtemp(scratchTemplate);
+    if (!scratch) {
+        std::fprintf(stderr, "cannot create a scratch directory\n");
+        return 1;
+    }
+
+    std::vector<Benchmark> suite;
+    addFormatBenchmarks(suite);
+    addMixBenchmarks(suite);
+    addMathBenchmarks(suite);
+    addResamplerBenchmarks(suite);
+    addChannelBenchmarks(suite);
+    addDynamicsBenchmarks(suite);
+    addEqBenchmarks(suite);
+    addRingBenchmarks(suite);
+    addStretchBenchmarks(suite);
+    addInferenceBenchmarks(suite);
+    addCallbackBenchmarks(suite, scratch);
+    addWaveformBenchmarks(suite, scratch);
+    addMetadataBenchmarks(suite, scratch);
+    addSearchBenchmarks(suite);
+    addSnapshotBenchmarks(suite, scratch);
+    addLogBenchmarks(suite);
+    addTraceBenchmarks(suite);
+    std::vector<QualityCase> quality = qualityCases(scratch);
+
+    if (options.list) {
+        for (const Benchmark& benchmark : suite) std::printf("%s\n", benchmark.name.c_str());
+        for (const QualityCase& qualityCase : quality) std::printf("%s\n", qualityCase.name);
+        return 0;
+    }
+
+    BenchRun run;
+    run.arch = archName();
+    run.simd = simdName();
+    run.buildType = *FTL_BENCH_BUILD_TYPE ? FTL_BENCH_BUILD_TYPE : "unspecified";
+    run.compiler = __VERSION__;
+    run.cpu = pinToCpu(options);
+    run.repetitions = options.repetitions;
+    if (run.buildType != "Release") {
+        std::fprintf(stderr, "warning: %s build - configure with -DCMAKE_BUILD_TYPE=Release for real numbers\n",
+                     run.buildType.c_str());
+    }
+
+    for (const Benchmark& benchmark : suite) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (benchmark.name.compare(0, 4, "log.") == 0) {
+            QuietStderr quiet;
+            run.benchmarks.push_back(measure(benchmark, options));
+        } else {
+            run.benchmarks.push_back(measure(benchmark, options));
+        }
+        const BenchResult& r = run.benchmarks.back();
+        std::fprintf(stderr, "%-28s %10.3f %s  (min %.3f, spread %.1f%%)",
+                     r.name.c_str(), r.median, r.unit.c_str(), r.min, r.spread * 100.0);
+        if (r.unit == "ns/inference" && r.median > 0.0) {
+            std::fprintf(stderr, "  %.0f inferences/s", 1e9 / r.median);
+        }
+        if (r.unit == "ns/update") {
+            std::fprintf(stderr, "  %.3f%% of a core", r.median / (AdaptiveEq::UPDATE_INTERVAL_MS * 1e6) * 100.0);
+        }
+        if (r.name == "trace.idleProbe" || r.name == "trace.recordedScope") {
+            double budget = r.name == "trace.idleProbe" ? TRACE_IDLE_BUDGET_NS : TRACE_EVENT_BUDGET_NS;
+            std::fprintf(stderr, "  %s the %.0f ns budget", r.median <= budget ? "within" : "OVER", budget);
+        }
+        if (r.name.compare(0, 8, "stretch.") == 0) {
+            int rate = r.name.find("96k") != std::string::npos ? 96000 : 48000;
+            std::fprintf(stderr, "  %.2f%% of a core per stereo stream", r.median * rate / 1e9 * 100.0);
+        }
+        if (r.name == "waveform.build" && r.median > 0.0) {
+            std::fprintf(stderr, "  %.0fx realtime", 1e9 / RATE / r.median);
+        }
+        if (r.unit == "ns/file" && r.median > 0.0) {
+            std::fprintf(stderr, "  %.0f files/s", 1e9 / r.median);
+        }
+        if (r.name == "search.build") {
+            std::fprintf(stderr, "  %.2f MB per 10k tracks", searchMegabytesPer10k);
+        }
+        if (r.name == "search.query" && !searchLatencies().empty()) {
+            std::vector<double> latencies = searchLatencies();
+            std::sort(latencies.begin(), latencies.end());
+            std::fprintf(stderr, "  p50 %.1f us, p99 %.1f us", latencies[latencies.size() / 2],
+                         latencies[latencies.size() * 99 / 100]);
+        }
+        if (r.name == "snapshot.materializeAll") {
+            std::fprintf(stderr, "  heap %.1f MB of rows vs %.1f MB mapped", snapshotHeapMegabytes,
+                         snapshotMappedMegabytes);
+        }
+        if (r.name.compare(0, 5, "math.") == 0) {
+            size_t suffix = r.name.rfind(".libm");
+            if (suffix != std::string::npos) {
+                libmMedians()[r.name.substr(0, suffix)] = r.median;
+            } else if (libmMedians().count(r.name) && r.median > 0.0) {
+                std::fprintf(stderr, "  %.1fx libm", libmMedians()[r.name] / r.median);
+            }
+        }
+        if (!logCallerNs().empty()) {
+            std::vector<double>& samples = logCallerNs();
+            std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+            std::fprintf(stderr, "  caller %.1f ns/call", samples[samples.size() / 2]);
+            samples.clear();
+        }
+        std::fprintf(stderr, "\n");
+    }
+
+    for (const QualityCase& qualityCase : quality) {
+        if (!options.filter.empty() && std::string(qualityCase.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        QualityReport report;
+        if (qualityCase.measure(report) != EngineResult::SUCCESS) {
+            std::fprintf(stderr, "%-44s failed\n", qualityCase.name);
+            continue;
+        }
+        size_t first = run.quality.size();
+        addQualityResults(qualityCase, report, run.quality);
+        for (size_t i = first; i < run.quality.size(); ++i) {
+            const QualityResult& q = run.quality[i];
+            std::fprintf(stderr, "%-44s %10.3f %s%s\n", q.name.c_str(), q.value, q.unit.c_str(),
+                         q.meetsLimit() ? "" : "  OUT OF SPEC");
+        }
+    }
+
+    // Scratch sources are only needed while the callback, waveform and metadata benchmarks run
+    suite.clear();
+    removeLibrary(std::string(scratch) + "/library");
+    for (int channels : {2, 6}) {
+        unlink((std::string(scratch) + "/bench_" + std::to_string(channels) + "ch.wav").c_str());
+    }
+    unlink((std::string(scratch) + "/bench.ftlwave").c_str());
+    rmdir(scratch);
+
+    FILE* out = options.output.empty() ? stdout : std::fopen(options.output.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+        return 1;
+    }
+    ftl_bench::writeBenchRun(out, run);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
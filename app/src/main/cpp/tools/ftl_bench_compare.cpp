@@ -0,0 +1,161 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          FTL BENCH COMPARE - REGRESSION GATE (HOST CLI)     ║
+ * ║        Current ftl_audio_bench Run Against a Baseline       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ *   ftl_bench_compare [--threshold <percent>] [--quality-tolerance <dB>]
+ *                     <baseline.json> <current.json>
+ *
+ * A benchmark regresses when its median grows by more than the threshold
+ * (default 10%) plus the noise both runs measured (their spreads), so a
+ * jittery kernel does not fail the gate on its own jitter.
+ *
+ * Quality measurements are deterministic: one fails when it breaks its
+ * spec limit, or when it is worse than the baseline by more than the
+ * tolerance (default 3 dB).
+ *
+ * Exit status: 0 clean, 1 regressions, 2 unreadable input.
+ */
+
+#include "BenchFormat.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using ftl_bench::BenchResult;
+using ftl_bench::BenchRun;
+using ftl_bench::QualityResult;
+
+namespace {
+
+const BenchResult* find(const BenchRun& run, const std::string& name) {
+    for (const BenchResult& result : run.benchmarks) {
+        if (result.name == name) return &result;
+    }
+    return nullptr;
+}
+
+const QualityResult* findQuality(const BenchRun& run, const std::string& name) {
+    for (const QualityResult& result : run.quality) {
+        if (result.name == name) return &result;
+    }
+    return nullptr;
+}
+
+/** Quality failures: out of spec, or worse than the baseline beyond the tolerance */
+int compareQuality(const BenchRun& baseline, const BenchRun& current, double toleranceDb) {
+    if (current.quality.empty()) return 0;
+    std::printf("\n%-44s %10s %10s %9s  %s\n", "quality (dB)", "baseline", "current", "limit", "");
+    int failures = 0;
+    for (const QualityResult& now : current.quality) {
+        const QualityResult* before = findQuality(baseline, now.name);
+        const char* verdict = "";
+        if (!now.meetsLimit()) {
+            verdict = "OUT OF SPEC";
+            ++failures;
+        } else if (before) {
+            double worse = now.higherIsBetter ? before->value - now.value : now.value - before->value;
+            if (worse > toleranceDb) {
+                verdict = "WORSE";
+                ++failures;
+            }
+        } else {
+            verdict = "new";
+        }
+        char baselineValue[32] = "-";
+        char limit[32] = "-";
+        if (before) std::snprintf(baselineValue, sizeof(baselineValue), "%.3f", before->value);
+        if (now.hasLimit) std::snprintf(limit, sizeof(limit), "%s%.1f", now.higherIsBetter ? ">" : "<", now.limit);
+        std::printf("%-44s %10s %10.3f %9s  %s\n", now.name.c_str(), baselineValue, now.value, limit, verdict);
+    }
+    return failures;
+}
+
+void warnIfDifferent(const char* what, const std::string& baseline, const std::string& current) {
+    if (baseline != current) {
+        std::printf("warning: %s differs (baseline %s, current %s) - numbers may not be comparable\n",
+                    what, baseline.c_str(), current.c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double thresholdPercent = 10.0;
+    double qualityToleranceDb = 3.0;
+    std::string paths[2];
+    int given = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threshold" && i + 1 < argc) {
+            thresholdPercent = std::atof(argv[++i]);
+        } else if (arg == "--quality-tolerance" && i + 1 < argc) {
+            qualityToleranceDb = std::atof(argv[++i]);
+        } else if (given < 2 && (arg.empty() || arg[0] != '-')) {
+            paths[given++] = arg;
+        } else {
+            given = -1;
+            break;
+        }
+    }
+    if (given != 2 || thresholdPercent < 0.0 || qualityToleranceDb < 0.0) {
+        std::fprintf(stderr, "usage: ftl_bench_compare [--threshold percent] [--quality-tolerance dB] "
+                             "baseline.json current.json\n");
+        return 2;
+    }
+
+    BenchRun baseline;
+    BenchRun current;
+    if (!ftl_bench::readBenchRun(paths[0], baseline)) {
+        std::fprintf(stderr, "cannot read benchmark results from %s\n", paths[0].c_str());
+        return 2;
+    }
+    if (!ftl_bench::readBenchRun(paths[1], current)) {
+        std::fprintf(stderr, "cannot read benchmark results from %s\n", paths[1].c_str());
+        return 2;
+    }
+    warnIfDifferent("arch", baseline.arch, current.arch);
+    warnIfDifferent("simd", baseline.simd, current.simd);
+    warnIfDifferent("build type", baseline.buildType, current.buildType);
+
+    std::printf("%-28s %12s %12s %9s  %s\n", "benchmark", "baseline", "current", "change", "");
+    int regressions = 0;
+    for (const BenchResult& now : current.benchmarks) {
+        const BenchResult* before = find(baseline, now.name);
+        if (!before) {
+            std::printf("%-28s %12s %12.3f %9s  new\n", now.name.c_str(), "-", now.median, "");
+            continue;
+        }
+        double change = (now.median / before->median - 1.0) * 100.0;
+        double allowed = thresholdPercent + (before->spread + now.spread) * 100.0;
+        const char* verdict = "";
+        if (change > allowed) {
+            verdict = "REGRESSION";
+            ++regressions;
+        } else if (change < -allowed) {
+            verdict = "faster";
+        }
+        std::printf("%-28s %12.3f %12.3f %+8.1f%%  %s\n",
+                    now.name.c_str(), before->median, now.median, change, verdict);
+    }
+    for (const BenchResult& before : baseline.benchmarks) {
+        if (!find(current, before.name)) {
+            std::printf("%-28s %12.3f %12s %9s  missing\n", before.name.c_str(), before.median, "-", "");
+        }
+    }
+
+    int qualityFailures = compareQuality(baseline, current, qualityToleranceDb);
+
+    if (regressions > 0 || qualityFailures > 0) {
+        std::printf("%d regression%s beyond %.1f%%, %d quality failure%s\n", regressions,
+                    regressions == 1 ? "" : "s", thresholdPercent, qualityFailures, qualityFailures == 1 ? "" : "s");
+        return 1;
+    }
+    std::printf("no regressions beyond %.1f%%, quality within spec and %.1f dB of the baseline\n",
+                thresholdPercent, qualityToleranceDb);
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL RENDER - OFFLINE DSP CHAIN (HOST CLI)        ║
+ * ║      Pre-Render, Regression-Check and Benchmark Tracks      ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ *   ftl_render [options] <input>...
+ *     -o <path>            Output file (one input) or directory (several)
+ *                          Omit to render to memory only (benchmark)
+ *     -f f32|s24|s16       Output sample format (default f32)
+ *     -b <frames>          Burst size, as the device would call (default 256)
+ *     -c <channels>        Output channels (default 2)
+ *     -j <threads>         Tracks rendered in parallel (default 1)
+ *     --loudness <LUFS>    R128 normalization toward a target
+ *     --limiter <dBTP>     True-peak limiter ceiling
+ *     --virtualizer        Headphone binaural / crossfeed
+ *     --eq <dB,dB,...>     Equalizer curve (10 octave bands, or any count)
+ *     --adaptive-eq <0..1> Adaptive EQ at this strength
+ *     --trace <path>       Chrome/Perfetto trace of the render
+ *
+ * Prints x realtime and per-stage time for every track.
+ */
+
+#include "OfflineRender.h"
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace ftl_audio;
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string output;
+    WavSampleFormat format = WavSampleFormat::FLOAT_32;
+    int burst = 256;
+    int channels = 2;
+    int threads = 1;
+    bool loudness = false;
+    float targetLufs = -18.0f;
+    bool limiter = false;
+    float ceilingDb = -1.0f;
+    bool virtualizer = false;
+    std::vector<float> eqCurve;
+    bool adaptiveEq = false;
+    float adaptiveStrength = 1.0f;
+    std::string tracePath;
+};
+
+void usage() {
+    std::fprintf(stderr,
+        "usage: ftl_render [-o out] [-f f32|s24|s16] [-b burst] [-c channels] [-j threads]\n"
+        "                  [--loudness LUFS] [--limiter dBTP] [--virtualizer] [--eq dB,dB,...]\n"
+        "                  [--adaptive-eq strength] [--trace out.json] input...\n");
+}
+
+bool parse(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            options.output = argv[++i];
+        } else if (arg == "-f" && hasValue) {
+            std::string format = argv[++i];
+            if (format == "f32") options.format = WavSampleFormat::FLOAT_32;
+            else if (format == "s24") options.format = WavSampleFormat::PCM_24;
+            else if (format == "s16") options.format = WavSampleFormat::PCM_16;
+            else return false;
+        } else if (arg == "-b" && hasValue) {
+            options.burst = std::atoi(argv[++i]);
+        } else if (arg == "-c" && hasValue) {
+            options.channels = std::atoi(argv[++i]);
+        } else if (arg == "-j" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--loudness" && hasValue) {
+            options.loudness = true;
+            options.targetLufs = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--limiter" && hasValue) {
+            options.limiter = true;
+            options.ceilingDb = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--virtualizer") {
+            options.virtualizer = true;
+        } else if (arg == "--eq" && hasValue) {
+            for (char* token = std::strtok(argv[++i], ","); token; token = std::strtok(nullptr, ",")) {
+                options.eqCurve.push_back(static_cast<float>(std::atof(token)));
+            }
+        } else if (arg == "--adaptive-eq" && hasValue) {
+            options.adaptiveEq = true;
+            options.adaptiveStrength = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    return !options.inputs.empty() && options.burst > 0 && options.threads > 0;
+}
+
+std::string outputPathFor(const Options& options, const std::string& input) {
+    if (options.output.empty()) {
+        return std::string();
+    }
+    struct stat info;
+    bool isDirectory = stat(options.output.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    if (options.inputs.size() == 1 && !isDirectory) {
+        return options.output;
+    }
+    size_t slash = input.find_last_of('/');
+    std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return options.output + "/" + name.substr(0, dot) + ".wav";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    AudioEngineConfig config;
+    config.framesPerBurst = options.burst;
+    config.channelCount = options.channels;
+
+    std::vector<OfflineJob> jobs(options.inputs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].sourcePath = options.inputs[i];
+        jobs[i].outputPath = outputPathFor(options, options.inputs[i]);
+        jobs[i].outputFormat = options.format;
+    }
+
+    auto setup = [&options](FTLAudioEngine& engine) {
+        if (options.loudness) engine.setLoudnessNormalization(true, options.targetLufs);
+        if (options.limiter) engine.setTruePeakLimiter(true, options.ceilingDb);
+        if (options.virtualizer) engine.setHeadphoneVirtualizer(true);
+        if (!options.eqCurve.empty()) {
+            engine.setEqualizer(true, options.eqCurve.data(), static_cast<int>(options.eqCurve.size()));
+        }
+        if (options.adaptiveEq) engine.setAdaptiveEq(true, options.adaptiveStrength);
+    };
+
+    if (!options.tracePath.empty() && !trace::start()) {
+        return 2;
+    }
+    auto start = std::chrono::steady_clock::now();
+    renderOfflineJobs(config, setup, jobs, options.threads);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!options.tracePath.empty()) {
+        trace::stop();
+        if (!trace::writeChromeTrace(options.tracePath)) {
+            std::fprintf(stderr, "cannot write %s\n", options.tracePath.c_str());
+        }
+    }
+
+    std::printf("%-32s %10s %9s %8s | %8s %8s %8s %8s %8s %8s %8s  (ms)\n", "track", "seconds", "x rt", "bursts",
+                "decode", "source", "loudness", "eq", "mix", "limiter", "meter");
+    double audioSeconds = 0.0;
+    int failures = 0;
+    for (const OfflineJob& job : jobs) {
+        if (job.result != EngineResult::SUCCESS) {
+            std::printf("%-32s FAILED (%d)\n", job.sourcePath.c_str(), static_cast<int>(job.result));
+            ++failures;
+            continue;
+        }
+        const OfflineRenderStats& s = job.stats;
+        double seconds = static_cast<double>(s.frames) / job.sampleRate;
+        audioSeconds += seconds;
+        std::printf("%-32s %10.2f %9.1f %8lld | %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+                    job.sourcePath.c_str(), seconds, s.realtimeFactor, static_cast<long long>(s.bursts),
+                    s.decodeMs, s.sourceMs, s.loudnessMs, s.eqMs, s.mixMs, s.limiterMs, s.meterMs);
+    }
+    std::printf("total: %.2f s of audio in %.3f s wall (%.1fx realtime, %d thread%s)\n",
+                audioSeconds, wall, wall > 0.0 ? audioSeconds / wall : 0.0,
+                options.threads, options.threads == 1 ? "" : "s");
+    return failures == 0 ? 0 : 1;
+}
@@ -1,8 +1,457 @@
 /**
  * ╔══════════════════════════════════════════════════════════════╗
- * ║                     LOG UTILS - STUB                        ║
- * ║              Placeholder for future implementation          ║
+ * ║              LOG UTILS - DEFERRED-FORMAT LOGGING            ║
+ * ║      Raw Arguments on the Caller, printf on a Log Thread    ║
  * ╚══════════════════════════════════════════════════════════════╝
  */
 
-// Stub implementation - will be implemented in future iterations
\ No newline at end of file
+#include "LogUtils.h"
+#include "MpscQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#define LOG_TAG "FTL_Log"
+
+namespace ftl_audio {
+namespace log {
+
+namespace {
+
+static_assert((RECORDS_PER_THREAD & (RECORDS_PER_THREAD - 1)) == 0, "Ring size must be a power of two");
+
+// Shared by real-time threads that never logged through a ring of their own
+constexpr size_t REALTIME_QUEUE_RECORDS = 64;
+
+// Idle wait of the log thread; bounds how long a real-time message waits, since
+// FTL_LOG*_RT cannot signal it
+constexpr auto IDLE_WAIT = std::chrono::milliseconds(200);
+
+constexpr size_t MAX_LINE = 1024;
+
+/**
+ * Single-producer ring: the owning thread advances `head`, the log
+ * thread advances `tail`.
+ */
+struct ThreadRing {
+    Record records[RECORDS_PER_THREAD];
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    bool inUse = false;                       // Guarded by the registry mutex
+};
+
+struct Registry {
+    std::mutex mutex;                         // Rings and the writer's lifetime
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    MpscQueue<Record, REALTIME_QUEUE_RECORDS> realtime;
+    std::thread writer;
+    bool started = false;
+    std::atomic<bool> stopped{false};
+
+    std::mutex wakeMutex;                     // Wakeups and flush tickets
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::atomic<bool> sleeping{false};
+    bool stopping = false;
+    uint64_t flushRequested = 0;
+    uint64_t flushCompleted = 0;
+
+    std::atomic<Sink> sink{nullptr};
+    std::atomic<uint64_t> dropped{0};
+};
+
+// Never destroyed: threads may still log while statics are torn down
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+int64_t nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// Plain pointer so the real-time path reads it without TLS construction
+thread_local ThreadRing* t_ring = nullptr;
+
+/** Returns the thread's ring to the pool when the thread exits */
+struct ThreadSlot {
+    ~ThreadSlot() {
+        if (t_ring) {
+            // Records still queued are drained; the next owner continues the sequence
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            t_ring->inUse = false;
+            t_ring = nullptr;
+        }
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+void emit(int level, const char* tag, const char* text) {
+    Sink sink = registry().sink.load(std::memory_order_acquire);
+    if (sink) {
+        sink(level, tag, text);
+    } else {
+        __android_log_write(level, tag, text);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LOG THREAD
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool anyQueued(const std::vector<ThreadRing*>& rings) {
+    for (const ThreadRing* ring : rings) {
+        if (ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Everything queued now, in timestamp order across threads */
+void drain(Registry& r, std::vector<ThreadRing*>& rings, std::vector<Record>& batch) {
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        rings.clear();
+        for (auto& ring : r.rings) rings.push_back(ring.get());
+    }
+    batch.clear();
+    for (ThreadRing* ring : rings) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail < head; ++tail) {
+            batch.push_back(ring->records[tail & (RECORDS_PER_THREAD - 1)]);
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    Record record;
+    while (r.realtime.pop(record)) {
+        batch.push_back(record);
+    }
+    std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) {
+        return a.timestampNs < b.timestampNs;
+    });
+    for (const Record& queued : batch) {
+        emit(queued.level, queued.tag, format(queued).c_str());
+    }
+}
+
+void writerLoop() {
+    Registry& r = registry();
+    std::vector<ThreadRing*> rings;
+    std::vector<Record> batch;
+    uint64_t reportedDrops = 0;
+    for (;;) {
+        uint64_t ticket;
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(r.wakeMutex);
+            r.wake.wait_for(lock, IDLE_WAIT, [&] {
+                return !r.sleeping.load(std::memory_order_relaxed) || r.stopping ||
+                       r.flushRequested > r.flushCompleted;
+            });
+            ticket = r.flushRequested;
+            stopping = r.stopping;
+        }
+        r.sleeping.store(false, std::memory_order_relaxed);
+
+        drain(r, rings, batch);
+        uint64_t dropped = r.dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops) {
+            char text[96];
+            std::snprintf(text, sizeof(text), "%llu real-time log messages dropped",
+                          static_cast<unsigned long long>(dropped - reportedDrops));
+            emit(ANDROID_LOG_WARN, LOG_TAG, text);
+            reportedDrops = dropped;
+        }
+        {
+            std::lock_guard<std::mutex> lock(r.wakeMutex);
+            r.flushCompleted = ticket;
+        }
+        r.flushed.notify_all();
+        if (stopping) {
+            return;
+        }
+
+        // Announce the sleep, then look once more: a producer that missed the flag
+        // published before we read its ring
+        r.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (anyQueued(rings)) {
+            r.sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void stopWriter() {
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.wakeMutex);
+        r.stopping = true;
+    }
+    r.wake.notify_one();
+    if (r.writer.joinable()) {
+        r.writer.join();
+    }
+    // Later calls (static destructors) emit on their own thread
+    r.stopped.store(true, std::memory_order_release);
+}
+
+/** Caller holds the registry mutex */
+void startWriterLocked(Registry& r) {
+    if (r.started) {
+        return;
+    }
+    r.started = true;
+    r.writer = std::thread(writerLoop);
+    std::atexit(stopWriter);
+}
+
+ThreadRing* acquireRing() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    startWriterLocked(r);
+    (void)t_slot;                             // Registers the thread-exit hook
+    for (auto& ring : r.rings) {
+        if (!ring->inUse) {
+            ring->inUse = true;
+            return ring.get();
+        }
+    }
+    r.rings.push_back(std::make_unique<ThreadRing>());
+    r.rings.back()->inUse = true;
+    return r.rings.back().get();
+}
+
+bool pushToRing(ThreadRing& ring, const Record& record) {
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= RECORDS_PER_THREAD) {
+        return false;
+    }
+    ring.records[head & (RECORDS_PER_THREAD - 1)] = record;
+    ring.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FORMATTING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+int64_t signedArg(const Record& record, size_t index) {
+    return static_cast<int64_t>(record.args[index]);
+}
+
+} // namespace
+
+/**
+ * Re-runs printf one conversion at a time. Integer conversions are widened
+ * to long long and narrowed back to the width the caller passed, so %x of
+ * a negative int prints 8 digits as printf would.
+ */
+std::string format(const Record& record) {
+    std::string out;
+    char spec[40];
+    char piece[MAX_LINE];
+    size_t arg = 0;
+    const char* f = record.format ? record.format : "";
+    while (*f && out.size() < MAX_LINE) {
+        if (*f != '%') {
+            const char* start = f;
+            while (*f && *f != '%') ++f;
+            out.append(start, static_cast<size_t>(f - start));
+            continue;
+        }
+        if (f[1] == '%') {
+            out += '%';
+            f += 2;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion; the length is rebuilt below
+        size_t n = 0;
+        auto put = [&](char c) {
+            if (n < sizeof(spec) - 4) spec[n++] = c;
+        };
+        put(*f++);
+        while (*f && std::strchr("-+ #0'", *f)) put(*f++);
+        for (int part = 0; part < 2; ++part) {
+            if (part == 1) {
+                if (*f != '.') break;
+                put(*f++);
+            }
+            if (*f == '*') {
+                ++f;
+                char number[24];
+                std::snprintf(number, sizeof(number), "%lld",
+                              static_cast<long long>(arg < record.argCount ? signedArg(record, arg++) : 0));
+                for (const char* c = number; *c; ++c) put(*c);
+            } else {
+                while (*f >= '0' && *f <= '9') put(*f++);
+            }
+        }
+        int shortBits = 0;                    // 8 for hh, 16 for h
+        bool wide = false;                    // l, ll, j, z, t, q, L
+        while (*f && std::strchr("hljztqL", *f)) {
+            if (*f == 'h') {
+                shortBits = shortBits == 16 ? 8 : 16;
+            } else {
+                wide = true;
+            }
+            ++f;
+        }
+        char conversion = *f ? *f++ : '\0';
+        if (conversion == 'n') {
+            ++arg;
+            continue;
+        }
+        if (!std::strchr("diouxXcsfFeEgGaAp", conversion) || conversion == '\0') {
+            out.append(spec, n);
+            if (conversion) out += conversion;
+            continue;
+        }
+        if (arg >= record.argCount) {
+            out += "<?>";
+            continue;
+        }
+
+        ArgType type = record.argTypes[arg];
+        uint64_t raw = record.args[arg++];
+        int written = 0;
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                int64_t value = static_cast<int64_t>(raw);
+                if (shortBits == 8) value = static_cast<signed char>(value);
+                else if (shortBits == 16) value = static_cast<short>(value);
+                else if (!wide && (type == ArgType::INT32 || type == ArgType::UINT32)) value = static_cast<int32_t>(value);
+                put('l'); put('l'); put(conversion); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, static_cast<long long>(value));
+                break;
+            }
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X': {
+                uint64_t value = raw;
+                if (type == ArgType::INT32 || type == ArgType::UINT32) value &= 0xFFFFFFFFull;
+                if (shortBits) value &= (1ull << shortBits) - 1;
+                put('l'); put('l'); put(conversion); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, static_cast<unsigned long long>(value));
+                break;
+            }
+            case 'c':
+                put('c'); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, static_cast<int>(raw));
+                break;
+            case 's': {
+                const char* text = type == ArgType::STRING && raw < sizeof(record.text) ? record.text + raw : "(?)";
+                put('s'); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, text);
+                break;
+            }
+            case 'p':
+                put('p'); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, reinterpret_cast<void*>(static_cast<uintptr_t>(raw)));
+                break;
+            default: {
+                double value;
+                if (type == ArgType::DOUBLE) {
+                    std::memcpy(&value, &raw, sizeof(value));
+                } else {
+                    value = static_cast<double>(static_cast<int64_t>(raw));
+                }
+                put(conversion); spec[n] = '\0';
+                written = std::snprintf(piece, sizeof(piece), spec, value);
+                break;
+            }
+        }
+        if (written > 0) {
+            out.append(piece, std::min(static_cast<size_t>(written), sizeof(piece) - 1));
+        }
+    }
+    if (out.size() > MAX_LINE) {
+        out.resize(MAX_LINE);
+    }
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool post(Record& record) {
+    Registry& r = registry();
+    if (r.stopped.load(std::memory_order_acquire)) {
+        return false;
+    }
+    record.timestampNs = nowNs();
+    if (!t_ring) {
+        t_ring = acquireRing();
+    }
+    if (!pushToRing(*t_ring, record)) {
+        // Not a real-time caller: wait for the log thread rather than overtake the queue
+        flush();
+        if (!pushToRing(*t_ring, record)) {
+            return false;
+        }
+    }
+    // Pairs with the fence before the log thread's last look at the rings
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (r.sleeping.load(std::memory_order_relaxed) && r.sleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock(r.wakeMutex);
+        r.wake.notify_one();
+    }
+    return true;
+}
+
+bool postRealtime(Record& record) {
+    Registry& r = registry();
+    record.timestampNs = nowNs();
+    bool queued = t_ring ? pushToRing(*t_ring, record) : r.realtime.push(record);
+    if (!queued) {
+        r.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+void emitNow(const Record& record) {
+    emit(record.level, record.tag, format(record).c_str());
+}
+
+void flush() {
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (r.stopped.load(std::memory_order_acquire)) {
+            return;
+        }
+        startWriterLocked(r);
+    }
+    std::unique_lock<std::mutex> lock(r.wakeMutex);
+    uint64_t ticket = ++r.flushRequested;
+    r.sleeping.store(false, std::memory_order_relaxed);
+    r.wake.notify_one();
+    r.flushed.wait(lock, [&] { return r.flushCompleted >= ticket || r.stopping; });
+}
+
+uint64_t droppedCount() {
+    return registry().dropped.load(std::memory_order_relaxed);
+}
+
+void setSink(Sink sink) {
+    registry().sink.store(sink, std::memory_order_release);
+}
+
+} // namespace log
+} // namespace ftl_audio
@@ -0,0 +1,213 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              LOG UTILS - DEFERRED-FORMAT LOGGING            ║
+ * ║      Raw Arguments on the Caller, printf on a Log Thread    ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A log call copies the format pointer, its arguments and any %s text
+ * into a fixed record on the calling thread's ring; a background thread
+ * formats and hands the line to __android_log_write (stderr on the host).
+ * The caller never formats, locks or makes a syscall once its thread
+ * has a ring.
+ *
+ * Formats must be string literals (only the pointer is stored) and are
+ * checked by the compiler like printf. Calls below FTL_LOG_MIN_LEVEL
+ * compile away. FTL_LOG*_RT never allocates or blocks: on a thread
+ * without a ring it uses a shared lock-free queue, and when full the
+ * message is dropped and counted. The plain variants instead wait for
+ * the log thread when their ring is full, so nothing is lost or reordered.
+ */
+
+#ifndef FTL_LOG_UTILS_H
+#define FTL_LOG_UTILS_H
+
+#include <android/log.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#ifndef FTL_LOG_MIN_LEVEL
+#define FTL_LOG_MIN_LEVEL ANDROID_LOG_VERBOSE
+#endif
+
+namespace ftl_audio {
+namespace log {
+
+constexpr size_t MAX_ARGS = 8;
+constexpr size_t RECORD_BYTES = 256;
+// Records per thread: 128 x 256 bytes = 32 KB
+constexpr size_t RECORDS_PER_THREAD = 128;
+
+enum class ArgType : uint8_t {
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    DOUBLE,
+    STRING,                         // Value is the offset of the copy in `text`
+    POINTER
+};
+
+struct Record {
+    int64_t timestampNs;
+    const char* tag;
+    const char* format;
+    uint8_t level;
+    uint8_t argCount;
+    uint8_t textBytes;
+    ArgType argTypes[MAX_ARGS];
+    uint64_t args[MAX_ARGS];
+    char text[152];                 // %s copies, each terminated; truncated when full
+};
+
+static_assert(sizeof(Record) == RECORD_BYTES, "Log records are one fixed size");
+
+/** Line as the log thread emits it; tests install a capture */
+using Sink = void (*)(int level, const char* tag, const char* text);
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ARGUMENT CAPTURE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+namespace detail {
+
+inline void storeText(Record& record, const char* text) {
+    uint8_t at = record.textBytes;
+    size_t room = sizeof(record.text) - at;
+    size_t length = text ? std::strlen(text) : 6;
+    if (room == 0) {
+        record.args[record.argCount] = sizeof(record.text) - 1;
+        return;
+    }
+    length = length < room - 1 ? length : room - 1;
+    std::memcpy(record.text + at, text ? text : "(null)", length);
+    record.text[at + length] = '\0';
+    record.args[record.argCount] = at;
+    record.textBytes = static_cast<uint8_t>(at + length + 1);
+}
+
+template <typename T>
+inline void store(Record& record, T value) {
+    using V = typename std::decay<T>::type;
+    ArgType& type = record.argTypes[record.argCount];
+    uint64_t& slot = record.args[record.argCount];
+    if constexpr (std::is_same<V, const char*>::value || std::is_same<V, char*>::value) {
+        type = ArgType::STRING;
+        storeText(record, value);
+    } else if constexpr (std::is_enum<V>::value) {
+        store(record, static_cast<typename std::underlying_type<V>::type>(value));
+        return;
+    } else if constexpr (std::is_floating_point<V>::value) {
+        double widened = static_cast<double>(value);
+        type = ArgType::DOUBLE;
+        std::memcpy(&slot, &widened, sizeof(widened));
+    } else if constexpr (std::is_pointer<V>::value || std::is_null_pointer<V>::value) {
+        type = ArgType::POINTER;
+        slot = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const void*>(value)));
+    } else {
+        static_assert(std::is_integral<V>::value, "Log arguments are numbers, pointers or C strings");
+        if constexpr (std::is_signed<V>::value) {
+            type = sizeof(V) <= 4 ? ArgType::INT32 : ArgType::INT64;
+            slot = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else {
+            type = sizeof(V) <= 4 ? ArgType::UINT32 : ArgType::UINT64;
+            slot = static_cast<uint64_t>(value);
+        }
+    }
+    ++record.argCount;
+}
+
+/** Never called; lets the compiler check the format against the arguments */
+__attribute__((format(printf, 1, 2))) inline void checkFormat(const char*, ...) {}
+
+} // namespace detail
+
+template <typename... Args>
+inline void capture(Record& record, int level, const char* tag, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+    record.level = static_cast<uint8_t>(level);
+    record.tag = tag;
+    record.format = format;
+    record.argCount = 0;
+    record.textBytes = 0;
+    (detail::store(record, args), ...);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// API
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+/** Queue on the calling thread's ring (taking one on first use); false once logging has shut down */
+bool post(Record& record);
+
+/** Never allocates or locks; false (and counted) when the message is dropped */
+bool postRealtime(Record& record);
+
+/** Format `record` as printf would have */
+std::string format(const Record& record);
+
+/** Format and emit on the calling thread (after shutdown) */
+void emitNow(const Record& record);
+
+/** Block until everything posted before the call has been emitted */
+void flush();
+
+/** Messages dropped by FTL_LOG*_RT since start */
+uint64_t droppedCount();
+
+/** Route emitted lines to `sink` instead of __android_log_write (nullptr restores it) */
+void setSink(Sink sink);
+
+template <typename... Args>
+inline void write(int level, const char* tag, const char* format, const Args&... args) {
+    Record record;
+    capture(record, level, tag, format, args...);
+    if (!post(record)) emitNow(record);
+}
+
+template <typename... Args>
+inline void writeRealtime(int level, const char* tag, const char* format, const Args&... args) {
+    Record record;
+    capture(record, level, tag, format, args...);
+    postRealtime(record);
+}
+
+} // namespace log
+} // namespace ftl_audio
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LOGGING MACROS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+#define FTL_LOG_AT(level, tag, ...)                                                      \
+    do {                                                                                \
+        if constexpr ((level) >= FTL_LOG_MIN_LEVEL) {                                   \
+            if (false) ::ftl_audio::log::detail::checkFormat(__VA_ARGS__);              \
+            ::ftl_audio::log::write((level), (tag), __VA_ARGS__);                       \
+        }                                                                               \
+    } while (0)
+
+#define FTL_LOG_RT_AT(level, tag, ...)                                                   \
+    do {                                                                                \
+        if constexpr ((level) >= FTL_LOG_MIN_LEVEL) {                                   \
+            if (false) ::ftl_audio::log::detail::checkFormat(__VA_ARGS__);              \
+            ::ftl_audio::log::writeRealtime((level), (tag), __VA_ARGS__);               \
+        }                                                                               \
+    } while (0)
+
+#define FTL_LOGV(tag, ...) FTL_LOG_AT(ANDROID_LOG_VERBOSE, tag, __VA_ARGS__)
+#define FTL_LOGD(tag, ...) FTL_LOG_AT(ANDROID_LOG_DEBUG, tag, __VA_ARGS__)
+#define FTL_LOGI(tag, ...) FTL_LOG_AT(ANDROID_LOG_INFO, tag, __VA_ARGS__)
+#define FTL_LOGW(tag, ...) FTL_LOG_AT(ANDROID_LOG_WARN, tag, __VA_ARGS__)
+#define FTL_LOGE(tag, ...) FTL_LOG_AT(ANDROID_LOG_ERROR, tag, __VA_ARGS__)
+
+#define FTL_LOGI_RT(tag, ...) FTL_LOG_RT_AT(ANDROID_LOG_INFO, tag, __VA_ARGS__)
+#define FTL_LOGW_RT(tag, ...) FTL_LOG_RT_AT(ANDROID_LOG_WARN, tag, __VA_ARGS__)
+#define FTL_LOGE_RT(tag, ...) FTL_LOG_RT_AT(ANDROID_LOG_ERROR, tag, __VA_ARGS__)
+
+#endif // FTL_LOG_UTILS_H
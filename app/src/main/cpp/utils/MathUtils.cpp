@@ -1,8 +1,433 @@
 /**
  * ╔══════════════════════════════════════════════════════════════╗
- * ║                    MATH UTILS - STUB                        ║
- * ║              Placeholder for future implementation          ║
+ * ║               MATH UTILS - VECTOR TRANSCENDENTALS           ║
+ * ║      Batch exp/log/pow/sin/cos, dB Gains & Wavetables       ║
  * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Cephes single-precision polynomials (as in Pommier's sse_mathfun),
+ * written once against a small set of lane operations that exist for
+ * NEON, SSE2 and plain floats. Everything, single values included,
+ * runs through the widest lanes the target has.
  */
 
-// Stub implementation - will be implemented in future iterations
\ No newline at end of file
+#include "MathUtils.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FTL_MATH_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FTL_MATH_SSE 1
+#endif
+
+namespace ftl_audio {
+namespace fastmath {
+
+namespace {
+
+constexpr float LOG2E = 1.44269504088896341f;
+constexpr float LN2_HI = 0.693359375f;
+constexpr float LN2_LO = -2.12194440e-4f;
+constexpr float SQRT_HALF = 0.707106781186547524f;
+constexpr float FOUR_OVER_PI = 1.27323954473516f;
+constexpr float PI_4_A = 0.78515625f;            // pi/4 in three parts
+constexpr float PI_4_B = 2.4187564849853515625e-4f;
+constexpr float PI_4_C = 3.77489497744594108e-8f;
+constexpr float DB_TO_LN = 0.115129254649702284f;   // ln(10) / 20
+constexpr float LN_TO_DB = 8.68588963806503655f;    // 20 / ln(10)
+
+constexpr float EXP_P[] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                           4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+constexpr float LOG_P[] = {7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f,
+                           -1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+                           2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f};
+constexpr float SIN_P[] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+constexpr float COS_P[] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LANES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+/** Lane operations for one float, where neither NEON nor SSE2 exists */
+struct ScalarLanes {
+    using F = float;
+    using I = int32_t;
+    using M = bool;
+    static constexpr size_t WIDTH = 1;
+
+    static F load(const float* p) { return *p; }
+    static void store(float* p, F v) { *p = v; }
+    static F splat(float v) { return v; }
+    static F add(F a, F b) { return a + b; }
+    static F sub(F a, F b) { return a - b; }
+    static F mul(F a, F b) { return a * b; }
+    static F min(F a, F b) { return a < b ? a : b; }
+    static F max(F a, F b) { return a > b ? a : b; }
+    static M less(F a, F b) { return a < b; }
+    static F select(M m, F a, F b) { return m ? a : b; }
+    static I bits(F v) { I i; std::memcpy(&i, &v, sizeof(i)); return i; }
+    static F fromBits(I i) { F v; std::memcpy(&v, &i, sizeof(v)); return v; }
+    static I truncate(F v) { return static_cast<I>(v); }
+    static F toFloat(I v) { return static_cast<F>(v); }
+    static I floorToInt(F v) { I t = static_cast<I>(v); return static_cast<F>(t) > v ? t - 1 : t; }
+    static I splatI(int32_t v) { return v; }
+    static I addI(I a, I b) { return a + b; }
+    static I andI(I a, I b) { return a & b; }
+    static I orI(I a, I b) { return a | b; }
+    static I xorI(I a, I b) { return a ^ b; }
+    template <int N> static I shiftLeft(I v) { return static_cast<I>(static_cast<uint32_t>(v) << N); }
+    template <int N> static I shiftRight(I v) { return static_cast<I>(static_cast<uint32_t>(v) >> N); }
+    static M isZero(I v) { return v == 0; }
+    static F opaque(F v) {
+#if defined(__i386__) || defined(__x86_64__)
+        __asm__("" : "+x"(v));
+#elif defined(__arm__) || defined(__aarch64__)
+        __asm__("" : "+w"(v));
+#else
+        __asm__("" : "+m"(v));
+#endif
+        return v;
+    }
+};
+
+#if defined(FTL_MATH_NEON)
+struct VectorLanes {
+    using F = float32x4_t;
+    using I = int32x4_t;
+    using M = uint32x4_t;
+    static constexpr size_t WIDTH = 4;
+
+    static F load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, F v) { vst1q_f32(p, v); }
+    static F splat(float v) { return vdupq_n_f32(v); }
+    static F add(F a, F b) { return vaddq_f32(a, b); }
+    static F sub(F a, F b) { return vsubq_f32(a, b); }
+    static F mul(F a, F b) { return vmulq_f32(a, b); }
+    static F min(F a, F b) { return vminq_f32(a, b); }
+    static F max(F a, F b) { return vmaxq_f32(a, b); }
+    static M less(F a, F b) { return vcltq_f32(a, b); }
+    static F select(M m, F a, F b) { return vbslq_f32(m, a, b); }
+    static I bits(F v) { return vreinterpretq_s32_f32(v); }
+    static F fromBits(I i) { return vreinterpretq_f32_s32(i); }
+    static I truncate(F v) { return vcvtq_s32_f32(v); }
+    static F toFloat(I v) { return vcvtq_f32_s32(v); }
+    static I floorToInt(F v) {
+        I t = vcvtq_s32_f32(v);
+        // All-ones (-1) where truncation rounded up
+        return vaddq_s32(t, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(t), v)));
+    }
+    static I splatI(int32_t v) { return vdupq_n_s32(v); }
+    static I addI(I a, I b) { return vaddq_s32(a, b); }
+    static I andI(I a, I b) { return vandq_s32(a, b); }
+    static I orI(I a, I b) { return vorrq_s32(a, b); }
+    static I xorI(I a, I b) { return veorq_s32(a, b); }
+    template <int N> static I shiftLeft(I v) { return vshlq_n_s32(v, N); }
+    template <int N> static I shiftRight(I v) {
+        return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), N));
+    }
+    static M isZero(I v) { return vceqq_s32(v, vdupq_n_s32(0)); }
+    static F opaque(F v) { __asm__("" : "+w"(v)); return v; }
+};
+#elif defined(FTL_MATH_SSE)
+struct VectorLanes {
+    using F = __m128;
+    using I = __m128i;
+    using M = __m128;
+    static constexpr size_t WIDTH = 4;
+
+    static F load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static F splat(float v) { return _mm_set1_ps(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+    static M less(F a, F b) { return _mm_cmplt_ps(a, b); }
+    static F select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static I bits(F v) { return _mm_castps_si128(v); }
+    static F fromBits(I i) { return _mm_castsi128_ps(i); }
+    static I truncate(F v) { return _mm_cvttps_epi32(v); }
+    static F toFloat(I v) { return _mm_cvtepi32_ps(v); }
+    static I floorToInt(F v) {
+        I t = _mm_cvttps_epi32(v);
+        // All-ones (-1) where truncation rounded up
+        return _mm_add_epi32(t, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(t), v)));
+    }
+    static I splatI(int32_t v) { return _mm_set1_epi32(v); }
+    static I addI(I a, I b) { return _mm_add_epi32(a, b); }
+    static I andI(I a, I b) { return _mm_and_si128(a, b); }
+    static I orI(I a, I b) { return _mm_or_si128(a, b); }
+    static I xorI(I a, I b) { return _mm_xor_si128(a, b); }
+    template <int N> static I shiftLeft(I v) { return _mm_slli_epi32(v, N); }
+    template <int N> static I shiftRight(I v) { return _mm_srli_epi32(v, N); }
+    static M isZero(I v) { return _mm_castsi128_ps(_mm_cmpeq_epi32(v, _mm_setzero_si128())); }
+    static F opaque(F v) { __asm__("" : "+x"(v)); return v; }
+};
+#else
+using VectorLanes = ScalarLanes;
+#endif
+
+/**
+ * One Cody-Waite step: a - b * c, with c one piece of a constant split so
+ * that b * c is exact. -ffast-math would otherwise merge the steps back
+ * into a single product and lose the low bits the split exists for, so
+ * each result passes through opaque(), an empty asm the compiler cannot
+ * see through (it costs no instruction).
+ */
+template <typename L, typename F>
+inline F reduce(F a, F b, float c) {
+    return L::opaque(L::sub(a, L::mul(b, L::splat(c))));
+}
+
+template <typename L>
+inline typename L::F polynomial(typename L::F x, const float* coefficients, int count) {
+    typename L::F y = L::splat(coefficients[0]);
+    for (int k = 1; k < count; ++k) {
+        y = L::add(L::mul(y, x), L::splat(coefficients[k]));
+    }
+    return y;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// KERNELS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+template <typename L>
+inline typename L::F expLanes(typename L::F x) {
+    using F = typename L::F;
+    x = L::min(L::max(x, L::splat(EXP_MIN_INPUT)), L::splat(EXP_MAX_INPUT));
+
+    // x = n ln2 + r, |r| <= ln2 / 2
+    auto n = L::floorToInt(L::add(L::mul(x, L::splat(LOG2E)), L::splat(0.5f)));
+    F fn = L::toFloat(n);
+    x = reduce<L>(x, fn, LN2_HI);
+    x = reduce<L>(x, fn, LN2_LO);
+
+    F z = L::mul(x, x);
+    F y = L::add(L::add(L::mul(polynomial<L>(x, EXP_P, 6), z), x), L::splat(1.0f));
+    return L::mul(y, L::fromBits(L::template shiftLeft<23>(L::addI(n, L::splatI(127)))));
+}
+
+template <typename L>
+inline typename L::F logLanes(typename L::F x) {
+    using F = typename L::F;
+    x = L::max(x, L::splat(LOG_MIN_INPUT));
+
+    // x = m 2^e with m in [0.5, 1); then m in [sqrt(0.5), sqrt(2)) by moving one bit into e
+    auto raw = L::bits(x);
+    F e = L::toFloat(L::addI(L::template shiftRight<23>(raw), L::splatI(-126)));
+    F m = L::fromBits(L::orI(L::andI(raw, L::splatI(0x007FFFFF)), L::splatI(0x3F000000)));
+    auto small = L::less(m, L::splat(SQRT_HALF));
+    e = L::sub(e, L::select(small, L::splat(1.0f), L::splat(0.0f)));
+    m = L::add(L::sub(m, L::splat(1.0f)), L::select(small, m, L::splat(0.0f)));
+
+    F z = L::mul(m, m);
+    F y = L::mul(L::mul(polynomial<L>(m, LOG_P, 9), m), z);
+    y = L::add(y, L::mul(e, L::splat(LN2_LO)));
+    y = L::sub(y, L::mul(z, L::splat(0.5f)));
+    return L::add(L::opaque(L::add(m, y)), L::mul(e, L::splat(LN2_HI)));
+}
+
+/** sin and cos of x; either output may be skipped */
+template <typename L>
+inline void sinCosLanes(typename L::F x, typename L::F* sinOut, typename L::F* cosOut) {
+    using F = typename L::F;
+    auto sign = L::andI(L::bits(x), L::splatI(INT32_MIN));
+    F ax = L::min(L::fromBits(L::andI(L::bits(x), L::splatI(INT32_MAX))), L::splat(TRIG_MAX_INPUT));
+
+    // Octant j (even), then ax - j pi/4 in [-pi/4, pi/4]
+    auto j = L::truncate(L::mul(ax, L::splat(FOUR_OVER_PI)));
+    j = L::andI(L::addI(j, L::splatI(1)), L::splatI(~1));
+    F fj = L::toFloat(j);
+    ax = reduce<L>(ax, fj, PI_4_A);
+    ax = reduce<L>(ax, fj, PI_4_B);
+    ax = reduce<L>(ax, fj, PI_4_C);
+
+    F z = L::mul(ax, ax);
+    F cosPoly = L::add(L::sub(L::mul(L::mul(polynomial<L>(z, COS_P, 3), z), z), L::mul(z, L::splat(0.5f))),
+                       L::splat(1.0f));
+    F sinPoly = L::add(L::mul(L::mul(polynomial<L>(z, SIN_P, 3), z), ax), ax);
+
+    if (sinOut) {
+        auto useSin = L::isZero(L::andI(j, L::splatI(2)));
+        auto flip = L::xorI(sign, L::template shiftLeft<29>(L::andI(j, L::splatI(4))));
+        *sinOut = L::fromBits(L::xorI(L::bits(L::select(useSin, sinPoly, cosPoly)), flip));
+    }
+    if (cosOut) {
+        auto k = L::addI(j, L::splatI(-2));
+        auto useSin = L::isZero(L::andI(k, L::splatI(2)));
+        auto flip = L::template shiftLeft<29>(L::andI(L::xorI(k, L::splatI(-1)), L::splatI(4)));
+        *cosOut = L::fromBits(L::xorI(L::bits(L::select(useSin, sinPoly, cosPoly)), flip));
+    }
+}
+
+template <typename L>
+inline typename L::F sinLanes(typename L::F x) {
+    typename L::F out;
+    sinCosLanes<L>(x, &out, nullptr);
+    return out;
+}
+
+template <typename L>
+inline typename L::F cosLanes(typename L::F x) {
+    typename L::F out;
+    sinCosLanes<L>(x, nullptr, &out);
+    return out;
+}
+
+template <typename L>
+inline typename L::F dbToGainLanes(typename L::F db) {
+    return expLanes<L>(L::mul(db, L::splat(DB_TO_LN)));
+}
+
+template <typename L>
+inline typename L::F gainToDbLanes(typename L::F gain) {
+    return L::mul(logLanes<L>(gain), L::splat(LN_TO_DB));
+}
+
+using V = VectorLanes;
+constexpr size_t WIDTH = VectorLanes::WIDTH;
+
+/**
+ * out[i] = kernel(in[i]). The tail runs through the same lanes from a
+ * padded copy rather than through scalar code, which -ffast-math is free
+ * to contract differently; a batch and the single-value functions then
+ * agree bit for bit.
+ */
+template <typename Kernel>
+void forEach(const float* in, float* out, size_t count, Kernel kernel) {
+    size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH) {
+        V::store(out + i, kernel(V::load(in + i)));
+    }
+    if (i < count) {
+        float block[WIDTH] = {};
+        std::memcpy(block, in + i, (count - i) * sizeof(float));
+        V::store(block, kernel(V::load(block)));
+        std::memcpy(out + i, block, (count - i) * sizeof(float));
+    }
+}
+
+template <typename Kernel>
+float single(float x, Kernel kernel) {
+    float block[WIDTH] = {x};
+    V::store(block, kernel(V::load(block)));
+    return block[0];
+}
+
+const auto EXP_KERNEL = [](V::F x) { return expLanes<V>(x); };
+const auto LOG_KERNEL = [](V::F x) { return logLanes<V>(x); };
+const auto SIN_KERNEL = [](V::F x) { return sinLanes<V>(x); };
+const auto COS_KERNEL = [](V::F x) { return cosLanes<V>(x); };
+const auto DB_TO_GAIN_KERNEL = [](V::F x) { return dbToGainLanes<V>(x); };
+const auto GAIN_TO_DB_KERNEL = [](V::F x) { return gainToDbLanes<V>(x); };
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BATCH
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+void exp(const float* in, float* out, size_t count) { forEach(in, out, count, EXP_KERNEL); }
+void log(const float* in, float* out, size_t count) { forEach(in, out, count, LOG_KERNEL); }
+void sin(const float* in, float* out, size_t count) { forEach(in, out, count, SIN_KERNEL); }
+void cos(const float* in, float* out, size_t count) { forEach(in, out, count, COS_KERNEL); }
+void dbToGain(const float* db, float* gain, size_t count) { forEach(db, gain, count, DB_TO_GAIN_KERNEL); }
+void gainToDb(const float* gain, float* db, size_t count) { forEach(gain, db, count, GAIN_TO_DB_KERNEL); }
+
+void pow(const float* base, float exponent, float* out, size_t count) {
+    V::F e = V::splat(exponent);
+    forEach(base, out, count, [e](V::F x) { return expLanes<V>(V::mul(logLanes<V>(x), e)); });
+}
+
+void sinCos(const float* in, float* sinOut, float* cosOut, size_t count) {
+    V::F s;
+    V::F c;
+    size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH) {
+        sinCosLanes<V>(V::load(in + i), &s, &c);
+        V::store(sinOut + i, s);
+        V::store(cosOut + i, c);
+    }
+    if (i < count) {
+        float block[WIDTH] = {};
+        std::memcpy(block, in + i, (count - i) * sizeof(float));
+        sinCosLanes<V>(V::load(block), &s, &c);
+        V::store(block, s);
+        std::memcpy(sinOut + i, block, (count - i) * sizeof(float));
+        V::store(block, c);
+        std::memcpy(cosOut + i, block, (count - i) * sizeof(float));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SINGLE VALUES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+float exp(float x) { return single(x, EXP_KERNEL); }
+float log(float x) { return single(x, LOG_KERNEL); }
+float sin(float x) { return single(x, SIN_KERNEL); }
+float cos(float x) { return single(x, COS_KERNEL); }
+float dbToGain(float db) { return single(db, DB_TO_GAIN_KERNEL); }
+float gainToDb(float gain) { return single(gain, GAIN_TO_DB_KERNEL); }
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WAVETABLE OSCILLATOR
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+constexpr int FRACTION_BITS = 32 - WavetableOscillator::TABLE_BITS;
+constexpr float FRACTION_SCALE = 1.0f / static_cast<float>(1u << FRACTION_BITS);
+
+/** One cycle plus a guard point, so interpolation never wraps */
+const float* sineTable() {
+    static const struct Table {
+        float values[WavetableOscillator::TABLE_SIZE + 1];
+        Table() {
+            for (int i = 0; i <= WavetableOscillator::TABLE_SIZE; ++i) {
+                values[i] = static_cast<float>(std::sin(2.0 * M_PI * i / WavetableOscillator::TABLE_SIZE));
+            }
+        }
+    } table;
+    return table.values;
+}
+
+} // namespace
+
+WavetableOscillator::WavetableOscillator() : m_table(sineTable()) {}
+
+void WavetableOscillator::setFrequency(double frequencyHz, double sampleRate) {
+    double cycles = sampleRate > 0.0 ? frequencyHz / sampleRate : 0.0;
+    cycles -= std::floor(cycles);
+    m_increment = static_cast<uint32_t>(cycles * 4294967296.0);
+}
+
+void WavetableOscillator::setPhase(double cycles) {
+    cycles -= std::floor(cycles);
+    m_phase = static_cast<uint32_t>(cycles * 4294967296.0);
+}
+
+double WavetableOscillator::phase() const {
+    return m_phase / 4294967296.0;
+}
+
+void WavetableOscillator::render(float* out, int32_t frames, float amplitude) {
+    uint32_t phase = m_phase;
+    for (int32_t i = 0; i < frames; ++i) {
+        uint32_t index = phase >> FRACTION_BITS;
+        float fraction = static_cast<float>(phase & ((1u << FRACTION_BITS) - 1)) * FRACTION_SCALE;
+        float a = m_table[index];
+        float b = m_table[index + 1];
+        out[i] = amplitude * (a + (b - a) * fraction);
+        phase += m_increment;
+    }
+    m_phase = phase;
+}
+
+} // namespace fastmath
+} // namespace ftl_audio
@@ -0,0 +1,87 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            MPSC QUEUE - BOUNDED LOCK-FREE MAILBOX           ║
+ * ║        Any Thread -> One Consumer, No Locks, No Allocation  ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Bounded ring of sequenced cells (Vyukov). Producers claim a cell with
+ * one CAS; the single consumer never blocks and never writes shared
+ * state other than the cell it releases, so it is safe to drain from the
+ * audio callback. `T` must be trivially copyable.
+ */
+
+#ifndef FTL_MPSC_QUEUE_H
+#define FTL_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ftl_audio {
+
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "Queue items are copied by value");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /** Any thread. False when the queue is full. */
+    bool push(const T& item) {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[position & (Capacity - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Consumer thread only. False when empty. */
+    bool pop(T& item) {
+        Cell& cell = m_cells[m_dequeuePosition & (Capacity - 1)];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_dequeuePosition + 1) {
+            return false;
+        }
+        item = cell.item;
+        cell.sequence.store(m_dequeuePosition + Capacity, std::memory_order_release);
+        ++m_dequeuePosition;
+        return true;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    Cell m_cells[Capacity];
+    alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(64) size_t m_dequeuePosition = 0;
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+};
+
+} // namespace ftl_audio
+
+#endif // FTL_MPSC_QUEUE_H
@@ -0,0 +1,283 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           TRACE RECORDER - CROSS-THREAD TIMELINE            ║
+ * ║     Callback, Decode and JNI Events for Chrome / Perfetto   ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "TraceRecorder.h"
+
+#include <android/log.h>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#define LOG_TAG "FTL_Trace"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace ftl_audio {
+namespace trace {
+
+std::atomic<bool> g_recording{false};
+
+namespace {
+
+static_assert((EVENTS_PER_THREAD & (EVENTS_PER_THREAD - 1)) == 0, "Ring size must be a power of two");
+
+// Rings ready before the first event, so most threads never allocate mid-capture
+constexpr int PREALLOCATED_RINGS = 4;
+
+struct Event {
+    int64_t timestampNs;
+    const char* name;
+    int64_t value;
+    int32_t tid;
+    EventType type;
+};
+
+/**
+ * Single-writer ring. The owning thread publishes each event with a
+ * release store of `head`; the dumper copies behind it and drops any
+ * slot the writer may have lapped while it was copying.
+ */
+struct ThreadRing {
+    Event events[EVENTS_PER_THREAD];
+    std::atomic<uint64_t> head{0};
+    bool inUse = false;                       // Guarded by the registry mutex
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    std::unordered_map<int32_t, std::string> threadNames;
+    std::atomic<int64_t> captureStartNs{0};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+int64_t nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+ThreadRing* acquireRing() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& ring : r.rings) {
+        if (!ring->inUse) {
+            ring->inUse = true;
+            return ring.get();
+        }
+    }
+    r.rings.push_back(std::make_unique<ThreadRing>());
+    r.rings.back()->inUse = true;
+    return r.rings.back().get();
+}
+
+/** Per-thread handle; returns the ring to the pool when the thread exits */
+struct ThreadSlot {
+    ThreadRing* ring = nullptr;
+    int32_t tid = static_cast<int32_t>(syscall(SYS_gettid));
+    const char* name = nullptr;
+
+    ~ThreadSlot() {
+        if (ring) {
+            // Its events stay dumpable until another thread laps them
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            ring->inUse = false;
+        }
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+            out += escaped;
+        } else {
+            out += *c;
+        }
+    }
+    out += '"';
+}
+
+/** Consistent copy of one ring's events recorded since `sinceNs` */
+void snapshotRing(const ThreadRing& ring, int64_t sinceNs, std::vector<Event>& out) {
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t first = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+    size_t base = out.size();
+    for (uint64_t i = first; i < head; ++i) {
+        out.push_back(ring.events[i & (EVENTS_PER_THREAD - 1)]);
+    }
+    // The writer kept going: the slot it is filling now, and any before it, may be torn
+    uint64_t after = ring.head.load(std::memory_order_acquire);
+    uint64_t safeFrom = after >= EVENTS_PER_THREAD ? after - EVENTS_PER_THREAD + 1 : 0;
+    size_t torn = safeFrom > first ? static_cast<size_t>(std::min(safeFrom - first, head - first)) : 0;
+    out.erase(out.begin() + base, out.begin() + base + torn);
+
+    // Trim to the capture; also covers a ring reused from a thread recorded earlier
+    size_t keep = base;
+    for (size_t i = base; i < out.size(); ++i) {
+        if (out[i].timestampNs >= sinceNs) out[keep++] = out[i];
+    }
+    out.resize(keep);
+}
+
+void appendEvent(std::string& json, const Event& event, int pid) {
+    static const char* const PHASES[] = {"B", "E", "C", "i"};
+    char buffer[160];
+    json += json.back() == '[' ? "\n" : ",\n";
+    json += "{\"name\":";
+    appendJsonString(json, event.name);
+    std::snprintf(buffer, sizeof(buffer), ",\"cat\":\"ftl\",\"ph\":\"%s\",\"ts\":%lld.%03lld,\"pid\":%d,\"tid\":%d",
+                  PHASES[static_cast<int>(event.type)],
+                  static_cast<long long>(event.timestampNs / 1000),
+                  static_cast<long long>(event.timestampNs % 1000), pid, event.tid);
+    json += buffer;
+    if (event.type == EventType::COUNTER) {
+        std::snprintf(buffer, sizeof(buffer), ",\"args\":{\"value\":%lld}", static_cast<long long>(event.value));
+        json += buffer;
+    } else if (event.type == EventType::INSTANT) {
+        json += ",\"s\":\"t\"";
+    }
+    json += '}';
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// RECORDING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+bool start() {
+    if (!FTL_TRACING) {
+        LOGE("Tracing was compiled out (FTL_TRACING=0)");
+        return false;
+    }
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        int idle = 0;
+        for (auto& ring : r.rings) {
+            idle += ring->inUse ? 0 : 1;
+        }
+        for (; idle < PREALLOCATED_RINGS; ++idle) {
+            r.rings.push_back(std::make_unique<ThreadRing>());
+        }
+    }
+    r.captureStartNs.store(nowNs(), std::memory_order_relaxed);
+    g_recording.store(true, std::memory_order_release);
+    LOGI("Trace capture started");
+    return true;
+}
+
+void stop() {
+    g_recording.store(false, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+    ThreadSlot& slot = t_slot;
+    if (slot.name == name) {
+        return;
+    }
+    slot.name = name;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threadNames[slot.tid] = name;
+}
+
+void record(EventType type, const char* name, int64_t value) {
+    ThreadSlot& slot = t_slot;
+    if (!slot.ring) {
+        // Once per thread: takes a pooled ring under the registry lock
+        slot.ring = acquireRing();
+    }
+    ThreadRing& ring = *slot.ring;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    Event& event = ring.events[head & (EVENTS_PER_THREAD - 1)];
+    event.timestampNs = nowNs();
+    event.name = name;
+    event.value = value;
+    event.tid = slot.tid;
+    event.type = type;
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// EXPORT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+std::string chromeTraceJson() {
+    Registry& r = registry();
+    int64_t sinceNs = r.captureStartNs.load(std::memory_order_relaxed);
+    int pid = static_cast<int>(getpid());
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    std::vector<Event> events;
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& ring : r.rings) {
+        events.clear();
+        snapshotRing(*ring, sinceNs, events);
+
+        // Slices whose begin was overwritten or predates the capture would dangle
+        std::unordered_map<int32_t, int> depth;
+        for (const Event& event : events) {
+            if (event.type == EventType::BEGIN) {
+                ++depth[event.tid];
+            } else if (event.type == EventType::END) {
+                if (depth[event.tid] == 0) continue;
+                --depth[event.tid];
+            }
+            appendEvent(json, event, pid);
+        }
+    }
+
+    char buffer[64];
+    for (const auto& thread : r.threadNames) {
+        json += json.back() == '[' ? "\n" : ",\n";
+        std::snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,",
+                      pid, thread.first);
+        json += buffer;
+        json += "\"args\":{\"name\":";
+        appendJsonString(json, thread.second.c_str());
+        json += "}}";
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::string json = chromeTraceJson();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOGE("Cannot create trace file %s", path.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (ok) {
+        LOGI("Trace written to %s (%zu bytes)", path.c_str(), json.size());
+    }
+    return ok;
+}
+
+} // namespace trace
+} // namespace ftl_audio
@@ -0,0 +1,113 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           TRACE RECORDER - CROSS-THREAD TIMELINE            ║
+ * ║     Callback, Decode and JNI Events for Chrome / Perfetto   ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Every thread that records gets its own fixed ring of events, so the
+ * audio callback never locks, allocates or shares a cache line with the
+ * decode or UI threads. Rings overwrite their oldest events: the recorder
+ * is a flight recorder, dumped after the glitch.
+ *
+ * Event names must be string literals (only the pointer is stored).
+ * Building with FTL_TRACING=0 compiles every FTL_TRACE_* macro away.
+ */
+
+#ifndef FTL_TRACE_RECORDER_H
+#define FTL_TRACE_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#ifndef FTL_TRACING
+#define FTL_TRACING 1
+#endif
+
+namespace ftl_audio {
+namespace trace {
+
+// Events kept per thread: 16384 x 32 bytes = 512 KB, about 20 s of callback
+constexpr size_t EVENTS_PER_THREAD = 16384;
+
+enum class EventType : uint8_t {
+    BEGIN,
+    END,
+    COUNTER,
+    INSTANT
+};
+
+extern std::atomic<bool> g_recording;
+
+/** One relaxed load: the whole cost of an instrumentation point while idle */
+inline bool isRecording() {
+    return FTL_TRACING && g_recording.load(std::memory_order_relaxed);
+}
+
+/** Start a new capture; events recorded before this call are not dumped. False if compiled out. */
+bool start();
+void stop();
+
+/** Label the calling thread in the dump ("audio", "decode"...) */
+void setThreadName(const char* name);
+
+/** Append to the calling thread's ring. Callers check isRecording() first. */
+void record(EventType type, const char* name, int64_t value);
+
+inline void counter(const char* name, int64_t value) {
+    if (isRecording()) record(EventType::COUNTER, name, value);
+}
+
+inline void instant(const char* name) {
+    if (isRecording()) record(EventType::INSTANT, name, 0);
+}
+
+/** Begin/end pair around a C++ scope */
+class Scope {
+public:
+    explicit Scope(const char* name) : m_name(isRecording() ? name : nullptr) {
+        if (m_name) record(EventType::BEGIN, m_name, 0);
+    }
+
+    ~Scope() {
+        // Closes even if the capture stopped meanwhile, so slices stay balanced
+        if (m_name) record(EventType::END, m_name, 0);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* m_name;
+};
+
+/** Chrome trace-event JSON of the current capture, every thread merged */
+std::string chromeTraceJson();
+
+/** Write chromeTraceJson() to a file Perfetto / chrome://tracing can open */
+bool writeChromeTrace(const std::string& path);
+
+} // namespace trace
+} // namespace ftl_audio
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// INSTRUMENTATION MACROS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+#if FTL_TRACING
+#define FTL_TRACE_CONCAT_INNER(a, b) a##b
+#define FTL_TRACE_CONCAT(a, b) FTL_TRACE_CONCAT_INNER(a, b)
+#define FTL_TRACE_SCOPE(name) ::ftl_audio::trace::Scope FTL_TRACE_CONCAT(ftlTraceScope_, __LINE__)(name)
+#define FTL_TRACE_COUNTER(name, value) ::ftl_audio::trace::counter(name, static_cast<int64_t>(value))
+#define FTL_TRACE_INSTANT(name) ::ftl_audio::trace::instant(name)
+#define FTL_TRACE_THREAD_NAME(name) ::ftl_audio::trace::setThreadName(name)
+#else
+#define FTL_TRACE_SCOPE(name) ((void)0)
+#define FTL_TRACE_COUNTER(name, value) ((void)0)
+#define FTL_TRACE_INSTANT(name) ((void)0)
+#define FTL_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // FTL_TRACE_RECORDER_H
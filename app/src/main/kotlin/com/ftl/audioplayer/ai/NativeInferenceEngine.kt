@@ -0,0 +1,186 @@
+package com.ftl.audioplayer.ai
+
+import android.content.Context
+import android.util.Log
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.isActive
+import kotlinx.coroutines.withContext
+import javax.inject.Inject
+import javax.inject.Singleton
+
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               NATIVE INFERENCE ENGINE                        ║
+ * ║      int8 Genre / Mood / EQ Models Without the Interpreter   ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Runs the genre, mood and EQ-suggestion heads in the native engine
+ * (SIMD float32 / int8 kernels, no GPU delegate). Feature extraction is
+ * native too, so a call ships audio in and gets answers back. Whole
+ * libraries are tagged on a background-priority native thread.
+ *
+ * Models are .ftlm assets next to the .tflite ones; a missing asset
+ * leaves that slot to the TensorFlow Lite path.
+ */
+@Singleton
+class NativeInferenceEngine @Inject constructor(
+    private val context: Context
+) {
+
+    companion object {
+        private const val TAG = "NativeInferenceEngine"
+
+        private const val GENRE_MODEL_FILE = "genre_classification.ftlm"
+        private const val MOOD_MODEL_FILE = "mood_detection.ftlm"
+        private const val EQ_SUGGESTION_MODEL_FILE = "eq_optimization.ftlm"
+
+        const val SLOT_GENRE = 0
+        const val SLOT_MOOD = 1
+        const val SLOT_EQ = 2
+
+        // Native result row: analyzed, genre, confidence, mood, confidence, EQ bands
+        private const val ROW_HEADER = 5
+        private const val ROW_WIDTH = ROW_HEADER + TensorFlowLiteModelManager.EQ_OUTPUT_SIZE
+
+        private const val PROGRESS_POLL_MS = 250L
+
+        init {
+            System.loadLibrary("ftl_audio_engine")
+        }
+    }
+
+    private var handle = 0L
+
+    /**
+     * Load whichever .ftlm assets exist
+     * @return True if at least one model is ready
+     */
+    @Synchronized
+    fun initialize(quantize: Boolean = true): Boolean {
+        if (handle == 0L) {
+            handle = nativeCreate()
+        }
+        val files = mapOf(
+            SLOT_GENRE to GENRE_MODEL_FILE,
+            SLOT_MOOD to MOOD_MODEL_FILE,
+            SLOT_EQ to EQ_SUGGESTION_MODEL_FILE
+        )
+        for ((slot, file) in files) {
+            val image = try {
+                context.assets.open(file).use { it.readBytes() }
+            } catch (e: Exception) {
+                Log.d(TAG, "No native model $file")
+                continue
+            }
+            if (nativeLoadModel(handle, slot, image, quantize)) {
+                Log.i(TAG, "Native model $file loaded (${if (quantize) "int8" else "float32"})")
+            } else {
+                Log.w(TAG, "Native model $file is invalid")
+            }
+        }
+        return isReady()
+    }
+
+    fun hasModel(slot: Int): Boolean = handle != 0L && nativeHasModel(handle, slot)
+
+    fun isReady(): Boolean = hasModel(SLOT_GENRE) || hasModel(SLOT_MOOD) || hasModel(SLOT_EQ)
+
+    /**
+     * Tag one interleaved clip; slots without a model come back empty
+     */
+    fun analyze(samples: FloatArray, sampleRate: Int, channelCount: Int): NativeTags? {
+        if (handle == 0L || samples.isEmpty()) return null
+        val row = nativeAnalyze(handle, samples, sampleRate, channelCount) ?: return null
+        return NativeTags.fromRow(row, 0, hasModel(SLOT_EQ))
+    }
+
+    /**
+     * Tag audio files on the native background thread, suspending until done
+     * (cancelling the coroutine cancels the run)
+     *
+     * @return Tags in input order, or empty if nothing could be started
+     */
+    suspend fun tagLibrary(
+        paths: List<String>,
+        onProgress: ((completed: Int, total: Int) -> Unit)? = null
+    ): List<LibraryTrackTags> = withContext(Dispatchers.Default) {
+        if (handle == 0L || paths.isEmpty() || !nativeStartTagging(handle, paths.toTypedArray())) {
+            return@withContext emptyList()
+        }
+        try {
+            while (isActive) {
+                val progress = nativeGetTaggingProgress(handle) ?: break
+                onProgress?.invoke(progress[0], progress[1])
+                if (progress[2] == 0) break
+                delay(PROGRESS_POLL_MS)
+            }
+        } finally {
+            if (!isActive) nativeCancelTagging(handle)
+        }
+
+        val rows = nativeGetTaggingResults(handle, 0) ?: FloatArray(0)
+        val hasEq = hasModel(SLOT_EQ)
+        List(rows.size / ROW_WIDTH) { index ->
+            LibraryTrackTags(paths[index], NativeTags.fromRow(rows, index * ROW_WIDTH, hasEq))
+        }
+    }
+
+    fun cancelTagging() {
+        if (handle != 0L) nativeCancelTagging(handle)
+    }
+
+    @Synchronized
+    fun release() {
+        if (handle != 0L) {
+            nativeRelease(handle)
+            handle = 0L
+        }
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // NATIVE METHOD DECLARATIONS
+    // ═══════════════════════════════════════════════════════════════════════════════════
+
+    private external fun nativeCreate(): Long
+    private external fun nativeLoadModel(handle: Long, slot: Int, image: ByteArray, quantize: Boolean): Boolean
+    private external fun nativeHasModel(handle: Long, slot: Int): Boolean
+    private external fun nativeAnalyze(handle: Long, samples: FloatArray, sampleRate: Int, channelCount: Int): FloatArray?
+    private external fun nativeStartTagging(handle: Long, paths: Array<String>): Boolean
+    private external fun nativeGetTaggingProgress(handle: Long): IntArray?
+    private external fun nativeGetTaggingResults(handle: Long, fromIndex: Int): FloatArray?
+    private external fun nativeCancelTagging(handle: Long)
+    private external fun nativeRelease(handle: Long)
+}
+
+/**
+ * Native model answers for one clip or file. Index -1: no model for that slot
+ * (or the file could not be decoded).
+ */
+data class NativeTags(
+    val analyzed: Boolean,
+    val genreIndex: Int,
+    val genreConfidence: Float,
+    val moodIndex: Int,
+    val moodConfidence: Float,
+    val suggestedEQ: List<Float>
+) {
+    companion object {
+        internal fun fromRow(row: FloatArray, offset: Int, hasEq: Boolean): NativeTags {
+            val bands = TensorFlowLiteModelManager.EQ_OUTPUT_SIZE
+            return NativeTags(
+                analyzed = row[offset] != 0.0f,
+                genreIndex = row[offset + 1].toInt(),
+                genreConfidence = row[offset + 2],
+                moodIndex = row[offset + 3].toInt(),
+                moodConfidence = row[offset + 4],
+                suggestedEQ = if (hasEq) row.copyOfRange(offset + 5, offset + 5 + bands).toList() else emptyList()
+            )
+        }
+    }
+}
+
+data class LibraryTrackTags(
+    val path: String,
+    val tags: NativeTags
+)
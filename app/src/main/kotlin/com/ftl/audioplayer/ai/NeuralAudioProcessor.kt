@@ -98,12 +98,14 @@ enum class LocationType {
 /**
  * Neural Audio Processor - Main AI Engine
  * 
- * Handles all AI-powered audio analysis and enhancement features
- * using TensorFlow Lite models for on-device processing
+ * Handles all AI-powered audio analysis and enhancement features.
+ * Native int8 models answer first when their assets are present;
+ * TensorFlow Lite (then the heuristics) covers the rest.
  */
 @Singleton
 class NeuralAudioProcessor @Inject constructor(
-    private val modelManager: TensorFlowLiteModelManager
+    private val modelManager: TensorFlowLiteModelManager,
+    private val nativeEngine: NativeInferenceEngine
 ) {
     
     companion object {
@@ -111,6 +113,7 @@ class NeuralAudioProcessor @Inject constructor(
         private const val AUDIO_FEATURE_VECTOR_SIZE = 128
         private const val EQ_BANDS_COUNT = 32
         private const val MAX_PLAYLIST_LENGTH = 100
+        private const val MONO = 1
         
         // EQ Enhancement Constants
         private const val WORKOUT_BASS_BOOST = 2.0f
@@ -131,6 +134,7 @@ class NeuralAudioProcessor @Inject constructor(
     
     private var isInitialized = false
     private var modelsLoaded = false
+    private var nativeModelsLoaded = false
     
     /**
      * Initialize TensorFlow Lite models
@@ -142,6 +146,13 @@ class NeuralAudioProcessor @Inject constructor(
         try {
             Log.i(TAG, "Initializing Neural Audio Processor...")
             
+            nativeModelsLoaded = try {
+                nativeEngine.initialize()
+            } catch (e: Throwable) {
+                Log.w(TAG, "Native inference unavailable: ${e.message}")
+                false
+            }
+            
             // Initialize TensorFlow Lite model manager
             modelManager.initializeModels()
             
@@ -185,14 +196,23 @@ class NeuralAudioProcessor @Inject constructor(
             return AudioIntelligence.EMPTY
         }
         
-        // 1. Extract audio features (MFCC, spectral features, tempo)
-        val audioFeatures = extractAudioFeatures(audioBuffer, sampleRate)
+        // 1. Native models featurize and infer in one call; slots they lack fall through
+        val native = if (nativeModelsLoaded) nativeEngine.analyze(audioBuffer, sampleRate, MONO) else null
+        val nativeComplete = native != null && native.genreIndex >= 0 && native.moodIndex >= 0 &&
+            native.suggestedEQ.isNotEmpty()
+        
+        // 2. Extract audio features (MFCC, spectral features, tempo)
+        val audioFeatures = if (nativeComplete) FloatArray(0) else extractAudioFeatures(audioBuffer, sampleRate)
         
-        // 2. Run neural network inference
-        val genreResult = classifyGenre(audioFeatures)
-        val moodResult = detectMood(audioFeatures) 
+        // 3. Run neural network inference
+        val genreResult = native?.takeIf { it.genreIndex >= 0 }
+            ?.let { TensorFlowLiteModelManager.genreName(it.genreIndex) to it.genreConfidence }
+            ?: classifyGenre(audioFeatures)
+        val moodResult = native?.takeIf { it.moodIndex >= 0 }
+            ?.let { AudioMood.values()[it.moodIndex.coerceIn(0, AudioMood.values().size - 1)] to it.moodConfidence }
+            ?: detectMood(audioFeatures)
         val musicFeatures = extractMusicFeatures(audioFeatures)
-        val eqSuggestion = generateEQSuggestion(audioFeatures)
+        val eqSuggestion = native?.suggestedEQ?.takeIf { it.isNotEmpty() } ?: generateEQSuggestion(audioFeatures)
         
         val intelligence = AudioIntelligence(
             genre = genreResult.first,
@@ -263,6 +283,26 @@ class NeuralAudioProcessor @Inject constructor(
         return emptyList()
     }
     
+    /**
+     * Tag whole-library files with genre, mood and EQ on the native
+     * background thread (decode, features and int8 inference stay native)
+     * 
+     * @param paths Audio file paths (WAV / FLAC)
+     * @param onProgress Called with (completed, total) while tagging
+     * @return Tags in input order; empty without native models
+     */
+    suspend fun tagLibrary(
+        paths: List<String>,
+        onProgress: ((completed: Int, total: Int) -> Unit)? = null
+    ): List<LibraryTrackTags> {
+        check(isInitialized) { "Neural processor not initialized" }
+        if (!nativeModelsLoaded) {
+            Log.w(TAG, "Library tagging needs native models")
+            return emptyList()
+        }
+        return nativeEngine.tagLibrary(paths, onProgress)
+    }
+    
     /**
      * Real-time audio enhancement using neural networks
      * 
@@ -317,8 +357,10 @@ class NeuralAudioProcessor @Inject constructor(
     fun cleanup() {
         if (isInitialized) {
             modelManager.cleanupResources()
+            nativeEngine.release()
             isInitialized = false
             modelsLoaded = false
+            nativeModelsLoaded = false
             Log.i(TAG, "Neural Audio Processor cleaned up")
         }
     }
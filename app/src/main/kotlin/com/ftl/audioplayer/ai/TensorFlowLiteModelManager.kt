@@ -39,6 +39,14 @@ class TensorFlowLiteModelManager @Inject constructor(
         const val GENRE_OUTPUT_SIZE = 10  // Number of supported genres
         const val MOOD_OUTPUT_SIZE = 8    // Number of AudioMood enum values
         const val EQ_OUTPUT_SIZE = 32     // Number of EQ bands
+        
+        private val GENRES = arrayOf(
+            "Electronic", "Rock", "Pop", "Hip-Hop", "Jazz",
+            "Classical", "Ambient", "Folk", "Metal", "Unknown"
+        )
+        
+        /** Genre label of a classifier output index (shared with the native models) */
+        fun genreName(index: Int): String = GENRES.getOrElse(index) { "Unknown" }
     }
     
     // TensorFlow Lite interpreters for each model
@@ -267,13 +275,7 @@ class TensorFlowLiteModelManager @Inject constructor(
         }
     }
     
-    private fun getGenreFromIndex(index: Int): String {
-        val genres = arrayOf(
-            "Electronic", "Rock", "Pop", "Hip-Hop", "Jazz", 
-            "Classical", "Ambient", "Folk", "Metal", "Unknown"
-        )
-        return genres.getOrElse(index) { "Unknown" }
-    }
+    private fun getGenreFromIndex(index: Int): String = genreName(index)
 }
 
 /**
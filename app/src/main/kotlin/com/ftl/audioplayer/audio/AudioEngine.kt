@@ -21,13 +21,15 @@ import android.content.Context
 import android.media.AudioFormat
 import android.media.AudioManager
 import android.util.Log
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.delay
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
 import kotlinx.coroutines.flow.asStateFlow
+import kotlinx.coroutines.withContext
+import java.io.File
 import javax.inject.Inject
 import javax.inject.Singleton
-import kotlin.coroutines.resume
-import kotlin.coroutines.suspendCoroutine
 
 /**
  * Core audio engine managing all audio processing operations
@@ -57,14 +59,59 @@ class AudioEngine @Inject constructor(
         private const val STEREO_CHANNEL_COUNT = 2
         private const val DEFAULT_DEVICE_ID = 0
         
-        // Load native library
-        init {
+        // Sidecar seek indexes for long FLAC files (app cache, safe to delete)
+        private const val SEEK_INDEX_DIR = "seek_index"
+        
+        // Waveform peak pyramids for the seek bar and visualizers (app cache, safe to delete)
+        private const val WAVEFORM_DIR = "waveform"
+
+        // Native metadata batch layout (see nativeReadTrackMetadata)
+        private const val METADATA_NUMBERS_PER_TRACK = 9
+        private const val METADATA_STRINGS_PER_TRACK = 4
+
+        // Loudness stage: EQ boosts can reach +24 dB, so the limiter is on by default
+        const val DEFAULT_LOUDNESS_TARGET_LUFS = -18.0f
+        const val DEFAULT_TRUE_PEAK_CEILING_DB = -1.0f
+        private const val NO_LOUDNESS_LUFS = -200.0f   // Native "not measured yet"
+        
+        // Native control thread commands (ControlAction) and results (EngineResult)
+        private const val CONTROL_START = 0
+        private const val CONTROL_STOP = 1
+        private const val CONTROL_PAUSE = 2
+        private const val CONTROL_RESUME = 3
+        private const val CONTROL_SEEK = 4
+        private const val CONTROL_SET_OUTPUT_MODE = 5
+        private const val RESULT_SUCCESS = 0
+        
+        // Native EngineState values the Kotlin state follows
+        private const val NATIVE_STATE_INITIALIZED = 1
+        private const val NATIVE_STATE_RUNNING = 3
+        private const val NATIVE_STATE_PAUSED = 4
+        private const val NATIVE_STATE_ERROR = 6
+        private const val RESULT_PENDING = Int.MIN_VALUE
+        private const val COMMAND_POLL_MAX_MS = 16L
+        private const val COMMAND_TIMEOUT_MS = 5000L
+        
+        // Time-stretch for BPM matching: tempo range and pitch shift limit (semitones)
+        const val MIN_TEMPO = 0.7
+        const val MAX_TEMPO = 1.3
+        const val MAX_PITCH_SHIFT_SEMITONES = 12.0
+        const val STRETCH_MODE_MUSIC = 0
+        const val STRETCH_MODE_SPEECH = 1
+        
+        // In-engine EQ: ISO octave bands 31.5 Hz .. 16 kHz
+        const val EQ_BANDS = 10
+        const val DEFAULT_ADAPTIVE_EQ_STRENGTH = 0.5f
+        
+        // Native library: loaded on first use off the main thread, never in a class initializer
+        private val nativeLibraryLoaded: Boolean by lazy {
             try {
                 System.loadLibrary("ftl_audio_engine")
                 Log.i(TAG, "Native audio library loaded successfully")
+                true
             } catch (e: UnsatisfiedLinkError) {
                 Log.e(TAG, "Failed to load native audio library: ${e.message}")
-                throw RuntimeException("Failed to load ftl_audio_engine native library", e)
+                false
             }
         }
     }
@@ -88,6 +135,22 @@ class AudioEngine @Inject constructor(
     // Native engine handle (opaque pointer)
     private var nativeEngineHandle: Long = 0
     
+    // Lock-free view of native metrics/state (aliases engine memory)
+    @Volatile
+    private var snapshotReader: EngineSnapshotReader? = null
+    
+    // Last measureAudioQuality() result; the snapshot does not carry quality figures
+    @Volatile
+    private var lastQualityReport: AudioQualityReport? = null
+    
+    private val seekIndexDir: File by lazy {
+        File(context.cacheDir, SEEK_INDEX_DIR).apply { mkdirs() }
+    }
+    
+    private val waveformDir: File by lazy {
+        File(context.cacheDir, WAVEFORM_DIR).apply { mkdirs() }
+    }
+    
     // Audio manager for system integration
     private val audioManager: AudioManager by lazy {
         context.getSystemService(Context.AUDIO_SERVICE) as AudioManager
@@ -97,23 +160,41 @@ class AudioEngine @Inject constructor(
     // INITIALIZATION
     // ═══════════════════════════════════════════════════════════════════════════════════
     
+    /**
+     * Load the native library in the background. Call early (e.g. from
+     * Application.onCreate) so the first initialize() skips the load.
+     */
+    suspend fun preload(): Boolean = withContext(Dispatchers.Default) { nativeLibraryLoaded }
+    
     /**
      * Initialize the audio engine with optimal settings
      * 
+     * Runs off the caller's thread. The device stream opens in the background
+     * and pre-warms, so a setAudioSource() right after decodes while the device
+     * comes up and the first start() plays on the next burst.
+     * 
      * @param preferredSampleRate Target sample rate (Hz)
      * @param preferredBitDepth Target bit depth (16, 24, 32)
      * @param preferredBufferSize Target buffer size in frames
+     * @param burstPrefetch Read and decode seconds ahead in large batches so storage
+     *        and the CPU sleep in between; layout changes then follow the buffered audio
      * @return True if initialization successful
      */
     suspend fun initialize(
         preferredSampleRate: Int = DEFAULT_SAMPLE_RATE,
         preferredBitDepth: Int = DEFAULT_BIT_DEPTH,
-        preferredBufferSize: Int = 0 // 0 = auto-detect optimal
-    ): Boolean = suspendCoroutine { continuation ->
+        preferredBufferSize: Int = 0, // 0 = auto-detect optimal
+        burstPrefetch: Boolean = true
+    ): Boolean = withContext(Dispatchers.Default) {
         
         _engineState.value = AudioEngineState.INITIALIZING
         
         try {
+            if (!nativeLibraryLoaded) {
+                _engineState.value = AudioEngineState.ERROR
+                return@withContext false
+            }
+            
             // Get optimal audio configuration from system
             val optimalConfig = getOptimalAudioConfiguration(
                 preferredSampleRate, 
@@ -127,11 +208,18 @@ class AudioEngine @Inject constructor(
                 framesPerBurst = optimalConfig.framesPerBurst,
                 channelCount = optimalConfig.channelCount,
                 format = optimalConfig.format,
-                deviceId = optimalConfig.deviceId
+                deviceId = optimalConfig.deviceId,
+                prewarmStream = true,
+                burstPrefetch = burstPrefetch
             )
             
             if (initResult > 0) {
                 nativeEngineHandle = initResult
+                nativeSetSeekIndexDirectory(initResult, seekIndexDir.absolutePath)
+                nativeSetTruePeakLimiter(initResult, true, DEFAULT_TRUE_PEAK_CEILING_DB)
+                snapshotReader = nativeGetSnapshotBuffer(initResult)
+                    ?.let { EngineSnapshotReader(it) }
+                    ?.takeIf { it.isCompatible }
                 
                 // Update audio specs
                 _audioSpecs.value = AudioSpecs(
@@ -146,16 +234,16 @@ class AudioEngine @Inject constructor(
                 // This will be measured when needed
                 
                 _engineState.value = AudioEngineState.READY
-                continuation.resume(true)
+                true
             } else {
                 _engineState.value = AudioEngineState.ERROR
-                continuation.resume(false)
+                false
             }
             
         } catch (e: Exception) {
             Log.e(TAG, "Exception during audio engine initialization", e)
             _engineState.value = AudioEngineState.ERROR
-            continuation.resume(false)
+            false
         }
     }
     
@@ -216,9 +304,10 @@ class AudioEngine @Inject constructor(
      */
     suspend fun start(): Boolean {
         check(nativeEngineHandle != 0L) { "Audio engine not initialized" }
+        syncEngineState()
         if (_engineState.value != AudioEngineState.READY) return false
         
-        val result = nativeStartPlayback(nativeEngineHandle)
+        val result = runCommand(CONTROL_START)
         if (result) {
             _engineState.value = AudioEngineState.PLAYING
         }
@@ -230,9 +319,10 @@ class AudioEngine @Inject constructor(
      */
     suspend fun stop(): Boolean {
         check(nativeEngineHandle != 0L) { "Audio engine not initialized" }
+        syncEngineState()
         if (_engineState.value != AudioEngineState.PLAYING) return false
         
-        val result = nativeStopPlayback(nativeEngineHandle)
+        val result = runCommand(CONTROL_STOP)
         if (result) {
             _engineState.value = AudioEngineState.READY
         }
@@ -244,9 +334,10 @@ class AudioEngine @Inject constructor(
      */
     suspend fun pause(): Boolean {
         check(nativeEngineHandle != 0L) { "Audio engine not initialized" }
+        syncEngineState()
         if (_engineState.value != AudioEngineState.PLAYING) return false
         
-        val result = nativePausePlayback(nativeEngineHandle)
+        val result = runCommand(CONTROL_PAUSE)
         if (result) {
             _engineState.value = AudioEngineState.PAUSED
         }
@@ -258,15 +349,417 @@ class AudioEngine @Inject constructor(
      */
     suspend fun resume(): Boolean {
         check(nativeEngineHandle != 0L) { "Audio engine not initialized" }
+        syncEngineState()
         if (_engineState.value != AudioEngineState.PAUSED) return false
         
-        val result = nativeResumePlayback(nativeEngineHandle)
+        val result = runCommand(CONTROL_RESUME)
         if (result) {
             _engineState.value = AudioEngineState.PLAYING
         }
         return result
     }
     
+    /**
+     * Pick up state changes the engine made by itself, e.g. a sleep-timer
+     * PAUSE on the audio thread or a stream error
+     */
+    private fun syncEngineState() {
+        val current = _engineState.value
+        if (current != AudioEngineState.READY && current != AudioEngineState.PLAYING &&
+            current != AudioEngineState.PAUSED) return
+        
+        _engineState.value = when (nativeGetEngineState(nativeEngineHandle)) {
+            NATIVE_STATE_INITIALIZED -> AudioEngineState.READY
+            NATIVE_STATE_RUNNING -> AudioEngineState.PLAYING
+            NATIVE_STATE_PAUSED -> AudioEngineState.PAUSED
+            NATIVE_STATE_ERROR -> AudioEngineState.ERROR
+            else -> current                  // Mid-transition: the command that follows settles it
+        }
+    }
+    
+    /**
+     * Run a command on the native control thread
+     * Suspends while it waits in line or for the device, without holding a dispatcher thread
+     */
+    private suspend fun runCommand(action: Int, argument: Long = 0L): Boolean =
+        awaitCommand(nativePostCommand(nativeEngineHandle, action, argument), "$action")
+    
+    /**
+     * Wait for a posted control command without holding a dispatcher thread
+     */
+    private suspend fun awaitCommand(token: Long, action: String): Boolean {
+        if (token == 0L) {
+            Log.e(TAG, "Control command $action not accepted")
+            return false
+        }
+        
+        var pollMs = 1L
+        var waitedMs = 0L
+        while (waitedMs < COMMAND_TIMEOUT_MS) {
+            val result = nativeAwaitCommand(nativeEngineHandle, token, 0)
+            if (result != RESULT_PENDING) {
+                if (result != RESULT_SUCCESS) Log.e(TAG, "Control command $action failed: $result")
+                return result == RESULT_SUCCESS
+            }
+            delay(pollMs)
+            waitedMs += pollMs
+            pollMs = minOf(pollMs * 2, COMMAND_POLL_MAX_MS)
+        }
+        Log.e(TAG, "Control command $action timed out")
+        return false
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // SOURCE & SEEKING
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Play a WAV or FLAC file through the native decoder
+     * The stream follows the file's sample rate; change tracks while stopped
+     * if the rate differs. Runs on the control thread, in order with start/stop.
+     */
+    suspend fun setAudioSource(filePath: String): Boolean {
+        check(nativeEngineHandle != 0L) { "Audio engine not initialized" }
+        return awaitCommand(nativePostAudioSource(nativeEngineHandle, filePath), "set source")
+    }
+    
+    /**
+     * Pre-build the sidecar seek index for a FLAC file (e.g. during library scan)
+     * so its first seek is already O(1). Reads the whole file - run in background.
+     */
+    suspend fun buildSeekIndex(filePath: String): Boolean = withContext(Dispatchers.IO) {
+        nativeBuildSeekIndex(filePath, seekIndexDir.absolutePath)
+    }
+    
+    /**
+     * Queue the track that plays next. The decode thread opens it (and reads its
+     * first burst) at the end of its next batch, while storage is awake anyway;
+     * a setAudioSource() with the same path then starts without any I/O.
+     */
+    fun prefetchNextTrack(filePath: String): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativePrefetchNextSource(nativeEngineHandle, filePath)
+    }
+    
+    /**
+     * Build waveform peak pyramids for a library scan; tracks whose sidecar is
+     * still fresh are skipped. Decodes every new track once - run in background.
+     */
+    suspend fun buildWaveforms(filePaths: List<String>): WaveformBatchReport = withContext(Dispatchers.IO) {
+        val values = nativeBuildWaveforms(filePaths.toTypedArray(), waveformDir.absolutePath)
+            ?: return@withContext WaveformBatchReport()
+        val built = values[0].toInt()
+        WaveformBatchReport(
+            built = built,
+            skipped = values[1].toInt(),
+            failed = values[2].toInt(),
+            realtimeFactor = if (values[4] > 0.0) values[3] / values[4] else 0.0,
+            bytesPerTrack = if (built > 0) values[5] / built else 0.0
+        )
+    }
+    
+    /**
+     * Header-only metadata for a library scan: exact sample rate, bit depth,
+     * channels and duration plus the common tags, read from the first few KB
+     * of each file on a few native threads. Entries are null for files the
+     * parser does not handle (OGG, WMA, AMR...) - fall back to the platform
+     * retriever for those.
+     */
+    suspend fun readTrackMetadata(filePaths: List<String>): List<TrackMetadata?> = withContext(Dispatchers.IO) {
+        if (filePaths.isEmpty() || !nativeLibraryLoaded) {
+            return@withContext List(filePaths.size) { null }
+        }
+        val numbers = LongArray(filePaths.size * METADATA_NUMBERS_PER_TRACK)
+        val strings = nativeReadTrackMetadata(filePaths.toTypedArray(), 0, numbers)
+            ?: return@withContext List(filePaths.size) { null }
+        List(filePaths.size) { i ->
+            val n = i * METADATA_NUMBERS_PER_TRACK
+            val s = i * METADATA_STRINGS_PER_TRACK
+            if (numbers[n] == 0L) {
+                null
+            } else {
+                TrackMetadata(
+                    codec = strings[s] ?: "",
+                    sampleRate = numbers[n + 1].toInt(),
+                    channels = numbers[n + 2].toInt(),
+                    bitsPerSample = numbers[n + 3].toInt(),
+                    totalFrames = numbers[n + 4],
+                    durationMs = numbers[n + 5],
+                    bitRate = numbers[n + 6].toInt(),
+                    title = strings[s + 1],
+                    artist = strings[s + 2],
+                    album = strings[s + 3],
+                    year = numbers[n + 7].toInt(),
+                    trackNumber = numbers[n + 8].toInt()
+                )
+            }
+        }
+    }
+    
+    /**
+     * Waveform overview of a track, one column per pixel: whole track by default,
+     * or the [startMs, endMs) window when zoomed. Served from the mapped sidecar
+     * (built on first request), so any zoom costs a few bins per column.
+     */
+    suspend fun getWaveform(
+        filePath: String,
+        columns: Int,
+        startMs: Long = 0L,
+        endMs: Long = -1L
+    ): WaveformOverview? = withContext(Dispatchers.IO) {
+        val bytes = nativeGetWaveform(filePath, waveformDir.absolutePath, startMs, endMs, columns)
+            ?: return@withContext null
+        val count = bytes.size / 3
+        WaveformOverview(
+            min = FloatArray(count) { bytes[it * 3] / 127f },
+            max = FloatArray(count) { bytes[it * 3 + 1] / 127f },
+            rms = FloatArray(count) { (bytes[it * 3 + 2].toInt() and 0xFF) / 255f }
+        )
+    }
+    
+    /**
+     * Sample-accurate seek, in order with start/stop and source changes. Returns
+     * once the decoder has it; the old audio is flushed and the new position is
+     * audible within a few bursts.
+     */
+    suspend fun seekTo(positionMs: Long): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        val sampleRate = readSnapshot()?.sampleRate ?: return false
+        if (sampleRate <= 0) return false
+        return runCommand(CONTROL_SEEK, positionMs.coerceAtLeast(0L) * sampleRate / 1000L)
+    }
+    
+    /**
+     * Position currently audible at the speaker, in milliseconds
+     * Uses the AAudio presentation timestamp; prefer [readSnapshot] at display rate.
+     */
+    fun getPlayheadPositionMs(): Long {
+        if (nativeEngineHandle == 0L) return 0L
+        val frame = nativeGetPlayheadFrame(nativeEngineHandle)
+        val sampleRate = readSnapshot()?.sampleRate ?: return 0L
+        return if (frame >= 0 && sampleRate > 0) frame * 1000L / sampleRate else 0L
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // MIXER VOICES
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Play a file on a mixer voice over the current track, in the same stream
+     * Any sample rate; the engine resamples. Use for crossfade-in, previews
+     * and workout prompts.
+     * 
+     * @return Voice id, or null if the file can't be opened or all voices are busy
+     */
+    fun playVoice(filePath: String, gain: Float = 1.0f, fadeInMs: Int = 0): Int? {
+        if (nativeEngineHandle == 0L) return null
+        val voiceId = nativePlayVoice(nativeEngineHandle, filePath, gain, fadeInMs.coerceAtLeast(0))
+        return voiceId.takeIf { it >= 0 }
+    }
+    
+    fun setVoiceGain(voiceId: Int, gain: Float, rampMs: Int = 0): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetVoiceGain(nativeEngineHandle, voiceId, gain, rampMs.coerceAtLeast(0))
+    }
+    
+    fun stopVoice(voiceId: Int, fadeOutMs: Int = 0): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeStopVoice(nativeEngineHandle, voiceId, fadeOutMs.coerceAtLeast(0))
+    }
+    
+    /**
+     * Gain of the main track, ramped in the audio callback
+     * Crossfade: ramp this to 0 while a voice fades the next track in; duck
+     * it under prompts.
+     */
+    fun setProgramGain(gain: Float, rampMs: Int = 0): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetProgramGain(nativeEngineHandle, gain.coerceAtLeast(0f), rampMs.coerceAtLeast(0))
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // LOUDNESS
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Per-track EBU R128 normalization toward [targetLufs]
+     * Uses [setTrackLoudness] when the track has loudness metadata, otherwise
+     * measures the track as it plays (settles after ~2 s).
+     */
+    fun setLoudnessNormalization(enabled: Boolean, targetLufs: Float = DEFAULT_LOUDNESS_TARGET_LUFS): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetLoudnessNormalization(nativeEngineHandle, enabled, targetLufs)
+    }
+    
+    /**
+     * Integrated loudness of the current track from its metadata (e.g. an
+     * R128 or ReplayGain tag). Call after each [setAudioSource].
+     */
+    fun setTrackLoudness(integratedLufs: Float): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetTrackLoudness(nativeEngineHandle, integratedLufs)
+    }
+    
+    /**
+     * 4x-oversampled lookahead limiter at the end of the chain (adds ~1.6 ms)
+     */
+    fun setTruePeakLimiter(enabled: Boolean, ceilingDb: Float = DEFAULT_TRUE_PEAK_CEILING_DB): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetTruePeakLimiter(nativeEngineHandle, enabled, ceilingDb)
+    }
+    
+    /** Loudness of the current track measured so far, or null before the meter has any */
+    fun getIntegratedLoudness(): Float? {
+        if (nativeEngineHandle == 0L) return null
+        val lufs = nativeGetIntegratedLoudness(nativeEngineHandle)
+        return if (lufs > NO_LOUDNESS_LUFS) lufs else null
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // TEMPO & PITCH
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Playback tempo for matching a workout's BPM: [MIN_TEMPO] .. [MAX_TEMPO]
+     * source seconds per second, pitch unchanged. Heard within ~25 ms; the
+     * playhead and source-clock automation follow the source.
+     */
+    fun setTempo(tempo: Double): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetTempo(nativeEngineHandle, tempo)
+    }
+    
+    /** Pitch shift in semitones (+-[MAX_PITCH_SHIFT_SEMITONES]), tempo unchanged */
+    fun setPitchShift(semitones: Double): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetPitchShift(nativeEngineHandle, semitones)
+    }
+    
+    /**
+     * [STRETCH_MODE_MUSIC] (phase vocoder) or [STRETCH_MODE_SPEECH] (WSOLA,
+     * for podcasts and audiobooks); applies from the next track or seek
+     */
+    fun setStretchMode(mode: Int): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetStretchMode(nativeEngineHandle, mode)
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // EQUALIZER
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Curve for the in-engine EQ, in dB. Any length: gains are taken as
+     * log-spaced over 20 Hz .. 20 kHz (e.g. the 32-band suggestions of
+     * NeuralAudioProcessor), [EQ_BANDS] values map one per band; null is
+     * flat. Takes effect within a burst, also while playing.
+     */
+    fun setEqualizer(gainsDb: List<Float>?): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetEqualizer(nativeEngineHandle, gainsDb != null, gainsDb?.toFloatArray())
+    }
+    
+    /**
+     * Native adaptive EQ: a background thread analyzes the program and
+     * corrects the octave balance on top of the curve every 250 ms, with
+     * no JVM round trips. [strength] 0..1 scales the correction.
+     */
+    fun setAdaptiveEq(enabled: Boolean, strength: Float = DEFAULT_ADAPTIVE_EQ_STRENGTH): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetAdaptiveEq(nativeEngineHandle, enabled, strength)
+    }
+    
+    /** Band gains the EQ runs with now (curve + adaptive correction), or null */
+    fun getEqualizerGains(): List<Float>? {
+        if (nativeEngineHandle == 0L) return null
+        return nativeGetEqualizerGains(nativeEngineHandle)?.toList()
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // CHANNEL LAYOUT
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Fold-down matrix for sources with [inputChannels] channels (WAVE order:
+     * FL FR FC LFE BL BR SL SR), row-major [output][input]; null restores
+     * the ITU-R BS.775 default. Applies from the next decoded chunk.
+     */
+    fun setDownmixMatrix(inputChannels: Int, coefficients: FloatArray?): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetDownmixMatrix(nativeEngineHandle, inputChannels, coefficients)
+    }
+    
+    /**
+     * Headphone virtualizer: 5.1/7.1 sources on virtual speakers around the
+     * head, stereo sources with crossfeed. Stereo output only.
+     */
+    fun setHeadphoneVirtualizer(enabled: Boolean): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeSetHeadphoneVirtualizer(nativeEngineHandle, enabled)
+    }
+    
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // AUTOMATION (SLEEP / WORKOUT TIMERS)
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    
+    /**
+     * Schedule an event that the audio callback applies on its exact frame
+     * [AutomationClock.OUTPUT]: [timeMs] is a delay of played audio from now
+     * (stands still while paused). [AutomationClock.SOURCE]: [timeMs] is the
+     * track position, e.g. a cue point.
+     * 
+     * @return Event id for [cancelAutomation], or null if the timeline is full
+     */
+    fun scheduleAutomation(
+        action: AutomationAction,
+        timeMs: Long,
+        clock: AutomationClock = AutomationClock.OUTPUT,
+        value: Float = 0f,
+        rampMs: Int = 0,
+        voiceId: Int = -1
+    ): Long? {
+        if (nativeEngineHandle == 0L) return null
+        val eventId = nativeScheduleAutomation(
+            nativeEngineHandle,
+            action.code,
+            clock.code,
+            timeMs.coerceAtLeast(0L),
+            voiceId,
+            value.coerceAtLeast(0f),
+            rampMs.coerceAtLeast(0)
+        )
+        return if (eventId > 0L) eventId else null
+    }
+    
+    /**
+     * Sleep timer: fade the program out over [fadeMs], ending [delayMs] from
+     * now, then pause. Both events land on exact frames. Restore the gain
+     * with [setProgramGain] before resuming.
+     * 
+     * @return Event ids (fade, pause), or null if either couldn't be scheduled
+     */
+    fun scheduleSleepTimer(delayMs: Long, fadeMs: Int): List<Long>? {
+        val fadeStartMs = (delayMs - fadeMs).coerceAtLeast(0L)
+        val fade = scheduleAutomation(AutomationAction.PROGRAM_GAIN, fadeStartMs, value = 0f, rampMs = fadeMs)
+            ?: return null
+        val pause = scheduleAutomation(AutomationAction.PAUSE, delayMs)
+        if (pause == null) {
+            cancelAutomation(fade)
+            return null
+        }
+        return listOf(fade, pause)
+    }
+    
+    fun cancelAutomation(eventId: Long): Boolean {
+        if (nativeEngineHandle == 0L) return false
+        return nativeCancelAutomation(nativeEngineHandle, eventId)
+    }
+    
+    fun clearAutomation() {
+        if (nativeEngineHandle == 0L) return
+        nativeClearAutomation(nativeEngineHandle)
+    }
+    
     // ═══════════════════════════════════════════════════════════════════════════════════
     // AUDIO DATA PROCESSING
     // ═══════════════════════════════════════════════════════════════════════════════════
@@ -330,9 +823,17 @@ class AudioEngine @Inject constructor(
     
     /**
      * Get current performance metrics
+     * Served from the shared snapshot when available (no JNI transition)
      */
     suspend fun getPerformanceMetrics(): PerformanceMetrics {
-        val metrics = if (nativeEngineHandle != 0L) {
+        val quality = lastQualityReport
+        val metrics = readSnapshot()?.metrics?.let { snapshot ->
+            if (quality != null) {
+                snapshot.copy(thdPlusN = quality.thdPlusNPercent, signalToNoiseRatio = quality.snrDb)
+            } else {
+                snapshot
+            }
+        } ?: if (nativeEngineHandle != 0L) {
             nativeGetPerformanceMetrics(nativeEngineHandle)
         } else {
             PerformanceMetrics()
@@ -342,19 +843,88 @@ class AudioEngine @Inject constructor(
         return metrics
     }
     
+    /**
+     * Read the latest native snapshot (state, playhead, peaks, latency, metrics)
+     * Safe to call at display rate from any thread - plain memory reads only
+     */
+    fun readSnapshot(): EngineSnapshot? = snapshotReader?.read()
+    
+    /**
+     * Render test tones, an IMD pair, a multitone and a sweep through the
+     * current chain offline and measure THD+N, SNR, IMD and frequency
+     * response. Takes tens of milliseconds; playback is not interrupted.
+     * Fills [PerformanceMetrics.thdPlusN] and [PerformanceMetrics.signalToNoiseRatio].
+     */
+    suspend fun measureAudioQuality(): AudioQualityReport? = withContext(Dispatchers.Default) {
+        if (nativeEngineHandle == 0L) return@withContext null
+        val values = nativeMeasureQuality(nativeEngineHandle, context.cacheDir.absolutePath)
+            ?: return@withContext null
+        AudioQualityReport(
+            thdPlusNPercent = values[0],
+            thdPlusNDb = values[1],
+            snrDb = values[2],
+            lowLevelThdPlusNDb = values[3],
+            imdPercent = values[4],
+            multitoneDistortionDb = values[5],
+            responseMinDb = values[6],
+            responseMaxDb = values[7],
+            elapsedMs = values[8]
+        ).also { lastQualityReport = it }
+    }
+    
+    /**
+     * Start recording callback, decode, DSP and JNI events into the
+     * in-process flight recorder (process-wide, independent of the engine)
+     */
+    fun startTrace(): Boolean = nativeStartTrace()
+    
+    fun stopTrace() = nativeStopTrace()
+    
+    /**
+     * Write the capture as Chrome trace-event JSON; open it in ui.perfetto.dev
+     */
+    suspend fun dumpTrace(file: File): Boolean = withContext(Dispatchers.IO) {
+        nativeDumpTrace(file.absolutePath)
+    }
+    
     // ═══════════════════════════════════════════════════════════════════════════════════
     // CONFIGURATION
     // ═══════════════════════════════════════════════════════════════════════════════════
     
     /**
-     * Update audio engine configuration
+     * Switch to the deep-buffer stream when the screen turns off and back when
+     * it turns on. Playback carries on without a gap; while playing this waits
+     * for the old stream to drain (a few hundred milliseconds).
+     */
+    suspend fun setPowerSaving(enabled: Boolean): Boolean =
+        nativeEngineHandle != 0L && runCommand(CONTROL_SET_OUTPUT_MODE, if (enabled) 1L else 0L)
+    
+    /**
+     * Callback rate and CPU time spent in one output mode since initialize
+     */
+    fun getOutputModeActivity(powerSaving: Boolean): OutputModeActivity? {
+        if (nativeEngineHandle == 0L) return null
+        val values = nativeGetOutputModeActivity(nativeEngineHandle, powerSaving) ?: return null
+        return OutputModeActivity(
+            callbacks = values[0].toLong(),
+            audioSeconds = values[1],
+            callbackCpuMs = values[2],
+            decodeCpuMs = values[3],
+            decodeWakeups = values[4].toLong(),
+            callbacksPerSecond = values[5],
+            cpuMsPerAudioMinute = values[6]
+        )
+    }
+    
+    /**
+     * Update audio engine configuration while stopped or paused
+     * Runs on the control thread, in order with start/stop. Only the latency,
+     * resolution, DSP and thread settings change; the rate and buffer sizes
+     * stay as initialized.
      */
     suspend fun updateConfiguration(config: AudioEngineConfiguration): Boolean {
-        return if (nativeEngineHandle != 0L) {
-            nativeUpdateConfiguration(nativeEngineHandle, config)
-        } else {
-            false
-        }
+        if (nativeEngineHandle == 0L) return false
+        return awaitCommand(nativePostConfiguration(nativeEngineHandle, config), "configure")
     }
     
     // ═══════════════════════════════════════════════════════════════════════════════════
@@ -366,6 +936,8 @@ class AudioEngine @Inject constructor(
      */
     suspend fun shutdown() {
         if (nativeEngineHandle != 0L) {
+            // Buffer aliases native memory - drop it before the engine is freed
+            snapshotReader = null
             nativeShutdownEngine(nativeEngineHandle)
             nativeEngineHandle = 0L
         }
@@ -396,28 +968,17 @@ class AudioEngine @Inject constructor(
         framesPerBurst: Int,
         channelCount: Int,
         format: Int,
-        deviceId: Int
+        deviceId: Int,
+        prewarmStream: Boolean,
+        burstPrefetch: Boolean
     ): Long
     
     /**
-     * Start playback on native engine
+     * Playback commands, run in order on the native control thread
+     * nativeAwaitCommand returns the EngineResult, or Int.MIN_VALUE while pending
      */
-    private external fun nativeStartPlayback(engineHandle: Long): Boolean
-    
-    /**
-     * Stop playback on native engine
-     */
-    private external fun nativeStopPlayback(engineHandle: Long): Boolean
-    
-    /**
-     * Pause playback on native engine
-     */
-    private external fun nativePausePlayback(engineHandle: Long): Boolean
-    
-    /**
-     * Resume playback on native engine
-     */
-    private external fun nativeResumePlayback(engineHandle: Long): Boolean
+    private external fun nativePostCommand(engineHandle: Long, action: Int, argument: Long): Long
+    private external fun nativeAwaitCommand(engineHandle: Long, token: Long, timeoutMs: Int): Int
     
     /**
      * Process audio buffer through native engine
@@ -441,12 +1002,157 @@ class AudioEngine @Inject constructor(
     private external fun nativeGetPerformanceMetrics(engineHandle: Long): PerformanceMetrics
     
     /**
-     * Update native engine configuration
+     * Get the native snapshot as a direct ByteBuffer (valid until shutdown)
+     */
+    private external fun nativeGetSnapshotBuffer(engineHandle: Long): java.nio.ByteBuffer?
+    
+    /**
+     * Native EngineState (see FTLAudioEngine.h)
+     */
+    private external fun nativeGetEngineState(engineHandle: Long): Int
+    
+    /**
+     * Post a file as the native engine's source
+     * @return Token for nativeAwaitCommand, or 0 if it couldn't be posted
+     */
+    private external fun nativePostAudioSource(engineHandle: Long, filePath: String): Long
+    
+    /**
+     * Set the sidecar seek-index cache directory
+     */
+    private external fun nativeSetSeekIndexDirectory(engineHandle: Long, directory: String)
+    
+    /**
+     * Build a sidecar seek index (blocking)
+     */
+    private external fun nativeBuildSeekIndex(filePath: String, directory: String): Boolean
+    
+    /**
+     * Queue the next track for prefetch
+     */
+    private external fun nativePrefetchNextSource(engineHandle: Long, filePath: String): Boolean
+    
+    /**
+     * Build waveform sidecars (blocking): [built, skipped, failed, audioSeconds, buildSeconds, bytes]
+     */
+    private external fun nativeBuildWaveforms(filePaths: Array<String>, directory: String): DoubleArray?
+    
+    /**
+     * Parse track headers (blocking): returns [codec, title, artist, album] per track
+     * and fills numbers with [parsed, sampleRate, channels, bitsPerSample,
+     * totalFrames, durationMs, bitRate, year, trackNumber] per track
+     */
+    private external fun nativeReadTrackMetadata(
+        filePaths: Array<String>,
+        threads: Int,
+        numbers: LongArray
+    ): Array<String?>?
+    
+    /**
+     * Render a waveform overview: columns x (min, max, rms) bytes
+     */
+    private external fun nativeGetWaveform(
+        filePath: String,
+        directory: String,
+        startMs: Long,
+        endMs: Long,
+        columns: Int
+    ): ByteArray?
+    
+    /**
+     * Source frame audible at the speaker (-1 on invalid handle)
+     */
+    private external fun nativeGetPlayheadFrame(engineHandle: Long): Long
+    
+    /**
+     * Start a mixer voice (-1 on failure)
+     */
+    private external fun nativePlayVoice(engineHandle: Long, filePath: String, gain: Float, fadeInMs: Int): Int
+    
+    /**
+     * Ramp a mixer voice's gain
+     */
+    private external fun nativeSetVoiceGain(engineHandle: Long, voiceId: Int, gain: Float, rampMs: Int): Boolean
+    
+    /**
+     * Fade out and release a mixer voice
+     */
+    private external fun nativeStopVoice(engineHandle: Long, voiceId: Int, fadeOutMs: Int): Boolean
+    
+    /**
+     * Ramp the main program's gain
+     */
+    private external fun nativeSetProgramGain(engineHandle: Long, gain: Float, rampMs: Int): Boolean
+    
+    /**
+     * Loudness normalization, track metadata and true-peak limiter
+     */
+    private external fun nativeSetLoudnessNormalization(engineHandle: Long, enabled: Boolean, targetLufs: Float): Boolean
+    private external fun nativeSetTrackLoudness(engineHandle: Long, integratedLufs: Float): Boolean
+    private external fun nativeSetTruePeakLimiter(engineHandle: Long, enabled: Boolean, ceilingDb: Float): Boolean
+    private external fun nativeGetIntegratedLoudness(engineHandle: Long): Float
+    
+    /**
+     * Tempo, pitch and time-stretch mode
+     */
+    private external fun nativeSetTempo(engineHandle: Long, tempo: Double): Boolean
+    private external fun nativeSetPitchShift(engineHandle: Long, semitones: Double): Boolean
+    private external fun nativeSetStretchMode(engineHandle: Long, mode: Int): Boolean
+    
+    /**
+     * In-engine EQ and its adaptive controller
+     */
+    private external fun nativeSetEqualizer(engineHandle: Long, enabled: Boolean, gainsDb: FloatArray?): Boolean
+    private external fun nativeSetAdaptiveEq(engineHandle: Long, enabled: Boolean, strength: Float): Boolean
+    private external fun nativeGetEqualizerGains(engineHandle: Long): FloatArray?
+    
+    /**
+     * Offline quality measurement of the current chain
+     */
+    private external fun nativeMeasureQuality(engineHandle: Long, scratchDirectory: String): DoubleArray?
+    
+    /**
+     * Multichannel fold-down and headphone virtualizer
+     */
+    private external fun nativeSetDownmixMatrix(engineHandle: Long, inputChannels: Int, coefficients: FloatArray?): Boolean
+    private external fun nativeSetHeadphoneVirtualizer(engineHandle: Long, enabled: Boolean): Boolean
+    
+    /**
+     * Schedule a sample-accurate automation event
      */
-    private external fun nativeUpdateConfiguration(
-        engineHandle: Long, 
-        config: AudioEngineConfiguration
-    ): Boolean
+    private external fun nativeScheduleAutomation(
+        engineHandle: Long,
+        action: Int,
+        clock: Int,
+        timeMs: Long,
+        voiceId: Int,
+        value: Float,
+        rampMs: Int
+    ): Long
+    
+    /**
+     * Cancel / clear scheduled automation events
+     */
+    private external fun nativeCancelAutomation(engineHandle: Long, eventId: Long): Boolean
+    private external fun nativeClearAutomation(engineHandle: Long)
+    
+    /**
+     * Process-wide trace recorder
+     */
+    private external fun nativeStartTrace(): Boolean
+    private external fun nativeStopTrace()
+    private external fun nativeDumpTrace(path: String): Boolean
+    
+    /**
+     * Low-latency / power-saving output stream
+     */
+    private external fun nativeGetOutputModeActivity(engineHandle: Long, powerSaving: Boolean): DoubleArray?
+    
+    /**
+     * Post new engine settings to the control thread
+     * @return Token for nativeAwaitCommand, or 0 if it couldn't be posted
+     */
+    private external fun nativePostConfiguration(engineHandle: Long, config: AudioEngineConfiguration): Long
     
     /**
      * Shutdown native audio engine
@@ -468,6 +1174,20 @@ enum class AudioEngineState {
     SHUTDOWN
 }
 
+/** Mirrors ftl_audio::AutomationAction */
+enum class AutomationAction(val code: Int) {
+    PROGRAM_GAIN(0),
+    VOICE_GAIN(1),
+    VOICE_STOP(2),
+    PAUSE(3)
+}
+
+/** Mirrors ftl_audio::AutomationClock */
+enum class AutomationClock(val code: Int) {
+    OUTPUT(0),
+    SOURCE(1)
+}
+
 data class AudioSpecs(
     val sampleRate: Int = 0,
     val bitDepth: Int = 0,
@@ -493,7 +1213,68 @@ data class PerformanceMetrics(
     val maxProcessingTimeUs: Double = 0.0,
     val callbackCount: Long = 0L,
     val missedCallbacks: Long = 0L,
-    val callbackLoad: Double = 0.0
+    val callbackLoad: Double = 0.0,
+    val thdPlusN: Double = 0.0,              // Percent, from measureAudioQuality()
+    val signalToNoiseRatio: Double = 0.0,    // dB
+    val streamRecoveries: Long = 0L,         // Reopens after device route changes
+    val lastRecoveryMs: Double = 0.0,        // Disconnect to first burst on the new device
+    val timeToFirstAudioMs: Double = 0.0     // Play request to first non-silent frame at the speaker
+)
+
+/** Chain quality: 1 kHz at -3 dBFS, SMPTE IMD, 31-tone multitone, log sweep */
+data class AudioQualityReport(
+    val thdPlusNPercent: Double,
+    val thdPlusNDb: Double,
+    val snrDb: Double,
+    val lowLevelThdPlusNDb: Double,          // 1 kHz at -60 dBFS
+    val imdPercent: Double,
+    val multitoneDistortionDb: Double,
+    val responseMinDb: Double,               // 20 Hz - 20 kHz, relative to 1 kHz
+    val responseMaxDb: Double,
+    val elapsedMs: Double
+)
+
+/** One column per pixel; peaks in -1..1, RMS in 0..1 */
+class WaveformOverview(
+    val min: FloatArray,
+    val max: FloatArray,
+    val rms: FloatArray
+) {
+    val columns: Int get() = min.size
+}
+
+data class WaveformBatchReport(
+    val built: Int = 0,
+    val skipped: Int = 0,                    // Sidecar already fresh
+    val failed: Int = 0,
+    val realtimeFactor: Double = 0.0,        // Audio seconds decoded per second of build time
+    val bytesPerTrack: Double = 0.0
+)
+
+/** One output mode's share of playback: wake-ups and CPU per minute of audio */
+data class OutputModeActivity(
+    val callbacks: Long,
+    val audioSeconds: Double,
+    val callbackCpuMs: Double,
+    val decodeCpuMs: Double,
+    val decodeWakeups: Long,
+    val callbacksPerSecond: Double,
+    val cpuMsPerAudioMinute: Double          // Callback and decode threads together
+)
+
+data class TrackMetadata(
+    val codec: String,                       // "wav", "flac", "dsf", "mp3", "aac", "alac"
+    val sampleRate: Int,
+    val channels: Int,
+    val bitsPerSample: Int,                  // 0 for lossy codecs, 1 for DSD
+    val totalFrames: Long,                   // -1 when the headers do not say
+    val durationMs: Long,
+    val bitRate: Int,
+    val title: String?,
+    val artist: String?,
+    val album: String?,
+    val year: Int,                           // 0 when untagged
+    val trackNumber: Int
 )
 
 data class AudioEngineConfiguration(
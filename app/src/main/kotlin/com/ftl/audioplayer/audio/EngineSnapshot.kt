@@ -0,0 +1,191 @@
+package com.ftl.audioplayer.audio
+
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - SHARED SNAPSHOT              ║
+ * ║          Lock-Free Metrics Reader (No JNI Per Poll)         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Mirrors the native EngineSnapshot layout (audio_engine/EngineSnapshot.h).
+ * The native side publishes with a seqlock; this reader retries until it
+ * observes the same even sequence number before and after copying.
+ */
+
+import android.os.Build
+import java.lang.invoke.VarHandle
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Immutable copy of one published native snapshot
+ */
+data class EngineSnapshot(
+    val sequence: Int = 0,
+    val engineState: Int = 0,
+    val sampleRate: Int = 0,
+    val channelCount: Int = 0,
+    val framesPerBurst: Int = 0,
+    val playheadFrame: Long = 0L,
+    val framesRendered: Long = 0L,
+    val metrics: PerformanceMetrics = PerformanceMetrics(),
+    val totalLatencyMs: Double = 0.0,
+    val outputLatencyMs: Double = 0.0,
+    val publishTimeNs: Long = 0L,
+    val peakLevels: FloatArray = FloatArray(0)
+) {
+    /** Playhead position in milliseconds at the engine's output rate */
+    val playheadMs: Long
+        get() = if (sampleRate > 0) playheadFrame * 1000L / sampleRate else 0L
+
+    override fun equals(other: Any?): Boolean =
+        other is EngineSnapshot && other.sequence == sequence && other.publishTimeNs == publishTimeNs
+
+    override fun hashCode(): Int = 31 * sequence + publishTimeNs.hashCode()
+}
+
+/**
+ * LoadLoad fence for the seqlock: ByteBuffer reads are plain loads, which
+ * ARM may reorder
+ */
+fun interface ReadFence {
+    fun acquire()
+
+    companion object {
+        /** For readers that never race a writer (e.g. a test filling the buffer itself) */
+        val NONE = ReadFence {}
+
+        /** VarHandle fences need API 33; before that the native side issues the fence (one cheap JNI call) */
+        fun forPlatform(): ReadFence =
+            if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) VarHandleReadFence else NativeReadFence
+    }
+}
+
+private object VarHandleReadFence : ReadFence {
+    override fun acquire() = VarHandle.acquireFence()
+}
+
+private object NativeReadFence : ReadFence {
+    override fun acquire() = nativeAcquireFence()
+
+    private external fun nativeAcquireFence()
+}
+
+/**
+ * Reads the native snapshot from a direct ByteBuffer without crossing JNI.
+ *
+ * The buffer aliases engine memory: drop the reader before the engine is
+ * shut down. Reads are plain memory loads fenced against the sequence
+ * loads; the sequence check rejects torn copies, and a bounded retry
+ * keeps the UI thread from spinning. Safe to call from any thread.
+ */
+class EngineSnapshotReader(
+    buffer: ByteBuffer,
+    private val fence: ReadFence = ReadFence.forPlatform()
+) {
+
+    companion object {
+        const val LAYOUT_VERSION = 2
+        private const val MAX_READ_ATTEMPTS = 8
+        private const val MAX_CHANNELS = 8
+
+        // Byte offsets - must match EngineSnapshot.h
+        private const val OFFSET_SEQUENCE = 0
+        private const val OFFSET_LAYOUT_VERSION = 4
+        private const val OFFSET_DATA = 8
+        private const val OFFSET_ENGINE_STATE = OFFSET_DATA + 0
+        private const val OFFSET_SAMPLE_RATE = OFFSET_DATA + 4
+        private const val OFFSET_CHANNEL_COUNT = OFFSET_DATA + 8
+        private const val OFFSET_FRAMES_PER_BURST = OFFSET_DATA + 12
+        private const val OFFSET_PLAYHEAD_FRAME = OFFSET_DATA + 16
+        private const val OFFSET_FRAMES_RENDERED = OFFSET_DATA + 24
+        private const val OFFSET_CALLBACK_COUNT = OFFSET_DATA + 32
+        private const val OFFSET_MISSED_CALLBACKS = OFFSET_DATA + 40
+        private const val OFFSET_BUFFER_UNDERRUNS = OFFSET_DATA + 48
+        private const val OFFSET_BUFFER_OVERRUNS = OFFSET_DATA + 56
+        private const val OFFSET_AVG_PROCESSING_US = OFFSET_DATA + 64
+        private const val OFFSET_MAX_PROCESSING_US = OFFSET_DATA + 72
+        private const val OFFSET_CALLBACK_LOAD = OFFSET_DATA + 80
+        private const val OFFSET_CPU_USAGE = OFFSET_DATA + 88
+        private const val OFFSET_MEMORY_USAGE = OFFSET_DATA + 96
+        private const val OFFSET_TOTAL_LATENCY_MS = OFFSET_DATA + 104
+        private const val OFFSET_OUTPUT_LATENCY_MS = OFFSET_DATA + 112
+        private const val OFFSET_PUBLISH_TIME_NS = OFFSET_DATA + 120
+        private const val OFFSET_PEAK_LEVELS = OFFSET_DATA + 128
+        private const val OFFSET_STREAM_RECOVERIES = OFFSET_DATA + 160
+        private const val OFFSET_LAST_RECOVERY_MS = OFFSET_DATA + 168
+        private const val OFFSET_TIME_TO_FIRST_AUDIO_MS = OFFSET_DATA + 176
+        private const val PAYLOAD_END = OFFSET_DATA + 184
+    }
+
+    private val buffer: ByteBuffer = buffer.duplicate().order(ByteOrder.nativeOrder())
+
+    /** True when the native layout matches what this reader was built for */
+    val isCompatible: Boolean
+        get() = buffer.capacity() >= PAYLOAD_END &&
+                buffer.getInt(OFFSET_LAYOUT_VERSION) == LAYOUT_VERSION
+
+    // Shared by every reading thread; snapshots are immutable, so publishing the reference is enough
+    @Volatile
+    private var lastSnapshot: EngineSnapshot? = null
+
+    /**
+     * Read a consistent snapshot, or the previous one if the writer kept
+     * the seqlock busy for every attempt (returns null only before the
+     * first successful read)
+     */
+    fun read(): EngineSnapshot? {
+        if (!isCompatible) return null
+
+        repeat(MAX_READ_ATTEMPTS) {
+            val before = buffer.getInt(OFFSET_SEQUENCE)
+            if (before and 1 != 0) return@repeat
+            fence.acquire()     // Payload loads stay after the first sequence load
+
+            // Fast path: nothing new since the last poll
+            lastSnapshot?.let { if (it.sequence == before) return it }
+
+            val snapshot = copyPayload(before)
+            fence.acquire()     // ... and before the second, or a torn copy could pass the check
+            if (buffer.getInt(OFFSET_SEQUENCE) == before) {
+                lastSnapshot = snapshot
+                return snapshot
+            }
+        }
+        return lastSnapshot
+    }
+
+    private fun copyPayload(sequence: Int): EngineSnapshot {
+        val channelCount = buffer.getInt(OFFSET_CHANNEL_COUNT).coerceIn(0, MAX_CHANNELS)
+        val peaks = FloatArray(channelCount) { ch -> buffer.getFloat(OFFSET_PEAK_LEVELS + ch * 4) }
+
+        return EngineSnapshot(
+            sequence = sequence,
+            engineState = buffer.getInt(OFFSET_ENGINE_STATE),
+            sampleRate = buffer.getInt(OFFSET_SAMPLE_RATE),
+            channelCount = channelCount,
+            framesPerBurst = buffer.getInt(OFFSET_FRAMES_PER_BURST),
+            playheadFrame = buffer.getLong(OFFSET_PLAYHEAD_FRAME),
+            framesRendered = buffer.getLong(OFFSET_FRAMES_RENDERED),
+            metrics = PerformanceMetrics(
+                cpuUsagePercent = buffer.getDouble(OFFSET_CPU_USAGE),
+                memoryUsageMB = buffer.getDouble(OFFSET_MEMORY_USAGE),
+                bufferUnderruns = buffer.getLong(OFFSET_BUFFER_UNDERRUNS),
+                bufferOverruns = buffer.getLong(OFFSET_BUFFER_OVERRUNS),
+                averageProcessingTimeUs = buffer.getDouble(OFFSET_AVG_PROCESSING_US),
+                maxProcessingTimeUs = buffer.getDouble(OFFSET_MAX_PROCESSING_US),
+                callbackCount = buffer.getLong(OFFSET_CALLBACK_COUNT),
+                missedCallbacks = buffer.getLong(OFFSET_MISSED_CALLBACKS),
+                callbackLoad = buffer.getDouble(OFFSET_CALLBACK_LOAD),
+                streamRecoveries = buffer.getLong(OFFSET_STREAM_RECOVERIES),
+                lastRecoveryMs = buffer.getDouble(OFFSET_LAST_RECOVERY_MS),
+                timeToFirstAudioMs = buffer.getDouble(OFFSET_TIME_TO_FIRST_AUDIO_MS)
+            ),
+            totalLatencyMs = buffer.getDouble(OFFSET_TOTAL_LATENCY_MS),
+            outputLatencyMs = buffer.getDouble(OFFSET_OUTPUT_LATENCY_MS),
+            publishTimeNs = buffer.getLong(OFFSET_PUBLISH_TIME_NS),
+            peakLevels = peaks
+        )
+    }
+}
@@ -2,6 +2,7 @@ package com.ftl.audioplayer.data.dao
 
 import androidx.room.*
 import com.ftl.audioplayer.data.entities.Track
+import com.ftl.audioplayer.data.search.TrackSearchEntry
 import kotlinx.coroutines.flow.Flow
 
 @Dao
@@ -19,6 +20,15 @@ interface TrackDao {
     @Query("SELECT * FROM tracks WHERE artist LIKE '%' || :query || '%' OR title LIKE '%' || :query || '%' OR album LIKE '%' || :query || '%'")
     fun searchTracks(query: String): Flow<List<Track>>
     
+    @Query("SELECT * FROM tracks WHERE id IN (:ids)")
+    fun getTracksByIds(ids: List<Long>): Flow<List<Track>>
+    
+    @Query("SELECT id, title, artist, album FROM tracks")
+    suspend fun getSearchEntries(): List<TrackSearchEntry>
+    
+    @Query("SELECT * FROM tracks")
+    suspend fun getAllTracksOnce(): List<Track>
+    
     @Query("SELECT DISTINCT artist FROM tracks WHERE artist != '' ORDER BY artist ASC")
     fun getAllArtists(): Flow<List<String>>
     
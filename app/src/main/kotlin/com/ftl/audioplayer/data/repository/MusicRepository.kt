@@ -6,14 +6,27 @@ import android.database.Cursor
 import android.media.MediaMetadataRetriever
 import android.net.Uri
 import android.provider.MediaStore
+import android.os.SystemClock
 import android.util.Log
+import com.ftl.audioplayer.audio.AudioEngine
+import com.ftl.audioplayer.audio.TrackMetadata
 import com.ftl.audioplayer.data.dao.PlaylistDao
 import com.ftl.audioplayer.data.dao.TrackDao
 import com.ftl.audioplayer.data.entities.Playlist
 import com.ftl.audioplayer.data.entities.PlaylistTrack
 import com.ftl.audioplayer.data.entities.Track
+import com.ftl.audioplayer.data.search.NativeSearchIndex
+import com.ftl.audioplayer.data.search.TrackSearchEntry
+import com.ftl.audioplayer.data.snapshot.LibrarySnapshotRows
+import com.ftl.audioplayer.data.snapshot.NativeLibrarySnapshot
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.flow.flowOn
+import kotlinx.coroutines.flow.map
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
 import kotlinx.coroutines.withContext
 import java.io.File
 import javax.inject.Inject
@@ -23,11 +36,19 @@ import javax.inject.Singleton
 class MusicRepository @Inject constructor(
     private val trackDao: TrackDao,
     private val playlistDao: PlaylistDao,
-    private val context: Context
+    private val context: Context,
+    private val audioEngine: AudioEngine,
+    private val searchIndex: NativeSearchIndex,
+    private val librarySnapshot: NativeLibrarySnapshot
 ) {
     
+    // Guards loading the search index against scans and clears writing to it
+    private val searchIndexMutex = Mutex()
+    private var searchIndexLoaded = false
+    
     companion object {
         private const val TAG = "MusicRepository"
+        private const val SNAPSHOT_FILE = "library.ftlsnap"
         private val SUPPORTED_FORMATS = setOf(
             "audio/mpeg", "audio/mp4", "audio/x-flac", "audio/ogg",
             "audio/wav", "audio/x-wav", "audio/aac", "audio/x-aac",
@@ -46,7 +67,30 @@ class MusicRepository @Inject constructor(
     
     fun getHiResTracks(): Flow<List<Track>> = trackDao.getHiResTracks()
     
-    fun searchTracks(query: String): Flow<List<Track>> = trackDao.searchTracks(query)
+    /**
+     * The library as of the last scan, mapped from disk for the first frames
+     * after a cold start; Room's flows are the source of truth
+     * @return Null if there is no usable snapshot
+     */
+    suspend fun openLibrarySnapshot(): LibrarySnapshotRows? = withContext(Dispatchers.IO) {
+        librarySnapshot.open(File(context.cacheDir, SNAPSHOT_FILE))
+    }
+    
+    /**
+     * Tracks matching every word of the query, best match first. Served by
+     * the native index (loaded from the database on first use); without it,
+     * or for a blank query, by the SQL LIKE scan.
+     */
+    fun searchTracks(query: String): Flow<List<Track>> = flow {
+        val ids = if (query.isNotBlank() && ensureSearchIndex()) searchIndex.search(query) else null
+        if (ids == null) {
+            emitAll(trackDao.searchTracks(query))
+            return@flow
+        }
+        val rank = HashMap<Long, Int>(ids.size * 2)
+        ids.forEachIndexed { i, id -> rank[id] = i }
+        emitAll(trackDao.getTracksByIds(ids.toList()).map { tracks -> tracks.sortedBy { rank[it.id] } })
+    }.flowOn(Dispatchers.IO)
     
     suspend fun getTrackById(id: Long): Track? = trackDao.getTrackById(id)
     
@@ -85,18 +129,20 @@ class MusicRepository @Inject constructor(
     suspend fun scanMusicLibrary(): Int = withContext(Dispatchers.IO) {
         try {
             android.util.Log.i(TAG, "🚀 Starting music library scan...")
-            val tracks = discoverAudioFiles()
+            val tracks = applyStreamMetadata(discoverAudioFiles())
             android.util.Log.d(TAG, "📚 Processing ${tracks.size} discovered tracks...")
             
             // Process each track individually to handle duplicates
             var newTracks = 0
             var updatedTracks = 0
+            val searchEntries = ArrayList<TrackSearchEntry>(tracks.size)
             
             tracks.forEach { track ->
                 val existingTrack = trackDao.getTrackByPath(track.filePath)
                 if (existingTrack == null) {
                     // New track, insert it
-                    trackDao.insertTrack(track)
+                    val id = trackDao.insertTrack(track)
+                    searchEntries += TrackSearchEntry(id, track.title, track.artist, track.album)
                     newTracks++
                 } else {
                     // Track exists, update metadata if changed
@@ -116,10 +162,17 @@ class MusicRepository @Inject constructor(
                         trackNumber = track.trackNumber
                     )
                     trackDao.updateTrack(updatedTrack)
+                    searchEntries += TrackSearchEntry(existingTrack.id, track.title, track.artist, track.album)
                     updatedTracks++
                 }
             }
             
+            // Only scanned tracks change; an index not yet loaded picks them up from the table
+            searchIndexMutex.withLock {
+                if (searchIndexLoaded) searchIndex.upsert(searchEntries)
+            }
+            writeLibrarySnapshot()
+            
             android.util.Log.i(TAG, "✅ Scan complete: $newTracks new tracks added, $updatedTracks tracks updated")
             newTracks + updatedTracks
         } catch (e: Exception) {
@@ -131,7 +184,11 @@ class MusicRepository @Inject constructor(
     suspend fun clearMusicLibrary() = withContext(Dispatchers.IO) {
         try {
             android.util.Log.i(TAG, "🗑️ Clearing music library...")
-            trackDao.deleteAllTracks()
+            searchIndexMutex.withLock {
+                trackDao.deleteAllTracks()
+                searchIndex.clear()
+            }
+            File(context.cacheDir, SNAPSHOT_FILE).delete()
             android.util.Log.i(TAG, "✅ Music library cleared successfully")
         } catch (e: Exception) {
             android.util.Log.e(TAG, "💥 Error clearing music library", e)
@@ -139,6 +196,34 @@ class MusicRepository @Inject constructor(
         }
     }
     
+    private suspend fun writeLibrarySnapshot() {
+        val start = SystemClock.elapsedRealtime()
+        val tracks = trackDao.getAllTracksOnce()
+        if (librarySnapshot.write(File(context.cacheDir, SNAPSHOT_FILE), tracks)) {
+            Log.i(TAG, "Library snapshot: ${tracks.size} tracks in ${SystemClock.elapsedRealtime() - start} ms")
+        } else {
+            Log.w(TAG, "Library snapshot not written")
+        }
+    }
+    
+    /**
+     * Load the search index from the tracks table once per process
+     * @return False if native search is unavailable
+     */
+    private suspend fun ensureSearchIndex(): Boolean = searchIndexMutex.withLock {
+        if (!searchIndexLoaded && searchIndex.isAvailable) {
+            val start = SystemClock.elapsedRealtime()
+            val entries = trackDao.getSearchEntries()
+            searchIndex.clear()
+            searchIndex.upsert(entries)
+            searchIndexLoaded = true
+            val stats = searchIndex.getStats()
+            Log.i(TAG, "Search index: ${entries.size} tracks in ${SystemClock.elapsedRealtime() - start} ms" +
+                       (stats?.let { ", ${it.memoryBytes / 1024} KB" } ?: ""))
+        }
+        searchIndexLoaded
+    }
+    
     private fun discoverAudioFiles(): List<Track> {
         val tracks = mutableListOf<Track>()
         
@@ -224,8 +309,8 @@ class MusicRepository @Inject constructor(
             val trackNumber = cursor.getInt(cursor.getColumnIndexOrThrow(MediaStore.Audio.Media.TRACK))
             val dateAdded = cursor.getLong(cursor.getColumnIndexOrThrow(MediaStore.Audio.Media.DATE_ADDED)) * 1000 // Convert to milliseconds
             
-            // Get additional metadata using MediaMetadataRetriever
-            val (sampleRate, bitRate, channels, bitDepth, codec) = getAudioMetadata(filePath)
+            // Stream parameters are filled in per batch by applyStreamMetadata()
+            val (sampleRate, bitRate, channels, bitDepth, codec) = AudioMetadata.UNKNOWN
             
             Track(
                 title = title,
@@ -251,6 +336,60 @@ class MusicRepository @Inject constructor(
         }
     }
     
+    /**
+     * Fill in exact stream parameters from the native header parser, which
+     * reads only the first few KB of each file. MediaStore tags win where the
+     * provider has them; formats the parser does not handle fall back to
+     * MediaMetadataRetriever.
+     */
+    private suspend fun applyStreamMetadata(tracks: List<Track>): List<Track> {
+        val start = SystemClock.elapsedRealtime()
+        val parsed = audioEngine.readTrackMetadata(tracks.map { it.filePath })
+        var fallbacks = 0
+        val result = tracks.mapIndexed { i, track ->
+            val meta = parsed[i]
+            if (meta != null) {
+                track.withNativeMetadata(meta)
+            } else {
+                fallbacks++
+                val (sampleRate, bitRate, channels, bitDepth, codec) = getAudioMetadata(track.filePath)
+                track.copy(
+                    sampleRate = sampleRate,
+                    bitRate = bitRate,
+                    channels = channels,
+                    bitDepth = bitDepth,
+                    codec = codec,
+                    isHiRes = sampleRate > 48000 || bitDepth > 16
+                )
+            }
+        }
+        val seconds = (SystemClock.elapsedRealtime() - start) / 1000.0
+        if (tracks.isNotEmpty()) {
+            Log.i(TAG, "Stream metadata: ${tracks.size} tracks in ${"%.2f".format(seconds)} s " +
+                       "(${"%.0f".format(tracks.size / seconds.coerceAtLeast(0.001))} files/s, $fallbacks via retriever)")
+        }
+        return result
+    }
+    
+    private fun Track.withNativeMetadata(meta: TrackMetadata): Track {
+        val bitDepth = if (meta.bitsPerSample > 0) meta.bitsPerSample else 16
+        return copy(
+            title = if (title == "Unknown Title") meta.title ?: title else title,
+            artist = if (artist == "Unknown Artist") meta.artist ?: artist else artist,
+            album = if (album == "Unknown Album") meta.album ?: album else album,
+            duration = if (meta.durationMs > 0) meta.durationMs else duration,
+            sampleRate = meta.sampleRate,
+            bitRate = meta.bitRate,
+            channels = meta.channels,
+            bitDepth = bitDepth,
+            codec = meta.codec.uppercase(),
+            year = year ?: meta.year.takeIf { it > 0 },
+            trackNumber = trackNumber ?: meta.trackNumber.takeIf { it > 0 },
+            // DSD (1 bit at 2.8 MHz and up) is hi-res by rate
+            isHiRes = meta.sampleRate > 48000 || bitDepth > 16
+        )
+    }
+    
     private fun getAudioMetadata(filePath: String): AudioMetadata {
         var sampleRate = 44100
         var bitRate = 320000
@@ -320,5 +459,9 @@ class MusicRepository @Inject constructor(
         val channels: Int,
         val bitDepth: Int,
         val codec: String
-    )
+    ) {
+        companion object {
+            val UNKNOWN = AudioMetadata(44100, 320000, 2, 16, "unknown")
+        }
+    }
 }
\ No newline at end of file
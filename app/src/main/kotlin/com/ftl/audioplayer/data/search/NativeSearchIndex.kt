@@ -0,0 +1,138 @@
+package com.ftl.audioplayer.data.search
+
+import android.util.Log
+import javax.inject.Inject
+import javax.inject.Singleton
+
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                  NATIVE LIBRARY SEARCH INDEX                 ║
+ * ║       Prefix, Substring & Typo-Tolerant Search Per Keystroke ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * In-memory index over title, artist and album, kept in step with the
+ * tracks table by MusicRepository. Text is case and diacritic folded on
+ * both sides ("bjork" finds "Björk"), every query word must match a word
+ * start or (from three characters) anywhere inside one, and near misses
+ * ("beatels") are tried when exact matches are few. Results are track IDs,
+ * best first; Room loads the rows.
+ */
+@Singleton
+class NativeSearchIndex @Inject constructor() {
+
+    companion object {
+        private const val TAG = "NativeSearchIndex"
+
+        const val DEFAULT_LIMIT = 200
+
+        private val nativeLibraryLoaded: Boolean by lazy {
+            try {
+                System.loadLibrary("ftl_audio_engine")
+                true
+            } catch (e: UnsatisfiedLinkError) {
+                Log.e(TAG, "Native search unavailable: ${e.message}")
+                false
+            }
+        }
+    }
+
+    private var handle = 0L
+
+    /** False when the native library is missing; callers fall back to SQL */
+    val isAvailable: Boolean
+        @Synchronized get() {
+            if (handle == 0L && nativeLibraryLoaded) {
+                handle = nativeCreate()
+            }
+            return handle != 0L
+        }
+
+    /**
+     * Add or replace tracks by ID
+     */
+    fun upsert(entries: List<TrackSearchEntry>) {
+        if (entries.isEmpty() || !isAvailable) return
+        nativeUpsert(
+            handle,
+            LongArray(entries.size) { entries[it].id },
+            Array(entries.size) { entries[it].title },
+            Array(entries.size) { entries[it].artist },
+            Array(entries.size) { entries[it].album }
+        )
+    }
+
+    fun remove(trackIds: List<Long>): Int {
+        if (trackIds.isEmpty() || !isAvailable) return 0
+        return nativeRemove(handle, trackIds.toLongArray())
+    }
+
+    fun clear() {
+        if (isAvailable) nativeClear(handle)
+    }
+
+    /**
+     * @return Track IDs, best match first; null if the index is unavailable
+     */
+    fun search(query: String, limit: Int = DEFAULT_LIMIT): LongArray? {
+        if (!isAvailable) return null
+        return nativeSearch(handle, query, limit)
+    }
+
+    fun getStats(): SearchIndexStats? {
+        if (!isAvailable) return null
+        val values = nativeGetStats(handle) ?: return null
+        return SearchIndexStats(
+            tracks = values[0].toInt(),
+            words = values[1].toInt(),
+            trigrams = values[2].toInt(),
+            postingBytes = values[3],
+            memoryBytes = values[4]
+        )
+    }
+
+    @Synchronized
+    fun release() {
+        if (handle != 0L) {
+            nativeRelease(handle)
+            handle = 0L
+        }
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // NATIVE METHOD DECLARATIONS
+    // ═══════════════════════════════════════════════════════════════════════════════════
+
+    private external fun nativeCreate(): Long
+    private external fun nativeUpsert(
+        handle: Long,
+        trackIds: LongArray,
+        titles: Array<String>,
+        artists: Array<String>,
+        albums: Array<String>
+    ): Boolean
+    private external fun nativeRemove(handle: Long, trackIds: LongArray): Int
+    private external fun nativeClear(handle: Long)
+    private external fun nativeSearch(handle: Long, query: String, limit: Int): LongArray?
+    private external fun nativeGetStats(handle: Long): LongArray?
+    private external fun nativeRelease(handle: Long)
+}
+
+/**
+ * The searchable columns of a track (a Room projection of the tracks table)
+ */
+data class TrackSearchEntry(
+    val id: Long,
+    val title: String,
+    val artist: String,
+    val album: String
+)
+
+data class SearchIndexStats(
+    val tracks: Int,
+    val words: Int,
+    val trigrams: Int,
+    val postingBytes: Long,
+    val memoryBytes: Long
+)
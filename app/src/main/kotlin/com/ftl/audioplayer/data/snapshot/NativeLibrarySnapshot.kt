@@ -0,0 +1,237 @@
+package com.ftl.audioplayer.data.snapshot
+
+import android.util.Log
+import com.ftl.audioplayer.data.entities.Track
+import java.io.File
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import javax.inject.Inject
+import javax.inject.Singleton
+
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║                 NATIVE LIBRARY SNAPSHOT                      ║
+ * ║        Memory-Mapped Track Rows for Library Cold Start       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * A columnar copy of the tracks table (library/LibrarySnapshot.h), written
+ * by MusicRepository after each scan. At startup the file is mapped and
+ * read through a direct ByteBuffer: each view is a list whose rows are
+ * built only when the UI asks for them, so the first screen appears
+ * without waiting for Room. Room's rows replace it as soon as they load.
+ */
+@Singleton
+class NativeLibrarySnapshot @Inject constructor() {
+
+    companion object {
+        private const val TAG = "NativeLibrarySnapshot"
+
+        // Per-track layout of nativeWrite's arrays
+        private const val NUMBERS_PER_TRACK = 11
+        private const val STRINGS_PER_TRACK = 6
+
+        private val nativeLibraryLoaded: Boolean by lazy {
+            try {
+                System.loadLibrary("ftl_audio_engine")
+                true
+            } catch (e: UnsatisfiedLinkError) {
+                Log.e(TAG, "Native snapshot unavailable: ${e.message}")
+                false
+            }
+        }
+    }
+
+    private var openPath: String? = null
+    private var openModified = 0L
+    private var openRows: LibrarySnapshotRows? = null
+
+    /**
+     * Write the snapshot atomically (the old file stays readable until replaced)
+     */
+    fun write(file: File, tracks: List<Track>): Boolean {
+        if (!nativeLibraryLoaded) return false
+        val numbers = LongArray(tracks.size * NUMBERS_PER_TRACK)
+        val strings = arrayOfNulls<String>(tracks.size * STRINGS_PER_TRACK)
+        tracks.forEachIndexed { i, track ->
+            var n = i * NUMBERS_PER_TRACK
+            numbers[n++] = track.id
+            numbers[n++] = track.duration
+            numbers[n++] = track.fileSize
+            numbers[n++] = track.dateAdded
+            numbers[n++] = track.sampleRate.toLong()
+            numbers[n++] = track.bitRate.toLong()
+            numbers[n++] = track.channels.toLong()
+            numbers[n++] = track.bitDepth.toLong()
+            numbers[n++] = (track.year ?: 0).toLong()
+            numbers[n++] = (track.trackNumber ?: 0).toLong()
+            numbers[n] = (if (track.isHiRes) LibrarySnapshotRows.FLAG_HI_RES else 0L) or
+                         (if (track.isFavorite) LibrarySnapshotRows.FLAG_FAVORITE else 0L)
+            var s = i * STRINGS_PER_TRACK
+            strings[s++] = track.title
+            strings[s++] = track.artist
+            strings[s++] = track.album
+            strings[s++] = track.filePath
+            strings[s++] = track.mimeType
+            strings[s] = track.codec
+        }
+        return nativeWrite(file.absolutePath, numbers, strings, System.currentTimeMillis())
+    }
+
+    /**
+     * Map the snapshot; the same file is mapped once per process
+     * @return Null if missing, invalid or from another version
+     */
+    @Synchronized
+    fun open(file: File): LibrarySnapshotRows? {
+        if (!nativeLibraryLoaded || !file.exists()) return null
+        val path = file.absolutePath
+        val modified = file.lastModified()
+        if (openRows != null && openPath == path && openModified == modified) {
+            return openRows
+        }
+        val handle = nativeOpen(path)
+        if (handle == 0L) {
+            Log.w(TAG, "Snapshot not usable: $path")
+            return null
+        }
+        val buffer = nativeGetBuffer(handle) ?: return null
+        openPath = path
+        openModified = modified
+        openRows = LibrarySnapshotRows(buffer.asReadOnlyBuffer().order(ByteOrder.nativeOrder()))
+        return openRows
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════════════════
+    // NATIVE METHOD DECLARATIONS
+    // ═══════════════════════════════════════════════════════════════════════════════════
+
+    private external fun nativeWrite(
+        path: String,
+        numbers: LongArray,
+        strings: Array<String?>,
+        createdMs: Long
+    ): Boolean
+    private external fun nativeOpen(path: String): Long
+    private external fun nativeGetBuffer(handle: Long): ByteBuffer?
+}
+
+/** The snapshot's sort orders, in file order */
+enum class SnapshotOrder {
+    TITLE,          // Title
+    ARTIST,         // Artist, album, track number
+    ALBUM,          // Album, track number
+    SAMPLE_RATE     // Hi-res first, then sample rate and bit depth, highest first
+}
+
+/**
+ * Reader over a mapped snapshot. The native side has already validated
+ * the header and section bounds; row indices are checked here.
+ */
+class LibrarySnapshotRows internal constructor(private val buffer: ByteBuffer) {
+
+    companion object {
+        const val FLAG_HI_RES = 1L
+        const val FLAG_FAVORITE = 2L
+
+        // SnapshotHeader and SnapshotColumn
+        private const val HEADER_BYTES = 64
+        private const val ROW_COUNT_OFFSET = 12
+        private const val STRING_COUNT_OFFSET = 16
+        private const val HI_RES_COUNT_OFFSET = 20
+        private const val CREATED_MS_OFFSET = 32
+
+        private const val COLUMN_ID = 0
+        private const val COLUMN_DURATION_MS = 1
+        private const val COLUMN_FILE_SIZE = 2
+        private const val COLUMN_DATE_ADDED = 3
+        private const val COLUMN_SAMPLE_RATE = 4
+        private const val COLUMN_BIT_RATE = 5
+        private const val COLUMN_CHANNELS = 6
+        private const val COLUMN_BIT_DEPTH = 7
+        private const val COLUMN_YEAR = 8
+        private const val COLUMN_TRACK_NUMBER = 9
+        private const val COLUMN_FLAGS = 10
+        private const val COLUMN_TITLE = 11
+        private const val COLUMN_ARTIST = 12
+        private const val COLUMN_ALBUM = 13
+        private const val COLUMN_FILE_PATH = 14
+        private const val COLUMN_MIME_TYPE = 15
+        private const val COLUMN_CODEC = 16
+        private const val COLUMNS = 17
+
+        private const val ORDERS = 4
+        private const val SECTION_STRING_OFFSETS = COLUMNS + ORDERS
+        private const val SECTION_STRING_BYTES = SECTION_STRING_OFFSETS + 1
+    }
+
+    val rowCount: Int = buffer.getInt(ROW_COUNT_OFFSET)
+    val hiResCount: Int = buffer.getInt(HI_RES_COUNT_OFFSET)
+    val createdMs: Long = buffer.getLong(CREATED_MS_OFFSET)
+
+    private val sections = IntArray(SECTION_STRING_BYTES + 1) {
+        buffer.getLong(HEADER_BYTES + it * 8).toInt()
+    }
+
+    // Interned strings decode once, so a repeated artist is one String
+    private val strings = arrayOfNulls<String>(buffer.getInt(STRING_COUNT_OFFSET))
+
+    /** Every row in `order`; each Track is built on get() */
+    fun tracks(order: SnapshotOrder): List<Track> = rows(order, rowCount)
+
+    /** The hi-res rows, which lead the SAMPLE_RATE order */
+    fun hiResTracks(): List<Track> = rows(SnapshotOrder.SAMPLE_RATE, hiResCount)
+
+    private fun rows(order: SnapshotOrder, count: Int): List<Track> {
+        val orderSection = sections[COLUMNS + order.ordinal]
+        return object : AbstractList<Track>() {
+            override val size = count
+            override fun get(index: Int): Track {
+                if (index < 0 || index >= count) throw IndexOutOfBoundsException("Row $index of $count")
+                return track(buffer.getInt(orderSection + index * 4))
+            }
+        }
+    }
+
+    private fun wide(column: Int, row: Int): Long = buffer.getLong(sections[column] + row * 8)
+
+    private fun narrow(column: Int, row: Int): Int = buffer.getInt(sections[column] + row * 4)
+
+    private fun text(column: Int, row: Int): String {
+        val index = narrow(column, row)
+        strings[index]?.let { return it }
+        val start = buffer.getInt(sections[SECTION_STRING_OFFSETS] + index * 4)
+        val end = buffer.getInt(sections[SECTION_STRING_OFFSETS] + (index + 1) * 4)
+        val bytes = ByteArray(end - start)
+        val view = buffer.duplicate()
+        view.position(sections[SECTION_STRING_BYTES] + start)
+        view.get(bytes)
+        // Racing decodes produce equal strings; either may be kept
+        return String(bytes, Charsets.UTF_8).also { strings[index] = it }
+    }
+
+    private fun track(row: Int): Track {
+        val flags = narrow(COLUMN_FLAGS, row).toLong()
+        return Track(
+            id = wide(COLUMN_ID, row),
+            title = text(COLUMN_TITLE, row),
+            artist = text(COLUMN_ARTIST, row),
+            album = text(COLUMN_ALBUM, row),
+            duration = wide(COLUMN_DURATION_MS, row),
+            filePath = text(COLUMN_FILE_PATH, row),
+            fileSize = wide(COLUMN_FILE_SIZE, row),
+            mimeType = text(COLUMN_MIME_TYPE, row),
+            sampleRate = narrow(COLUMN_SAMPLE_RATE, row),
+            bitRate = narrow(COLUMN_BIT_RATE, row),
+            channels = narrow(COLUMN_CHANNELS, row),
+            bitDepth = narrow(COLUMN_BIT_DEPTH, row),
+            codec = text(COLUMN_CODEC, row),
+            year = narrow(COLUMN_YEAR, row).takeIf { it > 0 },
+            trackNumber = narrow(COLUMN_TRACK_NUMBER, row).takeIf { it > 0 },
+            dateAdded = wide(COLUMN_DATE_ADDED, row),
+            isHiRes = (flags and FLAG_HI_RES) != 0L,
+            isFavorite = (flags and FLAG_FAVORITE) != 0L
+        )
+    }
+}
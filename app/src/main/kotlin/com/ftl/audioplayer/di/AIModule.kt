@@ -1,6 +1,7 @@
 package com.ftl.audioplayer.di
 
 import android.content.Context
+import com.ftl.audioplayer.ai.NativeInferenceEngine
 import com.ftl.audioplayer.ai.NeuralAudioProcessor
 import com.ftl.audioplayer.ai.TensorFlowLiteModelManager
 import dagger.Module
@@ -17,7 +18,8 @@ import javax.inject.Singleton
  * ╚══════════════════════════════════════════════════════════════╝
  * 
  * Hilt module providing AI-related dependencies including
- * TensorFlow Lite model management and neural audio processing.
+ * TensorFlow Lite model management, native inference and neural
+ * audio processing.
  */
 @Module
 @InstallIn(SingletonComponent::class)
@@ -31,11 +33,20 @@ object AIModule {
         return TensorFlowLiteModelManager(context)
     }
     
+    @Provides
+    @Singleton
+    fun provideNativeInferenceEngine(
+        @ApplicationContext context: Context
+    ): NativeInferenceEngine {
+        return NativeInferenceEngine(context)
+    }
+    
     @Provides
     @Singleton
     fun provideNeuralAudioProcessor(
-        modelManager: TensorFlowLiteModelManager
+        modelManager: TensorFlowLiteModelManager,
+        nativeEngine: NativeInferenceEngine
     ): NeuralAudioProcessor {
-        return NeuralAudioProcessor(modelManager)
+        return NeuralAudioProcessor(modelManager, nativeEngine)
     }
 }
\ No newline at end of file
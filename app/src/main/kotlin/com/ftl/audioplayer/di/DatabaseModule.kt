@@ -1,10 +1,13 @@
 package com.ftl.audioplayer.di
 
 import android.content.Context
+import com.ftl.audioplayer.audio.AudioEngine
 import com.ftl.audioplayer.data.dao.PlaylistDao
 import com.ftl.audioplayer.data.dao.TrackDao
 import com.ftl.audioplayer.data.database.MusicDatabase
 import com.ftl.audioplayer.data.repository.MusicRepository
+import com.ftl.audioplayer.data.search.NativeSearchIndex
+import com.ftl.audioplayer.data.snapshot.NativeLibrarySnapshot
 import com.ftl.audioplayer.playback.MusicPlayer
 import dagger.Module
 import dagger.Provides
@@ -38,9 +41,12 @@ object DatabaseModule {
     fun provideMusicRepository(
         trackDao: TrackDao,
         playlistDao: PlaylistDao,
-        @ApplicationContext context: Context
+        @ApplicationContext context: Context,
+        audioEngine: AudioEngine,
+        searchIndex: NativeSearchIndex,
+        librarySnapshot: NativeLibrarySnapshot
     ): MusicRepository {
-        return MusicRepository(trackDao, playlistDao, context)
+        return MusicRepository(trackDao, playlistDao, context, audioEngine, searchIndex, librarySnapshot)
     }
     
     @Provides
@@ -1,11 +1,14 @@
 package com.ftl.audioplayer.ui.viewmodels
 
 import android.content.Context
+import android.os.SystemClock
 import android.util.Log
 import androidx.lifecycle.ViewModel
 import androidx.lifecycle.viewModelScope
 import com.ftl.audioplayer.data.entities.Track
 import com.ftl.audioplayer.data.repository.MusicRepository
+import com.ftl.audioplayer.data.snapshot.LibrarySnapshotRows
+import com.ftl.audioplayer.data.snapshot.SnapshotOrder
 import com.ftl.audioplayer.playback.MusicPlayer
 import com.ftl.audioplayer.ui.screens.LibraryView
 import com.ftl.audioplayer.utils.PermissionUtils
@@ -40,7 +43,10 @@ class LibraryViewModel @Inject constructor(
     
     private val allTracks = musicRepository.getAllTracks()
     private val hiResTracks = musicRepository.getHiResTracks()
+    private var snapshotServed = false
     
+    // Until Room's first rows arrive, show the view from the mapped snapshot (once; a
+    // resubscription already has Room's rows as its value)
     val tracks: StateFlow<List<Track>> = combine(
         allTracks,
         hiResTracks,
@@ -52,12 +58,29 @@ class LibraryViewModel @Inject constructor(
             LibraryView.ALBUMS -> all.sortedBy { "${it.album} - ${it.trackNumber}" }
             LibraryView.ARTISTS -> all.sortedBy { "${it.artist} - ${it.album} - ${it.trackNumber}" }
         }
+    }.onStart {
+        if (snapshotServed) return@onStart
+        snapshotServed = true
+        val start = SystemClock.elapsedRealtime()
+        val snapshot = musicRepository.openLibrarySnapshot() ?: return@onStart
+        val rows = snapshotTracks(snapshot, selectedView.value)
+        if (rows.isNotEmpty()) {
+            emit(rows)
+            Log.i(TAG, "First rows from snapshot: ${rows.size} in ${SystemClock.elapsedRealtime() - start} ms")
+        }
     }.stateIn(
         scope = viewModelScope,
         started = SharingStarted.WhileSubscribed(5000),
         initialValue = emptyList()
     )
     
+    private fun snapshotTracks(snapshot: LibrarySnapshotRows, view: LibraryView): List<Track> = when (view) {
+        LibraryView.SONGS -> snapshot.tracks(SnapshotOrder.TITLE)
+        LibraryView.HI_RES -> snapshot.hiResTracks()
+        LibraryView.ALBUMS -> snapshot.tracks(SnapshotOrder.ALBUM)
+        LibraryView.ARTISTS -> snapshot.tracks(SnapshotOrder.ARTIST)
+    }
+    
     fun initializeLibrary() {
         checkPermissions()
         viewModelScope.launch {
@@ -0,0 +1,320 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - AUTOMATION TESTS             ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Schedules fades and pauses on the running engine and checks through the
+ * output tap that each lands on the frame it names - mid-burst, on either
+ * clock - and that cancelled events never fire. Also prints the per-burst
+ * cost of evaluating the timeline with 0 and 200 pending events.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AutomationScheduler.h"
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int BURST = 240;
+constexpr int64_t RECORD_FRAMES = SAMPLE_RATE * 4;
+constexpr float DC_LEVEL = 0.25f;
+
+/** Left channel of every frame the device played, indexed by stream frame */
+class OutputRecorder {
+public:
+    OutputRecorder() : m_left(RECORD_FRAMES, -1.0f) { host::setOutputTap(&OutputRecorder::tap, this); }
+    ~OutputRecorder() { host::setOutputTap(nullptr, nullptr); }
+
+    float at(int64_t frame) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return frame >= 0 && frame < RECORD_FRAMES ? m_left[frame] : -1.0f;
+    }
+
+    /** Stream frame after the last one played */
+    int64_t end() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_end;
+    }
+
+    /** Index-signal frame the device played at `frame`, -1 for silence */
+    int64_t indexAt(int64_t frame) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return frame >= 0 && frame < static_cast<int64_t>(m_index.size()) ? m_index[frame] : -1;
+    }
+
+    void recordIndex(bool enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_index.assign(enabled ? RECORD_FRAMES : 0, -1);
+    }
+
+private:
+    static void tap(const float* frames, int32_t numFrames, int32_t channelCount,
+                    int64_t streamFrame, void* userData) {
+        auto* self = static_cast<OutputRecorder*>(userData);
+        std::lock_guard<std::mutex> lock(self->m_mutex);
+        for (int32_t i = 0; i < numFrames; ++i) {
+            int64_t frame = streamFrame + i;
+            if (frame >= RECORD_FRAMES) break;
+            self->m_left[frame] = frames[i * channelCount];
+            if (!self->m_index.empty()) self->m_index[frame] = decodeIndex(frames + i * channelCount);
+        }
+        self->m_end = std::max(self->m_end, streamFrame + numFrames);
+    }
+
+    std::mutex m_mutex;
+    std::vector<float> m_left;
+    std::vector<int64_t> m_index;
+    int64_t m_end = 0;
+};
+
+bool startEngine(FTLAudioEngine& engine, const std::string& path) {
+    host::BackendSettings settings;
+    settings.realtimePacing = true;
+    host::setBackendSettings(settings);
+
+    AudioEngineConfig config;
+    config.sampleRate = SAMPLE_RATE;
+    config.framesPerBurst = BURST;
+    return engine.initialize(config) == EngineResult::SUCCESS &&
+           engine.setAudioSource(path) == EngineResult::SUCCESS &&
+           engine.startPlayback() == EngineResult::SUCCESS;
+}
+
+std::string makeDcFile(const char* name) {
+    std::string path = tempPath(name);
+    std::vector<int16_t> samples(static_cast<size_t>(SAMPLE_RATE) * 10 * 2,
+                                 static_cast<int16_t>(DC_LEVEL * 32768.0f));
+    return writeWav16(path, samples, 2, SAMPLE_RATE) ? path : std::string();
+}
+
+AutomationEvent outputEvent(AutomationAction action, int64_t frame, float value = 0.0f, int32_t rampFrames = 0) {
+    AutomationEvent event;
+    event.action = action;
+    event.clock = AutomationClock::OUTPUT;
+    event.frame = frame;
+    event.value = value;
+    event.rampFrames = rampFrames;
+    return event;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TIMELINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(timelineSplitsBurstsInOrder) {
+    AutomationScheduler scheduler;
+    uint32_t late = scheduler.schedule(outputEvent(AutomationAction::PROGRAM_GAIN, 1100, 0.2f));
+    uint32_t first = scheduler.schedule(outputEvent(AutomationAction::PROGRAM_GAIN, 1030, 0.5f));
+    uint32_t tie = scheduler.schedule(outputEvent(AutomationAction::PROGRAM_GAIN, 1030, 0.7f));
+    uint32_t cancelled = scheduler.schedule(outputEvent(AutomationAction::PAUSE, 1050));
+    ASSERT_TRUE(late != 0 && first != 0 && tie != 0 && cancelled != 0);
+    EXPECT_TRUE(scheduler.cancel(cancelled));
+    scheduler.drain();
+    EXPECT_EQ(scheduler.pendingCount(), 3);
+
+    BurstClock clock;
+    clock.outputFrame = 1000;
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 0, 64), 30);
+
+    AutomationEvent event;
+    EXPECT_TRUE(!scheduler.popDue(clock, 29, event));
+    ASSERT_TRUE(scheduler.popDue(clock, 30, event));
+    EXPECT_EQ(event.id, first);                 // Ties fire in the order scheduled
+    ASSERT_TRUE(scheduler.popDue(clock, 30, event));
+    EXPECT_EQ(event.id, tie);
+    EXPECT_TRUE(!scheduler.popDue(clock, 30, event));
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 30, 64), 64);
+
+    clock.outputFrame = 1064;
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 0, 64), 36);
+    EXPECT_EQ(scheduler.pendingCount(), 1);
+
+    // SOURCE events wait for frames that carry the source; overdue ones fire at once
+    AutomationEvent cue;
+    cue.clock = AutomationClock::SOURCE;
+    cue.frame = 500;
+    scheduler.schedule(cue);
+    scheduler.drain();
+    clock.sourceFrame = 480;
+    clock.sourceFrames = 0;
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 0, 36), 36);
+    clock.sourceFrames = 64;
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 0, 64), 20);
+    clock.sourceFrame = 900;
+    EXPECT_EQ(scheduler.nextEventOffset(clock, 5, 64), 5);
+
+    scheduler.clear();
+    scheduler.drain();
+    EXPECT_EQ(scheduler.pendingCount(), 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(outputFadeStartsOnItsFrame) {
+    std::string path = makeDcFile("automation_dc.wav");
+    ASSERT_TRUE(!path.empty());
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Mid-burst on purpose
+    constexpr int32_t RAMP = 480;
+    int64_t target = engine.getOutputFrame() + SAMPLE_RATE / 10 + 17;
+    uint32_t eventId = 0;
+    ASSERT_TRUE(engine.scheduleAutomation(outputEvent(AutomationAction::PROGRAM_GAIN, target, 0.0f, RAMP),
+                                          &eventId) == EngineResult::SUCCESS);
+    EXPECT_TRUE(eventId != 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    engine.shutdown();
+
+    for (int64_t frame = target - BURST; frame <= target; ++frame) {
+        EXPECT_EQ(recorder.at(frame), DC_LEVEL);
+    }
+    EXPECT_TRUE(recorder.at(target + 1) < DC_LEVEL);
+    for (int64_t frame = target + 1; frame < target + RAMP; ++frame) {
+        EXPECT_LE(recorder.at(frame), recorder.at(frame - 1));
+    }
+    for (int64_t frame = target + RAMP; frame < target + RAMP + BURST; ++frame) {
+        EXPECT_EQ(recorder.at(frame), 0.0f);
+    }
+}
+
+FTL_TEST(sourceEventFollowsTrackPosition) {
+    std::string path = tempPath("automation_index.wav");
+    ASSERT_TRUE(writeWav16(path, makeIndexSignal(SAMPLE_RATE * 10), 2, SAMPLE_RATE));
+    OutputRecorder recorder;
+    recorder.recordIndex(true);
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Cue point in the track, scheduled while the seek to it is still in flight
+    constexpr int64_t SEEK = 240000;
+    constexpr int64_t CUE = SEEK + 4800 + 13;
+    AutomationEvent cue;
+    cue.clock = AutomationClock::SOURCE;
+    cue.action = AutomationAction::PROGRAM_GAIN;
+    cue.frame = CUE;
+    cue.value = 0.0f;
+    ASSERT_TRUE(engine.seekToFrame(SEEK) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.scheduleAutomation(cue, nullptr) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    engine.shutdown();
+
+    int64_t lastIndex = -1;
+    int64_t lastFrame = -1;
+    for (int64_t frame = 0; frame < recorder.end(); ++frame) {
+        int64_t index = recorder.indexAt(frame);
+        if (index >= 0) {
+            lastIndex = index;
+            lastFrame = frame;
+        }
+    }
+    EXPECT_EQ(lastIndex, CUE - 1);
+    EXPECT_TRUE(recorder.end() - lastFrame > BURST * 4);     // Silent from the cue on
+}
+
+FTL_TEST(pauseEventStopsOnItsFrameAndResumes) {
+    std::string path = makeDcFile("automation_pause.wav");
+    ASSERT_TRUE(!path.empty());
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int64_t target = engine.getOutputFrame() + SAMPLE_RATE / 10 + 101;
+    ASSERT_TRUE(engine.scheduleAutomation(outputEvent(AutomationAction::PAUSE, target), nullptr) ==
+                EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::PAUSED);
+    EXPECT_EQ(recorder.at(target - 1), DC_LEVEL);
+    EXPECT_EQ(recorder.at(target), 0.0f);
+    int64_t stoppedAt = recorder.end();
+    EXPECT_EQ(stoppedAt, (target / BURST + 1) * BURST);    // No bursts after the pausing one
+    EXPECT_EQ(engine.getOutputFrame(), stoppedAt);
+
+    ASSERT_TRUE(engine.resumePlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(recorder.end() > stoppedAt);
+    EXPECT_EQ(recorder.at(recorder.end() - 1), DC_LEVEL);
+    engine.shutdown();
+}
+
+FTL_TEST(cancelledEventsNeverFire) {
+    std::string path = makeDcFile("automation_cancel.wav");
+    ASSERT_TRUE(!path.empty());
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int64_t now = engine.getOutputFrame();
+    uint32_t fade = 0;
+    ASSERT_TRUE(engine.scheduleAutomation(outputEvent(AutomationAction::PROGRAM_GAIN, now + 4800, 0.0f),
+                                          &fade) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.scheduleAutomation(outputEvent(AutomationAction::PAUSE, now + 7200), nullptr) ==
+                EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.cancelAutomation(fade) == EngineResult::SUCCESS);
+    engine.clearAutomation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    int64_t end = recorder.end();
+    ASSERT_TRUE(end > now + 9600);
+    for (int64_t frame = now + 4800; frame < end; ++frame) {
+        EXPECT_EQ(recorder.at(frame), DC_LEVEL);
+    }
+    engine.shutdown();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// COST
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(perBurstEvaluationCost) {
+    constexpr int BURSTS = 200000;
+    for (int pending : {0, 200}) {
+        AutomationScheduler scheduler;
+        for (int i = 0; i < pending; ++i) {
+            // All beyond the measured span, like a sleep timer and its cue points
+            AutomationEvent event = outputEvent(AutomationAction::PROGRAM_GAIN, 1LL << 40);
+            event.clock = (i & 1) ? AutomationClock::SOURCE : AutomationClock::OUTPUT;
+            scheduler.schedule(event);
+        }
+
+        BurstClock clock;
+        clock.sourceFrames = BURST;
+        int64_t checksum = 0;
+        Clock::time_point start = Clock::now();
+        for (int burst = 0; burst < BURSTS; ++burst) {
+            scheduler.drain();
+            checksum += scheduler.nextEventOffset(clock, 0, BURST);
+            clock.outputFrame += BURST;
+            clock.sourceFrame += BURST;
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BURSTS;
+        std::printf("  %3d pending events: %.1f ns per burst\n", pending, ns);
+        EXPECT_EQ(checksum, static_cast<int64_t>(BURSTS) * BURST);
+        EXPECT_EQ(scheduler.pendingCount(), pending);
+        EXPECT_TRUE(ns < 1000.0);
+    }
+}
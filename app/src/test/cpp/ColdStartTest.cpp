@@ -0,0 +1,158 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               FTL AUDIO ENGINE - COLD START TESTS           ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * A pre-warmed engine opens its stream in the background and runs it on
+ * silence: the track decodes meanwhile, and the first play is audible on
+ * the next burst. A warm stream nobody plays on stops after its idle
+ * time and a later play still starts it. Every start reports the time
+ * from the play request to the first non-silent frame.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int32_t BURST = 240;
+constexpr double TONE_AMPLITUDE = 0.25;
+
+struct Bursts {
+    std::atomic<int64_t> count{0};
+    std::atomic<float> peak{0.0f};
+
+    static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+        auto* self = static_cast<Bursts*>(userData);
+        float peak = 0.0f;
+        for (int32_t i = 0; i < numFrames * channelCount; ++i) peak = std::max(peak, std::fabs(frames[i]));
+        self->peak.store(peak);
+        self->count.fetch_add(1);
+    }
+};
+
+std::string writeTone(const char* name) {
+    std::string path = tempPath(name);
+    writeWav16(path, makeSineSignal(RATE * 5, 2, RATE, 1000.0, TONE_AMPLITUDE), 2, RATE);
+    return path;
+}
+
+AudioEngineConfig prewarmConfig() {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = BURST;
+    config.prewarmStream = true;
+    return config;
+}
+
+// Presentation lag (2 bursts on the null device) plus one burst of scheduling
+constexpr double MAX_WARM_FIRST_AUDIO_MS = 4.0 * BURST * 1000.0 / RATE;
+
+} // namespace
+
+FTL_TEST(prewarmedStreamPlaysOnNextBurst) {
+    std::string path = writeTone("cold_start.wav");
+    Bursts bursts;
+    host::setOutputTap(&Bursts::tap, &bursts);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(prewarmConfig()) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Warm: the device runs on silence and the track is already decoded
+    EXPECT_TRUE(bursts.count.load() > 10);
+    EXPECT_EQ(bursts.peak.load(), 0.0f);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::INITIALIZED);
+
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_NEAR(bursts.peak.load(), TONE_AMPLITUDE, 1e-3);
+
+    double firstAudioMs = engine.getPerformanceMetrics().timeToFirstAudioMs;
+    EXPECT_TRUE(firstAudioMs > 0.0);
+    EXPECT_LE(firstAudioMs, MAX_WARM_FIRST_AUDIO_MS);
+    std::printf("    time to first audio (warm): %.2f ms\n", firstAudioMs);
+
+    // The silent warm-up is not part of the track
+    int64_t playhead = engine.getPlayheadFrame();
+    EXPECT_TRUE(playhead > 0);
+    EXPECT_LE(playhead, RATE / 5);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+FTL_TEST(idleWarmStreamStopsAndStillStarts) {
+    std::string path = writeTone("cold_start_idle.wav");
+    Bursts bursts;
+    host::setOutputTap(&Bursts::tap, &bursts);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config = prewarmConfig();
+    config.prewarmIdleMs = 50;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    EXPECT_TRUE(AAudioStream_getState(host::getLastOpenedStream()) == AAUDIO_STREAM_STATE_STOPPED);
+    int64_t idleBursts = bursts.count.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(bursts.count.load(), idleBursts);
+
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    EXPECT_NEAR(bursts.peak.load(), TONE_AMPLITUDE, 1e-3);
+    EXPECT_TRUE(engine.getPerformanceMetrics().timeToFirstAudioMs > 0.0);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+FTL_TEST(everyStartReportsTimeToFirstAudio) {
+    std::string path = writeTone("cold_start_cold.wav");
+    Bursts bursts;
+    host::setOutputTap(&Bursts::tap, &bursts);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = BURST;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    EXPECT_EQ(engine.getPerformanceMetrics().timeToFirstAudioMs, 0.0);
+
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    double coldMs = engine.getPerformanceMetrics().timeToFirstAudioMs;
+    EXPECT_TRUE(coldMs > 0.0);
+    std::printf("    time to first audio (cold): %.2f ms\n", coldMs);
+
+    // Resume is a new play request
+    ASSERT_TRUE(engine.pausePlayback() == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.resumePlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    double resumeMs = engine.getPerformanceMetrics().timeToFirstAudioMs;
+    EXPECT_TRUE(resumeMs > 0.0 && resumeMs != coldMs);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
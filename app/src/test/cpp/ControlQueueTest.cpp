@@ -0,0 +1,318 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - CONTROL QUEUE TESTS           ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Thousands of start / pause / resume / seek / stop commands posted from
+ * several threads at once all complete, in a bounded time, and every
+ * result is the one the state machine gives for the commands that ran
+ * before it. Tokens and callbacks report results, a callback can call
+ * back into the engine, and shutdown cancels what is still queued. Source
+ * changes and reconfiguration run in the same order as everything else.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+
+// Commands in the order the control thread ran them
+struct RunLog {
+    struct Entry {
+        ControlAction action;
+        EngineResult result;
+    };
+    std::vector<Entry> entries;                      // Control thread only until all completed
+    std::atomic<int> completed{0};
+
+    static void record(ControlToken, ControlAction action, EngineResult result, void* userData) {
+        auto* self = static_cast<RunLog*>(userData);
+        self->entries.push_back({action, result});
+        self->completed.fetch_add(1, std::memory_order_release);
+    }
+};
+
+/** The documented transitions: what `action` returns in `state`, and the state after it */
+EngineResult expectedResult(ControlAction action, EngineState& state) {
+    switch (action) {
+        case ControlAction::START:
+        case ControlAction::RESUME:
+            if (state == EngineState::RUNNING) return EngineResult::ERROR_ALREADY_RUNNING;
+            state = EngineState::RUNNING;
+            return EngineResult::SUCCESS;
+        case ControlAction::PAUSE:
+            if (state != EngineState::RUNNING) return EngineResult::ERROR_NOT_INITIALIZED;
+            state = EngineState::PAUSED;
+            return EngineResult::SUCCESS;
+        case ControlAction::STOP:
+            state = EngineState::INITIALIZED;
+            return EngineResult::SUCCESS;
+        default:
+            return EngineResult::SUCCESS;
+    }
+}
+
+bool waitFor(const std::atomic<int>& counter, int target, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (counter.load(std::memory_order_acquire) < target) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+AudioEngineConfig testConfig() {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    return config;
+}
+
+} // namespace
+
+FTL_TEST(interleavedCommandsFollowTheStateMachine) {
+    std::string path = tempPath("control_tone.wav");
+    writeWav16(path, makeSineSignal(RATE * 10, 2, RATE, 1000.0, 0.25), 2, RATE);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(testConfig()) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    const uint64_t setupCommands = engine.getControlStats().completed;   // The source change
+
+    constexpr int THREADS = 4;
+    constexpr int COMMANDS_PER_THREAD = 1000;
+    RunLog log;
+    log.entries.reserve(THREADS * COMMANDS_PER_THREAD);
+    std::atomic<int> mailboxFull{0};
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&, t] {
+            std::mt19937 random(1234 + t);
+            const ControlAction actions[] = {ControlAction::START, ControlAction::PAUSE, ControlAction::RESUME,
+                                             ControlAction::SEEK, ControlAction::STOP};
+            for (int i = 0; i < COMMANDS_PER_THREAD; ++i) {
+                ControlAction action = actions[random() % 5];
+                int64_t argument = action == ControlAction::SEEK ? static_cast<int64_t>(random() % (RATE * 9)) : 0;
+                while (engine.postCommand(action, argument, &RunLog::record, &log) == 0) {
+                    mailboxFull.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            }
+        });
+    }
+    for (std::thread& producer : producers) producer.join();
+
+    // Nothing deadlocked: every command completes
+    ASSERT_TRUE(waitFor(log.completed, THREADS * COMMANDS_PER_THREAD, 30000));
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    // Each result is the transition from the state the commands before it left
+    EngineState state = EngineState::INITIALIZED;
+    int mismatches = 0;
+    int transitions = 0;
+    for (const RunLog::Entry& entry : log.entries) {
+        EngineState before = state;
+        if (entry.result != expectedResult(entry.action, state)) ++mismatches;
+        if (state != before) ++transitions;
+    }
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_TRUE(engine.getCurrentState() == state);
+
+    ControlStats stats = engine.getControlStats();
+    std::printf("    %d commands (%d state changes) in %.0f ms, latency mean %.2f ms, max %.1f ms, "
+                "mailbox full %d times\n", THREADS * COMMANDS_PER_THREAD, transitions, elapsedMs,
+                stats.meanLatencyMs, stats.maxLatencyMs, mailboxFull.load());
+    EXPECT_EQ(stats.completed - setupCommands, static_cast<uint64_t>(THREADS * COMMANDS_PER_THREAD));
+    EXPECT_EQ(stats.posted, stats.completed);
+    EXPECT_LE(stats.maxLatencyMs, 1000.0);
+
+    // Still plays afterwards
+    engine.stopPlayback();
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));   // Audio from before the last seek plays out
+    int64_t playhead = engine.getPlayheadFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(engine.getPlayheadFrame() > playhead + RATE / 20);
+    engine.shutdown();
+}
+
+FTL_TEST(tokensCallbacksAndShutdown) {
+    host::setBackendSettings(host::BackendSettings());
+    FTLAudioEngine engine;
+
+    // No control thread before initialize
+    EXPECT_EQ(engine.postCommand(ControlAction::START), 0u);
+    EXPECT_TRUE(engine.startPlayback() == EngineResult::ERROR_NOT_INITIALIZED);
+    ASSERT_TRUE(engine.initialize(testConfig()) == EngineResult::SUCCESS);
+
+    // Tokens: results come back in order, a second start is refused
+    ControlToken first = engine.postCommand(ControlAction::START);
+    ControlToken second = engine.postCommand(ControlAction::START);
+    EXPECT_TRUE(first != 0 && second > first);
+    EngineResult result = EngineResult::ERROR_PROCESSING_FAILED;
+    EXPECT_TRUE(engine.awaitCommand(second, 2000, &result));
+    EXPECT_TRUE(result == EngineResult::ERROR_ALREADY_RUNNING);
+    EXPECT_TRUE(engine.awaitCommand(first, 0, &result));
+    EXPECT_TRUE(result == EngineResult::SUCCESS);
+    EXPECT_TRUE(!engine.awaitCommand(0, 10, &result));
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+
+    // A callback may call in: it runs inline on the control thread instead of waiting on itself
+    struct Reentry {
+        FTLAudioEngine* engine;
+        EngineResult pauseResult = EngineResult::ERROR_PROCESSING_FAILED;
+        std::atomic<int> done{0};
+        static void callback(ControlToken, ControlAction, EngineResult, void* userData) {
+            auto* self = static_cast<Reentry*>(userData);
+            self->pauseResult = self->engine->pausePlayback();
+            self->done.store(1, std::memory_order_release);
+        }
+    } reentry{&engine};
+    EXPECT_TRUE(engine.postCommand(ControlAction::SEEK, 0, &Reentry::callback, &reentry) != 0);
+    ASSERT_TRUE(waitFor(reentry.done, 1, 2000));
+    EXPECT_TRUE(reentry.pauseResult == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::PAUSED);
+
+    // Shutdown with a full mailbox: the running command finishes, every queued one is cancelled
+    RunLog log;
+    log.entries.reserve(ControlQueue::CAPACITY * 2);
+    int posted = 0;
+    for (int i = 0; i < ControlQueue::CAPACITY * 2; ++i) {
+        ControlAction action = i % 2 ? ControlAction::STOP : ControlAction::START;
+        if (engine.postCommand(action, 0, &RunLog::record, &log) != 0) ++posted;
+    }
+    EXPECT_TRUE(posted >= ControlQueue::CAPACITY);
+    engine.shutdown();
+    EXPECT_EQ(log.completed.load(), posted);
+    int cancelled = 0;
+    for (const RunLog::Entry& entry : log.entries) {
+        if (entry.result == EngineResult::ERROR_NOT_INITIALIZED) ++cancelled;
+    }
+    EXPECT_TRUE(cancelled > 0);
+    EXPECT_EQ(engine.postCommand(ControlAction::START), 0u);
+}
+
+FTL_TEST(sourceChangesAndReconfigurationRunInOrder) {
+    std::string first = tempPath("control_first.wav");
+    std::string second = tempPath("control_second.wav");
+    writeWav16(first, makeSineSignal(RATE * 10, 2, RATE, 1000.0, 0.25), 2, RATE);
+    writeWav16(second, makeSineSignal(RATE * 5, 2, RATE, 440.0, 0.25), 2, RATE);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(testConfig()) == EngineResult::SUCCESS);
+
+    // Pointer arguments only through the engine's own entry points
+    EXPECT_EQ(engine.postCommand(ControlAction::SET_SOURCE), 0u);
+    EXPECT_EQ(engine.postCommand(ControlAction::RECONFIGURE), 0u);
+
+    // A seek posted right after a source runs after it, so it has a track to seek in
+    RunLog ordered;
+    ordered.entries.reserve(8);
+    EXPECT_TRUE(engine.postAudioSource(first, &RunLog::record, &ordered) != 0);
+    EXPECT_TRUE(engine.postCommand(ControlAction::SEEK, RATE * 8, &RunLog::record, &ordered) != 0);
+    EXPECT_TRUE(engine.postCommand(ControlAction::START, 0, &RunLog::record, &ordered) != 0);
+    EXPECT_TRUE(engine.postAudioSource(second, &RunLog::record, &ordered) != 0);
+    EXPECT_TRUE(engine.postCommand(ControlAction::SEEK, RATE * 4, &RunLog::record, &ordered) != 0);
+    EXPECT_TRUE(engine.postCommand(ControlAction::STOP, 0, &RunLog::record, &ordered) != 0);
+    ASSERT_TRUE(waitFor(ordered.completed, 6, 5000));
+    const ControlAction expectedOrder[] = {ControlAction::SET_SOURCE, ControlAction::SEEK, ControlAction::START,
+                                           ControlAction::SET_SOURCE, ControlAction::SEEK, ControlAction::STOP};
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(ordered.entries[i].action == expectedOrder[i]);
+        EXPECT_TRUE(ordered.entries[i].result == EngineResult::SUCCESS);
+    }
+
+    // Settings the stream and rings were sized for are refused; posted settings only carry the tunables
+    AudioEngineConfig resized = engine.getCurrentConfiguration();
+    resized.sampleRate = 44100;
+    EXPECT_TRUE(engine.updateConfiguration(resized) == EngineResult::ERROR_INVALID_CONFIG);
+    AudioEngineConfig tuning;                         // Defaults everywhere, as the JNI layer sends it
+    tuning.sampleRate = 96000;
+    tuning.enableDSPProcessing = false;
+    tuning.threadPriority = -10;
+    EngineResult tuned = EngineResult::ERROR_PROCESSING_FAILED;
+    ASSERT_TRUE(engine.awaitCommand(engine.postConfiguration(tuning), 2000, &tuned));
+    EXPECT_TRUE(tuned == EngineResult::SUCCESS);
+    AudioEngineConfig live = engine.getCurrentConfiguration();
+    EXPECT_EQ(live.sampleRate, RATE);
+    EXPECT_EQ(live.framesPerBurst, 240);
+    EXPECT_TRUE(!live.enableDSPProcessing);
+    EXPECT_EQ(live.threadPriority, -10);
+
+    // Track changes and reconfiguration from other threads don't disturb the state machine
+    constexpr int COMMANDS = 1000;
+    RunLog log;
+    log.entries.reserve(COMMANDS);
+    std::atomic<bool> producing{true};
+    std::atomic<int> sourceFailures{0};
+    std::atomic<int> configFailures{0};
+    std::thread switcher([&] {
+        for (int i = 0; producing.load(std::memory_order_acquire); ++i) {
+            if (engine.setAudioSource(i % 2 ? first : second) != EngineResult::SUCCESS) {
+                sourceFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    std::thread reconfigurer([&] {
+        AudioEngineConfig config = live;
+        while (producing.load(std::memory_order_acquire)) {
+            EngineResult result = engine.updateConfiguration(config);
+            if (result != EngineResult::SUCCESS && result != EngineResult::ERROR_ALREADY_RUNNING) {
+                configFailures.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+    std::mt19937 random(99);
+    const ControlAction actions[] = {ControlAction::START, ControlAction::PAUSE, ControlAction::RESUME,
+                                     ControlAction::SEEK, ControlAction::STOP};
+    for (int i = 0; i < COMMANDS; ++i) {
+        ControlAction action = actions[random() % 5];
+        int64_t argument = action == ControlAction::SEEK ? static_cast<int64_t>(random() % (RATE * 4)) : 0;
+        while (engine.postCommand(action, argument, &RunLog::record, &log) == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    ASSERT_TRUE(waitFor(log.completed, COMMANDS, 30000));
+    producing.store(false, std::memory_order_release);
+    switcher.join();
+    reconfigurer.join();
+    EXPECT_EQ(sourceFailures.load(), 0);
+    EXPECT_EQ(configFailures.load(), 0);
+
+    EngineState state = EngineState::INITIALIZED;
+    int mismatches = 0;
+    for (const RunLog::Entry& entry : log.entries) {
+        if (entry.result != expectedResult(entry.action, state)) ++mismatches;
+    }
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_TRUE(engine.getCurrentState() == state);
+
+    // Posted sources still queued at shutdown are cancelled with their commands
+    engine.stopPlayback();
+    RunLog cancelled;
+    cancelled.entries.reserve(64);
+    int posted = 0;
+    for (int i = 0; i < 64; ++i) {
+        if (engine.postAudioSource(i % 2 ? first : second, &RunLog::record, &cancelled) != 0) ++posted;
+    }
+    engine.shutdown();
+    EXPECT_EQ(cancelled.completed.load(), posted);
+}
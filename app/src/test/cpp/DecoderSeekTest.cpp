@@ -0,0 +1,148 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - DECODER SEEK TESTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Bit-exact decode and sample-accurate seeking for WAV and FLAC.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AudioSource.h"
+#include "FlacSource.h"
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int64_t TOTAL_FRAMES = 48000 * 3 + 123;   // Short final block
+
+const std::vector<int16_t>& indexSignal() {
+    static const std::vector<int16_t> signal = makeIndexSignal(TOTAL_FRAMES);
+    return signal;
+}
+
+/** Read `frames` frames and check each one carries its own index */
+bool readsIndexRun(AudioSource& source, int64_t firstFrame, int64_t frames) {
+    std::vector<float> buffer(4096 * 2);
+    int64_t expected = firstFrame;
+    while (expected < firstFrame + frames) {
+        int32_t want = static_cast<int32_t>(std::min<int64_t>(4096, firstFrame + frames - expected));
+        int32_t got = source.read(buffer.data(), want);
+        if (got <= 0) {
+            std::fprintf(stderr, "  read returned %d at frame %lld\n", got, static_cast<long long>(expected));
+            return false;
+        }
+        for (int32_t i = 0; i < got; ++i, ++expected) {
+            if (decodeIndex(&buffer[i * 2]) != expected) {
+                std::fprintf(stderr, "  frame %lld decoded as %lld\n", static_cast<long long>(expected),
+                             static_cast<long long>(decodeIndex(&buffer[i * 2])));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void checkFullDecode(const std::string& path) {
+    auto source = openAudioSource(path);
+    ASSERT_TRUE(source != nullptr);
+    EXPECT_EQ(source->info().sampleRate, SAMPLE_RATE);
+    EXPECT_EQ(source->info().channelCount, 2);
+    EXPECT_EQ(source->info().totalFrames, TOTAL_FRAMES);
+    EXPECT_TRUE(readsIndexRun(*source, 0, TOTAL_FRAMES));
+
+    float tail[8];
+    EXPECT_EQ(source->read(tail, 4), 0);
+}
+
+void checkSeeks(const std::string& path) {
+    auto source = openAudioSource(path);
+    ASSERT_TRUE(source != nullptr);
+
+    // Forward, backward, block boundaries, first/last frames
+    const int64_t targets[] = {100000, 5, 4095, 4096, 4097, 143000, 0, TOTAL_FRAMES - 1, 77777, 12288};
+    for (int64_t target : targets) {
+        EXPECT_TRUE(source->seekToFrame(target));
+        EXPECT_EQ(source->positionFrames(), target);
+        EXPECT_TRUE(readsIndexRun(*source, target, std::min<int64_t>(600, TOTAL_FRAMES - target)));
+    }
+
+    // Seeking to the end leaves nothing to read
+    EXPECT_TRUE(source->seekToFrame(TOTAL_FRAMES));
+    float frame[2];
+    EXPECT_EQ(source->read(frame, 1), 0);
+    EXPECT_TRUE(!source->seekToFrame(TOTAL_FRAMES + 1));
+}
+
+std::string writeFlacFixture(const char* name, const FlacWriteOptions& options) {
+    std::string path = tempPath(name);
+    if (!writeFlac16(path, indexSignal(), SAMPLE_RATE, options)) {
+        reportFailure(__FILE__, __LINE__, "cannot write " + path);
+    }
+    return path;
+}
+
+} // namespace
+
+FTL_TEST(wavDecodesBitExact) {
+    std::string path = tempPath("index.wav");
+    ASSERT_TRUE(writeWav16(path, indexSignal(), 2, SAMPLE_RATE));
+    checkFullDecode(path);
+}
+
+FTL_TEST(wavSeeksAreSampleAccurate) {
+    std::string path = tempPath("index_seek.wav");
+    ASSERT_TRUE(writeWav16(path, indexSignal(), 2, SAMPLE_RATE));
+    checkSeeks(path);
+}
+
+FTL_TEST(flacDecodesBitExactAllStereoModes) {
+    FlacWriteOptions options;
+    options.stereo = StereoMode::INDEPENDENT;
+    checkFullDecode(writeFlacFixture("independent.flac", options));
+    options.stereo = StereoMode::LEFT_SIDE;
+    checkFullDecode(writeFlacFixture("left_side.flac", options));
+    options.stereo = StereoMode::MID_SIDE;
+    checkFullDecode(writeFlacFixture("mid_side.flac", options));
+}
+
+FTL_TEST(flacSeeksWithSeekTable) {
+    FlacWriteOptions options;
+    options.stereo = StereoMode::MID_SIDE;
+    checkSeeks(writeFlacFixture("seektable.flac", options));
+}
+
+FTL_TEST(flacSeeksWithoutSeekTable) {
+    FlacWriteOptions options;
+    options.seekTable = false;
+    options.blockSize = 1152;
+    checkSeeks(writeFlacFixture("no_seektable.flac", options));
+}
+
+FTL_TEST(flacSeekIoIsBounded) {
+    FlacWriteOptions options;
+    options.seekTable = false;
+    std::string path = writeFlacFixture("seek_io.flac", options);
+
+    FlacSource source;
+    ASSERT_TRUE(source.open(path));
+    size_t indexBefore = source.frameIndex().size();
+
+    // Bisection finds the frame without decoding the file up to the target
+    IoStats before = source.ioStats();
+    EXPECT_TRUE(source.seekToFrame(130000));
+    uint64_t seekReads = source.ioStats().readRequests - before.readRequests;
+    EXPECT_LE(seekReads, 64u);
+    EXPECT_TRUE(readsIndexRun(source, 130000, 100));
+
+    // Frames discovered on the way are remembered for the next seek
+    EXPECT_TRUE(source.frameIndex().size() > indexBefore);
+    before = source.ioStats();
+    EXPECT_TRUE(source.seekToFrame(129000));
+    EXPECT_LE(source.ioStats().readRequests - before.readRequests, 8u);
+    EXPECT_TRUE(readsIndexRun(source, 129000, 100));
+}
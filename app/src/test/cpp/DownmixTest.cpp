@@ -0,0 +1,292 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          FTL AUDIO ENGINE - DOWNMIX & BINAURAL TESTS        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * BS.775 fold-down coefficients, the layout-specialized SIMD kernels
+ * against a plain matrix product, virtual speaker placement (interaural
+ * delay and level on the correct side, centre exactly between the ears),
+ * the whole path through the running engine, and the cost of 7.1 →
+ * binaural at 96 kHz.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "BinauralRenderer.h"
+#include "Downmix.h"
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float MINUS_3DB = 0.70710678f;
+
+/** Reference: dst = matrix * src in double */
+std::vector<float> referenceMix(const DownmixMatrix& matrix, const std::vector<float>& src, int32_t frames) {
+    std::vector<float> dst(static_cast<size_t>(frames) * matrix.outputChannels);
+    for (int32_t i = 0; i < frames; ++i) {
+        for (int o = 0; o < matrix.outputChannels; ++o) {
+            double sum = 0.0;
+            for (int c = 0; c < matrix.inputChannels; ++c) {
+                sum += static_cast<double>(matrix.coefficients[o][c]) * src[i * matrix.inputChannels + c];
+            }
+            dst[i * matrix.outputChannels + o] = static_cast<float>(sum);
+        }
+    }
+    return dst;
+}
+
+/** Impulse on one channel of a `channels`-wide signal, rendered binaurally */
+std::vector<float> binauralImpulse(int sampleRate, int channels, int channel, int32_t frames) {
+    std::vector<float> input(static_cast<size_t>(frames) * channels, 0.0f);
+    input[channel] = 1.0f;
+    std::vector<float> output(static_cast<size_t>(frames) * 2);
+    BinauralRenderer renderer;
+    renderer.configure(sampleRate, channels);
+    renderer.process(input.data(), output.data(), frames);
+    return output;
+}
+
+/** First frame where |ear| exceeds a threshold */
+int32_t onset(const std::vector<float>& stereo, int ear) {
+    for (size_t i = 0; i < stereo.size() / 2; ++i) {
+        if (std::fabs(stereo[i * 2 + ear]) > 1e-4f) return static_cast<int32_t>(i);
+    }
+    return -1;
+}
+
+double energy(const std::vector<float>& stereo, int ear) {
+    double sum = 0.0;
+    for (size_t i = 0; i < stereo.size() / 2; ++i) sum += stereo[i * 2 + ear] * stereo[i * 2 + ear];
+    return sum;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MATRIX DOWNMIX
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(standardMatricesFollowBs775) {
+    // 7.1: L R C LFE BL BR SL SR
+    DownmixMatrix m71 = DownmixMatrix::standard(8, 2);
+    const float left71[8] = {1.0f, 0.0f, MINUS_3DB, 0.0f, MINUS_3DB, 0.0f, MINUS_3DB, 0.0f};
+    const float right71[8] = {0.0f, 1.0f, MINUS_3DB, 0.0f, 0.0f, MINUS_3DB, 0.0f, MINUS_3DB};
+    for (int c = 0; c < 8; ++c) {
+        EXPECT_NEAR(m71.coefficients[0][c], left71[c], 1e-6);
+        EXPECT_NEAR(m71.coefficients[1][c], right71[c], 1e-6);
+    }
+
+    // 5.1: LFE dropped, surrounds at -3 dB on their own side
+    DownmixMatrix m51 = DownmixMatrix::standard(6, 2);
+    EXPECT_EQ(m51.coefficients[0][3], 0.0f);
+    EXPECT_NEAR(m51.coefficients[0][4], MINUS_3DB, 1e-6);
+    EXPECT_EQ(m51.coefficients[0][5], 0.0f);
+    EXPECT_NEAR(m51.coefficients[1][5], MINUS_3DB, 1e-6);
+
+    // Mono: average of the stereo fold-down
+    DownmixMatrix mono = DownmixMatrix::standard(2, 1);
+    EXPECT_EQ(mono.coefficients[0][0], 0.5f);
+    EXPECT_EQ(mono.coefficients[0][1], 0.5f);
+
+    // Not a fold-down: the old remap (repeat the last channel)
+    DownmixMatrix up = DownmixMatrix::standard(1, 2);
+    EXPECT_EQ(up.coefficients[0][0], 1.0f);
+    EXPECT_EQ(up.coefficients[1][0], 1.0f);
+
+    float tooMany[2 * 9] = {};
+    DownmixMatrix custom;
+    EXPECT_TRUE(!custom.assign(9, 2, tooMany));
+}
+
+FTL_TEST(specializedKernelsMatchMatrixProduct) {
+    constexpr int32_t FRAMES = 1001;       // Odd: exercises the scalar tail of the pair kernels
+    for (int in = 1; in <= DownmixMatrix::MAX_CHANNELS; ++in) {
+        for (int out = 1; out <= 4; ++out) {
+            std::vector<float> src(static_cast<size_t>(FRAMES) * in);
+            for (size_t i = 0; i < src.size(); ++i) {
+                src[i] = noiseSample(static_cast<int64_t>(i / in), static_cast<int>(i % in)) / 32768.0f;
+            }
+
+            // Arbitrary matrix, so every coefficient is exercised
+            std::vector<float> rows(static_cast<size_t>(in) * out);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                rows[i] = 0.1f * static_cast<float>((i * 7) % 11) - 0.4f;
+            }
+            DownmixMatrix matrix;
+            ASSERT_TRUE(matrix.assign(in, out, rows.data()));
+
+            Downmixer downmix;
+            downmix.configure(matrix);
+            std::vector<float> dst(static_cast<size_t>(FRAMES) * out);
+            downmix.process(src.data(), dst.data(), FRAMES);
+
+            std::vector<float> expected = referenceMix(matrix, src, FRAMES);
+            float worst = 0.0f;
+            for (size_t i = 0; i < dst.size(); ++i) {
+                worst = std::max(worst, std::fabs(dst[i] - expected[i]));
+            }
+            EXPECT_TRUE(worst < 1e-5f);
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// BINAURAL
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(binauralPlacesVirtualSpeakers) {
+    constexpr int RATE = 96000;
+    constexpr int32_t FRAMES = 2048;
+
+    // 7.1 side left (-90°): near ear first and louder; far ear a full head-width later
+    std::vector<float> sideLeft = binauralImpulse(RATE, 8, 6, FRAMES);
+    int32_t itd = onset(sideLeft, 1) - onset(sideLeft, 0);
+    double expectedItd = BinauralRenderer::HEAD_RADIUS_M / BinauralRenderer::SPEED_OF_SOUND_MS *
+                         (1.0 + M_PI / 2.0) * RATE;
+    std::printf("  SL: onset L %d R %d (ITD %d frames, model %.1f), ILD %.1f dB\n",
+                onset(sideLeft, 0), onset(sideLeft, 1), itd, expectedItd,
+                10.0 * std::log10(energy(sideLeft, 0) / energy(sideLeft, 1)));
+    EXPECT_EQ(onset(sideLeft, 0), 0);
+    EXPECT_NEAR(itd, expectedItd, 1.0);
+    EXPECT_TRUE(energy(sideLeft, 0) > 4.0 * energy(sideLeft, 1));
+
+    // Mirror image on the right
+    std::vector<float> sideRight = binauralImpulse(RATE, 8, 7, FRAMES);
+    EXPECT_EQ(onset(sideRight, 1), 0);
+    EXPECT_EQ(onset(sideRight, 0), onset(sideLeft, 1));
+    EXPECT_NEAR(energy(sideRight, 1), energy(sideLeft, 0), 1e-6);
+
+    // Centre: identical at both ears (down to the denormal guard)
+    std::vector<float> centre = binauralImpulse(RATE, 8, 2, FRAMES);
+    for (int32_t i = 0; i < FRAMES; ++i) {
+        EXPECT_NEAR(centre[i * 2], centre[i * 2 + 1], 1e-12);
+    }
+
+    // LFE is dropped, as in the matrix fold-down
+    EXPECT_TRUE(energy(binauralImpulse(RATE, 8, 3, FRAMES), 0) < 1e-30);
+
+    // Stereo crossfeed: the left channel reaches the right ear, later and darker
+    std::vector<float> crossfeed = binauralImpulse(48000, 2, 0, FRAMES);
+    EXPECT_TRUE(onset(crossfeed, 1) > onset(crossfeed, 0));
+    EXPECT_TRUE(energy(crossfeed, 1) > 0.0);
+    EXPECT_TRUE(energy(crossfeed, 0) > energy(crossfeed, 1));
+
+    // Every ear path is unity-sum at DC times the speaker gain
+    double dc = 0.0;
+    for (int32_t i = 0; i < FRAMES; ++i) dc += crossfeed[i * 2 + 1];
+    EXPECT_NEAR(dc, BinauralRenderer::SPEAKER_GAIN, 1e-3);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(engineFoldsDownSurroundSources) {
+    constexpr int RATE = 48000;
+    // 5.1 with a different constant per channel: L R C LFE BL BR
+    const int16_t levels[6] = {3200, 1600, 6400, 12800, 800, 1200};
+    std::vector<int16_t> samples;
+    for (int i = 0; i < RATE * 5; ++i) {
+        samples.insert(samples.end(), levels, levels + 6);
+    }
+    std::string path = tempPath("downmix_51.wav");
+    ASSERT_TRUE(writeWav16(path, samples, 6, RATE));
+    auto level = [&](int channel) { return levels[channel] / 32768.0f; };
+
+    struct Last {
+        static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+            auto* last = static_cast<std::atomic<float>*>(userData);
+            last[0].store(frames[(numFrames - 1) * channelCount]);
+            last[1].store(frames[(numFrames - 1) * channelCount + 1]);
+        }
+    };
+    std::atomic<float> last[2] = {};
+    host::setOutputTap(&Last::tap, last);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+
+    // BS.775 by default
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_NEAR(last[0].load(), level(0) + MINUS_3DB * (level(2) + level(4)), 1e-5);
+    EXPECT_NEAR(last[1].load(), level(1) + MINUS_3DB * (level(2) + level(5)), 1e-5);
+
+    // Custom matrix: LFE to the right, left untouched; the buffered ring plays out first
+    const float lfeRight[12] = {1, 0, 0, 0, 0, 0,
+                                0, 0, 0, 1, 0, 0};
+    EXPECT_TRUE(engine.setDownmixMatrix(6, lfeRight, 12) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setDownmixMatrix(6, lfeRight, 6) != EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    EXPECT_NEAR(last[0].load(), level(0), 1e-5);
+    EXPECT_NEAR(last[1].load(), level(3), 1e-5);
+
+    // Virtualizer: at DC every speaker reaches both ears at SPEAKER_GAIN (LFE dropped)
+    EXPECT_TRUE(engine.setHeadphoneVirtualizer(true) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    float dc = BinauralRenderer::SPEAKER_GAIN * (level(0) + level(1) + level(2) + level(4) + level(5));
+    EXPECT_NEAR(last[0].load(), dc, 1e-4);
+    EXPECT_NEAR(last[1].load(), dc, 1e-4);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// COST
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(sevenOneToBinauralCostAt96kHz) {
+    constexpr int RATE = 96000;
+    constexpr int CHANNELS = 8;
+    constexpr double SECONDS = 10.0;
+    constexpr int32_t CHUNK = 1024;        // Decode thread chunk
+    int32_t frames = static_cast<int32_t>(SECONDS * RATE);
+    std::vector<float> input(static_cast<size_t>(frames) * CHANNELS);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = noiseSample(static_cast<int64_t>(i / CHANNELS), static_cast<int>(i % CHANNELS)) / 32768.0f;
+    }
+    std::vector<float> output(static_cast<size_t>(CHUNK) * 2);
+
+    BinauralRenderer binaural;
+    binaural.configure(RATE, CHANNELS);
+    Downmixer downmix;
+    downmix.configure(DownmixMatrix::standard(CHANNELS, 2));
+
+    double binauralUs = 0.0;
+    double downmixUs = 0.0;
+    for (int32_t done = 0; done + CHUNK <= frames; done += CHUNK) {
+        const float* chunk = input.data() + static_cast<size_t>(done) * CHANNELS;
+        Clock::time_point start = Clock::now();
+        binaural.process(chunk, output.data(), CHUNK);
+        Clock::time_point middle = Clock::now();
+        downmix.process(chunk, output.data(), CHUNK);
+        Clock::time_point end = Clock::now();
+        binauralUs += std::chrono::duration<double, std::micro>(middle - start).count();
+        downmixUs += std::chrono::duration<double, std::micro>(end - middle).count();
+    }
+
+    // Share of one core for real-time 7.1 at 96 kHz
+    double binauralLoad = binauralUs / (SECONDS * 1e6) * 100.0;
+    double downmixLoad = downmixUs / (SECONDS * 1e6) * 100.0;
+    std::printf("  7.1 @ 96 kHz: binaural %.3f%%, BS.775 matrix %.3f%% of a core\n", binauralLoad, downmixLoad);
+    EXPECT_TRUE(binauralLoad < 5.0);
+    EXPECT_TRUE(downmixLoad < 2.0);
+}
@@ -0,0 +1,283 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - EQUALIZER TESTS             ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Peaking bands hit their gain at the center and leave distant bands
+ * alone, a flat EQ is bit-exact, curves map onto the bands, the adaptive
+ * loop corrects a colored program within its limits and step size then
+ * holds still, and the running engine picks up a new curve without a
+ * stream restart.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AdaptiveEq.h"
+#include "Equalizer.h"
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int CHANNELS = 2;
+constexpr int32_t BURST = 256;
+
+std::vector<float> stereoSine(double seconds, double frequency, double amplitude) {
+    int64_t frames = static_cast<int64_t>(seconds * RATE);
+    std::vector<float> out(static_cast<size_t>(frames) * CHANNELS);
+    for (int64_t i = 0; i < frames; ++i) {
+        float sample = static_cast<float>(amplitude * std::sin(2.0 * M_PI * frequency * i / RATE));
+        out[i * CHANNELS] = sample;
+        out[i * CHANNELS + 1] = sample;
+    }
+    return out;
+}
+
+/** Level of the second half (past the filters' settling), dBFS RMS */
+double tailRmsDb(const std::vector<float>& signal) {
+    size_t from = signal.size() / 2;
+    double sum = 0.0;
+    for (size_t i = from; i < signal.size(); ++i) sum += static_cast<double>(signal[i]) * signal[i];
+    return 10.0 * std::log10(sum / static_cast<double>(signal.size() - from));
+}
+
+double gainThrough(Equalizer& eq, double frequency) {
+    std::vector<float> signal = stereoSine(1.0, frequency, 0.25);
+    double before = tailRmsDb(signal);
+    eq.reset();
+    int32_t frames = static_cast<int32_t>(signal.size() / CHANNELS);
+    for (int32_t done = 0; done < frames; done += BURST) {
+        eq.process(signal.data() + done * CHANNELS, std::min(BURST, frames - done));
+    }
+    return tailRmsDb(signal) - before;
+}
+
+/**
+ * Program that is bass-heavy and dull against the adaptive reference:
+ * pink noise (Kellet's filter, equal energy per octave) tilted by the
+ * reference slope, then colored with a known excess and deficit
+ */
+std::vector<float> coloredNoise(double seconds) {
+    int64_t frames = static_cast<int64_t>(seconds * RATE);
+    std::vector<float> out(static_cast<size_t>(frames) * CHANNELS);
+    double pink[CHANNELS][3] = {};
+    for (int64_t i = 0; i < frames; ++i) {
+        for (int ch = 0; ch < CHANNELS; ++ch) {
+            double white = noiseSample(i, ch) / 32768.0;
+            double* b = pink[ch];
+            b[0] = 0.99765 * b[0] + white * 0.0990460;
+            b[1] = 0.96300 * b[1] + white * 0.2965164;
+            b[2] = 0.57000 * b[2] + white * 1.0526913;
+            out[i * CHANNELS + ch] = static_cast<float>(0.05 * (b[0] + b[1] + b[2] + white * 0.1848));
+        }
+    }
+
+    float tilt[Equalizer::BANDS];
+    const float coloring[Equalizer::BANDS] = {8, 8, 4, 0, 0, 0, 0, -4, -8, -8};
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        tilt[band] = AdaptiveEq::REFERENCE_TILT_DB_PER_OCTAVE * (band - 5);
+    }
+    for (const float* gains : {static_cast<const float*>(tilt), coloring}) {
+        Equalizer eq;
+        eq.configure(CHANNELS);
+        eq.post(Equalizer::design(RATE, gains));
+        eq.process(out.data(), static_cast<int32_t>(frames));
+    }
+    return out;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FILTERS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(bandsHitTheirGainAndFlatIsBitExact) {
+    float gains[Equalizer::BANDS] = {};
+    gains[1] = -6.0f;                                   // 63 Hz
+    gains[5] = 6.0f;                                    // 1 kHz
+    Equalizer eq;
+    eq.configure(CHANNELS);
+    eq.post(Equalizer::design(RATE, gains));
+
+    double at63 = gainThrough(eq, 63.0);
+    double at1k = gainThrough(eq, 1000.0);
+    double at8k = gainThrough(eq, 8000.0);
+    std::printf("  63 Hz %+.3f dB, 1 kHz %+.3f dB, 8 kHz %+.3f dB\n", at63, at1k, at8k);
+    EXPECT_NEAR(at63, -6.0, 0.1);
+    EXPECT_NEAR(at1k, 6.0, 0.05);
+    EXPECT_NEAR(at8k, 0.0, 0.2);
+    EXPECT_TRUE(!eq.isFlat());
+
+    // Out-of-range gains are clamped, bands past 0.45 fs stay flat
+    gains[9] = 40.0f;
+    Equalizer::Coefficients clamped = Equalizer::design(RATE, gains);
+    EXPECT_EQ(clamped.gainsDb[9], Equalizer::MAX_GAIN_DB);
+    EXPECT_TRUE((Equalizer::design(32000, gains).activeMask & (1u << 9)) == 0);
+
+    // Back to flat: not a bit changes
+    float flat[Equalizer::BANDS] = {};
+    eq.post(Equalizer::design(RATE, flat));
+    std::vector<float> noise(BURST * CHANNELS);
+    for (size_t i = 0; i < noise.size(); ++i) noise[i] = noiseSample(i / CHANNELS, i % CHANNELS) / 32768.0f;
+    std::vector<float> processed = noise;
+    eq.process(processed.data(), BURST);
+    EXPECT_TRUE(eq.isFlat());
+    EXPECT_TRUE(processed == noise);
+}
+
+FTL_TEST(curvesMapOntoBands) {
+    float bands[Equalizer::BANDS];
+
+    // A constant curve of any resolution stays constant
+    std::vector<float> constant(32, 3.0f);
+    Equalizer::mapCurve(constant.data(), static_cast<int>(constant.size()), bands);
+    for (float gain : bands) EXPECT_NEAR(gain, 3.0, 1e-5);
+
+    // A ramp over log frequency lands on the bands' positions
+    std::vector<float> ramp(31);
+    for (size_t i = 0; i < ramp.size(); ++i) ramp[i] = static_cast<float>(i);
+    Equalizer::mapCurve(ramp.data(), static_cast<int>(ramp.size()), bands);
+    for (int band = 0; band < Equalizer::BANDS; ++band) {
+        double expected = std::log(Equalizer::bandFrequency(band) / 20.0) / std::log(1000.0) * 30.0;
+        EXPECT_NEAR(bands[band], expected, 1e-4);
+    }
+
+    // Band-resolution curves are taken as is
+    float exact[Equalizer::BANDS] = {1, -2, 3, -4, 5, -6, 7, -8, 9, -10};
+    Equalizer::mapCurve(exact, Equalizer::BANDS, bands);
+    for (int band = 0; band < Equalizer::BANDS; ++band) EXPECT_EQ(bands[band], exact[band]);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ADAPTIVE LOOP
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(adaptiveLoopCorrectsTiltThenHolds) {
+    Equalizer eq;
+    eq.configure(CHANNELS);
+    AdaptiveEq adaptive;
+    adaptive.configure(&eq, RATE, CHANNELS, BURST);
+    adaptive.setAdaptive(true, 1.0f);
+
+    constexpr int32_t UPDATE_FRAMES = RATE * AdaptiveEq::UPDATE_INTERVAL_MS / 1000;
+    std::vector<float> program = coloredNoise(30.0);
+    int32_t frames = static_cast<int32_t>(program.size() / CHANNELS);
+
+    float previous[Equalizer::BANDS] = {};
+    float largestStep = 0.0f;
+    int updates = 0;
+    int lateMoves = 0;
+    for (int32_t done = 0; done + UPDATE_FRAMES <= frames; done += UPDATE_FRAMES) {
+        for (int32_t burst = 0; burst < UPDATE_FRAMES; burst += BURST) {
+            adaptive.tap(program.data() + static_cast<size_t>(done + burst) * CHANNELS,
+                         std::min(BURST, UPDATE_FRAMES - burst));
+        }
+        bool moved = adaptive.update();
+        if (done >= frames - 10 * RATE && moved) ++lateMoves;
+        float applied[Equalizer::BANDS];
+        adaptive.appliedGains(applied);
+        for (int band = 0; band < Equalizer::BANDS; ++band) {
+            largestStep = std::max(largestStep, std::fabs(applied[band] - previous[band]));
+            previous[band] = applied[band];
+        }
+        ++updates;
+    }
+
+    std::printf("  %d updates, largest step %.2f dB, %d moves in the last 10 s:", updates, largestStep, lateMoves);
+    for (float gain : previous) std::printf(" %+.1f", gain);
+    std::printf("\n");
+    EXPECT_LE(largestStep, AdaptiveEq::MAX_STEP_DB + 1e-4f);
+    for (float gain : previous) {
+        EXPECT_TRUE(gain >= AdaptiveEq::MAX_CUT_DB - 1e-4f && gain <= AdaptiveEq::MAX_BOOST_DB + 1e-4f);
+    }
+    // Too much bass, too little air
+    EXPECT_TRUE(previous[0] < -2.0f && previous[1] < -2.0f);
+    EXPECT_TRUE(previous[7] > 2.0f && previous[8] > 2.0f);
+    // Hysteresis: the converged estimate no longer nudges the filters every update
+    EXPECT_LE(lateMoves, 10);
+
+    // Disabling goes straight back to the curve
+    adaptive.setAdaptive(false, 1.0f);
+    float applied[Equalizer::BANDS];
+    adaptive.appliedGains(applied);
+    for (float gain : applied) EXPECT_EQ(gain, 0.0f);
+    EXPECT_TRUE(!adaptive.update());
+}
+
+FTL_TEST(adaptiveLoopIgnoresSilence) {
+    Equalizer eq;
+    eq.configure(CHANNELS);
+    AdaptiveEq adaptive;
+    adaptive.configure(&eq, RATE, CHANNELS, BURST);
+    adaptive.setAdaptive(true, 1.0f);
+
+    std::vector<float> silence(static_cast<size_t>(BURST) * CHANNELS, 0.0f);
+    for (int update = 0; update < 20; ++update) {
+        for (int32_t burst = 0; burst < RATE / 4; burst += BURST) adaptive.tap(silence.data(), BURST);
+        EXPECT_TRUE(!adaptive.update());
+    }
+    float applied[Equalizer::BANDS];
+    adaptive.appliedGains(applied);
+    for (float gain : applied) EXPECT_EQ(gain, 0.0f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(engineTakesNewCurveWhilePlaying) {
+    std::string path = tempPath("eq_tone.wav");
+    ASSERT_TRUE(writeWav16(path, makeSineSignal(RATE * 5, 2, RATE, 1000.0, 0.25), 2, RATE));
+
+    struct Peak {
+        static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+            float peak = 0.0f;
+            for (int32_t i = 0; i < numFrames; ++i) peak = std::max(peak, std::fabs(frames[i * channelCount]));
+            static_cast<std::atomic<float>*>(userData)->store(peak);
+        }
+    };
+    std::atomic<float> peak{0.0f};
+    host::setOutputTap(&Peak::tap, &peak);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_NEAR(peak.load(), 0.25f, 1e-3);
+
+    // +6 dB at 1 kHz, no restart
+    float curve[Equalizer::BANDS] = {};
+    curve[5] = 6.0f;
+    EXPECT_TRUE(engine.setEqualizer(true, curve, Equalizer::BANDS) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    float applied[Equalizer::BANDS];
+    EXPECT_EQ(engine.getEqualizerGains(applied, Equalizer::BANDS), Equalizer::BANDS);
+    EXPECT_EQ(applied[5], 6.0f);
+    EXPECT_NEAR(20.0f * std::log10(peak.load() / 0.25f), 6.0f, 0.05f);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+
+    EXPECT_TRUE(engine.setAdaptiveEq(true, 2.0f) != EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setEqualizer(true, nullptr, 0) != EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setEqualizer(false, nullptr, 0) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_NEAR(peak.load(), 0.25f, 1e-3);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
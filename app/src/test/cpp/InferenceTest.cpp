@@ -0,0 +1,357 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - NATIVE INFERENCE TESTS        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * SIMD kernels match a scalar reference at every depth and stride; int8
+ * models track their float originals closely enough to give the same
+ * answers; .ftlm images round-trip and corrupt ones are rejected;
+ * features respond to the signal; batch tagging of files matches
+ * single-clip analysis and skips what it cannot decode.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AudioFeatures.h"
+#include "AudioSource.h"
+#include "InferenceKernels.h"
+#include "InferenceModel.h"
+#include "LibraryTagger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+
+struct Random {
+    uint32_t state;
+    explicit Random(uint32_t seed) : state(seed) {}
+    float uniform() {   // -1 .. 1
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state) * (2.0f / 4294967296.0f) - 1.0f;
+    }
+};
+
+/** He-style initialized layer, so activations keep a sane range through the stack */
+LayerSpec randomLayer(LayerType type, int depth, int outputs, Activation activation, Random& random,
+                      int kernel = 1, int stride = 1) {
+    LayerSpec layer;
+    layer.type = type;
+    layer.activation = activation;
+    layer.outputs = outputs;
+    layer.kernel = kernel;
+    layer.stride = stride;
+    float scale = std::sqrt(6.0f / depth);
+    layer.weights.resize(static_cast<size_t>(depth) * outputs);
+    for (float& w : layer.weights) w = random.uniform() * scale;
+    layer.bias.resize(outputs);
+    for (float& b : layer.bias) b = random.uniform() * 0.1f;
+    return layer;
+}
+
+ModelSpec genreMlp(uint32_t seed) {
+    Random random(seed);
+    ModelSpec spec;
+    spec.inputChannels = FEATURE_SIZE;
+    spec.layers.push_back(randomLayer(LayerType::DENSE, FEATURE_SIZE, 256, Activation::RELU, random));
+    spec.layers.push_back(randomLayer(LayerType::DENSE, 256, 128, Activation::RELU, random));
+    spec.layers.push_back(randomLayer(LayerType::DENSE, 128, 10, Activation::SOFTMAX, random));
+    return spec;
+}
+
+/** Feature vector read as a (128, 1) sequence: two strided convolutions, pooled */
+ModelSpec moodCnn(uint32_t seed) {
+    Random random(seed);
+    ModelSpec spec;
+    spec.inputLength = FEATURE_SIZE;
+    spec.inputChannels = 1;
+    spec.layers.push_back(randomLayer(LayerType::CONV1D, 8, 16, Activation::RELU, random, 8, 2));
+    spec.layers.push_back(randomLayer(LayerType::CONV1D, 5 * 16, 32, Activation::RELU, random, 5, 2));
+    LayerSpec pool;
+    pool.type = LayerType::GLOBAL_AVERAGE_POOL;
+    spec.layers.push_back(pool);
+    spec.layers.push_back(randomLayer(LayerType::DENSE, 32, 8, Activation::SOFTMAX, random));
+    return spec;
+}
+
+ModelSpec eqMlp(uint32_t seed) {
+    Random random(seed);
+    ModelSpec spec;
+    spec.inputChannels = FEATURE_SIZE;
+    spec.layers.push_back(randomLayer(LayerType::DENSE, FEATURE_SIZE, 64, Activation::TANH, random));
+    spec.layers.push_back(randomLayer(LayerType::DENSE, 64, 32, Activation::NONE, random));
+    return spec;
+}
+
+std::vector<float> randomInputs(int count, int size, uint32_t seed) {
+    Random random(seed);
+    std::vector<float> inputs(static_cast<size_t>(count) * size);
+    for (float& x : inputs) x = random.uniform() * 2.0f;
+    return inputs;
+}
+
+int argmaxOf(const float* row, int count) {
+    return static_cast<int>(std::max_element(row, row + count) - row);
+}
+
+/** Sine plus optional noise, stereo 16-bit WAV */
+bool writeClip(const std::string& path, double seconds, double hz, double noise) {
+    int64_t frames = static_cast<int64_t>(seconds * RATE);
+    std::vector<int16_t> samples = makeSineSignal(frames, 2, RATE, hz, 0.4);
+    for (int64_t i = 0; i < frames * 2; ++i) {
+        samples[i] = static_cast<int16_t>(samples[i] + noise * noiseSample(i / 2, static_cast<int>(i % 2)));
+    }
+    return writeWav16(path, samples, 2, RATE);
+}
+
+std::vector<float> decodeAll(const std::string& path) {
+    std::vector<float> samples;
+    std::unique_ptr<AudioSource> source = openAudioSource(path);
+    if (!source) return samples;
+    std::vector<float> chunk(4096 * 2);
+    int32_t frames;
+    while ((frames = source->read(chunk.data(), 4096)) > 0) {
+        samples.insert(samples.end(), chunk.begin(), chunk.begin() + frames * 2);
+    }
+    return samples;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// KERNELS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(kernelsMatchReference) {
+    Random random(7);
+    // Depths around the 4- and 16-wide vector steps, outputs around the 4-row blocks
+    for (int depth : {1, 3, 4, 15, 16, 17, 37, 128}) {
+        for (int outputs : {1, 4, 7}) {
+            const int rows = 3;
+            const int stride = depth + 5;   // Rows read at a stride, like Conv1D windows
+            std::vector<float> x(static_cast<size_t>(rows) * stride), w(static_cast<size_t>(outputs) * depth);
+            for (float& v : x) v = random.uniform();
+            for (float& v : w) v = random.uniform();
+            std::vector<int8_t> qx(x.size()), qw(w.size());
+            for (size_t i = 0; i < x.size(); ++i) qx[i] = static_cast<int8_t>(std::lrint(x[i] * 127.0f));
+            for (size_t i = 0; i < w.size(); ++i) qw[i] = static_cast<int8_t>(std::lrint(w[i] * 127.0f));
+
+            std::vector<float> out(static_cast<size_t>(rows) * outputs);
+            std::vector<int32_t> qout(out.size());
+            nn::dotRowsF32(x.data(), rows, stride, w.data(), depth, outputs, out.data());
+            nn::dotRowsI8(qx.data(), rows, stride, qw.data(), depth, outputs, qout.data());
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < outputs; ++c) {
+                    double reference = 0.0;
+                    int32_t exact = 0;
+                    for (int k = 0; k < depth; ++k) {
+                        reference += static_cast<double>(x[r * stride + k]) * w[c * depth + k];
+                        exact += qx[r * stride + k] * qw[c * depth + k];
+                    }
+                    EXPECT_NEAR(out[r * outputs + c], reference, 1e-4);
+                    EXPECT_EQ(qout[r * outputs + c], exact);
+                }
+            }
+        }
+    }
+
+    // Full-scale int8 at depth 4096 stays exact (no int16 saturation)
+    std::vector<int8_t> extreme(4096 * 2);
+    for (size_t i = 0; i < extreme.size(); ++i) extreme[i] = (i % 3 == 0) ? -127 : 127;
+    int32_t sum = 0;
+    nn::dotRowsI8(extreme.data(), 1, 4096, extreme.data() + 4096, 4096, 1, &sum);
+    int32_t expected = 0;
+    for (int k = 0; k < 4096; ++k) expected += extreme[k] * extreme[4096 + k];
+    EXPECT_EQ(sum, expected);
+
+    int8_t quantized[3];
+    const float values[3] = {-2.0f, 0.5f, 1.0f};
+    float scale = nn::quantizeSymmetric(values, 3, quantized);
+    EXPECT_NEAR(scale, 2.0f / 127.0f, 1e-7);
+    EXPECT_EQ(static_cast<int>(quantized[0]), -127);
+    EXPECT_EQ(static_cast<int>(quantized[1]), 32);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MODELS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(int8TracksFloat) {
+    constexpr int COUNT = 256;
+    for (int variant = 0; variant < 2; ++variant) {
+        ModelSpec spec = variant == 0 ? genreMlp(11) : moodCnn(12);
+        InferenceModel reference, quantized;
+        ASSERT_TRUE(reference.build(spec, InferencePrecision::FLOAT32));
+        ASSERT_TRUE(quantized.build(spec, InferencePrecision::INT8));
+        EXPECT_EQ(reference.inputSize(), FEATURE_SIZE);
+        const int outputs = reference.outputSize();
+        EXPECT_EQ(outputs, variant == 0 ? 10 : 8);
+
+        std::vector<float> inputs = randomInputs(COUNT, FEATURE_SIZE, 99 + variant);
+        std::vector<float> expected(static_cast<size_t>(COUNT) * outputs), actual(expected.size());
+        reference.run(inputs.data(), COUNT, expected.data());
+        quantized.run(inputs.data(), COUNT, actual.data());
+
+        double largestError = 0.0;
+        int agree = 0;
+        for (int i = 0; i < COUNT; ++i) {
+            const float* e = expected.data() + i * outputs;
+            const float* a = actual.data() + i * outputs;
+            for (int c = 0; c < outputs; ++c) largestError = std::max(largestError, std::fabs(double(e[c]) - a[c]));
+            agree += argmaxOf(e, outputs) == argmaxOf(a, outputs) ? 1 : 0;
+        }
+        std::printf("  %s: %lld MACs, largest probability error %.4f, top-1 agreement %d/%d\n",
+                    variant == 0 ? "mlp" : "cnn", static_cast<long long>(reference.macsPerInference()),
+                    largestError, agree, COUNT);
+        EXPECT_TRUE(largestError < 0.05);
+        EXPECT_TRUE(agree >= COUNT * 95 / 100);
+
+        // A batch gives exactly what one-at-a-time does
+        std::vector<float> single(outputs);
+        for (int i : {0, 17, COUNT - 1}) {
+            quantized.run(inputs.data() + i * FEATURE_SIZE, 1, single.data());
+            for (int c = 0; c < outputs; ++c) EXPECT_EQ(single[c], actual[i * outputs + c]);
+        }
+    }
+}
+
+FTL_TEST(modelImagesRoundTrip) {
+    ModelSpec spec = moodCnn(21);
+    std::vector<uint8_t> image = encodeModel(spec);
+    std::string path = tempPath("mood.ftlm");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_TRUE(file != nullptr);
+    std::fwrite(image.data(), 1, image.size(), file);
+    std::fclose(file);
+
+    InferenceModel built, loaded;
+    ASSERT_TRUE(built.build(spec, InferencePrecision::INT8));
+    ASSERT_TRUE(loaded.load(path, InferencePrecision::INT8));
+    EXPECT_EQ(loaded.outputSize(), 8);
+    EXPECT_EQ(loaded.macsPerInference(), built.macsPerInference());
+    std::vector<float> input = randomInputs(1, FEATURE_SIZE, 5);
+    float a[8], b[8];
+    built.run(input.data(), 1, a);
+    loaded.run(input.data(), 1, b);
+    for (int c = 0; c < 8; ++c) EXPECT_EQ(a[c], b[c]);
+
+    // Truncated, padded, bad magic, and weights that do not match the shape
+    InferenceModel rejected;
+    EXPECT_TRUE(!rejected.loadFromMemory(image.data(), image.size() - 4, InferencePrecision::FLOAT32));
+    std::vector<uint8_t> padded(image);
+    padded.push_back(0);
+    EXPECT_TRUE(!rejected.loadFromMemory(padded.data(), padded.size(), InferencePrecision::FLOAT32));
+    std::vector<uint8_t> badMagic(image);
+    badMagic[0] = 'X';
+    EXPECT_TRUE(!rejected.loadFromMemory(badMagic.data(), badMagic.size(), InferencePrecision::FLOAT32));
+    EXPECT_TRUE(!rejected.load(tempPath("missing.ftlm"), InferencePrecision::FLOAT32));
+    ModelSpec broken = genreMlp(3);
+    broken.layers[1].weights.pop_back();
+    EXPECT_TRUE(!rejected.build(broken, InferencePrecision::INT8));
+    EXPECT_TRUE(!rejected.isLoaded());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FEATURES & TAGGING
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(featuresFollowTheSignal) {
+    constexpr int FRAMES = RATE * 2;
+    std::vector<float> tone(FRAMES * 2), noise(FRAMES * 2);
+    Random random(3);
+    for (int n = 0; n < FRAMES; ++n) {
+        float t = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 440.0 * n / RATE));
+        float r = random.uniform() * 0.5f;
+        tone[n * 2] = tone[n * 2 + 1] = t;
+        noise[n * 2] = noise[n * 2 + 1] = r;
+    }
+
+    FeatureExtractor extractor;
+    float toneFeatures[FEATURE_SIZE], noiseFeatures[FEATURE_SIZE], silent[FEATURE_SIZE];
+    extractor.extract(tone.data(), FRAMES, 2, RATE, toneFeatures);
+    extractor.extract(noise.data(), FRAMES, 2, RATE, noiseFeatures);
+
+    // Statistics in the slots the Kotlin fallback uses
+    EXPECT_NEAR(toneFeatures[1], 0.5f, 1e-3);
+    EXPECT_NEAR(toneFeatures[2], 0.5f / std::sqrt(2.0f), 1e-3);
+    EXPECT_NEAR(toneFeatures[3], 2.0f * 440.0f / RATE, 1e-3);
+
+    // Centroid (116) and flatness (122): noise is bright and flat, a tone is neither
+    EXPECT_TRUE(noiseFeatures[116] > 0.4f && toneFeatures[116] < 0.05f);
+    EXPECT_TRUE(noiseFeatures[122] > 0.3f && toneFeatures[122] < 0.01f);
+    // 440 Hz lands in the 8th mel band; noise spreads across all of them
+    const float* toneMel = toneFeatures + 4;
+    const float* noiseMel = noiseFeatures + 4;
+    int toneBand = static_cast<int>(std::max_element(toneMel, toneMel + FEATURE_MEL_BANDS) - toneMel);
+    EXPECT_TRUE(toneBand >= 6 && toneBand <= 8);
+    EXPECT_TRUE(*std::min_element(noiseMel, noiseMel + FEATURE_MEL_BANDS) > -7.0f);
+
+    std::vector<float> zeros(RATE);
+    extractor.extract(zeros.data(), RATE / 2, 2, RATE, silent);
+    for (float value : silent) EXPECT_TRUE(std::isfinite(value));
+    EXPECT_EQ(silent[2], 0.0f);
+}
+
+FTL_TEST(batchTaggingMatchesSingleClips) {
+    LibraryTagger tagger;
+    std::vector<std::string> paths;
+    EXPECT_TRUE(!tagger.start(paths));   // No model yet
+    ASSERT_TRUE(tagger.setModel(TagModel::GENRE, genreMlp(31), InferencePrecision::INT8));
+    ASSERT_TRUE(tagger.setModel(TagModel::MOOD, moodCnn(32), InferencePrecision::INT8));
+    ASSERT_TRUE(tagger.setModel(TagModel::EQ, eqMlp(33), InferencePrecision::INT8));
+    ModelSpec wrongInput = eqMlp(34);
+    wrongInput.inputChannels = 64;
+    wrongInput.layers[0].weights.resize(64 * 64);
+    EXPECT_TRUE(!tagger.setModel(TagModel::EQ, wrongInput, InferencePrecision::INT8));
+    EXPECT_TRUE(tagger.hasModel(TagModel::EQ));
+
+    // More files than one batch, with an unreadable one in the middle
+    for (int i = 0; i < TAG_BATCH + 3; ++i) {
+        std::string path = tempPath("tag_" + std::to_string(i) + ".wav");
+        ASSERT_TRUE(writeClip(path, 1.0 + 0.1 * i, 110.0 * (1 + i % 7), 0.05 * (i % 4)));
+        paths.push_back(path);
+    }
+    paths.insert(paths.begin() + 5, tempPath("missing.wav"));
+
+    ASSERT_TRUE(tagger.start(paths));
+    EXPECT_TRUE(!tagger.start(paths) || !tagger.isRunning());
+    tagger.wait();
+    EXPECT_TRUE(!tagger.isRunning());
+    EXPECT_EQ(tagger.completed(), static_cast<int>(paths.size()));
+    EXPECT_EQ(tagger.total(), static_cast<int>(paths.size()));
+
+    std::vector<TrackTags> tags = tagger.results();
+    ASSERT_TRUE(tags.size() == paths.size());
+    EXPECT_TRUE(!tags[5].analyzed);
+    EXPECT_EQ(tags[5].genre, -1);
+    for (size_t i : {size_t(0), size_t(4), size_t(6), paths.size() - 1}) {
+        EXPECT_TRUE(tags[i].path == paths[i]);
+        EXPECT_TRUE(tags[i].analyzed);
+        EXPECT_TRUE(tags[i].genre >= 0 && tags[i].genre < 10);
+        EXPECT_TRUE(tags[i].mood >= 0 && tags[i].mood < 8);
+        EXPECT_EQ(tags[i].eq.size(), static_cast<size_t>(32));
+
+        // Whole (short) files are the analysis clip, so single-clip analysis agrees
+        std::vector<float> clip = decodeAll(paths[i]);
+        TrackTags single;
+        ASSERT_TRUE(tagger.analyze(clip.data(), static_cast<int64_t>(clip.size() / 2), 2, RATE, single));
+        EXPECT_EQ(single.genre, tags[i].genre);
+        EXPECT_EQ(single.genreConfidence, tags[i].genreConfidence);
+        EXPECT_EQ(single.mood, tags[i].mood);
+        EXPECT_TRUE(single.eq == tags[i].eq);
+    }
+
+    // Cancelling stops between files and keeps what was finished
+    ASSERT_TRUE(tagger.start(paths));
+    tagger.cancel();
+    tagger.wait();
+    EXPECT_TRUE(tagger.completed() <= static_cast<int>(paths.size()));
+    for (const TrackTags& t : tagger.results()) EXPECT_TRUE(!t.path.empty());
+}
@@ -0,0 +1,261 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - LIBRARY SNAPSHOT TESTS        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Columnar library snapshots: every field round-trips, strings are
+ * interned, the four view orders match a plain sort of the same rows,
+ * and truncated or foreign files are refused. A 100k-track snapshot
+ * reports its size and time to the first screen of rows.
+ */
+
+#include "TestHarness.h"
+
+#include "LibrarySnapshot.h"
+#include "SearchIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <tuple>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+SnapshotTrack track(int64_t id, const char* title, const char* artist, const char* album,
+                    uint32_t trackNumber, uint32_t sampleRate, uint32_t bitDepth) {
+    SnapshotTrack t;
+    t.id = id;
+    t.title = title;
+    t.artist = artist;
+    t.album = album;
+    t.trackNumber = trackNumber;
+    t.sampleRate = sampleRate;
+    t.bitDepth = bitDepth;
+    t.flags = sampleRate > 48000 || bitDepth > 16 ? SNAPSHOT_FLAG_HI_RES : 0;
+    t.durationMs = 1000 * id;
+    t.fileSize = 4096 * id;
+    t.dateAdded = 1700000000000 + id;
+    t.bitRate = sampleRate * bitDepth * 2;
+    t.channels = 2;
+    t.year = 1970 + static_cast<uint32_t>(id);
+    t.filePath = "/music/" + std::to_string(id) + ".flac";
+    t.mimeType = "audio/x-flac";
+    t.codec = "FLAC";
+    return t;
+}
+
+std::vector<SnapshotTrack> smallLibrary() {
+    return {
+        track(1, "Come Together", "The Beatles", "Abbey Road", 1, 44100, 16),
+        track(2, "Something", "The Beatles", "Abbey Road", 2, 96000, 24),
+        track(3, "\xC3\x89" "clair", "Beyonc\xC3\xA9", "Dangerously", 3, 48000, 24),
+        track(4, "eclipse", "Pink Floyd", "Dark Side", 10, 192000, 24),
+        track(5, "Brain Damage", "Pink Floyd", "Dark Side", 9, 44100, 16),
+        track(6, "Airbag", "Radiohead", "OK Computer", 1, 44100, 16),
+    };
+}
+
+std::vector<int64_t> idsInOrder(const LibrarySnapshot& snapshot, SnapshotOrder order) {
+    std::vector<int64_t> ids;
+    const uint32_t* rows = snapshot.order(order);
+    for (uint32_t i = 0; i < snapshot.rowCount(); ++i) ids.push_back(snapshot.wideColumn(COLUMN_ID)[rows[i]]);
+    return ids;
+}
+
+bool sameTrack(const SnapshotTrack& a, const SnapshotTrack& b) {
+    return std::tie(a.id, a.durationMs, a.fileSize, a.dateAdded, a.sampleRate, a.bitRate, a.channels,
+                    a.bitDepth, a.year, a.trackNumber, a.flags, a.title, a.artist, a.album, a.filePath,
+                    a.mimeType, a.codec) ==
+           std::tie(b.id, b.durationMs, b.fileSize, b.dateAdded, b.sampleRate, b.bitRate, b.channels,
+                    b.bitDepth, b.year, b.trackNumber, b.flags, b.title, b.artist, b.album, b.filePath,
+                    b.mimeType, b.codec);
+}
+
+bool writeBytes(const std::string& path, const std::string& bytes) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+std::string readBytes(const std::string& path) {
+    std::string bytes;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return bytes;
+    char buffer[4096];
+    size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.append(buffer, got);
+    std::fclose(file);
+    return bytes;
+}
+
+} // namespace
+
+FTL_TEST(rowsRoundTripWithInternedStrings) {
+    std::vector<SnapshotTrack> tracks = smallLibrary();
+    std::string path = tempPath("library_small.ftlsnap");
+    SnapshotWriteStats stats;
+    ASSERT_TRUE(LibrarySnapshot::write(path, tracks, 1234, &stats));
+    EXPECT_EQ(stats.rows, 6u);
+    // 6 titles, 4 artists, 4 albums, 6 paths, one MIME type and one codec
+    EXPECT_EQ(stats.strings, 22u);
+
+    LibrarySnapshot snapshot;
+    ASSERT_TRUE(snapshot.map(path));
+    EXPECT_EQ(snapshot.rowCount(), 6u);
+    EXPECT_EQ(snapshot.header().createdMs, static_cast<int64_t>(1234));
+    EXPECT_EQ(snapshot.header().fileBytes, static_cast<uint64_t>(snapshot.mappedBytes()));
+    for (uint32_t row = 0; row < tracks.size(); ++row) {
+        EXPECT_TRUE(sameTrack(snapshot.track(row), tracks[row]));
+    }
+    // Both Beatles rows point at one string
+    EXPECT_EQ(snapshot.narrowColumn(COLUMN_ARTIST)[0], snapshot.narrowColumn(COLUMN_ARTIST)[1]);
+    EXPECT_EQ(snapshot.narrowColumn(COLUMN_CODEC)[0], snapshot.narrowColumn(COLUMN_CODEC)[5]);
+
+    // Out of range reads are empty, never past the mapping
+    EXPECT_TRUE(snapshot.track(6).title.empty());
+    uint32_t length = 99;
+    snapshot.string(stats.strings, length);
+    EXPECT_EQ(length, 0u);
+
+    // An empty library is a valid snapshot
+    ASSERT_TRUE(LibrarySnapshot::write(path, {}, 0));
+    ASSERT_TRUE(snapshot.map(path));
+    EXPECT_EQ(snapshot.rowCount(), 0u);
+}
+
+FTL_TEST(ordersMatchTheLibraryViews) {
+    std::string path = tempPath("library_orders.ftlsnap");
+    ASSERT_TRUE(LibrarySnapshot::write(path, smallLibrary(), 0));
+    LibrarySnapshot snapshot;
+    ASSERT_TRUE(snapshot.map(path));
+
+    // Folded titles: "Éclair" before "eclipse", case ignored
+    EXPECT_TRUE(idsInOrder(snapshot, ORDER_TITLE) == (std::vector<int64_t>{6, 5, 1, 3, 4, 2}));
+    // Artist, album, then track number (9 before 10)
+    EXPECT_TRUE(idsInOrder(snapshot, ORDER_ARTIST) == (std::vector<int64_t>{3, 5, 4, 6, 1, 2}));
+    EXPECT_TRUE(idsInOrder(snapshot, ORDER_ALBUM) == (std::vector<int64_t>{1, 2, 3, 5, 4, 6}));
+    // Hi-res first, highest rate and depth first; the rest by title
+    EXPECT_TRUE(idsInOrder(snapshot, ORDER_SAMPLE_RATE) == (std::vector<int64_t>{4, 2, 3, 6, 5, 1}));
+    EXPECT_EQ(snapshot.header().hiResCount, 3u);
+}
+
+FTL_TEST(invalidFilesAreRefused) {
+    std::string path = tempPath("library_valid.ftlsnap");
+    ASSERT_TRUE(LibrarySnapshot::write(path, smallLibrary(), 0));
+    std::string bytes = readBytes(path);
+    ASSERT_TRUE(bytes.size() > sizeof(SnapshotHeader));
+
+    LibrarySnapshot snapshot;
+    std::string broken = tempPath("library_broken.ftlsnap");
+    EXPECT_TRUE(!snapshot.map(tempPath("library_missing.ftlsnap")));
+
+    ASSERT_TRUE(writeBytes(broken, bytes.substr(0, bytes.size() - 1)));
+    EXPECT_TRUE(!snapshot.map(broken));
+
+    std::string magic = bytes;
+    magic[0] = 'X';
+    ASSERT_TRUE(writeBytes(broken, magic));
+    EXPECT_TRUE(!snapshot.map(broken));
+
+    std::string version = bytes;
+    version[8] = static_cast<char>(SNAPSHOT_VERSION + 1);
+    ASSERT_TRUE(writeBytes(broken, version));
+    EXPECT_TRUE(!snapshot.map(broken));
+
+    // A section pointing past the end
+    std::string section = bytes;
+    uint64_t past = bytes.size();
+    std::memcpy(&section[sizeof(SnapshotHeader) + 3 * sizeof(uint64_t)], &past, sizeof(past));
+    ASSERT_TRUE(writeBytes(broken, section));
+    EXPECT_TRUE(!snapshot.map(broken));
+
+    ASSERT_TRUE(writeBytes(broken, bytes));
+    EXPECT_TRUE(snapshot.map(broken));
+}
+
+FTL_TEST(largeLibraryOrdersAgreeWithSort) {
+    constexpr int TRACKS = 100000;
+    constexpr uint32_t FIRST_SCREEN = 50;
+    std::mt19937 rng(7);
+    const char* const words[] = {"love", "Night", "\xC3\xA9t\xC3\xA9", "blue", "Stone", "river", "Sun", "zero",
+                                 "ghost", "Echo", "fire", "gold", "HEART", "rain", "wild", "dream"};
+    auto phrase = [&](int count) {
+        std::string text;
+        for (int w = 0; w < count; ++w) text += (w ? " " : "") + std::string(words[rng() % 16]);
+        return text;
+    };
+    std::vector<std::string> artists, albums;
+    for (int i = 0; i < TRACKS / 20; ++i) artists.push_back(phrase(2));
+    for (int i = 0; i < TRACKS / 10; ++i) albums.push_back(phrase(3));
+
+    std::vector<SnapshotTrack> tracks;
+    tracks.reserve(TRACKS);
+    const uint32_t rates[] = {44100, 48000, 96000, 192000};
+    for (int i = 0; i < TRACKS; ++i) {
+        SnapshotTrack t = track(i + 1, "", "", "", 1 + rng() % 20, rates[rng() % 4], rng() % 3 ? 16 : 24);
+        t.title = phrase(1 + static_cast<int>(rng() % 4));
+        t.artist = artists[rng() % artists.size()];
+        t.album = albums[rng() % albums.size()];
+        t.filePath = "/storage/emulated/0/Music/" + t.artist + "/" + t.album + "/" + std::to_string(i) + ".flac";
+        tracks.push_back(std::move(t));
+    }
+
+    std::string path = tempPath("library_large.ftlsnap");
+    SnapshotWriteStats stats;
+    ASSERT_TRUE(LibrarySnapshot::write(path, tracks, 0, &stats));
+
+    // Time to the first screen of title-ordered rows from a cold map
+    auto start = std::chrono::steady_clock::now();
+    LibrarySnapshot snapshot;
+    ASSERT_TRUE(snapshot.map(path));
+    std::vector<SnapshotTrack> screen;
+    for (uint32_t i = 0; i < FIRST_SCREEN; ++i) screen.push_back(snapshot.track(snapshot.order(ORDER_TITLE)[i]));
+    double firstRowsMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("    %u strings, %.1f MB, written in %.0f ms, first %u rows in %.2f ms\n", stats.strings,
+                stats.bytes / (1024.0 * 1024.0), stats.seconds * 1000.0, FIRST_SCREEN, firstRowsMs);
+
+    // Every order is a permutation sorted by its keys
+    auto key = [](const std::string& s) { return std::make_pair(SearchIndex::normalize(s), s); };
+    std::vector<std::pair<std::string, std::string>> titleKey, artistKey, albumKey;
+    for (const SnapshotTrack& t : tracks) {
+        titleKey.push_back(key(t.title));
+        artistKey.push_back(key(t.artist));
+        albumKey.push_back(key(t.album));
+    }
+    for (uint32_t o = 0; o < SNAPSHOT_ORDERS; ++o) {
+        const uint32_t* rows = snapshot.order(static_cast<SnapshotOrder>(o));
+        std::vector<uint32_t> sorted(rows, rows + TRACKS);
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<uint32_t> all(TRACKS);
+        std::iota(all.begin(), all.end(), 0u);
+        EXPECT_TRUE(sorted == all);
+    }
+    const uint32_t* byTitle = snapshot.order(ORDER_TITLE);
+    const uint32_t* byArtist = snapshot.order(ORDER_ARTIST);
+    const uint32_t* byRate = snapshot.order(ORDER_SAMPLE_RATE);
+    int outOfOrder = 0;
+    for (int i = 1; i < TRACKS; ++i) {
+        if (titleKey[byTitle[i]] < titleKey[byTitle[i - 1]]) ++outOfOrder;
+        uint32_t a = byArtist[i - 1], b = byArtist[i];
+        if (std::tie(artistKey[b], albumKey[b], tracks[b].trackNumber) <
+            std::tie(artistKey[a], albumKey[a], tracks[a].trackNumber)) ++outOfOrder;
+        a = byRate[i - 1];
+        b = byRate[i];
+        if (std::make_tuple(tracks[a].flags & SNAPSHOT_FLAG_HI_RES, tracks[a].sampleRate, tracks[a].bitDepth) <
+            std::make_tuple(tracks[b].flags & SNAPSHOT_FLAG_HI_RES, tracks[b].sampleRate, tracks[b].bitDepth)) {
+            ++outOfOrder;
+        }
+    }
+    EXPECT_EQ(outOfOrder, 0);
+    for (uint32_t i = 0; i < FIRST_SCREEN; ++i) EXPECT_TRUE(sameTrack(screen[i], tracks[byTitle[i]]));
+
+    // Interning keeps repeated artists, albums and the codec to one copy each
+    EXPECT_LE(stats.strings, static_cast<uint32_t>(TRACKS * 2 + TRACKS / 20 + TRACKS / 10 + 2));
+}
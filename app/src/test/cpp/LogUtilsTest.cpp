@@ -0,0 +1,174 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║               FTL AUDIO ENGINE - LOG UTILS TESTS            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Deferred formatting prints what printf would have; messages from many
+ * threads all arrive, each thread's in order; a full real-time queue
+ * drops and counts instead of blocking; a log call stays far below the
+ * cost of formatting on the caller.
+ */
+
+#include "TestHarness.h"
+
+#include "LogUtils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ftl_audio;
+
+namespace {
+
+struct Line {
+    int level;
+    std::string tag;
+    std::string text;
+};
+
+std::mutex g_linesMutex;
+std::vector<Line> g_lines;
+
+void captureLine(int level, const char* tag, const char* text) {
+    std::lock_guard<std::mutex> lock(g_linesMutex);
+    g_lines.push_back({level, tag ? tag : "", text ? text : ""});
+}
+
+std::vector<Line> takeLines() {
+    log::flush();
+    std::lock_guard<std::mutex> lock(g_linesMutex);
+    std::vector<Line> lines;
+    lines.swap(g_lines);
+    return lines;
+}
+
+template <typename... Args>
+std::string deferred(const char* format, const Args&... args) {
+    log::Record record;
+    log::capture(record, ANDROID_LOG_INFO, "test", format, args...);
+    return log::format(record);
+}
+
+template <typename... Args>
+std::string printed(const char* format, const Args&... args) {
+    char text[1024];
+    std::snprintf(text, sizeof(text), format, args...);
+    return text;
+}
+
+} // namespace
+
+FTL_TEST(deferredFormatMatchesPrintf) {
+    std::string name = "Cyber Aqua";
+    EXPECT_EQ(deferred("%d frames, %u underruns", -42, 7u), printed("%d frames, %u underruns", -42, 7u));
+    EXPECT_EQ(deferred("%lld ns", static_cast<long long>(-1234567890123LL)),
+              printed("%lld ns", static_cast<long long>(-1234567890123LL)));
+    EXPECT_EQ(deferred("%x %X %#o", -1, 0xBEEFu, 8), printed("%x %X %#o", -1, 0xBEEFu, 8));
+    EXPECT_EQ(deferred("%hhx %hd", 0x1FF, 70000), printed("%hhx %hd", 0x1FF, 70000));
+    EXPECT_EQ(deferred("%.2f ms, %8.3e, %g", 2.345, 12345.678f, 0.0001), printed("%.2f ms, %8.3e, %g", 2.345, 12345.678f, 0.0001));
+    EXPECT_EQ(deferred("[%-10s] [%.3s] %c", name.c_str(), "abcdef", 'Z'), printed("[%-10s] [%.3s] %c", name.c_str(), "abcdef", 'Z'));
+    EXPECT_EQ(deferred("%*d|%-*.*f", 6, 42, 9, 2, 3.14159), printed("%*d|%-*.*f", 6, 42, 9, 2, 3.14159));
+    EXPECT_EQ(deferred("%zu bytes, 100%%", sizeof(log::Record)), printed("%zu bytes, 100%%", sizeof(log::Record)));
+    EXPECT_EQ(deferred("%s", static_cast<const char*>(nullptr)), std::string("(null)"));
+
+    // %s text is copied at the call, so the caller's buffer may change before the log thread runs
+    char buffer[16] = "before";
+    log::Record record;
+    log::capture(record, ANDROID_LOG_INFO, "test", "%s", buffer);
+    std::snprintf(buffer, sizeof(buffer), "after");
+    EXPECT_EQ(log::format(record), std::string("before"));
+
+    // Text beyond the record is truncated, never overrun
+    std::string longText(400, 'x');
+    std::string formatted = deferred("%s|%s", longText.c_str(), "tail");
+    EXPECT_TRUE(formatted.size() < sizeof(record.text) + 1);
+    EXPECT_TRUE(formatted.find('|') != std::string::npos);
+}
+
+FTL_TEST(everyThreadsMessagesArriveInOrder) {
+    log::setSink(captureLine);
+    takeLines();
+
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 500;               // Several times a ring, so producers wait on full rings
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                FTL_LOGW("FTL_Test", "thread %d message %d", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    FTL_LOGE("FTL_Test", "after %s", "join");
+    std::vector<Line> lines = takeLines();
+    log::setSink(nullptr);
+
+    EXPECT_EQ(lines.size(), static_cast<size_t>(THREADS * MESSAGES + 1));
+    int next[THREADS] = {};
+    bool ordered = true;
+    for (const Line& line : lines) {
+        int t = -1;
+        int i = -1;
+        if (std::sscanf(line.text.c_str(), "thread %d message %d", &t, &i) == 2 && t >= 0 && t < THREADS) {
+            ordered = ordered && i == next[t];
+            next[t] = i + 1;
+            EXPECT_EQ(line.level, static_cast<int>(ANDROID_LOG_WARN));
+            EXPECT_EQ(line.tag, std::string("FTL_Test"));
+        }
+    }
+    EXPECT_TRUE(ordered);
+    for (int t = 0; t < THREADS; ++t) EXPECT_EQ(next[t], MESSAGES);
+    EXPECT_EQ(lines.back().text, std::string("after join"));
+}
+
+FTL_TEST(realtimeQueueDropsWhenFull) {
+    log::setSink(captureLine);
+    takeLines();
+
+    // A fresh thread has no ring, so it shares the fixed real-time queue
+    uint64_t droppedBefore = log::droppedCount();
+    std::thread realtime([] {
+        for (int i = 0; i < 1000; ++i) {
+            FTL_LOGE_RT("FTL_Test", "glitch %d", i);
+        }
+    });
+    realtime.join();
+    std::vector<Line> lines = takeLines();
+    log::setSink(nullptr);
+
+    uint64_t dropped = log::droppedCount() - droppedBefore;
+    size_t delivered = 0;
+    bool sawReport = false;
+    for (const Line& line : lines) {
+        delivered += line.text.compare(0, 7, "glitch ") == 0 ? 1 : 0;
+        sawReport = sawReport || line.text.find("real-time log messages dropped") != std::string::npos;
+    }
+    EXPECT_TRUE(delivered > 0);
+    EXPECT_EQ(delivered + dropped, static_cast<uint64_t>(1000));
+    EXPECT_TRUE(dropped == 0 || sawReport);
+}
+
+FTL_TEST(logCallIsCheaperThanFormatting) {
+    log::setSink(captureLine);
+    takeLines();
+
+    constexpr int CALLS = 100;                  // Fits one ring, so no call waits for the log thread
+    double bestNs = 1e30;
+    for (int round = 0; round < 20; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < CALLS; ++i) {
+            FTL_LOGI("FTL_Test", "latency %.3f ms, %d frames, %s", 0.001 * i, 192 * i, "aaudio");
+        }
+        auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        bestNs = std::min(bestNs, ns / CALLS);
+        takeLines();
+    }
+    log::setSink(nullptr);
+    std::printf("    %.0f ns per deferred log call\n", bestNs);
+    EXPECT_LE(bestNs, 2000.0);
+}
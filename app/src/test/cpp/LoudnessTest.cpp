@@ -0,0 +1,272 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           FTL AUDIO ENGINE - LOUDNESS & LIMITER TESTS       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Meter accuracy against the EBU Tech 3341 reference signals at three
+ * sample rates, normalization from metadata and from the running
+ * estimate, the limiter's true-peak ceiling (checked with an independent
+ * 16x interpolator) and its transparency below it, the whole stage in
+ * the running engine, and the per-channel CPU cost at 48 and 192 kHz.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+#include "LoudnessMeter.h"
+#include "TruePeakLimiter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int CHANNELS = 2;
+constexpr int32_t BURST = 256;
+
+/** Stereo sine, `amplitude` in dBFS (peak), appended to `out` */
+void appendSine(std::vector<float>& out, int sampleRate, double seconds, double frequency,
+                double amplitudeDb, double phase = 0.0) {
+    double amplitude = std::pow(10.0, amplitudeDb / 20.0);
+    int64_t frames = static_cast<int64_t>(seconds * sampleRate);
+    for (int64_t i = 0; i < frames; ++i) {
+        float sample = static_cast<float>(amplitude * std::sin(2.0 * M_PI * frequency * i / sampleRate + phase));
+        for (int ch = 0; ch < CHANNELS; ++ch) out.push_back(sample);
+    }
+}
+
+double measure(const std::vector<float>& signal, int sampleRate) {
+    LoudnessMeter meter;
+    meter.configure(sampleRate, CHANNELS);
+    int32_t frames = static_cast<int32_t>(signal.size() / CHANNELS);
+    for (int32_t done = 0; done < frames; done += BURST) {
+        meter.process(signal.data() + done * CHANNELS, std::min(BURST, frames - done));
+    }
+    return meter.integratedLufs();
+}
+
+/** Reference true peak: 16x windowed-sinc interpolation, 64 taps each side */
+double truePeakDb(const std::vector<float>& signal, int64_t from, int64_t to) {
+    constexpr int FACTOR = 16;
+    constexpr int HALF = 64;
+    int64_t frames = static_cast<int64_t>(signal.size() / CHANNELS);
+    double peak = 0.0;
+    for (int ch = 0; ch < CHANNELS; ++ch) {
+        for (int64_t n = std::max<int64_t>(from, HALF); n < std::min(to, frames - HALF); ++n) {
+            for (int k = 0; k < FACTOR; ++k) {
+                double t = n + static_cast<double>(k) / FACTOR;
+                double value = 0.0;
+                for (int64_t m = n - HALF + 1; m <= n + HALF; ++m) {
+                    double x = t - m;
+                    double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    double window = 0.5 + 0.5 * std::cos(M_PI * x / HALF);
+                    value += signal[m * CHANNELS + ch] * sinc * window;
+                }
+                peak = std::max(peak, std::fabs(value));
+            }
+        }
+    }
+    return 20.0 * std::log10(peak);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// METER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(meterMatchesReferenceSignals) {
+    for (int rate : {44100, 48000, 192000}) {
+        // Tech 3341 case 1: 1 kHz at -23 dBFS reads -23.0 LUFS
+        std::vector<float> tone;
+        appendSine(tone, rate, 20.0, 1000.0, -23.0);
+        double steady = measure(tone, rate);
+
+        // Case 3: the -36 dBFS sections fall under the relative gate
+        std::vector<float> gated;
+        appendSine(gated, rate, 10.0, 1000.0, -36.0);
+        appendSine(gated, rate, 60.0, 1000.0, -23.0);
+        appendSine(gated, rate, 10.0, 1000.0, -36.0);
+        double withGate = measure(gated, rate);
+
+        std::printf("  %6d Hz: case 1 %.3f LUFS, case 3 %.3f LUFS\n", rate, steady, withGate);
+        EXPECT_NEAR(steady, -23.0, 0.1);
+        EXPECT_NEAR(withGate, -23.0, 0.1);
+    }
+
+    // Silence never passes the absolute gate
+    std::vector<float> silence(48000 * 2 * CHANNELS, 0.0f);
+    EXPECT_EQ(measure(silence, 48000), LoudnessMeter::NO_MEASUREMENT_LUFS);
+}
+
+FTL_TEST(normalizerUsesMetadataThenEstimate) {
+    constexpr int RATE = 48000;
+    std::vector<float> program;
+    appendSine(program, RATE, 6.0, 440.0, -26.0);
+    int32_t frames = static_cast<int32_t>(program.size() / CHANNELS);
+
+    LoudnessNormalizer normalizer;
+    normalizer.configure(RATE, CHANNELS);
+    normalizer.setTargetLufs(-18.0f);
+
+    // Metadata wins from the first frame
+    normalizer.setTrackLoudness(-20.0f);
+    EXPECT_NEAR(normalizer.gainDb(), 2.0, 1e-6);
+
+    // Without it: unity until the estimate is trustworthy, then target - measured
+    normalizer.reset();
+    float earlyDb = 0.0f;
+    for (int32_t done = 0; done < frames; done += BURST) {
+        normalizer.process(program.data() + done * CHANNELS, std::min(BURST, frames - done));
+        if (done < RATE) earlyDb = std::max(earlyDb, std::fabs(normalizer.gainDb()));
+    }
+    double measured = normalizer.meter().integratedLufs();
+    std::printf("  measured %.2f LUFS, gain %.2f dB\n", measured, normalizer.gainDb());
+    EXPECT_EQ(earlyDb, 0.0f);
+    EXPECT_NEAR(normalizer.gainDb(), -18.0 - measured, 0.05);
+
+    // Boost is capped; a limiter is still needed for what remains
+    normalizer.setTrackLoudness(-40.0f);
+    EXPECT_NEAR(normalizer.gainDb(), LoudnessNormalizer::MAX_BOOST_DB, 1e-6);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// LIMITER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(limiterHoldsTruePeakCeiling) {
+    constexpr int RATE = 48000;
+    std::vector<float> input;
+    appendSine(input, RATE, 0.5, 1000.0, -10.0);
+    // fs/4 at 45 degrees: samples peak 3 dB under the waveform - a classic inter-sample over
+    appendSine(input, RATE, 0.5, RATE / 4.0, 4.0, M_PI / 4.0);
+    appendSine(input, RATE, 2.5, 1000.0, -10.0);
+    int32_t frames = static_cast<int32_t>(input.size() / CHANNELS);
+
+    TruePeakLimiter limiter;
+    limiter.configure(RATE, CHANNELS);
+    limiter.setCeilingDb(-1.0f);
+    std::vector<float> output = input;
+    float deepest = 0.0f;
+    for (int32_t done = 0; done < frames; done += BURST) {
+        limiter.process(output.data() + done * CHANNELS, std::min(BURST, frames - done));
+        deepest = std::min(deepest, limiter.lastReductionDb());
+    }
+    int32_t latency = limiter.latencyFrames();
+
+    double inputPeak = truePeakDb(input, RATE / 2 - 200, RATE + 200);
+    double outputPeak = truePeakDb(output, RATE / 2 - 200 + latency, RATE + 200 + latency);
+    std::printf("  true peak in %+.2f dBTP, out %+.2f dBTP, max reduction %.2f dB, latency %d frames\n",
+                inputPeak, outputPeak, deepest, latency);
+    EXPECT_TRUE(inputPeak > 3.5);
+    EXPECT_LE(outputPeak, -1.0 + 0.1);
+    EXPECT_TRUE(deepest < -4.5f);
+
+    // Below the ceiling it is a pure delay - before the over and once released
+    int64_t quietUntil = RATE / 2 - 2 * latency;
+    for (int64_t i = 0; i < quietUntil; ++i) {
+        for (int ch = 0; ch < CHANNELS; ++ch) {
+            EXPECT_EQ(output[(i + latency) * CHANNELS + ch], input[i * CHANNELS + ch]);
+        }
+    }
+    for (int64_t i = frames - RATE / 2; i < frames - latency; ++i) {
+        EXPECT_EQ(output[(i + latency) * CHANNELS], input[i * CHANNELS]);
+    }
+    EXPECT_EQ(limiter.lastReductionDb(), 0.0f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(engineAppliesTrackGainThenLimiter) {
+    constexpr int RATE = 48000;
+    std::string path = tempPath("loudness_dc.wav");
+    ASSERT_TRUE(writeWav16(path, std::vector<int16_t>(RATE * 5 * 2, 8192), 2, RATE));
+
+    struct Last {
+        static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+            static_cast<std::atomic<float>*>(userData)->store(frames[(numFrames - 1) * channelCount]);
+        }
+    };
+    std::atomic<float> last{0.0f};
+    host::setOutputTap(&Last::tap, &last);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setLoudnessNormalization(true, -18.0f) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setTrackLoudness(-24.0f) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+
+    // +6 dB from metadata
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_NEAR(last.load(), 0.25f * std::pow(10.0f, 6.0f / 20.0f), 1e-4);
+
+    // +12 dB would reach ~1.0; the limiter holds it at -6 dBTP
+    EXPECT_TRUE(engine.setTruePeakLimiter(true, -6.0f) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setTrackLoudness(-30.0f) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    float ceiling = std::pow(10.0f, -6.0f / 20.0f);
+    EXPECT_NEAR(last.load(), ceiling, 1e-3);
+    EXPECT_NEAR(engine.getLimiterReductionDb(), -6.0f, 0.1f);
+    EXPECT_TRUE(engine.setTruePeakLimiter(true, 3.0f) != EngineResult::SUCCESS);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// COST
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(perChannelCostAt48And192kHz) {
+    for (int rate : {48000, 192000}) {
+        constexpr double SECONDS = 10.0;
+        int32_t frames = static_cast<int32_t>(SECONDS * rate);
+        std::vector<float> program(static_cast<size_t>(frames) * CHANNELS);
+        for (int32_t i = 0; i < frames * CHANNELS; ++i) {
+            program[i] = noiseSample(i / CHANNELS, i % CHANNELS) / 16384.0f;  // Up to +6 dBFS
+        }
+        int32_t burst = rate / 48000 * 240;
+
+        LoudnessNormalizer normalizer;
+        normalizer.configure(rate, CHANNELS);
+        TruePeakLimiter limiter;
+        limiter.configure(rate, CHANNELS);
+
+        double meterUs = 0.0;
+        double limiterUs = 0.0;
+        for (int32_t done = 0; done + burst <= frames; done += burst) {
+            float* block = program.data() + static_cast<size_t>(done) * CHANNELS;
+            Clock::time_point start = Clock::now();
+            normalizer.process(block, burst);
+            Clock::time_point middle = Clock::now();
+            limiter.process(block, burst);
+            Clock::time_point end = Clock::now();
+            meterUs += std::chrono::duration<double, std::micro>(middle - start).count();
+            limiterUs += std::chrono::duration<double, std::micro>(end - middle).count();
+        }
+
+        // Share of one core per channel of real-time audio
+        double meterLoad = meterUs / (SECONDS * 1e6) / CHANNELS * 100.0;
+        double limiterLoad = limiterUs / (SECONDS * 1e6) / CHANNELS * 100.0;
+        std::printf("  %6d Hz per channel: meter %.3f%% + limiter %.3f%% of a core (%d-frame bursts)\n",
+                    rate, meterLoad, limiterLoad, burst);
+        EXPECT_TRUE(meterLoad + limiterLoad < 10.0);
+        EXPECT_TRUE(limiter.lastReductionDb() < 0.0f);
+    }
+}
@@ -0,0 +1,252 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - MATH UTILS TESTS            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Every kernel swept densely across its range against double-precision
+ * libm and held to the bound its header documents (MathUtils.cpp is
+ * built with -ffast-math, so this is the bound under it), batches
+ * agreeing with the single-value functions bit for bit, clamped inputs
+ * staying finite, and the wavetable oscillator tracking sin() over long
+ * runs split into bursts.
+ */
+
+#include "TestHarness.h"
+
+#include "MathUtils.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace ftl_audio;
+
+namespace {
+
+/** `count` points from `from` to `to`, evenly spaced */
+std::vector<float> sweep(double from, double to, size_t count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(from + (to - from) * static_cast<double>(i) / (count - 1));
+    }
+    return values;
+}
+
+/** `count` points from `from` to `to`, evenly spaced in log */
+std::vector<float> logSweep(double from, double to, size_t count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(from * std::pow(to / from, static_cast<double>(i) / (count - 1)));
+    }
+    return values;
+}
+
+template <typename Reference>
+double maxRelativeError(const std::vector<float>& in, const std::vector<float>& out, Reference reference) {
+    double worst = 0.0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        double expected = reference(static_cast<double>(in[i]));
+        worst = std::max(worst, std::fabs(out[i] - expected) / std::fabs(expected));
+    }
+    return worst;
+}
+
+template <typename Reference>
+double maxAbsoluteError(const std::vector<float>& in, const std::vector<float>& out, Reference reference) {
+    double worst = 0.0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        worst = std::max(worst, std::fabs(out[i] - reference(static_cast<double>(in[i]))));
+    }
+    return worst;
+}
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+constexpr size_t POINTS = 1 << 20;
+
+} // namespace
+
+FTL_TEST(expAndLogStayWithinBounds) {
+    std::vector<float> in = sweep(fastmath::EXP_MIN_INPUT, fastmath::EXP_MAX_INPUT, POINTS);
+    std::vector<float> out(in.size());
+    fastmath::exp(in.data(), out.data(), in.size());
+    double expError = maxRelativeError(in, out, [](double x) { return std::exp(x); });
+
+    std::vector<float> near1 = sweep(0.5, 2.0, POINTS);
+    out.resize(near1.size());
+    fastmath::log(near1.data(), out.data(), near1.size());
+    double logNearError = maxAbsoluteError(near1, out, [](double x) { return std::log(x); });
+
+    std::vector<float> wide = logSweep(1e-37, 1e38, POINTS);
+    std::vector<float> wideIn;
+    for (float x : wide) {
+        if (x < 0.5f || x > 2.0f) wideIn.push_back(x);
+    }
+    out.resize(wideIn.size());
+    fastmath::log(wideIn.data(), out.data(), wideIn.size());
+    double logWideError = maxRelativeError(wideIn, out, [](double x) { return std::log(x); });
+
+    std::printf("    exp rel %.3g, log abs %.3g in [0.5, 2], rel %.3g elsewhere\n", expError, logNearError,
+                logWideError);
+    EXPECT_LE(expError, 2e-7);
+    EXPECT_LE(logNearError, 1e-7);
+    EXPECT_LE(logWideError, 1.5e-7);
+}
+
+FTL_TEST(powStaysWithinBound) {
+    std::vector<float> base = logSweep(1e-6, 1e6, 4096);
+    const float exponents[] = {-3.0f, -1.0f, -0.5f, 0.25f, 1.0f / 2.4f, 2.2f, 3.0f};
+    std::vector<float> out(base.size());
+    bool bounded = true;
+    double worstExcess = 0.0;
+    for (float exponent : exponents) {
+        fastmath::pow(base.data(), exponent, out.data(), base.size());
+        for (size_t i = 0; i < base.size(); ++i) {
+            double expected = std::pow(static_cast<double>(base[i]), static_cast<double>(exponent));
+            double error = std::fabs(out[i] - expected) / expected;
+            double bound = 2.5e-7 + std::fabs(exponent * std::log(static_cast<double>(base[i]))) * 1.2e-7;
+            worstExcess = std::max(worstExcess, error / bound);
+            bounded = bounded && error <= bound;
+        }
+    }
+    std::printf("    pow at %.2f of its bound\n", worstExcess);
+    EXPECT_TRUE(bounded);
+}
+
+FTL_TEST(sinAndCosStayWithinBound) {
+    std::vector<float> in = sweep(-fastmath::TRIG_MAX_INPUT, fastmath::TRIG_MAX_INPUT, POINTS * 4);
+    std::vector<float> sinOut(in.size());
+    std::vector<float> cosOut(in.size());
+    fastmath::sin(in.data(), sinOut.data(), in.size());
+    fastmath::cos(in.data(), cosOut.data(), in.size());
+    double sinError = maxAbsoluteError(in, sinOut, [](double x) { return std::sin(x); });
+    double cosError = maxAbsoluteError(in, cosOut, [](double x) { return std::cos(x); });
+
+    // sinCos is the same reduction, so the same values
+    std::vector<float> sinBoth(in.size());
+    std::vector<float> cosBoth(in.size());
+    fastmath::sinCos(in.data(), sinBoth.data(), cosBoth.data(), in.size());
+    bool same = true;
+    for (size_t i = 0; i < in.size(); ++i) {
+        same = same && sameBits(sinBoth[i], sinOut[i]) && sameBits(cosBoth[i], cosOut[i]);
+    }
+
+    std::printf("    sin abs %.3g, cos abs %.3g\n", sinError, cosError);
+    EXPECT_LE(sinError, 1.5e-7);
+    EXPECT_LE(cosError, 1.5e-7);
+    EXPECT_TRUE(same);
+}
+
+FTL_TEST(decibelConversionsStayWithinBounds) {
+    // Both bounds grow with |dB|: the scaling product rounds to a float before exp or after log
+    std::vector<float> db = sweep(-700.0, 700.0, POINTS);
+    std::vector<float> gain(db.size());
+    fastmath::dbToGain(db.data(), gain.data(), db.size());
+    double toGainExcess = 0.0;
+    for (size_t i = 0; i < db.size(); ++i) {
+        double expected = std::pow(10.0, db[i] / 20.0);
+        double bound = 2.5e-7 + std::fabs(db[i]) * 8e-9;
+        toGainExcess = std::max(toGainExcess, std::fabs(gain[i] - expected) / expected / bound);
+    }
+
+    std::vector<float> gains = logSweep(1e-30, 1e30, POINTS);
+    std::vector<float> toDb(gains.size());
+    fastmath::gainToDb(gains.data(), toDb.data(), gains.size());
+    double toDbExcess = 0.0;
+    for (size_t i = 0; i < gains.size(); ++i) {
+        double expected = 20.0 * std::log10(static_cast<double>(gains[i]));
+        double bound = 1e-6 + std::fabs(expected) * 2.5e-7;
+        toDbExcess = std::max(toDbExcess, std::fabs(toDb[i] - expected) / bound);
+    }
+
+    std::printf("    dbToGain at %.2f of its bound, gainToDb at %.2f\n", toGainExcess, toDbExcess);
+    EXPECT_LE(toGainExcess, 1.0);
+    EXPECT_LE(toDbExcess, 1.0);
+    EXPECT_NEAR(fastmath::dbToGain(-6.0f), 0.501187f, 1e-6f);
+    EXPECT_NEAR(fastmath::gainToDb(0.5f), -6.0206f, 1e-4f);
+}
+
+FTL_TEST(batchesMatchSingleValuesAndInputsClamp) {
+    // An odd count runs whole vectors and the padded tail in one call
+    std::vector<float> in = sweep(-20.0, 20.0, 1003);
+    std::vector<float> out(in.size());
+    bool same = true;
+
+    fastmath::exp(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::exp(in[i]));
+    fastmath::sin(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::sin(in[i]));
+    fastmath::cos(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::cos(in[i]));
+    fastmath::dbToGain(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::dbToGain(in[i]));
+    std::vector<float> positive = logSweep(1e-9, 1e9, 1003);
+    fastmath::log(positive.data(), out.data(), positive.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::log(positive[i]));
+    fastmath::gainToDb(positive.data(), out.data(), positive.size());
+    for (size_t i = 0; i < in.size(); ++i) same = same && sameBits(out[i], fastmath::gainToDb(positive[i]));
+    EXPECT_TRUE(same);
+
+    // In place
+    std::vector<float> inPlace = in;
+    fastmath::exp(inPlace.data(), inPlace.data(), inPlace.size());
+    bool inPlaceSame = true;
+    for (size_t i = 0; i < in.size(); ++i) inPlaceSame = inPlaceSame && sameBits(inPlace[i], fastmath::exp(in[i]));
+    EXPECT_TRUE(inPlaceSame);
+
+    // Out-of-range inputs clamp to finite results
+    const float huge = std::numeric_limits<float>::max();
+    float edges[] = {-huge, -1000.0f, -0.0f, 0.0f, 1000.0f, huge, -1.0f, 1e-45f};
+    float results[8];
+    fastmath::exp(edges, results, 6);
+    EXPECT_TRUE(results[0] > 0.0f && results[0] < 1.2e-38f);
+    EXPECT_TRUE(std::isfinite(results[5]) && results[5] > 1e38f);
+    EXPECT_EQ(results[2], 1.0f);
+    fastmath::log(edges, results, 8);
+    bool finite = true;
+    for (float r : results) finite = finite && std::isfinite(r);
+    EXPECT_TRUE(finite);
+    EXPECT_NEAR(fastmath::gainToDb(0.0f), -758.6f, 0.1f);
+    fastmath::sin(edges, results, 8);
+    finite = true;
+    for (float r : results) finite = finite && std::isfinite(r) && std::fabs(r) <= 1.0f;
+    EXPECT_TRUE(finite);
+    EXPECT_EQ(fastmath::sin(0.0f), 0.0f);
+    EXPECT_EQ(fastmath::cos(0.0f), 1.0f);
+}
+
+FTL_TEST(wavetableOscillatorTracksSine) {
+    constexpr double RATE = 48000.0;
+    constexpr int32_t FRAMES = 48000 * 10;
+    const double frequencies[] = {1.0, 440.0, 997.0, 12345.6};
+    for (double frequency : frequencies) {
+        fastmath::WavetableOscillator oscillator;
+        oscillator.setFrequency(frequency, RATE);
+        oscillator.setPhase(0.25);
+
+        // Rendered in odd bursts; the phase carries across them
+        std::vector<float> out(FRAMES);
+        for (int32_t at = 0; at < FRAMES;) {
+            int32_t burst = std::min<int32_t>(FRAMES - at, 333);
+            oscillator.render(out.data() + at, burst, 0.5f);
+            at += burst;
+        }
+
+        // The increment is quantized to 2^-32 cycles, so compare against the same step
+        double step = std::floor(frequency / RATE * 4294967296.0) / 4294967296.0;
+        double worst = 0.0;
+        for (int32_t i = 0; i < FRAMES; ++i) {
+            double cycles = 0.25 + step * i;
+            worst = std::max(worst, std::fabs(out[i] - 0.5 * std::sin(2.0 * M_PI * (cycles - std::floor(cycles)))));
+        }
+        std::printf("    %.1f Hz: peak error %.3g\n", frequency, worst / 0.5);
+        EXPECT_LE(worst / 0.5, 1.3e-6);
+
+        double expectedPhase = 0.25 + step * FRAMES;
+        EXPECT_NEAR(oscillator.phase(), expectedPhase - std::floor(expectedPhase), 1e-9);
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - OFFLINE RENDER TESTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Offline renders are bit-exact and source-aligned through the default
+ * chain and through the limiter's delay, apply the same stages as the
+ * callback, write readable WAV files in every format, and run several
+ * tracks in parallel far faster than real time.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AudioSource.h"
+#include "FTLAudioEngine.h"
+#include "OfflineRender.h"
+
+#include <chrono>
+#include <cmath>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+
+/** Whole file through the decoder, as interleaved float */
+std::vector<float> decodeAll(const std::string& path) {
+    std::vector<float> samples;
+    std::unique_ptr<AudioSource> source = openAudioSource(path);
+    if (!source) return samples;
+    int channels = source->info().channelCount;
+    std::vector<float> chunk(4096 * channels);
+    int32_t frames;
+    while ((frames = source->read(chunk.data(), 4096)) > 0) {
+        samples.insert(samples.end(), chunk.begin(), chunk.begin() + frames * channels);
+    }
+    return samples;
+}
+
+AudioEngineConfig offlineConfig(int burst) {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = burst;
+    config.offlineRender = true;
+    return config;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// GRAPH
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(defaultChainIsBitExactAndAligned) {
+    constexpr int64_t FRAMES = RATE * 3 + 123;   // Not a whole number of bursts
+    std::string path = tempPath("offline_index.flac");
+    ASSERT_TRUE(writeFlac16(path, makeIndexSignal(FRAMES), RATE));
+    std::vector<float> expected = decodeAll(path);
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(offlineConfig(240)) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.startPlayback() != EngineResult::SUCCESS);   // No device to start
+
+    OfflineJob job;
+    job.sourcePath = path;
+    ASSERT_TRUE(renderOfflineJob(engine, job) == EngineResult::SUCCESS);
+    EXPECT_EQ(job.stats.frames, FRAMES);
+    ASSERT_TRUE(job.samples.size() == expected.size());
+    EXPECT_TRUE(job.samples == expected);
+    std::printf("  %lld frames, %lld bursts, %.0fx realtime\n", static_cast<long long>(job.stats.frames),
+                static_cast<long long>(job.stats.bursts), job.stats.realtimeFactor);
+
+    // A second track on the same engine starts clean
+    ASSERT_TRUE(renderOfflineJob(engine, job) == EngineResult::SUCCESS);
+    EXPECT_TRUE(job.samples == expected);
+}
+
+FTL_TEST(fullChainMatchesTheCallbackStages) {
+    constexpr int64_t FRAMES = RATE * 4;
+    std::string path = tempPath("offline_sine.wav");
+    ASSERT_TRUE(writeWav16(path, makeSineSignal(FRAMES, 2, RATE, 997.0, 0.1), 2, RATE));
+    std::vector<float> source = decodeAll(path);
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(offlineConfig(256)) == EngineResult::SUCCESS);
+
+    // Under the ceiling the limiter is a pure delay, and the render trims it
+    ASSERT_TRUE(engine.setTruePeakLimiter(true, -1.0f) == EngineResult::SUCCESS);
+    OfflineJob job;
+    job.sourcePath = path;
+    ASSERT_TRUE(renderOfflineJob(engine, job) == EngineResult::SUCCESS);
+    EXPECT_EQ(job.stats.frames, FRAMES);
+    EXPECT_TRUE(job.samples == source);
+
+    // +6 dB from metadata once the 100 ms normalization ramp has settled
+    ASSERT_TRUE(engine.setLoudnessNormalization(true, -18.0f) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setTrackLoudness(-24.0f) == EngineResult::SUCCESS);
+    std::vector<float> rendered;
+    OfflineRenderStats stats;
+    ASSERT_TRUE(engine.renderOffline([&](const float* frames, int32_t numFrames, int channelCount) {
+        rendered.insert(rendered.end(), frames, frames + numFrames * channelCount);
+        return true;
+    }, &stats) == EngineResult::SUCCESS);
+    ASSERT_TRUE(rendered.size() == source.size());
+    float gain = std::pow(10.0f, 6.0f / 20.0f);
+    float worst = 0.0f;
+    for (size_t i = RATE / 5 * 2; i < rendered.size(); ++i) {
+        worst = std::max(worst, std::fabs(rendered[i] - source[i] * gain));
+    }
+    EXPECT_TRUE(worst < 1e-5f);
+
+    std::printf("  stages (ms): decode %.2f source %.2f loudness %.2f mix %.2f limiter %.2f meter %.2f\n",
+                stats.decodeMs, stats.sourceMs, stats.loudnessMs, stats.mixMs, stats.limiterMs, stats.meterMs);
+    EXPECT_TRUE(stats.loudnessMs > 0.0);
+    EXPECT_TRUE(stats.limiterMs > 0.0);
+    EXPECT_TRUE(stats.realtimeFactor > 1.0);
+
+    // A sink can stop the render
+    int calls = 0;
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.renderOffline([&](const float*, int32_t, int) { return ++calls < 3; }, nullptr) ==
+                EngineResult::ERROR_PROCESSING_FAILED);
+    EXPECT_EQ(calls, 3);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FILES & PARALLEL JOBS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(parallelJobsWriteEveryFormat) {
+    constexpr int64_t FRAMES = RATE * 20;
+    std::string path = tempPath("offline_noise.flac");
+    ASSERT_TRUE(writeFlac16(path, makeNoiseSignal(FRAMES), RATE));
+    std::vector<float> expected = decodeAll(path);
+
+    const WavSampleFormat formats[] = {WavSampleFormat::FLOAT_32, WavSampleFormat::PCM_24, WavSampleFormat::PCM_16};
+    const double tolerance[] = {0.0, 1.0 / 8388608.0, 2.5 / 32768.0};   // 16-bit carries TPDF dither
+    std::vector<OfflineJob> jobs(6);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].sourcePath = path;
+        jobs[i].outputPath = tempPath("offline_out_" + std::to_string(i) + ".wav");
+        jobs[i].outputFormat = formats[i % 3];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    renderOfflineJobs(offlineConfig(256), nullptr, jobs, 3);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  6 x 20 s in %.3f s wall: %.0fx realtime overall\n", wall, 6 * 20.0 / wall);
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_TRUE(jobs[i].result == EngineResult::SUCCESS);
+        std::vector<float> written = decodeAll(jobs[i].outputPath);
+        ASSERT_TRUE(written.size() == expected.size());
+        double worst = 0.0;
+        for (size_t k = 0; k < written.size(); ++k) {
+            worst = std::max(worst, static_cast<double>(std::fabs(written[k] - expected[k])));
+        }
+        EXPECT_LE(worst, tolerance[i % 3]);
+    }
+
+    // Missing sources fail on their own without taking the batch down
+    std::vector<OfflineJob> missing(2);
+    missing[0].sourcePath = tempPath("does_not_exist.flac");
+    missing[1].sourcePath = path;
+    renderOfflineJobs(offlineConfig(256), nullptr, missing, 2);
+    EXPECT_TRUE(missing[0].result != EngineResult::SUCCESS);
+    EXPECT_TRUE(missing[1].result == EngineResult::SUCCESS);
+    EXPECT_TRUE(missing[1].samples == expected);
+}
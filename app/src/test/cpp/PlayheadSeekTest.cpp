@@ -0,0 +1,234 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - PLAYHEAD & SEEK TESTS         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Runs the engine against the paced host backend and watches what reaches
+ * the "DAC" through the output tap. The index signal makes every rendered
+ * frame name its source frame, so seeks are checked to the sample and
+ * seek-to-audible latency is measured from the outside.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int64_t TOTAL_FRAMES = 48000 * 20;
+constexpr int BURST = 240;
+
+struct TapBurst {
+    Clock::time_point time;
+    int64_t streamFrame;
+    int64_t firstIndex;      // Source frame of the burst's first frame, -1 for silence
+    int32_t frames;
+    bool contiguous;         // Every frame follows its predecessor
+};
+
+class OutputRecorder {
+public:
+    OutputRecorder() { host::setOutputTap(&OutputRecorder::tap, this); }
+    ~OutputRecorder() { host::setOutputTap(nullptr, nullptr); }
+
+    std::vector<TapBurst> since(Clock::time_point start) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<TapBurst> result;
+        for (const auto& burst : m_bursts) {
+            if (burst.time >= start) result.push_back(burst);
+        }
+        return result;
+    }
+
+    int64_t lastWrittenIndex() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_bursts.rbegin(); it != m_bursts.rend(); ++it) {
+            if (it->firstIndex >= 0) return it->firstIndex + it->frames;
+        }
+        return -1;
+    }
+
+private:
+    static void tap(const float* frames, int32_t numFrames, int32_t channelCount,
+                    int64_t streamFrame, void* userData) {
+        auto* self = static_cast<OutputRecorder*>(userData);
+        TapBurst burst{Clock::now(), streamFrame, decodeIndex(frames), numFrames, true};
+        for (int32_t i = 1; i < numFrames; ++i) {
+            int64_t index = decodeIndex(frames + i * channelCount);
+            int64_t previous = decodeIndex(frames + (i - 1) * channelCount);
+            if (index >= 0 && previous >= 0 && index != previous + 1) burst.contiguous = false;
+        }
+        std::lock_guard<std::mutex> lock(self->m_mutex);
+        self->m_bursts.push_back(burst);
+    }
+
+    std::mutex m_mutex;
+    std::vector<TapBurst> m_bursts;
+};
+
+bool startEngine(FTLAudioEngine& engine, const std::string& path) {
+    host::BackendSettings settings;
+    settings.realtimePacing = true;
+    settings.presentationLatencyBursts = 2;
+    host::setBackendSettings(settings);
+
+    AudioEngineConfig config;
+    config.sampleRate = 44100;          // Source is 48 kHz: the engine must follow it
+    config.framesPerBurst = BURST;
+    return engine.initialize(config) == EngineResult::SUCCESS &&
+           engine.setAudioSource(path) == EngineResult::SUCCESS &&
+           engine.startPlayback() == EngineResult::SUCCESS;
+}
+
+/**
+ * Seek and report the first tap burst carrying the target, or nullptr.
+ * Also checks that the seek landed exactly and playback continued in order.
+ */
+void checkSeek(FTLAudioEngine& engine, OutputRecorder& recorder, int64_t target, double& audibleMs) {
+    audibleMs = -1.0;
+    Clock::time_point requested = Clock::now();
+    EXPECT_TRUE(engine.seekToFrame(target) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    std::vector<TapBurst> bursts = recorder.since(requested);
+    size_t first = 0;
+    while (first < bursts.size() && bursts[first].firstIndex != target) {
+        // Pre-seek audio and silence may still be in flight, never anything else
+        ++first;
+    }
+    ASSERT_TRUE(first < bursts.size());
+
+    int64_t expected = target;
+    for (size_t i = first; i < bursts.size(); ++i) {
+        EXPECT_EQ(bursts[i].firstIndex, expected);
+        EXPECT_TRUE(bursts[i].contiguous);
+        expected += bursts[i].frames;
+    }
+
+    // Callback time plus the frames queued behind it in the host model
+    int32_t queued = AAudioStream_getBufferSizeInFrames(host::getLastOpenedStream());
+    double callbackMs = std::chrono::duration<double, std::milli>(bursts[first].time - requested).count();
+    audibleMs = callbackMs + queued * 1000.0 / SAMPLE_RATE;
+}
+
+void runSeekScenario(const std::string& path) {
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    EXPECT_EQ(engine.getCurrentConfiguration().sampleRate, SAMPLE_RATE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const int64_t targets[] = {480000, 96001, 700000, 12345};
+    for (int64_t target : targets) {
+        double audibleMs = 0.0;
+        checkSeek(engine, recorder, target, audibleMs);
+        double reportedMs = engine.getLastSeekLatencyMs();
+        std::printf("  seek %lld: audible after %.2f ms (engine reports %.2f ms)\n",
+                    static_cast<long long>(target), audibleMs, reportedMs);
+
+        EXPECT_TRUE(audibleMs > 0.0);
+        EXPECT_LE(audibleMs, 100.0);
+        // Engine's own estimate agrees with the tap to within a burst or two
+        EXPECT_NEAR(reportedMs, audibleMs, 2.0 * BURST * 1000.0 / SAMPLE_RATE + 5.0);
+    }
+
+    engine.shutdown();
+}
+
+} // namespace
+
+FTL_TEST(wavSeekIsSampleAccurateAndFast) {
+    std::string path = tempPath("engine.wav");
+    ASSERT_TRUE(writeWav16(path, makeIndexSignal(TOTAL_FRAMES), 2, SAMPLE_RATE));
+    runSeekScenario(path);
+}
+
+FTL_TEST(flacSeekIsSampleAccurateAndFast) {
+    std::string path = tempPath("engine.flac");
+    FlacWriteOptions options;
+    options.stereo = StereoMode::LEFT_SIDE;
+    ASSERT_TRUE(writeFlac16(path, makeIndexSignal(TOTAL_FRAMES), SAMPLE_RATE, options));
+    runSeekScenario(path);
+}
+
+FTL_TEST(playheadTracksPresentedFrame) {
+    std::string path = tempPath("playhead.wav");
+    ASSERT_TRUE(writeWav16(path, makeIndexSignal(TOTAL_FRAMES), 2, SAMPLE_RATE));
+
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int32_t queued = AAudioStream_getBufferSizeInFrames(host::getLastOpenedStream());
+    int64_t previous = -1;
+    for (int i = 0; i < 20; ++i) {
+        int64_t playhead = engine.getPlayheadFrame();
+        int64_t written = recorder.lastWrittenIndex();
+
+        // Audible frame trails the newest written frame by the device queue (+ one burst of slack)
+        EXPECT_LE(playhead, written);
+        EXPECT_LE(written - playhead, static_cast<int64_t>(queued + 2 * BURST));
+        EXPECT_LE(previous, playhead);
+        previous = playhead;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Right after a seek the playhead reports the target, never stale audio beyond it
+    EXPECT_TRUE(engine.seekToFrame(600000) == EngineResult::SUCCESS);
+    int64_t afterSeek = engine.getPlayheadFrame();
+    EXPECT_TRUE(afterSeek == 600000 || afterSeek < 600000 + queued + BURST);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    int64_t settled = engine.getPlayheadFrame();
+    EXPECT_TRUE(settled >= 600000 && settled < 600000 + SAMPLE_RATE / 5);
+
+    // Snapshot carries the same position for the UI
+    EXPECT_TRUE(engine.readSnapshot().playheadFrame >= 600000);
+    engine.shutdown();
+}
+
+FTL_TEST(failedRateChangeKeepsTheCurrentTrack) {
+    std::string path = tempPath("keep.wav");
+    std::string unplayable = tempPath("rate7000.wav");
+    ASSERT_TRUE(writeWav16(path, makeIndexSignal(TOTAL_FRAMES), 2, SAMPLE_RATE));
+    ASSERT_TRUE(writeWav16(unplayable, makeSineSignal(7000, 2, 7000, 440.0, 0.25), 2, 7000));
+
+    OutputRecorder recorder;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(startEngine(engine, path));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(engine.stopPlayback() == EngineResult::SUCCESS);
+    int64_t stoppedAt = engine.getPlayheadFrame();
+
+    // No stream opens below 8 kHz: the engine goes back to the old rate and track
+    EXPECT_TRUE(engine.setAudioSource(unplayable) != EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::INITIALIZED);
+    EXPECT_EQ(engine.getCurrentConfiguration().sampleRate, SAMPLE_RATE);
+
+    Clock::time_point restarted = Clock::now();
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::vector<TapBurst> bursts = recorder.since(restarted);
+    int audible = 0;
+    for (const TapBurst& burst : bursts) {
+        if (burst.firstIndex < 0) continue;
+        EXPECT_TRUE(burst.contiguous);
+        EXPECT_TRUE(burst.firstIndex >= stoppedAt);
+        ++audible;
+    }
+    EXPECT_TRUE(audible > 10);
+    engine.shutdown();
+}
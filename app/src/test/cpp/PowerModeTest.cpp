@@ -0,0 +1,204 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - POWER MODE TESTS             ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Switching between the low-latency and the deep-buffer stream while a
+ * tone plays: the old stream's last audible frame and the new stream's
+ * first one meet at the speaker within 2 ms, in both directions, and
+ * the tone carries on where it was. The deep stream calls back an order
+ * of magnitude less often. Idle engines just reopen, and power saving
+ * is refused when the engine was not sized for it.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr double TONE_HZ = 1000.0;
+constexpr double TONE_AMPLITUDE = 0.25;
+constexpr float AUDIBLE = 1e-4f;
+
+// First and last audible frame of every stream, in speaker time
+struct StreamSpan {
+    AAudioStream* stream = nullptr;
+    int64_t firstNs = -1;
+    int64_t lastNs = -1;
+    float firstSample = 0.0f;
+    float lastSample = 0.0f;
+};
+
+struct Presentation {
+    std::mutex mutex;
+    std::vector<StreamSpan> spans;
+
+    static void tap(AAudioStream* stream, const float* frames, int32_t numFrames, int32_t channelCount,
+                    int64_t presentationTimeNs, void* userData) {
+        auto* self = static_cast<Presentation*>(userData);
+        std::lock_guard<std::mutex> lock(self->mutex);
+        // A closed stream's handle can come back for the next one: a first burst starts a new span
+        StreamSpan* span = nullptr;
+        for (StreamSpan& candidate : self->spans) {
+            if (candidate.stream == stream) span = &candidate;
+        }
+        if (!span || AAudioStream_getFramesWritten(stream) == numFrames) {
+            self->spans.push_back(StreamSpan());
+            span = &self->spans.back();
+            span->stream = stream;
+        }
+        for (int32_t i = 0; i < numFrames; ++i) {
+            float sample = frames[i * channelCount];
+            if (std::fabs(sample) <= AUDIBLE) continue;
+            int64_t timeNs = presentationTimeNs + static_cast<int64_t>(i) * 1000000000LL / RATE;
+            if (span->firstNs < 0) {
+                span->firstNs = timeNs;
+                span->firstSample = sample;
+            }
+            span->lastNs = timeNs;
+            span->lastSample = sample;
+        }
+    }
+};
+
+AudioEngineConfig powerSavingConfig() {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    config.enablePowerSaving = true;
+    config.deepBufferMs = 120;
+    return config;
+}
+
+} // namespace
+
+FTL_TEST(handoverIsGaplessBothWays) {
+    std::string path = tempPath("power_mode_tone.wav");
+    writeWav16(path, makeSineSignal(RATE * 10, 2, RATE, TONE_HZ, TONE_AMPLITUDE), 2, RATE);
+    Presentation presentation;
+    host::setPresentationTap(&Presentation::tap, &presentation);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(powerSavingConfig()) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::POWER_SAVING) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.getOutputMode() == OutputMode::POWER_SAVING);
+    AAudioStream* deep = host::getLastOpenedStream();
+    EXPECT_TRUE(AAudioStream_getPerformanceMode(deep) == AAUDIO_PERFORMANCE_MODE_POWER_SAVING);
+    EXPECT_TRUE(AAudioStream_getBufferSizeInFrames(deep) >= RATE * 120 / 1000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::LOW_LATENCY) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.getOutputMode() == OutputMode::LOW_LATENCY);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    engine.shutdown();
+    host::setPresentationTap(nullptr, nullptr);
+
+    // Low latency, deep buffer, low latency again
+    std::lock_guard<std::mutex> lock(presentation.mutex);
+    ASSERT_TRUE(presentation.spans.size() == 3);
+    const char* names[] = {"low -> deep", "deep -> low"};
+    for (size_t seam = 0; seam < 2; ++seam) {
+        const StreamSpan& from = presentation.spans[seam];
+        const StreamSpan& to = presentation.spans[seam + 1];
+        ASSERT_TRUE(from.lastNs > 0 && to.firstNs > 0);
+        // Positive: silence between them; negative: both play at once
+        double gapMs = (to.firstNs - from.lastNs) / 1e6 - 1000.0 / RATE;
+        // A frame too many or too few still steps like the tone does, within one more step
+        float step = std::fabs(to.firstSample - from.lastSample);
+        std::printf("    %s: gap %+.3f ms, sample step %.4f\n", names[seam], gapMs, step);
+        EXPECT_LE(std::fabs(gapMs), 2.0);
+        EXPECT_LE(step, 0.07f);
+    }
+
+    // The deep stream ran on far fewer wake-ups for the same audio
+    OutputModeActivity low = engine.getOutputModeActivity(OutputMode::LOW_LATENCY);
+    OutputModeActivity saving = engine.getOutputModeActivity(OutputMode::POWER_SAVING);
+    std::printf("    low latency: %.1f callbacks/s, %.1f CPU ms per audio minute\n",
+                low.callbacksPerSecond, low.cpuMsPerAudioMinute);
+    std::printf("    power saving: %.1f callbacks/s, %.1f CPU ms per audio minute\n",
+                saving.callbacksPerSecond, saving.cpuMsPerAudioMinute);
+    EXPECT_TRUE(low.audioSeconds > 0.4 && saving.audioSeconds > 0.8);
+    EXPECT_NEAR(low.callbacksPerSecond, RATE / 240.0, 10.0);
+    EXPECT_LE(saving.callbacksPerSecond, low.callbacksPerSecond / 5.0);
+    EXPECT_TRUE(saving.cpuMsPerAudioMinute > 0.0);
+    EXPECT_TRUE(saving.decodeWakeups > 0);
+}
+
+FTL_TEST(idleEngineReopensInNewMode) {
+    host::setBackendSettings(host::BackendSettings());
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(powerSavingConfig()) == EngineResult::SUCCESS);
+    EXPECT_TRUE(AAudioStream_getPerformanceMode(host::getLastOpenedStream()) ==
+                AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::POWER_SAVING) == EngineResult::SUCCESS);
+    AAudioStream* deep = host::getLastOpenedStream();
+    EXPECT_TRUE(AAudioStream_getPerformanceMode(deep) == AAUDIO_PERFORMANCE_MODE_POWER_SAVING);
+    EXPECT_TRUE(AAudioStream_getSharingMode(deep) == AAUDIO_SHARING_MODE_SHARED);
+
+    // Unchanged mode keeps the stream
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::POWER_SAVING) == EngineResult::SUCCESS);
+    EXPECT_TRUE(host::getLastOpenedStream() == deep);
+
+    // Plays on the deep stream, then switches back while paused
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_TRUE(engine.pausePlayback() == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::LOW_LATENCY) == EngineResult::SUCCESS);
+    AAudioStream* back = host::getLastOpenedStream();
+    EXPECT_TRUE(AAudioStream_getPerformanceMode(back) == AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::PAUSED);
+    ASSERT_TRUE(engine.resumePlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    EXPECT_TRUE(engine.getOutputModeActivity(OutputMode::POWER_SAVING).callbacks > 0);
+    engine.shutdown();
+}
+
+FTL_TEST(powerSavingNeedsDeepDecodeRing) {
+    host::setBackendSettings(host::BackendSettings());
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setOutputMode(OutputMode::POWER_SAVING) == EngineResult::ERROR_INVALID_CONFIG);
+    EXPECT_TRUE(engine.getOutputMode() == OutputMode::LOW_LATENCY);
+    engine.shutdown();
+
+    config.outputMode = OutputMode::POWER_SAVING;
+    FTLAudioEngine misconfigured;
+    EXPECT_TRUE(misconfigured.initialize(config) == EngineResult::ERROR_INVALID_CONFIG);
+
+    config.enablePowerSaving = true;
+    config.deepBufferMs = 10;
+    EXPECT_TRUE(misconfigured.initialize(config) == EngineResult::ERROR_INVALID_CONFIG);
+
+    // Starting in power saving opens the deep stream right away
+    config.deepBufferMs = 200;
+    FTLAudioEngine saving;
+    ASSERT_TRUE(saving.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(AAudioStream_getPerformanceMode(host::getLastOpenedStream()) ==
+                AAUDIO_PERFORMANCE_MODE_POWER_SAVING);
+    saving.shutdown();
+}
@@ -0,0 +1,203 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - BURST PREFETCH TESTS         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Burst prefetch against the streaming reader on the same track: decode
+ * thread wakeups and read(2) requests per minute of playback, with no
+ * gaps in the output. The queued next track is opened at a batch and
+ * plays without touching storage; seeks still refill at once, and a
+ * burst-sized reader only probes after a seek.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "FileReader.h"
+#include "HostAudioBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int32_t BURST = 240;
+constexpr int PREFETCH_RING_MS = 1000;
+constexpr int MEASURE_MS = 3000;
+
+// Bursts that come out silent once the tone has started (a starved ring)
+struct Gaps {
+    std::atomic<int64_t> silentBursts{0};
+    std::atomic<bool> started{false};
+    std::atomic<float> peak{0.0f};
+
+    static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+        auto* self = static_cast<Gaps*>(userData);
+        float peak = 0.0f;
+        for (int32_t i = 0; i < numFrames * channelCount; ++i) peak = std::max(peak, std::fabs(frames[i]));
+        self->peak.store(peak);
+        if (peak > 0.01f) {
+            self->started.store(true);
+        } else if (self->started.load()) {
+            self->silentBursts.fetch_add(1);
+        }
+    }
+};
+
+std::string writeTone(const char* name, int seconds, double amplitude) {
+    std::string path = tempPath(name);
+    writeWav16(path, makeSineSignal(static_cast<int64_t>(RATE) * seconds, 2, RATE, 1000.0, amplitude), 2, RATE);
+    return path;
+}
+
+AudioEngineConfig playbackConfig(bool burstPrefetch) {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = BURST;
+    config.burstPrefetch = burstPrefetch;
+    config.prefetchRingMs = PREFETCH_RING_MS;
+    return config;
+}
+
+struct PerMinute {
+    double wakeups = 0.0;
+    double readRequests = 0.0;
+    int64_t silentBursts = 0;
+};
+
+/** Play `path` for MEASURE_MS from the first request, counting everything including the open */
+PerMinute measurePlayback(const std::string& path, bool burstPrefetch) {
+    Gaps gaps;
+    host::setOutputTap(&Gaps::tap, &gaps);
+    host::setBackendSettings(host::BackendSettings());
+
+    PerMinute result;
+    FTLAudioEngine engine;
+    if (engine.initialize(playbackConfig(burstPrefetch)) != EngineResult::SUCCESS ||
+        engine.setAudioSource(path) != EngineResult::SUCCESS ||
+        engine.startPlayback() != EngineResult::SUCCESS) {
+        reportFailure(__FILE__, __LINE__, "cannot start playback");
+        return result;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(MEASURE_MS));
+    DecodeActivity activity = engine.getDecodeActivity();
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+
+    result.wakeups = activity.wakeups * 60000.0 / MEASURE_MS;
+    result.readRequests = activity.readRequests * 60000.0 / MEASURE_MS;
+    result.silentBursts = gaps.silentBursts.load();
+    return result;
+}
+
+} // namespace
+
+FTL_TEST(burstPrefetchSleepsBetweenBatches) {
+    // 30 s of 16-bit stereo: 5.8 MB, more than two bursts
+    std::string path = writeTone("prefetch_long.wav", 30, 0.25);
+    PerMinute streaming = measurePlayback(path, false);
+    PerMinute burst = measurePlayback(path, true);
+
+    std::printf("    wakeups/min: streaming %.0f, burst %.0f (%d ms ring)\n",
+                streaming.wakeups, burst.wakeups, PREFETCH_RING_MS);
+    std::printf("    I/O requests/min: streaming %.0f, burst %.0f\n", streaming.readRequests, burst.readRequests);
+
+    EXPECT_EQ(streaming.silentBursts, 0);
+    EXPECT_EQ(burst.silentBursts, 0);
+    // One batch per 750 ms of audio against a poll every 10 ms
+    EXPECT_TRUE(burst.wakeups * 20.0 < streaming.wakeups);
+    EXPECT_LE(burst.wakeups, 60000.0 / (PREFETCH_RING_MS * 3 / 4) * 1.5);
+    // The open reads the first 2 MB (~11 s); the streaming reader reads 64 KB at a time
+    EXPECT_LE(burst.readRequests, 60000.0 / MEASURE_MS);
+    EXPECT_TRUE(burst.readRequests * 5.0 < streaming.readRequests);
+}
+
+FTL_TEST(queuedTrackPlaysWithoutStorageAccess) {
+    std::string first = writeTone("prefetch_first.wav", 10, 0.25);
+    std::string next = writeTone("prefetch_next.wav", 10, 0.5);
+    Gaps gaps;
+    host::setOutputTap(&Gaps::tap, &gaps);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(playbackConfig(true)) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(first) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    uint64_t playingReads = engine.getDecodeActivity().readRequests;
+
+    // Opened at the next batch (within one ring period), not right away
+    ASSERT_TRUE(engine.prefetchNextSource(next) == EngineResult::SUCCESS);
+    EXPECT_EQ(engine.getDecodeActivity().readRequests, playingReads);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PREFETCH_RING_MS));
+    uint64_t prefetchedReads = engine.getDecodeActivity().readRequests;
+    EXPECT_TRUE(prefetchedReads > playingReads);
+
+    // The whole 1.9 MB track came in with the prefetch burst
+    ASSERT_TRUE(engine.setAudioSource(next) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_NEAR(gaps.peak.load(), 0.5, 1e-3);
+    EXPECT_EQ(engine.getDecodeActivity().readRequests, prefetchedReads);
+
+    // A track that is not the queued one opens as usual
+    ASSERT_TRUE(engine.prefetchNextSource(tempPath("missing_next.wav")) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(first) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_NEAR(gaps.peak.load(), 0.25, 1e-3);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+FTL_TEST(seekRefillsDuringSleep) {
+    std::string path = writeTone("prefetch_seek.wav", 30, 0.25);
+    Gaps gaps;
+    host::setOutputTap(&Gaps::tap, &gaps);
+    host::setBackendSettings(host::BackendSettings());
+
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(playbackConfig(true)) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    // Past the first burst window: the reader probes, then streams again
+    ASSERT_TRUE(engine.seekToFrame(RATE * 20) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PREFETCH_RING_MS));
+    int64_t playhead = engine.getPlayheadFrame();
+    EXPECT_TRUE(playhead > RATE * 20);
+    EXPECT_LE(playhead, RATE * 20 + RATE * 3 / 2);
+    EXPECT_LE(engine.getLastSeekLatencyMs(), 50.0);
+    EXPECT_EQ(gaps.silentBursts.load(), 0);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+FTL_TEST(burstReaderProbesAfterSeek) {
+    std::string path = writeTone("prefetch_reader.wav", 20, 0.25);
+    const size_t burst = 2 * 1024 * 1024;
+    FileReader reader(burst);
+    ASSERT_TRUE(reader.open(path));
+    uint8_t bytes[16];
+
+    ASSERT_TRUE(reader.read(bytes, sizeof(bytes)) == sizeof(bytes));
+    EXPECT_EQ(reader.stats().bytesRead, static_cast<uint64_t>(burst));
+
+    // A jump outside the window reads one probe, sequential reads get bursts again
+    ASSERT_TRUE(reader.seek(3 * 1024 * 1024));
+    ASSERT_TRUE(reader.read(bytes, sizeof(bytes)) == sizeof(bytes));
+    EXPECT_EQ(reader.stats().bytesRead, static_cast<uint64_t>(burst + FileReader::PROBE_SIZE));
+    ASSERT_TRUE(reader.skip(FileReader::PROBE_SIZE - sizeof(bytes)));
+    ASSERT_TRUE(reader.read(bytes, sizeof(bytes)) == sizeof(bytes));
+    EXPECT_EQ(reader.stats().readRequests, 3u);
+    EXPECT_EQ(reader.stats().bytesRead, static_cast<uint64_t>(reader.size()) - 3 * 1024 * 1024 + burst);
+}
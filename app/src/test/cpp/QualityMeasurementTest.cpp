@@ -0,0 +1,144 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║          FTL AUDIO ENGINE - QUALITY MEASUREMENT TESTS       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * The analyzer reads known distortion, noise and IMD back at their
+ * synthesized levels; the default chain meets the THD+N < 0.001%,
+ * SNR > 120 dB and +/-0.1 dB response spec; a driven limiter and the
+ * resampler show up in the figures; the engine fills its metrics.
+ */
+
+#include "TestHarness.h"
+
+#include "FTLAudioEngine.h"
+#include "QualityMeasurement.h"
+#include "SignalAnalysis.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int FFT_SIZE = analysis::DEFAULT_FFT_SIZE;
+
+AudioEngineConfig offlineConfig() {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.channelCount = 2;
+    config.framesPerBurst = 240;
+    config.offlineRender = true;
+    return config;
+}
+
+void printReport(const char* name, const QualityReport& report) {
+    std::printf("  %-10s THD+N %.2f dB, SNR %.1f dB, -60 dBFS %.1f dB, IMD %.2e%%, multitone %.1f dB, "
+                "response %+.4f/%+.4f dB, %.0f ms\n",
+                name, report.thdPlusNDb, report.snrDb, report.lowLevelThdPlusNDb, report.imdPercent,
+                report.multitoneDistortionDb, report.responseMinDb, report.responseMaxDb, report.elapsedMs);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ANALYZER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(analyzerReadsKnownLevels) {
+    analysis::Fft fft(FFT_SIZE);
+    const int bin = analysis::binOf(1000.0, RATE, FFT_SIZE);
+    const double hz = analysis::binFrequency(bin, RATE, FFT_SIZE);
+    std::vector<float> signal(FFT_SIZE);
+    std::vector<double> power;
+
+    // A clean float tone: only rounding to float is left
+    analysis::generateTone(signal.data(), FFT_SIZE, 1, hz, 0.5, RATE);
+    fft.powerSpectrum(signal.data(), 1, 0, power);
+    analysis::ToneResult clean = analysis::analyzeTone(power, bin, RATE, FFT_SIZE);
+    EXPECT_LE(analysis::ratioToDb(clean.thdPlusN), -130.0);
+    EXPECT_NEAR(clean.fundamentalDbfs, -6.0206, 0.001);
+
+    // -60 dB third harmonic plus white noise 90 dB below the tone's RMS
+    uint32_t state = 12345;
+    const double noiseRms = 0.5 / std::sqrt(2.0) * 3.16227766e-5;
+    for (int n = 0; n < FFT_SIZE; ++n) {
+        state = state * 1664525u + 1013904223u;
+        double uniform = static_cast<double>(state) / 4294967296.0 - 0.5;   // RMS 1 / sqrt(12)
+        double third = 0.5e-3 * std::sin(2.0 * 3.14159265358979323846 * 3.0 * bin * n / FFT_SIZE);
+        signal[n] = static_cast<float>(signal[n] + third + uniform * std::sqrt(12.0) * noiseRms);
+    }
+    fft.powerSpectrum(signal.data(), 1, 0, power);
+    analysis::ToneResult distorted = analysis::analyzeTone(power, bin, RATE, FFT_SIZE);
+    EXPECT_NEAR(analysis::ratioToDb(distorted.thd), -60.0, 0.01);
+    // In-band share of full-band white noise: (20 kHz - 20 Hz) / 24 kHz
+    EXPECT_NEAR(distorted.snrDb, 90.0 - 10.0 * std::log10(19980.0 / 24000.0), 0.3);
+    EXPECT_NEAR(analysis::ratioToDb(distorted.thdPlusN), -60.0, 0.05);
+
+    // Amplitude modulation by 1%: each SMPTE sideband at half the depth
+    const int lowBin = analysis::binOf(60.0, RATE, FFT_SIZE);
+    const int highBin = analysis::binOf(7000.0, RATE, FFT_SIZE);
+    for (int n = 0; n < FFT_SIZE; ++n) {
+        double t = 2.0 * 3.14159265358979323846 * n / FFT_SIZE;
+        signal[n] = static_cast<float>(0.2 * (1.0 + 0.01 * std::cos(t * lowBin)) * std::sin(t * highBin));
+    }
+    fft.powerSpectrum(signal.data(), 1, 0, power);
+    EXPECT_NEAR(analysis::analyzeSmpteImd(power, lowBin, highBin), 0.01 / std::sqrt(2.0), 1e-5);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CHAIN
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(defaultChainMeetsSpec) {
+    QualityReport report;
+    ASSERT_TRUE(measureChainQuality(offlineConfig(), nullptr, tempPath(""), report) == EngineResult::SUCCESS);
+    printReport("default", report);
+
+    EXPECT_TRUE(report.thdPlusNPercent < 0.001);
+    EXPECT_TRUE(report.snrDb > 120.0);
+    EXPECT_TRUE(report.lowLevelThdPlusNDb < -100.0);
+    EXPECT_TRUE(report.imdPercent < 0.001);
+    EXPECT_TRUE(report.multitoneDistortionDb < -100.0);
+    EXPECT_TRUE(report.responseMinDb > -0.1 && report.responseMaxDb < 0.1);
+    EXPECT_EQ(report.response.size(), static_cast<size_t>(31));
+    EXPECT_TRUE(report.elapsedMs < 2000.0);
+}
+
+FTL_TEST(degradedChainsShowUp) {
+    // A -12 dBTP ceiling squashes the -3 dBFS tone
+    QualityReport limited;
+    OfflineSetup squash = [](FTLAudioEngine& engine) { engine.setTruePeakLimiter(true, -12.0f); };
+    ASSERT_TRUE(measureChainQuality(offlineConfig(), squash, tempPath(""), limited) == EngineResult::SUCCESS);
+    printReport("limited", limited);
+    EXPECT_TRUE(limited.thdPlusNPercent > 0.001);
+
+    // Catmull-Rom voice resampling, 44.1 -> 48 kHz: imaging and HF droop put it
+    // outside the playback spec (voices are previews and prompts), but bounded
+    QualityReport resampled;
+    ASSERT_TRUE(measureResamplerQuality(44100, RATE, resampled) == EngineResult::SUCCESS);
+    printReport("resampler", resampled);
+    EXPECT_TRUE(resampled.thdPlusNDb > -100.0 && resampled.thdPlusNDb < -85.0);
+    EXPECT_TRUE(resampled.responseMinDb > -3.5 && resampled.responseMaxDb < 0.1);
+}
+
+FTL_TEST(engineFillsQualityMetrics) {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    QualityReport report;
+    EXPECT_TRUE(engine.measureQuality(tempPath(""), &report) == EngineResult::ERROR_NOT_INITIALIZED);
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+
+    ASSERT_TRUE(engine.setTruePeakLimiter(true, -1.0f) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.measureQuality(tempPath(""), &report) == EngineResult::SUCCESS);
+    PerformanceMetrics metrics = engine.getPerformanceMetrics();
+    EXPECT_TRUE(metrics.thdPlusN > 0.0);
+    EXPECT_EQ(metrics.thdPlusN, report.thdPlusNPercent);
+    EXPECT_EQ(metrics.signalToNoiseRatio, report.snrDb);
+    EXPECT_TRUE(metrics.thdPlusN < 0.001);
+}
@@ -0,0 +1,256 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - SEARCH INDEX TESTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Library search: text folding, prefix / substring / typo matches and
+ * their ranking, incremental updates through compaction, and agreement
+ * with a brute-force substring scan over a generated library (index
+ * memory per 10k tracks reported).
+ */
+
+#include "TestHarness.h"
+
+#include "SearchIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+SearchEntry entry(int64_t id, const char* title, const char* artist, const char* album) {
+    return SearchEntry{id, title, artist, album};
+}
+
+std::vector<SearchEntry> smallLibrary() {
+    return {
+        entry(1, "Come Together", "The Beatles", "Abbey Road"),
+        entry(2, "Something", "The Beatles", "Abbey Road"),
+        entry(3, "Halo", "Beyonc\xC3\xA9", "I Am... Sasha Fierce"),
+        entry(4, "Killer Queen", "Queen", "Sheer Heart Attack"),
+        entry(5, "Bohemian Rhapsody", "Queen", "A Night at the Opera"),
+        entry(6, "J\xC3\xB3ga", "Bj\xC3\xB6rk", "Homogenic"),
+        entry(7, "Paranoid Android", "Radiohead", "OK Computer"),
+        entry(8, "Queen of Hearts", "Juice Newton", "Juice"),
+        entry(9, "Ace of Spades", "Mot\xC3\xB6rhead", "Ace of Spades"),
+        entry(10, "Don\xE2\x80\x99t Stop Me Now", "Queen", "Jazz"),
+    };
+}
+
+std::vector<int64_t> ids(const std::vector<SearchHit>& hits) {
+    std::vector<int64_t> out;
+    for (const SearchHit& hit : hits) out.push_back(hit.trackId);
+    return out;
+}
+
+std::set<int64_t> idSet(const std::vector<SearchHit>& hits) {
+    std::vector<int64_t> list = ids(hits);
+    return std::set<int64_t>(list.begin(), list.end());
+}
+
+// Pseudo-words from syllables, so trigrams repeat the way real titles do
+std::string randomWords(std::mt19937& rng, int minWords, int maxWords) {
+    static const char* const SYLLABLES[] = {"la", "ve", "ro", "ma", "ti", "ka", "ne", "so", "du", "ri",
+                                            "mo", "be", "an", "el", "tor", "sun", "day", "night", "ly", "ing"};
+    std::uniform_int_distribution<int> words(minWords, maxWords);
+    std::uniform_int_distribution<int> syllables(1, 4);
+    std::uniform_int_distribution<int> pick(0, 19);
+    std::string text;
+    for (int w = words(rng); w > 0; --w) {
+        if (!text.empty()) text += ' ';
+        for (int s = syllables(rng); s > 0; --s) text += SYLLABLES[pick(rng)];
+        if (pick(rng) == 0) text[text.size() - 1] = static_cast<char>(text.back() - 'a' + 'A');
+    }
+    return text;
+}
+
+} // namespace
+
+FTL_TEST(normalizeFoldsCaseDiacriticsAndPunctuation) {
+    EXPECT_EQ(SearchIndex::normalize("Bj\xC3\xB6rk \xE2\x80\x93 J\xC3\xB3ga (Live)"), std::string("bjork joga live"));
+    EXPECT_EQ(SearchIndex::normalize("Stra\xC3\x9F" "e der \xC3\x86on"), std::string("strasse der aeon"));
+    // Decomposed (NFD) e + combining acute, as macOS writes tags
+    EXPECT_EQ(SearchIndex::normalize("Beyonce\xCC\x81"), std::string("beyonce"));
+    EXPECT_EQ(SearchIndex::normalize("Don\xE2\x80\x99t Stop"), std::string("dont stop"));
+    EXPECT_EQ(SearchIndex::normalize("  AC/DC  -- T.N.T. "), std::string("ac dc t n t"));
+    // Fullwidth ASCII, Latin Extended-A, Cyrillic and Greek case
+    EXPECT_EQ(SearchIndex::normalize("\xEF\xBC\xA1\xEF\xBC\xA2\xEF\xBC\xA3 \xC5\x81\xC3\xB3" "d\xC5\xBA"),
+              std::string("abc lodz"));
+    EXPECT_EQ(SearchIndex::normalize("\xD0\x9A\xD0\x98\xD0\x9D\xD0\x9E \xCE\x86\xCE\xA3\xCE\x9C\xCE\x91"),
+              SearchIndex::normalize("\xD0\xBA\xD0\xB8\xD0\xBD\xD0\xBE \xCE\xB1\xCF\x83\xCE\xBC\xCE\xB1"));
+    // Malformed UTF-8 separates words instead of failing
+    EXPECT_EQ(SearchIndex::normalize("ab\xFF" "cd\xC3"), std::string("ab cd"));
+}
+
+FTL_TEST(prefixSubstringAndRanking) {
+    SearchIndex index;
+    index.upsert(smallLibrary());
+    EXPECT_EQ(index.size(), static_cast<size_t>(10));
+
+    // Short tokens match word starts only: "be" is in "Abbey" but does not start a word there
+    EXPECT_TRUE(idSet(index.search("be")) == (std::set<int64_t>{1, 2, 3}));
+    EXPECT_TRUE(idSet(index.search("b")) == (std::set<int64_t>{1, 2, 3, 5, 6}));
+    // Three or more: anywhere in a word
+    EXPECT_TRUE(idSet(index.search("atle")) == (std::set<int64_t>{1, 2}));
+    // (few exact hits, so near misses like "heart" follow them)
+    std::vector<int64_t> head = ids(index.search("HEAD"));
+    ASSERT_TRUE(head.size() >= 2u);
+    EXPECT_TRUE(std::set<int64_t>(head.begin(), head.begin() + 2) == (std::set<int64_t>{7, 9}));
+    // Folded both ways, every token required, in any field
+    EXPECT_TRUE(ids(index.search("bjork")) == (std::vector<int64_t>{6}));
+    EXPECT_TRUE(ids(index.search("BEYONC\xC3\x89 halo")) == (std::vector<int64_t>{3}));
+    std::vector<SearchHit> some = index.search("abbey some");
+    ASSERT_TRUE(!some.empty());
+    EXPECT_EQ(some[0].trackId, static_cast<int64_t>(2));
+    EXPECT_TRUE(ids(index.search("dont stop")) == (std::vector<int64_t>{10}));
+    EXPECT_TRUE(index.search("abbey queen").empty());
+    EXPECT_TRUE(index.search(" -- ").empty());
+
+    // The artist Queen (ties by track ID) before a title that merely starts with the word
+    EXPECT_TRUE(ids(index.search("queen")) == (std::vector<int64_t>{4, 5, 10, 8}));
+    std::vector<SearchHit> hits = index.search("queen");
+    for (size_t i = 1; i < hits.size(); ++i) EXPECT_TRUE(hits[i - 1].score >= hits[i].score);
+
+    // Title beats artist beats album for the same kind of match
+    SearchIndex fields;
+    fields.upsert({entry(1, "x", "y", "Nova"), entry(2, "x", "Nova", "y"), entry(3, "Nova", "x", "y")});
+    EXPECT_TRUE(ids(fields.search("nov")) == (std::vector<int64_t>{3, 2, 1}));
+    EXPECT_TRUE(ids(fields.search("nov", 2)) == (std::vector<int64_t>{3, 2}));
+}
+
+FTL_TEST(typosMatchOnlyWhenExactHitsAreFew) {
+    SearchIndex index;
+    index.upsert(smallLibrary());
+
+    EXPECT_TRUE(idSet(index.search("beatels")) == (std::set<int64_t>{1, 2}));      // Swapped letters
+    EXPECT_TRUE(ids(index.search("radiohaed")) == (std::vector<int64_t>{7}));
+    EXPECT_TRUE(ids(index.search("bohemain rapsody")) == (std::vector<int64_t>{5}));
+    EXPECT_TRUE(ids(index.search("paranoyd")) == (std::vector<int64_t>{7}));
+    // Too far off, or too short to guess at
+    EXPECT_TRUE(index.search("rdhx").empty());
+    EXPECT_TRUE(index.search("bq").empty());
+
+    // Exact hits outrank typo hits
+    std::vector<SearchEntry> library;
+    library.push_back(entry(1, "Heart of Glass", "Blondie", "Parallel Lines"));
+    library.push_back(entry(2, "Hearts", "Marty Balin", "Balin"));
+    library.push_back(entry(3, "Heatr", "Nobody", "Typo"));
+    SearchIndex ranked;
+    ranked.upsert(library);
+    std::vector<SearchHit> hits = ranked.search("heart");
+    ASSERT_TRUE(hits.size() == 3u);
+    EXPECT_EQ(hits.back().trackId, static_cast<int64_t>(3));
+    EXPECT_TRUE(hits[1].score > hits[2].score);
+
+    // With plenty of exact hits no typo pass runs
+    SearchIndex many;
+    std::vector<SearchEntry> hearts;
+    for (int i = 0; i < 20; ++i) hearts.push_back(entry(i, "Heart", "A", "B"));
+    hearts.push_back(entry(100, "Heatr", "A", "B"));
+    many.upsert(hearts);
+    EXPECT_EQ(many.search("heart").size(), static_cast<size_t>(20));
+}
+
+FTL_TEST(updatesAndRemovalsSurviveCompaction) {
+    SearchIndex index;
+    index.upsert(smallLibrary());
+
+    index.upsert(entry(7, "Karma Police", "Radiohead", "OK Computer"));
+    EXPECT_TRUE(index.search("paranoid").empty());
+    EXPECT_TRUE(ids(index.search("karma")) == (std::vector<int64_t>{7}));
+    EXPECT_EQ(index.size(), static_cast<size_t>(10));
+
+    EXPECT_EQ(index.remove({4, 5, 999}), static_cast<size_t>(2));
+    EXPECT_TRUE(idSet(index.search("queen")) == (std::set<int64_t>{8, 10}));
+
+    // Thousands of retags: superseded documents are dropped along the way
+    std::mt19937 rng(7);
+    std::vector<std::string> titles(1500);
+    for (int round = 0; round < 4; ++round) {
+        std::vector<SearchEntry> batch;
+        for (int i = 0; i < 1500; ++i) {
+            titles[i] = randomWords(rng, 1, 3);
+            batch.push_back(SearchEntry{1000 + i, titles[i], "Various", "Mix"});
+        }
+        index.upsert(batch);
+    }
+    EXPECT_EQ(index.size(), static_cast<size_t>(1508));
+    EXPECT_EQ(index.stats().tracks, static_cast<size_t>(1508));
+    for (int i = 0; i < 1500; i += 97) {
+        std::set<int64_t> found = idSet(index.search(titles[i] + " various", 2000));
+        EXPECT_TRUE(found.count(1000 + i) == 1);
+    }
+    std::vector<SearchHit> karma = index.search("karma");
+    ASSERT_TRUE(!karma.empty());
+    EXPECT_EQ(karma[0].trackId, static_cast<int64_t>(7));
+
+    index.clear();
+    EXPECT_EQ(index.size(), static_cast<size_t>(0));
+    EXPECT_TRUE(index.search("karma").empty());
+}
+
+FTL_TEST(agreesWithBruteForceScan) {
+    constexpr int TRACKS = 20000;
+    std::mt19937 rng(42);
+    std::vector<SearchEntry> library;
+    for (int i = 0; i < TRACKS; ++i) {
+        library.push_back(SearchEntry{i, randomWords(rng, 1, 5), randomWords(rng, 1, 2), randomWords(rng, 1, 3)});
+    }
+    SearchIndex index;
+    index.upsert(library);
+
+    std::vector<std::string> normalized;
+    for (const SearchEntry& e : library) {
+        normalized.push_back(" " + SearchIndex::normalize(e.title) + "\n " + SearchIndex::normalize(e.artist) +
+                             "\n " + SearchIndex::normalize(e.album));
+    }
+
+    // Substring queries (3+ chars, taken from real fields) must find exactly what a scan finds
+    std::uniform_int_distribution<int> pickTrack(0, TRACKS - 1);
+    int checked = 0;
+    for (int q = 0; q < 2000 && checked < 150; ++q) {
+        std::string source = SearchIndex::normalize(library[pickTrack(rng)].title);
+        std::uniform_int_distribution<size_t> start(0, source.size() - 1);
+        size_t from = start(rng);
+        std::string token = source.substr(from, 3 + q % 5);
+        if (token.size() < 3 || token.find(' ') != std::string::npos) continue;
+
+        std::set<int64_t> expected;
+        for (int i = 0; i < TRACKS; ++i) {
+            if (normalized[i].find(token) != std::string::npos) expected.insert(i);
+        }
+        std::set<int64_t> found = idSet(index.search(token, TRACKS));
+        if (expected.size() >= SEARCH_FUZZY_BELOW_HITS) {
+            EXPECT_TRUE(found == expected);
+        } else {
+            // The typo pass may add near misses
+            EXPECT_TRUE(std::includes(found.begin(), found.end(), expected.begin(), expected.end()));
+        }
+        ++checked;
+    }
+    EXPECT_EQ(checked, 150);
+
+    // Word-prefix queries
+    for (const char* prefix : {"l", "ve", "s", "ri"}) {
+        std::set<int64_t> expected;
+        std::string needle = std::string(" ") + prefix;
+        for (int i = 0; i < TRACKS; ++i) {
+            std::string text = normalized[i];
+            std::replace(text.begin(), text.end(), '\n', ' ');
+            if (text.find(needle) != std::string::npos) expected.insert(i);
+        }
+        EXPECT_TRUE(idSet(index.search(prefix, TRACKS)) == expected);
+    }
+
+    SearchIndexStats stats = index.stats();
+    double perTenThousand = stats.memoryBytes * 10000.0 / TRACKS;
+    std::printf("    %zu words, %.0f KB postings, %.2f MB per 10k tracks\n",
+                stats.words, stats.postingBytes / 1024.0, perTenThousand / (1024.0 * 1024.0));
+    EXPECT_EQ(stats.tracks, static_cast<size_t>(TRACKS));
+    EXPECT_LE(perTenThousand, 4.0 * 1024 * 1024);
+}
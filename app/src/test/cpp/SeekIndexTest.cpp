@@ -0,0 +1,195 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - SEEK INDEX TESTS            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Sidecar seek index on a long, seektable-less FLAC: correctness, stale
+ * sidecar rejection, and seek I/O/latency with vs. without the index.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "FlacSource.h"
+#include "SeekIndex.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr int64_t TOTAL_FRAMES = 48000 * 30 + 777;
+constexpr int SEEK_COUNT = 40;
+
+/** Noise whose level (and so FLAC bitrate) changes every second, like real music */
+int16_t vbrSample(int64_t frame, int channel) {
+    int64_t second = frame / SAMPLE_RATE;
+    int shift = static_cast<int>((second * 7 + second / 3) % 13);
+    return static_cast<int16_t>(noiseSample(frame, channel) >> shift);
+}
+
+std::vector<int16_t> makeVbrSignal(int64_t frames) {
+    std::vector<int16_t> samples(static_cast<size_t>(frames) * 2);
+    for (int64_t i = 0; i < frames; ++i) {
+        samples[i * 2] = vbrSample(i, 0);
+        samples[i * 2 + 1] = vbrSample(i, 1);
+    }
+    return samples;
+}
+
+const std::string& fixturePath() {
+    static const std::string path = [] {
+        std::string file = tempPath("long_noise.flac");
+        FlacWriteOptions options;
+        options.seekTable = false;       // Typical of live recordings
+        if (!writeFlac16(file, makeVbrSignal(TOTAL_FRAMES), SAMPLE_RATE, options)) {
+            reportFailure(__FILE__, __LINE__, "cannot write fixture");
+        }
+        return file;
+    }();
+    return path;
+}
+
+bool readsSignal(AudioSource& source, int64_t firstFrame, int32_t frames) {
+    std::vector<float> buffer(static_cast<size_t>(frames) * 2);
+    if (source.read(buffer.data(), frames) != frames) return false;
+    for (int32_t i = 0; i < frames; ++i) {
+        for (int ch = 0; ch < 2; ++ch) {
+            if (std::lround(buffer[i * 2 + ch] * 32768.0f) != vbrSample(firstFrame + i, ch)) return false;
+        }
+    }
+    return true;
+}
+
+struct SeekCost {
+    double bytesPerSeek = 0.0;
+    double readsPerSeek = 0.0;
+    double microsPerSeek = 0.0;
+};
+
+/** First seek after open - what the user feels when scrubbing a track just started */
+SeekCost measureColdSeeks(const std::string& sidecar) {
+    SeekCost cost;
+    uint64_t state = 12345;
+    for (int i = 0; i < SEEK_COUNT; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        int64_t target = static_cast<int64_t>((state >> 33) % static_cast<uint64_t>(TOTAL_FRAMES - 64));
+
+        FlacSource source;
+        EXPECT_TRUE(source.open(fixturePath()));
+        if (!sidecar.empty()) {
+            EXPECT_TRUE(source.loadSeekIndex(sidecar));
+        }
+
+        IoStats before = source.ioStats();
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(source.seekToFrame(target));
+        cost.microsPerSeek += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        cost.bytesPerSeek += static_cast<double>(source.ioStats().bytesRead - before.bytesRead);
+        cost.readsPerSeek += static_cast<double>(source.ioStats().readRequests - before.readRequests);
+        EXPECT_TRUE(readsSignal(source, target, 64));
+    }
+
+    cost.microsPerSeek /= SEEK_COUNT;
+    cost.bytesPerSeek /= SEEK_COUNT;
+    cost.readsPerSeek /= SEEK_COUNT;
+    return cost;
+}
+
+} // namespace
+
+FTL_TEST(sidecarCoversEveryFrame) {
+    std::string sidecar = tempPath("long_noise.ftlidx");
+    ASSERT_TRUE(buildSeekIndex(fixturePath(), sidecar));
+
+    SourceStamp stamp;
+    ASSERT_TRUE(SourceStamp::of(fixturePath(), stamp));
+    SeekIndex index;
+    ASSERT_TRUE(index.map(sidecar, stamp));
+    EXPECT_EQ(index.header().spacingFrames, 4096u);
+    EXPECT_EQ(index.header().entryCount, static_cast<uint64_t>((TOTAL_FRAMES + 4095) / 4096));
+    EXPECT_EQ(index.mappedBytes(), sizeof(SeekIndexHeader) + index.header().entryCount * 8);
+
+    // Cross-check against the frame walk
+    FlacSource source;
+    ASSERT_TRUE(source.open(fixturePath()));
+    std::vector<FlacSeekPoint> frames;
+    ASSERT_TRUE(source.scanFrames(frames));
+    EXPECT_EQ(frames.size(), static_cast<size_t>((TOTAL_FRAMES + 4095) / 4096));
+    for (size_t i = 0; i < frames.size(); i += 37) {
+        int64_t sample = 0, offset = 0;
+        EXPECT_TRUE(index.lookup(frames[i].sample + 100, sample, offset));
+        EXPECT_EQ(sample, frames[i].sample);
+        EXPECT_EQ(offset, frames[i].offset);
+    }
+    int64_t sample = 0, offset = 0;
+    EXPECT_TRUE(!index.lookup(TOTAL_FRAMES + 4096, sample, offset));
+}
+
+FTL_TEST(indexedSeeksReadLessAndAreExact) {
+    std::string sidecar = tempPath("long_noise_io.ftlidx");
+    ASSERT_TRUE(buildSeekIndex(fixturePath(), sidecar));
+
+    SeekCost without = measureColdSeeks("");
+    SeekCost with = measureColdSeeks(sidecar);
+
+    std::printf("  without index: %.0f bytes, %.2f reads, %.1f us per seek\n",
+                without.bytesPerSeek, without.readsPerSeek, without.microsPerSeek);
+    std::printf("  with index:    %.0f bytes, %.2f reads, %.1f us per seek\n",
+                with.bytesPerSeek, with.readsPerSeek, with.microsPerSeek);
+
+    // One buffer at the frame (two when the frame straddles it)
+    EXPECT_LE(with.readsPerSeek, 2.0);
+    EXPECT_TRUE(with.bytesPerSeek < without.bytesPerSeek);
+    EXPECT_LE(with.readsPerSeek, without.readsPerSeek);
+}
+
+FTL_TEST(staleSidecarIsRejected) {
+    std::string copy = tempPath("stale.flac");
+    FlacWriteOptions options;
+    options.seekTable = false;
+    ASSERT_TRUE(writeFlac16(copy, makeNoiseSignal(48000), SAMPLE_RATE, options));
+    std::string sidecar = tempPath("stale.ftlidx");
+    ASSERT_TRUE(buildSeekIndex(copy, sidecar));
+
+    // Re-encoding the file in place changes size/mtime
+    ASSERT_TRUE(writeFlac16(copy, makeNoiseSignal(96000), SAMPLE_RATE, options));
+    struct timespec times[2] = {{0, UTIME_NOW}, {12345, 0}};
+    utimensat(AT_FDCWD, copy.c_str(), times, 0);
+
+    FlacSource source;
+    ASSERT_TRUE(source.open(copy));
+    EXPECT_TRUE(!source.loadSeekIndex(sidecar));
+    EXPECT_TRUE(!source.loadSeekIndex(tempPath("missing.ftlidx")));
+}
+
+FTL_TEST(engineBuildsSidecarOnFirstPlay) {
+    std::string directory = tempPath("");
+    std::string sidecar = SeekIndex::sidecarPath(directory, fixturePath());
+    std::remove(sidecar.c_str());
+
+    FTLAudioEngine engine;
+    AudioEngineConfig config;
+    config.framesPerBurst = 240;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    engine.setSeekIndexDirectory(directory);
+    ASSERT_TRUE(engine.setAudioSource(fixturePath()) == EngineResult::SUCCESS);
+
+    SourceStamp stamp;
+    ASSERT_TRUE(SourceStamp::of(fixturePath(), stamp));
+    SeekIndex index;
+    bool built = false;
+    for (int i = 0; i < 500 && !built; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        built = index.map(sidecar, stamp);
+    }
+    EXPECT_TRUE(built);
+    engine.shutdown();
+}
@@ -0,0 +1,226 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║           FTL AUDIO ENGINE - STREAM RECOVERY TESTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * A disconnected stream is reopened off the callback thread and playback
+ * carries on where it was: no gap or skip in the rendered program, the
+ * playhead keeps counting, and the time to resume is reported. A new
+ * device that runs at another rate gets a shared stream at the source
+ * rate, a 16-bit-only device gets a PCM_I16 stream, and a paused engine
+ * comes back paused.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AudioFormat.h"
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr double TONE_HZ = 1000.0;
+constexpr double TONE_AMPLITUDE = 0.25;
+
+// Largest step between consecutive left samples (a gap or skip in the tone shows up as a jump)
+struct Continuity {
+    std::atomic<int64_t> bursts{0};
+    std::atomic<float> peak{0.0f};
+    std::atomic<float> maxStep{0.0f};
+    float last = 0.0f;
+
+    static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+        auto* self = static_cast<Continuity*>(userData);
+        float peak = 0.0f;
+        float maxStep = self->maxStep.load();
+        for (int32_t i = 0; i < numFrames; ++i) {
+            float sample = frames[i * channelCount];
+            peak = std::max(peak, std::fabs(sample));
+            maxStep = std::max(maxStep, std::fabs(sample - self->last));
+            self->last = sample;
+        }
+        self->peak.store(peak);
+        self->maxStep.store(maxStep);
+        self->bursts.fetch_add(1);
+    }
+};
+
+std::string writeTone(const char* name, int rate) {
+    std::string path = tempPath(name);
+    writeWav16(path, makeSineSignal(rate * 10, 2, rate, TONE_HZ, TONE_AMPLITUDE), 2, rate);
+    return path;
+}
+
+bool waitForRecoveries(FTLAudioEngine& engine, uint64_t count) {
+    for (int i = 0; i < 200; ++i) {
+        if (engine.getPerformanceMetrics().streamRecoveries >= count) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+} // namespace
+
+FTL_TEST(playbackResumesAfterDisconnect) {
+    const int rate = 48000;
+    std::string path = writeTone("recovery_tone.wav", rate);
+    Continuity continuity;
+    host::setOutputTap(&Continuity::tap, &continuity);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = rate;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    int64_t playheadBefore = engine.getPlayheadFrame();
+    EXPECT_TRUE(playheadBefore > rate / 10);
+
+    host::injectDisconnect(host::getLastOpenedStream());
+    ASSERT_TRUE(waitForRecoveries(engine, 1));
+    int64_t burstsAtRecovery = continuity.bursts.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    EXPECT_TRUE(continuity.bursts.load() > burstsAtRecovery + 10);
+    EXPECT_NEAR(continuity.peak.load(), TONE_AMPLITUDE, 1e-3);
+    // One sample step of the tone is 2π·f/rate·A = 0.033: nothing dropped or repeated
+    EXPECT_LE(continuity.maxStep.load(), 0.034f);
+
+    // The playhead kept counting through the reopen (no jump back to the stream's frame 0)
+    int64_t playheadAfter = engine.getPlayheadFrame();
+    EXPECT_TRUE(playheadAfter > playheadBefore);
+    EXPECT_TRUE(playheadAfter < playheadBefore + rate);
+
+    PerformanceMetrics metrics = engine.getPerformanceMetrics();
+    EXPECT_EQ(metrics.streamRecoveries, 1u);
+    EXPECT_TRUE(metrics.lastRecoveryMs > 0.0);
+    EXPECT_LE(metrics.lastRecoveryMs, 100.0);
+    std::printf("    time to resume: %.2f ms\n", metrics.lastRecoveryMs);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
+
+FTL_TEST(newDeviceRateKeepsSourceRate) {
+    const int rate = 44100;
+    std::string path = writeTone("recovery_tone_44k.wav", rate);
+    Continuity continuity;
+    host::setOutputTap(&Continuity::tap, &continuity);
+    host::BackendSettings settings;
+    settings.deviceSampleRate = 48000;
+    host::setBackendSettings(settings);
+
+    AudioEngineConfig config;
+    config.sampleRate = 48000;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    host::injectDisconnect(host::getLastOpenedStream());
+    ASSERT_TRUE(waitForRecoveries(engine, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // The 48 kHz device cannot take 44.1 kHz exclusively: the shared mixer resamples
+    AAudioStream* stream = host::getLastOpenedStream();
+    EXPECT_EQ(AAudioStream_getSampleRate(stream), rate);
+    EXPECT_TRUE(AAudioStream_getSharingMode(stream) == AAUDIO_SHARING_MODE_SHARED);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    EXPECT_NEAR(continuity.peak.load(), TONE_AMPLITUDE, 1e-3);
+    EXPECT_LE(continuity.maxStep.load(), 0.04f);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+    host::setBackendSettings(host::BackendSettings());
+}
+
+FTL_TEST(sixteenBitDeviceGetsConvertedOutput) {
+    float in[] = {0.0f, 0.25f, -0.25f, 1.5f, -1.5f, 0.5f / 32768.0f};
+    int16_t out[6];
+    pcm::floatToS16(in, out, 6);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 8192);
+    EXPECT_EQ(out[2], -8192);
+    EXPECT_EQ(out[3], 32767);
+    EXPECT_EQ(out[4], -32768);
+
+    const int rate = 48000;
+    std::string path = writeTone("recovery_tone_s16.wav", rate);
+    Continuity continuity;
+    host::setOutputTap(&Continuity::tap, &continuity);
+    host::BackendSettings settings;
+    settings.deviceSupportsFloat = false;
+    host::setBackendSettings(settings);
+
+    AudioEngineConfig config;
+    config.sampleRate = rate;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(AAudioStream_getFormat(host::getLastOpenedStream()) == AAUDIO_FORMAT_PCM_I16);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    host::injectDisconnect(host::getLastOpenedStream());
+    ASSERT_TRUE(waitForRecoveries(engine, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_TRUE(AAudioStream_getFormat(host::getLastOpenedStream()) == AAUDIO_FORMAT_PCM_I16);
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::RUNNING);
+    EXPECT_NEAR(continuity.peak.load(), TONE_AMPLITUDE, 1.0 / 32768.0 + 1e-3);
+    EXPECT_LE(continuity.maxStep.load(), 0.034f);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+    host::setBackendSettings(host::BackendSettings());
+}
+
+FTL_TEST(pausedEngineRecoversPaused) {
+    const int rate = 48000;
+    std::string path = writeTone("recovery_tone_paused.wav", rate);
+    Continuity continuity;
+    host::setOutputTap(&Continuity::tap, &continuity);
+    host::setBackendSettings(host::BackendSettings());
+
+    AudioEngineConfig config;
+    config.sampleRate = rate;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(engine.pausePlayback() == EngineResult::SUCCESS);
+
+    host::injectDisconnect(host::getLastOpenedStream());
+    ASSERT_TRUE(waitForRecoveries(engine, 1));
+    int64_t pausedBursts = continuity.bursts.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(engine.getCurrentState() == EngineState::PAUSED);
+    EXPECT_EQ(continuity.bursts.load(), pausedBursts);
+
+    ASSERT_TRUE(engine.resumePlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(continuity.bursts.load() > pausedBursts + 10);
+    EXPECT_NEAR(continuity.peak.load(), TONE_AMPLITUDE, 1e-3);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
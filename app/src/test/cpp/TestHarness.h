@@ -0,0 +1,92 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - HOST TEST HARNESS           ║
+ * ║           Minimal Assertions for Native Host Tests          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * Each test file is its own executable (see CMakeLists.txt) linked with
+ * TestMain.cpp, which runs every FTL_TEST in registration order.
+ */
+
+#ifndef FTL_TEST_HARNESS_H
+#define FTL_TEST_HARNESS_H
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ftl_test {
+
+struct TestCase {
+    const char* name;
+    void (*body)();
+};
+
+std::vector<TestCase>& registry();
+void reportFailure(const char* file, int line, const std::string& message);
+
+/** Scratch directory unique to this test process (created on first use) */
+std::string tempPath(const std::string& fileName);
+
+struct Registrar {
+    Registrar(const char* name, void (*body)()) { registry().push_back({name, body}); }
+};
+
+template <typename A, typename B>
+std::string describe(const char* expression, const A& actual, const B& expected) {
+    std::ostringstream out;
+    out << expression << " (actual: " << actual << ", expected: " << expected << ")";
+    return out.str();
+}
+
+} // namespace ftl_test
+
+#define FTL_TEST(name)                                                     \
+    static void name();                                                    \
+    static ::ftl_test::Registrar name##_registrar(#name, name);            \
+    static void name()
+
+#define EXPECT_TRUE(cond)                                                  \
+    do {                                                                   \
+        if (!(cond)) ::ftl_test::reportFailure(__FILE__, __LINE__, #cond); \
+    } while (0)
+
+#define ASSERT_TRUE(cond)                                                  \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            ::ftl_test::reportFailure(__FILE__, __LINE__, #cond);          \
+            return;                                                        \
+        }                                                                  \
+    } while (0)
+
+#define EXPECT_EQ(actual, expected)                                        \
+    do {                                                                   \
+        auto&& a_ = (actual);                                              \
+        auto&& e_ = (expected);                                            \
+        if (!(a_ == e_))                                                   \
+            ::ftl_test::reportFailure(__FILE__, __LINE__,                  \
+                ::ftl_test::describe(#actual " == " #expected, a_, e_));   \
+    } while (0)
+
+#define EXPECT_NEAR(actual, expected, tolerance)                           \
+    do {                                                                   \
+        double a_ = (actual);                                              \
+        double e_ = (expected);                                            \
+        if (!(std::fabs(a_ - e_) <= (tolerance)))                          \
+            ::ftl_test::reportFailure(__FILE__, __LINE__,                  \
+                ::ftl_test::describe(#actual " ~= " #expected, a_, e_));   \
+    } while (0)
+
+#define EXPECT_LE(actual, bound)                                           \
+    do {                                                                   \
+        auto&& a_ = (actual);                                              \
+        auto&& b_ = (bound);                                               \
+        if (!(a_ <= b_))                                                   \
+            ::ftl_test::reportFailure(__FILE__, __LINE__,                  \
+                ::ftl_test::describe(#actual " <= " #bound, a_, b_));      \
+    } while (0)
+
+#endif // FTL_TEST_HARNESS_H
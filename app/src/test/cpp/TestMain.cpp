@@ -0,0 +1,57 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║              FTL AUDIO ENGINE - HOST TEST RUNNER            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ */
+
+#include "TestHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace ftl_test {
+
+namespace {
+int g_failures = 0;
+}
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+void reportFailure(const char* file, int line, const std::string& message) {
+    std::fprintf(stderr, "  %s:%d: FAILED %s\n", file, line, message.c_str());
+    ++g_failures;
+}
+
+std::string tempPath(const std::string& fileName) {
+    static const std::string directory = [] {
+        const char* base = std::getenv("TMPDIR");
+        std::string pattern = std::string(base ? base : "/tmp") + "/ftl_test_XXXXXX";
+        if (!mkdtemp(&pattern[0])) {
+            std::perror("mkdtemp");
+            std::exit(2);
+        }
+        return pattern;
+    }();
+    return directory + "/" + fileName;
+}
+
+} // namespace ftl_test
+
+int main() {
+    int failedTests = 0;
+    for (const auto& test : ftl_test::registry()) {
+        int before = ftl_test::g_failures;
+        std::printf("[ RUN  ] %s\n", test.name);
+        std::fflush(stdout);
+        test.body();
+        bool passed = ftl_test::g_failures == before;
+        std::printf("[ %s ] %s\n", passed ? " OK " : "FAIL", test.name);
+        failedTests += passed ? 0 : 1;
+    }
+    std::printf("%zu tests, %d failed\n", ftl_test::registry().size(), failedTests);
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,362 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - TEST SIGNAL FILES            ║
+ * ║        Frame-Index Encoded WAV/FLAC Writers for Tests       ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * 🎵 CYBER AQUA (#00FFFF) • NEURAL INDIGO (#4B0082) • AUDIOPHILE GRADE 🎵
+ *
+ * The "index" signal stores each frame's own index in its samples
+ * (left = low 16 bits, right = high 16 bits), so any decoded or rendered
+ * frame tells exactly which source frame it came from.
+ */
+
+#ifndef FTL_TEST_SIGNALS_H
+#define FTL_TEST_SIGNALS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace ftl_test {
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// INDEX SIGNAL
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+inline int16_t indexSample(int64_t frame, int channel) {
+    uint32_t bits = channel == 0 ? static_cast<uint32_t>(frame & 0xFFFF)
+                                 : static_cast<uint32_t>((frame >> 16) & 0xFFFF);
+    return static_cast<int16_t>(static_cast<int32_t>(bits) - 32768);
+}
+
+/** Stereo 16-bit interleaved index signal */
+inline std::vector<int16_t> makeIndexSignal(int64_t frames) {
+    std::vector<int16_t> samples(static_cast<size_t>(frames) * 2);
+    for (int64_t i = 0; i < frames; ++i) {
+        samples[i * 2] = indexSample(i, 0);
+        samples[i * 2 + 1] = indexSample(i, 1);
+    }
+    return samples;
+}
+
+/** Frame index carried by a decoded stereo float frame, -1 for silence */
+inline int64_t decodeIndex(const float* frame) {
+    if (frame[0] == 0.0f && frame[1] == 0.0f) {
+        return -1;
+    }
+    int64_t low = std::lround(frame[0] * 32768.0f) + 32768;
+    int64_t high = std::lround(frame[1] * 32768.0f) + 32768;
+    return low | (high << 16);
+}
+
+/** Deterministic white noise (barely compressible - realistic FLAC frame sizes) */
+inline int16_t noiseSample(int64_t frame, int channel) {
+    uint64_t x = static_cast<uint64_t>(frame) * 2 + static_cast<uint64_t>(channel) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<int16_t>((x ^ (x >> 31)) >> 48);
+}
+
+inline std::vector<int16_t> makeNoiseSignal(int64_t frames) {
+    std::vector<int16_t> samples(static_cast<size_t>(frames) * 2);
+    for (int64_t i = 0; i < frames; ++i) {
+        samples[i * 2] = noiseSample(i, 0);
+        samples[i * 2 + 1] = noiseSample(i, 1);
+    }
+    return samples;
+}
+
+/** 16-bit sine, same value on every channel */
+inline std::vector<int16_t> makeSineSignal(int64_t frames, int channels, int sampleRate,
+                                           double frequency, double amplitude) {
+    std::vector<int16_t> samples(static_cast<size_t>(frames) * channels);
+    for (int64_t i = 0; i < frames; ++i) {
+        double value = amplitude * std::sin(2.0 * M_PI * frequency * i / sampleRate);
+        int16_t sample = static_cast<int16_t>(std::lround(value * 32767.0));
+        for (int ch = 0; ch < channels; ++ch) {
+            samples[i * channels + ch] = sample;
+        }
+    }
+    return samples;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// WAV WRITER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+class ByteWriter {
+public:
+    void u8(uint32_t v) { m_bytes.push_back(static_cast<uint8_t>(v)); }
+    void le16(uint32_t v) { u8(v); u8(v >> 8); }
+    void le32(uint32_t v) { le16(v); le16(v >> 16); }
+    void be(uint64_t v, int bytes) {
+        for (int i = bytes - 1; i >= 0; --i) u8(static_cast<uint32_t>(v >> (i * 8)));
+    }
+    void text(const char* s) { while (*s) u8(static_cast<uint8_t>(*s++)); }
+    void append(const std::vector<uint8_t>& other) { m_bytes.insert(m_bytes.end(), other.begin(), other.end()); }
+
+    size_t size() const { return m_bytes.size(); }
+    std::vector<uint8_t>& bytes() { return m_bytes; }
+
+    bool save(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(m_bytes.data(), 1, m_bytes.size(), file) == m_bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+/** 16-bit PCM WAV with a LIST chunk ahead of data to exercise chunk walking */
+inline bool writeWav16(const std::string& path, const std::vector<int16_t>& samples,
+                       int channels, int sampleRate) {
+    ByteWriter out;
+    uint32_t dataBytes = static_cast<uint32_t>(samples.size() * 2);
+    out.text("RIFF");
+    out.le32(4 + (8 + 16) + (8 + 6) + (8 + dataBytes));
+    out.text("WAVE");
+    out.text("fmt ");
+    out.le32(16);
+    out.le16(1);
+    out.le16(channels);
+    out.le32(sampleRate);
+    out.le32(sampleRate * channels * 2);
+    out.le16(channels * 2);
+    out.le16(16);
+    out.text("LIST");
+    out.le32(6);
+    out.text("INFOxx");
+    out.text("data");
+    out.le32(dataBytes);
+    for (int16_t s : samples) out.le16(static_cast<uint16_t>(s));
+    return out.save(path);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FLAC WRITER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+enum class StereoMode { INDEPENDENT, LEFT_SIDE, MID_SIDE };
+
+struct FlacWriteOptions {
+    int blockSize = 4096;
+    StereoMode stereo = StereoMode::INDEPENDENT;
+    bool seekTable = true;
+    int seekPointSpacing = 4;        // Frames between seek points
+};
+
+class BitWriter {
+public:
+    void bits(uint64_t value, int count) {
+        for (int i = count - 1; i >= 0; --i) {
+            m_accumulator = (m_accumulator << 1) | ((value >> i) & 1u);
+            if (++m_count == 8) flushByte();
+        }
+    }
+    void signedBits(int64_t value, int count) { bits(static_cast<uint64_t>(value) & ((1ull << count) - 1), count); }
+    void unary(uint32_t zeros) {
+        for (uint32_t i = 0; i < zeros; ++i) bits(0, 1);
+        bits(1, 1);
+    }
+    void alignToByte() { while (m_count != 0) bits(0, 1); }
+    std::vector<uint8_t>& bytes() { return m_bytes; }
+
+private:
+    void flushByte() {
+        m_bytes.push_back(static_cast<uint8_t>(m_accumulator));
+        m_accumulator = 0;
+        m_count = 0;
+    }
+    std::vector<uint8_t> m_bytes;
+    uint32_t m_accumulator = 0;
+    int m_count = 0;
+};
+
+inline uint8_t flacCrc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+    }
+    return crc;
+}
+
+inline uint16_t flacCrc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+/** Subframe: CONSTANT when possible, else the best FIXED predictor (order 0-4) */
+inline void writeSubframe(BitWriter& out, const std::vector<int64_t>& x, int bps) {
+    bool constant = std::all_of(x.begin(), x.end(), [&](int64_t v) { return v == x[0]; });
+    if (constant) {
+        out.bits(0, 8);               // pad + type CONSTANT + no wasted bits
+        out.signedBits(x[0], bps);
+        return;
+    }
+
+    const int n = static_cast<int>(x.size());
+    int bestOrder = 0;
+    uint64_t bestCost = UINT64_MAX;
+    std::vector<int64_t> residual, bestResidual;
+    for (int order = 0; order <= std::min(4, n - 1); ++order) {
+        residual.assign(n - order, 0);
+        uint64_t cost = 0;
+        for (int i = order; i < n; ++i) {
+            int64_t r;
+            switch (order) {
+                case 0: r = x[i]; break;
+                case 1: r = x[i] - x[i - 1]; break;
+                case 2: r = x[i] - 2 * x[i - 1] + x[i - 2]; break;
+                case 3: r = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3]; break;
+                default: r = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4]; break;
+            }
+            residual[i - order] = r;
+            cost += static_cast<uint64_t>(std::llabs(r));
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestOrder = order;
+            bestResidual = residual;
+        }
+    }
+
+    out.bits(0, 1);
+    out.bits(0x08 | bestOrder, 6);    // FIXED
+    out.bits(0, 1);
+    for (int i = 0; i < bestOrder; ++i) out.signedBits(x[i], bps);
+
+    // Rice, partition order 0, parameter from the mean folded residual
+    uint64_t sum = 0;
+    for (int64_t r : bestResidual) sum += static_cast<uint64_t>(r < 0 ? -2 * r - 1 : 2 * r);
+    uint64_t mean = bestResidual.empty() ? 0 : sum / bestResidual.size();
+    int k = 0;
+    while (k < 14 && (1ull << (k + 1)) <= mean) ++k;
+
+    out.bits(0, 2);
+    out.bits(0, 4);
+    out.bits(k, 4);
+    for (int64_t r : bestResidual) {
+        uint64_t folded = static_cast<uint64_t>(r < 0 ? -2 * r - 1 : 2 * r);
+        out.unary(static_cast<uint32_t>(folded >> k));
+        out.bits(folded & ((1ull << k) - 1), k);
+    }
+}
+
+inline void writeUtf8Number(BitWriter& out, uint32_t value) {
+    if (value < 0x80) {
+        out.bits(value, 8);
+    } else if (value < 0x800) {
+        out.bits(0xC0 | (value >> 6), 8);
+        out.bits(0x80 | (value & 0x3F), 8);
+    } else {
+        out.bits(0xE0 | (value >> 12), 8);
+        out.bits(0x80 | ((value >> 6) & 0x3F), 8);
+        out.bits(0x80 | (value & 0x3F), 8);
+    }
+}
+
+/** Stereo 16-bit FLAC (fixed blocking) from an interleaved signal */
+inline bool writeFlac16(const std::string& path, const std::vector<int16_t>& samples,
+                        int sampleRate, const FlacWriteOptions& options = FlacWriteOptions()) {
+    const int channels = 2;
+    const int64_t totalFrames = static_cast<int64_t>(samples.size()) / channels;
+    const int blockSize = options.blockSize;
+    const int64_t frameCount = (totalFrames + blockSize - 1) / blockSize;
+
+    // Encode frames first: the seektable needs their offsets
+    std::vector<uint8_t> audio;
+    std::vector<uint64_t> frameOffsets;
+    for (int64_t f = 0; f < frameCount; ++f) {
+        int64_t first = f * blockSize;
+        int n = static_cast<int>(std::min<int64_t>(blockSize, totalFrames - first));
+        frameOffsets.push_back(audio.size());
+
+        std::vector<int64_t> left(n), right(n);
+        for (int i = 0; i < n; ++i) {
+            left[i] = samples[(first + i) * 2];
+            right[i] = samples[(first + i) * 2 + 1];
+        }
+
+        int assignment = 1;
+        std::vector<int64_t> a = left, b = right;
+        int bpsA = 16, bpsB = 16;
+        if (options.stereo == StereoMode::LEFT_SIDE) {
+            assignment = 8;
+            for (int i = 0; i < n; ++i) b[i] = left[i] - right[i];
+            bpsB = 17;
+        } else if (options.stereo == StereoMode::MID_SIDE) {
+            assignment = 10;
+            for (int i = 0; i < n; ++i) {
+                a[i] = (left[i] + right[i]) >> 1;
+                b[i] = left[i] - right[i];
+            }
+            bpsB = 17;
+        }
+
+        BitWriter frame;
+        frame.bits(0xFFF8, 16);               // Sync + fixed blocking
+        frame.bits(7, 4);                     // Block size: 16-bit field follows
+        frame.bits(0, 4);                     // Sample rate from STREAMINFO
+        frame.bits(assignment, 4);
+        frame.bits(4, 3);                     // 16 bits per sample
+        frame.bits(0, 1);
+        writeUtf8Number(frame, static_cast<uint32_t>(f));
+        frame.bits(n - 1, 16);
+        frame.bits(flacCrc8(frame.bytes().data(), frame.bytes().size()), 8);
+
+        writeSubframe(frame, a, bpsA);
+        writeSubframe(frame, b, bpsB);
+        frame.alignToByte();
+        frame.bits(flacCrc16(frame.bytes().data(), frame.bytes().size()), 16);
+        audio.insert(audio.end(), frame.bytes().begin(), frame.bytes().end());
+    }
+
+    ByteWriter out;
+    out.text("fLaC");
+
+    std::vector<size_t> seekFrames;
+    if (options.seekTable) {
+        for (int64_t f = 0; f < frameCount; f += options.seekPointSpacing) seekFrames.push_back(static_cast<size_t>(f));
+    }
+
+    out.u8(seekFrames.empty() ? 0x80 : 0x00);   // STREAMINFO, last block unless a seektable follows
+    out.be(34, 3);
+    out.be(blockSize, 2);
+    out.be(blockSize, 2);
+    out.be(0, 3);
+    out.be(0, 3);
+    // 20 bits rate, 3 bits channels-1, 5 bits bps-1, 36 bits total samples
+    uint64_t packed = (static_cast<uint64_t>(sampleRate) << 44) | (static_cast<uint64_t>(channels - 1) << 41) |
+                      (static_cast<uint64_t>(15) << 36) | static_cast<uint64_t>(totalFrames);
+    out.be(packed, 8);
+    for (int i = 0; i < 16; ++i) out.u8(0);     // MD5 unset
+
+    if (!seekFrames.empty()) {
+        out.u8(0x80 | 3);
+        out.be(seekFrames.size() * 18, 3);
+        for (size_t f : seekFrames) {
+            out.be(static_cast<uint64_t>(f) * blockSize, 8);
+            out.be(frameOffsets[f], 8);
+            out.be(static_cast<uint64_t>(std::min<int64_t>(blockSize, totalFrames - static_cast<int64_t>(f) * blockSize)), 2);
+        }
+    }
+
+    out.append(audio);
+    return out.save(path);
+}
+
+} // namespace ftl_test
+
+#endif // FTL_TEST_SIGNALS_H
@@ -0,0 +1,388 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - TIME STRETCH TESTS           ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * The real FFT against the double-precision reference; tempo and pitch
+ * through both stretch modes, measured on tones (consumption rate and
+ * zero-crossing frequency); transient preservation on a click train; and
+ * the engine path: offline renders shorten by the tempo, the playhead
+ * follows the source clock, seeks land, and the setters are refused
+ * without `enableTimeStretch`.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+#include "OfflineRender.h"
+#include "RealFft.h"
+#include "SignalAnalysis.h"
+#include "TimeStretch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int CHANNELS = 2;
+
+/** Interleaved stereo sine, same on both channels */
+std::vector<float> makeTone(int64_t frames, double frequency, double amplitude) {
+    std::vector<float> samples(static_cast<size_t>(frames) * CHANNELS);
+    for (int64_t i = 0; i < frames; ++i) {
+        float value = static_cast<float>(amplitude * std::sin(2.0 * M_PI * frequency * i / RATE));
+        samples[i * CHANNELS] = value;
+        samples[i * CHANNELS + 1] = value;
+    }
+    return samples;
+}
+
+struct VectorInput {
+    const std::vector<float>* samples;
+    int64_t position = 0;
+
+    static int32_t pull(float* frames, int32_t count, void* userData) {
+        auto* self = static_cast<VectorInput*>(userData);
+        int64_t available = static_cast<int64_t>(self->samples->size()) / CHANNELS - self->position;
+        int32_t n = static_cast<int32_t>(std::min<int64_t>(count, std::max<int64_t>(available, 0)));
+        std::memcpy(frames, self->samples->data() + self->position * CHANNELS,
+                    sizeof(float) * n * CHANNELS);
+        self->position += n;
+        return n;
+    }
+};
+
+/** Stretch `input` in bursts of 240 until `outputFrames` are out or the input runs dry */
+std::vector<float> stretch(TimeStretcher& stretcher, const std::vector<float>& input, int64_t outputFrames) {
+    constexpr int32_t BURST = 240;
+    VectorInput source{&input};
+    std::vector<float> output;
+    std::vector<float> burst(BURST * CHANNELS);
+    while (static_cast<int64_t>(output.size()) / CHANNELS < outputFrames) {
+        int32_t rendered = stretcher.process(burst.data(), BURST, &VectorInput::pull, &source);
+        output.insert(output.end(), burst.begin(), burst.begin() + rendered * CHANNELS);
+        if (rendered < BURST) break;
+    }
+    return output;
+}
+
+/** Frequency from rising zero crossings of channel 0 over [begin, end), interpolated */
+double measureFrequency(const std::vector<float>& samples, int64_t begin, int64_t end) {
+    double first = -1.0, last = -1.0;
+    int crossings = 0;
+    for (int64_t i = begin + 1; i < end; ++i) {
+        float a = samples[(i - 1) * CHANNELS], b = samples[i * CHANNELS];
+        if (a < 0.0f && b >= 0.0f) {
+            double at = (i - 1) + a / (a - b);
+            if (first < 0.0) {
+                first = at;
+            } else {
+                ++crossings;
+            }
+            last = at;
+        }
+    }
+    return crossings > 0 ? crossings * RATE / (last - first) : 0.0;
+}
+
+double peakOf(const std::vector<float>& samples, int64_t begin, int64_t end) {
+    double peak = 0.0;
+    for (int64_t i = begin; i < end; ++i) {
+        peak = std::max(peak, static_cast<double>(std::fabs(samples[i * CHANNELS])));
+    }
+    return peak;
+}
+
+double maxStep(const std::vector<float>& samples, int64_t begin, int64_t end) {
+    double step = 0.0;
+    for (int64_t i = begin + 1; i < end; ++i) {
+        step = std::max(step, static_cast<double>(std::fabs(samples[i * CHANNELS] - samples[(i - 1) * CHANNELS])));
+    }
+    return step;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// REAL FFT
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(realFftMatchesReference) {
+    for (int size : {RealFft::MIN_SIZE, 256, 2048, 4096}) {
+        std::vector<float> input(size);
+        std::vector<std::complex<double>> reference(size);
+        for (int i = 0; i < size; ++i) {
+            input[i] = noiseSample(i, 0) / 32768.0f;
+            reference[i] = input[i];
+        }
+        analysis::Fft(size).forward(reference.data());
+
+        RealFft fft(size);
+        std::vector<float> re(fft.bins()), im(fft.bins()), back(size);
+        fft.forward(input.data(), re.data(), im.data());
+        double scale = 0.0, error = 0.0;
+        for (int k = 0; k < fft.bins(); ++k) {
+            scale = std::max(scale, std::abs(reference[k]));
+            error = std::max(error, std::abs(std::complex<double>(re[k], im[k]) - reference[k]));
+        }
+        fft.inverse(re.data(), im.data(), back.data());
+        double roundTrip = 0.0;
+        for (int i = 0; i < size; ++i) {
+            roundTrip = std::max(roundTrip, static_cast<double>(std::fabs(back[i] - input[i])));
+        }
+        std::printf("    N=%d: spectrum error %.2e of peak %.1f, round trip %.2e\n", size, error, scale, roundTrip);
+        EXPECT_LE(error / scale, 1e-5);
+        EXPECT_LE(roundTrip, 1e-5);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// STRETCHER
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(unityPassesSignalThrough) {
+    std::vector<float> input = makeTone(RATE, 1000.0, 0.5);
+    for (StretchMode mode : {StretchMode::MUSIC, StretchMode::SPEECH}) {
+        TimeStretcher stretcher;
+        stretcher.configure(RATE, CHANNELS);
+        stretcher.setMode(mode);
+        stretcher.reset();
+        std::vector<float> output = stretch(stretcher, input, RATE / 2);
+        ASSERT_TRUE(output.size() == static_cast<size_t>(RATE / 2 * CHANNELS));
+        double error = 0.0;
+        for (size_t i = 0; i < output.size(); ++i) {
+            error = std::max(error, static_cast<double>(std::fabs(output[i] - input[i])));
+        }
+        std::printf("    %s: max error %.2e\n", mode == StretchMode::MUSIC ? "music" : "speech", error);
+        EXPECT_LE(error, 1e-4);
+        // WSOLA may take a frame whole periods off its nominal position: same audio, within the search
+        double slack = mode == StretchMode::MUSIC ? 1e-6 : stretcher.hopFrames() / 2.0;
+        EXPECT_NEAR(stretcher.inputPosition(), RATE / 2.0, slack);
+    }
+}
+
+FTL_TEST(tempoKeepsFrequency) {
+    std::vector<float> input = makeTone(RATE * 4, 1000.0, 0.5);
+    for (StretchMode mode : {StretchMode::MUSIC, StretchMode::SPEECH}) {
+        for (double tempo : {TimeStretcher::MIN_TEMPO, TimeStretcher::MAX_TEMPO}) {
+            TimeStretcher stretcher;
+            stretcher.configure(RATE, CHANNELS);
+            stretcher.setMode(mode);
+            stretcher.setTempo(tempo);
+            stretcher.reset();
+            std::vector<float> output = stretch(stretcher, input, RATE * 2);
+            ASSERT_TRUE(output.size() == static_cast<size_t>(RATE * 2 * CHANNELS));
+
+            double rate = stretcher.inputPosition() / (RATE * 2);
+            double frequency = measureFrequency(output, RATE / 4, RATE * 2);
+            double peak = peakOf(output, RATE / 4, RATE * 2);
+            std::printf("    %s tempo %.1f: rate %.4f, %.2f Hz, peak %.3f\n",
+                        mode == StretchMode::MUSIC ? "music" : "speech", tempo, rate, frequency, peak);
+            EXPECT_NEAR(rate, tempo, tempo * 0.005);
+            EXPECT_NEAR(frequency, 1000.0, 2.0);
+            EXPECT_NEAR(peak, 0.5, 0.05);
+        }
+    }
+}
+
+FTL_TEST(pitchShiftKeepsDuration) {
+    std::vector<float> input = makeTone(RATE * 4, 1000.0, 0.5);
+    const double ratio = std::pow(2.0, 7.0 / 12.0);
+    for (StretchMode mode : {StretchMode::MUSIC, StretchMode::SPEECH}) {
+        TimeStretcher stretcher;
+        stretcher.configure(RATE, CHANNELS);
+        stretcher.setMode(mode);
+        stretcher.setPitchSemitones(7.0);
+        stretcher.reset();
+        std::vector<float> output = stretch(stretcher, input, RATE * 2);
+        ASSERT_TRUE(output.size() == static_cast<size_t>(RATE * 2 * CHANNELS));
+
+        double rate = stretcher.inputPosition() / (RATE * 2);
+        double frequency = measureFrequency(output, RATE / 4, RATE * 2);
+        std::printf("    %s +7 st: rate %.4f, %.2f Hz (expected %.2f)\n",
+                    mode == StretchMode::MUSIC ? "music" : "speech", rate, frequency, 1000.0 * ratio);
+        EXPECT_NEAR(rate, 1.0, 0.005);
+        EXPECT_NEAR(frequency / 1000.0, ratio, 0.002);
+    }
+}
+
+FTL_TEST(transientPreservationKeepsClicksSharp) {
+    // Clicks every 0.25 s over a quiet tone, stretched to 0.7x
+    constexpr int64_t SPACING = RATE / 4;
+    std::vector<float> input = makeTone(RATE * 4, 220.0, 0.05);
+    for (int64_t click = SPACING / 2; click < RATE * 4; click += SPACING) {
+        input[click * CHANNELS] += 0.9f;
+        input[click * CHANNELS + 1] += 0.9f;
+    }
+
+    double peaks[2] = {};
+    for (int preserve = 0; preserve < 2; ++preserve) {
+        TimeStretcher stretcher;
+        stretcher.configure(RATE, CHANNELS);
+        stretcher.setTempo(0.7);
+        stretcher.setTransientPreservation(preserve != 0);
+        stretcher.reset();
+        std::vector<float> output = stretch(stretcher, input, RATE * 4);
+        // Mean peak over each click's slot in the output
+        const int64_t slot = static_cast<int64_t>(SPACING / 0.7);
+        int count = 0;
+        for (int64_t begin = slot / 4; begin + slot <= static_cast<int64_t>(output.size()) / CHANNELS;
+             begin += slot) {
+            peaks[preserve] += peakOf(output, begin, begin + slot);
+            ++count;
+        }
+        peaks[preserve] /= std::max(count, 1);
+        std::printf("    preservation %s: mean click peak %.3f, %llu onsets\n", preserve ? "on " : "off",
+                    peaks[preserve], static_cast<unsigned long long>(stretcher.transientCount()));
+        if (preserve) EXPECT_TRUE(stretcher.transientCount() >= 10);
+    }
+    EXPECT_TRUE(peaks[1] > peaks[0] * 1.25);
+}
+
+FTL_TEST(speechModeStaysContinuous) {
+    // Voiced-like signal: 140 Hz with decaying harmonics
+    constexpr int64_t FRAMES = RATE * 3;
+    std::vector<float> input(FRAMES * CHANNELS);
+    for (int64_t i = 0; i < FRAMES; ++i) {
+        double value = 0.0;
+        for (int h = 1; h <= 6; ++h) {
+            value += 0.3 / h * std::sin(2.0 * M_PI * 140.0 * h * i / RATE);
+        }
+        input[i * CHANNELS] = input[i * CHANNELS + 1] = static_cast<float>(value);
+    }
+    double inputStep = maxStep(input, 0, FRAMES);
+
+    for (double tempo : {0.75, 1.25}) {
+        TimeStretcher stretcher;
+        stretcher.configure(RATE, CHANNELS);
+        stretcher.setMode(StretchMode::SPEECH);
+        stretcher.setTempo(tempo);
+        stretcher.reset();
+        EXPECT_TRUE(stretcher.mode() == StretchMode::SPEECH);
+        std::vector<float> output = stretch(stretcher, input, RATE * 2);
+        ASSERT_TRUE(output.size() == static_cast<size_t>(RATE * 2 * CHANNELS));
+
+        double step = maxStep(output, 0, RATE * 2);
+        double rate = stretcher.inputPosition() / (RATE * 2);
+        std::printf("    tempo %.2f: rate %.4f, max step %.4f (input %.4f)\n", tempo, rate, step, inputStep);
+        EXPECT_NEAR(rate, tempo, tempo * 0.005);
+        EXPECT_LE(step, inputStep * 1.2);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ENGINE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(settersNeedTheConfigFlag) {
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.offlineRender = true;
+
+    FTLAudioEngine plain;
+    ASSERT_TRUE(plain.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(plain.setTempo(1.1) != EngineResult::SUCCESS);
+    EXPECT_TRUE(plain.setPitchShift(2.0) != EngineResult::SUCCESS);
+    EXPECT_NEAR(plain.getTempo(), 1.0, 0.0);
+
+    config.enableTimeStretch = true;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setTempo(1.1) == EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setTempo(1.5) != EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setPitchShift(-13.0) != EngineResult::SUCCESS);
+    EXPECT_TRUE(engine.setPitchShift(-3.0) == EngineResult::SUCCESS);
+    EXPECT_NEAR(engine.getTempo(), 1.1, 0.0);
+    EXPECT_NEAR(engine.getPitchShift(), -3.0, 0.0);
+}
+
+FTL_TEST(offlineRenderFollowsTempo) {
+    constexpr int64_t FRAMES = RATE * 3;
+    std::string path = tempPath("stretch_tone.wav");
+    ASSERT_TRUE(writeWav16(path, makeSineSignal(FRAMES, CHANNELS, RATE, 1000.0, 0.5), CHANNELS, RATE));
+
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    config.offlineRender = true;
+    config.enableTimeStretch = true;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setTempo(1.25) == EngineResult::SUCCESS);
+
+    OfflineJob job;
+    job.sourcePath = path;
+    ASSERT_TRUE(renderOfflineJob(engine, job) == EngineResult::SUCCESS);
+    double frequency = measureFrequency(job.samples, RATE / 4, job.stats.frames - RATE / 4);
+    std::printf("    %lld frames for %lld source frames at 1.25x, %.2f Hz\n",
+                static_cast<long long>(job.stats.frames), static_cast<long long>(FRAMES), frequency);
+    EXPECT_NEAR(static_cast<double>(job.stats.frames), FRAMES / 1.25, 240.0);
+    EXPECT_NEAR(frequency, 1000.0, 2.0);
+
+    // Pitch alone keeps the length
+    ASSERT_TRUE(engine.setTempo(1.0) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setPitchShift(-5.0) == EngineResult::SUCCESS);
+    ASSERT_TRUE(renderOfflineJob(engine, job) == EngineResult::SUCCESS);
+    frequency = measureFrequency(job.samples, RATE / 4, job.stats.frames - RATE / 4);
+    std::printf("    -5 st: %lld frames, %.2f Hz\n", static_cast<long long>(job.stats.frames), frequency);
+    EXPECT_NEAR(static_cast<double>(job.stats.frames), static_cast<double>(FRAMES), 240.0);
+    EXPECT_NEAR(frequency / 1000.0, std::pow(2.0, -5.0 / 12.0), 0.002);
+}
+
+FTL_TEST(playheadFollowsSourceClock) {
+    constexpr int64_t FRAMES = RATE * 20;
+    std::string path = tempPath("stretch_live.wav");
+    ASSERT_TRUE(writeWav16(path, makeSineSignal(FRAMES, CHANNELS, RATE, 440.0, 0.5), CHANNELS, RATE));
+
+    host::BackendSettings settings;
+    settings.realtimePacing = true;
+    host::setBackendSettings(settings);
+    AudioEngineConfig config;
+    config.sampleRate = RATE;
+    config.framesPerBurst = 240;
+    config.enableTimeStretch = true;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setTempo(1.3) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    // Source frames per output frame, from the engine's own clocks
+    int64_t playhead0 = engine.getPlayheadFrame(), output0 = engine.getOutputFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    int64_t playhead1 = engine.getPlayheadFrame(), output1 = engine.getOutputFrame();
+    double rate = static_cast<double>(playhead1 - playhead0) / static_cast<double>(output1 - output0);
+    std::printf("    playhead advanced %.3fx the output clock\n", rate);
+    EXPECT_NEAR(rate, 1.3, 0.03);
+
+    // Seeks land exactly and keep the tempo
+    constexpr int64_t TARGET = RATE * 10;
+    ASSERT_TRUE(engine.seekToFrame(TARGET) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    playhead0 = engine.getPlayheadFrame();
+    output0 = engine.getOutputFrame();
+    EXPECT_TRUE(playhead0 >= TARGET);
+    EXPECT_LE(playhead0, TARGET + RATE / 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    playhead1 = engine.getPlayheadFrame();
+    output1 = engine.getOutputFrame();
+    rate = static_cast<double>(playhead1 - playhead0) / static_cast<double>(output1 - output0);
+    std::printf("    after seek: playhead %lld, %.3fx\n", static_cast<long long>(playhead0), rate);
+    EXPECT_NEAR(rate, 1.3, 0.03);
+
+    engine.stopPlayback();
+    host::setBackendSettings(host::BackendSettings());
+}
@@ -0,0 +1,173 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - TRACE RECORDER TESTS          ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * A live engine on the paced host backend produces a Chrome trace with
+ * named audio and decode threads and balanced slices; wrapped rings and
+ * restarted captures stay well-formed; every scope records exactly one
+ * begin and one end. Event cost is a benchmark (ftl_audio_bench), not a
+ * test: it depends on load and build type.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+/** Event lines of one thread (the dump writes one event per line) */
+std::vector<std::string> eventsOfThread(const std::string& json, int tid) {
+    std::vector<std::string> lines;
+    std::string tidField = "\"tid\":" + std::to_string(tid);
+    size_t start = 0;
+    for (size_t end; (end = json.find('\n', start)) != std::string::npos; start = end + 1) {
+        std::string line = json.substr(start, end - start);
+        size_t at = line.find(tidField);
+        if (at != std::string::npos && line.find("\"ph\":\"M\"") == std::string::npos &&
+            (line[at + tidField.size()] == ',' || line[at + tidField.size()] == '}')) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+/** Depth never negative, and every begin closed by the end of the list */
+bool balanced(const std::vector<std::string>& events) {
+    int depth = 0;
+    for (const std::string& event : events) {
+        if (event.find("\"ph\":\"B\"") != std::string::npos) ++depth;
+        if (event.find("\"ph\":\"E\"") != std::string::npos && --depth < 0) return false;
+    }
+    return depth == 0;
+}
+
+int currentTid() {
+    return static_cast<int>(syscall(SYS_gettid));
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// CAPTURE
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(liveEngineTraceHasEveryThread) {
+    std::string path = tempPath("trace_source.flac");
+    ASSERT_TRUE(writeFlac16(path, makeIndexSignal(48000 * 5), 48000));
+
+    AudioEngineConfig config;
+    config.sampleRate = 48000;
+    config.framesPerBurst = 240;
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.setAudioSource(path) == EngineResult::SUCCESS);
+
+    ASSERT_TRUE(trace::start());
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    ASSERT_TRUE(engine.seekToFrame(48000 * 2) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    engine.stopPlayback();
+    trace::stop();
+
+    std::string json = trace::chromeTraceJson();
+    EXPECT_TRUE(json.compare(0, 17, "{\"displayTimeUnit") == 0);
+    EXPECT_TRUE(json.size() > 3 && json.compare(json.size() - 3, 3, "]}\n") == 0);
+    EXPECT_TRUE(countOf(json, "\"name\":\"audioCallback\"") > 40);
+    EXPECT_TRUE(countOf(json, "\"name\":\"renderSource\"") > 40);
+    EXPECT_TRUE(countOf(json, "\"name\":\"decodeChunk\"") > 0);
+    EXPECT_TRUE(countOf(json, "\"name\":\"flac.read\"") > 0);
+    EXPECT_TRUE(countOf(json, "\"name\":\"decodeSeek\"") > 0);
+    EXPECT_TRUE(countOf(json, "\"name\":\"decodeRingFrames\",\"cat\":\"ftl\",\"ph\":\"C\"") > 40);
+    EXPECT_TRUE(countOf(json, "\"args\":{\"name\":\"audio\"}") == 1);
+    EXPECT_TRUE(countOf(json, "\"args\":{\"name\":\"decode\"}") == 1);
+    EXPECT_EQ(countOf(json, "\"ph\":\"B\""), countOf(json, "\"ph\":\"E\""));
+
+    ASSERT_TRUE(trace::writeChromeTrace(tempPath("engine.json")));
+    FILE* file = std::fopen(tempPath("engine.json").c_str(), "rb");
+    ASSERT_TRUE(file != nullptr);
+    std::fseek(file, 0, SEEK_END);
+    EXPECT_EQ(static_cast<size_t>(std::ftell(file)), json.size());
+    std::fclose(file);
+}
+
+FTL_TEST(wrappedRingStaysBalanced) {
+    ASSERT_TRUE(trace::start());
+    int tid = 0;
+    std::thread worker([&tid] {
+        tid = currentTid();
+        trace::setThreadName("worker \"quoted\"");
+        for (size_t i = 0; i < trace::EVENTS_PER_THREAD * 3 + 1; ++i) {
+            FTL_TRACE_SCOPE("outer");
+            FTL_TRACE_SCOPE("inner");
+            FTL_TRACE_COUNTER("iteration", i);
+        }
+    });
+    worker.join();
+    trace::stop();
+
+    std::string json = trace::chromeTraceJson();
+    std::vector<std::string> events = eventsOfThread(json, tid);
+    // The oldest events were overwritten; the cut lands mid-slice and is repaired
+    EXPECT_LE(events.size(), trace::EVENTS_PER_THREAD);
+    EXPECT_TRUE(events.size() > trace::EVENTS_PER_THREAD - 8);
+    EXPECT_TRUE(balanced(events));
+    EXPECT_TRUE(countOf(json, "\"args\":{\"name\":\"worker \\\"quoted\\\"\"}") == 1);
+
+    // A new capture drops everything before it, even in the recycled ring
+    ASSERT_TRUE(trace::start());
+    std::thread([&tid] {
+        tid = currentTid();
+        FTL_TRACE_INSTANT("marker");
+    }).join();
+    trace::stop();
+    json = trace::chromeTraceJson();
+    EXPECT_EQ(countOf(json, "\"name\":\"outer\""), static_cast<size_t>(0));
+    EXPECT_EQ(countOf(json, "\"name\":\"marker\",\"cat\":\"ftl\",\"ph\":\"i\""), static_cast<size_t>(1));
+
+    // Idle probes record nothing
+    { FTL_TRACE_SCOPE("idle"); }
+    EXPECT_EQ(countOf(trace::chromeTraceJson(), "\"name\":\"idle\""), static_cast<size_t>(0));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// SCOPES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+// Cost is measured by ftl_audio_bench (trace.idleProbe, trace.recordedScope) against its baseline
+FTL_TEST(everyScopeRecordsBeginAndEnd) {
+    constexpr int SCOPES = 1000;
+    int tid = 0;
+    ASSERT_TRUE(trace::start());
+    std::thread([&tid] {
+        tid = currentTid();
+        for (int i = 0; i < SCOPES; ++i) {
+            FTL_TRACE_SCOPE("timed");
+        }
+    }).join();
+    trace::stop();
+
+    std::vector<std::string> events = eventsOfThread(trace::chromeTraceJson(), tid);
+    EXPECT_EQ(events.size(), static_cast<size_t>(2 * SCOPES));
+    EXPECT_TRUE(balanced(events));
+}
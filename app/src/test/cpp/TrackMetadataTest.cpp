@@ -0,0 +1,626 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - TRACK METADATA TESTS         ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Header-only parsing of every container the library scan meets: WAV and
+ * FLAC agree with the decoders, extensible WAV reports its valid bits,
+ * tags are found behind cover art, DSF, VBR/CBR MP3 and MP4 (AAC, ALAC)
+ * report exact lengths, and only header bytes are read. A batch keeps
+ * input order across its workers.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "AudioSource.h"
+#include "TrackMetadata.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+void le64(ByteWriter& out, uint64_t value) {
+    out.le32(static_cast<uint32_t>(value));
+    out.le32(static_cast<uint32_t>(value >> 32));
+}
+
+void syncsafe(ByteWriter& out, uint32_t value) {
+    for (int shift = 21; shift >= 0; shift -= 7) out.u8((value >> shift) & 0x7F);
+}
+
+bool save(const std::string& path, ByteWriter& out) { return out.save(path); }
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// ID3 / MPEG FIXTURES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+Bytes latin1Frame(const char* text) {
+    ByteWriter out;
+    out.u8(0);
+    out.text(text);
+    return out.bytes();
+}
+
+/** UTF-16 with a little-endian BOM, NUL-terminated */
+Bytes utf16Frame(const std::u16string& text) {
+    ByteWriter out;
+    out.u8(1);
+    out.le16(0xFEFF);
+    for (char16_t unit : text) out.le16(unit);
+    out.le16(0);
+    return out.bytes();
+}
+
+Bytes utf8Frame(const char* text) {
+    ByteWriter out;
+    out.u8(3);
+    out.text(text);
+    return out.bytes();
+}
+
+Bytes id3v2(int version, const std::vector<std::pair<std::string, Bytes>>& frames) {
+    ByteWriter body;
+    for (const auto& frame : frames) {
+        body.text(frame.first.c_str());
+        uint32_t size = static_cast<uint32_t>(frame.second.size());
+        if (version == 2) body.be(size, 3);
+        else if (version == 3) body.be(size, 4);
+        else syncsafe(body, size);
+        if (version > 2) body.le16(0);
+        body.append(frame.second);
+    }
+    for (int i = 0; i < 32; ++i) body.u8(0);   // Padding
+    ByteWriter out;
+    out.text("ID3");
+    out.u8(version);
+    out.u8(0);
+    out.u8(0);
+    syncsafe(out, static_cast<uint32_t>(body.size()));
+    out.append(body.bytes());
+    return out.bytes();
+}
+
+// MPEG-1 layer III, 128 kbps, 44.1 kHz, joint stereo: 417-byte frames of 1152 samples
+constexpr int MP3_RATE = 44100;
+constexpr int MP3_FRAME_BYTES = 417;
+constexpr int MP3_FRAME_SAMPLES = 1152;
+
+void mp3Frame(ByteWriter& out) {
+    out.u8(0xFF);
+    out.u8(0xFB);
+    out.u8(0x90);
+    out.u8(0x40);
+    for (int i = 4; i < MP3_FRAME_BYTES; ++i) out.u8(0);
+}
+
+/** Info frame: Xing header with frame and byte counts, then a LAME tag */
+void xingFrame(ByteWriter& out, uint32_t frames, uint32_t bytes, int delay, int padding) {
+    ByteWriter frame;
+    frame.u8(0xFF);
+    frame.u8(0xFB);
+    frame.u8(0x90);
+    frame.u8(0x40);
+    for (int i = 0; i < 32; ++i) frame.u8(0);   // Side info
+    frame.text("Xing");
+    frame.be(0x3, 4);
+    frame.be(frames, 4);
+    frame.be(bytes, 4);
+    frame.text("LAME3.100");
+    for (int i = 9; i < 21; ++i) frame.u8(0);
+    frame.be((static_cast<uint32_t>(delay) << 12) | static_cast<uint32_t>(padding), 3);
+    while (frame.size() < MP3_FRAME_BYTES) frame.u8(0);
+    out.append(frame.bytes());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// MP4 FIXTURES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+Bytes box(const char* type, const Bytes& body) {
+    ByteWriter out;
+    out.be(8 + body.size(), 4);
+    out.text(type);
+    out.append(body);
+    return out.bytes();
+}
+
+Bytes concat(std::initializer_list<Bytes> parts) {
+    Bytes out;
+    for (const Bytes& part : parts) out.insert(out.end(), part.begin(), part.end());
+    return out;
+}
+
+Bytes fullBox(const char* type, const Bytes& body) {
+    return box(type, concat({Bytes(4, 0), body}));
+}
+
+Bytes mdhd(uint32_t timescale, uint32_t duration) {
+    ByteWriter out;
+    out.be(0, 8);
+    out.be(timescale, 4);
+    out.be(duration, 4);
+    out.be(0, 4);
+    return fullBox("mdhd", out.bytes());
+}
+
+Bytes hdlr(const char* handler) {
+    ByteWriter out;
+    out.be(0, 4);
+    out.text(handler);
+    out.be(0, 12);
+    out.u8(0);
+    return fullBox("hdlr", out.bytes());
+}
+
+Bytes sampleEntry(const char* type, int channels, int sampleSize, uint32_t rate, const Bytes& children) {
+    ByteWriter out;
+    out.be(0, 6);
+    out.be(1, 2);
+    out.be(0, 8);
+    out.be(channels, 2);
+    out.be(sampleSize, 2);
+    out.be(0, 4);
+    out.be(static_cast<uint64_t>(rate) << 16, 4);
+    out.append(children);
+    ByteWriter stsd;
+    stsd.be(1, 4);
+    stsd.append(box(type, out.bytes()));
+    return fullBox("stsd", stsd.bytes());
+}
+
+Bytes esds(uint32_t avgBitRate) {
+    ByteWriter out;
+    out.u8(0x03);
+    out.u8(25);
+    out.be(1, 2);
+    out.u8(0);
+    out.u8(0x04);
+    out.u8(17);
+    out.u8(0x40);                // MPEG-4 audio
+    out.u8(0x15);
+    out.be(0, 3);
+    out.be(avgBitRate + 64000, 4);
+    out.be(avgBitRate, 4);
+    out.u8(0x05);
+    out.u8(2);
+    out.u8(0x12);                // AAC LC, 44.1 kHz,
+    out.u8(0x10);                // stereo
+    out.u8(0x06);
+    out.u8(1);
+    out.u8(0x02);
+    return fullBox("esds", out.bytes());
+}
+
+Bytes alacCookie(int bits, int channels, uint32_t rate) {
+    ByteWriter out;
+    out.be(4096, 4);
+    out.u8(0);
+    out.u8(bits);
+    out.u8(40);
+    out.u8(10);
+    out.u8(14);
+    out.u8(channels);
+    out.be(255, 2);
+    out.be(0, 4);
+    out.be(0, 4);
+    out.be(rate, 4);
+    return fullBox("alac", out.bytes());
+}
+
+Bytes ilstItem(const char* type, uint32_t dataType, const Bytes& value) {
+    ByteWriter data;
+    data.be(dataType, 4);
+    data.be(0, 4);
+    data.append(value);
+    return box(type, box("data", data.bytes()));
+}
+
+Bytes text(const char* value) {
+    ByteWriter out;
+    out.text(value);
+    return out.bytes();
+}
+
+Bytes trak(const char* handler, uint32_t timescale, uint32_t duration, const Bytes& stsd) {
+    return box("trak", box("mdia", concat({mdhd(timescale, duration), hdlr(handler),
+                                           box("minf", box("stbl", stsd))})));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// FLAC / WAV / DSF FIXTURES
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+Bytes streamInfo(int rate, int channels, int bits, uint64_t totalSamples) {
+    BitWriter bits34;
+    bits34.bits(4096, 16);
+    bits34.bits(4096, 16);
+    bits34.bits(0, 24);
+    bits34.bits(0, 24);
+    bits34.bits(static_cast<uint64_t>(rate), 20);
+    bits34.bits(static_cast<uint64_t>(channels - 1), 3);
+    bits34.bits(static_cast<uint64_t>(bits - 1), 5);
+    bits34.bits(totalSamples, 36);
+    for (int i = 0; i < 16; ++i) bits34.bits(0, 8);
+    return bits34.bytes();
+}
+
+void flacBlock(ByteWriter& out, int type, bool last, const Bytes& body) {
+    out.u8((last ? 0x80 : 0) | type);
+    out.be(body.size(), 3);
+    out.append(body);
+}
+
+Bytes vorbisComment(const std::vector<std::string>& entries) {
+    ByteWriter out;
+    out.le32(5);
+    out.text("tests");
+    out.le32(static_cast<uint32_t>(entries.size()));
+    for (const std::string& entry : entries) {
+        out.le32(static_cast<uint32_t>(entry.size()));
+        out.text(entry.c_str());
+    }
+    return out.bytes();
+}
+
+std::string mp3Path() {
+    std::string path = tempPath("metadata_vbr.mp3");
+    ByteWriter out;
+    out.append(id3v2(3, {
+        {"TIT2", utf16Frame(u"Café \U0001F3B5")},
+        {"APIC", Bytes(100 * 1024, 0x55)},       // Cover art, skipped
+        {"TPE1", latin1Frame("Ma\xefve")},
+        {"TALB", latin1Frame("Frames")},
+        {"TYER", latin1Frame("1999")},
+        {"TRCK", latin1Frame("4/10")},
+    }));
+    xingFrame(out, 1000, 1000 * MP3_FRAME_BYTES, 576, 1000);
+    for (int i = 0; i < 1000; ++i) mp3Frame(out);
+    save(path, out);
+    return path;
+}
+
+std::string flacPath() {
+    std::string path = tempPath("metadata_tags.flac");
+    ByteWriter out;
+    out.text("fLaC");
+    flacBlock(out, 0, false, streamInfo(88200, 2, 24, 12345678));
+    flacBlock(out, 6, false, Bytes(200 * 1024, 0xAA));   // PICTURE
+    flacBlock(out, 4, true, vorbisComment({"title=Behind The Art", "ARTIST=Vorbis", "Album=Blocks",
+                                           "DATE=2021-03-04", "TRACKNUMBER=7/12"}));
+    for (int i = 0; i < 4096; ++i) out.u8(0);
+    save(path, out);
+    return path;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════════════
+
+FTL_TEST(wavAndFlacAgreeWithDecoders) {
+    std::string wav = tempPath("metadata_plain.wav");
+    std::string flac = tempPath("metadata_plain.flac");
+    std::vector<int16_t> signal = makeSineSignal(48000 * 3 + 17, 2, 48000, 440.0, 0.5);
+    ASSERT_TRUE(writeWav16(wav, signal, 2, 48000));
+    ASSERT_TRUE(writeFlac16(flac, signal, 48000));
+
+    for (const std::string& path : {wav, flac}) {
+        TrackMetadata metadata;
+        ASSERT_TRUE(readTrackMetadata(path, metadata));
+        auto source = openAudioSource(path);
+        ASSERT_TRUE(source != nullptr);
+        EXPECT_TRUE(metadata.codec == source->info().codec);
+        EXPECT_EQ(metadata.sampleRate, source->info().sampleRate);
+        EXPECT_EQ(metadata.channelCount, source->info().channelCount);
+        EXPECT_EQ(metadata.bitsPerSample, 16);
+        EXPECT_EQ(metadata.totalFrames, source->info().totalFrames);
+        EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(METADATA_READ_BYTES));
+    }
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(wav, metadata));
+    EXPECT_EQ(metadata.bitRate, 48000 * 2 * 16);
+}
+
+FTL_TEST(extensibleWavReportsValidBitsAndTrailingInfo) {
+    // 24 valid bits in 32-bit containers, 96 kHz, 5 s; INFO chunk after the audio
+    const int rate = 96000;
+    const uint32_t dataBytes = rate * 5 * 8;
+    ByteWriter info;
+    info.text("INFO");
+    for (auto tag : {std::make_pair("INAM", "Long Take"), std::make_pair("IART", "Riff"),
+                     std::make_pair("IPRD", "Chunks"), std::make_pair("ICRD", "2004"),
+                     std::make_pair("ITRK", "9")}) {
+        info.text(tag.first);
+        uint32_t size = static_cast<uint32_t>(std::strlen(tag.second)) + 1;
+        info.le32(size);
+        info.text(tag.second);
+        info.u8(0);
+        if (size & 1) info.u8(0);
+    }
+
+    ByteWriter out;
+    out.text("RIFF");
+    out.le32(static_cast<uint32_t>(4 + 8 + 40 + 8 + dataBytes + 8 + info.size()));
+    out.text("WAVE");
+    out.text("fmt ");
+    out.le32(40);
+    out.le16(0xFFFE);
+    out.le16(2);
+    out.le32(rate);
+    out.le32(rate * 8);
+    out.le16(8);
+    out.le16(32);
+    out.le16(22);
+    out.le16(24);
+    out.le32(3);
+    out.le16(1);                 // KSDATAFORMAT_SUBTYPE_PCM
+    for (int i = 0; i < 14; ++i) out.u8(0);
+    out.text("data");
+    out.le32(dataBytes);
+    out.bytes().resize(out.size() + dataBytes, 0);
+    out.text("LIST");
+    out.le32(static_cast<uint32_t>(info.size()));
+    out.append(info.bytes());
+    std::string path = tempPath("metadata_extensible.wav");
+    ASSERT_TRUE(save(path, out));
+
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(path, metadata));
+    EXPECT_TRUE(metadata.codec == "wav");
+    EXPECT_EQ(metadata.sampleRate, rate);
+    EXPECT_EQ(metadata.bitsPerSample, 24);
+    EXPECT_EQ(metadata.totalFrames, static_cast<int64_t>(rate) * 5);
+    EXPECT_NEAR(metadata.durationSeconds(), 5.0, 1e-9);
+    EXPECT_TRUE(metadata.title == "Long Take");
+    EXPECT_TRUE(metadata.artist == "Riff");
+    EXPECT_TRUE(metadata.album == "Chunks");
+    EXPECT_EQ(metadata.year, 2004);
+    EXPECT_EQ(metadata.trackNumber, 9);
+    // The head and the tail of a 3.8 MB file
+    EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(2 * METADATA_READ_BYTES));
+}
+
+FTL_TEST(flacTagsAreFoundBehindCoverArt) {
+    std::string path = flacPath();
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(path, metadata));
+    EXPECT_TRUE(metadata.codec == "flac");
+    EXPECT_EQ(metadata.sampleRate, 88200);
+    EXPECT_EQ(metadata.channelCount, 2);
+    EXPECT_EQ(metadata.bitsPerSample, 24);
+    EXPECT_EQ(metadata.totalFrames, 12345678);
+    EXPECT_TRUE(metadata.title == "Behind The Art");
+    EXPECT_TRUE(metadata.artist == "Vorbis");
+    EXPECT_TRUE(metadata.album == "Blocks");
+    EXPECT_EQ(metadata.year, 2021);
+    EXPECT_EQ(metadata.trackNumber, 7);
+    EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(2 * METADATA_READ_BYTES));
+
+    // An ID3v2 tag in front of the stream marker wins
+    ByteWriter prefixed;
+    prefixed.append(id3v2(4, {{"TIT2", utf8Frame("From ID3")}}));
+    FILE* file = std::fopen(path.c_str(), "rb");
+    ASSERT_TRUE(file != nullptr);
+    Bytes rest(300 * 1024);
+    rest.resize(std::fread(rest.data(), 1, rest.size(), file));
+    std::fclose(file);
+    prefixed.append(rest);
+    std::string tagged = tempPath("metadata_id3.flac");
+    ASSERT_TRUE(save(tagged, prefixed));
+    ASSERT_TRUE(readTrackMetadata(tagged, metadata));
+    EXPECT_TRUE(metadata.title == "From ID3");
+    EXPECT_TRUE(metadata.artist == "Vorbis");
+    EXPECT_EQ(metadata.totalFrames, 12345678);
+}
+
+FTL_TEST(mistaggedUtf8FieldsReadAsLatin1) {
+    // Vorbis comments and ID3 encoding 3 claim UTF-8; Latin-1 bytes there must not reach JNI as-is
+    std::string path = tempPath("metadata_latin1.flac");
+    ByteWriter out;
+    out.text("fLaC");
+    flacBlock(out, 0, false, streamInfo(44100, 2, 16, 44100));
+    flacBlock(out, 4, true, vorbisComment({"TITLE=Caf\xc3\xa9 \xf0\x9f\x8e\xb5", "ARTIST=Beyonc\xe9",
+                                           "ALBUM=Trunc\xe2\x82"}));
+    for (int i = 0; i < 4096; ++i) out.u8(0);
+    ASSERT_TRUE(save(path, out));
+
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(path, metadata));
+    EXPECT_TRUE(metadata.title == "Caf\xc3\xa9 \xf0\x9f\x8e\xb5");    // Well-formed: kept
+    EXPECT_TRUE(metadata.artist == "Beyonc\xc3\xa9");
+    EXPECT_TRUE(metadata.album == "Trunc\xc3\xa2\xc2\x82");            // Cut-off sequence
+
+    std::string mp3 = tempPath("metadata_latin1.mp3");
+    ByteWriter tagged;
+    tagged.append(id3v2(4, {{"TIT2", utf8Frame("Ma\xefve")}, {"TPE1", utf8Frame("\xed\xa0\x80")}}));
+    for (int i = 0; i < 100; ++i) mp3Frame(tagged);
+    ASSERT_TRUE(save(mp3, tagged));
+    ASSERT_TRUE(readTrackMetadata(mp3, metadata));
+    EXPECT_TRUE(metadata.title == "Ma\xc3\xafve");
+    EXPECT_TRUE(metadata.artist == "\xc3\xad\xc2\xa0\xc2\x80");      // Encoded surrogate
+}
+
+FTL_TEST(dsfReportsDsdRateAndTrailingTag) {
+    const uint32_t rate = 2822400;   // DSD64
+    const uint64_t samples = static_cast<uint64_t>(rate) * 3;
+    const uint64_t dataBytes = samples / 8 * 2;
+    Bytes tag = id3v2(4, {{"TIT2", utf8Frame("One Bit")}, {"TPE1", utf8Frame("Sigma-Delta")}});
+
+    ByteWriter out;
+    out.text("DSD ");
+    le64(out, 28);
+    le64(out, 28 + 52 + 12 + dataBytes + tag.size());
+    le64(out, 28 + 52 + 12 + dataBytes);
+    out.text("fmt ");
+    le64(out, 52);
+    out.le32(1);
+    out.le32(0);
+    out.le32(2);
+    out.le32(2);
+    out.le32(rate);
+    out.le32(1);
+    le64(out, samples);
+    out.le32(4096);
+    out.le32(0);
+    out.text("data");
+    le64(out, 12 + dataBytes);
+    out.bytes().resize(out.size() + dataBytes, 0x69);
+    out.append(tag);
+    std::string path = tempPath("metadata.dsf");
+    ASSERT_TRUE(save(path, out));
+
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(path, metadata));
+    EXPECT_TRUE(metadata.codec == "dsf");
+    EXPECT_EQ(metadata.sampleRate, static_cast<int>(rate));
+    EXPECT_EQ(metadata.channelCount, 2);
+    EXPECT_EQ(metadata.bitsPerSample, 1);
+    EXPECT_EQ(metadata.totalFrames, static_cast<int64_t>(samples));
+    EXPECT_NEAR(metadata.durationSeconds(), 3.0, 1e-9);
+    EXPECT_TRUE(metadata.title == "One Bit");
+    EXPECT_TRUE(metadata.artist == "Sigma-Delta");
+    EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(2 * METADATA_READ_BYTES));
+}
+
+FTL_TEST(vbrMp3UsesXingFramesAndGaplessTrim) {
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(mp3Path(), metadata));
+    EXPECT_TRUE(metadata.codec == "mp3");
+    EXPECT_EQ(metadata.sampleRate, MP3_RATE);
+    EXPECT_EQ(metadata.channelCount, 2);
+    EXPECT_EQ(metadata.bitsPerSample, 0);
+    EXPECT_EQ(metadata.totalFrames, 1000 * MP3_FRAME_SAMPLES - 576 - 1000);
+    EXPECT_NEAR(metadata.bitRate, 1000.0 * MP3_FRAME_BYTES * 8 * MP3_RATE / (1000 * MP3_FRAME_SAMPLES), 1.0);
+    EXPECT_TRUE(metadata.title == "Caf\xc3\xa9 \xf0\x9f\x8e\xb5");
+    EXPECT_TRUE(metadata.artist == "Ma\xc3\xafve");
+    EXPECT_TRUE(metadata.album == "Frames");
+    EXPECT_EQ(metadata.year, 1999);
+    EXPECT_EQ(metadata.trackNumber, 4);
+    // Cover art skipped: one read for the head, one after the 100 KB frame
+    EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(2 * METADATA_READ_BYTES));
+}
+
+FTL_TEST(cbrMp3FallsBackToId3v1AndFileLength) {
+    const int frames = 300;
+    ByteWriter out;
+    out.bytes().resize(100, 0);  // Junk before the first frame
+    for (int i = 0; i < frames; ++i) mp3Frame(out);
+    out.text("TAG");
+    const char* fields[] = {"Old School", "Tagger", "V1"};
+    for (const char* field : fields) {
+        size_t start = out.size();
+        out.text(field);
+        out.bytes().resize(start + 30, 0);
+    }
+    out.text("1987");
+    out.bytes().resize(out.size() + 28, 0);
+    out.u8(0);
+    out.u8(12);
+    out.u8(0);
+    std::string path = tempPath("metadata_cbr.mp3");
+    ASSERT_TRUE(save(path, out));
+
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(path, metadata));
+    EXPECT_TRUE(metadata.codec == "mp3");
+    EXPECT_EQ(metadata.bitRate, 128000);
+    EXPECT_EQ(metadata.totalFrames, static_cast<int64_t>(frames) * MP3_FRAME_BYTES * 8 * MP3_RATE / 128000);
+    // Real streams pad one frame in 25 to 417.96 bytes; these frames never pad
+    EXPECT_NEAR(metadata.durationSeconds(), static_cast<double>(frames) * MP3_FRAME_SAMPLES / MP3_RATE, 0.03);
+    EXPECT_TRUE(metadata.title == "Old School");
+    EXPECT_TRUE(metadata.artist == "Tagger");
+    EXPECT_TRUE(metadata.album == "V1");
+    EXPECT_EQ(metadata.year, 1987);
+    EXPECT_EQ(metadata.trackNumber, 12);
+}
+
+FTL_TEST(mp4ReadsAudioTrackAndIlst) {
+    // Video track first, audio metadata after a 256 KB mdat
+    Bytes ilst = box("ilst", concat({ilstItem("\xA9nam", 1, text("Atoms")),
+                                     ilstItem("\xA9" "ART", 1, text("Boxes")),
+                                     ilstItem("\xA9" "day", 1, text("2016-01-01T00:00:00Z")),
+                                     ilstItem("trkn", 0, {0, 0, 0, 3, 0, 9, 0, 0})}));
+    Bytes meta = fullBox("meta", concat({hdlr("mdir"), ilst}));
+    Bytes moov = box("moov", concat({
+        trak("vide", 600, 6000, sampleEntry("avc1", 0, 0, 0, {})),
+        trak("soun", MP3_RATE, MP3_RATE * 10, sampleEntry("mp4a", 2, 16, MP3_RATE, esds(256000))),
+        box("udta", meta),
+    }));
+    ByteWriter aac;
+    aac.append(box("ftyp", concat({text("M4A "), Bytes(4, 0)})));
+    aac.append(box("mdat", Bytes(256 * 1024, 0x21)));
+    aac.append(moov);
+    std::string aacPath = tempPath("metadata_aac.m4a");
+    ASSERT_TRUE(save(aacPath, aac));
+
+    TrackMetadata metadata;
+    ASSERT_TRUE(readTrackMetadata(aacPath, metadata));
+    EXPECT_TRUE(metadata.codec == "aac");
+    EXPECT_EQ(metadata.sampleRate, MP3_RATE);
+    EXPECT_EQ(metadata.channelCount, 2);
+    EXPECT_EQ(metadata.bitsPerSample, 0);
+    EXPECT_EQ(metadata.totalFrames, static_cast<int64_t>(MP3_RATE) * 10);
+    EXPECT_EQ(metadata.bitRate, 256000);
+    EXPECT_TRUE(metadata.title == "Atoms");
+    EXPECT_TRUE(metadata.artist == "Boxes");
+    EXPECT_EQ(metadata.year, 2016);
+    EXPECT_EQ(metadata.trackNumber, 3);
+    EXPECT_LE(metadata.bytesRead, static_cast<uint64_t>(2 * METADATA_READ_BYTES));
+
+    // ALAC: the sample entry's 16.16 rate cannot hold 192 kHz, the cookie can
+    ByteWriter alac;
+    alac.append(box("ftyp", concat({text("M4A "), Bytes(4, 0)})));
+    alac.append(box("moov", trak("soun", 192000, 192000 * 4,
+                                 sampleEntry("alac", 2, 24, 0, alacCookie(24, 2, 192000)))));
+    alac.append(box("mdat", Bytes(64 * 1024, 0x42)));
+    std::string alacPath = tempPath("metadata_alac.m4a");
+    ASSERT_TRUE(save(alacPath, alac));
+    ASSERT_TRUE(readTrackMetadata(alacPath, metadata));
+    EXPECT_TRUE(metadata.codec == "alac");
+    EXPECT_EQ(metadata.sampleRate, 192000);
+    EXPECT_EQ(metadata.bitsPerSample, 24);
+    EXPECT_EQ(metadata.totalFrames, 192000 * 4);
+    EXPECT_TRUE(metadata.title.empty());
+}
+
+FTL_TEST(batchKeepsOrderAndCountsFailures) {
+    std::string notAudio = tempPath("metadata_notes.txt");
+    ByteWriter notes;
+    notes.text("just some text, no audio here");
+    ASSERT_TRUE(save(notAudio, notes));
+    const std::vector<std::string> kinds = {mp3Path(), flacPath(), tempPath("metadata_missing.flac"), notAudio};
+
+    std::vector<std::string> library;
+    for (int i = 0; i < 200; ++i) library.push_back(kinds[i % kinds.size()]);
+    MetadataBatchStats stats;
+    std::vector<TrackMetadata> results = readTrackMetadataBatch(library, 4, &stats);
+    ASSERT_TRUE(results.size() == library.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_TRUE(results[i].path == library[i]);
+        EXPECT_EQ(results[i].parsed, i % kinds.size() < 2);
+    }
+    EXPECT_TRUE(results[0].codec == "mp3" && results[1].codec == "flac");
+    EXPECT_EQ(stats.parsed, 100);
+    EXPECT_EQ(stats.failed, 100);
+    EXPECT_TRUE(stats.filesPerSecond() > 0.0);
+    std::printf("    %.0f files/s, %.1f KB read per file\n", stats.filesPerSecond(),
+                stats.bytesRead / 1024.0 / library.size());
+
+    std::atomic<bool> cancel{true};
+    MetadataBatchStats cancelled;
+    results = readTrackMetadataBatch(library, 2, &cancelled, &cancel);
+    EXPECT_EQ(cancelled.parsed + cancelled.failed, 0);
+    EXPECT_TRUE(results.size() == library.size() && !results[0].parsed);
+}
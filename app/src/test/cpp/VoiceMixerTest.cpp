@@ -0,0 +1,305 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║             FTL AUDIO ENGINE - VOICE MIXER TESTS            ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Drives the mixer the way the callback does - fixed bursts into a
+ * zeroed buffer - with its real feeder thread decoding WAV files. Checks
+ * bit-exact passthrough, resampling, fades and slot reuse under
+ * concurrent add/remove, and prints the per-burst mixing cost for 1-16
+ * voices.
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "FTLAudioEngine.h"
+#include "HostAudioBackend.h"
+#include "VoiceMixer.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int OUTPUT_RATE = 48000;
+constexpr int CHANNELS = 2;
+constexpr int32_t BURST = 256;
+constexpr int32_t RING_FRAMES = 16384;
+
+/** Wait until every voice has a burst decoded (or has ended) */
+void waitForVoices(VoiceMixer& mixer, const std::vector<int32_t>& voices, int32_t frames) {
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+    for (int32_t id : voices) {
+        while (mixer.isActive(id) && mixer.bufferedFrames(id) < frames && Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool waitForIdle(VoiceMixer& mixer) {
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+    while (mixer.activeVoiceCount() > 0 && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return mixer.activeVoiceCount() == 0;
+}
+
+/** Render bursts until the voice ends; returns everything it produced */
+std::vector<float> renderVoice(VoiceMixer& mixer, int32_t voice) {
+    std::vector<float> output;
+    std::vector<float> burst(static_cast<size_t>(BURST) * CHANNELS);
+    while (mixer.isActive(voice)) {
+        waitForVoices(mixer, {voice}, BURST);
+        std::fill(burst.begin(), burst.end(), 0.0f);
+        int32_t buffered = std::min(mixer.bufferedFrames(voice), BURST);
+        mixer.render(burst.data(), BURST);
+        output.insert(output.end(), burst.begin(), burst.begin() + buffered * CHANNELS);
+    }
+    return output;
+}
+
+} // namespace
+
+FTL_TEST(passthroughVoiceIsBitExact) {
+    std::string path = tempPath("voice_index.wav");
+    ASSERT_TRUE(writeWav16(path, makeIndexSignal(20000), 2, OUTPUT_RATE));
+
+    VoiceMixer mixer;
+    mixer.configure(OUTPUT_RATE, CHANNELS, RING_FRAMES);
+    int32_t voice = mixer.play(openAudioSource(path), 1.0f, 0);
+    ASSERT_TRUE(voice != VoiceMixer::INVALID_VOICE);
+
+    std::vector<float> output = renderVoice(mixer, voice);
+    EXPECT_EQ(output.size(), static_cast<size_t>(20000 * CHANNELS));
+    int64_t mismatches = 0;
+    for (size_t frame = 1; frame < output.size() / CHANNELS; ++frame) {
+        mismatches += decodeIndex(&output[frame * CHANNELS]) != static_cast<int64_t>(frame) ? 1 : 0;
+    }
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_TRUE(waitForIdle(mixer));
+}
+
+FTL_TEST(resampledVoiceKeepsPitchAndDuration) {
+    constexpr int SOURCE_RATE = 44100;
+    constexpr double FREQUENCY = 1000.0;
+    constexpr double AMPLITUDE = 0.5;
+    std::string path = tempPath("voice_sine.wav");
+    ASSERT_TRUE(writeWav16(path, makeSineSignal(SOURCE_RATE, 1, SOURCE_RATE, FREQUENCY, AMPLITUDE), 1, SOURCE_RATE));
+
+    VoiceMixer mixer;
+    mixer.configure(OUTPUT_RATE, CHANNELS, RING_FRAMES);
+    int32_t voice = mixer.play(openAudioSource(path), 1.0f, 0);
+    ASSERT_TRUE(voice != VoiceMixer::INVALID_VOICE);
+
+    // One second in, one second out; mono is spread to both channels
+    std::vector<float> output = renderVoice(mixer, voice);
+    size_t frames = output.size() / CHANNELS;
+    EXPECT_NEAR(static_cast<double>(frames), OUTPUT_RATE, 4.0);
+
+    double maxError = 0.0;
+    bool channelsMatch = true;
+    for (size_t i = 16; i + 16 < frames; ++i) {
+        double ideal = AMPLITUDE * std::sin(2.0 * M_PI * FREQUENCY * i / OUTPUT_RATE);
+        maxError = std::max(maxError, std::fabs(output[i * CHANNELS] - ideal));
+        channelsMatch = channelsMatch && output[i * CHANNELS] == output[i * CHANNELS + 1];
+    }
+    std::printf("  44.1k -> 48k, 1 kHz: max error %.2e (%.1f dB below signal)\n",
+                maxError, 20.0 * std::log10(maxError / AMPLITUDE));
+    EXPECT_TRUE(channelsMatch);
+    EXPECT_LE(maxError, AMPLITUDE * 1e-3);
+}
+
+FTL_TEST(fadeOutIsSmoothAndFreesSlot) {
+    std::string path = tempPath("voice_dc.wav");
+    ASSERT_TRUE(writeWav16(path, std::vector<int16_t>(OUTPUT_RATE * 5 * 2, 16384), 2, OUTPUT_RATE));
+
+    VoiceMixer mixer;
+    mixer.configure(OUTPUT_RATE, CHANNELS, RING_FRAMES);
+    int32_t voice = mixer.play(openAudioSource(path), 1.0f, BURST);
+    ASSERT_TRUE(voice != VoiceMixer::INVALID_VOICE);
+
+    // Fade in, steady, fade out - sampled on the left channel
+    std::vector<float> burst(static_cast<size_t>(BURST) * CHANNELS);
+    std::vector<float> envelope;
+    for (int i = 0; i < 12 && mixer.isActive(voice); ++i) {
+        if (i == 4) {
+            EXPECT_TRUE(mixer.stop(voice, BURST * 3));
+            EXPECT_TRUE(!mixer.setGain(voice, 1.0f, 0));   // Stopping voices ignore gain changes
+        }
+        waitForVoices(mixer, {voice}, BURST);
+        std::fill(burst.begin(), burst.end(), 0.0f);
+        mixer.render(burst.data(), BURST);
+        for (int32_t f = 0; f < BURST; ++f) envelope.push_back(burst[f * CHANNELS]);
+    }
+
+    EXPECT_NEAR(envelope[0], 0.0, 1e-6);
+    EXPECT_NEAR(envelope[BURST * 2], 0.5, 1e-6);
+    float largestStep = 0.0f;
+    for (size_t i = 1; i < envelope.size(); ++i) {
+        largestStep = std::max(largestStep, std::fabs(envelope[i] - envelope[i - 1]));
+    }
+    EXPECT_LE(largestStep, 0.5f / BURST + 1e-5f);          // Linear ramps, no clicks
+    EXPECT_EQ(envelope.size(), static_cast<size_t>(BURST * 7));  // Finished right after the fade
+    EXPECT_NEAR(envelope.back(), 0.0, 0.5 / (BURST * 3) + 1e-6);
+    EXPECT_TRUE(waitForIdle(mixer));
+
+    // Slot is reused under a new id; the old one no longer addresses it
+    int32_t next = mixer.play(openAudioSource(path), 1.0f, 0);
+    EXPECT_TRUE(next != voice);
+    EXPECT_TRUE(!mixer.stop(voice, 0));
+    EXPECT_TRUE(mixer.isActive(next));
+}
+
+FTL_TEST(voicesComeAndGoWhileRendering) {
+    std::string path = tempPath("voice_short.wav");
+    ASSERT_TRUE(writeWav16(path, makeNoiseSignal(2000), 2, 32000));
+
+    VoiceMixer mixer;
+    mixer.configure(OUTPUT_RATE, CHANNELS, RING_FRAMES);
+
+    std::atomic<bool> running{true};
+    std::atomic<int64_t> bursts{0};
+    std::atomic<bool> outputSane{true};
+    std::thread callback([&] {
+        std::vector<float> burst(static_cast<size_t>(BURST) * CHANNELS);
+        while (running.load()) {
+            std::fill(burst.begin(), burst.end(), 0.0f);
+            mixer.render(burst.data(), BURST);
+            for (float sample : burst) {
+                if (!std::isfinite(sample) || std::fabs(sample) > MAX_MIXER_VOICES) outputSane = false;
+            }
+            bursts.fetch_add(1);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    // Random plays and stops; voices also end on their own after ~45 ms
+    int started = 0;
+    int refused = 0;
+    bool idsDistinct = true;
+    std::vector<int32_t> live;
+    uint64_t state = 99;
+    for (int i = 0; i < 3000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        if ((state >> 40) % 3 != 0 || live.empty()) {
+            int32_t id = mixer.play(openAudioSource(path), 0.25f, (state >> 20) % 64);
+            if (id == VoiceMixer::INVALID_VOICE) {
+                ++refused;
+            } else {
+                ++started;
+                idsDistinct = idsDistinct && std::find(live.begin(), live.end(), id) == live.end();
+                live.push_back(id);
+            }
+        } else {
+            size_t pick = (state >> 8) % live.size();
+            mixer.stop(live[pick], (state >> 16) % 128);
+            live.erase(live.begin() + pick);
+        }
+        live.erase(std::remove_if(live.begin(), live.end(),
+                                  [&](int32_t id) { return !mixer.isActive(id); }), live.end());
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    mixer.stopAll(0);
+    bool idle = waitForIdle(mixer);
+    running = false;
+    callback.join();
+
+    std::printf("  %d voices started, %d refused (all slots busy), %lld bursts rendered\n",
+                started, refused, static_cast<long long>(bursts.load()));
+    EXPECT_TRUE(idle);
+    EXPECT_TRUE(outputSane.load());
+    EXPECT_TRUE(idsDistinct);
+    EXPECT_TRUE(started > refused);
+}
+
+FTL_TEST(mixingCostForOneToSixteenVoices) {
+    std::string path = tempPath("voice_noise.wav");
+    ASSERT_TRUE(writeWav16(path, makeNoiseSignal(OUTPUT_RATE * 20), 2, OUTPUT_RATE));
+
+    VoiceMixer mixer;
+    mixer.configure(OUTPUT_RATE, CHANNELS, RING_FRAMES);
+    std::vector<float> burst(static_cast<size_t>(BURST) * CHANNELS);
+    const double burstUs = BURST * 1e6 / OUTPUT_RATE;
+    constexpr int MEASURED_BURSTS = 400;
+
+    double sixteenVoiceUs = 0.0;
+    for (int count : {1, 2, 4, 8, 16}) {
+        std::vector<int32_t> voices;
+        for (int i = 0; i < count; ++i) {
+            voices.push_back(mixer.play(openAudioSource(path), 1.0f / count, 0));
+        }
+
+        double totalUs = 0.0;
+        double worstUs = 0.0;
+        for (int i = 0; i < MEASURED_BURSTS; ++i) {
+            waitForVoices(mixer, voices, BURST);
+            std::fill(burst.begin(), burst.end(), 0.0f);
+            Clock::time_point start = Clock::now();
+            int mixed = mixer.render(burst.data(), BURST);
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            EXPECT_EQ(mixed, count);
+            totalUs += us;
+            worstUs = std::max(worstUs, us);
+        }
+
+        double meanUs = totalUs / MEASURED_BURSTS;
+        std::printf("  %2d voices: %6.2f us/burst mean, %6.2f us worst (%.2f%% of a %d-frame burst)\n",
+                    count, meanUs, worstUs, 100.0 * meanUs / burstUs, BURST);
+        if (count == 16) sixteenVoiceUs = meanUs;
+
+        // Stopped voices finish on the next rendered burst
+        mixer.stopAll(0);
+        mixer.render(burst.data(), BURST);
+        EXPECT_TRUE(waitForIdle(mixer));
+    }
+
+    EXPECT_LE(sixteenVoiceUs, burstUs * 0.25);
+}
+
+FTL_TEST(engineMixesVoiceOverProgram) {
+    std::string path = tempPath("engine_voice.wav");
+    ASSERT_TRUE(writeWav16(path, std::vector<int16_t>(OUTPUT_RATE * 2 * 2, 8192), 2, OUTPUT_RATE));
+
+    struct Peak {
+        static void tap(const float* frames, int32_t numFrames, int32_t channelCount, int64_t, void* userData) {
+            auto* peak = static_cast<std::atomic<float>*>(userData);
+            float value = peak->load();
+            for (int32_t i = 0; i < numFrames * channelCount; ++i) value = std::max(value, frames[i]);
+            peak->store(value);
+        }
+    };
+    std::atomic<float> peak{0.0f};
+    host::setOutputTap(&Peak::tap, &peak);
+
+    host::BackendSettings settings;
+    host::setBackendSettings(settings);
+    AudioEngineConfig config;
+    config.sampleRate = OUTPUT_RATE;
+    config.framesPerBurst = 240;
+    config.enableDSPProcessing = false;       // Program is silence
+    FTLAudioEngine engine;
+    ASSERT_TRUE(engine.initialize(config) == EngineResult::SUCCESS);
+    ASSERT_TRUE(engine.startPlayback() == EngineResult::SUCCESS);
+
+    int32_t voice = -1;
+    EXPECT_TRUE(engine.playVoice(path, 0.5f, 0, &voice) == EngineResult::SUCCESS);
+    EXPECT_EQ(engine.getActiveVoiceCount(), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_NEAR(peak.load(), 0.125, 1e-6);      // 0.25 at half gain
+
+    EXPECT_TRUE(engine.stopVoice(voice, 10) == EngineResult::SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(engine.getActiveVoiceCount(), 0);
+    EXPECT_TRUE(engine.stopVoice(voice, 10) != EngineResult::SUCCESS);
+
+    engine.shutdown();
+    host::setOutputTap(nullptr, nullptr);
+}
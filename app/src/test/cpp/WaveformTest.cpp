@@ -0,0 +1,209 @@
+/**
+ * ╔══════════════════════════════════════════════════════════════╗
+ * ║            FTL AUDIO ENGINE - WAVEFORM PYRAMID TESTS        ║
+ * ╚══════════════════════════════════════════════════════════════╝
+ *
+ * Peak pyramid sidecars of a track that drops from -6 dB to -20 dB
+ * halfway: bin values at every level, column rendering at overview and
+ * zoomed-in scales, stale sidecar rejection, WAV/FLAC agreement, and a
+ * batch scan that skips fresh sidecars (build speed and size reported).
+ */
+
+#include "TestHarness.h"
+#include "TestSignals.h"
+
+#include "WaveformPyramid.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ftl_audio;
+using namespace ftl_test;
+
+namespace {
+
+constexpr int RATE = 48000;
+constexpr int64_t HALF_FRAMES = RATE * 5;
+constexpr int64_t TOTAL_FRAMES = HALF_FRAMES * 2;
+constexpr int64_t BASE_BIN_FRAMES = RATE / 50;
+
+// A sine's peak rounds outward to the next 1/127 step; its RMS is peak / sqrt(2)
+constexpr int LOUD_PEAK = 64;          // 0.5 * 127 = 63.5
+constexpr int LOUD_RMS = 90;           // 0.354 * 255
+constexpr int QUIET_PEAK = 13;         // 0.1 * 127 = 12.7
+constexpr int QUIET_RMS = 18;          // 0.0707 * 255
+
+std::vector<int16_t> makeStepSignal() {
+    std::vector<int16_t> samples = makeSineSignal(HALF_FRAMES, 2, RATE, 1000.0, 0.5);
+    std::vector<int16_t> quiet = makeSineSignal(HALF_FRAMES, 2, RATE, 1000.0, 0.1);
+    samples.insert(samples.end(), quiet.begin(), quiet.end());
+    return samples;
+}
+
+const std::string& wavPath() {
+    static const std::string path = [] {
+        std::string file = tempPath("waveform_step.wav");
+        if (!writeWav16(file, makeStepSignal(), 2, RATE)) {
+            reportFailure(__FILE__, __LINE__, "cannot write fixture");
+        }
+        return file;
+    }();
+    return path;
+}
+
+const std::string& flacPath() {
+    static const std::string path = [] {
+        std::string file = tempPath("waveform_step.flac");
+        if (!writeFlac16(file, makeStepSignal(), RATE)) {
+            reportFailure(__FILE__, __LINE__, "cannot write fixture");
+        }
+        return file;
+    }();
+    return path;
+}
+
+bool mapFresh(WaveformPyramid& pyramid, const std::string& sidecar, const std::string& source) {
+    SourceStamp stamp;
+    return SourceStamp::of(source, stamp) && pyramid.map(sidecar, stamp);
+}
+
+} // namespace
+
+FTL_TEST(levelsSummarizeTheTrack) {
+    std::string sidecar = tempPath("waveform_step.ftlwave");
+    WaveformBuildStats stats;
+    ASSERT_TRUE(buildWaveform(wavPath(), sidecar, &stats));
+
+    WaveformPyramid pyramid;
+    ASSERT_TRUE(mapFresh(pyramid, sidecar, wavPath()));
+    EXPECT_EQ(pyramid.header().totalFrames, TOTAL_FRAMES);
+    EXPECT_EQ(pyramid.mappedBytes(), static_cast<size_t>(stats.bytes));
+
+    // 500 bins of 20 ms, then 125 of 80 ms fit a seek bar
+    ASSERT_TRUE(pyramid.levelCount() == 2);
+    EXPECT_EQ(pyramid.level(0).framesPerBin, static_cast<uint32_t>(BASE_BIN_FRAMES));
+    EXPECT_EQ(pyramid.level(0).binCount, 500u);
+    EXPECT_EQ(pyramid.level(1).framesPerBin, static_cast<uint32_t>(BASE_BIN_FRAMES * 4));
+    EXPECT_EQ(pyramid.level(1).binCount, 125u);
+
+    for (int index = 0; index < pyramid.levelCount(); ++index) {
+        const WaveformBin* bins = pyramid.bins(index);
+        const WaveformBin& loud = bins[2];
+        const WaveformBin& quiet = bins[pyramid.level(index).binCount - 2];
+        EXPECT_EQ(loud.max, LOUD_PEAK);
+        EXPECT_EQ(loud.min, -LOUD_PEAK);
+        EXPECT_EQ(loud.rms, LOUD_RMS);
+        EXPECT_EQ(quiet.max, QUIET_PEAK);
+        EXPECT_EQ(quiet.min, -QUIET_PEAK);
+        EXPECT_EQ(quiet.rms, QUIET_RMS);
+    }
+}
+
+FTL_TEST(renderPicksLevelForZoom) {
+    std::string sidecar = tempPath("waveform_render.ftlwave");
+    ASSERT_TRUE(buildWaveform(wavPath(), sidecar));
+    WaveformPyramid pyramid;
+    ASSERT_TRUE(mapFresh(pyramid, sidecar, wavPath()));
+
+    // Whole track on a 100-column seek bar: the 80 ms level, 4800 frames a column
+    EXPECT_EQ(pyramid.levelFor(static_cast<double>(TOTAL_FRAMES) / 100), 1);
+    WaveformBin overview[100];
+    ASSERT_TRUE(pyramid.render(0, TOTAL_FRAMES, 100, overview) == 100);
+    for (int column = 0; column < 50; ++column) {
+        EXPECT_EQ(overview[column].max, LOUD_PEAK);
+    }
+    // Column 50 starts inside the 80 ms bin that straddles the step
+    for (int column = 51; column < 100; ++column) {
+        EXPECT_EQ(overview[column].max, QUIET_PEAK);
+        EXPECT_EQ(overview[column].rms, QUIET_RMS);
+    }
+
+    // 200 ms around the step, one 20 ms bin per column
+    WaveformBin zoomed[10];
+    ASSERT_TRUE(pyramid.render(HALF_FRAMES - RATE / 10, HALF_FRAMES + RATE / 10, 10, zoomed) == 10);
+    for (int column = 0; column < 10; ++column) {
+        EXPECT_EQ(zoomed[column].max, column < 5 ? LOUD_PEAK : QUIET_PEAK);
+        EXPECT_EQ(zoomed[column].rms, column < 5 ? LOUD_RMS : QUIET_RMS);
+    }
+
+    // Ranges are clamped to the track
+    EXPECT_EQ(pyramid.render(TOTAL_FRAMES, TOTAL_FRAMES + RATE, 10, zoomed), 0);
+    EXPECT_EQ(pyramid.render(-RATE, RATE, 4, zoomed), 4);
+}
+
+FTL_TEST(staleSidecarIsRejected) {
+    std::string copy = tempPath("waveform_stale.wav");
+    ASSERT_TRUE(writeWav16(copy, makeSineSignal(RATE, 2, RATE, 1000.0, 0.5), 2, RATE));
+    std::string sidecar = tempPath("waveform_stale.ftlwave");
+    ASSERT_TRUE(buildWaveform(copy, sidecar));
+
+    WaveformPyramid pyramid;
+    EXPECT_TRUE(mapFresh(pyramid, sidecar, copy));
+
+    // Re-encoding the file in place changes size/mtime
+    ASSERT_TRUE(writeWav16(copy, makeSineSignal(RATE * 2, 2, RATE, 1000.0, 0.5), 2, RATE));
+    struct timespec times[2] = {{0, UTIME_NOW}, {12345, 0}};
+    utimensat(AT_FDCWD, copy.c_str(), times, 0);
+    EXPECT_TRUE(!mapFresh(pyramid, sidecar, copy));
+    EXPECT_TRUE(!pyramid.isMapped());
+    EXPECT_TRUE(!mapFresh(pyramid, tempPath("missing.ftlwave"), copy));
+
+    // A truncated sidecar is corrupt, not short
+    ASSERT_TRUE(buildWaveform(copy, sidecar));
+    ASSERT_TRUE(mapFresh(pyramid, sidecar, copy));
+    off_t length = static_cast<off_t>(pyramid.mappedBytes());
+    pyramid.unmap();
+    ASSERT_TRUE(truncate(sidecar.c_str(), length - 1) == 0);
+    EXPECT_TRUE(!mapFresh(pyramid, sidecar, copy));
+}
+
+FTL_TEST(flacAndWavBuildTheSamePyramid) {
+    std::string fromWav = tempPath("waveform_match_wav.ftlwave");
+    std::string fromFlac = tempPath("waveform_match_flac.ftlwave");
+    ASSERT_TRUE(buildWaveform(wavPath(), fromWav));
+    ASSERT_TRUE(buildWaveform(flacPath(), fromFlac));
+
+    WaveformPyramid wav;
+    WaveformPyramid flac;
+    ASSERT_TRUE(mapFresh(wav, fromWav, wavPath()));
+    ASSERT_TRUE(mapFresh(flac, fromFlac, flacPath()));
+    ASSERT_TRUE(wav.levelCount() == flac.levelCount());
+    for (int index = 0; index < wav.levelCount(); ++index) {
+        ASSERT_TRUE(wav.level(index).binCount == flac.level(index).binCount);
+        EXPECT_TRUE(std::memcmp(wav.bins(index), flac.bins(index),
+                                wav.level(index).binCount * sizeof(WaveformBin)) == 0);
+    }
+}
+
+FTL_TEST(batchSkipsFreshSidecars) {
+    std::string directory = tempPath("waveform_cache");
+    mkdir(directory.c_str(), 0755);
+    std::vector<std::string> library = {wavPath(), flacPath(), tempPath("missing_track.flac")};
+    for (const std::string& path : library) {
+        std::remove(WaveformPyramid::sidecarPath(directory, path).c_str());
+    }
+
+    WaveformBatchStats first = buildWaveforms(library, directory);
+    EXPECT_EQ(first.built, 2);
+    EXPECT_EQ(first.skipped, 0);
+    EXPECT_EQ(first.failed, 1);
+    EXPECT_NEAR(first.audioSeconds, 20.0, 1e-9);
+    EXPECT_TRUE(first.realtimeFactor() > 1.0);
+    // 625 three-byte bins plus header and level table
+    EXPECT_LE(first.bytesPerTrack(), 2048.0);
+    std::printf("    build speed: %.0fx realtime, %.0f bytes/track (10 s)\n",
+                first.realtimeFactor(), first.bytesPerTrack());
+
+    WaveformBatchStats second = buildWaveforms(library, directory);
+    EXPECT_EQ(second.built, 0);
+    EXPECT_EQ(second.skipped, 2);
+    EXPECT_EQ(second.failed, 1);
+
+    std::atomic<bool> cancel{true};
+    WaveformBatchStats cancelled = buildWaveforms(library, directory, &cancel);
+    EXPECT_EQ(cancelled.built + cancelled.skipped + cancelled.failed, 0);
+}
@@ -0,0 +1,66 @@
+package com.ftl.audioplayer.audio
+
+import com.google.common.truth.Truth.assertThat
+import org.junit.Test
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Layout tests for the shared native snapshot reader
+ * Buffers are filled by hand with the same offsets as EngineSnapshot.h;
+ * nothing writes concurrently, so the readers skip the seqlock fence
+ */
+class EngineSnapshotReaderTest {
+
+    private fun snapshotBuffer(sequence: Int, version: Int = EngineSnapshotReader.LAYOUT_VERSION): ByteBuffer {
+        val buffer = ByteBuffer.allocateDirect(192).order(ByteOrder.nativeOrder())
+        buffer.putInt(0, sequence)
+        buffer.putInt(4, version)
+        buffer.putInt(8, 3)           // engineState = RUNNING
+        buffer.putInt(12, 48000)      // sampleRate
+        buffer.putInt(16, 2)          // channelCount
+        buffer.putInt(20, 256)        // framesPerBurst
+        buffer.putLong(24, 96000L)    // playheadFrame
+        buffer.putLong(40, 500L)      // callbackCount
+        buffer.putDouble(72, 120.5)   // averageProcessingTimeUs
+        buffer.putDouble(112, 8.25)   // totalLatencyMs
+        buffer.putFloat(136, 0.5f)    // peak L
+        buffer.putFloat(140, 0.25f)   // peak R
+        buffer.putLong(168, 3L)       // streamRecoveries
+        buffer.putDouble(176, 42.5)   // lastRecoveryMs
+        buffer.putDouble(184, 87.25)  // timeToFirstAudioMs
+        return buffer
+    }
+
+    @Test
+    fun `reads consistent snapshot fields`() {
+        val snapshot = EngineSnapshotReader(snapshotBuffer(sequence = 4), ReadFence.NONE).read()
+
+        assertThat(snapshot).isNotNull()
+        assertThat(snapshot!!.sampleRate).isEqualTo(48000)
+        assertThat(snapshot.playheadFrame).isEqualTo(96000L)
+        assertThat(snapshot.playheadMs).isEqualTo(2000L)
+        assertThat(snapshot.metrics.callbackCount).isEqualTo(500L)
+        assertThat(snapshot.metrics.averageProcessingTimeUs).isEqualTo(120.5)
+        assertThat(snapshot.totalLatencyMs).isEqualTo(8.25)
+        assertThat(snapshot.peakLevels.toList()).containsExactly(0.5f, 0.25f).inOrder()
+        assertThat(snapshot.metrics.streamRecoveries).isEqualTo(3L)
+        assertThat(snapshot.metrics.lastRecoveryMs).isEqualTo(42.5)
+        assertThat(snapshot.metrics.timeToFirstAudioMs).isEqualTo(87.25)
+    }
+
+    @Test
+    fun `returns null while writer holds the seqlock before first read`() {
+        val reader = EngineSnapshotReader(snapshotBuffer(sequence = 5), ReadFence.NONE)
+
+        assertThat(reader.read()).isNull()
+    }
+
+    @Test
+    fun `rejects mismatched layout version`() {
+        val reader = EngineSnapshotReader(snapshotBuffer(sequence = 2, version = 99), ReadFence.NONE)
+
+        assertThat(reader.isCompatible).isFalse()
+        assertThat(reader.read()).isNull()
+    }
+}